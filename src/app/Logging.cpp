@@ -10,27 +10,170 @@
 #include <QMutex>
 #include <QMutexLocker>
 #include <QStandardPaths>
-#include <QTextStream>
 #include <QThread>
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
 #include <cstdlib>
+#include <cstring>
 #include <exception>
 #include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 namespace onecad::app {
 namespace {
 
 QMutex gLogMutex;
-QFile gLogFile;
+QFile gLogFile;  // Written only with gDrainMutex held
 QString gLogFilePath;
-QtMessageHandler gPreviousHandler = nullptr;
+std::atomic<QtMessageHandler> gPreviousHandler{nullptr};  // Called by whoever drains the queues
 bool gInitialized = false;
-bool gDebugLoggingEnabled = false;
+std::atomic<bool> gDebugLoggingEnabled{false};
 std::terminate_handler gPreviousTerminateHandler = nullptr;
 
 constexpr int kLogRetentionDays = 30;
 constexpr int kMaxRunLogFiles = 30;
 
+// Writer wakes at least this often; warnings and fuller queues wake it sooner
+constexpr auto kFlushInterval = std::chrono::milliseconds(50);
+// How long a crashing thread waits for the writer to finish its batch
+constexpr auto kCrashFlushTimeout = std::chrono::milliseconds(200);
+// Producer retries before dropping a message when its queue is full
+constexpr int kPushRetries = 64;
+
+/**
+ * @brief Unformatted message as captured on the logging thread
+ *
+ * Context strings point into the intern table (see internContext()), so
+ * they stay valid after the caller's strings are gone, e.g. a category
+ * that was not static or a plugin that was unloaded.
+ */
+struct LogRecord {
+    qint64 timestampMs = 0;
+    quintptr threadId = 0;
+    QtMsgType type = QtDebugMsg;
+    const char* category = nullptr;
+    const char* file = nullptr;
+    const char* function = nullptr;
+    int line = 0;
+    QString message;
+};
+
+/**
+ * @brief Bounded single-producer/single-consumer ring owned by one thread
+ *
+ * The owning thread pushes without locks; records are consumed by
+ * whoever holds gDrainMutex (the writer thread, or a thread flushing on
+ * a fatal error).
+ */
+class ThreadLogQueue {
+public:
+    static constexpr size_t kCapacity = 512;  // Power of two
+
+    bool tryPush(LogRecord&& record) {
+        const size_t head = head_.load(std::memory_order_relaxed);
+        if (head - tail_.load(std::memory_order_acquire) == kCapacity) {
+            return false;
+        }
+        slots_[head & (kCapacity - 1)] = std::move(record);
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    size_t size() const {
+        return head_.load(std::memory_order_acquire) - tail_.load(std::memory_order_acquire);
+    }
+
+    void drainInto(std::vector<LogRecord>& out) {
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        const size_t head = head_.load(std::memory_order_acquire);
+        for (; tail != head; ++tail) {
+            out.push_back(std::move(slots_[tail & (kCapacity - 1)]));
+        }
+        tail_.store(tail, std::memory_order_release);
+    }
+
+    /// Set when the owning thread exits; the queue is dropped once empty
+    std::atomic<bool> retired{false};
+
+private:
+    std::array<LogRecord, kCapacity> slots_;
+    alignas(64) std::atomic<size_t> head_{0};
+    alignas(64) std::atomic<size_t> tail_{0};
+};
+
+std::mutex gQueuesMutex;  // Guards gQueues; taken once per thread and per writer pass
+std::vector<std::shared_ptr<ThreadLogQueue>> gQueues;
+std::timed_mutex gDrainMutex;  // Single consumer of every queue
+std::mutex gWakeMutex;
+std::condition_variable gWake;
+std::atomic<bool> gWakeRequested{false};
+std::atomic<bool> gWriterRunning{false};
+std::atomic<quint64> gDroppedMessages{0};
+std::thread gWriterThread;
+
+struct ThreadQueueHandle {
+    ThreadQueueHandle()
+        : queue(std::make_shared<ThreadLogQueue>()) {
+        std::lock_guard<std::mutex> lock(gQueuesMutex);
+        gQueues.push_back(queue);
+    }
+    ~ThreadQueueHandle() { queue->retired.store(true, std::memory_order_release); }
+
+    std::shared_ptr<ThreadLogQueue> queue;
+};
+
+ThreadLogQueue& threadQueue() {
+    thread_local ThreadQueueHandle handle;
+    return *handle.queue;
+}
+
+std::mutex gInternMutex;
+std::unordered_set<std::string> gInternedStrings;  // Never shrinks; file/function/category names are few
+
+/**
+ * @brief Stable copy of a context string
+ *
+ * Each thread remembers which interned copy it used for a pointer; the
+ * content is compared before reuse, so a different string at a recycled
+ * address is interned again instead of being misreported.
+ */
+const char* internContext(const char* text) {
+    if (text == nullptr) {
+        return nullptr;
+    }
+    thread_local std::unordered_map<const char*, const char*> cache;
+    auto cached = cache.find(text);
+    if (cached != cache.end() && std::strcmp(cached->second, text) == 0) {
+        return cached->second;
+    }
+
+    const char* stable = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(gInternMutex);
+        stable = gInternedStrings.insert(text).first->c_str();
+    }
+    cache[text] = stable;
+    return stable;
+}
+
+void wakeWriter() {
+    // No lock on the hot path: a missed notification costs at most one
+    // kFlushInterval of latency
+    gWakeRequested.store(true, std::memory_order_release);
+    gWake.notify_one();
+}
+
 const char* levelToString(QtMsgType type) {
     switch (type) {
         case QtDebugMsg:
@@ -102,54 +245,179 @@ void setLoggingRules(bool debugBuild) {
     QLoggingCategory::setFilterRules(rules.join('\n'));
 }
 
-QString formatMessage(QtMsgType type, const QMessageLogContext& context, const QString& msg) {
-    const QString timestamp = QDateTime::currentDateTime().toString(Qt::ISODateWithMs);
-    const QString threadId = QString::number(reinterpret_cast<quintptr>(QThread::currentThreadId()), 16);
+QByteArray formatRecord(const LogRecord& record) {
+    const QString timestamp = QDateTime::fromMSecsSinceEpoch(record.timestampMs).toString(Qt::ISODateWithMs);
+    const QString threadId = QString::number(record.threadId, 16);
 
-    const QString location = (context.file && context.line > 0)
-                                 ? QStringLiteral("%1:%2").arg(context.file).arg(context.line)
+    const QString location = (record.file && record.line > 0)
+                                 ? QStringLiteral("%1:%2").arg(record.file).arg(record.line)
                                  : QStringLiteral("<unknown>");
 
-    const QString function = context.function ? QString::fromUtf8(context.function) : QStringLiteral("<unknown>");
-    const QString category = context.category ? QString::fromUtf8(context.category) : QStringLiteral("default");
+    const QString function = record.function ? QString::fromUtf8(record.function) : QStringLiteral("<unknown>");
+    const QString category = record.category ? QString::fromUtf8(record.category) : QStringLiteral("default");
 
-    return QStringLiteral("%1 [%2] [tid=0x%3] [%4] [%5] [%6] %7")
+    return QStringLiteral("%1 [%2] [tid=0x%3] [%4] [%5] [%6] %7\n")
         .arg(timestamp,
-             QString::fromLatin1(levelToString(type)),
+             QString::fromLatin1(levelToString(record.type)),
              threadId,
              category,
              location,
              function,
-             msg);
+             record.message)
+        .toUtf8();
 }
 
-void writeToConsole(QtMsgType type, const QString& formatted) {
-    if (type == QtWarningMsg || type == QtCriticalMsg || type == QtFatalMsg) {
-        std::cerr << formatted.toStdString() << std::endl;
-    } else {
-        std::cout << formatted.toStdString() << std::endl;
-    }
+bool isConsoleError(QtMsgType type) {
+    return type == QtWarningMsg || type == QtCriticalMsg || type == QtFatalMsg;
 }
 
-void messageHandler(QtMsgType type, const QMessageLogContext& context, const QString& msg) {
-    const QString formatted = formatMessage(type, context, msg);
+/**
+ * @brief Write every queued record to the log file and console
+ *
+ * Caller holds gDrainMutex. Records from different threads are merged
+ * by timestamp; each batch costs one write and one flush per sink.
+ */
+void drainQueuesLocked() {
+    std::vector<std::shared_ptr<ThreadLogQueue>> queues;
+    {
+        std::lock_guard<std::mutex> lock(gQueuesMutex);
+        queues = gQueues;
+    }
+
+    std::vector<LogRecord> records;
+    for (const auto& queue : queues) {
+        queue->drainInto(records);
+    }
+
+    const quint64 dropped = gDroppedMessages.exchange(0, std::memory_order_relaxed);
+    if (dropped > 0) {
+        LogRecord notice;
+        notice.timestampMs = QDateTime::currentMSecsSinceEpoch();
+        notice.threadId = reinterpret_cast<quintptr>(QThread::currentThreadId());
+        notice.type = QtWarningMsg;
+        notice.category = "onecad.app.logging";
+        notice.message = QStringLiteral("%1 log messages dropped (queue full)").arg(dropped);
+        records.push_back(std::move(notice));
+    }
 
     {
-        QMutexLocker lock(&gLogMutex);
-        if (gLogFile.isOpen()) {
-            QTextStream stream(&gLogFile);
-            stream << formatted << Qt::endl;
-            gLogFile.flush();
+        // Threads that exited and whose records are written can go
+        std::lock_guard<std::mutex> lock(gQueuesMutex);
+        gQueues.erase(std::remove_if(gQueues.begin(), gQueues.end(),
+                                     [](const std::shared_ptr<ThreadLogQueue>& queue) {
+                                         return queue->retired.load(std::memory_order_acquire) &&
+                                                queue->size() == 0;
+                                     }),
+                      gQueues.end());
+    }
+
+    if (records.empty()) {
+        return;
+    }
+    std::stable_sort(records.begin(), records.end(), [](const LogRecord& a, const LogRecord& b) {
+        return a.timestampMs < b.timestampMs;
+    });
+
+    QByteArray fileBatch;
+    QByteArray outBatch;
+    QByteArray errBatch;
+    for (const LogRecord& record : records) {
+        const QByteArray line = formatRecord(record);
+        fileBatch += line;
+        (isConsoleError(record.type) ? errBatch : outBatch) += line;
+    }
+
+    if (gLogFile.isOpen()) {
+        gLogFile.write(fileBatch);
+        gLogFile.flush();
+    }
+    if (const QtMessageHandler previous = gPreviousHandler.load(std::memory_order_acquire)) {
+        // Off the logging threads; record strings are interned, so still valid
+        for (const LogRecord& record : records) {
+            const QMessageLogContext context(record.file, record.line, record.function, record.category);
+            previous(record.type, context, record.message);
         }
     }
+    if (!outBatch.isEmpty()) {
+        std::fwrite(outBatch.constData(), 1, static_cast<size_t>(outBatch.size()), stdout);
+        std::fflush(stdout);
+    }
+    if (!errBatch.isEmpty()) {
+        std::fwrite(errBatch.constData(), 1, static_cast<size_t>(errBatch.size()), stderr);
+        std::fflush(stderr);
+    }
+}
 
-    writeToConsole(type, formatted);
+void drainQueues() {
+    std::lock_guard<std::timed_mutex> lock(gDrainMutex);
+    drainQueuesLocked();
+}
 
-    if (gPreviousHandler != nullptr) {
-        gPreviousHandler(type, context, msg);
+void writerLoop() {
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(gWakeMutex);
+            gWake.wait_for(lock, kFlushInterval, []() {
+                return gWakeRequested.load(std::memory_order_acquire) ||
+                       !gWriterRunning.load(std::memory_order_acquire);
+            });
+            gWakeRequested.store(false, std::memory_order_relaxed);
+        }
+        drainQueues();
+        if (!gWriterRunning.load(std::memory_order_acquire)) {
+            break;
+        }
     }
+}
+
+void startWriter() {
+    gWriterRunning.store(true, std::memory_order_release);
+    gWriterThread = std::thread(writerLoop);
+}
+
+void stopWriter() {
+    if (!gWriterThread.joinable()) {
+        return;
+    }
+    gWriterRunning.store(false, std::memory_order_release);
+    wakeWriter();
+    gWriterThread.join();
+}
+
+void enqueue(LogRecord&& record) {
+    ThreadLogQueue& queue = threadQueue();
+    const bool urgent = isConsoleError(record.type);
+    for (int attempt = 0; !queue.tryPush(std::move(record)); ++attempt) {
+        if (attempt >= kPushRetries || !gWriterRunning.load(std::memory_order_acquire)) {
+            gDroppedMessages.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        wakeWriter();
+        std::this_thread::yield();
+    }
+    if (urgent || queue.size() >= ThreadLogQueue::kCapacity / 2) {
+        wakeWriter();
+    }
+}
+
+void messageHandler(QtMsgType type, const QMessageLogContext& context, const QString& msg) {
+    // Only capture here; formatting and I/O happen on the writer thread.
+    // Disabled categories never get this far: qCDebug() and friends test
+    // the category's cached enabled flag before building the message.
+    LogRecord record;
+    record.timestampMs = QDateTime::currentMSecsSinceEpoch();
+    record.threadId = reinterpret_cast<quintptr>(QThread::currentThreadId());
+    record.type = type;
+    record.category = internContext(context.category);
+    record.file = internContext(context.file);
+    record.function = internContext(context.function);
+    record.line = context.line;
+    record.message = msg;
+    enqueue(std::move(record));
 
     if (type == QtFatalMsg) {
+        // Also hands the message to the previous handler before aborting
+        drainQueues();
         std::abort();
     }
 }
@@ -158,11 +426,13 @@ void terminateHandler() {
     const QString timestamp = QDateTime::currentDateTime().toString(Qt::ISODateWithMs);
     const QString message = QStringLiteral("%1 [FATAL] [terminate] Unhandled exception triggered std::terminate").arg(timestamp);
 
-    {
-        QMutexLocker lock(&gLogMutex);
+    // Write out what the other threads queued before the crash. If the
+    // writer is wedged (or this is the writer), give up rather than hang.
+    std::unique_lock<std::timed_mutex> lock(gDrainMutex, std::defer_lock);
+    if (lock.try_lock_for(kCrashFlushTimeout)) {
+        drainQueuesLocked();
         if (gLogFile.isOpen()) {
-            QTextStream stream(&gLogFile);
-            stream << message << Qt::endl;
+            gLogFile.write(message.toUtf8() + '\n');
             gLogFile.flush();
         }
     }
@@ -260,7 +530,8 @@ bool Logging::initialize(const QString& appName, bool debugBuild) {
             return false;
         }
 
-        gPreviousHandler = qInstallMessageHandler(messageHandler);
+        startWriter();
+        gPreviousHandler.store(qInstallMessageHandler(messageHandler), std::memory_order_release);
         gPreviousTerminateHandler = std::set_terminate(terminateHandler);
         gInitialized = true;
         initializedLogFilePath = gLogFilePath;
@@ -271,7 +542,7 @@ bool Logging::initialize(const QString& appName, bool debugBuild) {
                       << "logFile=" << QFileInfo(initializedLogFilePath).absoluteFilePath()
                       << "logDir=" << logDirectoryPath
                       << "debugBuild=" << debugBuild
-                      << "debugLogsEnabled=" << gDebugLoggingEnabled;
+                      << "debugLogsEnabled=" << gDebugLoggingEnabled.load();
 
     pruneOldLogs(QDir(logDirectoryPath), initializedLogFilePath);
     qInfo().noquote() << "Log retention applied"
@@ -293,16 +564,20 @@ void Logging::shutdown() {
 
     qInfo().noquote() << "Logging shutdown" << "logFile=" << closingLogFilePath;
 
+    stopWriter();
+
     {
         QMutexLocker lock(&gLogMutex);
-        qInstallMessageHandler(gPreviousHandler);
-        gPreviousHandler = nullptr;
+        qInstallMessageHandler(gPreviousHandler.load(std::memory_order_acquire));
 
         std::set_terminate(gPreviousTerminateHandler);
         gPreviousTerminateHandler = nullptr;
 
+        // Messages logged while the writer was stopping
+        std::lock_guard<std::timed_mutex> drainLock(gDrainMutex);
+        drainQueuesLocked();
+        gPreviousHandler.store(nullptr, std::memory_order_release);
         if (gLogFile.isOpen()) {
-            gLogFile.flush();
             gLogFile.close();
         }
 
@@ -317,8 +592,7 @@ QString Logging::logFilePath() {
 }
 
 bool Logging::isDebugLoggingEnabled() {
-    QMutexLocker lock(&gLogMutex);
-    return gDebugLoggingEnabled;
+    return gDebugLoggingEnabled.load(std::memory_order_relaxed);
 }
 
 } // namespace onecad::app
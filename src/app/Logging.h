@@ -5,6 +5,13 @@
 
 namespace onecad::app {
 
+/**
+ * @brief Process-wide Qt message handler writing to a per-run log file
+ *
+ * Messages are captured into per-thread lock-free queues and written by a
+ * background thread in batches (one write and flush per batch). Fatal
+ * messages and std::terminate flush the queues synchronously.
+ */
 class Logging {
 public:
     static bool initialize(const QString& appName, bool debugBuild);
@@ -3,6 +3,7 @@
  */
 #include "AddBodyCommand.h"
 #include "../document/Document.h"
+#include "../../core/memory/MemoryEstimate.h"
 
 #include <QUuid>
 
@@ -41,4 +42,8 @@ bool AddBodyCommand::undo() {
     return document_->removeBody(bodyId_);
 }
 
+std::size_t AddBodyCommand::memoryBytes() const {
+    return sizeof(*this) + core::memory::stringBytes(bodyId_) + core::memory::stringBytes(bodyName_);
+}
+
 } // namespace onecad::app::commands
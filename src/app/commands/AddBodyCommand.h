@@ -26,6 +26,8 @@ public:
     bool execute() override;
     bool undo() override;
     std::string label() const override { return "Add Body"; }
+    std::size_t memoryBytes() const override;
+    void collectShapes(std::vector<TopoDS_Shape>& shapes) const override { shapes.push_back(shape_); }
 
     const std::string& bodyId() const { return bodyId_; }
     const std::string& bodyName() const { return bodyName_; }
@@ -5,7 +5,11 @@
 #ifndef ONECAD_APP_COMMANDS_COMMAND_H
 #define ONECAD_APP_COMMANDS_COMMAND_H
 
+#include <cstddef>
 #include <string>
+#include <vector>
+
+class TopoDS_Shape;
 
 namespace onecad::app::commands {
 
@@ -15,6 +19,16 @@ public:
     virtual bool execute() = 0;
     virtual bool undo() = 0;
     virtual std::string label() const { return {}; }
+
+    /**
+     * @brief Approximate bytes kept for undo/redo, not counting shapes
+     */
+    virtual std::size_t memoryBytes() const { return sizeof(Command); }
+
+    /**
+     * @brief Append the shapes this command keeps alive (for memory reports)
+     */
+    virtual void collectShapes(std::vector<TopoDS_Shape>& shapes) const { (void)shapes; }
 };
 
 } // namespace onecad::app::commands
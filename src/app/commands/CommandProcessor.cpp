@@ -2,6 +2,8 @@
  * @file CommandProcessor.cpp
  */
 #include "CommandProcessor.h"
+#include "../document/Document.h"
+#include "../../core/memory/MemoryEstimate.h"
 
 #include <algorithm>
 
@@ -40,11 +42,41 @@ public:
 
     std::string label() const override { return label_; }
 
+    std::size_t memoryBytes() const override {
+        std::size_t bytes = sizeof(*this) + core::memory::stringBytes(label_)
+            + core::memory::vectorBytes(commands_);
+        for (const auto& cmd : commands_) {
+            bytes += cmd->memoryBytes();
+        }
+        return bytes;
+    }
+
+    void collectShapes(std::vector<TopoDS_Shape>& shapes) const override {
+        for (const auto& cmd : commands_) {
+            cmd->collectShapes(shapes);
+        }
+    }
+
 private:
     std::string label_;
     std::vector<std::unique_ptr<Command>> commands_;
 };
 
+std::size_t stackBytes(const std::vector<std::unique_ptr<Command>>& stack) {
+    std::size_t bytes = core::memory::vectorBytes(stack);
+    for (const auto& cmd : stack) {
+        bytes += cmd->memoryBytes();
+    }
+    return bytes;
+}
+
+void collectStackShapes(const std::vector<std::unique_ptr<Command>>& stack,
+                        std::vector<TopoDS_Shape>& shapes) {
+    for (const auto& cmd : stack) {
+        cmd->collectShapes(shapes);
+    }
+}
+
 } // namespace
 
 CommandProcessor::CommandProcessor(QObject* parent)
@@ -56,6 +88,7 @@ bool CommandProcessor::execute(std::unique_ptr<Command> command) {
         return false;
     }
 
+    Document::ChangeBatch changeBatch(document_);
     if (!command->execute()) {
         if (inTransaction_) {
             cancelTransaction();
@@ -82,6 +115,7 @@ void CommandProcessor::undo() {
         return;
     }
 
+    Document::ChangeBatch changeBatch(document_);
     const bool prevUndo = canUndo();
     const bool prevRedo = canRedo();
 
@@ -102,6 +136,7 @@ void CommandProcessor::redo() {
         return;
     }
 
+    Document::ChangeBatch changeBatch(document_);
     const bool prevUndo = canUndo();
     const bool prevRedo = canRedo();
 
@@ -207,4 +242,19 @@ void CommandProcessor::emitStateChange(bool prevUndo, bool prevRedo) {
     }
 }
 
+CommandProcessor::MemoryUsage CommandProcessor::memoryUsage() const {
+    MemoryUsage usage;
+    usage.undoBytes = stackBytes(undoStack_);
+    usage.redoBytes = stackBytes(redoStack_);
+    usage.transactionBytes = stackBytes(transaction_);
+    usage.commandCount = undoStack_.size() + redoStack_.size() + transaction_.size();
+    return usage;
+}
+
+void CommandProcessor::collectShapes(std::vector<TopoDS_Shape>& shapes) const {
+    collectStackShapes(undoStack_, shapes);
+    collectStackShapes(redoStack_, shapes);
+    collectStackShapes(transaction_, shapes);
+}
+
 } // namespace onecad::app::commands
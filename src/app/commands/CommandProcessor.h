@@ -12,6 +12,10 @@
 #include <string>
 #include <vector>
 
+namespace onecad::app {
+class Document;
+}
+
 namespace onecad::app::commands {
 
 class CommandProcessor : public QObject {
@@ -20,6 +24,14 @@ class CommandProcessor : public QObject {
 public:
     explicit CommandProcessor(QObject* parent = nullptr);
 
+    /**
+     * @brief Document whose body changes are delivered once per execute/undo/redo
+     *
+     * Transactions span several user steps, so each command in them is
+     * delivered separately and the viewport follows along.
+     */
+    void setDocument(Document* document) { document_ = document; }
+
     bool execute(std::unique_ptr<Command> command);
     void undo();
     void redo();
@@ -29,6 +41,21 @@ public:
 
     void clear();
 
+    /**
+     * @brief Approximate bytes held by the undo, redo and open transaction stacks
+     *
+     * Shapes are excluded; they are shared with the document and reported
+     * through collectShapes() so the caller can count each one once.
+     */
+    struct MemoryUsage {
+        std::size_t undoBytes = 0;
+        std::size_t redoBytes = 0;
+        std::size_t transactionBytes = 0;
+        std::size_t commandCount = 0;
+    };
+    MemoryUsage memoryUsage() const;
+    void collectShapes(std::vector<TopoDS_Shape>& shapes) const;
+
     void beginTransaction(const std::string& label = {});
     void endTransaction();
     void cancelTransaction();
@@ -40,6 +67,7 @@ signals:
 private:
     void emitStateChange(bool prevUndo, bool prevRedo);
 
+    Document* document_ = nullptr;
     bool inTransaction_ = false;
     std::string transactionLabel_;
     std::vector<std::unique_ptr<Command>> undoStack_;
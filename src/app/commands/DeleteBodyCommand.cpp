@@ -3,6 +3,7 @@
  */
 #include "DeleteBodyCommand.h"
 #include "../document/Document.h"
+#include "../../core/memory/MemoryEstimate.h"
 
 namespace onecad::app::commands {
 
@@ -41,4 +42,8 @@ bool DeleteBodyCommand::undo() {
     return true;
 }
 
+std::size_t DeleteBodyCommand::memoryBytes() const {
+    return sizeof(*this) + core::memory::stringBytes(bodyId_) + core::memory::stringBytes(savedName_);
+}
+
 } // namespace onecad::app::commands
@@ -23,6 +23,8 @@ public:
     bool execute() override;
     bool undo() override;
     std::string label() const override { return "Delete Body"; }
+    std::size_t memoryBytes() const override;
+    void collectShapes(std::vector<TopoDS_Shape>& shapes) const override { shapes.push_back(savedShape_); }
 
 private:
     Document* document_ = nullptr;
@@ -3,6 +3,7 @@
  */
 #include "DeleteSketchCommand.h"
 #include "../document/Document.h"
+#include "../../core/memory/MemoryEstimate.h"
 #include "../../core/sketch/Sketch.h"
 
 namespace onecad::app::commands {
@@ -48,4 +49,9 @@ bool DeleteSketchCommand::undo() {
     return true;
 }
 
+std::size_t DeleteSketchCommand::memoryBytes() const {
+    return sizeof(*this) + core::memory::stringBytes(sketchId_) + core::memory::stringBytes(savedName_)
+        + core::memory::stringBytes(savedJson_);
+}
+
 } // namespace onecad::app::commands
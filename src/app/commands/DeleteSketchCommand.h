@@ -27,6 +27,7 @@ public:
     bool execute() override;
     bool undo() override;
     std::string label() const override { return "Delete Sketch"; }
+    std::size_t memoryBytes() const override;
 
 private:
     Document* document_ = nullptr;
@@ -1,5 +1,6 @@
 #include "ModifyBodyCommand.h"
 #include "../document/Document.h"
+#include "../../core/memory/MemoryEstimate.h"
 #include "../../kernel/elementmap/ElementMap.h"
 
 namespace onecad::app::commands {
@@ -45,4 +46,8 @@ bool ModifyBodyCommand::undo() {
     return document_->updateBodyShape(bodyId_, oldShape_);
 }
 
+std::size_t ModifyBodyCommand::memoryBytes() const {
+    return sizeof(*this) + core::memory::stringBytes(bodyId_);
+}
+
 } // namespace onecad::app::commands
@@ -20,6 +20,8 @@ public:
     bool execute() override;
     bool undo() override;
     std::string label() const override { return "Modify Body"; }
+    std::size_t memoryBytes() const override;
+    void collectShapes(std::vector<TopoDS_Shape>& shapes) const override { shapes.push_back(newShape_); shapes.push_back(oldShape_); }
 
 private:
     Document* document_ = nullptr;
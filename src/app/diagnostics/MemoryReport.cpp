@@ -0,0 +1,398 @@
+/**
+ * @file MemoryReport.cpp
+ * @brief Memory report collection and JSON output.
+ */
+#include "MemoryReport.h"
+
+#include "../commands/CommandProcessor.h"
+#include "../document/Document.h"
+
+#include <BRep_CurveRepresentation.hxx>
+#include <BRep_ListIteratorOfListOfCurveRepresentation.hxx>
+#include <BRep_TEdge.hxx>
+#include <BRep_TFace.hxx>
+#include <BRep_TVertex.hxx>
+#include <BRep_Tool.hxx>
+#include <Geom2d_BSplineCurve.hxx>
+#include <Geom2d_TrimmedCurve.hxx>
+#include <Geom_BSplineCurve.hxx>
+#include <Geom_BSplineSurface.hxx>
+#include <Geom_BezierCurve.hxx>
+#include <Geom_BezierSurface.hxx>
+#include <Geom_OffsetSurface.hxx>
+#include <Geom_RectangularTrimmedSurface.hxx>
+#include <Geom_TrimmedCurve.hxx>
+#include <Poly_PolygonOnTriangulation.hxx>
+#include <Poly_Triangulation.hxx>
+#include <TopExp.hxx>
+#include <TopLoc_Location.hxx>
+#include <TopTools_IndexedMapOfShape.hxx>
+#include <TopoDS.hxx>
+#include <TopoDS_Shape.hxx>
+
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QLocale>
+#include <QLoggingCategory>
+#include <QStringList>
+
+#include <algorithm>
+
+namespace onecad::app::diagnostics {
+
+Q_LOGGING_CATEGORY(logMemoryReport, "onecad.app.diagnostics.memory")
+
+namespace {
+
+// Analytic curves and surfaces (lines, planes, cylinders...) are a handful
+// of doubles plus the Standard_Transient header
+constexpr std::size_t kAnalyticGeometryBytes = 128;
+// BRep_CurveRepresentation subclass objects besides the geometry they hold
+constexpr std::size_t kCurveRepresentationBytes = 64;
+// One TopoDS_ListOfShape node per child of a wire/shell/solid/compound
+constexpr std::size_t kChildNodeBytes = sizeof(TopoDS_Shape) + 2 * sizeof(void*);
+
+std::size_t knotsBytes(int knotCount) {
+    return static_cast<std::size_t>(knotCount) * (sizeof(double) + sizeof(int));
+}
+
+/**
+ * @brief Geometry and mesh sizes, each object counted on first sight only
+ */
+class GeometryBytes {
+public:
+    explicit GeometryBytes(std::unordered_set<const void*>& seen) : seen_(seen) {}
+
+    std::size_t curve(const Handle(Geom_Curve)& curve) {
+        if (curve.IsNull() || !seen_.insert(curve.get()).second) {
+            return 0;
+        }
+        if (auto trimmed = Handle(Geom_TrimmedCurve)::DownCast(curve)) {
+            return sizeof(Geom_TrimmedCurve) + this->curve(trimmed->BasisCurve());
+        }
+        if (auto bspline = Handle(Geom_BSplineCurve)::DownCast(curve)) {
+            const auto poles = static_cast<std::size_t>(bspline->NbPoles());
+            return sizeof(Geom_BSplineCurve) + poles * sizeof(gp_Pnt)
+                + (bspline->IsRational() ? poles * sizeof(double) : 0) + knotsBytes(bspline->NbKnots());
+        }
+        if (auto bezier = Handle(Geom_BezierCurve)::DownCast(curve)) {
+            const auto poles = static_cast<std::size_t>(bezier->NbPoles());
+            return sizeof(Geom_BezierCurve) + poles * sizeof(gp_Pnt)
+                + (bezier->IsRational() ? poles * sizeof(double) : 0);
+        }
+        return kAnalyticGeometryBytes;
+    }
+
+    std::size_t curve2d(const Handle(Geom2d_Curve)& curve) {
+        if (curve.IsNull() || !seen_.insert(curve.get()).second) {
+            return 0;
+        }
+        if (auto trimmed = Handle(Geom2d_TrimmedCurve)::DownCast(curve)) {
+            return sizeof(Geom2d_TrimmedCurve) + curve2d(trimmed->BasisCurve());
+        }
+        if (auto bspline = Handle(Geom2d_BSplineCurve)::DownCast(curve)) {
+            const auto poles = static_cast<std::size_t>(bspline->NbPoles());
+            return sizeof(Geom2d_BSplineCurve) + poles * sizeof(gp_Pnt2d)
+                + (bspline->IsRational() ? poles * sizeof(double) : 0) + knotsBytes(bspline->NbKnots());
+        }
+        return kAnalyticGeometryBytes;
+    }
+
+    std::size_t surface(const Handle(Geom_Surface)& surface) {
+        if (surface.IsNull() || !seen_.insert(surface.get()).second) {
+            return 0;
+        }
+        if (auto trimmed = Handle(Geom_RectangularTrimmedSurface)::DownCast(surface)) {
+            return sizeof(Geom_RectangularTrimmedSurface) + this->surface(trimmed->BasisSurface());
+        }
+        if (auto offset = Handle(Geom_OffsetSurface)::DownCast(surface)) {
+            return sizeof(Geom_OffsetSurface) + this->surface(offset->BasisSurface());
+        }
+        if (auto bspline = Handle(Geom_BSplineSurface)::DownCast(surface)) {
+            const auto poles = static_cast<std::size_t>(bspline->NbUPoles())
+                * static_cast<std::size_t>(bspline->NbVPoles());
+            const bool rational = bspline->IsURational() || bspline->IsVRational();
+            return sizeof(Geom_BSplineSurface) + poles * sizeof(gp_Pnt)
+                + (rational ? poles * sizeof(double) : 0)
+                + knotsBytes(bspline->NbUKnots()) + knotsBytes(bspline->NbVKnots());
+        }
+        if (auto bezier = Handle(Geom_BezierSurface)::DownCast(surface)) {
+            const auto poles = static_cast<std::size_t>(bezier->NbUPoles())
+                * static_cast<std::size_t>(bezier->NbVPoles());
+            const bool rational = bezier->IsURational() || bezier->IsVRational();
+            return sizeof(Geom_BezierSurface) + poles * sizeof(gp_Pnt)
+                + (rational ? poles * sizeof(double) : 0);
+        }
+        return kAnalyticGeometryBytes;
+    }
+
+    std::size_t triangulation(const Handle(Poly_Triangulation)& triangulation) {
+        if (triangulation.IsNull() || !seen_.insert(triangulation.get()).second) {
+            return 0;
+        }
+        const auto nodes = static_cast<std::size_t>(triangulation->NbNodes());
+        std::size_t bytes = sizeof(Poly_Triangulation) + nodes * sizeof(gp_Pnt)
+            + static_cast<std::size_t>(triangulation->NbTriangles()) * sizeof(Poly_Triangle);
+        if (triangulation->HasUVNodes()) {
+            bytes += nodes * sizeof(gp_Pnt2d);
+        }
+        if (triangulation->HasNormals()) {
+            bytes += nodes * 3 * sizeof(float);
+        }
+        return bytes;
+    }
+
+    std::size_t polygon(const Handle(Poly_PolygonOnTriangulation)& polygon) {
+        if (polygon.IsNull() || !seen_.insert(polygon.get()).second) {
+            return 0;
+        }
+        const auto nodes = static_cast<std::size_t>(polygon->NbNodes());
+        return sizeof(Poly_PolygonOnTriangulation) + nodes * sizeof(int)
+            + (polygon->HasParameters() ? nodes * sizeof(double) : 0);
+    }
+
+private:
+    std::unordered_set<const void*>& seen_;
+};
+
+} // namespace
+
+std::size_t ShapeMemoryEstimator::add(const TopoDS_Shape& shape) {
+    if (shape.IsNull()) {
+        return 0;
+    }
+
+    GeometryBytes geometry(seen_);
+    TopTools_IndexedMapOfShape subShapes;
+    TopExp::MapShapes(shape, subShapes);
+
+    std::size_t bytes = 0;
+    for (int i = 1; i <= subShapes.Extent(); ++i) {
+        const TopoDS_Shape& sub = subShapes(i);
+        if (!firstSeen(sub.TShape().get())) {
+            continue;  // Same TShape under another location/orientation
+        }
+
+        switch (sub.ShapeType()) {
+            case TopAbs_FACE: {
+                const TopoDS_Face& face = TopoDS::Face(sub);
+                TopLoc_Location location;
+                bytes += sizeof(BRep_TFace);
+                bytes += geometry.surface(BRep_Tool::Surface(face, location));
+                bytes += geometry.triangulation(BRep_Tool::Triangulation(face, location));
+                break;
+            }
+            case TopAbs_EDGE: {
+                bytes += sizeof(BRep_TEdge);
+                Handle(BRep_TEdge) edge = Handle(BRep_TEdge)::DownCast(sub.TShape());
+                if (edge.IsNull()) {
+                    break;
+                }
+                for (BRep_ListIteratorOfListOfCurveRepresentation it(edge->Curves()); it.More(); it.Next()) {
+                    const Handle(BRep_CurveRepresentation)& representation = it.Value();
+                    bytes += kCurveRepresentationBytes;
+                    if (representation->IsCurve3D()) {
+                        bytes += geometry.curve(representation->Curve3D());
+                    } else if (representation->IsCurveOnSurface()) {
+                        bytes += geometry.curve2d(representation->PCurve());
+                        if (representation->IsCurveOnClosedSurface()) {
+                            bytes += geometry.curve2d(representation->PCurve2());
+                        }
+                    } else if (representation->IsPolygonOnTriangulation()) {
+                        bytes += geometry.polygon(representation->PolygonOnTriangulation());
+                    }
+                }
+                break;
+            }
+            case TopAbs_VERTEX:
+                bytes += sizeof(BRep_TVertex);
+                break;
+            default:
+                // Wires, shells, solids and compounds only hold their children
+                bytes += sizeof(TopoDS_TShape)
+                    + static_cast<std::size_t>(sub.NbChildren()) * kChildNodeBytes;
+                break;
+        }
+    }
+    return bytes;
+}
+
+MemoryReport MemoryReport::collect(const Document& document,
+                                   const commands::CommandProcessor* commandProcessor) {
+    MemoryReport report;
+    ShapeMemoryEstimator shapes;
+
+    std::size_t loadedBodies = 0;
+    for (const auto& id : document.getBodyIds()) {
+        if (!document.isBodyLoaded(id)) {
+            continue;
+        }
+        const TopoDS_Shape* shape = document.getBodyShape(id);
+        const std::size_t bytes = shape ? shapes.add(*shape) : 0;
+        report.addPart("brep", "bodies", bytes);
+        report.addItem("brep", id, bytes);
+        ++loadedBodies;
+    }
+    report.setCount("brep", loadedBodies);
+
+    const render::SceneMeshStore& meshStore = document.meshStore();
+    report.addPart("sceneMeshes", "meshes", meshStore.memoryBytes());
+    meshStore.forEachMesh([&report](const render::SceneMeshStore::Mesh& mesh) {
+        report.addItem("sceneMeshes", mesh.bodyId, render::SceneMeshStore::meshBytes(mesh));
+    });
+    report.setCount("sceneMeshes", meshStore.size());
+
+    const kernel::elementmap::ElementMap& elementMap = document.elementMap();
+    report.addPart("elementMap", "entries", elementMap.memoryBytes());
+    report.setCount("elementMap", elementMap.size());
+
+    std::size_t loadedSketches = 0;
+    for (const auto& id : document.getSketchIds()) {
+        if (!document.isSketchLoaded(id)) {
+            continue;
+        }
+        const core::sketch::Sketch* sketch = document.getSketch(id);
+        if (!sketch) {
+            continue;
+        }
+        const core::sketch::SketchMemoryUsage usage = sketch->memoryUsage();
+        report.addPart("sketches", "entities", usage.entityBytes);
+        report.addPart("sketches", "constraints", usage.constraintBytes);
+        report.addPart("sketches", "index", usage.indexBytes);
+        report.addPart("sketches", "solver", usage.solverBytes);
+        report.addItem("sketches", id, usage.total());
+        ++loadedSketches;
+    }
+    report.setCount("sketches", loadedSketches);
+
+    if (commandProcessor) {
+        const auto usage = commandProcessor->memoryUsage();
+        report.addPart("undoStack", "undo", usage.undoBytes);
+        report.addPart("undoStack", "redo", usage.redoBytes);
+        report.addPart("undoStack", "transaction", usage.transactionBytes);
+
+        // Body shapes were added first, so this is only what undo alone keeps alive
+        std::vector<TopoDS_Shape> retained;
+        commandProcessor->collectShapes(retained);
+        std::size_t retainedBytes = 0;
+        for (const auto& shape : retained) {
+            retainedBytes += shapes.add(shape);
+        }
+        report.addPart("undoStack", "retainedBrep", retainedBytes);
+        report.setCount("undoStack", usage.commandCount);
+    }
+
+    qCDebug(logMemoryReport) << "collect: total=" << report.totalBytes()
+                             << "bodies=" << loadedBodies << "sketches=" << loadedSketches;
+    return report;
+}
+
+MemoryReport::Category& MemoryReport::category(const std::string& name) {
+    auto it = std::find_if(categories_.begin(), categories_.end(),
+                           [&name](const Category& category) { return category.name == name; });
+    if (it != categories_.end()) {
+        return *it;
+    }
+    categories_.push_back(Category{name});
+    return categories_.back();
+}
+
+void MemoryReport::addPart(const std::string& categoryName, const std::string& part, std::size_t bytes) {
+    Category& target = category(categoryName);
+    target.bytes += bytes;
+    auto it = std::find_if(target.parts.begin(), target.parts.end(),
+                           [&part](const Entry& entry) { return entry.name == part; });
+    if (it != target.parts.end()) {
+        it->bytes += bytes;
+    } else {
+        target.parts.push_back(Entry{part, bytes});
+    }
+}
+
+void MemoryReport::addItem(const std::string& categoryName, const std::string& item, std::size_t bytes) {
+    category(categoryName).items.push_back(Entry{item, bytes});
+}
+
+void MemoryReport::setCount(const std::string& categoryName, std::size_t count) {
+    category(categoryName).count = count;
+}
+
+const MemoryReport::Category* MemoryReport::findCategory(const std::string& name) const {
+    auto it = std::find_if(categories_.begin(), categories_.end(),
+                           [&name](const Category& category) { return category.name == name; });
+    return it != categories_.end() ? &*it : nullptr;
+}
+
+std::size_t MemoryReport::totalBytes() const {
+    std::size_t total = 0;
+    for (const auto& category : categories_) {
+        total += category.bytes;
+    }
+    return total;
+}
+
+QJsonObject MemoryReport::toJson() const {
+    auto entriesToJson = [](const std::vector<Entry>& entries) {
+        QJsonObject object;
+        for (const auto& entry : entries) {
+            object.insert(QString::fromStdString(entry.name), static_cast<qint64>(entry.bytes));
+        }
+        return object;
+    };
+
+    QJsonArray categories;
+    for (const auto& category : categories_) {
+        QJsonObject object;
+        object["name"] = QString::fromStdString(category.name);
+        object["bytes"] = static_cast<qint64>(category.bytes);
+        object["count"] = static_cast<qint64>(category.count);
+        object["parts"] = entriesToJson(category.parts);
+        object["items"] = entriesToJson(category.items);
+        categories.append(object);
+    }
+
+    QJsonObject root;
+    root["totalBytes"] = static_cast<qint64>(totalBytes());
+    root["categories"] = categories;
+    return root;
+}
+
+bool MemoryReport::writeJson(const QString& path) const {
+    QFile file(path);
+    const QByteArray json = QJsonDocument(toJson()).toJson(QJsonDocument::Indented);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate) || file.write(json) != json.size()) {
+        qCWarning(logMemoryReport) << "Failed to write memory report" << path << file.errorString();
+        return false;
+    }
+    qCInfo(logMemoryReport) << "Memory report written" << "path=" << path << "total=" << totalBytes();
+    return true;
+}
+
+QString MemoryReport::summary() const {
+    std::vector<const Category*> sorted;
+    sorted.reserve(categories_.size());
+    for (const auto& category : categories_) {
+        sorted.push_back(&category);
+    }
+    std::stable_sort(sorted.begin(), sorted.end(),
+                     [](const Category* a, const Category* b) { return a->bytes > b->bytes; });
+
+    QStringList lines;
+    lines << QStringLiteral("Total: %1").arg(formatBytes(totalBytes()));
+    for (const Category* category : sorted) {
+        QString line = QStringLiteral("%1: %2")
+                           .arg(QString::fromStdString(category->name), formatBytes(category->bytes));
+        if (category->count > 0) {
+            line += QStringLiteral(" (%1)").arg(category->count);
+        }
+        lines << line;
+    }
+    return lines.join('\n');
+}
+
+QString MemoryReport::formatBytes(std::size_t bytes) {
+    return QLocale().formattedDataSize(static_cast<qint64>(bytes));
+}
+
+} // namespace onecad::app::diagnostics
@@ -0,0 +1,112 @@
+/**
+ * @file MemoryReport.h
+ * @brief Approximate memory use broken down by body, sketch and cache.
+ *
+ * Every figure is an estimate computed from container sizes and OCCT
+ * topology/geometry counts; it is meant to compare consumers and spot
+ * growth over a session, not to add up to the process RSS.
+ */
+#ifndef ONECAD_APP_DIAGNOSTICS_MEMORYREPORT_H
+#define ONECAD_APP_DIAGNOSTICS_MEMORYREPORT_H
+
+#include <QJsonObject>
+#include <QString>
+
+#include <cstddef>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+class TopoDS_Shape;
+
+namespace onecad::app {
+class Document;
+namespace commands {
+class CommandProcessor;
+}
+}
+
+namespace onecad::app::diagnostics {
+
+/**
+ * @brief Estimates BRep memory, counting shared topology and geometry once
+ *
+ * Shapes that share sub-shapes (a body and an undo snapshot of it, or two
+ * bodies after a copy) only add the parts not seen before.
+ */
+class ShapeMemoryEstimator {
+public:
+    /**
+     * @brief Bytes of topology, geometry and triangulation new to this estimator
+     */
+    std::size_t add(const TopoDS_Shape& shape);
+
+private:
+    bool firstSeen(const void* object) { return object && seen_.insert(object).second; }
+
+    std::unordered_set<const void*> seen_;
+};
+
+/**
+ * @brief Memory report with one entry per category (brep, sceneMeshes, ...)
+ *
+ * A category's bytes are the sum of its parts. Items break the same bytes
+ * down by body or sketch id where that is known.
+ */
+class MemoryReport {
+public:
+    struct Entry {
+        std::string name;
+        std::size_t bytes = 0;
+    };
+
+    struct Category {
+        std::string name;
+        std::size_t bytes = 0;
+        std::size_t count = 0;  ///< Bodies, entries, commands... (0 if not tracked)
+        std::vector<Entry> parts;
+        std::vector<Entry> items;
+    };
+
+    /**
+     * @brief Report for the document and its undo history
+     *
+     * Covers BRep per body, scene meshes, ElementMap, sketches and the undo
+     * stack. Pending (not yet loaded) entries are skipped, not loaded.
+     * Viewport caches are added by the UI, see Viewport::appendMemoryReport().
+     */
+    static MemoryReport collect(const Document& document,
+                                const commands::CommandProcessor* commandProcessor);
+
+    /**
+     * @brief Add bytes to a category part, creating either as needed
+     */
+    void addPart(const std::string& category, const std::string& part, std::size_t bytes);
+    /**
+     * @brief Record a per-item figure; does not change the category total
+     */
+    void addItem(const std::string& category, const std::string& item, std::size_t bytes);
+    void setCount(const std::string& category, std::size_t count);
+
+    const std::vector<Category>& categories() const { return categories_; }
+    const Category* findCategory(const std::string& name) const;
+    std::size_t totalBytes() const;
+
+    QJsonObject toJson() const;
+    bool writeJson(const QString& path) const;
+    /**
+     * @brief One line per category, largest first, for the debug panel
+     */
+    QString summary() const;
+
+    static QString formatBytes(std::size_t bytes);
+
+private:
+    Category& category(const std::string& name);
+
+    std::vector<Category> categories_;
+};
+
+} // namespace onecad::app::diagnostics
+
+#endif // ONECAD_APP_DIAGNOSTICS_MEMORYREPORT_H
@@ -36,6 +36,14 @@ Document::Document(QObject* parent)
 
 Document::~Document() = default;
 
+kernel::elementmap::ElementMap& Document::mutableElementMap() {
+    if (elementMap_.use_count() > 1) {
+        // A snapshot still reads this map; it keeps the old copy
+        elementMap_ = std::make_shared<kernel::elementmap::ElementMap>(*elementMap_);
+    }
+    return *elementMap_;
+}
+
 std::string Document::addSketch(std::unique_ptr<core::sketch::Sketch> sketch) {
     if (!sketch) {
         return {};
@@ -62,7 +70,7 @@ bool Document::addSketchWithId(const std::string& id,
     if (!sketch || id.empty()) {
         return false;
     }
-    if (sketches_.find(id) != sketches_.end()) {
+    if (isSketchLoaded(id) || pendingSketches_.count(id) > 0) {
         return false;  // ID already exists
     }
 
@@ -85,30 +93,51 @@ core::sketch::Sketch* Document::getSketch(const std::string& id) {
     if (it != sketches_.end()) {
         return it->second.get();
     }
+    auto captured = capturedSketches_.find(id);
+    if (captured != capturedSketches_.end()) {
+        auto sketch = core::sketch::Sketch::fromJson(captured->second);
+        capturedSketches_.erase(captured);
+        if (!sketch) {
+            qCWarning(logDocument) << "getSketch: failed to decode captured sketch" << QString::fromStdString(id);
+            return nullptr;
+        }
+        return (sketches_[id] = std::move(sketch)).get();
+    }
+    if (loadPendingSketch(id)) {
+        return sketches_[id].get();
+    }
     return nullptr;
 }
 
 const core::sketch::Sketch* Document::getSketch(const std::string& id) const {
-    auto it = sketches_.find(id);
-    if (it != sketches_.end()) {
-        return it->second.get();
-    }
-    return nullptr;
+    // Loading a pending sketch does not change the document's logical state
+    return const_cast<Document*>(this)->getSketch(id);
 }
 
 std::vector<std::string> Document::getSketchIds() const {
     std::vector<std::string> ids;
-    ids.reserve(sketches_.size());
+    ids.reserve(sketchCount());
     for (const auto& [id, sketch] : sketches_) {
         ids.push_back(id);
     }
+    for (const auto& [id, json] : capturedSketches_) {
+        ids.push_back(id);
+    }
+    ids.insert(ids.end(), pendingSketches_.begin(), pendingSketches_.end());
     return ids;
 }
 
 bool Document::removeSketch(const std::string& id) {
     auto it = sketches_.find(id);
     if (it == sketches_.end()) {
-        return false;
+        if (capturedSketches_.erase(id) == 0 && pendingSketches_.erase(id) == 0) {
+            return false;
+        }
+        sketchNames_.erase(id);
+        sketchVisibility_.erase(id);
+        setModified(true);
+        emit sketchRemoved(QString::fromStdString(id));
+        return true;
     }
 
     sketches_.erase(it);
@@ -129,7 +158,7 @@ std::string Document::getSketchName(const std::string& id) const {
 }
 
 void Document::setSketchName(const std::string& id, const std::string& name) {
-    if (sketches_.find(id) == sketches_.end()) {
+    if (!isSketchLoaded(id) && pendingSketches_.count(id) == 0) {
         return;
     }
 
@@ -159,6 +188,7 @@ void Document::setModified(bool modified) {
 
 void Document::clear() {
     sketches_.clear();
+    capturedSketches_.clear();
     sketchNames_.clear();
     sketchVisibility_.clear();
     bodies_.clear();
@@ -168,7 +198,14 @@ void Document::clear() {
     operations_.clear();
     suppressedOperations_.clear();
     operationFailures_.clear();
-    elementMap_.clear();
+    historyVerificationPending_ = false;
+    saveBaselinePath_.clear();
+    savedShapeRevisions_.clear();
+    entryLoader_.reset();
+    pendingSketches_.clear();
+    pendingBodies_.clear();
+    failedPendingEntries_.clear();
+    elementMap_ = std::make_shared<kernel::elementmap::ElementMap>();
     if (sceneMeshStore_) {
         sceneMeshStore_->clear();
     }
@@ -180,15 +217,52 @@ void Document::clear() {
     nextSketchNumber_ = 1;
     nextBodyNumber_ = 1;
     setModified(false);
+    changesToCommit().noteCleared();
     emit documentCleared();
 }
 
+std::unique_ptr<Document> Document::createSnapshot() const {
+    auto snapshot = std::make_unique<Document>();
+    snapshot->moveToThread(nullptr);
+
+    // Sketches hand out mutable pointers, so they cannot be shared; decoding
+    // the text is left to whoever uses the snapshot
+    snapshot->capturedSketches_ = capturedSketches_;
+    for (const auto& [id, sketch] : sketches_) {
+        snapshot->capturedSketches_[id] = sketch->toJson();
+    }
+    snapshot->entryLoader_ = entryLoader_;
+    snapshot->pendingSketches_ = pendingSketches_;
+    snapshot->pendingBodies_ = pendingBodies_;
+    snapshot->failedPendingEntries_ = failedPendingEntries_;
+    snapshot->sketchNames_ = sketchNames_;
+    snapshot->sketchVisibility_ = sketchVisibility_;
+    snapshot->bodies_ = bodies_;
+    snapshot->bodyNames_ = bodyNames_;
+    snapshot->bodyVisibilityCache_ = bodyVisibilityCache_;
+    snapshot->baseBodyIds_ = baseBodyIds_;
+    snapshot->operations_ = operations_;
+    snapshot->suppressedOperations_ = suppressedOperations_;
+    snapshot->operationFailures_ = operationFailures_;
+    snapshot->elementMap_ = elementMap_;
+    snapshot->modified_ = modified_;
+    snapshot->historyVerificationPending_ = historyVerificationPending_;
+    snapshot->nextShapeRevision_ = nextShapeRevision_;
+    snapshot->nextSketchNumber_ = nextSketchNumber_;
+    snapshot->nextBodyNumber_ = nextBodyNumber_;
+    return snapshot;
+}
+
 std::string Document::toJson() const {
     QJsonObject root;
 
     // Serialize sketches
     QJsonArray sketchArray;
-    for (const auto& [id, sketch] : sketches_) {
+    for (const auto& id : getSketchIds()) {
+        const core::sketch::Sketch* sketch = getSketch(id);
+        if (!sketch) {
+            continue;
+        }
         QJsonObject sketchObj;
         sketchObj["id"] = QString::fromStdString(id);
         sketchObj["name"] = QString::fromStdString(getSketchName(id));
@@ -258,13 +332,17 @@ std::string Document::addBody(const TopoDS_Shape& shape) {
     return id;
 }
 
+bool Document::prepareBodyMesh(const TopoDS_Shape& shape) const {
+    return tessellationCache_ && tessellationCache_->triangulate(shape);
+}
+
 bool Document::addBodyWithId(const std::string& id,
                              const TopoDS_Shape& shape,
                              const std::string& name) {
     if (shape.IsNull() || id.empty()) {
         return false;
     }
-    if (bodies_.find(id) != bodies_.end()) {
+    if (bodies_.find(id) != bodies_.end() || pendingBodies_.count(id) > 0) {
         return false;
     }
 
@@ -282,6 +360,7 @@ bool Document::addBodyWithId(const std::string& id,
 
     BodyEntry entry;
     entry.shape = shape;
+    entry.shapeRevision = nextShapeRevision_++;
     auto visibilityIt = bodyVisibilityCache_.find(id);
     if (visibilityIt != bodyVisibilityCache_.end()) {
         entry.visible = visibilityIt->second;
@@ -289,10 +368,11 @@ bool Document::addBodyWithId(const std::string& id,
     }
     bodies_[id] = entry;
 
-    elementMap_.rebindBody(id, shape);
+    mutableElementMap().rebindBody(id, shape);
     updateBodyMesh(id, shape, false);
 
     setModified(true);
+    changesToCommit().noteAdded(id);
     emit bodyAdded(QString::fromStdString(id));
     return true;
 }
@@ -302,13 +382,15 @@ bool Document::updateBodyShape(const std::string& id, const TopoDS_Shape& shape,
     if (shape.IsNull()) {
         return false;
     }
+    loadPendingBody(id);
     auto it = bodies_.find(id);
     if (it == bodies_.end()) {
         return false;
     }
 
     it->second.shape = shape;
-    elementMap_.rebindBody(id, shape, opId);
+    it->second.shapeRevision = nextShapeRevision_++;
+    mutableElementMap().rebindBody(id, shape, opId);
     updateBodyMesh(id, shape, emitSignal);
     setModified(true);
     return true;
@@ -317,7 +399,11 @@ bool Document::updateBodyShape(const std::string& id, const TopoDS_Shape& shape,
 const TopoDS_Shape* Document::getBodyShape(const std::string& id) const {
     auto it = bodies_.find(id);
     if (it == bodies_.end()) {
-        return nullptr;
+        // Loading a pending body does not change the document's logical state
+        if (!const_cast<Document*>(this)->loadPendingBody(id)) {
+            return nullptr;
+        }
+        it = bodies_.find(id);
     }
     return &it->second.shape;
 }
@@ -340,7 +426,7 @@ std::optional<core::sketch::SketchPlane> Document::getSketchPlaneForFace(const s
         return std::nullopt;
     }
 
-    const auto* faceEntry = elementMap_.find(kernel::elementmap::ElementId::From(faceId));
+    const auto* faceEntry = elementMap_->find(kernel::elementmap::ElementId::From(faceId));
     if (!faceEntry || faceEntry->kind != kernel::elementmap::ElementKind::Face ||
         faceEntry->shape.IsNull()) {
         qCWarning(logDocument) << "getSketchPlaneForFace:face-missing-or-not-face"
@@ -459,7 +545,7 @@ bool Document::projectHostFaceBoundaries(core::sketch::Sketch& sketch,
         return false;
     }
 
-    const auto* faceEntry = elementMap_.find(kernel::elementmap::ElementId::From(faceId));
+    const auto* faceEntry = elementMap_->find(kernel::elementmap::ElementId::From(faceId));
     if (!faceEntry || faceEntry->kind != kernel::elementmap::ElementKind::Face ||
         faceEntry->shape.IsNull()) {
         qCWarning(logDocument) << "projectHostFaceBoundaries:invalid-face-entry"
@@ -528,30 +614,42 @@ bool Document::projectHostFaceBoundaries(core::sketch::Sketch& sketch,
 
 std::vector<std::string> Document::getBodyIds() const {
     std::vector<std::string> ids;
-    ids.reserve(bodies_.size());
+    ids.reserve(bodies_.size() + pendingBodies_.size());
     for (const auto& [id, body] : bodies_) {
         (void)body;
         ids.push_back(id);
     }
+    ids.insert(ids.end(), pendingBodies_.begin(), pendingBodies_.end());
     return ids;
 }
 
 bool Document::removeBody(const std::string& id) {
     auto it = bodies_.find(id);
     if (it == bodies_.end()) {
-        return false;
+        if (pendingBodies_.erase(id) == 0) {
+            return false;
+        }
+        baseBodyIds_.erase(id);
+        bodyNames_.erase(id);
+        mutableElementMap().removeElementsForBody(id);
+        setModified(true);
+        changesToCommit().noteRemoved(id);
+        emit bodyRemoved(QString::fromStdString(id));
+        return true;
     }
 
     bodyVisibilityCache_.erase(id);
     baseBodyIds_.erase(id);
+    savedShapeRevisions_.erase(id);
     bodies_.erase(it);
     bodyNames_.erase(id);
     if (sceneMeshStore_) {
         sceneMeshStore_->removeBody(id);
     }
-    elementMap_.removeElementsForBody(id);
+    mutableElementMap().removeElementsForBody(id);
 
     setModified(true);
+    changesToCommit().noteRemoved(id);
     emit bodyRemoved(QString::fromStdString(id));
     return true;
 }
@@ -559,16 +657,25 @@ bool Document::removeBody(const std::string& id) {
 bool Document::removeBodyPreserveElementMap(const std::string& id) {
     auto it = bodies_.find(id);
     if (it == bodies_.end()) {
-        return false;
+        if (pendingBodies_.erase(id) == 0) {
+            return false;
+        }
+        bodyVisibilityCache_[id] = false;
+        setModified(true);
+        changesToCommit().noteRemoved(id);
+        emit bodyRemoved(QString::fromStdString(id));
+        return true;
     }
 
     bodyVisibilityCache_[id] = it->second.visible;
+    savedShapeRevisions_.erase(id);
     bodies_.erase(it);
     if (sceneMeshStore_) {
         sceneMeshStore_->removeBody(id);
     }
 
     setModified(true);
+    changesToCommit().noteRemoved(id);
     emit bodyRemoved(QString::fromStdString(id));
     return true;
 }
@@ -582,7 +689,7 @@ std::string Document::getBodyName(const std::string& id) const {
 }
 
 void Document::setBodyName(const std::string& id, const std::string& name) {
-    if (bodies_.find(id) == bodies_.end()) {
+    if (bodies_.find(id) == bodies_.end() && pendingBodies_.count(id) == 0) {
         return;
     }
 
@@ -615,6 +722,35 @@ bool Document::isBaseBody(const std::string& id) const {
     return baseBodyIds_.find(id) != baseBodyIds_.end();
 }
 
+bool Document::isBodyShapeSaved(const std::string& id) const {
+    if (pendingBodies_.count(id) > 0) {
+        return true;  // Never loaded, so the stored BREP is current
+    }
+    auto it = bodies_.find(id);
+    auto savedIt = savedShapeRevisions_.find(id);
+    return it != bodies_.end() && savedIt != savedShapeRevisions_.end() &&
+           savedIt->second == it->second.shapeRevision;
+}
+
+uint64_t Document::bodyShapeRevision(const std::string& id) const {
+    auto it = bodies_.find(id);
+    return it != bodies_.end() ? it->second.shapeRevision : 0;
+}
+
+void Document::markBodyShapeSaved(const std::string& id) {
+    auto it = bodies_.find(id);
+    if (it != bodies_.end()) {
+        savedShapeRevisions_[id] = it->second.shapeRevision;
+    }
+}
+
+void Document::markAllBodyShapesSaved() {
+    savedShapeRevisions_.clear();
+    for (const auto& [id, entry] : bodies_) {
+        savedShapeRevisions_[id] = entry.shapeRevision;
+    }
+}
+
 void Document::addOperation(const OperationRecord& record) {
     insertOperation(operations_.size(), record);
 }
@@ -772,6 +908,9 @@ bool Document::isBodyVisible(const std::string& id) const {
 }
 
 void Document::setBodyVisible(const std::string& id, bool visible) {
+    if (visible) {
+        loadPendingBody(id);  // Needs its mesh to be shown
+    }
     auto it = bodies_.find(id);
     if (it == bodies_.end()) {
         return;
@@ -780,6 +919,7 @@ void Document::setBodyVisible(const std::string& id, bool visible) {
         return;
     }
     it->second.visible = visible;
+    changesToCommit().noteVisibilityChanged(id);
     emit bodyVisibilityChanged(QString::fromStdString(id), visible);
 }
 
@@ -792,7 +932,7 @@ bool Document::isSketchVisible(const std::string& id) const {
 }
 
 void Document::setSketchVisible(const std::string& id, bool visible) {
-    if (sketches_.find(id) == sketches_.end()) {
+    if (!isSketchLoaded(id) && pendingSketches_.count(id) == 0) {
         return;
     }
     auto it = sketchVisibility_.find(id);
@@ -806,9 +946,10 @@ void Document::setSketchVisible(const std::string& id, bool visible) {
 // Isolation management
 
 void Document::isolateItem(const std::string& id) {
-    // Check if item exists
+    // Check if item exists (an isolated pending body is shown, so load it)
+    loadPendingBody(id);
     bool isBody = bodies_.find(id) != bodies_.end();
-    bool isSketch = sketches_.find(id) != sketches_.end();
+    bool isSketch = isSketchLoaded(id) || pendingSketches_.count(id) > 0;
     if (!isBody && !isSketch) {
         return;
     }
@@ -835,6 +976,7 @@ void Document::isolateItem(const std::string& id) {
         bool shouldBeVisible = (bodyId == id);
         if (entry.visible != shouldBeVisible) {
             entry.visible = shouldBeVisible;
+            changesToCommit().noteVisibilityChanged(bodyId);
             emit bodyVisibilityChanged(QString::fromStdString(bodyId), shouldBeVisible);
         }
     }
@@ -847,6 +989,7 @@ void Document::isolateItem(const std::string& id) {
     }
 
     isolatedItemId_ = id;
+    changesToCommit().isolationChanged = true;
     emit isolationChanged();
 }
 
@@ -861,6 +1004,7 @@ void Document::clearIsolation() {
         bool prevVisible = (it != preIsolationBodyVisibility_.end()) ? it->second : true;
         if (entry.visible != prevVisible) {
             entry.visible = prevVisible;
+            changesToCommit().noteVisibilityChanged(bodyId);
             emit bodyVisibilityChanged(QString::fromStdString(bodyId), prevVisible);
         }
     }
@@ -876,14 +1020,54 @@ void Document::clearIsolation() {
     isolatedItemId_.clear();
     preIsolationBodyVisibility_.clear();
     preIsolationSketchVisibility_.clear();
+    changesToCommit().isolationChanged = true;
     emit isolationChanged();
 }
 
+// Change notification batching
+
+void Document::beginChangeBatch() {
+    ++changeBatchDepth_;
+}
+
+void Document::endChangeBatch() {
+    if (changeBatchDepth_ == 0) {
+        return;
+    }
+    if (--changeBatchDepth_ == 0) {
+        flushChanges();
+    }
+}
+
+void Document::flushChanges() {
+    if (pendingChanges_.empty()) {
+        return;
+    }
+    DocumentChangeSet changes = std::move(pendingChanges_);
+    pendingChanges_.clear();
+    emit changesCommitted(changes);
+}
+
+DocumentChangeSet& Document::changesToCommit() {
+    if (changeBatchDepth_ == 0 && !changeFlushScheduled_) {
+        // Coalesce everything that happens during this event-loop iteration
+        changeFlushScheduled_ = true;
+        QMetaObject::invokeMethod(this, [this]() {
+            changeFlushScheduled_ = false;
+            if (changeBatchDepth_ == 0) {
+                flushChanges();
+            }
+        }, Qt::QueuedConnection);
+    }
+    return pendingChanges_;
+}
+
 void Document::registerBodyElements(const std::string& bodyId, const TopoDS_Shape& shape) {
     using kernel::elementmap::ElementId;
     using kernel::elementmap::ElementKind;
 
-    elementMap_.registerElement(ElementId::From(bodyId), ElementKind::Body, shape);
+    kernel::elementmap::ElementMap& elementMap = mutableElementMap();
+    elementMap.registerElement(ElementId::From(bodyId), ElementKind::Body, shape);
 
     TopTools_IndexedMapOfShape faceMap;
     TopTools_IndexedMapOfShape edgeMap;
@@ -895,19 +1079,19 @@ void Document::registerBodyElements(const std::string& bodyId, const TopoDS_Shap
     for (int i = 1; i <= faceMap.Extent(); ++i) {
         TopoDS_Face face = TopoDS::Face(faceMap(i));
         std::string faceId = bodyId + "/face/" + std::to_string(i - 1);
-        elementMap_.registerElement(ElementId::From(faceId), ElementKind::Face, face);
+        elementMap.registerElement(ElementId::From(faceId), ElementKind::Face, face);
     }
 
     for (int i = 1; i <= edgeMap.Extent(); ++i) {
         TopoDS_Edge edge = TopoDS::Edge(edgeMap(i));
         std::string edgeId = bodyId + "/edge/" + std::to_string(i - 1);
-        elementMap_.registerElement(ElementId::From(edgeId), ElementKind::Edge, edge);
+        elementMap.registerElement(ElementId::From(edgeId), ElementKind::Edge, edge);
     }
 
     for (int i = 1; i <= vertexMap.Extent(); ++i) {
         TopoDS_Vertex vertex = TopoDS::Vertex(vertexMap(i));
         std::string vertexId = bodyId + "/vertex/" + std::to_string(i - 1);
-        elementMap_.registerElement(ElementId::From(vertexId), ElementKind::Vertex, vertex);
+        elementMap.registerElement(ElementId::From(vertexId), ElementKind::Vertex, vertex);
     }
 }
 
@@ -917,17 +1101,110 @@ void Document::updateBodyMesh(const std::string& bodyId,
     if (!sceneMeshStore_ || !tessellationCache_) {
         return;
     }
-    render::SceneMeshStore::Mesh mesh = tessellationCache_->buildMesh(bodyId, shape, elementMap_);
+    render::SceneMeshStore::Mesh mesh = tessellationCache_->buildMesh(bodyId, shape, mutableElementMap());
     sceneMeshStore_->setBodyMesh(bodyId, std::move(mesh));
     if (emitSignal) {
+        changesToCommit().noteUpdated(bodyId);
         emit bodyUpdated(QString::fromStdString(bodyId));
     }
 }
 
+bool Document::addPendingSketch(const std::string& id, const std::string& name) {
+    if (id.empty() || isSketchLoaded(id) || !pendingSketches_.insert(id).second) {
+        return false;
+    }
+    sketchNames_[id] = name.empty() ? "Sketch " + std::to_string(nextSketchNumber_++) : name;
+    sketchVisibility_[id] = true;
+    emit sketchAdded(QString::fromStdString(id));
+    return true;
+}
+
+bool Document::addPendingBody(const std::string& id, const std::string& name) {
+    if (id.empty() || bodies_.find(id) != bodies_.end() || !pendingBodies_.insert(id).second) {
+        return false;
+    }
+    bodyNames_[id] = name.empty() ? "Body " + std::to_string(nextBodyNumber_++) : name;
+    changesToCommit().noteAdded(id);
+    emit bodyAdded(QString::fromStdString(id));
+    return true;
+}
+
+bool Document::loadPendingEntries() {
+    bool ok = true;
+    const std::vector<std::string> sketchIds(pendingSketches_.begin(), pendingSketches_.end());
+    for (const auto& id : sketchIds) {
+        ok = loadPendingSketch(id) && ok;
+    }
+    const std::vector<std::string> bodyIds(pendingBodies_.begin(), pendingBodies_.end());
+    for (const auto& id : bodyIds) {
+        ok = loadPendingBody(id) && ok;
+    }
+    if (ok) {
+        entryLoader_.reset();
+    }
+    return ok;
+}
+
+void Document::notePendingLoadFailure(const std::string& id, const std::string& name,
+                                      const std::string& error) {
+    qCWarning(logDocument) << "loadPending:failed" << QString::fromStdString(id)
+                           << QString::fromStdString(error);
+    if (failedPendingEntries_.insert(id).second) {
+        emit pendingEntryLoadFailed(QString::fromStdString(id), QString::fromStdString(name),
+                                    QString::fromStdString(error));
+    }
+}
+
+bool Document::loadPendingSketch(const std::string& id) {
+    if (pendingSketches_.count(id) == 0 || failedPendingEntries_.count(id) > 0) {
+        return false;
+    }
+
+    std::string error = "No entry loader";
+    auto sketch = entryLoader_ ? entryLoader_->loadSketch(id, error) : nullptr;
+    if (!sketch) {
+        // Stays pending: saving keeps the stored entry instead of dropping it
+        notePendingLoadFailure(id, getSketchName(id), error);
+        return false;
+    }
+
+    pendingSketches_.erase(id);
+    sketches_[id] = std::move(sketch);
+    qCDebug(logDocument) << "loadPendingSketch:loaded" << QString::fromStdString(id);
+    return true;
+}
+
+bool Document::loadPendingBody(const std::string& id) {
+    if (pendingBodies_.count(id) == 0 || failedPendingEntries_.count(id) > 0) {
+        return false;
+    }
+
+    std::string error = "No entry loader";
+    TopoDS_Shape shape = entryLoader_ ? entryLoader_->loadBodyShape(id, error) : TopoDS_Shape();
+    if (shape.IsNull()) {
+        notePendingLoadFailure(id, getBodyName(id), error);
+        return false;
+    }
+
+    pendingBodies_.erase(id);
+    BodyEntry entry;
+    entry.shape = shape;
+    entry.visible = false;
+    entry.shapeRevision = nextShapeRevision_++;
+    bodies_[id] = entry;
+    // Matches the stored BREP until the shape changes (incremental save)
+    savedShapeRevisions_[id] = entry.shapeRevision;
+
+    mutableElementMap().rebindBody(id, shape);
+    updateBodyMesh(id, shape, false);
+    qCDebug(logDocument) << "loadPendingBody:loaded" << QString::fromStdString(id);
+    return true;
+}
+
 void Document::rebuildElementMap() {
-    elementMap_.clear();
+    elementMap_ = std::make_shared<kernel::elementmap::ElementMap>();
     for (const auto& [id, body] : bodies_) {
-        elementMap_.rebindBody(id, body.shape);
+        elementMap_->rebindBody(id, body.shape);
     }
 }
 
@@ -8,6 +8,7 @@
 
 #include <QObject>
 #include <QString>
+#include <cstdint>
 #include <memory>
 #include <optional>
 #include <string>
@@ -17,6 +18,8 @@
 
 #include <TopoDS_Shape.hxx>
 
+#include "DocumentChangeSet.h"
+#include "DocumentEntryLoader.h"
 #include "OperationRecord.h"
 #include "../../core/sketch/Sketch.h"
 #include "../../kernel/elementmap/ElementMap.h"
@@ -69,7 +72,9 @@ public:
     /**
      * @brief Get number of sketches
      */
-    size_t sketchCount() const { return sketches_.size(); }
+    size_t sketchCount() const {
+        return sketches_.size() + capturedSketches_.size() + pendingSketches_.size();
+    }
 
     /**
      * @brief Remove sketch by ID
@@ -92,6 +97,21 @@ public:
     void setModified(bool modified);
     void clear();
 
+    /**
+     * @brief Detached copy of the persistent document state for background saving
+     *
+     * Body shapes are shared with this document (TopoDS_Shape is a handle and
+     * shapes are replaced, never edited, by updateBodyShape) and so is the
+     * ElementMap, copy-on-write through mutableElementMap(). Sketches are
+     * captured as JSON text and only rebuilt when the snapshot first asks
+     * for them, i.e. on the thread that uses it; history is copied. No
+     * meshes are built, no signals are emitted, and isolation state is not
+     * carried over.
+     * The copy has no thread affinity, so a worker may own and destroy it.
+     * Saved-shape marks and the save baseline are not copied.
+     */
+    std::unique_ptr<Document> createSnapshot() const;
+
     // Serialization
     std::string toJson() const;
     static std::unique_ptr<Document> fromJson(const std::string& json, QObject* parent = nullptr);
@@ -99,6 +119,13 @@ public:
     // Body management
     std::string addBody(const TopoDS_Shape& shape);
     bool addBodyWithId(const std::string& id, const TopoDS_Shape& shape, const std::string& name = {});
+    /**
+     * @brief Triangulate a shape before it is added (thread-safe)
+     *
+     * Lets importers mesh on worker threads so addBody() only builds the
+     * scene mesh from the existing triangulation.
+     */
+    bool prepareBodyMesh(const TopoDS_Shape& shape) const;
     bool updateBodyShape(const std::string& id, const TopoDS_Shape& shape,
                          bool emitSignal = true, const std::string& opId = {});
     const TopoDS_Shape* getBodyShape(const std::string& id) const;
@@ -113,7 +140,7 @@ public:
     bool removeBodyPreserveElementMap(const std::string& id);
     std::string getBodyName(const std::string& id) const;
     void setBodyName(const std::string& id, const std::string& name);
-    size_t bodyCount() const { return bodies_.size(); }
+    size_t bodyCount() const { return bodies_.size() + pendingBodies_.size(); }
     void setBaseBodyIds(const std::unordered_set<std::string>& ids);
     void addBaseBodyId(const std::string& id);
     bool isBaseBody(const std::string& id) const;
@@ -140,6 +167,63 @@ public:
     }
     const std::vector<OperationRecord>& operations() const { return operations_; }
 
+    /**
+     * @brief Bodies were opened from a trusted BREP cache and history has not been replayed yet
+     */
+    bool isHistoryVerificationPending() const { return historyVerificationPending_; }
+    void setHistoryVerificationPending(bool pending) { historyVerificationPending_ = pending; }
+
+    /**
+     * @brief Package file the saved-shape marks refer to (empty if never saved/loaded)
+     *
+     * Incremental saves to this path may keep a body's stored BREP instead of
+     * re-encoding it while isBodyShapeSaved() holds.
+     */
+    const QString& saveBaselinePath() const { return saveBaselinePath_; }
+    void setSaveBaselinePath(const QString& path) { saveBaselinePath_ = path; }
+
+    /**
+     * @brief Body shape is unchanged since it was last saved to / loaded from the baseline
+     */
+    bool isBodyShapeSaved(const std::string& id) const;
+    /**
+     * @brief Revision of a body's shape, bumped on every shape change (0 if unknown)
+     */
+    uint64_t bodyShapeRevision(const std::string& id) const;
+    void markBodyShapeSaved(const std::string& id);
+    void markAllBodyShapesSaved();
+
+    /**
+     * @brief Source for pending (not yet loaded) sketches and bodies
+     *
+     * Pending entries are listed by getSketchIds()/getBodyIds() with their
+     * names, and are loaded on first access: getSketch(), getBodyShape(),
+     * or showing a pending body. Pending bodies are hidden. Nothing is
+     * emitted when an entry loads, since it was already listed.
+     *
+     * An entry that fails to load stays pending, so saving keeps its stored
+     * copy; pendingEntryLoadFailed() is emitted once and later accesses
+     * return nullptr without reading again until the loader is replaced.
+     */
+    void setEntryLoader(std::shared_ptr<DocumentEntryLoader> loader) {
+        entryLoader_ = std::move(loader);
+        failedPendingEntries_.clear();
+    }
+    DocumentEntryLoader* entryLoader() const { return entryLoader_.get(); }
+    bool addPendingSketch(const std::string& id, const std::string& name = {});
+    bool addPendingBody(const std::string& id, const std::string& name = {});
+    bool isSketchLoaded(const std::string& id) const {
+        return sketches_.count(id) > 0 || capturedSketches_.count(id) > 0;
+    }
+    bool isBodyLoaded(const std::string& id) const { return bodies_.count(id) > 0; }
+    size_t pendingEntryCount() const { return pendingSketches_.size() + pendingBodies_.size(); }
+    /**
+     * @brief Load every pending entry now and drop the loader (before its source goes away)
+     * @return false if some entry could not be loaded; it stays pending and
+     *         the loader is kept, so the source must not be removed
+     */
+    bool loadPendingEntries();
+
     // Visibility management
     bool isBodyVisible(const std::string& id) const;
     void setBodyVisible(const std::string& id, bool visible);
@@ -152,10 +236,55 @@ public:
     bool isIsolationActive() const { return !isolatedItemId_.empty(); }
     std::string isolatedItemId() const { return isolatedItemId_; }
 
+    // Change notification batching
+    /**
+     * @brief Start collecting body changes without delivering them
+     *
+     * Body changes are always coalesced into a DocumentChangeSet and
+     * delivered once through changesCommitted(): when the outermost batch
+     * ends, or otherwise on the next event-loop iteration. Batches nest.
+     * The per-body signals are still emitted as changes happen.
+     */
+    void beginChangeBatch();
+    void endChangeBatch();
+    /**
+     * @brief Deliver collected changes now, even inside a batch
+     */
+    void flushChanges();
+    bool hasPendingChanges() const { return !pendingChanges_.empty(); }
+
+    /**
+     * @brief Scope guard for beginChangeBatch()/endChangeBatch()
+     */
+    class ChangeBatch {
+    public:
+        explicit ChangeBatch(Document* doc) : doc_(doc) {
+            if (doc_) {
+                doc_->beginChangeBatch();
+            }
+        }
+        ~ChangeBatch() {
+            if (doc_) {
+                doc_->endChangeBatch();
+            }
+        }
+        ChangeBatch(const ChangeBatch&) = delete;
+        ChangeBatch& operator=(const ChangeBatch&) = delete;
+
+    private:
+        Document* doc_;
+    };
+
     render::SceneMeshStore& meshStore() { return *sceneMeshStore_; }
     const render::SceneMeshStore& meshStore() const { return *sceneMeshStore_; }
-    kernel::elementmap::ElementMap& elementMap() { return elementMap_; }
-    const kernel::elementmap::ElementMap& elementMap() const { return elementMap_; }
+    const kernel::elementmap::ElementMap& elementMap() const { return *elementMap_; }
+    /**
+     * @brief ElementMap for modification
+     *
+     * The map is shared copy-on-write with snapshots; it is copied here
+     * first if a snapshot still refers to it. Read through elementMap().
+     */
+    kernel::elementmap::ElementMap& mutableElementMap();
 
 signals:
     void sketchAdded(const QString& id);
@@ -170,24 +299,40 @@ signals:
     void isolationChanged();
     void modifiedChanged(bool modified);
     void documentCleared();
+    /**
+     * @brief Coalesced body changes (see beginChangeBatch())
+     */
+    void changesCommitted(const onecad::app::DocumentChangeSet& changes);
     void operationAdded(const QString& opId);
     void operationRemoved(const QString& opId);
     void operationUpdated(const QString& opId);
     void operationSuppressionChanged(const QString& opId, bool suppressed);
     void operationFailed(const QString& opId, const QString& reason);
     void operationSucceeded(const QString& opId);
+    /**
+     * @brief A pending sketch or body could not be read from its source
+     */
+    void pendingEntryLoadFailed(const QString& id, const QString& name, const QString& error);
 
 private:
     struct BodyEntry {
         TopoDS_Shape shape;
         bool visible = true;
+        uint64_t shapeRevision = 0;  ///< Bumped on every shape change (save tracking)
     };
 
     void registerBodyElements(const std::string& bodyId, const TopoDS_Shape& shape);
     void updateBodyMesh(const std::string& bodyId, const TopoDS_Shape& shape, bool emitSignal = true);
     void rebuildElementMap();
+    bool loadPendingSketch(const std::string& id);
+    bool loadPendingBody(const std::string& id);
+    void notePendingLoadFailure(const std::string& id, const std::string& name,
+                                const std::string& error);
+    /// Pending change set; schedules its delivery
+    DocumentChangeSet& changesToCommit();
 
     std::unordered_map<std::string, std::unique_ptr<core::sketch::Sketch>> sketches_;
+    std::unordered_map<std::string, std::string> capturedSketches_;  // Snapshots: id -> Sketch::toJson(), decoded on first access
     std::unordered_map<std::string, std::string> sketchNames_;  // id -> display name
     std::unordered_map<std::string, bool> sketchVisibility_;    // id -> visible
     std::unordered_map<std::string, BodyEntry> bodies_;
@@ -202,12 +347,24 @@ private:
     std::vector<OperationRecord> operations_;
     std::unordered_set<std::string> suppressedOperations_;
     std::unordered_map<std::string, std::string> operationFailures_;
-    kernel::elementmap::ElementMap elementMap_;
+    std::shared_ptr<kernel::elementmap::ElementMap> elementMap_ =
+        std::make_shared<kernel::elementmap::ElementMap>();  // Shared with snapshots until modified
     std::unique_ptr<render::SceneMeshStore> sceneMeshStore_;
     std::unique_ptr<render::TessellationCache> tessellationCache_;
     bool modified_ = false;
+    bool historyVerificationPending_ = false;
+    QString saveBaselinePath_;
+    std::unordered_map<std::string, uint64_t> savedShapeRevisions_;  // body id -> revision on disk
+    uint64_t nextShapeRevision_ = 1;
+    std::shared_ptr<DocumentEntryLoader> entryLoader_;
+    std::unordered_set<std::string> pendingSketches_;  // Listed, loaded on first access
+    std::unordered_set<std::string> pendingBodies_;    // Hidden, loaded on first access
+    std::unordered_set<std::string> failedPendingEntries_;  // Not retried until the loader changes
     unsigned int nextSketchNumber_ = 1;
     unsigned int nextBodyNumber_ = 1;
+    DocumentChangeSet pendingChanges_;
+    int changeBatchDepth_ = 0;
+    bool changeFlushScheduled_ = false;
 };
 
 } // namespace onecad::app
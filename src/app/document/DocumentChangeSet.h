@@ -0,0 +1,76 @@
+/**
+ * @file DocumentChangeSet.h
+ * @brief Coalesced per-body delta delivered by Document::changesCommitted
+ */
+#ifndef ONECAD_APP_DOCUMENT_DOCUMENTCHANGESET_H
+#define ONECAD_APP_DOCUMENT_DOCUMENTCHANGESET_H
+
+#include <string>
+#include <unordered_set>
+
+namespace onecad::app {
+
+/**
+ * @brief Net body changes since the last delivered change set
+ *
+ * Each body id appears in at most one of added/removed/updated, reflecting
+ * the net effect of everything that happened in the batch: a body added
+ * and removed again is absent, a body removed and re-added (undo/redo,
+ * regeneration) is updated. visibilityChanged lists bodies whose
+ * visibility flag flipped and that still exist; query the document for
+ * the current value.
+ */
+struct DocumentChangeSet {
+    std::unordered_set<std::string> added;
+    std::unordered_set<std::string> removed;
+    std::unordered_set<std::string> updated;
+    std::unordered_set<std::string> visibilityChanged;
+    bool isolationChanged = false;
+    /// Document was cleared; consumers should resync everything
+    bool cleared = false;
+
+    bool empty() const {
+        return added.empty() && removed.empty() && updated.empty() &&
+               visibilityChanged.empty() && !isolationChanged && !cleared;
+    }
+
+    void clear() { *this = DocumentChangeSet{}; }
+
+    void noteAdded(const std::string& id) {
+        if (removed.erase(id) > 0) {
+            updated.insert(id);  // Existed before the batch
+        } else {
+            added.insert(id);
+        }
+    }
+
+    void noteRemoved(const std::string& id) {
+        updated.erase(id);
+        visibilityChanged.erase(id);
+        if (added.erase(id) == 0) {
+            removed.insert(id);  // Did not exist before the batch otherwise
+        }
+    }
+
+    void noteUpdated(const std::string& id) {
+        if (added.count(id) == 0) {
+            updated.insert(id);
+        }
+    }
+
+    void noteVisibilityChanged(const std::string& id) {
+        // Flipping back within the batch is no net change
+        if (visibilityChanged.erase(id) == 0) {
+            visibilityChanged.insert(id);
+        }
+    }
+
+    void noteCleared() {
+        clear();
+        cleared = true;
+    }
+};
+
+} // namespace onecad::app
+
+#endif // ONECAD_APP_DOCUMENT_DOCUMENTCHANGESET_H
@@ -0,0 +1,47 @@
+/**
+ * @file DocumentEntryLoader.h
+ * @brief Source for document entries that are materialized on first access
+ */
+#ifndef ONECAD_APP_DOCUMENT_DOCUMENTENTRYLOADER_H
+#define ONECAD_APP_DOCUMENT_DOCUMENTENTRYLOADER_H
+
+#include <memory>
+#include <string>
+
+#include <TopoDS_Shape.hxx>
+
+namespace onecad::core::sketch {
+class Sketch;
+}
+
+namespace onecad::app {
+
+/**
+ * @brief Loads pending sketches and bodies for Document
+ *
+ * Registered with Document::setEntryLoader() by the file loader. The
+ * document keeps names and visibility of pending entries and asks the
+ * loader for their content on first access. Implementations must be
+ * thread-safe: snapshots taken for background saving share the loader.
+ */
+class DocumentEntryLoader {
+public:
+    virtual ~DocumentEntryLoader() = default;
+
+    /**
+     * @brief Load a sketch entry
+     * @return Sketch, or nullptr on error (errorMessage set)
+     */
+    virtual std::unique_ptr<core::sketch::Sketch> loadSketch(const std::string& id,
+                                                            std::string& errorMessage) = 0;
+
+    /**
+     * @brief Load a body's stored shape
+     * @return Shape, or a null shape on error (errorMessage set)
+     */
+    virtual TopoDS_Shape loadBodyShape(const std::string& id, std::string& errorMessage) = 0;
+};
+
+} // namespace onecad::app
+
+#endif // ONECAD_APP_DOCUMENT_DOCUMENTENTRYLOADER_H
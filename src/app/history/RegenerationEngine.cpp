@@ -11,6 +11,7 @@
 #include "../../core/sketch/Sketch.h"
 #include "../../core/sketch/SketchLine.h"
 #include "../../core/sketch/SketchPoint.h"
+#include "../../core/trace/Trace.h"
 
 #include <QLoggingCategory>
 #include <QString>
@@ -43,6 +44,18 @@ namespace onecad::app::history {
 Q_LOGGING_CATEGORY(logRegen, "onecad.app.history.regeneration")
 
 namespace {
+
+const char* operationTraceName(OperationType type) {
+    switch (type) {
+    case OperationType::Extrude: return "op.extrude";
+    case OperationType::Revolve: return "op.revolve";
+    case OperationType::Fillet: return "op.fillet";
+    case OperationType::Chamfer: return "op.chamfer";
+    case OperationType::Shell: return "op.shell";
+    case OperationType::Boolean: return "op.boolean";
+    }
+    return "op.unknown";
+}
 constexpr double kDraftAngleEpsilon = 1e-4;
 constexpr double kSideFaceDotThreshold = 0.9;
 constexpr double kMinValue = 1e-3;
@@ -63,6 +76,7 @@ RegenerationEngine::RegenerationEngine(Document* doc)
 }
 
 RegenResult RegenerationEngine::regenerateAll() {
+    ONECAD_TRACE_SCOPE("regen", "regenerateAll");
     RegenResult result;
     qCInfo(logRegen) << "regenerateAll:start";
 
@@ -72,6 +86,9 @@ RegenResult RegenerationEngine::regenerateAll() {
         return result;
     }
 
+    // Deliver body changes to the viewport as one delta
+    Document::ChangeBatch changeBatch(doc_);
+
     // Rebuild dependency graph from current operations
     graph_.rebuildFromOperations(doc_->operations());
     for (const auto& op : doc_->operations()) {
@@ -211,6 +228,7 @@ RegenResult RegenerationEngine::regenerateAll() {
 }
 
 RegenResult RegenerationEngine::regenerateFrom(const std::string& opId) {
+    ONECAD_TRACE_SCOPE("regen", "regenerateFrom");
     RegenResult result;
 
     if (!doc_) {
@@ -218,6 +236,8 @@ RegenResult RegenerationEngine::regenerateFrom(const std::string& opId) {
         return result;
     }
 
+    Document::ChangeBatch changeBatch(doc_);
+
     // Ensure graph is up to date
     graph_.rebuildFromOperations(doc_->operations());
     for (const auto& op : doc_->operations()) {
@@ -411,6 +431,8 @@ std::optional<TopoDS_Shape> RegenerationEngine::resolveBody(const std::string& b
 }
 
 bool RegenerationEngine::executeOperation(const OperationRecord& op, std::string& errorOut) {
+    ONECAD_TRACE_NAMED_SCOPE(trace, "regen", operationTraceName(op.type));
+    ONECAD_TRACE_ARG(trace, "opId", op.opId);
     qCDebug(logRegen) << "executeOperation:start"
                       << "opId=" << QString::fromStdString(op.opId)
                       << "type=" << static_cast<int>(op.type)
@@ -1128,7 +1150,7 @@ void RegenerationEngine::applyBodyResult(const std::string& bodyId, const TopoDS
         doc_->updateBodyShape(bodyId, shape, true, opId);
     } else {
         doc_->addBodyWithId(bodyId, shape);
-        doc_->elementMap().rebindBody(bodyId, shape, opId);
+        doc_->mutableElementMap().rebindBody(bodyId, shape, opId);
     }
 }
 
@@ -1,5 +1,7 @@
 #include "AdjacencyGraph.h"
 
+#include <cmath>
+
 namespace onecad::core::loop {
 
 namespace {
@@ -23,15 +25,42 @@ int AdjacencyGraph::findOrCreateNode(const sk::Vec2d& pos,
         }
     }
 
-    for (size_t i = 0; i < nodes.size(); ++i) {
-        if (distanceSquared(nodes[i].position, pos) <= tol2) {
-            if (pointId) {
-                nodeByPointId[*pointId] = static_cast<int>(i);
-                nodes[i].pointIds.push_back(*pointId);
+    double cellSize = tolerance > 0.0 ? tolerance : 1.0;
+    if (cellSize != nodeCellSize_) {
+        nodeCellSize_ = cellSize;
+        nodeCells_.clear();
+        for (size_t i = 0; i < nodes.size(); ++i) {
+            nodeCells_[nodeCellKey(nodeCellCoord(nodes[i].position.x),
+                                   nodeCellCoord(nodes[i].position.y))]
+                .push_back(static_cast<int>(i));
+        }
+    }
+
+    // Lowest-index node within tolerance, as a linear scan would find
+    int match = -1;
+    const long long cellX = nodeCellCoord(pos.x);
+    const long long cellY = nodeCellCoord(pos.y);
+    for (long long x = cellX - 1; x <= cellX + 1; ++x) {
+        for (long long y = cellY - 1; y <= cellY + 1; ++y) {
+            auto it = nodeCells_.find(nodeCellKey(x, y));
+            if (it == nodeCells_.end()) {
+                continue;
+            }
+            for (int i : it->second) {
+                if ((match < 0 || i < match) &&
+                    distanceSquared(nodes[i].position, pos) <= tol2) {
+                    match = i;
+                }
             }
-            return static_cast<int>(i);
         }
     }
+    if (match >= 0) {
+        if (pointId) {
+            nodeByPointId[*pointId] = match;
+            nodes[match].pointIds.push_back(*pointId);
+        }
+        return match;
+    }
 
     GraphNode node;
     node.position = pos;
@@ -44,7 +73,16 @@ int AdjacencyGraph::findOrCreateNode(const sk::Vec2d& pos,
     }
 
     nodes.push_back(std::move(node));
+    nodeCells_[nodeCellKey(nodeCellCoord(pos.x), nodeCellCoord(pos.y))].push_back(static_cast<int>(nodes.size() - 1));
     return static_cast<int>(nodes.size() - 1);
 }
 
+long long AdjacencyGraph::nodeCellKey(long long cellX, long long cellY) const {
+    return (cellX << 32) ^ (cellY & 0xffffffffLL);
+}
+
+long long AdjacencyGraph::nodeCellCoord(double value) const {
+    return static_cast<long long>(std::floor(value / nodeCellSize_));
+}
+
 } // namespace onecad::core::loop
@@ -41,6 +41,14 @@ struct AdjacencyGraph {
     int findOrCreateNode(const sk::Vec2d& pos,
                          const std::optional<sk::EntityID>& pointId,
                          double tolerance);
+
+private:
+    // Node lookup grid with tolerance-sized cells (rebuilt if tolerance changes)
+    std::unordered_map<long long, std::vector<int>> nodeCells_;
+    double nodeCellSize_ = 0.0;
+
+    long long nodeCellKey(long long cellX, long long cellY) const;
+    long long nodeCellCoord(double value) const;
 };
 
 } // namespace onecad::core::loop
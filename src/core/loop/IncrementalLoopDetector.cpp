@@ -0,0 +1,339 @@
+/**
+ * @file IncrementalLoopDetector.cpp
+ * @brief Component-cached loop detection
+ */
+#include "IncrementalLoopDetector.h"
+
+#include "../sketch/Sketch.h"
+#include "../sketch/SketchLine.h"
+#include "../sketch/SpatialRTree.h"
+#include "../trace/Trace.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <unordered_set>
+
+namespace onecad::core::loop {
+
+namespace {
+
+uint64_t mixHash(uint64_t seed, uint64_t value) {
+    return seed ^ (value + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2));
+}
+
+uint64_t hashDouble(double value) {
+    uint64_t bits = 0;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+uint64_t hashId(const sk::EntityID& id) {
+    return static_cast<uint64_t>(std::hash<sk::EntityID>{}(id));
+}
+
+bool isLoopCurve(sk::EntityType type) {
+    return type == sk::EntityType::Line || type == sk::EntityType::Arc ||
+           type == sk::EntityType::Circle;
+}
+
+size_t findRoot(std::vector<size_t>& parent, size_t i) {
+    while (parent[i] != i) {
+        parent[i] = parent[parent[i]];
+        i = parent[i];
+    }
+    return i;
+}
+
+} // namespace
+
+IncrementalLoopDetector::IncrementalLoopDetector()
+    : detector_() {
+}
+
+IncrementalLoopDetector::IncrementalLoopDetector(const LoopDetectorConfig& config)
+    : detector_(config) {
+}
+
+void IncrementalLoopDetector::setConfig(const LoopDetectorConfig& config) {
+    detector_.setConfig(config);
+    clear();
+}
+
+void IncrementalLoopDetector::clear() {
+    cache_.clear();
+    stats_ = {};
+    sketchInstance_ = 0;
+    members_.clear();
+    components_.clear();
+    tree_.clear();
+}
+
+void IncrementalLoopDetector::refreshMember(const sk::SketchEntity& entity,
+                                            const sk::Sketch& sketch,
+                                            Member& member) const {
+    member.active = false;
+    member.bounds = {};
+    member.fingerprint = 0;
+    if (entity.isConstruction()) {
+        return;
+    }
+    std::vector<sk::Vec2d> outline = detector_.entityOutline(entity, sketch);
+    if (outline.empty()) {
+        return;
+    }
+
+    const double tolerance = detector_.getConfig().coincidenceTolerance;
+    member.active = true;
+    member.fingerprint = mixHash(hashId(entity.id()), static_cast<uint64_t>(entity.type()));
+    if (auto* line = dynamic_cast<const sk::SketchLine*>(&entity)) {
+        member.fingerprint = mixHash(member.fingerprint, hashId(line->startPointId()));
+        member.fingerprint = mixHash(member.fingerprint, hashId(line->endPointId()));
+    }
+
+    double minChord = std::numeric_limits<double>::infinity();
+    for (size_t i = 0; i < outline.size(); ++i) {
+        const auto& p = outline[i];
+        member.bounds.minX = std::min(member.bounds.minX, p.x);
+        member.bounds.minY = std::min(member.bounds.minY, p.y);
+        member.bounds.maxX = std::max(member.bounds.maxX, p.x);
+        member.bounds.maxY = std::max(member.bounds.maxY, p.y);
+        member.fingerprint = mixHash(member.fingerprint, hashDouble(p.x));
+        member.fingerprint = mixHash(member.fingerprint, hashDouble(p.y));
+        if (i > 0) {
+            double chord = std::hypot(p.x - outline[i - 1].x, p.y - outline[i - 1].y);
+            if (chord > tolerance) {
+                minChord = std::min(minChord, chord);
+            }
+        }
+    }
+
+    // Same slack as the planarizer's tolerance predicates, plus node merging
+    double diag = std::hypot(member.bounds.maxX - member.bounds.minX,
+                             member.bounds.maxY - member.bounds.minY);
+    double pad = tolerance * (2.0 + diag);
+    if (std::isfinite(minChord)) {
+        pad += tolerance / minChord;
+    }
+    member.bounds.minX -= pad;
+    member.bounds.minY -= pad;
+    member.bounds.maxX += pad;
+    member.bounds.maxY += pad;
+}
+
+void IncrementalLoopDetector::repartition(const std::vector<sk::EntityID>& touched,
+                                          std::vector<uint64_t> affected,
+                                          const sk::Sketch& sketch) {
+    // Curves to re-partition: touched ones plus every member of a component
+    // they touched. Overlaps reaching another component pull it in too, so
+    // components left out cannot be connected to anything that changed.
+    std::unordered_set<uint64_t> affectedSet(affected.begin(), affected.end());
+    std::unordered_map<sk::EntityID, size_t> slotById;
+    std::vector<sk::EntityID> region;
+    auto addToRegion = [&](const sk::EntityID& id) {
+        auto member = members_.find(id);
+        if (member == members_.end() || !member->second.active) {
+            return;
+        }
+        if (slotById.try_emplace(id, region.size()).second) {
+            region.push_back(id);
+        }
+    };
+    auto addComponent = [&](uint64_t componentId) {
+        auto component = components_.find(componentId);
+        if (component == components_.end()) {
+            return;
+        }
+        for (const auto& id : component->second.entityIds) {
+            addToRegion(id);
+        }
+        components_.erase(component);
+    };
+
+    for (const auto& id : touched) {
+        addToRegion(id);
+    }
+    for (uint64_t componentId : affected) {
+        addComponent(componentId);
+    }
+
+    // The region grows while it is scanned; new curves start as their own roots
+    std::vector<size_t> parent;
+    auto growParent = [&]() {
+        while (parent.size() < region.size()) {
+            parent.push_back(parent.size());
+        }
+    };
+    for (size_t i = 0; i < region.size(); ++i) {
+        growParent();
+        const sk::EntityID id = region[i];
+        for (const auto& otherId : tree_.query(members_[id].bounds)) {
+            auto slot = slotById.find(otherId);
+            if (slot == slotById.end()) {
+                const uint64_t componentId = members_[otherId].component;
+                if (affectedSet.insert(componentId).second) {
+                    addComponent(componentId);
+                }
+                slot = slotById.find(otherId);
+                if (slot == slotById.end()) {
+                    continue;
+                }
+            }
+            growParent();
+            size_t a = findRoot(parent, i);
+            size_t b = findRoot(parent, slot->second);
+            if (a != b) {
+                parent[std::max(a, b)] = std::min(a, b);
+            }
+        }
+    }
+
+    growParent();
+
+    const sk::SketchSpatialIndex& index = sketch.spatialIndex();
+    std::unordered_map<size_t, uint64_t> componentByRoot;
+    for (size_t i = 0; i < region.size(); ++i) {
+        const size_t root = findRoot(parent, i);
+        auto [it, inserted] = componentByRoot.try_emplace(root, 0);
+        if (inserted) {
+            it->second = nextComponentId_++;
+        }
+        members_[region[i]].component = it->second;
+        components_[it->second].entityIds.push_back(region[i]);
+    }
+
+    for (const auto& [root, componentId] : componentByRoot) {
+        Component& component = components_[componentId];
+        std::sort(component.entityIds.begin(), component.entityIds.end(),
+                  [&index](const sk::EntityID& a, const sk::EntityID& b) {
+                      return index.orderOf(a) < index.orderOf(b);
+                  });
+        component.firstOrder = index.orderOf(component.entityIds.front());
+        component.key = mixHash(0, component.entityIds.size());
+        for (const auto& id : component.entityIds) {
+            component.key = mixHash(component.key, members_[id].fingerprint);
+        }
+    }
+}
+
+LoopDetectionResult IncrementalLoopDetector::detect(const sk::Sketch& sketch) {
+    ONECAD_TRACE_SCOPE("loop", "detectIncremental");
+    LoopDetectionResult result;
+    stats_ = {};
+
+    const LoopDetectorConfig& config = detector_.getConfig();
+    const sk::SketchSpatialIndex& index = sketch.spatialIndex();
+    if (sketch.geometryInstanceId() != sketchInstance_) {
+        members_.clear();
+        components_.clear();
+        tree_.clear();
+        sketchInstance_ = sketch.geometryInstanceId();
+    }
+
+    // 1. Re-tessellate curves whose revision moved; note the components they
+    //    belonged to before the edit
+    ++pass_;
+    std::vector<sk::EntityID> touched;
+    std::vector<uint64_t> affected;
+    for (const auto& entity : sketch.getAllEntities()) {
+        if (!entity || !isLoopCurve(entity->type())) {
+            continue;
+        }
+        const uint64_t revision = index.entityRevision(entity->id());
+        auto [it, inserted] = members_.try_emplace(entity->id());
+        Member& member = it->second;
+        member.seenPass = pass_;
+        if (!inserted && member.revision == revision) {
+            continue;
+        }
+        member.revision = revision;
+        if (member.active) {
+            affected.push_back(member.component);
+            tree_.remove(entity->id());
+        }
+        refreshMember(*entity, sketch, member);
+        ++stats_.curvesRefreshed;
+        if (member.active) {
+            tree_.insert(entity->id(), member.bounds);
+            touched.push_back(entity->id());
+        }
+    }
+    for (auto it = members_.begin(); it != members_.end();) {
+        if (it->second.seenPass == pass_) {
+            ++it;
+            continue;
+        }
+        if (it->second.active) {
+            affected.push_back(it->second.component);
+            tree_.remove(it->first);
+        }
+        it = members_.erase(it);
+    }
+
+    // 2. Re-partition only around the change
+    if (!touched.empty() || !affected.empty()) {
+        repartition(touched, std::move(affected), sketch);
+    }
+
+    // 3. Components in sketch order of their first member
+    std::vector<const Component*> ordered;
+    ordered.reserve(components_.size());
+    for (const auto& [componentId, component] : components_) {
+        ordered.push_back(&component);
+    }
+    std::sort(ordered.begin(), ordered.end(), [](const Component* a, const Component* b) {
+        return a->firstOrder < b->firstOrder;
+    });
+
+    std::unordered_map<uint64_t, ComponentResult> nextCache;
+    nextCache.reserve(ordered.size());
+    std::vector<Loop> loops;
+    stats_.components = ordered.size();
+
+    for (const Component* component : ordered) {
+        ComponentResult entry;
+        auto cached = cache_.find(component->key);
+        if (cached != cache_.end() && cached->second.entityIds == component->entityIds) {
+            entry = std::move(cached->second);
+            cache_.erase(cached);
+            ++stats_.componentsReused;
+        } else {
+            std::unordered_set<sk::EntityID> selection(component->entityIds.begin(),
+                                                       component->entityIds.end());
+            LoopDetectionResult partial;
+            entry.entityIds = component->entityIds;
+            entry.success = detector_.collectLoops(sketch, &selection, entry.loops, partial);
+            entry.openWires = std::move(partial.openWires);
+            entry.unusedEdges = std::move(partial.unusedEdges);
+            entry.errorMessage = std::move(partial.errorMessage);
+            ++stats_.componentsRebuilt;
+        }
+
+        if (!entry.success) {
+            result.success = false;
+            result.errorMessage = entry.errorMessage;
+        }
+        loops.insert(loops.end(), entry.loops.begin(), entry.loops.end());
+        result.openWires.insert(result.openWires.end(), entry.openWires.begin(), entry.openWires.end());
+        result.unusedEdges.insert(result.unusedEdges.end(),
+                                  entry.unusedEdges.begin(), entry.unusedEdges.end());
+        nextCache.emplace(component->key, std::move(entry));
+    }
+
+    // Components that disappeared are dropped
+    cache_ = std::move(nextCache);
+
+    if (!result.success) {
+        return result;
+    }
+    if (config.maxLoops > 0 && loops.size() > config.maxLoops) {
+        loops.resize(config.maxLoops);
+    }
+
+    detector_.finishResult(std::move(loops), sketch, result);
+    return result;
+}
+
+} // namespace onecad::core::loop
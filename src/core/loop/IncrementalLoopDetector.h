@@ -0,0 +1,119 @@
+/**
+ * @file IncrementalLoopDetector.h
+ * @brief Loop detection that reuses results for unchanged parts of a sketch
+ *
+ * The sketch is partitioned into interaction components: groups of curves
+ * whose (tolerance-padded) outlines overlap, directly or transitively. Curves
+ * in different components can neither intersect nor share a node, so the
+ * planar arrangement of the whole sketch is the union of the per-component
+ * arrangements. Each component's loops are cached under a fingerprint of its
+ * members' ids and geometry; an edit only re-planarizes the components whose
+ * fingerprint changed. Hole resolution still runs over all loops.
+ *
+ * Curve outlines, padded bounds (in an R-tree) and the partition itself are
+ * kept between calls. Curves whose SketchSpatialIndex::entityRevision() moved
+ * are re-tessellated, and only the components they touched, before or after
+ * the edit, are re-partitioned. The remaining per-call work over the whole
+ * sketch is a revision lookup per curve and concatenating cached loops.
+ *
+ * Loop edge IDs do not depend on the partition, so region keys from
+ * regionKey() are identical to those of a full LoopDetector::detect().
+ */
+#ifndef ONECAD_CORE_LOOP_INCREMENTAL_LOOP_DETECTOR_H
+#define ONECAD_CORE_LOOP_INCREMENTAL_LOOP_DETECTOR_H
+
+#include "LoopDetector.h"
+#include "../sketch/SpatialRTree.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace onecad::core::loop {
+
+/**
+ * @brief Stateful loop detector with per-component result reuse
+ */
+class IncrementalLoopDetector {
+public:
+    /**
+     * @brief Component reuse counters for the most recent detect() call
+     */
+    struct Stats {
+        size_t components = 0;
+        size_t componentsReused = 0;
+        size_t componentsRebuilt = 0;
+        size_t curvesRefreshed = 0;   ///< Curves re-tessellated since the previous call
+    };
+
+    IncrementalLoopDetector();
+    explicit IncrementalLoopDetector(const LoopDetectorConfig& config);
+
+    /**
+     * @brief Detect loops, re-planarizing only components that changed
+     */
+    LoopDetectionResult detect(const sk::Sketch& sketch);
+
+    /**
+     * @brief Update configuration (drops all cached components)
+     */
+    void setConfig(const LoopDetectorConfig& config);
+    const LoopDetectorConfig& getConfig() const { return detector_.getConfig(); }
+
+    /**
+     * @brief Drop all cached components
+     */
+    void clear();
+
+    const Stats& lastStats() const { return stats_; }
+    size_t cachedComponentCount() const { return cache_.size(); }
+
+private:
+    struct ComponentResult {
+        std::vector<sk::EntityID> entityIds;
+        std::vector<Loop> loops;
+        std::vector<Wire> openWires;
+        std::vector<sk::EntityID> unusedEdges;
+        bool success = true;
+        std::string errorMessage;
+    };
+
+    /**
+     * @brief Cached outline data of one line, arc or circle
+     */
+    struct Member {
+        uint64_t revision = 0;      ///< entityRevision() the data was built at
+        uint64_t seenPass = 0;
+        bool active = false;        ///< Non-construction with a usable outline
+        sk::BoundingBox2d bounds;   ///< Padded outline bounds (active only)
+        uint64_t fingerprint = 0;
+        uint64_t component = 0;     ///< Key into components_ (active only)
+    };
+
+    struct Component {
+        std::vector<sk::EntityID> entityIds;  ///< Sketch order
+        uint64_t firstOrder = 0;              ///< Sketch order of the first member
+        uint64_t key = 0;                     ///< Fingerprint, key into cache_
+    };
+
+    LoopDetector detector_;
+    std::unordered_map<uint64_t, ComponentResult> cache_;
+    Stats stats_;
+
+    uint64_t sketchInstance_ = 0;
+    uint64_t pass_ = 0;
+    uint64_t nextComponentId_ = 1;
+    std::unordered_map<sk::EntityID, Member> members_;
+    std::unordered_map<uint64_t, Component> components_;
+    sk::SpatialRTree tree_;
+
+    void refreshMember(const sk::SketchEntity& entity, const sk::Sketch& sketch, Member& member) const;
+    void repartition(const std::vector<sk::EntityID>& touched,
+                     std::vector<uint64_t> affected,
+                     const sk::Sketch& sketch);
+};
+
+} // namespace onecad::core::loop
+
+#endif // ONECAD_CORE_LOOP_INCREMENTAL_LOOP_DETECTOR_H
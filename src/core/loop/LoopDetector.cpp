@@ -7,9 +7,11 @@
 #include "../sketch/SketchCircle.h"
 #include "../sketch/SketchLine.h"
 #include "../sketch/SketchPoint.h"
+#include "../trace/Trace.h"
 
 #include <algorithm>
 #include <cmath>
+#include <cstdint>
 #include <functional>
 #include <limits>
 #include <numbers>
@@ -196,6 +198,148 @@ bool segmentIntersection(const sk::Vec2d& p1, const sk::Vec2d& p2,
     return true;
 }
 
+/**
+ * @brief Uniform-grid broad-phase over planarization segments
+ *
+ * Each segment's box is padded by the slack of the tolerance-based narrow-phase
+ * (parametric tolerance scales with length, cross-product tolerance with
+ * 1/length), so every pair the predicates could accept shares a cell. The
+ * 1/length term is clamped to tolerance + length/2: pointOnSegment's dot test
+ * already keeps accepted points that close to the midpoint.
+ *
+ * Boxes spanning more than kMaxCellsPerBox cells (a long construction diagonal
+ * among short arc chords) are not rasterized; they are kept in a side list and
+ * tested directly against every query.
+ */
+class SegmentGrid {
+public:
+    SegmentGrid(const std::vector<Segment>& segments, double tolerance) {
+        boxes_.reserve(segments.size());
+        double minX = std::numeric_limits<double>::infinity();
+        double minY = minX;
+        double maxX = -minX;
+        double maxY = -minX;
+        double extentSum = 0.0;
+        for (const auto& segment : segments) {
+            double length = std::sqrt(distanceSquared(segment.start, segment.end));
+            double pad = tolerance * (1.0 + length);
+            if (length > 0.0) {
+                pad += std::min(tolerance / length, tolerance + 0.5 * length);
+            }
+            Box box{std::min(segment.start.x, segment.end.x) - pad,
+                    std::min(segment.start.y, segment.end.y) - pad,
+                    std::max(segment.start.x, segment.end.x) + pad,
+                    std::max(segment.start.y, segment.end.y) + pad};
+            minX = std::min(minX, box.minX);
+            minY = std::min(minY, box.minY);
+            maxX = std::max(maxX, box.maxX);
+            maxY = std::max(maxY, box.maxY);
+            extentSum += std::max(box.maxX - box.minX, box.maxY - box.minY);
+            boxes_.push_back(box);
+        }
+
+        // Cells about one segment wide, but never more than kMaxCellsPerAxis across.
+        double extent = std::max(maxX - minX, maxY - minY);
+        double mean = segments.empty() ? 1.0 : extentSum / static_cast<double>(segments.size());
+        cellSize_ = std::max({mean, extent / kMaxCellsPerAxis, 1e-9});
+
+        oversized_.assign(boxes_.size(), false);
+        for (size_t i = 0; i < boxes_.size(); ++i) {
+            if (cellCount(boxes_[i]) > kMaxCellsPerBox) {
+                oversized_[i] = true;
+                oversizedIds_.push_back(static_cast<uint32_t>(i));
+                continue;
+            }
+            forEachCell(boxes_[i], [&](long long key) {
+                cells_[key].push_back(static_cast<uint32_t>(i));
+            });
+        }
+        stamp_.assign(boxes_.size(), std::numeric_limits<size_t>::max());
+    }
+
+    /**
+     * @brief Indices j > i whose padded boxes overlap segment i, ascending
+     */
+    void candidatesAfter(size_t i, std::vector<size_t>& out) {
+        out.clear();
+        const Box& box = boxes_[i];
+        if (oversized_[i]) {
+            // Walking its cells would cost more than testing every later box.
+            for (size_t j = i + 1; j < boxes_.size(); ++j) {
+                if (overlaps(box, boxes_[j])) {
+                    out.push_back(j);
+                }
+            }
+            return;
+        }
+        forEachCell(box, [&](long long key) {
+            auto it = cells_.find(key);
+            if (it == cells_.end()) {
+                return;
+            }
+            for (uint32_t j : it->second) {
+                if (j <= i || stamp_[j] == i) {
+                    continue;
+                }
+                stamp_[j] = i;
+                if (overlaps(box, boxes_[j])) {
+                    out.push_back(j);
+                }
+            }
+        });
+        for (uint32_t j : oversizedIds_) {
+            if (j > i && overlaps(box, boxes_[j])) {
+                out.push_back(j);
+            }
+        }
+        std::sort(out.begin(), out.end());
+    }
+
+private:
+    static constexpr double kMaxCellsPerAxis = 1024.0;
+    static constexpr long long kMaxCellsPerBox = 64;
+
+    struct Box {
+        double minX;
+        double minY;
+        double maxX;
+        double maxY;
+    };
+
+    static bool overlaps(const Box& a, const Box& b) {
+        return !(b.maxX < a.minX || b.minX > a.maxX ||
+                 b.maxY < a.minY || b.minY > a.maxY);
+    }
+
+    long long cellCount(const Box& box) const {
+        const long long nx = static_cast<long long>(std::floor(box.maxX / cellSize_)) -
+                             static_cast<long long>(std::floor(box.minX / cellSize_)) + 1;
+        const long long ny = static_cast<long long>(std::floor(box.maxY / cellSize_)) -
+                             static_cast<long long>(std::floor(box.minY / cellSize_)) + 1;
+        return nx * ny;
+    }
+
+    template <typename Fn>
+    void forEachCell(const Box& box, Fn&& fn) const {
+        const long long x0 = static_cast<long long>(std::floor(box.minX / cellSize_));
+        const long long x1 = static_cast<long long>(std::floor(box.maxX / cellSize_));
+        const long long y0 = static_cast<long long>(std::floor(box.minY / cellSize_));
+        const long long y1 = static_cast<long long>(std::floor(box.maxY / cellSize_));
+        for (long long x = x0; x <= x1; ++x) {
+            for (long long y = y0; y <= y1; ++y) {
+                fn((x << 32) ^ (y & 0xffffffffLL));
+            }
+        }
+    }
+
+    std::vector<Box> boxes_;
+    std::unordered_map<long long, std::vector<uint32_t>> cells_;
+    std::vector<size_t> stamp_;
+    std::vector<bool> oversized_;
+    std::vector<uint32_t> oversizedIds_;
+    double cellSize_ = 1.0;
+};
+
 std::vector<sk::Vec2d> tessellateArcPoints(const sk::Vec2d& center,
                                            double radius,
                                            double startAngle,
@@ -337,6 +481,7 @@ LoopDetectionResult LoopDetector::detect(const sk::Sketch& sketch) const {
 
 LoopDetectionResult LoopDetector::detect(const sk::Sketch& sketch,
                                          const std::vector<sk::EntityID>& selectedEntities) const {
+    ONECAD_TRACE_SCOPE("loop", "detect");
     LoopDetectionResult result;
 
     std::unordered_set<sk::EntityID> selection;
@@ -344,15 +489,26 @@ LoopDetectionResult LoopDetector::detect(const sk::Sketch& sketch,
         selection.insert(selectedEntities.begin(), selectedEntities.end());
     }
 
-    auto graph = buildGraph(sketch, selection.empty() ? nullptr : &selection,
-                            config_.planarizeIntersections);
+    std::vector<Loop> loops;
+    if (!collectLoops(sketch, selection.empty() ? nullptr : &selection, loops, result)) {
+        return result;
+    }
+
+    finishResult(std::move(loops), sketch, result);
+    return result;
+}
+
+bool LoopDetector::collectLoops(const sk::Sketch& sketch,
+                                const std::unordered_set<sk::EntityID>* selection,
+                                std::vector<Loop>& loops,
+                                LoopDetectionResult& result) const {
+    auto graph = buildGraph(sketch, selection, config_.planarizeIntersections);
     if (!graph) {
         result.success = false;
         result.errorMessage = "Failed to build adjacency graph";
-        return result;
+        return false;
     }
 
-    std::vector<Loop> loops;
     std::unordered_set<sk::EntityID> edgesInLoops;
 
     if (config_.planarizeIntersections) {
@@ -411,7 +567,7 @@ LoopDetectionResult LoopDetector::detect(const sk::Sketch& sketch,
             if (!entity || entity->isConstruction()) {
                 continue;
             }
-            if (!selection.empty() && selection.find(entity->id()) == selection.end()) {
+            if (selection && !selection->empty() && selection->find(entity->id()) == selection->end()) {
                 continue;
             }
             if (entity->type() != sk::EntityType::Circle) {
@@ -439,39 +595,15 @@ LoopDetectionResult LoopDetector::detect(const sk::Sketch& sketch,
         }
     }
 
-    result.totalLoopsFound = static_cast<int>(loops.size());
-
-    if (config_.resolveHoles) {
-        result.faces = buildFaceHierarchy(std::move(loops));
-        for (const auto& face : result.faces) {
-            if (!face.innerLoops.empty()) {
-                result.facesWithHoles++;
-            }
-        }
-    } else {
-        for (auto& loop : loops) {
-            Face face;
-            face.outerLoop = std::move(loop);
-            result.faces.push_back(std::move(face));
-        }
-    }
-
+    // Hole resolution only regroups loops, so faces use exactly these edges
     std::unordered_set<int> usedEdges;
-    for (const auto& face : result.faces) {
-        for (const auto& edge : face.outerLoop.wire.edges) {
+    for (const auto& loop : loops) {
+        for (const auto& edge : loop.wire.edges) {
             auto it = graph->edgeByEntity.find(edge);
             if (it != graph->edgeByEntity.end()) {
                 usedEdges.insert(it->second);
             }
         }
-        for (const auto& hole : face.innerLoops) {
-            for (const auto& edge : hole.wire.edges) {
-                auto it = graph->edgeByEntity.find(edge);
-                if (it != graph->edgeByEntity.end()) {
-                    usedEdges.insert(it->second);
-                }
-            }
-        }
     }
 
     std::unordered_set<int> openUsed;
@@ -518,47 +650,93 @@ LoopDetectionResult LoopDetector::detect(const sk::Sketch& sketch,
         result.unusedEdges.push_back(graph->edges[edgeIndex].entityId);
     }
 
-    for (const auto& entity : sketch.getAllEntities()) {
-        if (!entity || entity->type() != sk::EntityType::Point) {
-            continue;
+    return true;
+}
+
+void LoopDetector::finishResult(std::vector<Loop> loops,
+                                const sk::Sketch& sketch,
+                                LoopDetectionResult& result) const {
+    result.totalLoopsFound = static_cast<int>(loops.size());
+
+    if (config_.resolveHoles) {
+        result.faces = buildFaceHierarchy(std::move(loops));
+        for (const auto& face : result.faces) {
+            if (!face.innerLoops.empty()) {
+                result.facesWithHoles++;
+            }
         }
-        auto* point = dynamic_cast<const sk::SketchPoint*>(entity.get());
-        if (!point) {
-            continue;
+    } else {
+        for (auto& loop : loops) {
+            Face face;
+            face.outerLoop = std::move(loop);
+            result.faces.push_back(std::move(face));
         }
+    }
 
-        bool referenced = false;
-        for (const auto& e : sketch.getAllEntities()) {
-            if (!e || e->isConstruction()) {
-                continue;
+    // Points referenced by any non-construction line, arc or circle
+    std::unordered_set<sk::EntityID> referencedPoints;
+    for (const auto& e : sketch.getAllEntities()) {
+        if (!e || e->isConstruction()) {
+            continue;
+        }
+        if (e->type() == sk::EntityType::Line) {
+            auto* line = dynamic_cast<const sk::SketchLine*>(e.get());
+            if (line) {
+                referencedPoints.insert(line->startPointId());
+                referencedPoints.insert(line->endPointId());
             }
-            if (e->type() == sk::EntityType::Line) {
-                auto* line = dynamic_cast<const sk::SketchLine*>(e.get());
-                if (line && (line->startPointId() == point->id() || line->endPointId() == point->id())) {
-                    referenced = true;
-                    break;
-                }
-            } else if (e->type() == sk::EntityType::Arc) {
-                auto* arc = dynamic_cast<const sk::SketchArc*>(e.get());
-                if (arc && arc->centerPointId() == point->id()) {
-                    referenced = true;
-                    break;
-                }
-            } else if (e->type() == sk::EntityType::Circle) {
-                auto* circle = dynamic_cast<const sk::SketchCircle*>(e.get());
-                if (circle && circle->centerPointId() == point->id()) {
-                    referenced = true;
-                    break;
-                }
+        } else if (e->type() == sk::EntityType::Arc) {
+            auto* arc = dynamic_cast<const sk::SketchArc*>(e.get());
+            if (arc) {
+                referencedPoints.insert(arc->centerPointId());
+            }
+        } else if (e->type() == sk::EntityType::Circle) {
+            auto* circle = dynamic_cast<const sk::SketchCircle*>(e.get());
+            if (circle) {
+                referencedPoints.insert(circle->centerPointId());
             }
         }
+    }
 
-        if (!referenced) {
-            result.isolatedPoints.push_back(point->id());
+    for (const auto& entity : sketch.getAllEntities()) {
+        if (!entity || entity->type() != sk::EntityType::Point) {
+            continue;
+        }
+        if (!referencedPoints.count(entity->id())) {
+            result.isolatedPoints.push_back(entity->id());
         }
     }
+}
 
-    return result;
+std::vector<sk::Vec2d> LoopDetector::entityOutline(const sk::SketchEntity& entity,
+                                                   const sk::Sketch& sketch) const {
+    if (entity.type() == sk::EntityType::Line) {
+        auto* line = dynamic_cast<const sk::SketchLine*>(&entity);
+        auto* start = line ? sketch.getEntityAs<sk::SketchPoint>(line->startPointId()) : nullptr;
+        auto* end = line ? sketch.getEntityAs<sk::SketchPoint>(line->endPointId()) : nullptr;
+        if (!start || !end) {
+            return {};
+        }
+        return {toVec2(start->position()), toVec2(end->position())};
+    }
+    if (entity.type() == sk::EntityType::Arc) {
+        auto* arc = dynamic_cast<const sk::SketchArc*>(&entity);
+        auto* centerPoint = arc ? sketch.getEntityAs<sk::SketchPoint>(arc->centerPointId()) : nullptr;
+        if (!centerPoint) {
+            return {};
+        }
+        return tessellateArcPoints(toVec2(centerPoint->position()), arc->radius(),
+                                   arc->startAngle(), arc->endAngle(), config_);
+    }
+    if (entity.type() == sk::EntityType::Circle) {
+        auto* circle = dynamic_cast<const sk::SketchCircle*>(&entity);
+        auto* centerPoint = circle ? sketch.getEntityAs<sk::SketchPoint>(circle->centerPointId()) : nullptr;
+        if (!centerPoint) {
+            return {};
+        }
+        return tessellateCirclePoints(toVec2(centerPoint->position()), circle->radius(), config_);
+    }
+    return {};
 }
 
 std::optional<Face> LoopDetector::findLoopAtPoint(const sk::Sketch& sketch,
@@ -855,8 +1033,13 @@ std::unique_ptr<AdjacencyGraph> LoopDetector::buildGraph(
         return kb + "|" + ka;
     };
 
+    // Same pair order as an all-pairs scan (i ascending, then j ascending), so
+    // split points are merged identically; only non-overlapping pairs are skipped.
+    SegmentGrid grid(segments, tolerance);
+    std::vector<size_t> candidates;
     for (size_t i = 0; i < segments.size(); ++i) {
-        for (size_t j = i + 1; j < segments.size(); ++j) {
+        grid.candidatesAfter(i, candidates);
+        for (size_t j : candidates) {
             const auto& a = segments[i];
             const auto& b = segments[j];
 
@@ -219,6 +219,8 @@ struct LoopDetectorConfig {
 
     /// Maximum circle segments
     int maxCircleSegments = 512;
+
+    bool operator==(const LoopDetectorConfig&) const = default;
 };
 
 /**
@@ -296,8 +298,32 @@ public:
     const LoopDetectorConfig& getConfig() const { return config_; }
 
 private:
+    friend class IncrementalLoopDetector;
+
     LoopDetectorConfig config_;
 
+    /**
+     * @brief Build the graph and collect validated loops, open wires and unused edges
+     * @return false if the graph could not be built (result carries the error)
+     */
+    bool collectLoops(const sk::Sketch& sketch,
+                      const std::unordered_set<sk::EntityID>* selection,
+                      std::vector<Loop>& loops,
+                      LoopDetectionResult& result) const;
+
+    /**
+     * @brief Resolve holes into faces and collect isolated points
+     */
+    void finishResult(std::vector<Loop> loops,
+                      const sk::Sketch& sketch,
+                      LoopDetectionResult& result) const;
+
+    /**
+     * @brief Polyline the planarizer uses for a line, arc or circle (empty otherwise)
+     */
+    std::vector<sk::Vec2d> entityOutline(const sk::SketchEntity& entity,
+                                         const sk::Sketch& sketch) const;
+
     /**
      * @brief Build adjacency graph from sketch
      *
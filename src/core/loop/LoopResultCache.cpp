@@ -0,0 +1,94 @@
+/**
+ * @file LoopResultCache.cpp
+ * @brief Revision-stamped loop detection cache
+ */
+#include "LoopResultCache.h"
+
+#include "../sketch/Sketch.h"
+
+#include <QLoggingCategory>
+
+#include <algorithm>
+
+namespace onecad::core::loop {
+
+Q_LOGGING_CATEGORY(logLoopCache, "onecad.core.loop.cache")
+
+namespace {
+// Callers use one or two configs; keep a little headroom
+constexpr size_t kMaxEntries = 4;
+} // namespace
+
+LoopResultCache::LoopResultCache() = default;
+
+LoopResultCache::~LoopResultCache() = default;
+
+void LoopResultCache::clear() {
+    entries_.clear();
+}
+
+void LoopResultCache::logStats(const char* context) const {
+    auto hitRate = [](uint64_t hits, uint64_t misses) {
+        const uint64_t total = hits + misses;
+        return total > 0 ? 100.0 * static_cast<double>(hits) / static_cast<double>(total) : 0.0;
+    };
+    qCDebug(logLoopCache).nospace()
+        << context << ": detection " << stats_.detectionHits << " hits / "
+        << stats_.detectionMisses << " misses ("
+        << hitRate(stats_.detectionHits, stats_.detectionMisses) << "%), regions "
+        << stats_.regionHits << " hits / " << stats_.regionMisses << " misses ("
+        << hitRate(stats_.regionHits, stats_.regionMisses) << "%)";
+}
+
+LoopResultCache::Entry& LoopResultCache::entryFor(const LoopDetectorConfig& config) {
+    auto it = std::find_if(entries_.begin(), entries_.end(), [&](const auto& entry) {
+        return entry->config == config;
+    });
+    if (it == entries_.end()) {
+        auto entry = std::make_unique<Entry>();
+        entry->config = config;
+        entry->detector.setConfig(config);
+        if (entries_.size() >= kMaxEntries) {
+            entries_.pop_back();
+        }
+        entries_.insert(entries_.begin(), std::move(entry));
+        return *entries_.front();
+    }
+    std::rotate(entries_.begin(), it, it + 1);
+    return *entries_.front();
+}
+
+const LoopDetectionResult& LoopResultCache::detect(const sk::Sketch& sketch,
+                                                   const LoopDetectorConfig& config) {
+    Entry& entry = entryFor(config);
+    const uint64_t revision = sketch.geometryRevision();
+    if (entry.hasResult && entry.resultRevision == revision) {
+        ++stats_.detectionHits;
+        return entry.result;
+    }
+
+    ++stats_.detectionMisses;
+    entry.result = entry.detector.detect(sketch);
+    entry.resultRevision = revision;
+    entry.hasResult = true;
+    return entry.result;
+}
+
+const std::vector<RegionDefinition>& LoopResultCache::regions(const sk::Sketch& sketch,
+                                                              const LoopDetectorConfig& config) {
+    Entry& entry = entryFor(config);
+    const uint64_t revision = sketch.geometryRevision();
+    if (entry.hasRegions && entry.regionsRevision == revision) {
+        ++stats_.regionHits;
+        return entry.regions;
+    }
+
+    ++stats_.regionMisses;
+    const LoopDetectionResult& result = detect(sketch, config);
+    entry.regions = buildRegionDefinitions(result, sk::constants::COINCIDENCE_TOLERANCE);
+    entry.regionsRevision = revision;
+    entry.hasRegions = true;
+    return entry.regions;
+}
+
+} // namespace onecad::core::loop
@@ -0,0 +1,89 @@
+/**
+ * @file LoopResultCache.h
+ * @brief Memoized loop detection and region definitions for one sketch
+ *
+ * Results are keyed by LoopDetectorConfig and stamped with the sketch
+ * geometry revision. A repeated request at the same revision returns the
+ * stored result; after an edit the per-config IncrementalLoopDetector
+ * re-planarizes only the components that changed.
+ */
+#ifndef ONECAD_CORE_LOOP_LOOP_RESULT_CACHE_H
+#define ONECAD_CORE_LOOP_LOOP_RESULT_CACHE_H
+
+#include "IncrementalLoopDetector.h"
+#include "RegionUtils.h"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace onecad::core::loop {
+
+/**
+ * @brief Hit/miss counters for LoopResultCache
+ */
+struct LoopCacheStats {
+    uint64_t detectionHits = 0;
+    uint64_t detectionMisses = 0;
+    uint64_t regionHits = 0;
+    uint64_t regionMisses = 0;
+};
+
+/**
+ * @brief Per-sketch cache of loop detection results, one entry per config
+ */
+class LoopResultCache {
+public:
+    LoopResultCache();
+    ~LoopResultCache();
+
+    /**
+     * @brief Loop detection result for the sketch's current geometry
+     *
+     * The reference stays valid until the next call with the same config.
+     */
+    const LoopDetectionResult& detect(const sk::Sketch& sketch, const LoopDetectorConfig& config);
+
+    /**
+     * @brief Region definitions (outer loop + holes) for the current geometry
+     *
+     * Built with sk::constants::COINCIDENCE_TOLERANCE, like the RegionUtils helpers.
+     */
+    const std::vector<RegionDefinition>& regions(const sk::Sketch& sketch,
+                                                 const LoopDetectorConfig& config);
+
+    /**
+     * @brief Drop all cached results (counters are kept)
+     */
+    void clear();
+
+    const LoopCacheStats& stats() const { return stats_; }
+    void resetStats() { stats_ = {}; }
+
+    /**
+     * @brief Write the hit/miss counters and hit rates to the loop cache log category
+     */
+    void logStats(const char* context) const;
+
+private:
+    struct Entry {
+        LoopDetectorConfig config;
+        IncrementalLoopDetector detector;
+        bool hasResult = false;
+        uint64_t resultRevision = 0;
+        LoopDetectionResult result;
+        bool hasRegions = false;
+        uint64_t regionsRevision = 0;
+        std::vector<RegionDefinition> regions;
+    };
+
+    // Most recently used first; bounded by kMaxEntries in the .cpp
+    std::vector<std::unique_ptr<Entry>> entries_;
+    LoopCacheStats stats_;
+
+    Entry& entryFor(const LoopDetectorConfig& config);
+};
+
+} // namespace onecad::core::loop
+
+#endif // ONECAD_CORE_LOOP_LOOP_RESULT_CACHE_H
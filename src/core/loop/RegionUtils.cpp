@@ -69,6 +69,20 @@ const sk::SketchEntity* resolveLoopEdgeEntity(const sk::Sketch& sketch,
     return sketch.getEntity(toBaseEdgeId(loopEdgeId));
 }
 
+const RegionDefinition* findCachedRegion(const sk::Sketch& sketch,
+                                         const std::string& regionId,
+                                         const LoopDetectorConfig& config) {
+    if (regionId.empty()) {
+        return nullptr;
+    }
+    for (const auto& region : sketch.regionDefinitions(config)) {
+        if (region.id == regionId) {
+            return &region;
+        }
+    }
+    return nullptr;
+}
+
 } // namespace
 
 std::string regionKey(const Loop& loop) {
@@ -212,21 +226,14 @@ std::optional<Face> resolveRegionFace(const sk::Sketch& sketch,
 std::optional<Face> resolveRegionFace(const sk::Sketch& sketch,
                                       const std::string& regionId,
                                       const LoopDetectorConfig& config) {
-    LoopDetector detector;
-    detector.setConfig(config);
-    auto result = detector.detect(sketch);
-    if (!result.success) {
-        return std::nullopt;
-    }
-
-    auto region = findRegionDefinition(result, regionId, sk::constants::COINCIDENCE_TOLERANCE);
-    if (!region.has_value()) {
+    const RegionDefinition* region = findCachedRegion(sketch, regionId, config);
+    if (!region) {
         return std::nullopt;
     }
 
     Face face;
     face.outerLoop = region->outerLoop;
-    face.innerLoops = std::move(region->holes);
+    face.innerLoops = region->holes;
     return face;
 }
 
@@ -300,14 +307,8 @@ bool loopContainsEntity(const sk::Sketch& sketch,
 std::vector<sk::EntityID> getEntityIdsInRegion(const sk::Sketch& sketch,
                                                 const std::string& regionId) {
     std::vector<sk::EntityID> out;
-    LoopDetector detector;
-    detector.setConfig(makeRegionDetectionConfig());
-    auto result = detector.detect(sketch);
-    if (!result.success) {
-        return out;
-    }
-    auto region = findRegionDefinition(result, regionId, sk::constants::COINCIDENCE_TOLERANCE);
-    if (!region.has_value()) {
+    const RegionDefinition* region = findCachedRegion(sketch, regionId, makeRegionDetectionConfig());
+    if (!region) {
         return out;
     }
     std::unordered_set<sk::EntityID> pointIds;
@@ -437,14 +438,7 @@ std::optional<std::string> getRegionIdContainingEntity(const sk::Sketch& sketch,
     if (entityId.empty()) {
         return std::nullopt;
     }
-    LoopDetector detector;
-    detector.setConfig(makeRegionDetectionConfig());
-    auto result = detector.detect(sketch);
-    if (!result.success) {
-        return std::nullopt;
-    }
-    auto regions = buildRegionDefinitions(result, sk::constants::COINCIDENCE_TOLERANCE);
-    for (const auto& region : regions) {
+    for (const auto& region : sketch.regionDefinitions(makeRegionDetectionConfig())) {
         if (loopContainsEntity(sketch, region.outerLoop, entityId)) {
             return region.id;
         }
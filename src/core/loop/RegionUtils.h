@@ -4,6 +4,8 @@
  *
  * Provides stable region IDs derived from loop edge sets and helpers to
  * build region definitions (outer loop + holes) from loop detection results.
+ * Sketch-level lookups use Sketch::regionDefinitions(), so repeated queries on
+ * unchanged geometry share one detection pass.
  */
 #ifndef ONECAD_CORE_LOOP_REGIONUTILS_H
 #define ONECAD_CORE_LOOP_REGIONUTILS_H
@@ -0,0 +1,68 @@
+/**
+ * @file MemoryEstimate.h
+ * @brief Approximate heap usage of standard containers for memory reports
+ *
+ * The numbers model a typical libstdc++/libc++ layout (node-based hash maps,
+ * small-string optimisation) and ignore allocator overhead. They are meant
+ * to rank consumers and spot growth, not to match the process RSS.
+ */
+#ifndef ONECAD_CORE_MEMORY_MEMORYESTIMATE_H
+#define ONECAD_CORE_MEMORY_MEMORYESTIMATE_H
+
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace onecad::core::memory {
+
+/**
+ * @brief Heap bytes of a string beyond the object itself (0 while inline)
+ */
+inline std::size_t stringBytes(const std::string& value) {
+    return value.capacity() > std::string().capacity() ? value.capacity() + 1 : 0;
+}
+
+/**
+ * @brief Heap bytes of a vector's storage, not counting what elements own
+ */
+template <typename T>
+std::size_t vectorBytes(const std::vector<T>& values) {
+    return values.capacity() * sizeof(T);
+}
+
+/**
+ * @brief Heap bytes of a hash container: bucket array plus one node per element
+ */
+template <typename Container>
+std::size_t hashBytes(const Container& container) {
+    using Value = typename Container::value_type;
+    return container.bucket_count() * sizeof(void*)
+        + container.size() * (sizeof(Value) + 2 * sizeof(void*));
+}
+
+/**
+ * @brief hashBytes() plus the heap owned by string keys
+ */
+template <typename Value>
+std::size_t stringMapBytes(const std::unordered_map<std::string, Value>& map) {
+    std::size_t bytes = hashBytes(map);
+    for (const auto& [key, value] : map) {
+        (void)value;
+        bytes += stringBytes(key);
+    }
+    return bytes;
+}
+
+inline std::size_t stringSetBytes(const std::unordered_set<std::string>& set) {
+    std::size_t bytes = hashBytes(set);
+    for (const auto& key : set) {
+        bytes += stringBytes(key);
+    }
+    return bytes;
+}
+
+} // namespace onecad::core::memory
+
+#endif // ONECAD_CORE_MEMORY_MEMORYESTIMATE_H
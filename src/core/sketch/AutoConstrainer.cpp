@@ -34,6 +34,30 @@ inline double normalizeAngle(double angle) {
     while (angle < -PI) angle += 2.0 * PI;
     return angle;
 }
+
+// Line direction buckets over [0, π); 1° each
+constexpr int kAngleBucketCount = 180;
+constexpr double kAngleBucketWidth = PI / kAngleBucketCount;
+
+// Equal-radius inference window (mm); also the radius bucket width
+constexpr double kEqualRadiusTolerance = 0.5;
+
+// Direction folded to [0, π)
+inline double directionAngle(double angle) {
+    double folded = std::fmod(angle, PI);
+    if (folded < 0.0) {
+        folded += PI;
+    }
+    return folded < PI ? folded : 0.0;
+}
+
+inline long long cellCoord(double value, double cellSize) {
+    return static_cast<long long>(std::floor(value / cellSize));
+}
+
+inline long long packCell(long long cellX, long long cellY) {
+    return (cellX << 32) ^ (cellY & 0xffffffffLL);
+}
 } // anonymous namespace
 
 AutoConstrainer::AutoConstrainer() {
@@ -335,11 +359,12 @@ std::optional<InferredConstraint> AutoConstrainer::inferCoincident(
     double nearestDistSq = config_.coincidenceTolerance * config_.coincidenceTolerance;
     EntityID nearestId;
 
-    for (const auto& entity : sketch.getAllEntities()) {
-        if (entity->id() == excludeEntity) continue;
-        if (entity->type() != EntityType::Point) continue;
+    // Point bounds are degenerate, so the square query is a superset of the disc
+    for (const auto& candidateId : sketch.spatialIndex().queryRadius(point, config_.coincidenceTolerance)) {
+        if (candidateId == excludeEntity) continue;
 
-        const auto* pt = static_cast<const SketchPoint*>(entity.get());
+        const auto* pt = sketch.getEntityAs<SketchPoint>(candidateId);
+        if (!pt) continue;
         if (!excludeEntity.empty()) {
             const auto& connected = pt->connectedEntities();
             if (std::find(connected.begin(), connected.end(), excludeEntity) != connected.end()) {
@@ -353,7 +378,7 @@ std::optional<InferredConstraint> AutoConstrainer::inferCoincident(
         if (distSq < nearestDistSq) {
             nearestDistSq = distSq;
             nearestPoint = pt;
-            nearestId = entity->id();
+            nearestId = candidateId;
         }
     }
 
@@ -425,22 +450,13 @@ std::optional<InferredConstraint> AutoConstrainer::inferPerpendicular(
     std::optional<InferredConstraint> best;
     double bestDeviation = std::numeric_limits<double>::infinity();
 
-    for (const auto& entity : sketch.getAllEntities()) {
-        if (entity->type() != EntityType::Line) continue;
-        if (!line1Id.empty() && entity->id() == line1Id) continue;
-
-        const auto* line = static_cast<const SketchLine*>(entity.get());
-        const auto* startPt = sketch.getEntityAs<SketchPoint>(line->startPointId());
-        const auto* endPt = sketch.getEntityAs<SketchPoint>(line->endPointId());
-        if (!startPt || !endPt) continue;
+    // Indexed directions are exact for the current geometry revision
+    const CandidateIndex& index = candidateIndex(sketch);
+    const double line1Angle = lineAngle(line1Start, line1End);
+    for (size_t candidate : linesNearDirection(index, line1Angle + HALF_PI, config_.perpendicularTolerance)) {
+        if (!line1Id.empty() && index.lines[candidate] == line1Id) continue;
 
-        Vec2d line2Start = toVec2d(startPt->position());
-        Vec2d line2End = toVec2d(endPt->position());
-        if (distance(line2Start, line2End) < constants::MIN_GEOMETRY_SIZE) {
-            continue;
-        }
-
-        double angle = angleBetweenLines(line1Start, line1End, line2Start, line2End);
+        double angle = angleBetweenDirections(line1Angle, index.lineAngles[candidate]);
         double deviation = std::abs(angle - HALF_PI);
         if (deviation > config_.perpendicularTolerance) {
             continue;
@@ -452,7 +468,7 @@ std::optional<InferredConstraint> AutoConstrainer::inferPerpendicular(
             best = InferredConstraint{
                 .type = ConstraintType::Perpendicular,
                 .entity1 = line1Id,
-                .entity2 = entity->id(),
+                .entity2 = index.lines[candidate],
                 .confidence = confidence
             };
         }
@@ -514,22 +530,12 @@ std::optional<InferredConstraint> AutoConstrainer::inferParallel(
     std::optional<InferredConstraint> best;
     double bestDeviation = std::numeric_limits<double>::infinity();
 
-    for (const auto& entity : sketch.getAllEntities()) {
-        if (entity->type() != EntityType::Line) continue;
-        if (!lineId.empty() && entity->id() == lineId) continue;
-
-        const auto* line = static_cast<const SketchLine*>(entity.get());
-        const auto* startPt = sketch.getEntityAs<SketchPoint>(line->startPointId());
-        const auto* endPt = sketch.getEntityAs<SketchPoint>(line->endPointId());
-        if (!startPt || !endPt) continue;
+    const CandidateIndex& index = candidateIndex(sketch);
+    const double drawnAngle = lineAngle(lineStart, lineEnd);
+    for (size_t candidate : linesNearDirection(index, drawnAngle, config_.parallelTolerance)) {
+        if (!lineId.empty() && index.lines[candidate] == lineId) continue;
 
-        Vec2d line2Start = toVec2d(startPt->position());
-        Vec2d line2End = toVec2d(endPt->position());
-        if (distance(line2Start, line2End) < constants::MIN_GEOMETRY_SIZE) {
-            continue;
-        }
-
-        double angle = angleBetweenLines(lineStart, lineEnd, line2Start, line2End);
+        double angle = angleBetweenDirections(drawnAngle, index.lineAngles[candidate]);
         double deviation = std::min(angle, std::abs(angle - PI));
         if (deviation > config_.parallelTolerance) {
             continue;
@@ -541,7 +547,7 @@ std::optional<InferredConstraint> AutoConstrainer::inferParallel(
             best = InferredConstraint{
                 .type = ConstraintType::Parallel,
                 .entity1 = lineId,
-                .entity2 = entity->id(),
+                .entity2 = index.lines[candidate],
                 .confidence = confidence
             };
         }
@@ -562,11 +568,12 @@ std::optional<InferredConstraint> AutoConstrainer::inferTangent(
     double bestDeviation = std::numeric_limits<double>::infinity();
     std::optional<InferredConstraint> best;
 
-    for (const auto& entity : sketch.getAllEntities()) {
-        if (entity->id() == arcId) continue;
-        if (entity->type() != EntityType::Line) continue;
+    // A line with an endpoint near the arc start has bounds near it too
+    for (const auto& candidateId : sketch.spatialIndex().queryRadius(arcStartPoint, config_.coincidenceTolerance)) {
+        if (candidateId == arcId) continue;
 
-        const auto* line = static_cast<const SketchLine*>(entity.get());
+        const auto* line = sketch.getEntityAs<SketchLine>(candidateId);
+        if (!line) continue;
         const auto* startPt = sketch.getEntityAs<SketchPoint>(line->startPointId());
         const auto* endPt = sketch.getEntityAs<SketchPoint>(line->endPointId());
         if (!startPt || !endPt) continue;
@@ -630,7 +637,7 @@ std::optional<InferredConstraint> AutoConstrainer::inferTangent(
                 best = InferredConstraint{
                     .type = ConstraintType::Tangent,
                     .entity1 = arcId,
-                    .entity2 = entity->id(),
+                    .entity2 = line->id(),
                     .confidence = confidence
                 };
             }
@@ -648,21 +655,41 @@ std::optional<InferredConstraint> AutoConstrainer::inferConcentric(
     std::optional<InferredConstraint> best;
     double bestDist = config_.coincidenceTolerance;
 
-    for (const auto& entity : sketch.getAllEntities()) {
+    const CandidateIndex& index = candidateIndex(sketch);
+    if (index.centerCellSize <= 0.0 || !std::isfinite(center.x) || !std::isfinite(center.y)) {
+        return best;
+    }
+
+    std::vector<size_t> nearby;
+    const long long cellX = cellCoord(center.x, index.centerCellSize);
+    const long long cellY = cellCoord(center.y, index.centerCellSize);
+    for (long long dx = -1; dx <= 1; ++dx) {
+        for (long long dy = -1; dy <= 1; ++dy) {
+            auto cellIt = index.centerCells.find(packCell(cellX + dx, cellY + dy));
+            if (cellIt != index.centerCells.end()) {
+                nearby.insert(nearby.end(), cellIt->second.begin(), cellIt->second.end());
+            }
+        }
+    }
+    std::sort(nearby.begin(), nearby.end());
+
+    for (size_t candidate : nearby) {
+        const SketchEntity* entity = sketch.getEntity(index.curves[candidate]);
+        if (!entity) continue;
         if (entity->id() == entityId) continue;
 
         Vec2d existingCenter;
         bool hasCenter = false;
 
         if (entity->type() == EntityType::Circle) {
-            const auto* circle = static_cast<const SketchCircle*>(entity.get());
+            const auto* circle = static_cast<const SketchCircle*>(entity);
             const auto* centerPt = sketch.getEntityAs<SketchPoint>(circle->centerPointId());
             if (centerPt) {
                 existingCenter = toVec2d(centerPt->position());
                 hasCenter = true;
             }
         } else if (entity->type() == EntityType::Arc) {
-            const auto* arc = static_cast<const SketchArc*>(entity.get());
+            const auto* arc = static_cast<const SketchArc*>(entity);
             const auto* centerPt = sketch.getEntityAs<SketchPoint>(arc->centerPointId());
             if (centerPt) {
                 existingCenter = toVec2d(centerPt->position());
@@ -694,22 +721,36 @@ std::optional<InferredConstraint> AutoConstrainer::inferEqualRadius(
     EntityID entityId,
     const Sketch& sketch) const
 {
-    constexpr double RADIUS_TOLERANCE = 0.5;  // mm
-
     std::optional<InferredConstraint> best;
-    double bestDiff = RADIUS_TOLERANCE;
+    double bestDiff = kEqualRadiusTolerance;
+    if (!std::isfinite(radius)) {
+        return best;
+    }
 
-    for (const auto& entity : sketch.getAllEntities()) {
+    const CandidateIndex& index = candidateIndex(sketch);
+    std::vector<size_t> nearby;
+    const long long bucket = cellCoord(radius, kEqualRadiusTolerance);
+    for (long long b = bucket - 1; b <= bucket + 1; ++b) {
+        auto bucketIt = index.radiusBuckets.find(b);
+        if (bucketIt != index.radiusBuckets.end()) {
+            nearby.insert(nearby.end(), bucketIt->second.begin(), bucketIt->second.end());
+        }
+    }
+    std::sort(nearby.begin(), nearby.end());
+
+    for (size_t candidate : nearby) {
+        const SketchEntity* entity = sketch.getEntity(index.curves[candidate]);
+        if (!entity) continue;
         if (entity->id() == entityId) continue;
 
         double existingRadius = 0;
         bool hasRadius = false;
 
         if (entity->type() == EntityType::Circle) {
-            existingRadius = static_cast<const SketchCircle*>(entity.get())->radius();
+            existingRadius = static_cast<const SketchCircle*>(entity)->radius();
             hasRadius = true;
         } else if (entity->type() == EntityType::Arc) {
-            existingRadius = static_cast<const SketchArc*>(entity.get())->radius();
+            existingRadius = static_cast<const SketchArc*>(entity)->radius();
             hasRadius = true;
         }
 
@@ -718,7 +759,7 @@ std::optional<InferredConstraint> AutoConstrainer::inferEqualRadius(
         double diff = std::abs(radius - existingRadius);
         if (diff < bestDiff) {
             bestDiff = diff;
-            double confidence = 1.0 - (diff / RADIUS_TOLERANCE);
+            double confidence = 1.0 - (diff / kEqualRadiusTolerance);
 
             best = InferredConstraint{
                 .type = ConstraintType::Equal,
@@ -732,6 +773,108 @@ std::optional<InferredConstraint> AutoConstrainer::inferEqualRadius(
     return best;
 }
 
+// ========== Candidate Index ==========
+
+const AutoConstrainer::CandidateIndex& AutoConstrainer::candidateIndex(const Sketch& sketch) const {
+    CandidateIndex& index = candidates_;
+    const uint64_t revision = sketch.geometryRevision();
+    if (index.sketchInstance == sketch.geometryInstanceId() && index.revision == revision &&
+        index.entityCount == sketch.getEntityCount() &&
+        index.centerCellSize == config_.coincidenceTolerance) {
+        return index;
+    }
+
+    index = CandidateIndex{};
+    index.sketchInstance = sketch.geometryInstanceId();
+    index.revision = revision;
+    index.entityCount = sketch.getEntityCount();
+    index.centerCellSize = config_.coincidenceTolerance;
+    index.lineAngleBuckets.resize(kAngleBucketCount);
+
+    for (const auto& entity : sketch.getAllEntities()) {
+        if (entity->type() == EntityType::Line) {
+            const auto* line = static_cast<const SketchLine*>(entity.get());
+            const auto* startPt = sketch.getEntityAs<SketchPoint>(line->startPointId());
+            const auto* endPt = sketch.getEntityAs<SketchPoint>(line->endPointId());
+            if (!startPt || !endPt) continue;
+
+            Vec2d start = toVec2d(startPt->position());
+            Vec2d end = toVec2d(endPt->position());
+            if (distance(start, end) < constants::MIN_GEOMETRY_SIZE) {
+                continue;
+            }
+            const double angle = lineAngle(start, end);
+            int bucket = static_cast<int>(directionAngle(angle) / kAngleBucketWidth);
+            bucket = std::clamp(bucket, 0, kAngleBucketCount - 1);
+            index.lineAngleBuckets[static_cast<size_t>(bucket)].push_back(index.lines.size());
+            index.lines.push_back(entity->id());
+            index.lineAngles.push_back(angle);
+            continue;
+        }
+
+        double radius = 0.0;
+        EntityID centerId;
+        if (entity->type() == EntityType::Circle) {
+            const auto* circle = static_cast<const SketchCircle*>(entity.get());
+            radius = circle->radius();
+            centerId = circle->centerPointId();
+        } else if (entity->type() == EntityType::Arc) {
+            const auto* arc = static_cast<const SketchArc*>(entity.get());
+            radius = arc->radius();
+            centerId = arc->centerPointId();
+        } else {
+            continue;
+        }
+
+        const size_t curveIndex = index.curves.size();
+        index.curves.push_back(entity->id());
+        if (std::isfinite(radius)) {
+            index.radiusBuckets[cellCoord(radius, kEqualRadiusTolerance)].push_back(curveIndex);
+        }
+        const auto* centerPt = sketch.getEntityAs<SketchPoint>(centerId);
+        if (centerPt && index.centerCellSize > 0.0) {
+            Vec2d c = toVec2d(centerPt->position());
+            if (std::isfinite(c.x) && std::isfinite(c.y)) {
+                index.centerCells[packCell(cellCoord(c.x, index.centerCellSize),
+                                           cellCoord(c.y, index.centerCellSize))]
+                    .push_back(curveIndex);
+            }
+        }
+    }
+
+    qCDebug(logAutoConstrainer) << "candidateIndex:rebuilt"
+                                << "revision=" << revision
+                                << "lines=" << index.lines.size()
+                                << "curves=" << index.curves.size();
+    return index;
+}
+
+std::vector<size_t> AutoConstrainer::linesNearDirection(const CandidateIndex& index,
+                                                        double angle,
+                                                        double tolerance) const {
+    std::vector<size_t> result;
+    if (!(tolerance >= 0.0) || !std::isfinite(angle)) {
+        return result;
+    }
+
+    // One extra bucket each side absorbs rounding at bucket edges
+    const double target = directionAngle(angle);
+    long long first = static_cast<long long>(std::floor((target - tolerance) / kAngleBucketWidth)) - 1;
+    long long last = static_cast<long long>(std::floor((target + tolerance) / kAngleBucketWidth)) + 1;
+    if (last - first + 1 >= kAngleBucketCount) {
+        first = 0;
+        last = kAngleBucketCount - 1;
+    }
+
+    for (long long b = first; b <= last; ++b) {
+        const long long wrapped = ((b % kAngleBucketCount) + kAngleBucketCount) % kAngleBucketCount;
+        const auto& bucket = index.lineAngleBuckets[static_cast<size_t>(wrapped)];
+        result.insert(result.end(), bucket.begin(), bucket.end());
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
 // ========== Geometry Helpers ==========
 
 double AutoConstrainer::lineAngle(const Vec2d& start, const Vec2d& end) {
@@ -742,9 +885,10 @@ double AutoConstrainer::angleBetweenLines(
     const Vec2d& line1Start, const Vec2d& line1End,
     const Vec2d& line2Start, const Vec2d& line2End)
 {
-    double angle1 = lineAngle(line1Start, line1End);
-    double angle2 = lineAngle(line2Start, line2End);
+    return angleBetweenDirections(lineAngle(line1Start, line1End), lineAngle(line2Start, line2End));
+}
 
+double AutoConstrainer::angleBetweenDirections(double angle1, double angle2) {
     double diff = std::abs(normalizeAngle(angle1 - angle2));
     // Return angle in [0, π]
     return std::min(diff, PI - diff);
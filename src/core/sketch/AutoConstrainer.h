@@ -17,6 +17,7 @@
 #define ONECAD_CORE_SKETCH_AUTO_CONSTRAINER_H
 
 #include "SketchTypes.h"
+#include <cstdint>
 #include <optional>
 #include <unordered_map>
 #include <vector>
@@ -202,6 +203,41 @@ private:
     AutoConstrainerConfig config_;
     std::unordered_map<ConstraintType, bool> typeEnabled_;
 
+    /**
+     * @brief Candidate lookup tables for one sketch geometry revision
+     *
+     * Coincident and tangent candidates come from the sketch spatial index;
+     * this holds the orientation/size tables the spatial index cannot answer.
+     * Buckets store indices into lines/curves, which are in sketch order, so
+     * sorted candidates are evaluated in the same order as a full scan.
+     */
+    struct CandidateIndex {
+        uint64_t sketchInstance = 0;                            ///< Sketch::geometryInstanceId()
+        uint64_t revision = 0;
+        size_t entityCount = 0;
+        double centerCellSize = 0.0;
+
+        std::vector<EntityID> lines;                            ///< Non-degenerate lines
+        std::vector<double> lineAngles;                         ///< lineAngle() per line
+        std::vector<std::vector<size_t>> lineAngleBuckets;      ///< Direction mod π
+        std::vector<EntityID> curves;                           ///< Circles and arcs
+        std::unordered_map<long long, std::vector<size_t>> radiusBuckets;
+        std::unordered_map<long long, std::vector<size_t>> centerCells;
+    };
+    mutable CandidateIndex candidates_;
+
+    /**
+     * @brief Candidate tables for sketch, rebuilt only after geometry changes
+     */
+    const CandidateIndex& candidateIndex(const Sketch& sketch) const;
+
+    /**
+     * @brief Lines whose direction is within tolerance of angle (mod π), in sketch order
+     */
+    std::vector<size_t> linesNearDirection(const CandidateIndex& index,
+                                           double angle,
+                                           double tolerance) const;
+
     // ========== Individual Inference Methods ==========
 
     /**
@@ -326,6 +362,12 @@ private:
         const Vec2d& line1Start, const Vec2d& line1End,
         const Vec2d& line2Start, const Vec2d& line2End);
 
+    /**
+     * @brief Angle between two line directions given by lineAngle()
+     * @return Angle in radians [0, π]
+     */
+    static double angleBetweenDirections(double angle1, double angle2);
+
     /**
      * @brief Check if two lines are approximately perpendicular
      */
@@ -6,14 +6,36 @@
 #include "SketchArc.h"
 #include "SketchCircle.h"
 #include "SketchPoint.h"
+#include "SketchSpatialIndex.h"
 
 #include <algorithm>
 #include <cmath>
 #include <numbers>
+#include <unordered_map>
 #include <unordered_set>
 
 namespace onecad::core::sketch {
 
+namespace {
+
+bool isSplittableType(EntityType type) {
+    return type == EntityType::Line || type == EntityType::Arc || type == EntityType::Circle;
+}
+
+long long cellCoord(double value, double cellSize) {
+    return static_cast<long long>(std::floor(value / cellSize));
+}
+
+long long packCell(long long cellX, long long cellY) {
+    return (cellX << 32) ^ (cellY & 0xffffffffLL);
+}
+
+long long cellKey(const Vec2d& pos, double cellSize) {
+    return packCell(cellCoord(pos.x, cellSize), cellCoord(pos.y, cellSize));
+}
+
+} // namespace
+
 IntersectionManager::IntersectionManager() = default;
 IntersectionManager::~IntersectionManager() = default;
 
@@ -21,6 +43,14 @@ IntersectionResult IntersectionManager::processIntersections(
     EntityID newEntityId,
     Sketch& sketch,
     const SnapManager& snapManager)
+{
+    return processIntersections(std::vector<EntityID>{newEntityId}, sketch, snapManager);
+}
+
+IntersectionResult IntersectionManager::processIntersections(
+    const std::vector<EntityID>& newEntityIds,
+    Sketch& sketch,
+    const SnapManager& snapManager)
 {
     IntersectionResult result;
 
@@ -28,242 +58,271 @@ IntersectionResult IntersectionManager::processIntersections(
         return result;
     }
 
-    auto* newEntity = sketch.getEntity(newEntityId);
-    if (!newEntity) {
-        return result;
-    }
-
     // Only process lines, arcs, circles for now
-    if (newEntity->type() != EntityType::Line &&
-        newEntity->type() != EntityType::Arc &&
-        newEntity->type() != EntityType::Circle) {
-        return result;
-    }
-
-    // Collect all existing entities (exclude the new one and points)
-    std::vector<SketchEntity*> existingEntities;
-    for (const auto& entity : sketch.getAllEntities()) {
-        if (entity->id() == newEntityId) {
+    std::unordered_set<EntityID> newIdSet;
+    std::vector<const SketchEntity*> newEntities;
+    for (const auto& id : newEntityIds) {
+        if (!newIdSet.insert(id).second) {
             continue;
         }
-        if (entity->type() == EntityType::Point) {
-            continue;
-        }
-        if (entity->type() == EntityType::Line ||
-            entity->type() == EntityType::Arc ||
-            entity->type() == EntityType::Circle) {
-            existingEntities.push_back(entity.get());
+        const SketchEntity* entity = sketch.getEntity(id);
+        if (entity && isSplittableType(entity->type())) {
+            newEntities.push_back(entity);
         }
     }
 
-    // Find all intersection points
-    std::vector<Vec2d> allIntersections;
-    std::vector<EntityID> intersectedEntityIds;
-
-    for (auto* existingEntity : existingEntities) {
-        auto intersections = findIntersections(
-            newEntity, existingEntity, sketch, snapManager);
+    if (newEntities.empty()) {
+        return result;
+    }
 
-        if (!intersections.empty()) {
-            allIntersections.insert(
-                allIntersections.end(),
-                intersections.begin(),
-                intersections.end());
+    // Broad-phase through the spatial index; narrow-phase per overlapping pair
+    std::vector<RawIntersection> rawIntersections;
+    {
+        const SketchSpatialIndex& index = sketch.spatialIndex();
+        for (const SketchEntity* newEntity : newEntities) {
+            BoundingBox2d bounds = SketchSpatialIndex::entityBounds(*newEntity, sketch);
+            if (bounds.isEmpty()) {
+                continue;
+            }
+            bounds.minX -= minPointSpacing_;
+            bounds.minY -= minPointSpacing_;
+            bounds.maxX += minPointSpacing_;
+            bounds.maxY += minPointSpacing_;
+
+            const uint64_t newOrder = index.orderOf(newEntity->id());
+            for (const auto& otherId : index.queryRect(bounds)) {
+                if (otherId == newEntity->id()) {
+                    continue;
+                }
+                // Pairs of two new entities are handled from the earlier one
+                if (newIdSet.count(otherId) && index.orderOf(otherId) < newOrder) {
+                    continue;
+                }
+                const SketchEntity* other = sketch.getEntity(otherId);
+                if (!other || !isSplittableType(other->type())) {
+                    continue;
+                }
 
-            // Track which entity was intersected (for splitting)
-            for (size_t i = 0; i < intersections.size(); ++i) {
-                intersectedEntityIds.push_back(existingEntity->id());
+                for (const auto& pt : findIntersections(newEntity, other, sketch, snapManager)) {
+                    rawIntersections.push_back({pt, newEntity->id(), otherId});
+                }
             }
         }
     }
 
-    if (allIntersections.empty()) {
+    if (rawIntersections.empty()) {
         return result;
     }
 
     // Merge nearby points
+    std::vector<Vec2d> allIntersections;
+    allIntersections.reserve(rawIntersections.size());
+    for (const auto& raw : rawIntersections) {
+        allIntersections.push_back(raw.position);
+    }
     auto mergedPoints = mergeNearbyPoints(allIntersections, minPointSpacing_);
     result.intersectionPoints = mergedPoints;
 
+    // Points and splits are applied as one edit batch
+    sketch.beginEditBatch();
+
     // Create points at each unique intersection (or use existing)
-    std::vector<EntityID> intersectionPointIds;
     for (const auto& pt : mergedPoints) {
         EntityID existingPtId = findExistingPointAt(pt, sketch, minPointSpacing_);
-
-        if (!existingPtId.empty()) {
-            intersectionPointIds.push_back(existingPtId);
-        } else {
+        if (existingPtId.empty()) {
             EntityID ptId = sketch.addPoint(pt.x, pt.y, false);
             if (!ptId.empty()) {
-                intersectionPointIds.push_back(ptId);
                 result.pointsCreated++;
             }
         }
     }
 
-    // Build map of entity -> intersection points (using MERGED points for accurate splitting)
-    // For each merged point, determine which entities it lies on
-    std::unordered_map<EntityID, std::vector<Vec2d>> entityIntersections;
-    double mergeTolSq = minPointSpacing_ * minPointSpacing_;
+    // Build map of entity -> intersection points (using MERGED points for accurate splitting).
+    // Every raw intersection within tolerance of a merged point contributes both of its
+    // entities; raw points are bucketed by cell so this stays linear in the point count.
+    const double mergeTol = minPointSpacing_;
+    const double mergeTolSq = mergeTol * mergeTol;
+    const double cellSize = mergeTol > 0.0 ? mergeTol : 1.0;
+    std::unordered_map<long long, std::vector<size_t>> rawCells;
+    for (size_t i = 0; i < rawIntersections.size(); ++i) {
+        rawCells[cellKey(rawIntersections[i].position, cellSize)].push_back(i);
+    }
 
+    std::vector<EntityID> splitOrder;
+    std::unordered_map<EntityID, std::vector<Vec2d>> entityIntersections;
     for (const Vec2d& mergedPt : mergedPoints) {
-        // Track which entities this merged point should be applied to
         std::unordered_set<EntityID> entitiesForThisPoint;
-
-        // All merged points lie on the new entity (by construction)
-        if (newEntity->type() == EntityType::Line || newEntity->type() == EntityType::Arc) {
-            entitiesForThisPoint.insert(newEntityId);
-        }
-
-        // Find which existing entities contributed to this merged point
-        for (size_t i = 0; i < allIntersections.size(); ++i) {
-            double dx = allIntersections[i].x - mergedPt.x;
-            double dy = allIntersections[i].y - mergedPt.y;
-            if (dx*dx + dy*dy <= mergeTolSq) {
-                // This raw intersection was merged into mergedPt
-                entitiesForThisPoint.insert(intersectedEntityIds[i]);
+        const long long cellX = cellCoord(mergedPt.x, cellSize);
+        const long long cellY = cellCoord(mergedPt.y, cellSize);
+        for (long long dx = -1; dx <= 1; ++dx) {
+            for (long long dy = -1; dy <= 1; ++dy) {
+                auto cellIt = rawCells.find(packCell(cellX + dx, cellY + dy));
+                if (cellIt == rawCells.end()) {
+                    continue;
+                }
+                for (size_t i : cellIt->second) {
+                    const RawIntersection& raw = rawIntersections[i];
+                    double ddx = raw.position.x - mergedPt.x;
+                    double ddy = raw.position.y - mergedPt.y;
+                    if (ddx * ddx + ddy * ddy > mergeTolSq) {
+                        continue;
+                    }
+                    for (const EntityID* id : {&raw.firstEntityId, &raw.secondEntityId}) {
+                        if (!entitiesForThisPoint.insert(*id).second) {
+                            continue;
+                        }
+                        auto [it, inserted] = entityIntersections.try_emplace(*id);
+                        if (inserted) {
+                            splitOrder.push_back(*id);
+                        }
+                        it->second.push_back(mergedPt);
+                    }
+                }
             }
         }
+    }
 
-        // Add merged point to all relevant entities
-        for (const EntityID& entityId : entitiesForThisPoint) {
-            entityIntersections[entityId].push_back(mergedPt);
-        }
+    // Split each intersected entity at its intersection points, all in one pass
+    for (const EntityID& entityId : splitOrder) {
+        splitEntityAt(entityId, entityIntersections[entityId], sketch, result);
     }
 
-    // Split each intersected entity at its intersection points
-    // NOTE: We need to be careful about order - split from end to start
-    // to avoid invalidating entity IDs during splitting
+    sketch.endEditBatch();
 
-    for (auto& [entityId, points] : entityIntersections) {
-        auto* entity = sketch.getEntity(entityId);
-        if (!entity) {
-            continue;
-        }
+    return result;
+}
 
-        if (entity->type() == EntityType::Line) {
-            auto* line = sketch.getEntityAs<SketchLine>(entityId);
-            if (!line) {
-                continue;
-            }
+void IntersectionManager::splitEntityAt(
+    const EntityID& entityId,
+    const std::vector<Vec2d>& points,
+    Sketch& sketch,
+    IntersectionResult& result) const
+{
+    auto* entity = sketch.getEntity(entityId);
+    if (!entity) {
+        return;
+    }
 
-            auto* startPt = sketch.getEntityAs<SketchPoint>(line->startPointId());
-            auto* endPt = sketch.getEntityAs<SketchPoint>(line->endPointId());
-            if (!startPt || !endPt) {
-                continue;
-            }
+    if (entity->type() == EntityType::Line) {
+        auto* line = sketch.getEntityAs<SketchLine>(entityId);
+        if (!line) {
+            return;
+        }
 
-            // Sort intersection points along line (by parameter t)
-            gp_Pnt2d p1 = startPt->position();
-            gp_Pnt2d p2 = endPt->position();
-            double dx = p2.X() - p1.X();
-            double dy = p2.Y() - p1.Y();
-            double lenSq = dx * dx + dy * dy;
+        auto* startPt = sketch.getEntityAs<SketchPoint>(line->startPointId());
+        auto* endPt = sketch.getEntityAs<SketchPoint>(line->endPointId());
+        if (!startPt || !endPt) {
+            return;
+        }
 
-            if (lenSq < 1e-10) {
-                continue;
-            }
+        // Sort intersection points along line (by parameter t)
+        gp_Pnt2d p1 = startPt->position();
+        gp_Pnt2d p2 = endPt->position();
+        double dx = p2.X() - p1.X();
+        double dy = p2.Y() - p1.Y();
+        double lenSq = dx * dx + dy * dy;
 
-            struct SplitPoint {
-                Vec2d pos;
-                double t;
-            };
-            std::vector<SplitPoint> splits;
-
-            for (const auto& pt : points) {
-                double t = ((pt.x - p1.X()) * dx + (pt.y - p1.Y()) * dy) / lenSq;
-                // Only split if point is actually on segment interior
-                if (t > 0.001 && t < 0.999) {
-                    splits.push_back({pt, t});
-                }
-            }
+        if (lenSq < 1e-10) {
+            return;
+        }
 
-            if (splits.empty()) {
-                continue;
+        struct SplitPoint {
+            Vec2d pos;
+            double t;
+        };
+        std::vector<SplitPoint> splits;
+
+        for (const auto& pt : points) {
+            double t = ((pt.x - p1.X()) * dx + (pt.y - p1.Y()) * dy) / lenSq;
+            // Only split if point is actually on segment interior
+            if (t > 0.001 && t < 0.999) {
+                splits.push_back({pt, t});
             }
+        }
 
-            // Sort by parameter t (ascending)
-            std::sort(splits.begin(), splits.end(),
-                [](const SplitPoint& a, const SplitPoint& b) {
-                    return a.t < b.t;
-                });
-
-            // Split multiple times (from end to start to maintain IDs)
-            EntityID currentLineId = entityId;
-            for (auto it = splits.rbegin(); it != splits.rend(); ++it) {
-                auto [seg1, seg2] = sketch.splitLineAt(currentLineId, it->pos);
-                if (!seg1.empty() && !seg2.empty()) {
-                    result.newSegments.push_back(seg1);
-                    result.newSegments.push_back(seg2);
-                    result.entitiesSplit++;
-                    currentLineId = seg1;  // Continue splitting the first segment
-                }
-            }
+        if (splits.empty()) {
+            return;
         }
-        else if (entity->type() == EntityType::Arc) {
-            auto* arc = sketch.getEntityAs<SketchArc>(entityId);
-            if (!arc) {
-                continue;
-            }
 
-            auto* centerPt = sketch.getEntityAs<SketchPoint>(arc->centerPointId());
-            if (!centerPt) {
-                continue;
+        // Sort by parameter t (ascending)
+        std::sort(splits.begin(), splits.end(),
+            [](const SplitPoint& a, const SplitPoint& b) {
+                return a.t < b.t;
+            });
+
+        // Split multiple times (from end to start to maintain IDs)
+        EntityID currentLineId = entityId;
+        for (auto it = splits.rbegin(); it != splits.rend(); ++it) {
+            auto [seg1, seg2] = sketch.splitLineAt(currentLineId, it->pos);
+            if (!seg1.empty() && !seg2.empty()) {
+                result.newSegments.push_back(seg1);
+                result.newSegments.push_back(seg2);
+                result.entitiesSplit++;
+                currentLineId = seg1;  // Continue splitting the first segment
             }
+        }
+    }
+    else if (entity->type() == EntityType::Arc) {
+        auto* arc = sketch.getEntityAs<SketchArc>(entityId);
+        if (!arc) {
+            return;
+        }
 
-            gp_Pnt2d center = centerPt->position();
-
-            // Calculate angles for each intersection point
-            struct SplitAngle {
-                double angle;
-            };
-            std::vector<SplitAngle> splits;
-
-            for (const auto& pt : points) {
-                double angle = std::atan2(pt.y - center.Y(), pt.x - center.X());
-                if (arc->containsAngle(angle)) {
-                    // Check not too close to endpoints
-                    double startAngle = arc->startAngle();
-                    double endAngle = arc->endAngle();
-
-                    auto angleDiff = [](double a1, double a2) {
-                        double diff = std::fmod(std::abs(a1 - a2), 2.0 * std::numbers::pi);
-                        return std::min(diff, 2.0 * std::numbers::pi - diff);
-                    };
-
-                    if (angleDiff(angle, startAngle) > 0.01 &&
-                        angleDiff(angle, endAngle) > 0.01) {
-                        splits.push_back({angle});
-                    }
+        auto* centerPt = sketch.getEntityAs<SketchPoint>(arc->centerPointId());
+        if (!centerPt) {
+            return;
+        }
+
+        gp_Pnt2d center = centerPt->position();
+
+        // Calculate angles for each intersection point
+        struct SplitAngle {
+            double angle;
+        };
+        std::vector<SplitAngle> splits;
+
+        for (const auto& pt : points) {
+            double angle = std::atan2(pt.y - center.Y(), pt.x - center.X());
+            if (arc->containsAngle(angle)) {
+                // Check not too close to endpoints
+                double startAngle = arc->startAngle();
+                double endAngle = arc->endAngle();
+
+                auto angleDiff = [](double a1, double a2) {
+                    double diff = std::fmod(std::abs(a1 - a2), 2.0 * std::numbers::pi);
+                    return std::min(diff, 2.0 * std::numbers::pi - diff);
+                };
+
+                if (angleDiff(angle, startAngle) > 0.01 &&
+                    angleDiff(angle, endAngle) > 0.01) {
+                    splits.push_back({angle});
                 }
             }
+        }
 
-            if (splits.empty()) {
-                continue;
-            }
+        if (splits.empty()) {
+            return;
+        }
 
-            // Sort by angle
-            std::sort(splits.begin(), splits.end(),
-                [](const SplitAngle& a, const SplitAngle& b) {
-                    return a.angle < b.angle;
-                });
-
-            // Split arc (from end to start)
-            EntityID currentArcId = entityId;
-            for (auto it = splits.rbegin(); it != splits.rend(); ++it) {
-                auto [seg1, seg2] = sketch.splitArcAt(currentArcId, it->angle);
-                if (!seg1.empty() && !seg2.empty()) {
-                    result.newSegments.push_back(seg1);
-                    result.newSegments.push_back(seg2);
-                    result.entitiesSplit++;
-                    currentArcId = seg1;
-                }
+        // Sort by angle
+        std::sort(splits.begin(), splits.end(),
+            [](const SplitAngle& a, const SplitAngle& b) {
+                return a.angle < b.angle;
+            });
+
+        // Split arc (from end to start)
+        EntityID currentArcId = entityId;
+        for (auto it = splits.rbegin(); it != splits.rend(); ++it) {
+            auto [seg1, seg2] = sketch.splitArcAt(currentArcId, it->angle);
+            if (!seg1.empty() && !seg2.empty()) {
+                result.newSegments.push_back(seg1);
+                result.newSegments.push_back(seg2);
+                result.entitiesSplit++;
+                currentArcId = seg1;
             }
         }
-        // Circles are not split (they're closed curves)
     }
-
-    return result;
+    // Circles are not split (they're closed curves)
 }
 
 std::vector<Vec2d> IntersectionManager::findIntersections(
@@ -283,12 +342,13 @@ EntityID IntersectionManager::findExistingPointAt(
 {
     double tolSq = tolerance * tolerance;
 
-    for (const auto& entity : sketch.getAllEntities()) {
-        if (entity->type() != EntityType::Point) {
+    // Candidates come back in sketch order, so the first match is the oldest point
+    for (const auto& id : sketch.spatialIndex().queryRadius(pos, tolerance)) {
+        auto* pt = sketch.getEntityAs<SketchPoint>(id);
+        if (!pt) {
             continue;
         }
 
-        auto* pt = static_cast<const SketchPoint*>(entity.get());
         gp_Pnt2d ptPos = pt->position();
 
         double dx = pos.x - ptPos.X();
@@ -315,6 +375,14 @@ std::vector<Vec2d> IntersectionManager::mergeNearbyPoints(
     std::vector<bool> used(points.size(), false);
     double tolSq = tolerance * tolerance;
 
+    // Bucket points by cell so each seed only scans its neighbourhood
+    const double cellSize = tolerance > 0.0 ? tolerance : 1.0;
+    std::unordered_map<long long, std::vector<size_t>> cells;
+    for (size_t i = 0; i < points.size(); ++i) {
+        cells[cellKey(points[i], cellSize)].push_back(i);
+    }
+
+    std::vector<size_t> nearby;
     for (size_t i = 0; i < points.size(); ++i) {
         if (used[i]) {
             continue;
@@ -325,23 +393,39 @@ std::vector<Vec2d> IntersectionManager::mergeNearbyPoints(
         size_t clusterSize = 1;
         used[i] = true;
 
-        // Find all nearby points and average them
-        for (size_t j = i + 1; j < points.size(); ++j) {
-            if (used[j]) {
-                continue;
-            }
+        // Find all nearby points (later in input order) and average them
+        nearby.clear();
+        const long long cellX = cellCoord(points[i].x, cellSize);
+        const long long cellY = cellCoord(points[i].y, cellSize);
+        for (long long cx = cellX - 1; cx <= cellX + 1; ++cx) {
+            for (long long cy = cellY - 1; cy <= cellY + 1; ++cy) {
+                auto cellIt = cells.find(packCell(cx, cy));
+                if (cellIt == cells.end()) {
+                    continue;
+                }
+                for (size_t j : cellIt->second) {
+                    if (j <= i || used[j]) {
+                        continue;
+                    }
 
-            double dx = points[j].x - points[i].x;
-            double dy = points[j].y - points[i].y;
-            double distSq = dx * dx + dy * dy;
+                    double dx = points[j].x - points[i].x;
+                    double dy = points[j].y - points[i].y;
+                    double distSq = dx * dx + dy * dy;
 
-            if (distSq <= tolSq) {
-                cluster.x += points[j].x;
-                cluster.y += points[j].y;
-                clusterSize++;
-                used[j] = true;
+                    if (distSq <= tolSq) {
+                        nearby.push_back(j);
+                    }
+                }
             }
         }
+        std::sort(nearby.begin(), nearby.end());
+
+        for (size_t j : nearby) {
+            cluster.x += points[j].x;
+            cluster.y += points[j].y;
+            clusterSize++;
+            used[j] = true;
+        }
 
         // Average the cluster
         cluster.x /= clusterSize;
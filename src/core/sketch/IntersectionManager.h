@@ -57,6 +57,26 @@ public:
         Sketch& sketch,
         const SnapManager& snapManager);
 
+    /**
+     * @brief Process intersections for a batch of new entities at once
+     * @param newEntityIds IDs of newly created entities
+     * @param sketch Sketch containing the entities
+     * @param snapManager SnapManager for intersection detection
+     * @return Combined split statistics
+     *
+     * Candidate pairs come from the sketch spatial index, so each new entity is
+     * only tested against curves whose bounds overlap it. Pairs of two new
+     * entities are tested once. All points are merged globally and every
+     * affected entity is split in a single pass after detection finishes.
+     *
+     * The single-entity overload used by the drawing tools runs through this
+     * path with a batch of one.
+     */
+    IntersectionResult processIntersections(
+        const std::vector<EntityID>& newEntityIds,
+        Sketch& sketch,
+        const SnapManager& snapManager);
+
     /**
      * @brief Enable/disable automatic intersection processing
      */
@@ -76,6 +96,15 @@ private:
     bool enabled_ = true;
     double minPointSpacing_ = 0.01;  // mm
 
+    /**
+     * @brief Raw intersection between two curves, before merging
+     */
+    struct RawIntersection {
+        Vec2d position;
+        EntityID firstEntityId;
+        EntityID secondEntityId;
+    };
+
     /**
      * @brief Find all intersections between two entities
      */
@@ -99,6 +128,15 @@ private:
     std::vector<Vec2d> mergeNearbyPoints(
         const std::vector<Vec2d>& points,
         double tolerance) const;
+
+    /**
+     * @brief Split a line or arc at the given points (circles are left intact)
+     */
+    void splitEntityAt(
+        const EntityID& entityId,
+        const std::vector<Vec2d>& points,
+        Sketch& sketch,
+        IntersectionResult& result) const;
 };
 
 } // namespace onecad::core::sketch
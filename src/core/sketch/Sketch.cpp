@@ -2,7 +2,9 @@
 #include "constraints/Constraints.h"
 #include "solver/ConstraintSolver.h"
 #include "solver/SolverAdapter.h"
+#include "../loop/LoopResultCache.h"
 #include "../loop/RegionUtils.h"
+#include "../memory/MemoryEstimate.h"
 
 #include <QJsonArray>
 #include <QJsonDocument>
@@ -21,7 +23,9 @@ namespace onecad::core::sketch {
 Q_LOGGING_CATEGORY(logSketchEngine, "onecad.core.sketch")
 
 Sketch::Sketch(const SketchPlane& plane)
-    : plane_(plane) {
+    : plane_(plane)
+    , spatialIndex_(std::make_unique<SketchSpatialIndex>())
+    , loopCache_(std::make_unique<loop::LoopResultCache>()) {
 }
 
 Sketch::~Sketch() = default;
@@ -38,6 +42,7 @@ EntityID Sketch::addPoint(double x, double y, bool construction) {
     EntityID id = point->id();
     entityIndex_[id] = entities_.size();
     entities_.push_back(std::move(point));
+    trackEntity(*entities_.back());
 
     invalidateSolver();
     qCDebug(logSketchEngine) << "addPoint:done"
@@ -64,6 +69,7 @@ EntityID Sketch::addLine(EntityID startId, EntityID endId, bool construction) {
     EntityID id = line->id();
     entityIndex_[id] = entities_.size();
     entities_.push_back(std::move(line));
+    trackEntity(*entities_.back());
 
     startPoint->addConnectedEntity(id);
     endPoint->addConnectedEntity(id);
@@ -94,6 +100,7 @@ EntityID Sketch::addArc(EntityID centerId, double radius, double startAngle,
     EntityID id = arc->id();
     entityIndex_[id] = entities_.size();
     entities_.push_back(std::move(arc));
+    trackEntity(*entities_.back());
 
     centerPoint->addConnectedEntity(id);
 
@@ -113,6 +120,7 @@ EntityID Sketch::addCircle(EntityID centerId, double radius, bool construction)
     EntityID id = circle->id();
     entityIndex_[id] = entities_.size();
     entities_.push_back(std::move(circle));
+    trackEntity(*entities_.back());
 
     centerPoint->addConnectedEntity(id);
 
@@ -151,6 +159,7 @@ EntityID Sketch::addEllipse(EntityID centerId, double majorRadius, double minorR
     EntityID id = ellipse->id();
     entityIndex_[id] = entities_.size();
     entities_.push_back(std::move(ellipse));
+    trackEntity(*entities_.back());
 
     centerPoint->addConnectedEntity(id);
 
@@ -274,8 +283,19 @@ bool Sketch::removeEntity(EntityID id) {
         rebuildConstraintIndex();
     }
 
-    entities_.erase(entities_.begin() + static_cast<long>(it->second));
-    rebuildEntityIndex();
+    spatialIndex_->entityRemoved(id);
+    const size_t removedIndex = it->second;
+    entityIndex_.erase(it);
+    if (editBatchDepth_ > 0) {
+        // Storage is compacted once when the batch ends
+        editBatchHasRemovals_ = true;
+    } else {
+        // Only entities after the erased slot shift; re-index just those
+        entities_.erase(entities_.begin() + static_cast<long>(removedIndex));
+        for (size_t i = removedIndex; i < entities_.size(); ++i) {
+            entityIndex_[entities_[i]->id()] = i;
+        }
+    }
     invalidateSolver();
 
     // Clean up orphaned points (points with no connected entities)
@@ -290,6 +310,25 @@ bool Sketch::removeEntity(EntityID id) {
     return true;
 }
 
+void Sketch::beginEditBatch() {
+    ++editBatchDepth_;
+}
+
+void Sketch::endEditBatch() {
+    if (editBatchDepth_ == 0) {
+        return;
+    }
+    if (--editBatchDepth_ > 0 || !editBatchHasRemovals_) {
+        return;
+    }
+
+    editBatchHasRemovals_ = false;
+    std::erase_if(entities_, [this](const std::unique_ptr<SketchEntity>& entity) {
+        return entityIndex_.find(entity->id()) == entityIndex_.end();
+    });
+    rebuildEntityIndex();
+}
+
 std::pair<EntityID, EntityID> Sketch::splitLineAt(EntityID lineId, const Vec2d& splitPoint) {
     auto* line = getEntityAs<SketchLine>(lineId);
     if (!line) {
@@ -339,23 +378,35 @@ std::pair<EntityID, EntityID> Sketch::splitLineAt(EntityID lineId, const Vec2d&
         }
     }
 
-    // Remove original line (this also removes constraints)
-    if (!removeEntity(lineId)) {
-        return {{}, {}};
-    }
-
     // Create intermediate point at split location
     EntityID midPointId = addPoint(splitPoint.x, splitPoint.y, construction);
     if (midPointId.empty()) {
         return {{}, {}};
     }
 
-    // Create two new line segments
+    // Create two new line segments before removing the original, so its
+    // endpoints stay connected and are not cleaned up as orphans
     EntityID line1Id = addLine(origStartId, midPointId, construction);
     EntityID line2Id = addLine(midPointId, origEndId, construction);
 
+    // Undo partial work; the original line keeps its endpoints alive
+    auto rollback = [&]() {
+        for (const EntityID& segmentId : {line1Id, line2Id}) {
+            if (!segmentId.empty()) {
+                removeEntity(segmentId);
+            }
+        }
+        removeEntity(midPointId);
+        return std::pair<EntityID, EntityID>{};
+    };
+
     if (line1Id.empty() || line2Id.empty()) {
-        return {{}, {}};
+        return rollback();
+    }
+
+    // Remove original line (this also removes constraints)
+    if (!removeEntity(lineId)) {
+        return rollback();
     }
 
     return {line1Id, line2Id};
@@ -402,11 +453,6 @@ std::pair<EntityID, EntityID> Sketch::splitArcAt(EntityID arcId, double splitAng
     double radius = arc->radius();
     bool construction = arc->isConstruction();
 
-    // Remove original arc
-    if (!removeEntity(arcId)) {
-        return {{}, {}};
-    }
-
     // Calculate split point position
     gp_Pnt2d center = centerPt->position();
     double splitX = center.X() + radius * std::cos(splitAngle);
@@ -418,12 +464,28 @@ std::pair<EntityID, EntityID> Sketch::splitArcAt(EntityID arcId, double splitAng
         return {{}, {}};
     }
 
-    // Create two arc segments
+    // Create two arc segments before removing the original, so the shared
+    // center point is not cleaned up as an orphan
     EntityID arc1Id = addArc(centerId, radius, startAngle, splitAngle, construction);
     EntityID arc2Id = addArc(centerId, radius, splitAngle, endAngle, construction);
 
+    auto rollback = [&]() {
+        for (const EntityID& segmentId : {arc1Id, arc2Id}) {
+            if (!segmentId.empty()) {
+                removeEntity(segmentId);
+            }
+        }
+        removeEntity(splitPointId);
+        return std::pair<EntityID, EntityID>{};
+    };
+
     if (arc1Id.empty() || arc2Id.empty()) {
-        return {{}, {}};
+        return rollback();
+    }
+
+    // Remove original arc
+    if (!removeEntity(arcId)) {
+        return rollback();
     }
 
     return {arc1Id, arc2Id};
@@ -900,9 +962,13 @@ SolveResult Sketch::solve() {
     }
 
     SolverResult solverResult = solver_->solve();
+    for (const auto& id : solverResult.movedEntities) {
+        spatialIndex_->entityGeometryChanged(id);
+    }
     result.success = solverResult.success;
     result.iterations = solverResult.iterations;
     result.residual = solverResult.residual;
+    result.movedEntities = solverResult.movedEntities;
     result.conflictingConstraints = solverResult.conflictingConstraints;
     result.errorMessage = solverResult.errorMessage;
     return result;
@@ -1022,9 +1088,13 @@ SolveResult Sketch::solveWithDrag(EntityID draggedPoint, const Vec2d& targetPos)
         isDraggingPoint_ ? activeDragFixedPoints_ : kNoFixedPoints;
 
     SolverResult solverResult = solver_->solveWithDrag(draggedPoint, targetPos, pointIdsToFix);
+    for (const auto& id : solverResult.movedEntities) {
+        spatialIndex_->entityGeometryChanged(id);
+    }
     result.success = solverResult.success;
     result.iterations = solverResult.iterations;
     result.residual = solverResult.residual;
+    result.movedEntities = solverResult.movedEntities;
     result.conflictingConstraints = solverResult.conflictingConstraints;
     result.errorMessage = solverResult.errorMessage;
 
@@ -1297,6 +1367,7 @@ std::unique_ptr<Sketch> Sketch::fromJson(const std::string& json) {
             EntityID id = entity->id();
             sketch->entityIndex_[id] = sketch->entities_.size();
             sketch->entities_.push_back(std::move(entity));
+            sketch->trackEntity(*sketch->entities_.back());
         }
     }
 
@@ -1352,7 +1423,9 @@ EntityID Sketch::findNearest(const Vec2d& pos, double tolerance,
     double bestDistance = tolerance;
     gp_Pnt2d query(pos.x, pos.y);
 
-    for (const auto& entity : entities_) {
+    // Anything within tolerance has bounds overlapping the tolerance square
+    for (const auto& id : spatialIndex().queryRadius(pos, tolerance)) {
+        const SketchEntity* entity = getEntity(id);
         if (!entity) {
             continue;
         }
@@ -1363,12 +1436,12 @@ EntityID Sketch::findNearest(const Vec2d& pos, double tolerance,
         double distance = std::numeric_limits<double>::infinity();
         switch (entity->type()) {
             case EntityType::Point: {
-                auto* point = dynamic_cast<SketchPoint*>(entity.get());
+                auto* point = dynamic_cast<const SketchPoint*>(entity);
                 distance = point ? point->distanceTo(query) : distance;
                 break;
             }
             case EntityType::Line: {
-                auto* line = dynamic_cast<SketchLine*>(entity.get());
+                auto* line = dynamic_cast<const SketchLine*>(entity);
                 if (!line) {
                     break;
                 }
@@ -1381,7 +1454,7 @@ EntityID Sketch::findNearest(const Vec2d& pos, double tolerance,
                 break;
             }
             case EntityType::Arc: {
-                auto* arc = dynamic_cast<SketchArc*>(entity.get());
+                auto* arc = dynamic_cast<const SketchArc*>(entity);
                 if (!arc) {
                     break;
                 }
@@ -1396,7 +1469,7 @@ EntityID Sketch::findNearest(const Vec2d& pos, double tolerance,
                 break;
             }
             case EntityType::Circle: {
-                auto* circle = dynamic_cast<SketchCircle*>(entity.get());
+                auto* circle = dynamic_cast<const SketchCircle*>(entity);
                 if (!circle) {
                     break;
                 }
@@ -1408,7 +1481,7 @@ EntityID Sketch::findNearest(const Vec2d& pos, double tolerance,
                 break;
             }
             case EntityType::Ellipse: {
-                auto* ellipse = dynamic_cast<SketchEllipse*>(entity.get());
+                auto* ellipse = dynamic_cast<const SketchEllipse*>(entity);
                 if (!ellipse) {
                     break;
                 }
@@ -1451,7 +1524,9 @@ std::vector<EntityID> Sketch::findInRect(const Vec2d& min, const Vec2d& max) con
     rect.maxX = std::max(min.x, max.x);
     rect.maxY = std::max(min.y, max.y);
 
-    for (const auto& entity : entities_) {
+    // Indexed curve bounds also cover the center point; exact bounds are re-checked below
+    for (const auto& id : spatialIndex().queryRect(rect)) {
+        const SketchEntity* entity = getEntity(id);
         if (!entity) {
             continue;
         }
@@ -1459,14 +1534,14 @@ std::vector<EntityID> Sketch::findInRect(const Vec2d& min, const Vec2d& max) con
         BoundingBox2d bounds;
         switch (entity->type()) {
             case EntityType::Point: {
-                auto* point = dynamic_cast<SketchPoint*>(entity.get());
+                auto* point = dynamic_cast<const SketchPoint*>(entity);
                 if (point) {
                     bounds = point->bounds();
                 }
                 break;
             }
             case EntityType::Line: {
-                auto* line = dynamic_cast<SketchLine*>(entity.get());
+                auto* line = dynamic_cast<const SketchLine*>(entity);
                 if (!line) {
                     break;
                 }
@@ -1479,7 +1554,7 @@ std::vector<EntityID> Sketch::findInRect(const Vec2d& min, const Vec2d& max) con
                 break;
             }
             case EntityType::Arc: {
-                auto* arc = dynamic_cast<SketchArc*>(entity.get());
+                auto* arc = dynamic_cast<const SketchArc*>(entity);
                 if (!arc) {
                     break;
                 }
@@ -1491,7 +1566,7 @@ std::vector<EntityID> Sketch::findInRect(const Vec2d& min, const Vec2d& max) con
                 break;
             }
             case EntityType::Circle: {
-                auto* circle = dynamic_cast<SketchCircle*>(entity.get());
+                auto* circle = dynamic_cast<const SketchCircle*>(entity);
                 if (!circle) {
                     break;
                 }
@@ -1503,7 +1578,7 @@ std::vector<EntityID> Sketch::findInRect(const Vec2d& min, const Vec2d& max) con
                 break;
             }
             case EntityType::Ellipse: {
-                auto* ellipse = dynamic_cast<SketchEllipse*>(entity.get());
+                auto* ellipse = dynamic_cast<const SketchEllipse*>(entity);
                 if (!ellipse) {
                     break;
                 }
@@ -1545,6 +1620,77 @@ void Sketch::rebuildSolver() {
     qCDebug(logSketchEngine) << "rebuildSolver:done";
 }
 
+const SketchSpatialIndex& Sketch::spatialIndex() const {
+    spatialIndex_->flush(*this);
+    return *spatialIndex_;
+}
+
+const SketchIntersectionIndex& Sketch::intersectionIndex() const {
+    spatialIndex_->flush(*this);
+    spatialIndex_->flushIntersections(*this);
+    return spatialIndex_->intersections();
+}
+
+const loop::LoopDetectionResult& Sketch::loopDetection(const loop::LoopDetectorConfig& config) const {
+    return loopCache_->detect(*this, config);
+}
+
+const std::vector<loop::RegionDefinition>& Sketch::regionDefinitions(
+    const loop::LoopDetectorConfig& config) const {
+    return loopCache_->regions(*this, config);
+}
+
+const loop::LoopCacheStats& Sketch::loopCacheStats() const {
+    return loopCache_->stats();
+}
+
+void Sketch::resetLoopCacheStats() const {
+    loopCache_->resetStats();
+}
+
+void Sketch::logLoopCacheStats(const char* context) const {
+    loopCache_->logStats(context);
+}
+
+SketchMemoryUsage Sketch::memoryUsage() const {
+    // R-tree node share plus pending/intersection bookkeeping per entity
+    constexpr size_t kIndexBytesPerEntity = 128;
+
+    SketchMemoryUsage usage;
+    usage.entityBytes = memory::vectorBytes(entities_) + memory::stringMapBytes(entityIndex_);
+    for (const auto& entity : entities_) {
+        switch (entity->type()) {
+            case EntityType::Point: usage.entityBytes += sizeof(SketchPoint); break;
+            case EntityType::Line: usage.entityBytes += sizeof(SketchLine); break;
+            case EntityType::Arc: usage.entityBytes += sizeof(SketchArc); break;
+            case EntityType::Circle: usage.entityBytes += sizeof(SketchCircle); break;
+            case EntityType::Ellipse: usage.entityBytes += sizeof(SketchEllipse); break;
+            default: usage.entityBytes += sizeof(SketchEntity); break;
+        }
+        usage.entityBytes += memory::stringBytes(entity->id());
+    }
+
+    usage.constraintBytes = memory::vectorBytes(constraints_) + memory::stringMapBytes(constraintIndex_);
+    for (const auto& constraint : constraints_) {
+        // Concrete constraints add a value and a few entity ids to the base
+        usage.constraintBytes += sizeof(SketchConstraint) + memory::stringBytes(constraint->id());
+        for (const auto& entityId : constraint->referencedEntities()) {
+            usage.constraintBytes += sizeof(EntityID) + memory::stringBytes(entityId);
+        }
+    }
+
+    usage.indexBytes = sizeof(SketchSpatialIndex) + spatialIndex_->size() * kIndexBytesPerEntity;
+    if (solver_) {
+        usage.solverBytes = solver_->memoryBytes();
+    }
+    return usage;
+}
+
+void Sketch::trackEntity(SketchEntity& entity) {
+    entity.setGeometryListener(spatialIndex_.get());
+    spatialIndex_->entityAdded(entity.id());
+}
+
 void Sketch::rebuildEntityIndex() {
     entityIndex_.clear();
     for (size_t i = 0; i < entities_.size(); ++i) {
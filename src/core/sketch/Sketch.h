@@ -23,6 +23,7 @@
 #include "SketchCircle.h"
 #include "SketchEllipse.h"
 #include "SketchConstraint.h"
+#include "SketchSpatialIndex.h"
 
 #include <memory>
 #include <vector>
@@ -34,6 +35,14 @@
 // Forward declarations
 namespace GCS { class System; }
 
+namespace onecad::core::loop {
+struct LoopDetectorConfig;
+struct LoopDetectionResult;
+struct RegionDefinition;
+struct LoopCacheStats;
+class LoopResultCache;
+} // namespace onecad::core::loop
+
 namespace onecad::core::sketch {
 
 // Forward declaration
@@ -141,6 +150,18 @@ struct ValidationResult {
     std::vector<EntityID> invalidEntities;
 };
 
+/**
+ * @brief Approximate memory held by a sketch, in bytes
+ */
+struct SketchMemoryUsage {
+    size_t entityBytes = 0;      ///< Entity objects and their id lookup
+    size_t constraintBytes = 0;  ///< Constraint objects and their id lookup
+    size_t indexBytes = 0;       ///< Spatial/intersection index estimate
+    size_t solverBytes = 0;      ///< ConstraintSolver and PlaneGCS estimate
+
+    size_t total() const { return entityBytes + constraintBytes + indexBytes + solverBytes; }
+};
+
 /**
  * @brief Main sketch class
  *
@@ -220,6 +241,23 @@ public:
      */
     bool removeEntity(EntityID id);
 
+    /**
+     * @brief Start a batch of entity edits (e.g. bulk splitting)
+     *
+     * Removed entities are detached immediately, so getEntity() no longer finds
+     * them, but entity storage is compacted only once when the outermost batch
+     * ends. Until then getAllEntities() may still list removed entities.
+     * Batches nest.
+     */
+    void beginEditBatch();
+
+    /**
+     * @brief End a batch started with beginEditBatch()
+     */
+    void endEditBatch();
+
+    bool isInEditBatch() const { return editBatchDepth_ > 0; }
+
     /**
      * @brief Split a line at a point, creating two line segments
      * @param lineId ID of line to split
@@ -531,6 +569,9 @@ public:
 
     /**
      * @brief Find entity nearest to a point within tolerance
+     *
+     * Candidates come from spatialIndex(); only those get the exact distance test.
+     *
      * @param pos Query position in sketch coordinates
      * @param tolerance Maximum distance to consider
      * @param filter Optional type filter
@@ -540,15 +581,72 @@ public:
                          std::optional<EntityType> filter = std::nullopt) const;
 
     /**
-     * @brief Find all entities within a rectangular region
+     * @brief Find all entities whose bounds intersect a rectangular region
+     *
+     * Candidates come from spatialIndex(); results are in sketch order.
      */
     std::vector<EntityID> findInRect(const Vec2d& min, const Vec2d& max) const;
 
+    /**
+     * @brief Incrementally maintained spatial index over entity geometry
+     *
+     * Pending add/move/remove notifications are applied before returning,
+     * so the index always reflects current geometry.
+     */
+    const SketchSpatialIndex& spatialIndex() const;
+
+    /**
+     * @brief Maintained curve-curve intersection points, updated for changed curves only
+     */
+    const SketchIntersectionIndex& intersectionIndex() const;
+
+    /**
+     * @brief Counter bumped whenever any entity is added, removed or moved
+     */
+    uint64_t geometryRevision() const { return spatialIndex_->revision(); }
+
+    /**
+     * @brief Process-unique id of this sketch's geometry, kept across moves
+     *
+     * Caches keyed by geometryRevision() pair it with this id rather than the
+     * sketch address, which a later sketch may reuse.
+     */
+    uint64_t geometryInstanceId() const { return spatialIndex_->instanceId(); }
+
+    /**
+     * @brief Loop detection result for current geometry, memoized per config
+     *
+     * Recomputed only after geometryRevision() changes. The reference is valid
+     * until the next call with the same config.
+     */
+    const loop::LoopDetectionResult& loopDetection(const loop::LoopDetectorConfig& config) const;
+
+    /**
+     * @brief Region definitions for current geometry, memoized per config
+     */
+    const std::vector<loop::RegionDefinition>& regionDefinitions(
+        const loop::LoopDetectorConfig& config) const;
+
+    /**
+     * @brief Hit/miss counters of the loop and region caches
+     */
+    const loop::LoopCacheStats& loopCacheStats() const;
+    void resetLoopCacheStats() const;
+    /**
+     * @brief Log the loop cache counters (category onecad.core.loop.cache)
+     */
+    void logLoopCacheStats(const char* context) const;
+
     // ========== Statistics ==========
 
     size_t getEntityCount() const { return entities_.size(); }
     size_t getConstraintCount() const { return constraints_.size(); }
 
+    /**
+     * @brief Approximate memory of entities, constraints, index and solver
+     */
+    SketchMemoryUsage memoryUsage() const;
+
 private:
     SketchPlane plane_;
     std::optional<HostFaceAttachment> hostFaceAttachment_;
@@ -560,6 +658,16 @@ private:
     std::unordered_map<EntityID, size_t> entityIndex_;
     std::unordered_map<ConstraintID, size_t> constraintIndex_;
 
+    // Open edit batches; removals defer storage compaction while > 0
+    int editBatchDepth_ = 0;
+    bool editBatchHasRemovals_ = false;
+
+    // Owned on the heap so entity listener pointers survive Sketch moves
+    std::unique_ptr<SketchSpatialIndex> spatialIndex_;
+
+    // Memoized loop/region detection, stamped with geometryRevision()
+    std::unique_ptr<loop::LoopResultCache> loopCache_;
+
     // Solver (PlaneGCS wrapper)
     std::unique_ptr<ConstraintSolver> solver_;
     bool solverDirty_ = true;  // Needs rebuild if true
@@ -584,6 +692,11 @@ private:
      */
     void rebuildSolver();
 
+    /**
+     * @brief Hook a newly stored entity into geometry change tracking
+     */
+    void trackEntity(SketchEntity& entity);
+
     /**
      * @brief Update entity index map after removal
      */
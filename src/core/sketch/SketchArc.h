@@ -68,7 +68,10 @@ public:
     /**
      * @brief Set center point reference
      */
-    void setCenterPointId(const PointID& pointId) { m_centerPointId = pointId; }
+    void setCenterPointId(const PointID& pointId) {
+        m_centerPointId = pointId;
+        notifyGeometryChanged();
+    }
 
     /**
      * @brief Get arc radius
@@ -87,7 +90,10 @@ public:
      * @brief Set arc radius
      * @param radius Radius in mm (must be positive)
      */
-    void setRadius(double radius) { m_radius = std::max(0.0, radius); }
+    void setRadius(double radius) {
+        m_radius = std::max(0.0, radius);
+        notifyGeometryChanged();
+    }
 
     /**
      * @brief Get start angle
@@ -107,7 +113,10 @@ public:
      * @brief Set start angle
      * @param angle Angle in radians
      */
-    void setStartAngle(double angle) { m_startAngle = normalizeAngle(angle); }
+    void setStartAngle(double angle) {
+        m_startAngle = normalizeAngle(angle);
+        notifyGeometryChanged();
+    }
 
     /**
      * @brief Get end angle
@@ -127,7 +136,10 @@ public:
      * @brief Set end angle
      * @param angle Angle in radians
      */
-    void setEndAngle(double angle) { m_endAngle = normalizeAngle(angle); }
+    void setEndAngle(double angle) {
+        m_endAngle = normalizeAngle(angle);
+        notifyGeometryChanged();
+    }
 
     //--------------------------------------------------------------------------
     // Derived Geometry
@@ -53,7 +53,10 @@ public:
     /**
      * @brief Set center point reference
      */
-    void setCenterPointId(const PointID& pointId) { m_centerPointId = pointId; }
+    void setCenterPointId(const PointID& pointId) {
+        m_centerPointId = pointId;
+        notifyGeometryChanged();
+    }
 
     /**
      * @brief Get circle radius
@@ -72,7 +75,10 @@ public:
      * @brief Set circle radius
      * @param radius Radius in mm (must be positive)
      */
-    void setRadius(double radius) { m_radius = std::max(0.0, radius); }
+    void setRadius(double radius) {
+        m_radius = std::max(0.0, radius);
+        notifyGeometryChanged();
+    }
 
     //--------------------------------------------------------------------------
     // Derived Geometry
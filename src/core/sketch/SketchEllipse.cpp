@@ -44,11 +44,13 @@ void SketchEllipse::setMajorRadius(double r) {
     if (m_majorRadius < m_minorRadius) {
         m_minorRadius = m_majorRadius;
     }
+    notifyGeometryChanged();
 }
 
 void SketchEllipse::setMinorRadius(double r) {
     // Clamp minor to not exceed current major radius
     m_minorRadius = std::clamp(r, 0.0, m_majorRadius);
+    notifyGeometryChanged();
 }
 
 double SketchEllipse::circumference() const {
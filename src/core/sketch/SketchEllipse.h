@@ -57,7 +57,10 @@ public:
     //--------------------------------------------------------------------------
 
     const PointID& centerPointId() const { return m_centerPointId; }
-    void setCenterPointId(const PointID& pointId) { m_centerPointId = pointId; }
+    void setCenterPointId(const PointID& pointId) {
+        m_centerPointId = pointId;
+        notifyGeometryChanged();
+    }
 
     double majorRadius() const { return m_majorRadius; }
     void setMajorRadius(double r);
@@ -66,7 +69,10 @@ public:
     void setMinorRadius(double r);
 
     double rotation() const { return m_rotation; }
-    void setRotation(double angle) { m_rotation = angle; }
+    void setRotation(double angle) {
+        m_rotation = angle;
+        notifyGeometryChanged();
+    }
 
     //--------------------------------------------------------------------------
     // Derived Geometry
@@ -59,6 +59,24 @@ struct BoundingBox2d {
     }
 };
 
+/**
+ * @brief Receiver for geometry-change notifications from sketch entities
+ *
+ * The owning Sketch installs a listener on every entity it holds so derived
+ * structures (spatial index, caches) can be updated incrementally instead of
+ * rebuilt from all entities.
+ */
+class EntityGeometryListener {
+public:
+    virtual ~EntityGeometryListener() = default;
+
+    /**
+     * @brief Called after the geometry of an entity has changed
+     * @param id Entity whose position, radius or references were modified
+     */
+    virtual void entityGeometryChanged(const EntityID& id) = 0;
+};
+
 /**
  * @brief Abstract base class for all sketch geometry entities
  *
@@ -112,7 +130,14 @@ public:
      * @brief Set construction mode
      * @param value true for construction geometry
      */
-    void setConstruction(bool value) { m_isConstruction = value; }
+    void setConstruction(bool value) {
+        if (m_isConstruction == value) {
+            return;
+        }
+        m_isConstruction = value;
+        // Construction curves are excluded from loops, so this is a geometry change
+        notifyGeometryChanged();
+    }
 
     /**
      * @brief Check whether this entity is a locked host-face reference.
@@ -158,6 +183,12 @@ public:
      */
     virtual int degreesOfFreedom() const = 0;
 
+    /**
+     * @brief Install the listener notified by geometry setters
+     * @param listener Listener owned by the containing sketch, or nullptr
+     */
+    void setGeometryListener(EntityGeometryListener* listener) { m_geometryListener = listener; }
+
     //--------------------------------------------------------------------------
     // Serialization (per SPECIFICATION.md §17.3)
     //--------------------------------------------------------------------------
@@ -194,9 +225,21 @@ protected:
      */
     static EntityID generateId();
 
+    /**
+     * @brief Notify the owning sketch that this entity's geometry changed
+     *
+     * Must be called by every setter that alters position, size or point references.
+     */
+    void notifyGeometryChanged() {
+        if (m_geometryListener) {
+            m_geometryListener->entityGeometryChanged(m_id);
+        }
+    }
+
     EntityID m_id;
     bool m_isConstruction = true;  // Default: construction (per SPECIFICATION.md §6.1)
     bool m_isReferenceLocked = false;
+    EntityGeometryListener* m_geometryListener = nullptr;
 };
 
 } // namespace onecad::core::sketch
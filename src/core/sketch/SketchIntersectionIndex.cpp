@@ -0,0 +1,218 @@
+/**
+ * @file SketchIntersectionIndex.cpp
+ * @brief Implementation of the maintained curve intersection index
+ */
+
+#include "SketchIntersectionIndex.h"
+
+#include "Sketch.h"
+#include "SketchSpatialIndex.h"
+#include "SnapManager.h"
+
+#include <algorithm>
+#include <cmath>
+#include <tuple>
+
+namespace onecad::core::sketch {
+
+namespace {
+
+bool isCurve(const SketchEntity& entity) {
+    const EntityType type = entity.type();
+    return type == EntityType::Line || type == EntityType::Arc ||
+           type == EntityType::Circle || type == EntityType::Ellipse;
+}
+
+} // namespace
+
+SketchIntersectionIndex::SketchIntersectionIndex(double cellSize)
+    : cellSize_(cellSize > 0.0 ? cellSize : constants::SNAP_RADIUS_MM)
+{
+}
+
+void SketchIntersectionIndex::clear() {
+    points_.clear();
+    pointsByEntity_.clear();
+    cells_.clear();
+    dirty_.clear();
+}
+
+void SketchIntersectionIndex::markDirty(const EntityID& id) {
+    dirty_.insert(id);
+}
+
+void SketchIntersectionIndex::markRemoved(const EntityID& id) {
+    removePointsOf(id);
+    dirty_.erase(id);
+}
+
+void SketchIntersectionIndex::flush(const Sketch& sketch, const SketchSpatialIndex& spatialIndex) {
+    if (dirty_.empty()) {
+        return;
+    }
+
+    std::unordered_set<EntityID> dirty;
+    dirty.swap(dirty_);
+    for (const auto& id : dirty) {
+        removePointsOf(id);
+    }
+
+    for (const auto& id : dirty) {
+        const SketchEntity* entity = sketch.getEntity(id);
+        if (!entity || !isCurve(*entity)) {
+            continue;
+        }
+        const BoundingBox2d bounds = SketchSpatialIndex::entityBounds(*entity, sketch);
+        if (bounds.isEmpty()) {
+            continue;
+        }
+
+        const uint64_t entityOrder = spatialIndex.orderOf(id);
+        for (const auto& otherId : spatialIndex.queryRect(bounds)) {
+            if (otherId == id) {
+                continue;
+            }
+            const uint64_t otherOrder = spatialIndex.orderOf(otherId);
+            // Pairs of two dirty curves are computed once, from the earlier one.
+            if (dirty.count(otherId) && otherOrder < entityOrder) {
+                continue;
+            }
+            const SketchEntity* other = sketch.getEntity(otherId);
+            if (!other || !isCurve(*other)) {
+                continue;
+            }
+
+            const bool entityFirst = entityOrder < otherOrder;
+            const SketchEntity* first = entityFirst ? entity : other;
+            const SketchEntity* second = entityFirst ? other : entity;
+            for (const auto& pt : SnapManager::findEntityIntersections(first, second, sketch)) {
+                addPoint(pt, first->id(), second->id());
+            }
+        }
+    }
+}
+
+std::vector<const SketchIntersectionIndex::IntersectionPoint*> SketchIntersectionIndex::query(
+    const Vec2d& center,
+    double radius,
+    const SketchSpatialIndex& spatialIndex) const
+{
+    std::vector<std::pair<uint64_t, const IntersectionPoint*>> hits;
+    const double safeRadius = std::max(0.0, radius);
+    const long long minX = static_cast<long long>(std::floor((center.x - safeRadius) / cellSize_));
+    const long long maxX = static_cast<long long>(std::floor((center.x + safeRadius) / cellSize_));
+    const long long minY = static_cast<long long>(std::floor((center.y - safeRadius) / cellSize_));
+    const long long maxY = static_cast<long long>(std::floor((center.y + safeRadius) / cellSize_));
+
+    for (long long cellX = minX; cellX <= maxX; ++cellX) {
+        for (long long cellY = minY; cellY <= maxY; ++cellY) {
+            auto cellIt = cells_.find(packCell(cellX, cellY));
+            if (cellIt == cells_.end()) {
+                continue;
+            }
+            for (uint64_t handle : cellIt->second) {
+                const IntersectionPoint& point = points_.at(handle);
+                if (std::abs(point.position.x - center.x) <= safeRadius &&
+                    std::abs(point.position.y - center.y) <= safeRadius) {
+                    hits.emplace_back(handle, &point);
+                }
+            }
+        }
+    }
+
+    std::sort(hits.begin(), hits.end(), [&](const auto& a, const auto& b) {
+        return std::make_tuple(spatialIndex.orderOf(a.second->firstEntityId),
+                               spatialIndex.orderOf(a.second->secondEntityId),
+                               a.first) <
+               std::make_tuple(spatialIndex.orderOf(b.second->firstEntityId),
+                               spatialIndex.orderOf(b.second->secondEntityId),
+                               b.first);
+    });
+
+    std::vector<const IntersectionPoint*> result;
+    result.reserve(hits.size());
+    for (const auto& hit : hits) {
+        result.push_back(hit.second);
+    }
+    return result;
+}
+
+std::vector<const SketchIntersectionIndex::IntersectionPoint*> SketchIntersectionIndex::pointsOf(
+    const EntityID& id) const
+{
+    std::vector<const IntersectionPoint*> result;
+    auto it = pointsByEntity_.find(id);
+    if (it == pointsByEntity_.end()) {
+        return result;
+    }
+    result.reserve(it->second.size());
+    for (uint64_t handle : it->second) {
+        auto pointIt = points_.find(handle);
+        if (pointIt != points_.end()) {
+            result.push_back(&pointIt->second);
+        }
+    }
+    return result;
+}
+
+void SketchIntersectionIndex::removePointsOf(const EntityID& id) {
+    auto it = pointsByEntity_.find(id);
+    if (it == pointsByEntity_.end()) {
+        return;
+    }
+    const std::vector<uint64_t> handles = std::move(it->second);
+    pointsByEntity_.erase(it);
+
+    for (uint64_t handle : handles) {
+        auto pointIt = points_.find(handle);
+        if (pointIt == points_.end()) {
+            continue;
+        }
+
+        const IntersectionPoint& point = pointIt->second;
+        const EntityID& otherId = point.firstEntityId == id ? point.secondEntityId : point.firstEntityId;
+        auto otherIt = pointsByEntity_.find(otherId);
+        if (otherIt != pointsByEntity_.end()) {
+            auto& otherHandles = otherIt->second;
+            otherHandles.erase(std::remove(otherHandles.begin(), otherHandles.end(), handle),
+                               otherHandles.end());
+            if (otherHandles.empty()) {
+                pointsByEntity_.erase(otherIt);
+            }
+        }
+
+        auto cellIt = cells_.find(cellKey(point.position));
+        if (cellIt != cells_.end()) {
+            auto& cellHandles = cellIt->second;
+            cellHandles.erase(std::remove(cellHandles.begin(), cellHandles.end(), handle),
+                              cellHandles.end());
+            if (cellHandles.empty()) {
+                cells_.erase(cellIt);
+            }
+        }
+
+        points_.erase(pointIt);
+    }
+}
+
+void SketchIntersectionIndex::addPoint(const Vec2d& position,
+                                       const EntityID& first,
+                                       const EntityID& second)
+{
+    const uint64_t handle = nextHandle_++;
+    points_.emplace(handle, IntersectionPoint{position, first, second});
+    pointsByEntity_[first].push_back(handle);
+    pointsByEntity_[second].push_back(handle);
+    cells_[cellKey(position)].push_back(handle);
+}
+
+long long SketchIntersectionIndex::cellKey(const Vec2d& position) const {
+    return packCell(static_cast<long long>(std::floor(position.x / cellSize_)),
+                    static_cast<long long>(std::floor(position.y / cellSize_)));
+}
+
+long long SketchIntersectionIndex::packCell(long long cellX, long long cellY) {
+    return (cellX << 32) ^ (cellY & 0xffffffffLL);
+}
+
+} // namespace onecad::core::sketch
@@ -0,0 +1,96 @@
+/**
+ * @file SketchIntersectionIndex.h
+ * @brief Maintained set of curve-curve intersection points for snapping
+ *
+ * Intersections are recomputed only for curves whose geometry changed since
+ * the last flush. Candidate pairs come from the sketch spatial index (R-tree
+ * broad-phase), so an edit costs time proportional to the curves overlapping
+ * the edited one rather than to the whole sketch.
+ */
+#ifndef ONECAD_CORE_SKETCH_INTERSECTION_INDEX_H
+#define ONECAD_CORE_SKETCH_INTERSECTION_INDEX_H
+
+#include "SketchTypes.h"
+
+#include <cstdint>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace onecad::core::sketch {
+
+class Sketch;
+class SketchSpatialIndex;
+
+/**
+ * @brief Point index over all pairwise curve intersections in a sketch
+ */
+class SketchIntersectionIndex {
+public:
+    /**
+     * @brief Intersection between two curves
+     *
+     * firstEntityId precedes secondEntityId in sketch insertion order, matching
+     * the pair order used by brute-force intersection snapping.
+     */
+    struct IntersectionPoint {
+        Vec2d position;
+        EntityID firstEntityId;
+        EntityID secondEntityId;
+    };
+
+    explicit SketchIntersectionIndex(double cellSize = constants::SNAP_RADIUS_MM);
+
+    void clear();
+
+    /**
+     * @brief Queue an entity whose intersections must be recomputed
+     */
+    void markDirty(const EntityID& id);
+
+    /**
+     * @brief Drop all intersections involving an entity immediately
+     */
+    void markRemoved(const EntityID& id);
+
+    /**
+     * @brief Recompute intersections for queued entities
+     * @param spatialIndex Flushed spatial index of the same sketch (broad-phase)
+     */
+    void flush(const Sketch& sketch, const SketchSpatialIndex& spatialIndex);
+
+    bool hasPendingChanges() const { return !dirty_.empty(); }
+
+    /**
+     * @brief Intersections within a square of half-size radius around center
+     *
+     * Results are ordered by the sketch order of the intersecting pair.
+     */
+    std::vector<const IntersectionPoint*> query(const Vec2d& center,
+                                                double radius,
+                                                const SketchSpatialIndex& spatialIndex) const;
+
+    /**
+     * @brief All intersections involving an entity, in insertion order
+     */
+    std::vector<const IntersectionPoint*> pointsOf(const EntityID& id) const;
+
+    size_t size() const { return points_.size(); }
+
+private:
+    double cellSize_;
+    uint64_t nextHandle_ = 0;
+    std::unordered_map<uint64_t, IntersectionPoint> points_;
+    std::unordered_map<EntityID, std::vector<uint64_t>> pointsByEntity_;
+    std::unordered_map<long long, std::vector<uint64_t>> cells_;
+    std::unordered_set<EntityID> dirty_;
+
+    void removePointsOf(const EntityID& id);
+    void addPoint(const Vec2d& position, const EntityID& first, const EntityID& second);
+    long long cellKey(const Vec2d& position) const;
+    static long long packCell(long long cellX, long long cellY);
+};
+
+} // namespace onecad::core::sketch
+
+#endif // ONECAD_CORE_SKETCH_INTERSECTION_INDEX_H
@@ -66,13 +66,19 @@ public:
      * @brief Set start point reference
      * @param pointId ID of start point
      */
-    void setStartPointId(const PointID& pointId) { m_startPointId = pointId; }
+    void setStartPointId(const PointID& pointId) {
+        m_startPointId = pointId;
+        notifyGeometryChanged();
+    }
 
     /**
      * @brief Set end point reference
      * @param pointId ID of end point
      */
-    void setEndPointId(const PointID& pointId) { m_endPointId = pointId; }
+    void setEndPointId(const PointID& pointId) {
+        m_endPointId = pointId;
+        notifyGeometryChanged();
+    }
 
     //--------------------------------------------------------------------------
     // Geometry Queries (require Sketch context for point lookup)
@@ -73,14 +73,20 @@ public:
      * @brief Set point position
      * @param position New position in sketch coordinates (mm)
      */
-    void setPosition(const gp_Pnt2d& position) { m_position = position; }
+    void setPosition(const gp_Pnt2d& position) {
+        m_position = position;
+        notifyGeometryChanged();
+    }
 
     /**
      * @brief Set position by coordinates
      * @param x X coordinate (mm)
      * @param y Y coordinate (mm)
      */
-    void setPosition(double x, double y) { m_position.SetCoord(x, y); }
+    void setPosition(double x, double y) {
+        m_position.SetCoord(x, y);
+        notifyGeometryChanged();
+    }
 
     /**
      * @brief Get X coordinate
@@ -1444,6 +1444,7 @@ void SketchRenderer::updateGeometry() {
     if (!sketch_) return;
 
     entityRenderData_.clear();
+    entityRenderIndex_.clear();
 
     // Process all entities
     for (const auto& entityPtr : sketch_->getAllEntities()) {
@@ -1527,6 +1528,7 @@ void SketchRenderer::updateGeometry() {
                 data.bounds[1].x = std::max(data.bounds[1].x, v.x);
                 data.bounds[1].y = std::max(data.bounds[1].y, v.y);
             }
+            entityRenderIndex_[data.id] = entityRenderData_.size();
             entityRenderData_.push_back(std::move(data));
         }
     }
@@ -1582,21 +1584,7 @@ void SketchRenderer::updateRegions() {
         return;
     }
 
-    loop::LoopDetector detector;
-    loop::LoopDetectorConfig config;
-    config.findAllLoops = false;
-    config.computeAreas = true;
-    config.resolveHoles = true;
-    config.validate = true;
-    config.planarizeIntersections = true;
-    detector.setConfig(config);
-
-    auto result = detector.detect(*sketch_);
-    if (!result.success) {
-        return;
-    }
-
-    auto regions = loop::buildRegionDefinitions(result, constants::COINCIDENCE_TOLERANCE);
+    const auto& regions = sketch_->regionDefinitions(loop::makeRegionDetectionConfig());
     if (regions.empty()) {
         return;
     }
@@ -1957,64 +1945,91 @@ EntityID SketchRenderer::pickEntity(const Vec2d& screenPos, double tolerance) co
     return hits.front().id;
 }
 
+std::optional<double> SketchRenderer::pickDistance(const EntityRenderData& data,
+                                                  const Vec2d& screenPos,
+                                                  double tolerance) const {
+    if (!isEntityVisible(data)) return std::nullopt;
+
+    double minDist = tolerance;
+
+    if (data.type == EntityType::Point) {
+        if (data.vertices.empty()) {
+            return std::nullopt;
+        }
+        double dx = screenPos.x - data.vertices[0].x;
+        double dy = screenPos.y - data.vertices[0].y;
+        double dist = std::sqrt(dx * dx + dy * dy);
+        if (dist > minDist) {
+            return std::nullopt;
+        }
+        return dist;
+    }
+
+    bool hit = false;
+    for (size_t i = 0; i + 1 < data.vertices.size(); ++i) {
+        const auto& p1 = data.vertices[i];
+        const auto& p2 = data.vertices[i + 1];
+
+        // Distance from point to line segment
+        double dx = p2.x - p1.x;
+        double dy = p2.y - p1.y;
+        double lenSq = dx * dx + dy * dy;
+        if (lenSq < 1e-10) continue;
+
+        double t = std::clamp(
+            ((screenPos.x - p1.x) * dx + (screenPos.y - p1.y) * dy) / lenSq,
+            0.0, 1.0);
+
+        double projX = p1.x + t * dx;
+        double projY = p1.y + t * dy;
+        double dist = std::sqrt((screenPos.x - projX) * (screenPos.x - projX) +
+                                 (screenPos.y - projY) * (screenPos.y - projY));
+
+        if (dist <= minDist) {
+            minDist = dist;
+            hit = true;
+        }
+    }
+    if (!hit) {
+        return std::nullopt;
+    }
+    return minDist;
+}
+
 std::vector<EntityPickHit> SketchRenderer::pickEntities(const Vec2d& screenPos, double tolerance) const {
     // Note: screenPos must be in world/sketch coordinates, not pixel screen coordinates.
     // Caller should transform screen pixels to sketch space before calling.
     std::vector<EntityPickHit> hits;
 
     for (const auto& data : entityRenderData_) {
-        if (!isEntityVisible(data)) continue;
-
-        double minDist = tolerance;
-
-        if (data.type == EntityType::Point) {
-            if (!data.vertices.empty()) {
-                double dx = screenPos.x - data.vertices[0].x;
-                double dy = screenPos.y - data.vertices[0].y;
-                double dist = std::sqrt(dx * dx + dy * dy);
-                if (dist <= minDist) {
-                    minDist = dist;
-                } else {
-                    continue;
-                }
-            } else {
-                continue;
-            }
-        } else {
-            bool hit = false;
-            for (size_t i = 0; i + 1 < data.vertices.size(); ++i) {
-                const auto& p1 = data.vertices[i];
-                const auto& p2 = data.vertices[i + 1];
-
-                // Distance from point to line segment
-                double dx = p2.x - p1.x;
-                double dy = p2.y - p1.y;
-                double lenSq = dx * dx + dy * dy;
-                if (lenSq < 1e-10) continue;
-
-                double t = std::clamp(
-                    ((screenPos.x - p1.x) * dx + (screenPos.y - p1.y) * dy) / lenSq,
-                    0.0, 1.0);
-
-                double projX = p1.x + t * dx;
-                double projY = p1.y + t * dy;
-                double dist = std::sqrt((screenPos.x - projX) * (screenPos.x - projX) +
-                                         (screenPos.y - projY) * (screenPos.y - projY));
-
-                if (dist <= minDist) {
-                    minDist = dist;
-                    hit = true;
-                }
-            }
-            if (!hit) {
-                continue;
-            }
+        auto dist = pickDistance(data, screenPos, tolerance);
+        if (dist) {
+            hits.push_back(EntityPickHit{data.id, data.type, data.isConstruction, *dist});
         }
+    }
+
+    std::stable_sort(hits.begin(), hits.end(), [](const EntityPickHit& a, const EntityPickHit& b) {
+        return a.distance < b.distance;
+    });
 
-        hits.push_back(EntityPickHit{data.id, data.type, data.isConstruction, minDist});
+    return hits;
+}
+
+std::vector<EntityPickHit> SketchRenderer::pickEntities(const Vec2d& screenPos, double tolerance,
+                                                        const std::vector<EntityID>& candidates) const {
+    std::vector<EntityPickHit> hits;
+
+    for (const auto& id : candidates) {
+        auto it = entityRenderIndex_.find(id);
+        if (it == entityRenderIndex_.end()) continue;
+        const auto& data = entityRenderData_[it->second];
+        auto dist = pickDistance(data, screenPos, tolerance);
+        if (dist) {
+            hits.push_back(EntityPickHit{data.id, data.type, data.isConstruction, *dist});
+        }
     }
 
-    std::sort(hits.begin(), hits.end(), [](const EntityPickHit& a, const EntityPickHit& b) {
+    std::stable_sort(hits.begin(), hits.end(), [](const EntityPickHit& a, const EntityPickHit& b) {
         return a.distance < b.distance;
     });
 
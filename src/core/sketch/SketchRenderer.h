@@ -483,6 +483,15 @@ public:
      * @return Vector of hits within tolerance, sorted by distance (nearest first)
      */
     std::vector<EntityPickHit> pickEntities(const Vec2d& screenPos, double tolerance = 5.0) const;
+    /**
+     * @brief Find entities at position, testing only the given candidates
+     *
+     * Candidates normally come from Sketch::spatialIndex().queryRadius() so
+     * the exact polyline distance test only runs on nearby entities.
+     * @return Vector of hits within tolerance, sorted by distance (nearest first)
+     */
+    std::vector<EntityPickHit> pickEntities(const Vec2d& screenPos, double tolerance,
+                                            const std::vector<EntityID>& candidates) const;
 
     /**
      * @brief Find constraint at screen position
@@ -545,6 +554,7 @@ private:
 
     // Cached render data
     std::vector<EntityRenderData> entityRenderData_;
+    std::unordered_map<EntityID, size_t> entityRenderIndex_;  // id -> entityRenderData_ slot
     std::vector<ConstraintRenderData> constraintRenderData_;
     std::vector<InferredConstraint> ghostConstraints_;
     bool geometryDirty_ = true;
@@ -580,6 +590,12 @@ private:
      */
     bool isEntityVisible(const EntityRenderData& data) const;
 
+    /**
+     * @brief Distance from pos to the entity's rendered geometry, if within tolerance
+     */
+    std::optional<double> pickDistance(const EntityRenderData& data, const Vec2d& pos,
+                                       double tolerance) const;
+
     /**
      * @brief Calculate constraint icon position
      *
@@ -0,0 +1,373 @@
+/**
+ * @file SketchSpatialIndex.cpp
+ * @brief Implementation of the incrementally maintained sketch spatial index
+ */
+
+#include "SketchSpatialIndex.h"
+
+#include "Sketch.h"
+#include "SketchArc.h"
+#include "SketchCircle.h"
+#include "SketchEllipse.h"
+#include "SketchLine.h"
+#include "SketchPoint.h"
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+
+namespace onecad::core::sketch {
+
+namespace {
+
+// Lines contribute at most three anchors (start, end, midpoint).
+constexpr uint64_t kAnchorsPerEntity = 4;
+
+// Extension guides are offered for t in [-2, 4] along the line (see SnapManager::findGuideSnaps).
+constexpr double kGuideMinT = -2.0;
+constexpr double kGuideMaxT = 4.0;
+
+// Starts at 1 so 0 can mean "no sketch" in caches keyed by instanceId()
+std::atomic<uint64_t> nextInstanceId{1};
+
+void expandToInclude(BoundingBox2d& box, double x, double y) {
+    box.minX = std::min(box.minX, x);
+    box.minY = std::min(box.minY, y);
+    box.maxX = std::max(box.maxX, x);
+    box.maxY = std::max(box.maxY, y);
+}
+
+BoundingBox2d squareAround(const Vec2d& center, double radius) {
+    const double safeRadius = std::max(0.0, radius);
+    BoundingBox2d box;
+    box.minX = center.x - safeRadius;
+    box.minY = center.y - safeRadius;
+    box.maxX = center.x + safeRadius;
+    box.maxY = center.y + safeRadius;
+    return box;
+}
+
+std::vector<const SketchSpatialIndex::AlignmentAnchor*> collectBand(
+    const std::multimap<double, SketchSpatialIndex::AlignmentAnchor>& anchors,
+    double value,
+    double tolerance)
+{
+    std::vector<const SketchSpatialIndex::AlignmentAnchor*> result;
+    const auto begin = anchors.lower_bound(value - tolerance);
+    const auto end = anchors.upper_bound(value + tolerance);
+    for (auto it = begin; it != end; ++it) {
+        result.push_back(&it->second);
+    }
+    return result;
+}
+
+} // namespace
+
+SketchSpatialIndex::SketchSpatialIndex()
+    : intersections_(constants::SNAP_RADIUS_MM)
+    , instanceId_(nextInstanceId.fetch_add(1, std::memory_order_relaxed))
+{
+}
+
+void SketchSpatialIndex::entityAdded(const EntityID& id) {
+    if (order_.find(id) == order_.end()) {
+        order_[id] = nextOrder_++;
+    }
+    pending_.insert(id);
+    ++revision_;
+}
+
+void SketchSpatialIndex::entityRemoved(const EntityID& id) {
+    removeFromStructures(id);
+    intersections_.markRemoved(id);
+    order_.erase(id);
+    pending_.erase(id);
+    ++revision_;
+}
+
+void SketchSpatialIndex::entityGeometryChanged(const EntityID& id) {
+    pending_.insert(id);
+    ++revision_;
+}
+
+void SketchSpatialIndex::flush(const Sketch& sketch) {
+    if (pending_.empty()) {
+        return;
+    }
+
+    // A moved point changes the bounds of every curve that references it.
+    std::unordered_set<EntityID> refresh = pending_;
+    for (const auto& id : pending_) {
+        const auto* point = sketch.getEntityAs<SketchPoint>(id);
+        if (!point) {
+            continue;
+        }
+        refresh.insert(point->connectedEntities().begin(), point->connectedEntities().end());
+    }
+    pending_.clear();
+
+    for (const auto& id : refresh) {
+        intersections_.markDirty(id);
+        const SketchEntity* entity = sketch.getEntity(id);
+        if (!entity) {
+            removeFromStructures(id);
+            order_.erase(id);
+            continue;
+        }
+        removeAnchors(id);
+        if (order_.find(id) == order_.end()) {
+            order_[id] = nextOrder_++;
+        }
+        indexEntity(*entity, sketch);
+        entityRevisions_[id] = revision_;
+    }
+}
+
+void SketchSpatialIndex::rebuild(const Sketch& sketch) {
+    boundsTree_.clear();
+    guideTree_.clear();
+    anchorsByX_.clear();
+    anchorsByY_.clear();
+    anchors_.clear();
+    intersections_.clear();
+    order_.clear();
+    pending_.clear();
+    entityRevisions_.clear();
+    nextOrder_ = 0;
+    ++revision_;
+
+    for (const auto& entity : sketch.getAllEntities()) {
+        if (!entity) {
+            continue;
+        }
+        order_[entity->id()] = nextOrder_++;
+        indexEntity(*entity, sketch);
+        entityRevisions_[entity->id()] = revision_;
+        intersections_.markDirty(entity->id());
+    }
+}
+
+uint64_t SketchSpatialIndex::entityRevision(const EntityID& id) const {
+    auto it = entityRevisions_.find(id);
+    return it != entityRevisions_.end() ? it->second : 0;
+}
+
+void SketchSpatialIndex::flushIntersections(const Sketch& sketch) {
+    intersections_.flush(sketch, *this);
+}
+
+std::vector<EntityID> SketchSpatialIndex::queryRect(const BoundingBox2d& box) const {
+    return sortedByOrder(boundsTree_.query(box));
+}
+
+std::vector<EntityID> SketchSpatialIndex::queryRadius(const Vec2d& center, double radius) const {
+    return queryRect(squareAround(center, radius));
+}
+
+std::vector<EntityID> SketchSpatialIndex::queryGuides(const Vec2d& center, double radius) const {
+    return sortedByOrder(guideTree_.query(squareAround(center, radius)));
+}
+
+std::vector<std::pair<EntityID, double>> SketchSpatialIndex::nearest(
+    const Vec2d& point,
+    size_t k,
+    double maxDistance,
+    const SpatialRTree::DistanceFn& exactDistance) const
+{
+    return boundsTree_.nearest(point, k, maxDistance, exactDistance);
+}
+
+std::vector<const SketchSpatialIndex::AlignmentAnchor*> SketchSpatialIndex::anchorsNearY(
+    double y, double tolerance) const
+{
+    return collectBand(anchorsByY_, y, tolerance);
+}
+
+std::vector<const SketchSpatialIndex::AlignmentAnchor*> SketchSpatialIndex::anchorsNearX(
+    double x, double tolerance) const
+{
+    return collectBand(anchorsByX_, x, tolerance);
+}
+
+uint64_t SketchSpatialIndex::orderOf(const EntityID& id) const {
+    auto it = order_.find(id);
+    return it != order_.end() ? it->second : std::numeric_limits<uint64_t>::max();
+}
+
+BoundingBox2d SketchSpatialIndex::entityBounds(const SketchEntity& entity, const Sketch& sketch) {
+    BoundingBox2d bounds;
+    switch (entity.type()) {
+        case EntityType::Point: {
+            bounds = static_cast<const SketchPoint&>(entity).bounds();
+            break;
+        }
+        case EntityType::Line: {
+            const auto& line = static_cast<const SketchLine&>(entity);
+            const auto* start = sketch.getEntityAs<SketchPoint>(line.startPointId());
+            const auto* end = sketch.getEntityAs<SketchPoint>(line.endPointId());
+            if (start && end) {
+                bounds = SketchLine::boundsWithPoints(start->position(), end->position());
+            }
+            break;
+        }
+        case EntityType::Arc: {
+            const auto& arc = static_cast<const SketchArc&>(entity);
+            if (const auto* center = sketch.getEntityAs<SketchPoint>(arc.centerPointId())) {
+                bounds = arc.boundsWithCenter(center->position());
+                expandToInclude(bounds, center->x(), center->y());
+            }
+            break;
+        }
+        case EntityType::Circle: {
+            const auto& circle = static_cast<const SketchCircle&>(entity);
+            if (const auto* center = sketch.getEntityAs<SketchPoint>(circle.centerPointId())) {
+                bounds = circle.boundsWithCenter(center->position());
+                expandToInclude(bounds, center->x(), center->y());
+            }
+            break;
+        }
+        case EntityType::Ellipse: {
+            const auto& ellipse = static_cast<const SketchEllipse&>(entity);
+            if (const auto* center = sketch.getEntityAs<SketchPoint>(ellipse.centerPointId())) {
+                bounds = ellipse.boundsWithCenter(center->position());
+                expandToInclude(bounds, center->x(), center->y());
+            }
+            break;
+        }
+        default:
+            break;
+    }
+    return bounds;
+}
+
+void SketchSpatialIndex::collectAlignmentAnchors(const SketchEntity& entity,
+                                                 const Sketch& sketch,
+                                                 std::vector<AlignmentAnchor>& out)
+{
+    auto push = [&](double x, double y, const EntityID& pointId) {
+        out.push_back({
+            .position = {x, y},
+            .entityId = entity.id(),
+            .pointId = pointId,
+            .order = 0
+        });
+    };
+
+    switch (entity.type()) {
+        case EntityType::Point: {
+            const auto& point = static_cast<const SketchPoint&>(entity);
+            push(point.x(), point.y(), entity.id());
+            break;
+        }
+        case EntityType::Line: {
+            const auto& line = static_cast<const SketchLine&>(entity);
+            const auto* start = sketch.getEntityAs<SketchPoint>(line.startPointId());
+            const auto* end = sketch.getEntityAs<SketchPoint>(line.endPointId());
+            if (!start || !end) {
+                break;
+            }
+            push(start->x(), start->y(), line.startPointId());
+            push(end->x(), end->y(), line.endPointId());
+            push((start->x() + end->x()) * 0.5, (start->y() + end->y()) * 0.5, EntityID{});
+            break;
+        }
+        case EntityType::Arc: {
+            const auto& arc = static_cast<const SketchArc&>(entity);
+            if (const auto* center = sketch.getEntityAs<SketchPoint>(arc.centerPointId())) {
+                push(center->x(), center->y(), arc.centerPointId());
+            }
+            break;
+        }
+        case EntityType::Circle: {
+            const auto& circle = static_cast<const SketchCircle&>(entity);
+            if (const auto* center = sketch.getEntityAs<SketchPoint>(circle.centerPointId())) {
+                push(center->x(), center->y(), circle.centerPointId());
+            }
+            break;
+        }
+        case EntityType::Ellipse: {
+            const auto& ellipse = static_cast<const SketchEllipse&>(entity);
+            if (const auto* center = sketch.getEntityAs<SketchPoint>(ellipse.centerPointId())) {
+                push(center->x(), center->y(), ellipse.centerPointId());
+            }
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+void SketchSpatialIndex::removeFromStructures(const EntityID& id) {
+    entityRevisions_.erase(id);
+    boundsTree_.remove(id);
+    guideTree_.remove(id);
+    removeAnchors(id);
+}
+
+void SketchSpatialIndex::removeAnchors(const EntityID& id) {
+    auto it = anchors_.find(id);
+    if (it == anchors_.end()) {
+        return;
+    }
+    for (auto anchorIt : it->second.byX) {
+        anchorsByX_.erase(anchorIt);
+    }
+    for (auto anchorIt : it->second.byY) {
+        anchorsByY_.erase(anchorIt);
+    }
+    anchors_.erase(it);
+}
+
+void SketchSpatialIndex::indexEntity(const SketchEntity& entity, const Sketch& sketch) {
+    const EntityID& id = entity.id();
+    const uint64_t entityOrder = order_[id];
+
+    boundsTree_.update(id, entityBounds(entity, sketch));
+
+    std::vector<AlignmentAnchor> anchors;
+    collectAlignmentAnchors(entity, sketch, anchors);
+    if (!anchors.empty()) {
+        EntityAnchors& stored = anchors_[id];
+        for (size_t i = 0; i < anchors.size(); ++i) {
+            AlignmentAnchor anchor = std::move(anchors[i]);
+            anchor.order = entityOrder * kAnchorsPerEntity + static_cast<uint64_t>(i);
+            stored.byX.push_back(anchorsByX_.emplace(anchor.position.x, anchor));
+            stored.byY.push_back(anchorsByY_.emplace(anchor.position.y, std::move(anchor)));
+        }
+    }
+
+    BoundingBox2d guide;
+    if (entity.type() == EntityType::Line) {
+        const auto& line = static_cast<const SketchLine&>(entity);
+        const auto* start = sketch.getEntityAs<SketchPoint>(line.startPointId());
+        const auto* end = sketch.getEntityAs<SketchPoint>(line.endPointId());
+        if (start && end) {
+            const double dx = end->x() - start->x();
+            const double dy = end->y() - start->y();
+            if (dx * dx + dy * dy >= 1e-12) {
+                expandToInclude(guide, start->x() + kGuideMinT * dx, start->y() + kGuideMinT * dy);
+                expandToInclude(guide, start->x() + kGuideMaxT * dx, start->y() + kGuideMaxT * dy);
+            }
+        }
+    }
+    guideTree_.update(id, guide);
+}
+
+std::vector<EntityID> SketchSpatialIndex::sortedByOrder(std::vector<EntityID> ids) const {
+    // Look each order up once; hashing ids inside the comparator dominates large queries
+    std::vector<std::pair<uint64_t, EntityID>> keyed;
+    keyed.reserve(ids.size());
+    for (auto& id : ids) {
+        const uint64_t order = orderOf(id);
+        keyed.emplace_back(order, std::move(id));
+    }
+    std::sort(keyed.begin(), keyed.end(), [](const auto& a, const auto& b) {
+        return a.first < b.first;
+    });
+    for (size_t i = 0; i < keyed.size(); ++i) {
+        ids[i] = std::move(keyed[i].second);
+    }
+    return ids;
+}
+
+} // namespace onecad::core::sketch
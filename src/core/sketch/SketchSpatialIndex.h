@@ -0,0 +1,196 @@
+/**
+ * @file SketchSpatialIndex.h
+ * @brief Persistent, incrementally maintained spatial index over sketch entities
+ *
+ * The index is owned by Sketch and kept up to date through add/remove/change
+ * notifications instead of being rebuilt per query. Changes are queued and
+ * applied lazily on the next flush, so dragging a point only re-indexes that
+ * point and the entities connected to it.
+ */
+#ifndef ONECAD_CORE_SKETCH_SPATIAL_INDEX_H
+#define ONECAD_CORE_SKETCH_SPATIAL_INDEX_H
+
+#include "SketchEntity.h"
+#include "SketchIntersectionIndex.h"
+#include "SketchTypes.h"
+#include "SpatialRTree.h"
+
+#include <cstdint>
+#include <map>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace onecad::core::sketch {
+
+class Sketch;
+
+/**
+ * @brief Spatial index over entity bounds, alignment anchors and line guides
+ *
+ * Three structures are maintained per entity:
+ * - Entity bounds in a dynamic R-tree (arcs/circles/ellipses include their center point)
+ * - Alignment anchors (points, line endpoints/midpoints, curve centers) sorted by X and Y
+ * - Line extension guide boxes (t in [-2, 4]) in a second R-tree
+ *
+ * Curve-curve intersection points are kept in a SketchIntersectionIndex fed
+ * from the same change queue; they are only recomputed on demand.
+ *
+ * Query results are returned in sketch insertion order so callers stay
+ * deterministic regardless of hash layout.
+ */
+class SketchSpatialIndex : public EntityGeometryListener {
+public:
+    /**
+     * @brief Point that horizontal/vertical inference can align to
+     */
+    struct AlignmentAnchor {
+        Vec2d position;
+        EntityID entityId;
+        EntityID pointId;      ///< Empty for derived anchors (line midpoint)
+        uint64_t order = 0;    ///< Entity insertion order, then anchor order within entity
+    };
+
+    SketchSpatialIndex();
+
+    // ========== Change Notifications ==========
+
+    void entityAdded(const EntityID& id);
+    void entityRemoved(const EntityID& id);
+    void entityGeometryChanged(const EntityID& id) override;
+
+    /**
+     * @brief Apply queued changes using current sketch geometry
+     *
+     * Cost is proportional to the number of changed entities (plus entities
+     * connected to changed points), not to sketch size.
+     */
+    void flush(const Sketch& sketch);
+
+    /**
+     * @brief Discard all state and re-index every entity in sketch order
+     */
+    void rebuild(const Sketch& sketch);
+
+    /**
+     * @brief Recompute intersection points for curves changed since the last call
+     *
+     * Requires flush() to have been called first.
+     */
+    void flushIntersections(const Sketch& sketch);
+
+    const SketchIntersectionIndex& intersections() const { return intersections_; }
+
+    bool hasPendingChanges() const { return !pending_.empty(); }
+
+    /**
+     * @brief Monotonic counter bumped on every add/remove/geometry change
+     */
+    uint64_t revision() const { return revision_; }
+
+    /**
+     * @brief revision() at which the entity was last re-indexed (0 if not indexed)
+     *
+     * Bumped when the entity itself changes and when a point it references
+     * moves, so callers can cache per-entity derived geometry. Call flush first.
+     */
+    uint64_t entityRevision(const EntityID& id) const;
+
+    /**
+     * @brief Process-unique id of this index, never reused (unlike its address)
+     */
+    uint64_t instanceId() const { return instanceId_; }
+
+    size_t size() const { return order_.size(); }
+
+    // ========== Queries (call flush first) ==========
+
+    /**
+     * @brief Entities whose bounds intersect the box, in insertion order
+     */
+    std::vector<EntityID> queryRect(const BoundingBox2d& box) const;
+
+    /**
+     * @brief Entities whose bounds intersect the square around center, in insertion order
+     */
+    std::vector<EntityID> queryRadius(const Vec2d& center, double radius) const;
+
+    /**
+     * @brief Lines whose extension guide range intersects the square around center
+     */
+    std::vector<EntityID> queryGuides(const Vec2d& center, double radius) const;
+
+    /**
+     * @brief Up to k entities nearest to a point, ascending by distance
+     * @param exactDistance Optional per-entity distance refinement (defaults to box distance)
+     */
+    std::vector<std::pair<EntityID, double>> nearest(
+        const Vec2d& point,
+        size_t k,
+        double maxDistance,
+        const SpatialRTree::DistanceFn& exactDistance = {}) const;
+
+    /**
+     * @brief Stored bounds of an entity (empty if not indexed)
+     */
+    BoundingBox2d boundsOf(const EntityID& id) const { return boundsTree_.bounds(id); }
+
+    /**
+     * @brief Anchors with |anchor.y - y| < tolerance
+     */
+    std::vector<const AlignmentAnchor*> anchorsNearY(double y, double tolerance) const;
+
+    /**
+     * @brief Anchors with |anchor.x - x| < tolerance
+     */
+    std::vector<const AlignmentAnchor*> anchorsNearX(double x, double tolerance) const;
+
+    /**
+     * @brief Insertion order of an entity (max() if not indexed)
+     */
+    uint64_t orderOf(const EntityID& id) const;
+
+    // ========== Shared Geometry Helpers ==========
+
+    /**
+     * @brief Bounds used for indexing; empty if referenced points are missing
+     */
+    static BoundingBox2d entityBounds(const SketchEntity& entity, const Sketch& sketch);
+
+    /**
+     * @brief Append alignment anchors of an entity (order field is anchor index only)
+     */
+    static void collectAlignmentAnchors(const SketchEntity& entity,
+                                        const Sketch& sketch,
+                                        std::vector<AlignmentAnchor>& out);
+
+private:
+    using AnchorMap = std::multimap<double, AlignmentAnchor>;
+
+    struct EntityAnchors {
+        std::vector<AnchorMap::iterator> byX;
+        std::vector<AnchorMap::iterator> byY;
+    };
+
+    SpatialRTree boundsTree_;
+    SpatialRTree guideTree_;
+    SketchIntersectionIndex intersections_;
+    AnchorMap anchorsByX_;
+    AnchorMap anchorsByY_;
+    std::unordered_map<EntityID, EntityAnchors> anchors_;
+    std::unordered_map<EntityID, uint64_t> order_;
+    std::unordered_map<EntityID, uint64_t> entityRevisions_;
+    std::unordered_set<EntityID> pending_;
+    uint64_t nextOrder_ = 0;
+    uint64_t revision_ = 0;
+    uint64_t instanceId_ = 0;
+
+    void removeFromStructures(const EntityID& id);
+    void removeAnchors(const EntityID& id);
+    void indexEntity(const SketchEntity& entity, const Sketch& sketch);
+    std::vector<EntityID> sortedByOrder(std::vector<EntityID> ids) const;
+};
+
+} // namespace onecad::core::sketch
+
+#endif // ONECAD_CORE_SKETCH_SPATIAL_INDEX_H
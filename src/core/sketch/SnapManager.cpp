@@ -104,10 +104,6 @@ SnapResult SnapManager::findBestSnap(
         return SnapResult{};
     }
 
-    if (spatialHashEnabled_) {
-        rebuildSpatialHash(sketch);
-    }
-
     auto snaps = findAllSnaps(cursorPos, sketch, excludeEntities, referencePoint);
     if (snaps.empty()) {
         qCDebug(logSnapManager) << "findBestSnap:no-candidates";
@@ -151,20 +147,11 @@ SnapResult SnapManager::findBestSnap(
                std::abs(snap.position.y - best.position.y) <= SnapResult::kOverlapEps;
     };
 
-    std::unordered_map<EntityID, size_t> pointOrder;
-    pointOrder.reserve(sketch.getEntityCount());
-    size_t pointIndex = 0;
-    for (const auto& entity : sketch.getAllEntities()) {
-        if (entity->type() != EntityType::Point) {
-            continue;
-        }
-        pointOrder.emplace(entity->id(), pointIndex++);
-    }
-
+    // Tie-break co-located vertices by sketch insertion order (maintained by the index).
+    const SketchSpatialIndex& index = sketch.spatialIndex();
     auto pointOrderOf = [&](const SnapResult& snap) {
         const EntityID& pointKey = snap.pointId.empty() ? snap.entityId : snap.pointId;
-        auto it = pointOrder.find(pointKey);
-        return it != pointOrder.end() ? it->second : std::numeric_limits<size_t>::max();
+        return index.orderOf(pointKey);
     };
 
     const SnapResult* bestVertex = &best;
@@ -179,8 +166,8 @@ SnapResult SnapManager::findBestSnap(
             continue;
         }
 
-        const size_t currentOrder = pointOrderOf(*bestVertex);
-        const size_t candidateOrder = pointOrderOf(snap);
+        const uint64_t currentOrder = pointOrderOf(*bestVertex);
+        const uint64_t candidateOrder = pointOrderOf(snap);
         if (candidateOrder < currentOrder ||
             (candidateOrder == currentOrder && snap < *bestVertex)) {
             bestVertex = &snap;
@@ -211,48 +198,41 @@ std::vector<SnapResult> SnapManager::findAllSnaps(
                             << "snapRadius=" << snapRadius_
                             << "spatialHashEnabled=" << spatialHashEnabled_;
 
-    std::unordered_set<EntityID> candidateSet;
-    const std::unordered_set<EntityID>* candidateFilter = nullptr;
-    if (spatialHashEnabled_) {
-        rebuildSpatialHash(sketch);
-        const std::vector<EntityID> candidateIds = spatialHash_.query(cursorPos, snapRadius_);
-        candidateSet.insert(candidateIds.begin(), candidateIds.end());
-        candidateFilter = &candidateSet;
-    }
+    const EntityList candidates = collectCandidates(cursorPos, sketch);
 
     std::vector<SnapResult> results;
     const double radiusSq = snapRadius_ * snapRadius_;
 
     // Find all snap types in priority order
     if (isSnapEnabled(SnapType::Vertex)) {
-        findVertexSnaps(cursorPos, sketch, excludeEntities, candidateFilter, radiusSq, results);
+        findVertexSnaps(cursorPos, sketch, excludeEntities, candidates, radiusSq, results);
     }
     if (isSnapEnabled(SnapType::Endpoint)) {
-        findEndpointSnaps(cursorPos, sketch, excludeEntities, candidateFilter, radiusSq, results);
+        findEndpointSnaps(cursorPos, sketch, excludeEntities, candidates, radiusSq, results);
     }
     if (isSnapEnabled(SnapType::Midpoint)) {
-        findMidpointSnaps(cursorPos, sketch, excludeEntities, candidateFilter, radiusSq, results);
+        findMidpointSnaps(cursorPos, sketch, excludeEntities, candidates, radiusSq, results);
     }
     if (isSnapEnabled(SnapType::Center)) {
-        findCenterSnaps(cursorPos, sketch, excludeEntities, candidateFilter, radiusSq, results);
+        findCenterSnaps(cursorPos, sketch, excludeEntities, candidates, radiusSq, results);
     }
     if (isSnapEnabled(SnapType::Quadrant)) {
-        findQuadrantSnaps(cursorPos, sketch, excludeEntities, candidateFilter, radiusSq, results);
+        findQuadrantSnaps(cursorPos, sketch, excludeEntities, candidates, radiusSq, results);
     }
     if (isSnapEnabled(SnapType::Intersection)) {
-        findIntersectionSnaps(cursorPos, sketch, excludeEntities, candidateFilter, radiusSq, results);
+        findIntersectionSnaps(cursorPos, sketch, excludeEntities, candidates, radiusSq, results);
     }
     if (isSnapEnabled(SnapType::OnCurve)) {
-        findOnCurveSnaps(cursorPos, sketch, excludeEntities, candidateFilter, radiusSq, results);
+        findOnCurveSnaps(cursorPos, sketch, excludeEntities, candidates, radiusSq, results);
     }
     if (gridSnapEnabled_ && isSnapEnabled(SnapType::Grid)) {
         findGridSnaps(cursorPos, radiusSq, results);
     }
     if (isSnapEnabled(SnapType::Perpendicular)) {
-        findPerpendicularSnaps(cursorPos, sketch, excludeEntities, radiusSq, results);
+        findPerpendicularSnaps(cursorPos, sketch, excludeEntities, candidates, radiusSq, results);
     }
     if (isSnapEnabled(SnapType::Tangent)) {
-        findTangentSnaps(cursorPos, sketch, excludeEntities, radiusSq, results);
+        findTangentSnaps(cursorPos, sketch, excludeEntities, candidates, radiusSq, results);
     }
     if (isSnapEnabled(SnapType::Horizontal)) {
         findHorizontalSnaps(cursorPos, sketch, excludeEntities, results);
@@ -261,7 +241,17 @@ std::vector<SnapResult> SnapManager::findAllSnaps(
         findVerticalSnaps(cursorPos, sketch, excludeEntities, results);
     }
     if (isSnapEnabled(SnapType::SketchGuide)) {
-        findGuideSnaps(cursorPos, sketch, excludeEntities, radiusSq, results);
+        EntityList guideLines;
+        if (spatialHashEnabled_) {
+            for (const auto& id : sketch.spatialIndex().queryGuides(cursorPos, snapRadius_)) {
+                if (const SketchEntity* entity = sketch.getEntity(id)) {
+                    guideLines.push_back(entity);
+                }
+            }
+        } else {
+            guideLines = candidates;
+        }
+        findGuideSnaps(cursorPos, sketch, excludeEntities, guideLines, radiusSq, results);
         if (referencePoint.has_value()) {
             findAngularSnap(cursorPos, referencePoint.value(), radiusSq, results);
         }
@@ -356,17 +346,26 @@ void SnapManager::clearAmbiguity() const {
     ambiguityState_.active = false;
 }
 
-void SnapManager::rebuildSpatialHash(const Sketch& sketch) const {
-    spatialHash_.rebuild(sketch);
-}
-
-bool SnapManager::shouldConsiderEntity(const EntityID& entityId,
-                                       const std::unordered_set<EntityID>* candidateSet) const
+SnapManager::EntityList SnapManager::collectCandidates(const Vec2d& cursorPos,
+                                                      const Sketch& sketch) const
 {
-    if (!candidateSet) {
-        return true;
+    EntityList candidates;
+    if (!spatialHashEnabled_) {
+        candidates.reserve(sketch.getEntityCount());
+        for (const auto& entity : sketch.getAllEntities()) {
+            candidates.push_back(entity.get());
+        }
+        return candidates;
     }
-    return candidateSet->count(entityId) > 0;
+
+    const std::vector<EntityID> ids = sketch.spatialIndex().queryRadius(cursorPos, snapRadius_);
+    candidates.reserve(ids.size());
+    for (const auto& id : ids) {
+        if (const SketchEntity* entity = sketch.getEntity(id)) {
+            candidates.push_back(entity);
+        }
+    }
+    return candidates;
 }
 
 // ========== Individual Snap Type Finders ==========
@@ -375,16 +374,15 @@ void SnapManager::findVertexSnaps(
     const Vec2d& cursorPos,
     const Sketch& sketch,
     const std::unordered_set<EntityID>& excludeEntities,
-    const std::unordered_set<EntityID>* candidateSet,
+    const EntityList& candidates,
     double radiusSq,
     std::vector<SnapResult>& results) const
 {
-    for (const auto& entity : sketch.getAllEntities()) {
-        if (!shouldConsiderEntity(entity->id(), candidateSet)) continue;
+    for (const SketchEntity* entity : candidates) {
         if (excludeEntities.count(entity->id())) continue;
         if (entity->type() != EntityType::Point) continue;
 
-        const auto* point = static_cast<const SketchPoint*>(entity.get());
+        const auto* point = static_cast<const SketchPoint*>(entity);
         Vec2d pos = toVec2d(point->position());
         double distSq = distanceSquared(cursorPos, pos);
 
@@ -406,16 +404,15 @@ void SnapManager::findEndpointSnaps(
     const Vec2d& cursorPos,
     const Sketch& sketch,
     const std::unordered_set<EntityID>& excludeEntities,
-    const std::unordered_set<EntityID>* candidateSet,
+    const EntityList& candidates,
     double radiusSq,
     std::vector<SnapResult>& results) const
 {
-    for (const auto& entity : sketch.getAllEntities()) {
-        if (!shouldConsiderEntity(entity->id(), candidateSet)) continue;
+    for (const SketchEntity* entity : candidates) {
         if (excludeEntities.count(entity->id())) continue;
 
         if (entity->type() == EntityType::Line) {
-            const auto* line = static_cast<const SketchLine*>(entity.get());
+            const auto* line = static_cast<const SketchLine*>(entity);
 
             // Get start point
             const auto* startPt = sketch.getEntityAs<SketchPoint>(line->startPointId());
@@ -454,7 +451,7 @@ void SnapManager::findEndpointSnaps(
             }
         }
         else if (entity->type() == EntityType::Arc) {
-            const auto* arc = static_cast<const SketchArc*>(entity.get());
+            const auto* arc = static_cast<const SketchArc*>(entity);
             const auto* centerPt = sketch.getEntityAs<SketchPoint>(arc->centerPointId());
             if (!centerPt) continue;
 
@@ -495,16 +492,15 @@ void SnapManager::findMidpointSnaps(
     const Vec2d& cursorPos,
     const Sketch& sketch,
     const std::unordered_set<EntityID>& excludeEntities,
-    const std::unordered_set<EntityID>* candidateSet,
+    const EntityList& candidates,
     double radiusSq,
     std::vector<SnapResult>& results) const
 {
-    for (const auto& entity : sketch.getAllEntities()) {
-        if (!shouldConsiderEntity(entity->id(), candidateSet)) continue;
+    for (const SketchEntity* entity : candidates) {
         if (excludeEntities.count(entity->id())) continue;
 
         if (entity->type() == EntityType::Line) {
-            const auto* line = static_cast<const SketchLine*>(entity.get());
+            const auto* line = static_cast<const SketchLine*>(entity);
             const auto* startPt = sketch.getEntityAs<SketchPoint>(line->startPointId());
             const auto* endPt = sketch.getEntityAs<SketchPoint>(line->endPointId());
             if (!startPt || !endPt) continue;
@@ -525,7 +521,7 @@ void SnapManager::findMidpointSnaps(
             }
         }
         else if (entity->type() == EntityType::Arc) {
-            const auto* arc = static_cast<const SketchArc*>(entity.get());
+            const auto* arc = static_cast<const SketchArc*>(entity);
             const auto* centerPt = sketch.getEntityAs<SketchPoint>(arc->centerPointId());
             if (!centerPt) continue;
 
@@ -550,26 +546,25 @@ void SnapManager::findCenterSnaps(
     const Vec2d& cursorPos,
     const Sketch& sketch,
     const std::unordered_set<EntityID>& excludeEntities,
-    const std::unordered_set<EntityID>* candidateSet,
+    const EntityList& candidates,
     double radiusSq,
     std::vector<SnapResult>& results) const
 {
-    for (const auto& entity : sketch.getAllEntities()) {
-        if (!shouldConsiderEntity(entity->id(), candidateSet)) continue;
+    for (const SketchEntity* entity : candidates) {
         if (excludeEntities.count(entity->id())) continue;
 
         const SketchPoint* centerPt = nullptr;
 
         if (entity->type() == EntityType::Arc) {
-            const auto* arc = static_cast<const SketchArc*>(entity.get());
+            const auto* arc = static_cast<const SketchArc*>(entity);
             centerPt = sketch.getEntityAs<SketchPoint>(arc->centerPointId());
         }
         else if (entity->type() == EntityType::Circle) {
-            const auto* circle = static_cast<const SketchCircle*>(entity.get());
+            const auto* circle = static_cast<const SketchCircle*>(entity);
             centerPt = sketch.getEntityAs<SketchPoint>(circle->centerPointId());
         }
         else if (entity->type() == EntityType::Ellipse) {
-            const auto* ellipse = static_cast<const SketchEllipse*>(entity.get());
+            const auto* ellipse = static_cast<const SketchEllipse*>(entity);
             centerPt = sketch.getEntityAs<SketchPoint>(ellipse->centerPointId());
         }
 
@@ -596,19 +591,18 @@ void SnapManager::findQuadrantSnaps(
     const Vec2d& cursorPos,
     const Sketch& sketch,
     const std::unordered_set<EntityID>& excludeEntities,
-    const std::unordered_set<EntityID>* candidateSet,
+    const EntityList& candidates,
     double radiusSq,
     std::vector<SnapResult>& results) const
 {
     // Quadrant angles: 0, 90, 180, 270 degrees
     constexpr double quadrantAngles[4] = {0.0, PI / 2.0, PI, 3.0 * PI / 2.0};
 
-    for (const auto& entity : sketch.getAllEntities()) {
-        if (!shouldConsiderEntity(entity->id(), candidateSet)) continue;
+    for (const SketchEntity* entity : candidates) {
         if (excludeEntities.count(entity->id())) continue;
 
         if (entity->type() == EntityType::Circle) {
-            const auto* circle = static_cast<const SketchCircle*>(entity.get());
+            const auto* circle = static_cast<const SketchCircle*>(entity);
             const auto* centerPt = sketch.getEntityAs<SketchPoint>(circle->centerPointId());
             if (!centerPt) continue;
 
@@ -635,7 +629,7 @@ void SnapManager::findQuadrantSnaps(
             }
         }
         else if (entity->type() == EntityType::Arc) {
-            const auto* arc = static_cast<const SketchArc*>(entity.get());
+            const auto* arc = static_cast<const SketchArc*>(entity);
             const auto* centerPt = sketch.getEntityAs<SketchPoint>(arc->centerPointId());
             if (!centerPt) continue;
 
@@ -665,7 +659,7 @@ void SnapManager::findQuadrantSnaps(
             }
         }
         else if (entity->type() == EntityType::Ellipse) {
-            const auto* ellipse = static_cast<const SketchEllipse*>(entity.get());
+            const auto* ellipse = static_cast<const SketchEllipse*>(entity);
             const auto* centerPt = sketch.getEntityAs<SketchPoint>(ellipse->centerPointId());
             if (!centerPt) continue;
 
@@ -692,20 +686,42 @@ void SnapManager::findIntersectionSnaps(
     const Vec2d& cursorPos,
     const Sketch& sketch,
     const std::unordered_set<EntityID>& excludeEntities,
-    const std::unordered_set<EntityID>* candidateSet,
+    const EntityList& candidates,
     double radiusSq,
     std::vector<SnapResult>& results) const
 {
+    if (spatialHashEnabled_) {
+        const SketchIntersectionIndex& intersections = sketch.intersectionIndex();
+        for (const auto* hit : intersections.query(cursorPos, snapRadius_, sketch.spatialIndex())) {
+            if (excludeEntities.count(hit->firstEntityId) ||
+                excludeEntities.count(hit->secondEntityId)) {
+                continue;
+            }
+            const double distSq = distanceSquared(cursorPos, hit->position);
+            if (distSq <= radiusSq) {
+                results.push_back({
+                    .snapped = true,
+                    .type = SnapType::Intersection,
+                    .position = hit->position,
+                    .entityId = hit->firstEntityId,
+                    .secondEntityId = hit->secondEntityId,
+                    .distance = std::sqrt(distSq),
+                    .hintText = "INT"
+                });
+            }
+        }
+        return;
+    }
+
     // Collect all non-excluded entities for intersection testing
     std::vector<const SketchEntity*> entities;
-    for (const auto& entity : sketch.getAllEntities()) {
-        if (!shouldConsiderEntity(entity->id(), candidateSet)) continue;
+    for (const SketchEntity* entity : candidates) {
         if (excludeEntities.count(entity->id())) continue;
         if (entity->type() == EntityType::Line ||
             entity->type() == EntityType::Arc ||
             entity->type() == EntityType::Circle ||
             entity->type() == EntityType::Ellipse) {
-            entities.push_back(entity.get());
+            entities.push_back(entity);
         }
     }
 
@@ -737,19 +753,18 @@ void SnapManager::findOnCurveSnaps(
     const Vec2d& cursorPos,
     const Sketch& sketch,
     const std::unordered_set<EntityID>& excludeEntities,
-    const std::unordered_set<EntityID>* candidateSet,
+    const EntityList& candidates,
     double radiusSq,
     std::vector<SnapResult>& results) const
 {
-    for (const auto& entity : sketch.getAllEntities()) {
-        if (!shouldConsiderEntity(entity->id(), candidateSet)) continue;
+    for (const SketchEntity* entity : candidates) {
         if (excludeEntities.count(entity->id())) continue;
 
         Vec2d nearestPt;
         bool found = false;
 
         if (entity->type() == EntityType::Line) {
-            const auto* line = static_cast<const SketchLine*>(entity.get());
+            const auto* line = static_cast<const SketchLine*>(entity);
             const auto* startPt = sketch.getEntityAs<SketchPoint>(line->startPointId());
             const auto* endPt = sketch.getEntityAs<SketchPoint>(line->endPointId());
             if (!startPt || !endPt) continue;
@@ -762,7 +777,7 @@ void SnapManager::findOnCurveSnaps(
             found = true;
         }
         else if (entity->type() == EntityType::Circle) {
-            const auto* circle = static_cast<const SketchCircle*>(entity.get());
+            const auto* circle = static_cast<const SketchCircle*>(entity);
             const auto* centerPt = sketch.getEntityAs<SketchPoint>(circle->centerPointId());
             if (!centerPt) continue;
 
@@ -774,7 +789,7 @@ void SnapManager::findOnCurveSnaps(
             found = true;
         }
         else if (entity->type() == EntityType::Arc) {
-            const auto* arc = static_cast<const SketchArc*>(entity.get());
+            const auto* arc = static_cast<const SketchArc*>(entity);
             const auto* centerPt = sketch.getEntityAs<SketchPoint>(arc->centerPointId());
             if (!centerPt) continue;
 
@@ -798,7 +813,7 @@ void SnapManager::findOnCurveSnaps(
             }
         }
         else if (entity->type() == EntityType::Ellipse) {
-            const auto* ellipse = static_cast<const SketchEllipse*>(entity.get());
+            const auto* ellipse = static_cast<const SketchEllipse*>(entity);
             const auto* centerPt = sketch.getEntityAs<SketchPoint>(ellipse->centerPointId());
             if (!centerPt) continue;
 
@@ -887,19 +902,20 @@ void SnapManager::findPerpendicularSnaps(
     const Vec2d& cursorPos,
     const Sketch& sketch,
     const std::unordered_set<EntityID>& excludeEntities,
+    const EntityList& candidates,
     double radiusSq,
     std::vector<SnapResult>& results) const
 {
     constexpr double kGeomEps = 1e-6;
 
-    for (const auto& entity : sketch.getAllEntities()) {
+    for (const SketchEntity* entity : candidates) {
         if (excludeEntities.count(entity->id())) continue;
 
         Vec2d foot;
         bool found = false;
 
         if (entity->type() == EntityType::Line) {
-            const auto* line = static_cast<const SketchLine*>(entity.get());
+            const auto* line = static_cast<const SketchLine*>(entity);
             const auto* startPt = sketch.getEntityAs<SketchPoint>(line->startPointId());
             const auto* endPt = sketch.getEntityAs<SketchPoint>(line->endPointId());
             if (!startPt || !endPt) continue;
@@ -921,7 +937,7 @@ void SnapManager::findPerpendicularSnaps(
             found = true;
         }
         else if (entity->type() == EntityType::Circle) {
-            const auto* circle = static_cast<const SketchCircle*>(entity.get());
+            const auto* circle = static_cast<const SketchCircle*>(entity);
             const auto* centerPt = sketch.getEntityAs<SketchPoint>(circle->centerPointId());
             if (!centerPt) continue;
 
@@ -942,7 +958,7 @@ void SnapManager::findPerpendicularSnaps(
             found = true;
         }
         else if (entity->type() == EntityType::Arc) {
-            const auto* arc = static_cast<const SketchArc*>(entity.get());
+            const auto* arc = static_cast<const SketchArc*>(entity);
             const auto* centerPt = sketch.getEntityAs<SketchPoint>(arc->centerPointId());
             if (!centerPt) continue;
 
@@ -994,12 +1010,13 @@ void SnapManager::findTangentSnaps(
     const Vec2d& cursorPos,
     const Sketch& sketch,
     const std::unordered_set<EntityID>& excludeEntities,
+    const EntityList& candidates,
     double radiusSq,
     std::vector<SnapResult>& results) const
 {
     constexpr double kGeomEps = 1e-6;
 
-    for (const auto& entity : sketch.getAllEntities()) {
+    for (const SketchEntity* entity : candidates) {
         if (excludeEntities.count(entity->id())) continue;
 
         Vec2d center;
@@ -1008,14 +1025,14 @@ void SnapManager::findTangentSnaps(
         const SketchArc* arc = nullptr;
 
         if (entity->type() == EntityType::Circle) {
-            const auto* circle = static_cast<const SketchCircle*>(entity.get());
+            const auto* circle = static_cast<const SketchCircle*>(entity);
             const auto* centerPt = sketch.getEntityAs<SketchPoint>(circle->centerPointId());
             if (!centerPt) continue;
             center = toVec2d(centerPt->position());
             radius = circle->radius();
         }
         else if (entity->type() == EntityType::Arc) {
-            arc = static_cast<const SketchArc*>(entity.get());
+            arc = static_cast<const SketchArc*>(entity);
             const auto* centerPt = sketch.getEntityAs<SketchPoint>(arc->centerPointId());
             if (!centerPt) continue;
             center = toVec2d(centerPt->position());
@@ -1092,99 +1109,54 @@ void SnapManager::findTangentSnaps(
     }
 }
 
-void SnapManager::findHorizontalSnaps(
+std::vector<SketchSpatialIndex::AlignmentAnchor> SnapManager::collectAlignmentAnchors(
     const Vec2d& cursorPos,
     const Sketch& sketch,
     const std::unordered_set<EntityID>& excludeEntities,
-    std::vector<SnapResult>& results) const
+    bool horizontal) const
 {
-    struct CandidatePoint {
-        Vec2d position;
-        EntityID entityId;
-        EntityID pointId;
+    std::vector<SketchSpatialIndex::AlignmentAnchor> anchors;
+    auto isExcluded = [&](const SketchSpatialIndex::AlignmentAnchor& anchor) {
+        return excludeEntities.count(anchor.entityId) > 0 ||
+               (!anchor.pointId.empty() && excludeEntities.count(anchor.pointId) > 0);
     };
 
-    std::vector<CandidatePoint> points;
-    points.reserve(sketch.getEntityCount() * 2);
-
-    for (const auto& entity : sketch.getAllEntities()) {
-        if (excludeEntities.count(entity->id())) continue;
-
-        if (entity->type() == EntityType::Point) {
-            const auto* point = static_cast<const SketchPoint*>(entity.get());
-            points.push_back({
-                .position = toVec2d(point->position()),
-                .entityId = entity->id(),
-                .pointId = entity->id()
-            });
-        }
-        else if (entity->type() == EntityType::Line) {
-            const auto* line = static_cast<const SketchLine*>(entity.get());
-            const auto* startPt = sketch.getEntityAs<SketchPoint>(line->startPointId());
-            const auto* endPt = sketch.getEntityAs<SketchPoint>(line->endPointId());
-            if (!startPt || !endPt) continue;
-
-            if (!excludeEntities.count(line->startPointId())) {
-                points.push_back({
-                    .position = toVec2d(startPt->position()),
-                    .entityId = entity->id(),
-                    .pointId = line->startPointId()
-                });
-            }
-            if (!excludeEntities.count(line->endPointId())) {
-                points.push_back({
-                    .position = toVec2d(endPt->position()),
-                    .entityId = entity->id(),
-                    .pointId = line->endPointId()
-                });
+    if (spatialHashEnabled_) {
+        const SketchSpatialIndex& index = sketch.spatialIndex();
+        const auto band = horizontal ? index.anchorsNearY(cursorPos.y, snapRadius_)
+                                     : index.anchorsNearX(cursorPos.x, snapRadius_);
+        anchors.reserve(band.size());
+        for (const auto* anchor : band) {
+            if (!isExcluded(*anchor)) {
+                anchors.push_back(*anchor);
             }
-
-            points.push_back({
-                .position = {
-                    (startPt->position().X() + endPt->position().X()) * 0.5,
-                    (startPt->position().Y() + endPt->position().Y()) * 0.5
-                },
-                .entityId = entity->id(),
-                .pointId = {}
-            });
-        }
-        else if (entity->type() == EntityType::Circle) {
-            const auto* circle = static_cast<const SketchCircle*>(entity.get());
-            if (excludeEntities.count(circle->centerPointId())) continue;
-            const auto* centerPt = sketch.getEntityAs<SketchPoint>(circle->centerPointId());
-            if (!centerPt) continue;
-
-            points.push_back({
-                .position = toVec2d(centerPt->position()),
-                .entityId = entity->id(),
-                .pointId = circle->centerPointId()
-            });
         }
-        else if (entity->type() == EntityType::Arc) {
-            const auto* arc = static_cast<const SketchArc*>(entity.get());
-            if (excludeEntities.count(arc->centerPointId())) continue;
-            const auto* centerPt = sketch.getEntityAs<SketchPoint>(arc->centerPointId());
-            if (!centerPt) continue;
-
-            points.push_back({
-                .position = toVec2d(centerPt->position()),
-                .entityId = entity->id(),
-                .pointId = arc->centerPointId()
-            });
-        }
-        else if (entity->type() == EntityType::Ellipse) {
-            const auto* ellipse = static_cast<const SketchEllipse*>(entity.get());
-            if (excludeEntities.count(ellipse->centerPointId())) continue;
-            const auto* centerPt = sketch.getEntityAs<SketchPoint>(ellipse->centerPointId());
-            if (!centerPt) continue;
+        std::sort(anchors.begin(), anchors.end(), [](const auto& a, const auto& b) {
+            return a.order < b.order;
+        });
+        return anchors;
+    }
 
-            points.push_back({
-                .position = toVec2d(centerPt->position()),
-                .entityId = entity->id(),
-                .pointId = ellipse->centerPointId()
-            });
+    std::vector<SketchSpatialIndex::AlignmentAnchor> entityAnchors;
+    for (const auto& entity : sketch.getAllEntities()) {
+        entityAnchors.clear();
+        SketchSpatialIndex::collectAlignmentAnchors(*entity, sketch, entityAnchors);
+        for (auto& anchor : entityAnchors) {
+            if (!isExcluded(anchor)) {
+                anchors.push_back(std::move(anchor));
+            }
         }
     }
+    return anchors;
+}
+
+void SnapManager::findHorizontalSnaps(
+    const Vec2d& cursorPos,
+    const Sketch& sketch,
+    const std::unordered_set<EntityID>& excludeEntities,
+    std::vector<SnapResult>& results) const
+{
+    const auto points = collectAlignmentAnchors(cursorPos, sketch, excludeEntities, true);
 
     double bestDeltaY = std::numeric_limits<double>::max();
     SnapResult best;
@@ -1225,93 +1197,7 @@ void SnapManager::findVerticalSnaps(
     const std::unordered_set<EntityID>& excludeEntities,
     std::vector<SnapResult>& results) const
 {
-    struct CandidatePoint {
-        Vec2d position;
-        EntityID entityId;
-        EntityID pointId;
-    };
-
-    std::vector<CandidatePoint> points;
-    points.reserve(sketch.getEntityCount() * 2);
-
-    for (const auto& entity : sketch.getAllEntities()) {
-        if (excludeEntities.count(entity->id())) continue;
-
-        if (entity->type() == EntityType::Point) {
-            const auto* point = static_cast<const SketchPoint*>(entity.get());
-            points.push_back({
-                .position = toVec2d(point->position()),
-                .entityId = entity->id(),
-                .pointId = entity->id()
-            });
-        }
-        else if (entity->type() == EntityType::Line) {
-            const auto* line = static_cast<const SketchLine*>(entity.get());
-            const auto* startPt = sketch.getEntityAs<SketchPoint>(line->startPointId());
-            const auto* endPt = sketch.getEntityAs<SketchPoint>(line->endPointId());
-            if (!startPt || !endPt) continue;
-
-            if (!excludeEntities.count(line->startPointId())) {
-                points.push_back({
-                    .position = toVec2d(startPt->position()),
-                    .entityId = entity->id(),
-                    .pointId = line->startPointId()
-                });
-            }
-            if (!excludeEntities.count(line->endPointId())) {
-                points.push_back({
-                    .position = toVec2d(endPt->position()),
-                    .entityId = entity->id(),
-                    .pointId = line->endPointId()
-                });
-            }
-
-            points.push_back({
-                .position = {
-                    (startPt->position().X() + endPt->position().X()) * 0.5,
-                    (startPt->position().Y() + endPt->position().Y()) * 0.5
-                },
-                .entityId = entity->id(),
-                .pointId = {}
-            });
-        }
-        else if (entity->type() == EntityType::Circle) {
-            const auto* circle = static_cast<const SketchCircle*>(entity.get());
-            if (excludeEntities.count(circle->centerPointId())) continue;
-            const auto* centerPt = sketch.getEntityAs<SketchPoint>(circle->centerPointId());
-            if (!centerPt) continue;
-
-            points.push_back({
-                .position = toVec2d(centerPt->position()),
-                .entityId = entity->id(),
-                .pointId = circle->centerPointId()
-            });
-        }
-        else if (entity->type() == EntityType::Arc) {
-            const auto* arc = static_cast<const SketchArc*>(entity.get());
-            if (excludeEntities.count(arc->centerPointId())) continue;
-            const auto* centerPt = sketch.getEntityAs<SketchPoint>(arc->centerPointId());
-            if (!centerPt) continue;
-
-            points.push_back({
-                .position = toVec2d(centerPt->position()),
-                .entityId = entity->id(),
-                .pointId = arc->centerPointId()
-            });
-        }
-        else if (entity->type() == EntityType::Ellipse) {
-            const auto* ellipse = static_cast<const SketchEllipse*>(entity.get());
-            if (excludeEntities.count(ellipse->centerPointId())) continue;
-            const auto* centerPt = sketch.getEntityAs<SketchPoint>(ellipse->centerPointId());
-            if (!centerPt) continue;
-
-            points.push_back({
-                .position = toVec2d(centerPt->position()),
-                .entityId = entity->id(),
-                .pointId = ellipse->centerPointId()
-            });
-        }
-    }
+    const auto points = collectAlignmentAnchors(cursorPos, sketch, excludeEntities, false);
 
     double bestDeltaX = std::numeric_limits<double>::max();
     SnapResult best;
@@ -1350,14 +1236,15 @@ void SnapManager::findGuideSnaps(
     const Vec2d& cursorPos,
     const Sketch& sketch,
     const std::unordered_set<EntityID>& excludeEntities,
+    const EntityList& candidates,
     double radiusSq,
     std::vector<SnapResult>& results) const
 {
-    for (const auto& entity : sketch.getAllEntities()) {
+    for (const SketchEntity* entity : candidates) {
         if (excludeEntities.count(entity->id())) continue;
         if (entity->type() != EntityType::Line) continue;
 
-        const auto* line = static_cast<const SketchLine*>(entity.get());
+        const auto* line = static_cast<const SketchLine*>(entity);
         const auto* startPt = sketch.getEntityAs<SketchPoint>(line->startPointId());
         const auto* endPt = sketch.getEntityAs<SketchPoint>(line->endPointId());
         if (!startPt || !endPt) continue;
@@ -1653,7 +1540,7 @@ void SnapManager::findExternalSnaps(
 std::vector<Vec2d> SnapManager::findEntityIntersections(
     const SketchEntity* e1,
     const SketchEntity* e2,
-    const Sketch& sketch) const
+    const Sketch& sketch)
 {
     std::vector<Vec2d> result;
 
@@ -11,7 +11,7 @@
 #define ONECAD_CORE_SKETCH_SNAP_MANAGER_H
 
 #include "SketchTypes.h"
-#include "SpatialHashGrid.h"
+#include "SketchSpatialIndex.h"
 #include <cstddef>
 #include <cmath>
 #include <limits>
@@ -224,15 +224,20 @@ public:
     void setShowSnappingHints(bool show) { showSnappingHints_ = show; }
     bool showSnappingHints() const { return showSnappingHints_; }
 
+    /**
+     * @brief Use the sketch's persistent spatial index for candidate lookup
+     *
+     * When disabled every finder scans all entities (reference brute-force path).
+     */
     void setSpatialHashEnabled(bool enabled) { spatialHashEnabled_ = enabled; }
     bool isSpatialHashEnabled() const { return spatialHashEnabled_; }
 
     /**
      * @brief Find intersections between two entities (public for IntersectionManager)
      */
-    std::vector<Vec2d> findEntityIntersections(const SketchEntity* e1,
-                                                const SketchEntity* e2,
-                                                const Sketch& sketch) const;
+    static std::vector<Vec2d> findEntityIntersections(const SketchEntity* e1,
+                                                       const SketchEntity* e2,
+                                                       const Sketch& sketch);
 
     // ========== Ambiguity Hooks (Future Tab-cycle UX) ==========
 
@@ -281,12 +286,16 @@ private:
     std::vector<Vec2d> extPoints_;
     std::vector<std::pair<Vec2d, Vec2d>> extLines_;
 
-    mutable SpatialHashGrid spatialHash_;
     mutable AmbiguityState ambiguityState_;
 
-    void rebuildSpatialHash(const Sketch& sketch) const;
-    bool shouldConsiderEntity(const EntityID& entityId,
-                              const std::unordered_set<EntityID>* candidateSet) const;
+    using EntityList = std::vector<const SketchEntity*>;
+
+    /**
+     * @brief Entities that may produce a snap near the cursor, in sketch order
+     *
+     * Uses the sketch spatial index when enabled; otherwise returns all entities.
+     */
+    EntityList collectCandidates(const Vec2d& cursorPos, const Sketch& sketch) const;
 
     // ========== Individual Snap Type Finders ==========
 
@@ -296,7 +305,7 @@ private:
     void findVertexSnaps(const Vec2d& cursorPos,
                          const Sketch& sketch,
                          const std::unordered_set<EntityID>& excludeEntities,
-                         const std::unordered_set<EntityID>* candidateSet,
+                         const EntityList& candidates,
                          double radiusSq,
                          std::vector<SnapResult>& results) const;
 
@@ -306,7 +315,7 @@ private:
     void findEndpointSnaps(const Vec2d& cursorPos,
                            const Sketch& sketch,
                            const std::unordered_set<EntityID>& excludeEntities,
-                           const std::unordered_set<EntityID>* candidateSet,
+                           const EntityList& candidates,
                            double radiusSq,
                            std::vector<SnapResult>& results) const;
 
@@ -316,7 +325,7 @@ private:
     void findMidpointSnaps(const Vec2d& cursorPos,
                            const Sketch& sketch,
                            const std::unordered_set<EntityID>& excludeEntities,
-                           const std::unordered_set<EntityID>* candidateSet,
+                           const EntityList& candidates,
                            double radiusSq,
                            std::vector<SnapResult>& results) const;
 
@@ -326,7 +335,7 @@ private:
     void findCenterSnaps(const Vec2d& cursorPos,
                          const Sketch& sketch,
                          const std::unordered_set<EntityID>& excludeEntities,
-                         const std::unordered_set<EntityID>* candidateSet,
+                         const EntityList& candidates,
                          double radiusSq,
                          std::vector<SnapResult>& results) const;
 
@@ -336,17 +345,20 @@ private:
     void findQuadrantSnaps(const Vec2d& cursorPos,
                            const Sketch& sketch,
                            const std::unordered_set<EntityID>& excludeEntities,
-                           const std::unordered_set<EntityID>* candidateSet,
+                           const EntityList& candidates,
                            double radiusSq,
                            std::vector<SnapResult>& results) const;
 
     /**
      * @brief Find snaps to entity intersections
+     *
+     * Uses the sketch's maintained intersection index when the spatial index is
+     * enabled; otherwise tests all candidate pairs.
      */
     void findIntersectionSnaps(const Vec2d& cursorPos,
                                const Sketch& sketch,
                                const std::unordered_set<EntityID>& excludeEntities,
-                               const std::unordered_set<EntityID>* candidateSet,
+                               const EntityList& candidates,
                                double radiusSq,
                                std::vector<SnapResult>& results) const;
 
@@ -356,7 +368,7 @@ private:
     void findOnCurveSnaps(const Vec2d& cursorPos,
                           const Sketch& sketch,
                           const std::unordered_set<EntityID>& excludeEntities,
-                          const std::unordered_set<EntityID>* candidateSet,
+                          const EntityList& candidates,
                           double radiusSq,
                           std::vector<SnapResult>& results) const;
 
@@ -373,6 +385,7 @@ private:
     void findPerpendicularSnaps(const Vec2d& cursorPos,
                                 const Sketch& sketch,
                                 const std::unordered_set<EntityID>& excludeEntities,
+                                const EntityList& candidates,
                                 double radiusSq,
                                 std::vector<SnapResult>& results) const;
 
@@ -382,9 +395,20 @@ private:
     void findTangentSnaps(const Vec2d& cursorPos,
                           const Sketch& sketch,
                           const std::unordered_set<EntityID>& excludeEntities,
+                          const EntityList& candidates,
                           double radiusSq,
                           std::vector<SnapResult>& results) const;
 
+    /**
+     * @brief Alignment anchors for H/V inference, in sketch order
+     * @param horizontal true for anchors within snap radius in Y, false for X
+     */
+    std::vector<SketchSpatialIndex::AlignmentAnchor> collectAlignmentAnchors(
+        const Vec2d& cursorPos,
+        const Sketch& sketch,
+        const std::unordered_set<EntityID>& excludeEntities,
+        bool horizontal) const;
+
     /**
      * @brief Find horizontal alignment inference snaps
      */
@@ -407,6 +431,7 @@ private:
     void findGuideSnaps(const Vec2d& cursorPos,
                         const Sketch& sketch,
                         const std::unordered_set<EntityID>& excludeEntities,
+                        const EntityList& candidates,
                         double radiusSq,
                         std::vector<SnapResult>& results) const;
 
@@ -0,0 +1,507 @@
+/**
+ * @file SpatialRTree.cpp
+ * @brief Implementation of the dynamic bounding-box R-tree
+ */
+
+#include "SpatialRTree.h"
+
+#include <algorithm>
+#include <cmath>
+#include <queue>
+
+namespace onecad::core::sketch {
+
+namespace {
+
+BoundingBox2d unite(const BoundingBox2d& a, const BoundingBox2d& b) {
+    if (a.isEmpty()) {
+        return b;
+    }
+    if (b.isEmpty()) {
+        return a;
+    }
+    BoundingBox2d result;
+    result.minX = std::min(a.minX, b.minX);
+    result.minY = std::min(a.minY, b.minY);
+    result.maxX = std::max(a.maxX, b.maxX);
+    result.maxY = std::max(a.maxY, b.maxY);
+    return result;
+}
+
+double area(const BoundingBox2d& box) {
+    return box.isEmpty() ? 0.0 : box.width() * box.height();
+}
+
+// Half perimeter; keeps degenerate (zero-area) boxes such as axis-aligned lines comparable.
+double margin(const BoundingBox2d& box) {
+    return box.isEmpty() ? 0.0 : box.width() + box.height();
+}
+
+bool containsBox(const BoundingBox2d& outer, const BoundingBox2d& inner) {
+    return !outer.isEmpty() && !inner.isEmpty() &&
+           inner.minX >= outer.minX && inner.maxX <= outer.maxX &&
+           inner.minY >= outer.minY && inner.maxY <= outer.maxY;
+}
+
+struct GrowthCost {
+    double area = 0.0;
+    double margin = 0.0;
+
+    bool operator<(const GrowthCost& other) const {
+        if (area != other.area) {
+            return area < other.area;
+        }
+        return margin < other.margin;
+    }
+};
+
+GrowthCost growth(const BoundingBox2d& box, const BoundingBox2d& added) {
+    const BoundingBox2d merged = unite(box, added);
+    return {area(merged) - area(box), margin(merged) - margin(box)};
+}
+
+} // namespace
+
+SpatialRTree::SpatialRTree() {
+    clear();
+}
+
+void SpatialRTree::clear() {
+    nodes_.clear();
+    freeNodes_.clear();
+    entries_.clear();
+    freeEntries_.clear();
+    entryById_.clear();
+    root_ = allocNode(true);
+}
+
+void SpatialRTree::insert(const EntityID& id, const BoundingBox2d& bounds) {
+    remove(id);
+    if (bounds.isEmpty()) {
+        return;
+    }
+    insertEntry(allocEntry(id, bounds));
+}
+
+void SpatialRTree::update(const EntityID& id, const BoundingBox2d& bounds) {
+    auto it = entryById_.find(id);
+    if (it == entryById_.end() || bounds.isEmpty()) {
+        insert(id, bounds);
+        return;
+    }
+
+    Entry& entry = entries_[static_cast<size_t>(it->second)];
+    if (containsBox(nodes_[static_cast<size_t>(entry.leaf)].bounds, bounds)) {
+        // Ancestor boxes stay conservative; they tighten on the next structural change.
+        entry.bounds = bounds;
+        return;
+    }
+    insert(id, bounds);
+}
+
+bool SpatialRTree::remove(const EntityID& id) {
+    auto it = entryById_.find(id);
+    if (it == entryById_.end()) {
+        return false;
+    }
+
+    const int entry = it->second;
+    entryById_.erase(it);
+    const int leaf = entries_[static_cast<size_t>(entry)].leaf;
+    auto& children = nodes_[static_cast<size_t>(leaf)].children;
+    children.erase(std::remove(children.begin(), children.end(), entry), children.end());
+
+    entries_[static_cast<size_t>(entry)] = Entry{};
+    freeEntries_.push_back(entry);
+
+    condense(leaf);
+    return true;
+}
+
+BoundingBox2d SpatialRTree::bounds(const EntityID& id) const {
+    auto it = entryById_.find(id);
+    if (it == entryById_.end()) {
+        return {};
+    }
+    return entries_[static_cast<size_t>(it->second)].bounds;
+}
+
+std::vector<EntityID> SpatialRTree::query(const BoundingBox2d& box) const {
+    std::vector<EntityID> result;
+    if (box.isEmpty() || entryById_.empty()) {
+        return result;
+    }
+
+    std::vector<int> stack{root_};
+    while (!stack.empty()) {
+        const Node& node = nodes_[static_cast<size_t>(stack.back())];
+        stack.pop_back();
+        if (!node.bounds.intersects(box)) {
+            continue;
+        }
+        for (int child : node.children) {
+            if (node.leaf) {
+                const Entry& entry = entries_[static_cast<size_t>(child)];
+                if (entry.bounds.intersects(box)) {
+                    result.push_back(entry.id);
+                }
+            } else {
+                stack.push_back(child);
+            }
+        }
+    }
+    return result;
+}
+
+std::vector<std::pair<EntityID, double>> SpatialRTree::nearest(
+    const Vec2d& point,
+    size_t k,
+    double maxDistance,
+    const DistanceFn& exactDistance) const
+{
+    std::vector<std::pair<EntityID, double>> result;
+    if (k == 0 || entryById_.empty()) {
+        return result;
+    }
+
+    enum class Kind { Node, EntryBound, EntryExact };
+    struct Item {
+        double distance;
+        Kind kind;
+        int index;
+        bool operator>(const Item& other) const {
+            if (distance != other.distance) {
+                return distance > other.distance;
+            }
+            // Resolve exact entries before expanding equally distant bounds.
+            return static_cast<int>(kind) < static_cast<int>(other.kind);
+        }
+    };
+    std::priority_queue<Item, std::vector<Item>, std::greater<Item>> queue;
+    queue.push({boxDistance(point, nodes_[static_cast<size_t>(root_)].bounds), Kind::Node, root_});
+
+    while (!queue.empty() && result.size() < k) {
+        const Item item = queue.top();
+        queue.pop();
+        if (item.distance > maxDistance) {
+            break;
+        }
+
+        switch (item.kind) {
+            case Kind::Node: {
+                const Node& node = nodes_[static_cast<size_t>(item.index)];
+                for (int child : node.children) {
+                    const BoundingBox2d& box = childBounds(node, child);
+                    const double d = boxDistance(point, box);
+                    if (d <= maxDistance) {
+                        queue.push({d, node.leaf ? Kind::EntryBound : Kind::Node, child});
+                    }
+                }
+                break;
+            }
+            case Kind::EntryBound: {
+                const Entry& entry = entries_[static_cast<size_t>(item.index)];
+                if (!exactDistance) {
+                    result.emplace_back(entry.id, item.distance);
+                    break;
+                }
+                const double d = exactDistance(entry.id, entry.bounds);
+                if (std::isfinite(d) && d <= maxDistance) {
+                    queue.push({std::max(d, item.distance), Kind::EntryExact, item.index});
+                }
+                break;
+            }
+            case Kind::EntryExact: {
+                result.emplace_back(entries_[static_cast<size_t>(item.index)].id, item.distance);
+                break;
+            }
+        }
+    }
+    return result;
+}
+
+size_t SpatialRTree::height() const {
+    size_t levels = 1;
+    int node = root_;
+    while (!nodes_[static_cast<size_t>(node)].leaf && !nodes_[static_cast<size_t>(node)].children.empty()) {
+        node = nodes_[static_cast<size_t>(node)].children.front();
+        ++levels;
+    }
+    return levels;
+}
+
+double SpatialRTree::boxDistance(const Vec2d& point, const BoundingBox2d& box) {
+    if (box.isEmpty()) {
+        return std::numeric_limits<double>::infinity();
+    }
+    const double dx = std::max({box.minX - point.x, 0.0, point.x - box.maxX});
+    const double dy = std::max({box.minY - point.y, 0.0, point.y - box.maxY});
+    return std::sqrt(dx * dx + dy * dy);
+}
+
+int SpatialRTree::allocNode(bool leaf) {
+    int index;
+    if (!freeNodes_.empty()) {
+        index = freeNodes_.back();
+        freeNodes_.pop_back();
+        nodes_[static_cast<size_t>(index)] = Node{};
+    } else {
+        index = static_cast<int>(nodes_.size());
+        nodes_.emplace_back();
+    }
+    nodes_[static_cast<size_t>(index)].leaf = leaf;
+    return index;
+}
+
+void SpatialRTree::freeNode(int node) {
+    nodes_[static_cast<size_t>(node)] = Node{};
+    freeNodes_.push_back(node);
+}
+
+int SpatialRTree::allocEntry(const EntityID& id, const BoundingBox2d& bounds) {
+    int index;
+    if (!freeEntries_.empty()) {
+        index = freeEntries_.back();
+        freeEntries_.pop_back();
+    } else {
+        index = static_cast<int>(entries_.size());
+        entries_.emplace_back();
+    }
+    entries_[static_cast<size_t>(index)] = Entry{id, bounds, -1};
+    entryById_[id] = index;
+    return index;
+}
+
+const BoundingBox2d& SpatialRTree::childBounds(const Node& node, int child) const {
+    return node.leaf ? entries_[static_cast<size_t>(child)].bounds
+                     : nodes_[static_cast<size_t>(child)].bounds;
+}
+
+void SpatialRTree::recomputeBounds(int node) {
+    Node& n = nodes_[static_cast<size_t>(node)];
+    BoundingBox2d box;
+    for (int child : n.children) {
+        box = unite(box, childBounds(n, child));
+    }
+    n.bounds = box;
+}
+
+int SpatialRTree::chooseLeaf(const BoundingBox2d& bounds) const {
+    int node = root_;
+    while (!nodes_[static_cast<size_t>(node)].leaf) {
+        const Node& n = nodes_[static_cast<size_t>(node)];
+        int best = n.children.front();
+        GrowthCost bestCost = growth(nodes_[static_cast<size_t>(best)].bounds, bounds);
+        double bestArea = area(nodes_[static_cast<size_t>(best)].bounds);
+        for (size_t i = 1; i < n.children.size(); ++i) {
+            const int child = n.children[i];
+            const BoundingBox2d& childBox = nodes_[static_cast<size_t>(child)].bounds;
+            const GrowthCost cost = growth(childBox, bounds);
+            const double childArea = area(childBox);
+            if (cost < bestCost || (!(bestCost < cost) && childArea < bestArea)) {
+                best = child;
+                bestCost = cost;
+                bestArea = childArea;
+            }
+        }
+        node = best;
+    }
+    return node;
+}
+
+void SpatialRTree::insertEntry(int entry) {
+    const int leaf = chooseLeaf(entries_[static_cast<size_t>(entry)].bounds);
+    insertChild(leaf, entry);
+
+    int sibling = -1;
+    if (nodes_[static_cast<size_t>(leaf)].children.size() > kMaxChildren) {
+        sibling = splitNode(leaf);
+    }
+    adjustUpwards(leaf, sibling);
+}
+
+void SpatialRTree::insertChild(int node, int child) {
+    Node& n = nodes_[static_cast<size_t>(node)];
+    n.children.push_back(child);
+    if (n.leaf) {
+        entries_[static_cast<size_t>(child)].leaf = node;
+    } else {
+        nodes_[static_cast<size_t>(child)].parent = node;
+    }
+}
+
+int SpatialRTree::splitNode(int node) {
+    const bool leaf = nodes_[static_cast<size_t>(node)].leaf;
+    std::vector<int> children = std::move(nodes_[static_cast<size_t>(node)].children);
+    nodes_[static_cast<size_t>(node)].children.clear();
+    const int sibling = allocNode(leaf);
+
+    auto boxOf = [&](int child) -> const BoundingBox2d& {
+        return leaf ? entries_[static_cast<size_t>(child)].bounds
+                    : nodes_[static_cast<size_t>(child)].bounds;
+    };
+
+    // Quadratic seed selection: the pair wasting the most space together.
+    size_t seedA = 0;
+    size_t seedB = 1;
+    GrowthCost worst{-std::numeric_limits<double>::infinity(), -std::numeric_limits<double>::infinity()};
+    for (size_t i = 0; i < children.size(); ++i) {
+        for (size_t j = i + 1; j < children.size(); ++j) {
+            const BoundingBox2d& a = boxOf(children[i]);
+            const BoundingBox2d& b = boxOf(children[j]);
+            const BoundingBox2d merged = unite(a, b);
+            const GrowthCost waste{area(merged) - area(a) - area(b), margin(merged) - margin(a) - margin(b)};
+            if (worst < waste) {
+                worst = waste;
+                seedA = i;
+                seedB = j;
+            }
+        }
+    }
+
+    BoundingBox2d boxA = boxOf(children[seedA]);
+    BoundingBox2d boxB = boxOf(children[seedB]);
+    insertChild(node, children[seedA]);
+    insertChild(sibling, children[seedB]);
+
+    std::vector<int> remaining;
+    remaining.reserve(children.size() - 2);
+    for (size_t i = 0; i < children.size(); ++i) {
+        if (i != seedA && i != seedB) {
+            remaining.push_back(children[i]);
+        }
+    }
+
+    while (!remaining.empty()) {
+        const size_t countA = nodes_[static_cast<size_t>(node)].children.size();
+        const size_t countB = nodes_[static_cast<size_t>(sibling)].children.size();
+        if (countA + remaining.size() <= kMinChildren) {
+            for (int child : remaining) {
+                insertChild(node, child);
+                boxA = unite(boxA, boxOf(child));
+            }
+            break;
+        }
+        if (countB + remaining.size() <= kMinChildren) {
+            for (int child : remaining) {
+                insertChild(sibling, child);
+                boxB = unite(boxB, boxOf(child));
+            }
+            break;
+        }
+
+        // Pick the child with the strongest preference for one group.
+        size_t pick = 0;
+        double bestPreference = -1.0;
+        for (size_t i = 0; i < remaining.size(); ++i) {
+            const GrowthCost toA = growth(boxA, boxOf(remaining[i]));
+            const GrowthCost toB = growth(boxB, boxOf(remaining[i]));
+            const double preference = std::abs(toA.area - toB.area) + std::abs(toA.margin - toB.margin);
+            if (preference > bestPreference) {
+                bestPreference = preference;
+                pick = i;
+            }
+        }
+
+        const int child = remaining[pick];
+        remaining.erase(remaining.begin() + static_cast<long>(pick));
+        const GrowthCost toA = growth(boxA, boxOf(child));
+        const GrowthCost toB = growth(boxB, boxOf(child));
+        bool chooseA = toA < toB;
+        if (!(toA < toB) && !(toB < toA)) {
+            chooseA = countA <= countB;
+        }
+        if (chooseA) {
+            insertChild(node, child);
+            boxA = unite(boxA, boxOf(child));
+        } else {
+            insertChild(sibling, child);
+            boxB = unite(boxB, boxOf(child));
+        }
+    }
+
+    nodes_[static_cast<size_t>(node)].bounds = boxA;
+    nodes_[static_cast<size_t>(sibling)].bounds = boxB;
+    return sibling;
+}
+
+void SpatialRTree::adjustUpwards(int node, int sibling) {
+    while (true) {
+        recomputeBounds(node);
+        if (sibling >= 0) {
+            recomputeBounds(sibling);
+        }
+
+        const int parent = nodes_[static_cast<size_t>(node)].parent;
+        if (parent < 0) {
+            if (sibling >= 0) {
+                const int newRoot = allocNode(false);
+                insertChild(newRoot, node);
+                insertChild(newRoot, sibling);
+                recomputeBounds(newRoot);
+                root_ = newRoot;
+            }
+            return;
+        }
+
+        int parentSibling = -1;
+        if (sibling >= 0) {
+            insertChild(parent, sibling);
+            if (nodes_[static_cast<size_t>(parent)].children.size() > kMaxChildren) {
+                parentSibling = splitNode(parent);
+            }
+        }
+        node = parent;
+        sibling = parentSibling;
+    }
+}
+
+void SpatialRTree::condense(int leaf) {
+    std::vector<int> orphans;
+    int node = leaf;
+    while (node != root_) {
+        const int parent = nodes_[static_cast<size_t>(node)].parent;
+        if (nodes_[static_cast<size_t>(node)].children.size() < kMinChildren) {
+            auto& siblings = nodes_[static_cast<size_t>(parent)].children;
+            siblings.erase(std::remove(siblings.begin(), siblings.end(), node), siblings.end());
+            detachSubtree(node, orphans);
+        } else {
+            recomputeBounds(node);
+        }
+        node = parent;
+    }
+    recomputeBounds(root_);
+
+    while (!nodes_[static_cast<size_t>(root_)].leaf &&
+           nodes_[static_cast<size_t>(root_)].children.size() == 1) {
+        const int child = nodes_[static_cast<size_t>(root_)].children.front();
+        freeNode(root_);
+        root_ = child;
+        nodes_[static_cast<size_t>(root_)].parent = -1;
+    }
+    if (!nodes_[static_cast<size_t>(root_)].leaf && nodes_[static_cast<size_t>(root_)].children.empty()) {
+        freeNode(root_);
+        root_ = allocNode(true);
+    }
+
+    for (int entry : orphans) {
+        insertEntry(entry);
+    }
+}
+
+void SpatialRTree::detachSubtree(int node, std::vector<int>& entries) {
+    std::vector<int> stack{node};
+    while (!stack.empty()) {
+        const int current = stack.back();
+        stack.pop_back();
+        const Node& n = nodes_[static_cast<size_t>(current)];
+        if (n.leaf) {
+            entries.insert(entries.end(), n.children.begin(), n.children.end());
+        } else {
+            stack.insert(stack.end(), n.children.begin(), n.children.end());
+        }
+        freeNode(current);
+    }
+}
+
+} // namespace onecad::core::sketch
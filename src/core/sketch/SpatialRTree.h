@@ -0,0 +1,135 @@
+/**
+ * @file SpatialRTree.h
+ * @brief Dynamic bounding-box R-tree keyed by entity ID
+ *
+ * Unlike a fixed-cell hash grid, boxes of any size occupy a single leaf
+ * slot, so long lines and large circles do not flood the structure.
+ * Supports insert, remove, in-place update, box queries and best-first
+ * k-nearest queries with an optional exact distance refinement.
+ */
+#ifndef ONECAD_CORE_SKETCH_SPATIAL_RTREE_H
+#define ONECAD_CORE_SKETCH_SPATIAL_RTREE_H
+
+#include "SketchEntity.h"
+#include "SketchTypes.h"
+
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace onecad::core::sketch {
+
+/**
+ * @brief R-tree (quadratic split) over axis-aligned boxes
+ */
+class SpatialRTree {
+public:
+    static constexpr size_t kMaxChildren = 8;
+    static constexpr size_t kMinChildren = 3;
+
+    /**
+     * @brief Exact distance from the query point to an entry
+     *
+     * Must be >= the distance to the entry's box. Return infinity to reject.
+     */
+    using DistanceFn = std::function<double(const EntityID& id, const BoundingBox2d& bounds)>;
+
+    SpatialRTree();
+
+    void clear();
+
+    /**
+     * @brief Insert or replace the box stored for an id (empty boxes remove it)
+     */
+    void insert(const EntityID& id, const BoundingBox2d& bounds);
+
+    /**
+     * @brief Change the box of an id; cheap when the box stays inside its leaf
+     */
+    void update(const EntityID& id, const BoundingBox2d& bounds);
+
+    /**
+     * @brief Remove an id
+     * @return false if the id was not stored
+     */
+    bool remove(const EntityID& id);
+
+    bool contains(const EntityID& id) const { return entryById_.count(id) > 0; }
+    size_t size() const { return entryById_.size(); }
+    bool empty() const { return entryById_.empty(); }
+
+    /**
+     * @brief Stored box for an id (empty box if absent)
+     */
+    BoundingBox2d bounds(const EntityID& id) const;
+
+    /**
+     * @brief All ids whose box intersects the query box (unordered)
+     */
+    std::vector<EntityID> query(const BoundingBox2d& box) const;
+
+    /**
+     * @brief Up to k nearest ids, ascending by distance
+     * @param point Query point
+     * @param k Maximum number of results
+     * @param maxDistance Entries farther than this are ignored
+     * @param exactDistance Optional refinement; box distance is used when empty
+     */
+    std::vector<std::pair<EntityID, double>> nearest(
+        const Vec2d& point,
+        size_t k,
+        double maxDistance = std::numeric_limits<double>::infinity(),
+        const DistanceFn& exactDistance = {}) const;
+
+    /**
+     * @brief Tree height (1 for a single leaf); exposed for diagnostics
+     */
+    size_t height() const;
+
+    /**
+     * @brief Distance from a point to a box (0 inside)
+     */
+    static double boxDistance(const Vec2d& point, const BoundingBox2d& box);
+
+private:
+    struct Entry {
+        EntityID id;
+        BoundingBox2d bounds;
+        int leaf = -1;
+    };
+
+    struct Node {
+        BoundingBox2d bounds;
+        int parent = -1;
+        bool leaf = true;
+        std::vector<int> children;  ///< Entry indices for leaves, node indices otherwise
+    };
+
+    std::vector<Node> nodes_;
+    std::vector<int> freeNodes_;
+    std::vector<Entry> entries_;
+    std::vector<int> freeEntries_;
+    std::unordered_map<EntityID, int> entryById_;
+    int root_ = -1;
+
+    int allocNode(bool leaf);
+    void freeNode(int node);
+    int allocEntry(const EntityID& id, const BoundingBox2d& bounds);
+
+    const BoundingBox2d& childBounds(const Node& node, int child) const;
+    void recomputeBounds(int node);
+    int chooseLeaf(const BoundingBox2d& bounds) const;
+    void insertEntry(int entry);
+    void insertChild(int node, int child);
+    int splitNode(int node);
+    void adjustUpwards(int node, int sibling);
+    void condense(int leaf);
+    void detachSubtree(int node, std::vector<int>& entries);
+};
+
+} // namespace onecad::core::sketch
+
+#endif // ONECAD_CORE_SKETCH_SPATIAL_RTREE_H
@@ -5,6 +5,8 @@
 #include "../SketchArc.h"
 #include "../SketchCircle.h"
 #include "../SketchConstraint.h"
+#include "../../memory/MemoryEstimate.h"
+#include "../../trace/Trace.h"
 
 #include <GCS.h>
 
@@ -303,6 +305,7 @@ void ConstraintSolver::removeConstraint(ConstraintID id) {
 }
 
 SolverResult ConstraintSolver::solve() {
+    ONECAD_TRACE_SCOPE("solver", "solve");
     SolverResult result;
     auto start = std::chrono::steady_clock::now();
 
@@ -388,11 +391,13 @@ SolverResult ConstraintSolver::solve() {
         }
     }
 
+    collectMovedEntities(result);
     return result;
 }
 
 SolverResult ConstraintSolver::solveWithDrag(EntityID pointId, const Vec2d& targetPos,
                                              const std::unordered_set<EntityID>& pointIdsToFix) {
+    ONECAD_TRACE_SCOPE("solver", "solveWithDrag");
     qCDebug(logConstraintSolver) << "solveWithDrag:start"
                                  << "pointId=" << QString::fromStdString(pointId)
                                  << "target=" << targetPos.x << targetPos.y
@@ -533,6 +538,39 @@ bool ConstraintSolver::isSolvable() const {
     return !gcsSystem_->hasConflicting();
 }
 
+std::size_t ConstraintSolver::memoryBytes() const {
+    using memory::hashBytes;
+    using memory::stringMapBytes;
+    using memory::vectorBytes;
+
+    // PlaneGCS keeps a constraint object, its parameter list and solver
+    // subsystem bookkeeping per constraint, and per-parameter maps
+    constexpr std::size_t kGcsBytesPerConstraint = 160;
+    constexpr std::size_t kGcsBytesPerParameter = 64;
+
+    std::size_t bytes = sizeof(*this);
+    bytes += stringMapBytes(entityToGcsId_);
+    bytes += stringMapBytes(constraintToGcsTag_);
+    bytes += hashBytes(gcsTagToConstraint_);
+    for (const auto& [tag, id] : gcsTagToConstraint_) {
+        (void)tag;
+        bytes += memory::stringBytes(id);
+    }
+    bytes += vectorBytes(parameterBackup_);
+    for (const auto& backup : parameterBackup_) {
+        bytes += memory::stringBytes(backup.entityId) + vectorBytes(backup.values);
+    }
+    bytes += stringMapBytes(pointsById_) + stringMapBytes(linesById_)
+        + stringMapBytes(arcsById_) + stringMapBytes(circlesById_);
+    bytes += vectorBytes(constraints_) + vectorBytes(parameters_) + vectorBytes(drivenParameters_);
+    if (gcsSystem_) {
+        bytes += sizeof(GCS::System)
+            + constraintToGcsTag_.size() * kGcsBytesPerConstraint
+            + (parameters_.size() + drivenParameters_.size()) * kGcsBytesPerParameter;
+    }
+    return bytes;
+}
+
 void ConstraintSolver::solveAsync(std::function<void(SolverResult)> callback) {
     if (solving_) {
         return;
@@ -591,14 +629,18 @@ void ConstraintSolver::restoreParameters() {
         switch (backup.type) {
             case EntityType::Point: {
                 auto it = pointsById_.find(backup.entityId);
-                if (it != pointsById_.end() && it->second && backup.values.size() >= 2) {
+                if (it != pointsById_.end() && it->second && backup.values.size() >= 2 &&
+                    (it->second->x() != backup.values[0] || it->second->y() != backup.values[1])) {
                     it->second->setPosition(backup.values[0], backup.values[1]);
                 }
                 break;
             }
             case EntityType::Arc: {
                 auto it = arcsById_.find(backup.entityId);
-                if (it != arcsById_.end() && it->second && backup.values.size() >= 3) {
+                if (it != arcsById_.end() && it->second && backup.values.size() >= 3 &&
+                    (it->second->radius() != backup.values[0] ||
+                     it->second->startAngle() != backup.values[1] ||
+                     it->second->endAngle() != backup.values[2])) {
                     it->second->setRadius(backup.values[0]);
                     it->second->setStartAngle(backup.values[1]);
                     it->second->setEndAngle(backup.values[2]);
@@ -607,7 +649,8 @@ void ConstraintSolver::restoreParameters() {
             }
             case EntityType::Circle: {
                 auto it = circlesById_.find(backup.entityId);
-                if (it != circlesById_.end() && it->second && !backup.values.empty()) {
+                if (it != circlesById_.end() && it->second && !backup.values.empty() &&
+                    it->second->radius() != backup.values[0]) {
                     it->second->setRadius(backup.values[0]);
                 }
                 break;
@@ -618,6 +661,41 @@ void ConstraintSolver::restoreParameters() {
     }
 }
 
+void ConstraintSolver::collectMovedEntities(SolverResult& result) const {
+    result.movedEntities.clear();
+    for (const auto& backup : parameterBackup_) {
+        std::vector<double> current;
+        switch (backup.type) {
+            case EntityType::Point: {
+                auto it = pointsById_.find(backup.entityId);
+                if (it != pointsById_.end() && it->second) {
+                    current = {it->second->x(), it->second->y()};
+                }
+                break;
+            }
+            case EntityType::Arc: {
+                auto it = arcsById_.find(backup.entityId);
+                if (it != arcsById_.end() && it->second) {
+                    current = {it->second->radius(), it->second->startAngle(), it->second->endAngle()};
+                }
+                break;
+            }
+            case EntityType::Circle: {
+                auto it = circlesById_.find(backup.entityId);
+                if (it != circlesById_.end() && it->second) {
+                    current = {it->second->radius()};
+                }
+                break;
+            }
+            default:
+                break;
+        }
+        if (!current.empty() && current != backup.values) {
+            result.movedEntities.push_back(backup.entityId);
+        }
+    }
+}
+
 bool ConstraintSolver::translateConstraint(SketchConstraint* constraint, int tagId) {
     if (!constraint || !gcsSystem_) {
         return false;
@@ -113,6 +113,9 @@ struct SolverResult {
     /// IDs of conflicting constraints
     std::vector<ConstraintID> conflictingConstraints;
 
+    /// Entities whose parameters differ from their pre-solve values
+    std::vector<EntityID> movedEntities;
+
     /// Human-readable error message
     std::string errorMessage;
 };
@@ -304,6 +307,14 @@ public:
      */
     bool isSolvable() const;
 
+    /**
+     * @brief Approximate bytes held by the solver
+     *
+     * Covers the id maps, parameter bindings and backup, plus an estimate
+     * of the PlaneGCS system based on its constraint and parameter counts.
+     */
+    std::size_t memoryBytes() const;
+
     // ========== Threading Support ==========
 
     /**
@@ -377,9 +388,17 @@ private:
 
     /**
      * @brief Restore parameters from backup
+     *
+     * Only entities whose values differ from the backup are written, so
+     * geometry change notifications stay proportional to what moved.
      */
     void restoreParameters();
 
+    /**
+     * @brief Fill result.movedEntities by diffing current values against the backup
+     */
+    void collectMovedEntities(SolverResult& result) const;
+
     /**
      * @brief Translate OneCAD constraint to PlaneGCS constraint
      */
@@ -393,6 +393,15 @@ void SketchToolManager::handleMouseRelease(const Vec2d& pos, Qt::MouseButton but
 
     activeTool_->onMouseRelease(snappedPos, button);
     currentInferredConstraints_ = activeTool_->inferredConstraints();
+
+    // Trim applies the segments collected during a drag on release
+    if (auto* trimTool = dynamic_cast<TrimTool*>(activeTool_.get())) {
+        if (trimTool->wasEntityDeleted()) {
+            trimTool->clearDeletedFlag();
+            qCDebug(logSketchToolMgr) << "mouseRelease:geometryCreated";
+            emit geometryCreated();
+        }
+    }
     emit updateRequested();
 }
 
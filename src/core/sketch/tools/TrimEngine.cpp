@@ -0,0 +1,467 @@
+/**
+ * @file TrimEngine.cpp
+ * @brief Implementation of cached trim segment lookup and removal
+ */
+
+#include "TrimEngine.h"
+#include "../Sketch.h"
+#include "../SketchArc.h"
+#include "../SketchCircle.h"
+#include "../SketchEllipse.h"
+#include "../SketchIntersectionIndex.h"
+#include "../SketchLine.h"
+#include "../SketchPoint.h"
+
+#include <QLoggingCategory>
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+
+namespace onecad::core::sketch::tools {
+
+Q_LOGGING_CATEGORY(logTrimEngine, "onecad.core.sketch.trim")
+
+namespace {
+
+constexpr double kTwoPi = 2.0 * std::numbers::pi;
+
+double normalizeAnglePositive(double angle) {
+    angle = std::fmod(angle, kTwoPi);
+    if (angle < 0.0) {
+        angle += kTwoPi;
+    }
+    return angle;
+}
+
+Vec2d toVec2d(const gp_Pnt2d& p) {
+    return {p.X(), p.Y()};
+}
+
+double angleOf(const Vec2d& center, const Vec2d& p) {
+    return std::atan2(p.y - center.y, p.x - center.x);
+}
+
+// Sorted, with values closer than tolerance collapsed
+void sortUnique(std::vector<double>& values, double tolerance) {
+    std::sort(values.begin(), values.end());
+    std::vector<double> unique;
+    unique.reserve(values.size());
+    for (double v : values) {
+        if (unique.empty() || v - unique.back() > tolerance) {
+            unique.push_back(v);
+        }
+    }
+    values = std::move(unique);
+}
+
+// Existing point at position, or a new one
+EntityID pointAt(Sketch& sketch, const Vec2d& position, bool construction) {
+    for (const auto& id : sketch.spatialIndex().queryRadius(position, constants::COINCIDENCE_TOLERANCE)) {
+        if (const auto* point = sketch.getEntityAs<SketchPoint>(id)) {
+            const gp_Pnt2d p = point->position();
+            if (std::hypot(p.X() - position.x, p.Y() - position.y) <= constants::COINCIDENCE_TOLERANCE) {
+                return id;
+            }
+        }
+    }
+    return sketch.addPoint(position.x, position.y, construction);
+}
+
+} // namespace
+
+void TrimEngine::clear() {
+    sketchInstance_ = 0;
+    revision_ = 0;
+    cuts_.clear();
+}
+
+void TrimEngine::syncRevision(const Sketch& sketch) {
+    const uint64_t revision = sketch.geometryRevision();
+    if (sketchInstance_ == sketch.geometryInstanceId() && revision_ == revision) {
+        return;
+    }
+    sketchInstance_ = sketch.geometryInstanceId();
+    revision_ = revision;
+    cuts_.clear();
+}
+
+const TrimEngine::CurveCuts* TrimEngine::cutsFor(const Sketch& sketch, const SketchEntity& entity) {
+    auto cached = cuts_.find(entity.id());
+    if (cached != cuts_.end()) {
+        return &cached->second;
+    }
+
+    CurveCuts cuts;
+    std::vector<Vec2d> crossings;
+    for (const auto* point : sketch.intersectionIndex().pointsOf(entity.id())) {
+        crossings.push_back(point->position);
+    }
+
+    if (entity.type() == EntityType::Line) {
+        const auto& line = static_cast<const SketchLine&>(entity);
+        const auto* startPt = sketch.getEntityAs<SketchPoint>(line.startPointId());
+        const auto* endPt = sketch.getEntityAs<SketchPoint>(line.endPointId());
+        if (!startPt || !endPt) {
+            return nullptr;
+        }
+        const Vec2d p1 = toVec2d(startPt->position());
+        const Vec2d p2 = toVec2d(endPt->position());
+        const double dx = p2.x - p1.x;
+        const double dy = p2.y - p1.y;
+        const double lenSq = dx * dx + dy * dy;
+        if (lenSq < 1e-10) {
+            return nullptr;
+        }
+        cuts.paramTolerance = constants::COINCIDENCE_TOLERANCE / std::sqrt(lenSq);
+        for (const auto& c : crossings) {
+            const double t = ((c.x - p1.x) * dx + (c.y - p1.y) * dy) / lenSq;
+            if (t > cuts.paramTolerance && t < 1.0 - cuts.paramTolerance) {
+                cuts.params.push_back(t);
+            }
+        }
+    } else if (entity.type() == EntityType::Arc || entity.type() == EntityType::Circle) {
+        const bool isArc = entity.type() == EntityType::Arc;
+        const EntityID centerId = isArc ? static_cast<const SketchArc&>(entity).centerPointId()
+                                        : static_cast<const SketchCircle&>(entity).centerPointId();
+        const double radius = isArc ? static_cast<const SketchArc&>(entity).radius()
+                                    : static_cast<const SketchCircle&>(entity).radius();
+        const auto* centerPt = sketch.getEntityAs<SketchPoint>(centerId);
+        if (!centerPt || radius <= constants::COINCIDENCE_TOLERANCE) {
+            return nullptr;
+        }
+        const Vec2d center = toVec2d(centerPt->position());
+        cuts.paramTolerance = constants::COINCIDENCE_TOLERANCE / radius;
+
+        if (isArc) {
+            const auto& arc = static_cast<const SketchArc&>(entity);
+            cuts.domainOrigin = arc.startAngle();
+            cuts.domainLength = arc.sweepAngle();
+            for (const auto& c : crossings) {
+                const double offset = normalizeAnglePositive(angleOf(center, c) - cuts.domainOrigin);
+                if (offset > cuts.paramTolerance && offset < cuts.domainLength - cuts.paramTolerance) {
+                    cuts.params.push_back(offset);
+                }
+            }
+        } else {
+            // The domain starts at the first cut; a circle needs two cuts to have a segment
+            std::vector<double> angles;
+            for (const auto& c : crossings) {
+                angles.push_back(normalizeAnglePositive(angleOf(center, c)));
+            }
+            sortUnique(angles, cuts.paramTolerance);
+            if (angles.size() > 1 && angles.back() - angles.front() > kTwoPi - cuts.paramTolerance) {
+                angles.pop_back();
+            }
+            cuts.domainLength = kTwoPi;
+            if (angles.size() >= 2) {
+                cuts.domainOrigin = angles.front();
+                for (size_t i = 1; i < angles.size(); ++i) {
+                    cuts.params.push_back(angles[i] - cuts.domainOrigin);
+                }
+            }
+        }
+    }
+
+    sortUnique(cuts.params, cuts.paramTolerance);
+    auto [it, inserted] = cuts_.emplace(entity.id(), std::move(cuts));
+    return &it->second;
+}
+
+bool TrimEngine::isPicked(const Sketch& sketch, const SketchEntity& entity, const Vec2d& pos,
+                          double tolerance) const {
+    const gp_Pnt2d testPoint(pos.x, pos.y);
+
+    if (entity.type() == EntityType::Line) {
+        const auto& line = static_cast<const SketchLine&>(entity);
+        const auto* startPt = sketch.getEntityAs<SketchPoint>(line.startPointId());
+        const auto* endPt = sketch.getEntityAs<SketchPoint>(line.endPointId());
+        if (!startPt || !endPt) {
+            return false;
+        }
+        const gp_Pnt2d p1 = startPt->position();
+        const gp_Pnt2d p2 = endPt->position();
+
+        // Point-to-line-segment distance
+        const double dx = p2.X() - p1.X();
+        const double dy = p2.Y() - p1.Y();
+        const double lenSq = dx * dx + dy * dy;
+        if (lenSq <= 1e-10) {
+            return false;
+        }
+        double t = ((testPoint.X() - p1.X()) * dx + (testPoint.Y() - p1.Y()) * dy) / lenSq;
+        t = std::max(0.0, std::min(1.0, t));
+        const double closestX = p1.X() + t * dx;
+        const double closestY = p1.Y() + t * dy;
+        const double dist = std::sqrt((testPoint.X() - closestX) * (testPoint.X() - closestX) +
+                                      (testPoint.Y() - closestY) * (testPoint.Y() - closestY));
+        return dist < tolerance;
+    }
+    if (entity.type() == EntityType::Arc) {
+        const auto& arc = static_cast<const SketchArc&>(entity);
+        const auto* centerPt = sketch.getEntityAs<SketchPoint>(arc.centerPointId());
+        return centerPt && arc.isNearWithCenter(testPoint, centerPt->position(), tolerance);
+    }
+    if (entity.type() == EntityType::Circle) {
+        const auto& circle = static_cast<const SketchCircle&>(entity);
+        const auto* centerPt = sketch.getEntityAs<SketchPoint>(circle.centerPointId());
+        return centerPt && circle.isNearWithCenter(testPoint, centerPt->position(), tolerance);
+    }
+    if (entity.type() == EntityType::Ellipse) {
+        const auto& ellipse = static_cast<const SketchEllipse&>(entity);
+        const auto* centerPt = sketch.getEntityAs<SketchPoint>(ellipse.centerPointId());
+        return centerPt && ellipse.isNearWithCenter(testPoint, centerPt->position(), tolerance);
+    }
+    return false;
+}
+
+std::optional<double> TrimEngine::paramAt(const Sketch& sketch, const SketchEntity& entity,
+                                          const CurveCuts& cuts, const Vec2d& pos) const {
+    if (entity.type() == EntityType::Line) {
+        const auto& line = static_cast<const SketchLine&>(entity);
+        const auto* startPt = sketch.getEntityAs<SketchPoint>(line.startPointId());
+        const auto* endPt = sketch.getEntityAs<SketchPoint>(line.endPointId());
+        if (!startPt || !endPt) {
+            return std::nullopt;
+        }
+        const Vec2d p1 = toVec2d(startPt->position());
+        const Vec2d p2 = toVec2d(endPt->position());
+        const double dx = p2.x - p1.x;
+        const double dy = p2.y - p1.y;
+        const double lenSq = dx * dx + dy * dy;
+        const double t = ((pos.x - p1.x) * dx + (pos.y - p1.y) * dy) / lenSq;
+        return std::clamp(t, 0.0, 1.0);
+    }
+
+    EntityID centerId;
+    if (entity.type() == EntityType::Arc) {
+        centerId = static_cast<const SketchArc&>(entity).centerPointId();
+    } else if (entity.type() == EntityType::Circle) {
+        centerId = static_cast<const SketchCircle&>(entity).centerPointId();
+    } else {
+        return std::nullopt;
+    }
+    const auto* centerPt = sketch.getEntityAs<SketchPoint>(centerId);
+    if (!centerPt) {
+        return std::nullopt;
+    }
+    double offset = normalizeAnglePositive(angleOf(toVec2d(centerPt->position()), pos) - cuts.domainOrigin);
+    if (offset > cuts.domainLength) {
+        // Beyond an arc's end: snap to the nearer end
+        offset = (offset - cuts.domainLength < kTwoPi - offset) ? cuts.domainLength : 0.0;
+    }
+    return offset;
+}
+
+std::optional<TrimSegment> TrimEngine::segmentAt(const Sketch& sketch, const Vec2d& pos, double tolerance) {
+    syncRevision(sketch);
+
+    // Bounds of every curve within tolerance overlap the query square; ids come in sketch order
+    for (const auto& id : sketch.spatialIndex().queryRadius(pos, tolerance)) {
+        const SketchEntity* entity = sketch.getEntity(id);
+        if (!entity || entity->type() == EntityType::Point) {
+            continue;
+        }
+        if (!isPicked(sketch, *entity, pos, tolerance)) {
+            continue;
+        }
+
+        TrimSegment segment;
+        segment.entityId = id;
+        segment.type = entity->type();
+        segment.pickPosition = pos;
+        segment.revision = revision_;
+
+        const CurveCuts* cuts = cutsFor(sketch, *entity);
+        if (!cuts || cuts->params.empty()) {
+            segment.endParam = cuts ? cuts->domainLength : 0.0;
+            return segment;
+        }
+        const std::optional<double> param = paramAt(sketch, *entity, *cuts, pos);
+        if (!param) {
+            segment.endParam = cuts->domainLength;
+            return segment;
+        }
+
+        auto upper = std::upper_bound(cuts->params.begin(), cuts->params.end(), *param);
+        segment.startParam = upper == cuts->params.begin() ? 0.0 : *(upper - 1);
+        segment.endParam = upper == cuts->params.end() ? cuts->domainLength : *upper;
+        segment.wholeEntity = false;
+        return segment;
+    }
+    return std::nullopt;
+}
+
+std::optional<TrimSegmentGeometry> TrimEngine::segmentGeometry(const Sketch& sketch, const TrimSegment& segment) {
+    syncRevision(sketch);
+    if (segment.wholeEntity || segment.revision != revision_) {
+        return std::nullopt;
+    }
+    const SketchEntity* entity = sketch.getEntity(segment.entityId);
+    if (!entity) {
+        return std::nullopt;
+    }
+    const CurveCuts* cuts = cutsFor(sketch, *entity);
+    if (!cuts) {
+        return std::nullopt;
+    }
+
+    TrimSegmentGeometry geometry;
+    if (const auto* line = dynamic_cast<const SketchLine*>(entity)) {
+        const auto* startPt = sketch.getEntityAs<SketchPoint>(line->startPointId());
+        const auto* endPt = sketch.getEntityAs<SketchPoint>(line->endPointId());
+        if (!startPt || !endPt) {
+            return std::nullopt;
+        }
+        const Vec2d p1 = toVec2d(startPt->position());
+        const Vec2d p2 = toVec2d(endPt->position());
+        geometry.start = {p1.x + segment.startParam * (p2.x - p1.x), p1.y + segment.startParam * (p2.y - p1.y)};
+        geometry.end = {p1.x + segment.endParam * (p2.x - p1.x), p1.y + segment.endParam * (p2.y - p1.y)};
+        return geometry;
+    }
+
+    const SketchPoint* centerPt = nullptr;
+    if (const auto* arc = dynamic_cast<const SketchArc*>(entity)) {
+        centerPt = sketch.getEntityAs<SketchPoint>(arc->centerPointId());
+        geometry.radius = arc->radius();
+    } else if (const auto* circle = dynamic_cast<const SketchCircle*>(entity)) {
+        centerPt = sketch.getEntityAs<SketchPoint>(circle->centerPointId());
+        geometry.radius = circle->radius();
+    }
+    if (!centerPt) {
+        return std::nullopt;
+    }
+    geometry.isLine = false;
+    geometry.center = toVec2d(centerPt->position());
+    geometry.startAngle = cuts->domainOrigin + segment.startParam;
+    geometry.endAngle = cuts->domainOrigin + segment.endParam;
+    return geometry;
+}
+
+size_t TrimEngine::trim(Sketch& sketch, std::vector<TrimSegment> segments, double tolerance) {
+    syncRevision(sketch);
+
+    struct Pending {
+        CurveCuts cuts;
+        std::vector<std::pair<double, double>> removed;
+        bool wholeEntity = false;
+    };
+    std::vector<EntityID> order;
+    std::unordered_map<EntityID, Pending> pending;
+
+    for (auto& segment : segments) {
+        if (segment.revision != revision_) {
+            auto refreshed = segmentAt(sketch, segment.pickPosition, tolerance);
+            if (!refreshed) {
+                continue;
+            }
+            segment = *refreshed;
+        }
+        const SketchEntity* entity = sketch.getEntity(segment.entityId);
+        if (!entity || entity->isReferenceLocked()) {
+            continue;
+        }
+        const CurveCuts* cuts = cutsFor(sketch, *entity);
+
+        auto [it, inserted] = pending.try_emplace(segment.entityId);
+        if (inserted) {
+            order.push_back(segment.entityId);
+            if (cuts) {
+                it->second.cuts = *cuts;
+            }
+        }
+        if (segment.wholeEntity || !cuts) {
+            it->second.wholeEntity = true;
+        } else {
+            it->second.removed.emplace_back(segment.startParam, segment.endParam);
+        }
+    }
+
+    if (order.empty()) {
+        return 0;
+    }
+
+    // One storage compaction (and one solver rebuild on next solve) for the whole gesture
+    size_t trimmed = 0;
+    sketch.beginEditBatch();
+    for (const auto& entityId : order) {
+        Pending& entry = pending[entityId];
+        if (trimEntity(sketch, entityId, entry.cuts, std::move(entry.removed), entry.wholeEntity)) {
+            ++trimmed;
+        }
+    }
+    sketch.endEditBatch();
+
+    qCDebug(logTrimEngine) << "trim:done" << "segments=" << segments.size() << "curves=" << trimmed;
+    return trimmed;
+}
+
+bool TrimEngine::trimEntity(Sketch& sketch, const EntityID& entityId, const CurveCuts& cuts,
+                            std::vector<std::pair<double, double>> removed, bool wholeEntity) {
+    SketchEntity* entity = sketch.getEntity(entityId);
+    if (!entity || entity->type() == EntityType::Point) {
+        return false;
+    }
+    if (wholeEntity || entity->type() == EntityType::Ellipse) {
+        return sketch.removeEntity(entityId);
+    }
+
+    // Kept pieces are the complement of the merged removed spans
+    const double eps = cuts.paramTolerance;
+    std::sort(removed.begin(), removed.end());
+    std::vector<std::pair<double, double>> kept;
+    double cursor = 0.0;
+    for (const auto& [start, end] : removed) {
+        if (start - cursor > eps) {
+            kept.emplace_back(cursor, start);
+        }
+        cursor = std::max(cursor, end);
+    }
+    if (cuts.domainLength - cursor > eps) {
+        kept.emplace_back(cursor, cuts.domainLength);
+    }
+    if (kept.empty()) {
+        return sketch.removeEntity(entityId);
+    }
+
+    const bool construction = entity->isConstruction();
+    // Pieces are added before the original is removed, so shared points are not orphaned
+    if (auto* line = dynamic_cast<SketchLine*>(entity)) {
+        const EntityID startId = line->startPointId();
+        const EntityID endId = line->endPointId();
+        const auto* startPt = sketch.getEntityAs<SketchPoint>(startId);
+        const auto* endPt = sketch.getEntityAs<SketchPoint>(endId);
+        if (!startPt || !endPt) {
+            return false;
+        }
+        const Vec2d p1 = toVec2d(startPt->position());
+        const Vec2d p2 = toVec2d(endPt->position());
+        auto at = [&](double t) {
+            return Vec2d{p1.x + t * (p2.x - p1.x), p1.y + t * (p2.y - p1.y)};
+        };
+        for (const auto& [start, end] : kept) {
+            const EntityID a = start <= eps ? startId : pointAt(sketch, at(start), construction);
+            const EntityID b = end >= 1.0 - eps ? endId : pointAt(sketch, at(end), construction);
+            sketch.addLine(a, b, construction);
+        }
+    } else {
+        EntityID centerId;
+        double radius = 0.0;
+        if (const auto* arc = dynamic_cast<const SketchArc*>(entity)) {
+            centerId = arc->centerPointId();
+            radius = arc->radius();
+        } else if (const auto* circle = dynamic_cast<const SketchCircle*>(entity)) {
+            centerId = circle->centerPointId();
+            radius = circle->radius();
+        } else {
+            return false;
+        }
+        for (const auto& [start, end] : kept) {
+            sketch.addArc(centerId, radius, cuts.domainOrigin + start, cuts.domainOrigin + end, construction);
+        }
+    }
+
+    return sketch.removeEntity(entityId);
+}
+
+} // namespace onecad::core::sketch::tools
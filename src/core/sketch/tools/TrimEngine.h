@@ -0,0 +1,125 @@
+/**
+ * @file TrimEngine.h
+ * @brief Segment lookup and removal for the trim tool
+ *
+ * Each curve is cut at its intersections with other curves, taken from the
+ * sketch's maintained SketchIntersectionIndex. The sorted cut parameters of a
+ * curve are computed once per geometry revision, so finding the segment under
+ * the cursor is a binary search. Several segments (one drag gesture) are
+ * removed in a single sketch edit batch.
+ */
+
+#ifndef ONECAD_CORE_SKETCH_TOOLS_TRIMENGINE_H
+#define ONECAD_CORE_SKETCH_TOOLS_TRIMENGINE_H
+
+#include "../SketchTypes.h"
+
+#include <cstdint>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+namespace onecad::core::sketch {
+class Sketch;
+class SketchEntity;
+}
+
+namespace onecad::core::sketch::tools {
+
+/**
+ * @brief Portion of a curve between two adjacent cuts
+ *
+ * Parameters are measured along the curve's trim domain [0, domainLength]:
+ * - Line: t in [0, 1] from start to end point
+ * - Arc: angle offset from startAngle, in [0, sweep]
+ * - Circle: angle offset from the first cut, in [0, 2π]
+ */
+struct TrimSegment {
+    EntityID entityId;
+    EntityType type = EntityType::Line;
+    double startParam = 0.0;
+    double endParam = 0.0;
+    bool wholeEntity = true;  ///< No cuts bound this segment; trimming deletes the entity
+    Vec2d pickPosition{0.0, 0.0};
+    uint64_t revision = 0;    ///< Sketch geometry revision the parameters refer to
+
+    bool sameSpan(const TrimSegment& other) const {
+        return entityId == other.entityId && startParam == other.startParam &&
+               endParam == other.endParam;
+    }
+};
+
+/**
+ * @brief Sketch-space shape of a segment (line or arc), for preview
+ */
+struct TrimSegmentGeometry {
+    bool isLine = true;
+    Vec2d start{0.0, 0.0};
+    Vec2d end{0.0, 0.0};
+    Vec2d center{0.0, 0.0};
+    double radius = 0.0;
+    double startAngle = 0.0;
+    double endAngle = 0.0;
+};
+
+/**
+ * @brief Cached intersection-parameter trim engine
+ */
+class TrimEngine {
+public:
+    /**
+     * @brief Segment of the first curve (sketch order) within tolerance of pos
+     */
+    std::optional<TrimSegment> segmentAt(const Sketch& sketch, const Vec2d& pos, double tolerance);
+
+    /**
+     * @brief Remove segments from their curves in one edit batch
+     *
+     * Segments found at an older geometry revision are re-resolved from their
+     * pick positions first. Remaining pieces of each curve are recreated and
+     * the original curve removed.
+     *
+     * @return Number of curves that were trimmed or deleted
+     */
+    size_t trim(Sketch& sketch, std::vector<TrimSegment> segments, double tolerance);
+
+    /**
+     * @brief Shape of a partial line/arc/circle segment (nullopt for whole or stale segments)
+     */
+    std::optional<TrimSegmentGeometry> segmentGeometry(const Sketch& sketch, const TrimSegment& segment);
+
+    /**
+     * @brief Drop cached cuts
+     */
+    void clear();
+
+    /**
+     * @brief Geometry revision the cached cuts belong to
+     */
+    uint64_t revision() const { return revision_; }
+
+private:
+    struct CurveCuts {
+        double domainOrigin = 0.0;   ///< Circle: angle of the first cut
+        double domainLength = 1.0;
+        double paramTolerance = 0.0; ///< COINCIDENCE_TOLERANCE in parameter units
+        std::vector<double> params;  ///< Interior cuts, ascending
+    };
+
+    uint64_t sketchInstance_ = 0;  ///< Sketch::geometryInstanceId() of the cached cuts
+    uint64_t revision_ = 0;
+    std::unordered_map<EntityID, CurveCuts> cuts_;
+
+    void syncRevision(const Sketch& sketch);
+    const CurveCuts* cutsFor(const Sketch& sketch, const SketchEntity& entity);
+    bool isPicked(const Sketch& sketch, const SketchEntity& entity, const Vec2d& pos,
+                  double tolerance) const;
+    std::optional<double> paramAt(const Sketch& sketch, const SketchEntity& entity,
+                                  const CurveCuts& cuts, const Vec2d& pos) const;
+    bool trimEntity(Sketch& sketch, const EntityID& entityId, const CurveCuts& cuts,
+                    std::vector<std::pair<double, double>> removed, bool wholeEntity);
+};
+
+} // namespace onecad::core::sketch::tools
+
+#endif // ONECAD_CORE_SKETCH_TOOLS_TRIMENGINE_H
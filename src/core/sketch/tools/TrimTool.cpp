@@ -1,22 +1,11 @@
 #include "TrimTool.h"
 #include "../Sketch.h"
 #include "../SketchRenderer.h"
-#include "../SketchEntity.h"
-#include "../SketchLine.h"
-#include "../SketchArc.h"
-#include "../SketchCircle.h"
-#include "../SketchEllipse.h"
-#include "../SketchPoint.h"
-
-#include <gp_Pnt2d.hxx>
-
-#include <algorithm>
-#include <cmath>
 
 namespace onecad::core::sketch::tools {
 
 TrimTool::TrimTool() {
-    // Trim tool is always in Idle state, ready to click
+    // Idle until a press starts a trim gesture
     state_ = State::Idle;
 }
 
@@ -31,29 +20,39 @@ void TrimTool::onMousePress(const Vec2d& pos, Qt::MouseButton button) {
     }
 
     entityDeleted_ = false;
+    pendingSegments_.clear();
+    state_ = State::Drawing;
 
-    // Find and delete entity at click position
-    EntityID entityId = findEntityAtPosition(pos);
-
-    if (!entityId.empty()) {
-        // Don't delete points directly - they may be referenced
-        auto* entity = sketch_->getEntity(entityId);
-        if (entity && entity->type() != EntityType::Point) {
-            if (sketch_->removeEntity(entityId)) {
-                entityDeleted_ = true;
-                hoverEntityId_.clear();
-            }
-        }
+    hoverSegment_ = engine_.segmentAt(*sketch_, pos, PICK_TOLERANCE);
+    if (hoverSegment_) {
+        collectSegment(*hoverSegment_);
     }
 }
 
 void TrimTool::onMouseMove(const Vec2d& pos) {
-    // Update hover entity for visual feedback
-    hoverEntityId_ = findEntityAtPosition(pos);
+    if (!sketch_) {
+        hoverSegment_.reset();
+        return;
+    }
+
+    // Cut parameters are cached per geometry revision; this is a binary search per candidate
+    hoverSegment_ = engine_.segmentAt(*sketch_, pos, PICK_TOLERANCE);
+    if (state_ == State::Drawing && hoverSegment_) {
+        collectSegment(*hoverSegment_);
+    }
 }
 
-void TrimTool::onMouseRelease(const Vec2d& /*pos*/, Qt::MouseButton /*button*/) {
-    // Nothing on release
+void TrimTool::onMouseRelease(const Vec2d& pos, Qt::MouseButton button) {
+    if (button != Qt::LeftButton || state_ != State::Drawing || !sketch_) {
+        return;
+    }
+
+    state_ = State::Idle;
+    if (!pendingSegments_.empty()) {
+        entityDeleted_ = engine_.trim(*sketch_, std::move(pendingSegments_), PICK_TOLERANCE) > 0;
+        pendingSegments_.clear();
+    }
+    hoverSegment_ = engine_.segmentAt(*sketch_, pos, PICK_TOLERANCE);
 }
 
 void TrimTool::onKeyPress(Qt::Key key) {
@@ -63,97 +62,40 @@ void TrimTool::onKeyPress(Qt::Key key) {
 }
 
 void TrimTool::cancel() {
-    hoverEntityId_.clear();
+    state_ = State::Idle;
+    hoverSegment_.reset();
+    pendingSegments_.clear();
+    engine_.clear();
     entityDeleted_ = false;
 }
 
 void TrimTool::render(SketchRenderer& renderer) {
-    // Highlight the entity that will be deleted on click
-    if (!hoverEntityId_.empty()) {
-        renderer.setHoverEntity(hoverEntityId_);
-    } else {
-        renderer.setHoverEntity({});
-    }
     renderer.clearPreview();
     renderer.clearPreviewDimensions();
-}
-
-EntityID TrimTool::findEntityAtPosition(const Vec2d& pos) const {
-    if (!sketch_) {
-        return {};
+    renderer.setHoverEntity({});
+    if (!hoverSegment_ || !sketch_) {
+        return;
     }
 
-    constexpr double PICK_TOLERANCE = 3.0;  // mm
-    gp_Pnt2d testPoint(pos.x, pos.y);
-
-    // Search through entities (skip points, we only trim lines/arcs/circles)
-    for (const auto& entity : sketch_->getAllEntities()) {
-        if (entity->type() == EntityType::Point) {
-            continue;
-        }
+    // Partial segments are drawn as preview geometry; whole curves use entity hover
+    auto geometry = engine_.segmentGeometry(*sketch_, *hoverSegment_);
+    if (!geometry) {
+        renderer.setHoverEntity(hoverSegment_->entityId);
+    } else if (geometry->isLine) {
+        renderer.setPreviewLine(geometry->start, geometry->end);
+    } else {
+        renderer.setPreviewArc(geometry->center, geometry->radius,
+                               geometry->startAngle, geometry->endAngle);
+    }
+}
 
-        // For lines, check directly
-        if (entity->type() == EntityType::Line) {
-            auto* line = static_cast<const SketchLine*>(entity.get());
-            auto* startPt = sketch_->getEntityAs<SketchPoint>(line->startPointId());
-            auto* endPt = sketch_->getEntityAs<SketchPoint>(line->endPointId());
-
-            if (startPt && endPt) {
-                gp_Pnt2d p1 = startPt->position();
-                gp_Pnt2d p2 = endPt->position();
-
-                // Point-to-line-segment distance
-                double dx = p2.X() - p1.X();
-                double dy = p2.Y() - p1.Y();
-                double lenSq = dx * dx + dy * dy;
-
-                if (lenSq > 1e-10) {
-                    double t = ((testPoint.X() - p1.X()) * dx +
-                                (testPoint.Y() - p1.Y()) * dy) / lenSq;
-                    t = std::max(0.0, std::min(1.0, t));
-
-                    double closestX = p1.X() + t * dx;
-                    double closestY = p1.Y() + t * dy;
-                    double dist = std::sqrt((testPoint.X() - closestX) * (testPoint.X() - closestX) +
-                                            (testPoint.Y() - closestY) * (testPoint.Y() - closestY));
-
-                    if (dist < PICK_TOLERANCE) {
-                        return entity->id();
-                    }
-                }
-            }
-        }
-        // For arcs and circles, use isNear if center point is available
-        else if (entity->type() == EntityType::Arc) {
-            auto* arc = static_cast<const SketchArc*>(entity.get());
-            auto* centerPt = sketch_->getEntityAs<SketchPoint>(arc->centerPointId());
-            if (centerPt) {
-                if (arc->isNearWithCenter(testPoint, centerPt->position(), PICK_TOLERANCE)) {
-                    return entity->id();
-                }
-            }
-        }
-        else if (entity->type() == EntityType::Circle) {
-            auto* circle = static_cast<const SketchCircle*>(entity.get());
-            auto* centerPt = sketch_->getEntityAs<SketchPoint>(circle->centerPointId());
-            if (centerPt) {
-                if (circle->isNearWithCenter(testPoint, centerPt->position(), PICK_TOLERANCE)) {
-                    return entity->id();
-                }
-            }
-        }
-        else if (entity->type() == EntityType::Ellipse) {
-            auto* ellipse = static_cast<const SketchEllipse*>(entity.get());
-            auto* centerPt = sketch_->getEntityAs<SketchPoint>(ellipse->centerPointId());
-            if (centerPt) {
-                if (ellipse->isNearWithCenter(testPoint, centerPt->position(), PICK_TOLERANCE)) {
-                    return entity->id();
-                }
-            }
+void TrimTool::collectSegment(const TrimSegment& segment) {
+    for (const auto& existing : pendingSegments_) {
+        if (existing.sameSpan(segment)) {
+            return;
         }
     }
-
-    return {};
+    pendingSegments_.push_back(segment);
 }
 
 } // namespace onecad::core::sketch::tools
@@ -11,20 +11,25 @@
 #define ONECAD_CORE_SKETCH_TOOLS_TRIMTOOL_H
 
 #include "SketchTool.h"
+#include "TrimEngine.h"
+
+#include <optional>
+#include <vector>
 
 namespace onecad::core::sketch::tools {
 
 /**
  * @brief Tool for trimming/deleting sketch entities
  *
- * Current implementation: Click to delete entire entity
- * Future: Intersection-based segment deletion
+ * Curves are split at their intersections with other curves; the segment
+ * under the cursor is removed and the remaining pieces are kept. Curves
+ * without cuts (and ellipses) are deleted whole.
  *
  * State machine:
- * - Idle: Ready to click entities
- * - Hover preview shows which entity will be deleted
- * - Click deletes the entity
- * - ESC exits trim mode
+ * - Idle: Hover preview shows the segment that will be removed
+ * - Drawing: Left button held; segments swept by the cursor are collected
+ * - Release trims all collected segments in one edit
+ * - ESC / right click abandons the gesture
  */
 class TrimTool : public SketchTool {
 public:
@@ -46,12 +51,16 @@ public:
     void clearDeletedFlag() { entityDeleted_ = false; }
 
 private:
+    static constexpr double PICK_TOLERANCE = 3.0;  // mm
+
     /**
-     * @brief Find entity at position using hit testing
+     * @brief Add a segment to the current drag gesture unless already collected
      */
-    EntityID findEntityAtPosition(const Vec2d& pos) const;
+    void collectSegment(const TrimSegment& segment);
 
-    EntityID hoverEntityId_{};  // Empty when no hover target
+    TrimEngine engine_;
+    std::optional<TrimSegment> hoverSegment_;
+    std::vector<TrimSegment> pendingSegments_;  // Collected during a drag
     bool entityDeleted_ = false;
 };
 
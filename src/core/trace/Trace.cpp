@@ -0,0 +1,246 @@
+/**
+ * @file Trace.cpp
+ * @brief Per-thread trace buffers and Chrome trace JSON writer
+ */
+#include "Trace.h"
+
+#include <QCoreApplication>
+#include <QFile>
+#include <QLoggingCategory>
+#include <QThread>
+
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace onecad::core::trace {
+
+namespace detail {
+std::atomic<bool> gEnabled{false};
+} // namespace detail
+
+namespace {
+
+Q_LOGGING_CATEGORY(logTrace, "onecad.core.trace")
+
+// Bounds memory for sessions left running; later events are counted only
+constexpr size_t kMaxEventsPerThread = 1u << 20;
+
+struct Event {
+    const char* category;
+    const char* name;
+    int64_t startUs;
+    int64_t durationUs;
+    const char* argKey;
+    std::string argValue;
+};
+
+/**
+ * @brief Events of one thread
+ *
+ * The mutex is only contended while stop() collects the buffer, so
+ * recording an event normally costs an uncontended lock and a push_back.
+ */
+struct ThreadBuffer {
+    std::mutex mutex;
+    std::vector<Event> events;
+    size_t dropped = 0;
+    int tid = 0;
+    std::string name;
+};
+
+std::mutex gBuffersMutex;  // Guards gBuffers and gNextTid
+std::vector<std::shared_ptr<ThreadBuffer>> gBuffers;
+int gNextTid = 1;
+const auto gEpoch = std::chrono::steady_clock::now();
+std::atomic<int64_t> gSessionStartUs{0};
+
+std::string defaultThreadName(int tid) {
+    const QCoreApplication* app = QCoreApplication::instance();
+    if (app && QThread::currentThread() == app->thread()) {
+        return "main";
+    }
+    const QString objectName = QThread::currentThread()->objectName();
+    if (!objectName.isEmpty()) {
+        return objectName.toStdString();
+    }
+    return "thread " + std::to_string(tid);
+}
+
+ThreadBuffer& threadBuffer() {
+    // The registry keeps the buffer alive after the thread exits so its
+    // events still make it into the file
+    thread_local std::shared_ptr<ThreadBuffer> buffer = []() {
+        auto created = std::make_shared<ThreadBuffer>();
+        std::lock_guard<std::mutex> lock(gBuffersMutex);
+        created->tid = gNextTid++;
+        created->name = defaultThreadName(created->tid);
+        gBuffers.push_back(created);
+        return created;
+    }();
+    return *buffer;
+}
+
+void appendEscaped(QByteArray& out, const char* text) {
+    for (const char* c = text; *c; ++c) {
+        const unsigned char ch = static_cast<unsigned char>(*c);
+        switch (ch) {
+            case '"': out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\n': out += "\\n"; break;
+            case '\r': out += "\\r"; break;
+            case '\t': out += "\\t"; break;
+            default:
+                if (ch < 0x20) {
+                    char escaped[8];
+                    std::snprintf(escaped, sizeof(escaped), "\\u%04x", ch);
+                    out += escaped;
+                } else {
+                    out += static_cast<char>(ch);
+                }
+        }
+    }
+}
+
+void appendString(QByteArray& out, const char* text) {
+    out += '"';
+    appendEscaped(out, text ? text : "");
+    out += '"';
+}
+
+} // namespace
+
+int64_t Scope::nowUs() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+               std::chrono::steady_clock::now() - gEpoch)
+        .count();
+}
+
+void Scope::finish() {
+    const int64_t endUs = nowUs();
+    ThreadBuffer& buffer = threadBuffer();
+    std::lock_guard<std::mutex> lock(buffer.mutex);
+    if (buffer.events.size() >= kMaxEventsPerThread) {
+        ++buffer.dropped;
+        return;
+    }
+    buffer.events.push_back(Event{category_, name_, startUs_, endUs - startUs_,
+                                  argKey_, std::move(argValue_)});
+}
+
+void start() {
+    {
+        std::lock_guard<std::mutex> lock(gBuffersMutex);
+        for (const auto& buffer : gBuffers) {
+            std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+            buffer->events.clear();
+            buffer->dropped = 0;
+        }
+    }
+    gSessionStartUs.store(Scope::nowUs(), std::memory_order_relaxed);
+    detail::gEnabled.store(true, std::memory_order_release);
+    qCInfo(logTrace) << "Trace session started";
+}
+
+bool stop(const std::string& path) {
+    if (!detail::gEnabled.exchange(false, std::memory_order_acq_rel)) {
+        return false;
+    }
+
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+    {
+        std::lock_guard<std::mutex> lock(gBuffersMutex);
+        buffers = gBuffers;
+    }
+
+    const int64_t sessionStartUs = gSessionStartUs.load(std::memory_order_relaxed);
+    const qint64 pid = QCoreApplication::applicationPid();
+    size_t eventCount = 0;
+    size_t droppedCount = 0;
+
+    QByteArray json;
+    json.reserve(1 << 20);
+    json += "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    bool first = true;
+    auto separator = [&]() {
+        if (!first) {
+            json += ",\n";
+        }
+        first = false;
+    };
+
+    for (const auto& buffer : buffers) {
+        std::vector<Event> events;
+        std::string name;
+        {
+            std::lock_guard<std::mutex> lock(buffer->mutex);
+            events.swap(buffer->events);
+            droppedCount += buffer->dropped;
+            buffer->dropped = 0;
+            name = buffer->name;
+        }
+        if (events.empty()) {
+            continue;
+        }
+        eventCount += events.size();
+
+        separator();
+        json += "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":";
+        json += QByteArray::number(pid);
+        json += ",\"tid\":";
+        json += QByteArray::number(buffer->tid);
+        json += ",\"args\":{\"name\":";
+        appendString(json, name.c_str());
+        json += "}}";
+
+        for (const Event& event : events) {
+            if (event.startUs < sessionStartUs) {
+                continue;  // Scope opened before this session
+            }
+            separator();
+            json += "{\"ph\":\"X\",\"cat\":";
+            appendString(json, event.category);
+            json += ",\"name\":";
+            appendString(json, event.name);
+            json += ",\"pid\":";
+            json += QByteArray::number(pid);
+            json += ",\"tid\":";
+            json += QByteArray::number(buffer->tid);
+            json += ",\"ts\":";
+            json += QByteArray::number(static_cast<qint64>(event.startUs - sessionStartUs));
+            json += ",\"dur\":";
+            json += QByteArray::number(static_cast<qint64>(event.durationUs));
+            if (event.argKey) {
+                json += ",\"args\":{";
+                appendString(json, event.argKey);
+                json += ':';
+                appendString(json, event.argValue.c_str());
+                json += '}';
+            }
+            json += '}';
+        }
+    }
+    json += "\n]}\n";
+
+    QFile file(QString::fromStdString(path));
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate) || file.write(json) != json.size()) {
+        qCWarning(logTrace) << "Failed to write trace file" << QString::fromStdString(path)
+                            << file.errorString();
+        return false;
+    }
+    qCInfo(logTrace) << "Trace session written"
+                     << "path=" << QString::fromStdString(path)
+                     << "events=" << eventCount
+                     << "dropped=" << droppedCount;
+    return true;
+}
+
+void setThreadName(const std::string& name) {
+    ThreadBuffer& buffer = threadBuffer();
+    std::lock_guard<std::mutex> lock(buffer.mutex);
+    buffer.name = name;
+}
+
+} // namespace onecad::core::trace
@@ -0,0 +1,113 @@
+/**
+ * @file Trace.h
+ * @brief Scoped trace events written as Chrome trace / Perfetto JSON
+ *
+ * Instrument a block with ONECAD_TRACE_SCOPE("category", "name"). While no
+ * session is running a scope costs one relaxed atomic load. During a
+ * session each scope records one complete ("X") event into a buffer owned
+ * by its thread; stop() merges the buffers into a JSON file with one lane
+ * per thread, loadable in chrome://tracing or ui.perfetto.dev.
+ */
+#ifndef ONECAD_CORE_TRACE_TRACE_H
+#define ONECAD_CORE_TRACE_TRACE_H
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <utility>
+
+namespace onecad::core::trace {
+
+namespace detail {
+extern std::atomic<bool> gEnabled;
+} // namespace detail
+
+/**
+ * @brief True while a trace session is recording
+ */
+inline bool isEnabled() {
+    return detail::gEnabled.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Start recording; discards events of any previous session
+ */
+void start();
+
+/**
+ * @brief Stop recording and write the session to a JSON file
+ * @return false if no session was running or the file could not be written
+ */
+bool stop(const std::string& path);
+
+/**
+ * @brief Name the calling thread's lane (defaults to "main"/"thread N")
+ */
+void setThreadName(const std::string& name);
+
+/**
+ * @brief Records the lifetime of a block as one trace event
+ *
+ * name and category must outlive the session (string literals).
+ */
+class Scope {
+public:
+    Scope(const char* category, const char* name)
+        : category_(category),
+          name_(name),
+          startUs_(isEnabled() ? nowUs() : -1) {}
+
+    ~Scope() {
+        if (startUs_ >= 0) {
+            finish();
+        }
+    }
+
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+    bool active() const { return startUs_ >= 0; }
+
+    /**
+     * @brief Attach a key/value to the event, shown as args in the viewer
+     *
+     * Only call when active(); ONECAD_TRACE_ARG does the check.
+     */
+    void setArg(const char* key, std::string value) {
+        argKey_ = key;
+        argValue_ = std::move(value);
+    }
+
+private:
+    static int64_t nowUs();
+    void finish();
+
+    const char* category_;
+    const char* name_;
+    int64_t startUs_;
+    const char* argKey_ = nullptr;
+    std::string argValue_;
+};
+
+} // namespace onecad::core::trace
+
+#define ONECAD_TRACE_CONCAT_INNER(a, b) a##b
+#define ONECAD_TRACE_CONCAT(a, b) ONECAD_TRACE_CONCAT_INNER(a, b)
+
+/// Trace the enclosing block
+#define ONECAD_TRACE_SCOPE(category, name) \
+    ::onecad::core::trace::Scope ONECAD_TRACE_CONCAT(onecadTraceScope_, __LINE__)(category, name)
+
+/// Trace the enclosing block as a named scope so ONECAD_TRACE_ARG can refer to it
+#define ONECAD_TRACE_NAMED_SCOPE(var, category, name) \
+    ::onecad::core::trace::Scope var(category, name)
+
+/// Attach an argument; the value expression is only evaluated while recording
+#define ONECAD_TRACE_ARG(var, key, value) \
+    do {                                  \
+        if ((var).active()) {             \
+            (var).setArg(key, value);     \
+        }                                 \
+    } while (0)
+
+#endif // ONECAD_CORE_TRACE_TRACE_H
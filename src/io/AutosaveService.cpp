@@ -0,0 +1,259 @@
+/**
+ * @file AutosaveService.cpp
+ * @brief Implementation of background autosave and crash recovery
+ */
+
+#include "AutosaveService.h"
+#include "JSONUtils.h"
+#include "OneCADFileIO.h"
+#include "../app/document/Document.h"
+
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QLoggingCategory>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QUuid>
+
+#include <algorithm>
+
+Q_LOGGING_CATEGORY(logAutosave, "onecad.io.autosave")
+
+namespace onecad::io {
+
+namespace {
+
+const QString kPackageName = QStringLiteral("recovery.onecad");
+const QString kInfoName = QStringLiteral("recovery.json");
+const QString kLockName = QStringLiteral("session.lock");
+
+bool writeRecoveryInfo(const QString& sessionDirectory, const QString& sourcePath) {
+    QJsonObject info;
+    info["sourcePath"] = sourcePath;
+    info["savedAt"] = QDateTime::currentDateTimeUtc().toString(Qt::ISODate);
+
+    QSaveFile file(QDir(sessionDirectory).filePath(kInfoName));
+    if (!file.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+    file.write(JSONUtils::toCanonicalJson(info));
+    return file.commit();
+}
+
+} // anonymous namespace
+
+struct AutosaveService::SaveResult {
+    bool success = false;
+    QString errorMessage;
+    qint64 elapsedMs = 0;
+    std::unordered_map<std::string, uint64_t> shapeRevisions;  ///< Bodies stored in the package
+};
+
+AutosaveService::AutosaveService(QObject* parent)
+    : QObject(parent) {
+    // Recovery saves are serialized; OneCADFileIO parallelizes inside one save
+    pool_.setMaxThreadCount(1);
+    timer_.setTimerType(Qt::VeryCoarseTimer);
+    connect(&timer_, &QTimer::timeout, this, [this]() { autosaveNow(); });
+    setIntervalSeconds(kDefaultIntervalSeconds);
+}
+
+AutosaveService::~AutosaveService() {
+    // Clean shutdown: the session leaves nothing to recover
+    timer_.stop();
+    discardRecovery();
+    if (sessionLock_) {
+        sessionLock_->unlock();
+        QDir(sessionDirectory_).removeRecursively();
+    }
+}
+
+void AutosaveService::setDocument(app::Document* document) {
+    discardRecovery();
+    document_ = document;
+}
+
+void AutosaveService::setIntervalSeconds(int seconds) {
+    intervalSeconds_ = std::max(0, seconds);
+    if (intervalSeconds_ == 0) {
+        timer_.stop();
+    } else {
+        timer_.start(intervalSeconds_ * 1000);
+    }
+}
+
+bool AutosaveService::autosaveNow() {
+    if (!document_ || saving_ || !document_->isModified()) {
+        return false;
+    }
+    if (!ensureSession()) {
+        emit autosaveFailed(tr("Cannot create recovery directory in %1").arg(recoveryRoot()));
+        return false;
+    }
+
+    // Capture on the UI thread; everything after this runs on the worker
+    QElapsedTimer captureTimer;
+    captureTimer.start();
+    std::shared_ptr<app::Document> snapshot = document_->createSnapshot();
+    const QString path = packagePath();
+    for (const auto& [bodyId, revision] : savedShapeRevisions_) {
+        if (snapshot->bodyShapeRevision(bodyId) == revision) {
+            snapshot->markBodyShapeSaved(bodyId);
+        }
+    }
+    snapshot->setSaveBaselinePath(QFileInfo(path).absoluteFilePath());
+    qCDebug(logAutosave) << "Snapshot captured in" << captureTimer.elapsed() << "ms";
+
+    saving_ = true;
+    const uint64_t generation = generation_;
+    const QString sessionDirectory = sessionDirectory_;
+    const QString sourcePath = sourcePath_;
+    pool_.start([this, snapshot, path, generation, sessionDirectory, sourcePath]() mutable {
+        QElapsedTimer timer;
+        timer.start();
+        SaveResult result;
+        try {
+            FileIOResult saved = OneCADFileIO::save(path, snapshot.get());
+            result.success = saved.success && writeRecoveryInfo(sessionDirectory, sourcePath);
+            result.errorMessage = saved.success ? QString("Failed to write %1").arg(kInfoName)
+                                                : saved.errorMessage;
+            if (result.success) {
+                for (const auto& bodyId : snapshot->getBodyIds()) {
+                    result.shapeRevisions[bodyId] = snapshot->bodyShapeRevision(bodyId);
+                }
+            }
+        } catch (...) {
+            result.success = false;
+            result.errorMessage = "Unexpected exception";
+        }
+        snapshot.reset();
+        result.elapsedMs = timer.elapsed();
+
+        QMetaObject::invokeMethod(this, [this, generation, result]() {
+            onSaveFinished(generation, result);
+        }, Qt::QueuedConnection);
+    });
+    return true;
+}
+
+void AutosaveService::onSaveFinished(uint64_t generation, const SaveResult& result) {
+    if (generation != generation_) {
+        return;  // Discarded while saving
+    }
+    saving_ = false;
+
+    if (!result.success) {
+        savedShapeRevisions_.clear();
+        qCWarning(logAutosave) << "Autosave failed:" << result.errorMessage;
+        emit autosaveFailed(result.errorMessage);
+        return;
+    }
+
+    savedShapeRevisions_ = result.shapeRevisions;
+    qCInfo(logAutosave) << "Autosaved" << packagePath() << "in" << result.elapsedMs << "ms";
+    emit autosaved(packagePath(), result.elapsedMs);
+}
+
+void AutosaveService::discardRecovery() {
+    pool_.waitForDone();
+    saving_ = false;
+    ++generation_;
+    savedShapeRevisions_.clear();
+
+    if (!sessionDirectory_.isEmpty()) {
+        QFile::remove(packagePath());
+        QFile::remove(QDir(sessionDirectory_).filePath(kInfoName));
+    }
+}
+
+bool AutosaveService::ensureSession() {
+    if (sessionLock_) {
+        return true;
+    }
+
+    const QString directory = QDir(recoveryRoot()).filePath(
+        QUuid::createUuid().toString(QUuid::WithoutBraces));
+    if (!QDir().mkpath(directory)) {
+        return false;
+    }
+
+    auto lock = std::make_unique<QLockFile>(QDir(directory).filePath(kLockName));
+    lock->setStaleLockTime(0);  // Only a dead owner makes the lock stale
+    if (!lock->tryLock(0)) {
+        QDir(directory).removeRecursively();
+        return false;
+    }
+
+    sessionDirectory_ = directory;
+    sessionLock_ = std::move(lock);
+    return true;
+}
+
+QString AutosaveService::packagePath() const {
+    return QDir(sessionDirectory_).filePath(kPackageName);
+}
+
+QString AutosaveService::recoveryRoot() {
+    const QString overridePath = qEnvironmentVariable("ONECAD_RECOVERY_DIR").trimmed();
+    if (!overridePath.isEmpty()) {
+        return overridePath;
+    }
+
+    const QString appDataPath = QStandardPaths::writableLocation(QStandardPaths::AppLocalDataLocation);
+    if (!appDataPath.isEmpty()) {
+        return QDir(appDataPath).filePath(QStringLiteral("recovery"));
+    }
+
+    return QDir::temp().filePath(QStringLiteral("onecad-recovery"));
+}
+
+std::vector<AutosaveService::RecoveryInfo> AutosaveService::findOrphanedRecoveries() {
+    std::vector<RecoveryInfo> result;
+
+    const QFileInfoList sessions =
+        QDir(recoveryRoot()).entryInfoList(QDir::Dirs | QDir::NoDotAndDotDot);
+    for (const QFileInfo& session : sessions) {
+        const QDir dir(session.absoluteFilePath());
+
+        // Held by a running instance (including this one)
+        QLockFile lock(dir.filePath(kLockName));
+        lock.setStaleLockTime(0);
+        if (!lock.tryLock(0)) {
+            continue;
+        }
+
+        RecoveryInfo info;
+        info.sessionDirectory = dir.absolutePath();
+        info.packagePath = dir.filePath(kPackageName);
+
+        QFile infoFile(dir.filePath(kInfoName));
+        if (infoFile.open(QIODevice::ReadOnly)) {
+            const QJsonObject json = QJsonDocument::fromJson(infoFile.readAll()).object();
+            info.sourcePath = json["sourcePath"].toString();
+            info.savedAt = QDateTime::fromString(json["savedAt"].toString(), Qt::ISODate);
+        }
+        lock.unlock();
+
+        if (!QFileInfo::exists(info.packagePath) || !info.savedAt.isValid()) {
+            // Crashed before its first autosave completed
+            dir.removeRecursively();
+            continue;
+        }
+        result.push_back(info);
+    }
+
+    std::sort(result.begin(), result.end(), [](const RecoveryInfo& a, const RecoveryInfo& b) {
+        return a.savedAt > b.savedAt;
+    });
+    return result;
+}
+
+bool AutosaveService::removeRecovery(const RecoveryInfo& info) {
+    return QDir(info.sessionDirectory).removeRecursively();
+}
+
+} // namespace onecad::io
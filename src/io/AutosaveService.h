@@ -0,0 +1,140 @@
+/**
+ * @file AutosaveService.h
+ * @brief Periodic background autosave and crash recovery
+ */
+
+#pragma once
+
+#include <QDateTime>
+#include <QLockFile>
+#include <QObject>
+#include <QString>
+#include <QThreadPool>
+#include <QTimer>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace onecad::app {
+class Document;
+}
+
+namespace onecad::io {
+
+/**
+ * @brief Writes recovery packages of the open document on a worker thread
+ *
+ * On each tick the document is captured with Document::createSnapshot() on
+ * the UI thread (shapes and the ElementMap are shared, sketches captured as
+ * text, history copied) and the snapshot is saved by OneCADFileIO on a
+ * single worker. Ticks are skipped
+ * while a save is still running or the document is unmodified, so
+ * interaction never waits on serialization or compression.
+ *
+ * Recovery saves are incremental: bodies whose shape did not change since
+ * the previous autosave are copied from the previous recovery package.
+ *
+ * Each running instance owns a session directory under recoveryRoot(),
+ * locked with a QLockFile. A directory whose lock is stale belongs to a
+ * session that did not shut down cleanly; findOrphanedRecoveries() lists them.
+ */
+class AutosaveService : public QObject {
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Recovery package left behind by an earlier session
+     */
+    struct RecoveryInfo {
+        QString sessionDirectory;
+        QString packagePath;  ///< recovery.onecad inside sessionDirectory
+        QString sourcePath;   ///< File the document was opened from/saved to (empty = untitled)
+        QDateTime savedAt;
+    };
+
+    static constexpr int kDefaultIntervalSeconds = 120;
+
+    explicit AutosaveService(QObject* parent = nullptr);
+    ~AutosaveService() override;
+
+    AutosaveService(const AutosaveService&) = delete;
+    AutosaveService& operator=(const AutosaveService&) = delete;
+
+    /**
+     * @brief Track a (new) document; previous recovery data is discarded
+     * @param document Not owned; must outlive the service or be replaced first
+     */
+    void setDocument(app::Document* document);
+
+    /**
+     * @brief File the document belongs to, recorded with the recovery package
+     */
+    void setSourcePath(const QString& path) { sourcePath_ = path; }
+
+    /**
+     * @brief Autosave interval in seconds, 0 disables autosave
+     */
+    void setIntervalSeconds(int seconds);
+    int intervalSeconds() const { return intervalSeconds_; }
+
+    /**
+     * @brief Snapshot the document and queue a recovery save
+     * @return false if skipped (no document, unmodified, or a save is running)
+     */
+    bool autosaveNow();
+
+    /**
+     * @brief Remove this session's recovery package (after an explicit save or clean exit)
+     *
+     * Waits for a running autosave to finish first.
+     */
+    void discardRecovery();
+
+    bool isSaving() const { return saving_; }
+
+    /**
+     * @brief Directory holding one subdirectory per session
+     */
+    static QString recoveryRoot();
+
+    /**
+     * @brief Recovery packages of sessions that did not shut down cleanly, newest first
+     */
+    static std::vector<RecoveryInfo> findOrphanedRecoveries();
+
+    /**
+     * @brief Delete an orphaned session directory
+     */
+    static bool removeRecovery(const RecoveryInfo& info);
+
+signals:
+    void autosaved(const QString& packagePath, qint64 elapsedMs);
+    void autosaveFailed(const QString& errorMessage);
+
+private:
+    struct SaveResult;
+
+    bool ensureSession();
+    QString packagePath() const;
+    void onSaveFinished(uint64_t generation, const SaveResult& result);
+
+    app::Document* document_ = nullptr;
+    QString sourcePath_;
+    int intervalSeconds_ = kDefaultIntervalSeconds;
+    QTimer timer_;
+    QThreadPool pool_;
+    bool saving_ = false;
+
+    QString sessionDirectory_;
+    std::unique_ptr<QLockFile> sessionLock_;
+
+    // Incremented on setDocument()/discardRecovery(); results of older saves are ignored
+    uint64_t generation_ = 0;
+    // Body id -> shape revision stored in the current recovery package
+    std::unordered_map<std::string, uint64_t> savedShapeRevisions_;
+};
+
+} // namespace onecad::io
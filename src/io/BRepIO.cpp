@@ -0,0 +1,151 @@
+/**
+ * @file BRepIO.cpp
+ * @brief Implementation of body geometry storage
+ */
+
+#include "BRepIO.h"
+#include "IODeviceStream.h"
+#include "Package.h"
+
+#include <QBuffer>
+
+#include <BRepTools.hxx>
+#include <BRep_Builder.hxx>
+#include <BinTools.hxx>
+
+#include <istream>
+#include <ostream>
+
+namespace onecad::io {
+
+namespace {
+
+// BinTools_ShapeSet header; ASCII files start with "CASCADE Topology V..., (c) Matra-Datavision"
+constexpr const char* kBinaryHeader = "Open CASCADE Topology";
+constexpr int kHeaderProbeBytes = 64;
+
+void writeToStream(const TopoDS_Shape& shape, BRepFormat format, std::ostream& stream) {
+    if (format == BRepFormat::Binary) {
+        BinTools::Write(shape, stream);
+    } else {
+        BRepTools::Write(shape, stream);
+    }
+}
+
+TopoDS_Shape readFromStream(std::istream& stream, BRepFormat format, QString& errorMessage) {
+    TopoDS_Shape shape;
+    if (format == BRepFormat::Binary) {
+        BinTools::Read(shape, stream);
+    } else {
+        BRep_Builder builder;
+        BRepTools::Read(shape, stream, builder);
+    }
+
+    if (stream.fail() || shape.IsNull()) {
+        errorMessage = "Failed to read BREP";
+        shape.Nullify();
+    }
+    return shape;
+}
+
+} // namespace
+
+bool BRepIO::writeShape(Package* package,
+                        const QString& path,
+                        const TopoDS_Shape& shape,
+                        BRepFormat format) {
+    if (!package || shape.IsNull()) {
+        return false;
+    }
+
+    return package->writeFileStreamed(path, [&](std::ostream& stream) {
+        return writeShape(stream, shape, format);
+    });
+}
+
+bool BRepIO::writeShape(std::ostream& stream, const TopoDS_Shape& shape, BRepFormat format) {
+    if (shape.IsNull()) {
+        return false;
+    }
+    writeToStream(shape, format, stream);
+    return stream.good();
+}
+
+TopoDS_Shape BRepIO::readShape(Package* package,
+                               const QString& path,
+                               QString& errorMessage) {
+    if (!package) {
+        errorMessage = "Invalid package";
+        return {};
+    }
+
+    // Parse straight from the package entry; the entry is never held whole
+    TopoDS_Shape shape;
+    bool found = false;
+    package->readFileStreamed(path, [&](QIODevice& device) {
+        found = true;
+        const BRepFormat format = detectFormat(device.peek(kHeaderProbeBytes));
+        IODeviceInputStreamBuf streamBuf(&device);
+        std::istream stream(&streamBuf);
+        shape = readFromStream(stream, format, errorMessage);
+        return !shape.IsNull();
+    });
+
+    if (!found) {
+        errorMessage = QString("Missing BREP data: %1").arg(path);
+    } else if (shape.IsNull()) {
+        errorMessage = QString("%1: %2").arg(errorMessage, path);
+    }
+    return shape;
+}
+
+QByteArray BRepIO::encodeShape(const TopoDS_Shape& shape, BRepFormat format) {
+    if (shape.IsNull()) {
+        return {};
+    }
+
+    QByteArray data;
+    QBuffer buffer(&data);
+    buffer.open(QIODevice::WriteOnly);
+    bool ok = false;
+    {
+        IODeviceStreamBuf streamBuf(&buffer);
+        std::ostream stream(&streamBuf);
+        writeToStream(shape, format, stream);
+        stream.flush();
+        ok = stream.good();
+    }
+    return ok ? data : QByteArray();
+}
+
+TopoDS_Shape BRepIO::decodeShape(const QByteArray& data, QString& errorMessage) {
+    if (data.isEmpty()) {
+        errorMessage = "Empty BREP data";
+        return {};
+    }
+
+    // Parse in place from the entry buffer
+    ByteArrayStreamBuf streamBuf(data);
+    std::istream stream(&streamBuf);
+    return readFromStream(stream, detectFormat(data), errorMessage);
+}
+
+BRepFormat BRepIO::detectFormat(const QByteArray& data) {
+    return data.left(kHeaderProbeBytes).contains(kBinaryHeader) ? BRepFormat::Binary
+                                                                : BRepFormat::Text;
+}
+
+std::optional<BRepFormat> BRepIO::reusableFormat(Package* package, const QString& path) {
+    std::optional<BRepFormat> format;
+    package->readReusableFileStreamed(path, [&format](QIODevice& device) {
+        format = detectFormat(device.peek(kHeaderProbeBytes));
+        return true;
+    });
+    return format;
+}
+
+QString BRepIO::formatName(BRepFormat format) {
+    return format == BRepFormat::Binary ? QStringLiteral("binary") : QStringLiteral("text");
+}
+
+} // namespace onecad::io
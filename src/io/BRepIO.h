@@ -0,0 +1,92 @@
+/**
+ * @file BRepIO.h
+ * @brief Body geometry storage (bodies/{uuid}.brep)
+ */
+
+#pragma once
+
+#include <QByteArray>
+#include <QString>
+#include <TopoDS_Shape.hxx>
+
+#include <iosfwd>
+#include <optional>
+
+namespace onecad::io {
+
+class Package;
+
+/**
+ * @brief Encoding of a stored body shape
+ */
+enum class BRepFormat {
+    Text,   ///< BRepTools ASCII format (diffable, larger, slower to parse)
+    Binary  ///< BinTools binary format
+};
+
+/**
+ * @brief Read/write OCCT shapes in a package
+ *
+ * Per FILE_FORMAT.md §10. Shapes are streamed directly into the package
+ * entry on write and parsed in place from the package data on read. The
+ * encoding is detected from the data header, so either format can be read
+ * regardless of what the body metadata says.
+ */
+class BRepIO {
+public:
+    /**
+     * @brief Write shape to package entry in the given format
+     */
+    static bool writeShape(Package* package,
+                           const QString& path,
+                           const TopoDS_Shape& shape,
+                           BRepFormat format);
+
+    /**
+     * @brief Write shape to an output stream in the given format
+     */
+    static bool writeShape(std::ostream& stream,
+                           const TopoDS_Shape& shape,
+                           BRepFormat format);
+
+    /**
+     * @brief Read shape from package entry (format auto-detected)
+     * @return Shape, or null shape on error (errorMessage set)
+     */
+    static TopoDS_Shape readShape(Package* package,
+                                  const QString& path,
+                                  QString& errorMessage);
+
+    /**
+     * @brief Encode shape to an in-memory entry (safe to call from worker threads)
+     * @return Encoded data, empty on failure
+     */
+    static QByteArray encodeShape(const TopoDS_Shape& shape, BRepFormat format);
+
+    /**
+     * @brief Decode shape from entry data (format auto-detected, thread-safe)
+     * @return Shape, or null shape on error (errorMessage set)
+     */
+    static TopoDS_Shape decodeShape(const QByteArray& data, QString& errorMessage);
+
+    /**
+     * @brief Detect encoding from the leading bytes of stored shape data
+     */
+    static BRepFormat detectFormat(const QByteArray& data);
+
+    /**
+     * @brief Encoding of the stored entry Package::reuseFile() would keep
+     * @return nullopt if the package has nothing to reuse at path
+     */
+    static std::optional<BRepFormat> reusableFormat(Package* package, const QString& path);
+
+    /**
+     * @brief Format name stored in body metadata ("text" / "binary")
+     */
+    static QString formatName(BRepFormat format);
+
+private:
+    BRepIO() = delete;
+};
+
+} // namespace onecad::io
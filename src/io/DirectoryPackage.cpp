@@ -98,6 +98,24 @@ QByteArray DirectoryPackage::readFile(const QString& path) {
     return file.readAll();
 }
 
+bool DirectoryPackage::readFileStreamed(const QString& path, const DeviceReader& reader) {
+    if (!isValid()) return false;
+
+    QString fullPath = pImpl_->fullPath(path);
+    if (fullPath.isEmpty()) {
+        pImpl_->errorString = "Invalid path (contains ..)";
+        return false;
+    }
+
+    QFile file(fullPath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        pImpl_->errorString = QString("Failed to open file: %1").arg(fullPath);
+        return false;
+    }
+
+    return reader(file);
+}
+
 bool DirectoryPackage::fileExists(const QString& path) const {
     return QFile::exists(pImpl_->fullPath(path));
 }
@@ -161,6 +179,76 @@ bool DirectoryPackage::writeFile(const QString& path, const QByteArray& data) {
     return true;
 }
 
+bool DirectoryPackage::writeFileStreamed(const QString& path, const StreamWriter& writer) {
+    if (!isValid()) return false;
+
+    QString fullPath = pImpl_->fullPath(path);
+    if (fullPath.isEmpty()) {
+        pImpl_->errorString = "Invalid path (contains ..)";
+        return false;
+    }
+
+    QFileInfo fileInfo(fullPath);
+    QDir().mkpath(fileInfo.absolutePath());
+
+    QFile file(fullPath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        pImpl_->errorString = QString("Failed to create file: %1").arg(fullPath);
+        return false;
+    }
+
+    bool ok = writeToDevice(&file, writer);
+    file.close();
+
+    if (!ok) {
+        pImpl_->errorString = QString("Failed to write all data to: %1").arg(fullPath);
+        return false;
+    }
+
+    return true;
+}
+
+bool DirectoryPackage::copyFile(Package& source, const QString& path) {
+    if (!isValid()) return false;
+
+    auto* directorySource = dynamic_cast<DirectoryPackage*>(&source);
+    if (!directorySource) {
+        return Package::copyFile(source, path);
+    }
+
+    QString fullPath = pImpl_->fullPath(path);
+    QString sourcePath = directorySource->pImpl_->fullPath(path);
+    if (fullPath.isEmpty() || sourcePath.isEmpty()) {
+        pImpl_->errorString = "Invalid path (contains ..)";
+        return false;
+    }
+
+    // Saving over the same directory: the entry is already in place
+    if (QFileInfo(fullPath).canonicalFilePath() == QFileInfo(sourcePath).canonicalFilePath() &&
+        QFileInfo::exists(fullPath)) {
+        return true;
+    }
+
+    QDir().mkpath(QFileInfo(fullPath).absolutePath());
+    QFile::remove(fullPath);
+    if (!QFile::copy(sourcePath, fullPath)) {
+        pImpl_->errorString = QString("Failed to copy file: %1").arg(sourcePath);
+        return false;
+    }
+    return true;
+}
+
+bool DirectoryPackage::removeFile(const QString& path) {
+    if (!isValid()) return false;
+
+    QString fullPath = pImpl_->fullPath(path);
+    if (fullPath.isEmpty()) {
+        pImpl_->errorString = "Invalid path (contains ..)";
+        return false;
+    }
+    return QFile::remove(fullPath);
+}
+
 bool DirectoryPackage::finalize() {
     // No-op for directory package - files already written to disk
     return true;
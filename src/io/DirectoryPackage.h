@@ -40,9 +40,13 @@ public:
     
     // Package interface
     QByteArray readFile(const QString& path) override;
+    bool readFileStreamed(const QString& path, const DeviceReader& reader) override;
     bool fileExists(const QString& path) const override;
     QStringList listFiles(const QString& prefix) const override;
     bool writeFile(const QString& path, const QByteArray& data) override;
+    bool writeFileStreamed(const QString& path, const StreamWriter& writer) override;
+    bool copyFile(Package& source, const QString& path) override;
+    bool removeFile(const QString& path) override;
     bool finalize() override;
     QString errorString() const override;
     bool isValid() const override;
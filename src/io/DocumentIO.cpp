@@ -9,23 +9,28 @@
 #include "SketchIO.h"
 #include "ElementMapIO.h"
 #include "HistoryIO.h"
+#include "ManifestIO.h"
+#include "PackageEntryLoader.h"
+#include "PackageEntryPipeline.h"
 #include "../app/document/Document.h"
 #include "../app/history/RegenerationEngine.h"
 #include "../core/sketch/Sketch.h"
+#include "../core/trace/Trace.h"
 
 #include <QJsonDocument>
 #include <QJsonArray>
 #include <QFileInfo>
-#include <BRepTools.hxx>
-#include <BRep_Builder.hxx>
-#include <Standard_Stream.hxx>
-#include <sstream>
+#include <algorithm>
+#include <optional>
+#include <ostream>
 #include <unordered_map>
 #include <unordered_set>
 
 namespace onecad::io {
 
-bool DocumentIO::saveDocument(Package* package, const app::Document* document) {
+bool DocumentIO::saveDocument(Package* package, const app::Document* document,
+                              BRepFormat brepFormat) {
+    ONECAD_TRACE_SCOPE("io", "saveDocument");
     // 1. Create and write document.json
     QJsonObject docJson = createDocumentJson(document);
     QByteArray docData = JSONUtils::toCanonicalJson(docJson);
@@ -33,46 +38,107 @@ bool DocumentIO::saveDocument(Package* package, const app::Document* document) {
         return false;
     }
     
+    // 2-4. Sketch JSON, body metadata and changed BREPs are encoded
+    // concurrently (BREPs into temporary files). Reusable BREPs and the
+    // ElementMap are only streamed by the writer if they cannot be kept.
+    // Entries are written in this order by a single writer.
+    PackageEntryPipeline pipeline(package);
+
     // 2. Save each sketch to sketches/{uuid}.json
     for (const auto& sketchId : document->getSketchIds()) {
+        if (!document->isSketchLoaded(sketchId)) {
+            // Never loaded: keep the stored entry, or load it only to copy it elsewhere
+            const QString id = QString::fromStdString(sketchId);
+            pipeline.reuseOrWriteStreamed(QString("sketches/%1.json").arg(id), {},
+                                          [id, sketchId, document](std::ostream& stream) {
+                const auto* sketch = document->getSketch(sketchId);
+                const QByteArray data = sketch ? SketchIO::encodeSketch(id, sketch) : QByteArray();
+                stream.write(data.constData(), data.size());
+                return !data.isEmpty() && stream.good();
+            });
+            continue;
+        }
         const auto* sketch = document->getSketch(sketchId);
         if (sketch) {
-            if (!SketchIO::saveSketch(package, QString::fromStdString(sketchId), sketch)) {
-                return false;
-            }
+            const QString id = QString::fromStdString(sketchId);
+            pipeline.write(QString("sketches/%1.json").arg(id), [id, sketch](QByteArray& data) {
+                data = SketchIO::encodeSketch(id, sketch);
+                return !data.isEmpty();
+            });
         }
     }
     
     // 3. Save body metadata and BREP cache
     for (const auto& bodyId : document->getBodyIds()) {
+        QString brepPath = QString("bodies/%1.brep").arg(QString::fromStdString(bodyId));
+
+        // A stored BREP is only kept if it already has the requested
+        // encoding, so older text entries move to binary on the next save
+        const std::optional<BRepFormat> storedFormat = BRepIO::reusableFormat(package, brepPath);
+        const bool storedMatches = storedFormat == brepFormat;
+
+        enum class BrepAction { None, Reuse, Encode };
+        BrepAction action = BrepAction::None;
+        BRepFormat writtenFormat = brepFormat;
+        const TopoDS_Shape* shape = nullptr;
+        if (!document->isBodyLoaded(bodyId)) {
+            if (!storedMatches) {
+                // Re-encoding needs the shape; if it cannot be loaded the
+                // stored copy is kept as it is
+                shape = document->getBodyShape(bodyId);
+            }
+            if (shape && !shape->IsNull()) {
+                action = BrepAction::Encode;
+            } else {
+                action = BrepAction::Reuse;
+                writtenFormat = storedFormat.value_or(brepFormat);
+            }
+        } else {
+            shape = document->getBodyShape(bodyId);
+            if (shape && !shape->IsNull()) {
+                // Unchanged since the last save/load: keep the stored BREP
+                action = document->isBodyShapeSaved(bodyId) && storedMatches ? BrepAction::Reuse
+                                                                              : BrepAction::Encode;
+            }
+        }
+
         QJsonObject bodyJson;
         bodyJson["bodyId"] = QString::fromStdString(bodyId);
         bodyJson["name"] = QString::fromStdString(document->getBodyName(bodyId));
         bodyJson["visible"] = document->isBodyVisible(bodyId);
-
-        QString brepPath = QString("bodies/%1.brep").arg(QString::fromStdString(bodyId));
         bodyJson["brepPath"] = brepPath;
+        bodyJson["brepFormat"] = BRepIO::formatName(writtenFormat);
 
         QString bodyPath = QString("bodies/%1.json").arg(QString::fromStdString(bodyId));
-        if (!package->writeFile(bodyPath, JSONUtils::toCanonicalJson(bodyJson))) {
-            return false;
-        }
+        QByteArray bodyData = JSONUtils::toCanonicalJson(bodyJson);
+        pipeline.write(bodyPath, [bodyData](QByteArray& data) {
+            data = bodyData;
+            return true;
+        });
 
-        const TopoDS_Shape* shape = document->getBodyShape(bodyId);
-        if (!shape || shape->IsNull()) {
-            continue;
-        }
-
-        std::ostringstream stream;
-        BRepTools::Write(*shape, stream);
-        QByteArray brepData = QByteArray::fromStdString(stream.str());
-        if (!package->writeFile(brepPath, brepData)) {
-            return false;
+        if (action == BrepAction::Reuse) {
+            pipeline.reuseOrWriteStreamed(brepPath, {},
+                                          [bodyId, document, brepFormat](std::ostream& stream) {
+                const TopoDS_Shape* reloaded = document->getBodyShape(bodyId);
+                return reloaded && BRepIO::writeShape(stream, *reloaded, brepFormat);
+            });
+        } else if (action == BrepAction::Encode) {
+            pipeline.writeStreamed(brepPath, [shape, brepFormat](std::ostream& stream) {
+                return BRepIO::writeShape(stream, *shape, brepFormat);
+            });
         }
     }
     
     // 4. Save ElementMap
-    if (!ElementMapIO::saveElementMap(package, document->elementMap())) {
+    const auto& elementMap = document->elementMap();
+    pipeline.reuseOrWriteStreamed("topology/elementmap.json",
+                                  ElementMapIO::computeElementMapHash(elementMap),
+                                  [&elementMap](std::ostream& stream) {
+        return ElementMapIO::writeElementMap(stream, elementMap);
+    });
+
+    if (!pipeline.finish()) {
+        qWarning() << "Failed to save document entries:" << pipeline.errors();
         return false;
     }
     
@@ -95,7 +161,10 @@ bool DocumentIO::saveDocument(Package* package, const app::Document* document) {
 
 std::unique_ptr<app::Document> DocumentIO::loadDocument(Package* package,
                                                          QObject* parent,
-                                                         QString& errorMessage) {
+                                                         QString& errorMessage,
+                                                         const QJsonObject& manifest,
+                                                         std::shared_ptr<PackageEntryLoader> lazyLoader) {
+    ONECAD_TRACE_SCOPE("io", "loadDocument");
     // 1. Read document.json
     QByteArray docData = package->readFile("document.json");
     if (docData.isEmpty()) {
@@ -115,22 +184,55 @@ std::unique_ptr<app::Document> DocumentIO::loadDocument(Package* package,
     if (!parseDocumentJson(jsonDoc.object(), document.get(), errorMessage)) {
         return nullptr;
     }
+    document->setEntryLoader(lazyLoader);
     
-    // 3. Load sketches
+    // 3. Load sketches; decoding overlaps with the reads below and is
+    // collected before any body is added or regenerated
+    PackageEntryPipeline pipeline(package);
+
+    struct LoadedSketch {
+        QString id;
+        std::unique_ptr<core::sketch::Sketch> sketch;
+        QString error;
+    };
+
     QStringList sketchFiles = package->listFiles("sketches/");
-    for (const QString& sketchFile : sketchFiles) {
-        if (!sketchFile.endsWith(".json")) {
-            continue;
-        }
-        QString sketchId = QFileInfo(sketchFile).baseName();
-        auto sketch = SketchIO::loadSketch(package, sketchId, errorMessage);
-        if (!sketch) {
-            // Log warning but continue - partial recovery
-            qWarning() << "Failed to load sketch:" << sketchId << "-" << errorMessage;
-            continue;
+    sketchFiles.erase(std::remove_if(sketchFiles.begin(), sketchFiles.end(),
+                                     [](const QString& file) { return !file.endsWith(".json"); }),
+                      sketchFiles.end());
+    std::vector<LoadedSketch> loadedSketches(static_cast<size_t>(sketchFiles.size()));
+    if (lazyLoader) {
+        // Listed now, parsed on first access (regeneration loads what it uses)
+        for (const QString& sketchFile : sketchFiles) {
+            document->addPendingSketch(QFileInfo(sketchFile).baseName().toStdString());
         }
-        document->addSketchWithId(sketchId.toStdString(), std::move(sketch));
+        loadedSketches.clear();
     }
+    for (size_t i = 0; i < loadedSketches.size(); ++i) {
+        LoadedSketch& slot = loadedSketches[i];
+        slot.id = QFileInfo(sketchFiles[static_cast<qsizetype>(i)]).baseName();
+        const QString path = QString("sketches/%1.json").arg(slot.id);
+        pipeline.read(path, [&slot, path](const QByteArray& data, QString& error) {
+            slot.sketch = SketchIO::decodeSketch(data, path, slot.error);
+            error = slot.error;
+            return slot.sketch != nullptr;
+        });
+    }
+
+    auto addLoadedSketches = [&]() {
+        for (auto& loaded : loadedSketches) {
+            if (!loaded.sketch) {
+                // Log warning but continue - partial recovery
+                if (loaded.error.isEmpty()) {
+                    loaded.error = QString("Sketch file not found: sketches/%1.json").arg(loaded.id);
+                }
+                qWarning() << "Failed to load sketch:" << loaded.id << "-" << loaded.error;
+                errorMessage = loaded.error;
+                continue;
+            }
+            document->addSketchWithId(loaded.id.toStdString(), std::move(loaded.sketch));
+        }
+    };
     
     // 4. Load operation history first (determines if we regenerate or load BREP)
     QString historyError;
@@ -138,7 +240,7 @@ std::unique_ptr<app::Document> DocumentIO::loadDocument(Package* package,
 
     // 4b. Load ElementMap for stable topology references (if present)
     QString elementMapError;
-    ElementMapIO::loadElementMap(package, document->elementMap(), elementMapError);
+    ElementMapIO::loadElementMap(package, document->mutableElementMap(), elementMapError);
 
     struct BodyMeta {
         QString name;
@@ -175,33 +277,60 @@ std::unique_ptr<app::Document> DocumentIO::loadDocument(Package* package,
             meta.brepPath = QString("bodies/%1.brep").arg(bodyId);
         }
 
+        if (lazyLoader) {
+            lazyLoader->setBodyPath(bodyId.toStdString(), meta.brepPath);
+        }
         bodyMeta[bodyId.toStdString()] = meta;
     }
 
-    auto loadBodyFromBrep = [&](const std::string& bodyId, const BodyMeta& meta) {
-        QByteArray brepData = package->readFile(meta.brepPath);
-        if (brepData.isEmpty()) {
-            qWarning() << "Missing BREP data for body:" << QString::fromStdString(bodyId);
-            return false;
-        }
+    // Hidden bodies are not drawn, so with a lazy loader they load on first access
+    auto deferBody = [&](const std::string& bodyId) {
+        const BodyMeta& meta = bodyMeta[bodyId];
+        return lazyLoader && !meta.visible &&
+               document->addPendingBody(bodyId, meta.name.toStdString());
+    };
 
-        TopoDS_Shape shape;
-        BRep_Builder builder;
-        std::string brepString(brepData.constData(), brepData.size());
-        std::istringstream stream(brepString);
-        BRepTools::Read(shape, stream, builder);
-        if (stream.fail() || shape.IsNull()) {
-            qWarning() << "Failed to read BREP for body:" << QString::fromStdString(bodyId);
-            return false;
+    // Decode the requested BREPs concurrently; null shapes for failures
+    auto readBreps = [&](const std::vector<std::string>& bodyIds) {
+        std::unordered_map<std::string, TopoDS_Shape> shapes;
+        shapes.reserve(bodyIds.size());
+        for (const auto& bodyId : bodyIds) {
+            shapes[bodyId];
+        }
+        for (const auto& bodyId : bodyIds) {
+            // Text or binary encoding is detected from the data
+            TopoDS_Shape& slot = shapes[bodyId];
+            pipeline.read(bodyMeta[bodyId].brepPath, [&slot](const QByteArray& data, QString& error) {
+                slot = BRepIO::decodeShape(data, error);
+                return !slot.IsNull();
+            });
+        }
+        pipeline.finish();
+        for (const auto& failure : pipeline.errors()) {
+            if (failure.startsWith("bodies/")) {
+                qWarning() << "Failed to load body:" << failure;
+            }
         }
+        addLoadedSketches();
+        return shapes;
+    };
 
-        if (!document->addBodyWithId(bodyId, shape, meta.name.toStdString())) {
+    auto addBody = [&](const std::string& bodyId, const BodyMeta& meta, const TopoDS_Shape& shape) {
+        if (shape.IsNull() || !document->addBodyWithId(bodyId, shape, meta.name.toStdString())) {
             return false;
         }
         document->setBodyVisible(bodyId, meta.visible);
+        // Matches the stored BREP until the shape changes (incremental save)
+        document->markBodyShapeSaved(bodyId);
         return true;
     };
 
+    std::vector<std::string> allBodyIds;
+    allBodyIds.reserve(bodyMeta.size());
+    for (const auto& [bodyId, meta] : bodyMeta) {
+        allBodyIds.push_back(bodyId);
+    }
+
     // 5. If operations exist, regenerate from history (seed base bodies from BREP)
     if (!document->operations().empty()) {
         std::unordered_set<std::string> createdBodies;
@@ -228,57 +357,106 @@ std::unique_ptr<app::Document> DocumentIO::loadDocument(Package* package,
             }
         }
 
-        std::unordered_set<std::string> baseBodies;
-        for (const auto& [bodyId, meta] : bodyMeta) {
-            if (createdBodies.find(bodyId) != createdBodies.end()) {
-                continue;
+        // 5a. Trusted cache: read every stored body; regeneration is only verified later
+        QString cacheRejection = "No manifest";
+        if (!manifest.isEmpty()) {
+            cacheRejection = ManifestIO::checkBodyCache(
+                manifest,
+                HistoryIO::computeOpsHash(document->operations()),
+                ElementMapIO::computeStoredElementMapHash(package));
+        }
+
+        // Trusted cache needs every visible body, regeneration all base bodies
+        std::vector<std::string> neededIds;
+        std::vector<std::string> deferredIds;
+        if (cacheRejection.isEmpty()) {
+            for (const auto& bodyId : allBodyIds) {
+                if (lazyLoader && !bodyMeta[bodyId].visible) {
+                    deferredIds.push_back(bodyId);
+                } else {
+                    neededIds.push_back(bodyId);
+                }
             }
-            if (loadBodyFromBrep(bodyId, meta)) {
-                baseBodies.insert(bodyId);
+        } else {
+            for (const auto& bodyId : allBodyIds) {
+                if (createdBodies.find(bodyId) == createdBodies.end()) {
+                    neededIds.push_back(bodyId);
+                }
             }
         }
-        document->setBaseBodyIds(baseBodies);
+        auto shapes = readBreps(neededIds);
 
-        app::history::RegenerationEngine regen(document.get());
-        auto result = regen.regenerateAll();
+        if (cacheRejection.isEmpty()) {
+            for (const auto& bodyId : neededIds) {
+                if (shapes[bodyId].IsNull()) {
+                    cacheRejection = QString("Unreadable BREP for body %1")
+                                         .arg(QString::fromStdString(bodyId));
+                    break;
+                }
+            }
+        }
 
-        if (result.status == app::history::RegenStatus::CriticalFailure) {
-            // All ops failed - store for UI to show RegenFailureDialog
-            QString failedOps;
-            for (const auto& f : result.failedOps) {
-                if (!failedOps.isEmpty()) failedOps += "; ";
-                failedOps += QString::fromStdString(f.opId + ": " + f.errorMessage);
+        if (cacheRejection.isEmpty()) {
+            std::unordered_set<std::string> baseBodies;
+            for (const auto& bodyId : neededIds) {
+                if (addBody(bodyId, bodyMeta[bodyId], shapes[bodyId]) &&
+                    createdBodies.find(bodyId) == createdBodies.end()) {
+                    baseBodies.insert(bodyId);
+                }
             }
-            if (failedOps.isEmpty()) {
-                errorMessage = "Regeneration failed: dependency cycle or invalid history";
-            } else {
-                errorMessage = QString("Regeneration failed: %1").arg(failedOps);
+            for (const auto& bodyId : deferredIds) {
+                if (deferBody(bodyId) && createdBodies.find(bodyId) == createdBodies.end()) {
+                    baseBodies.insert(bodyId);
+                }
             }
-            // Continue anyway - partial document may be usable
-        } else if (result.status == app::history::RegenStatus::PartialFailure) {
-            // Some ops failed - log warning
-            qWarning() << "Some operations failed during regeneration:";
-            for (const auto& f : result.failedOps) {
-                qWarning() << "  " << QString::fromStdString(f.opId)
-                           << ":" << QString::fromStdString(f.errorMessage);
+            document->setBaseBodyIds(baseBodies);
+            document->setHistoryVerificationPending(true);
+            qInfo() << "Opened from BREP cache:" << neededIds.size() << "bodies,"
+                    << deferredIds.size() << "deferred,"
+                    << document->operations().size() << "operations";
+        } else {
+            qInfo() << "BREP cache not used, regenerating:" << cacheRejection;
+
+            std::unordered_set<std::string> baseBodies;
+            for (const auto& [bodyId, meta] : bodyMeta) {
+                if (createdBodies.find(bodyId) != createdBodies.end()) {
+                    continue;
+                }
+                if (addBody(bodyId, meta, shapes[bodyId])) {
+                    baseBodies.insert(bodyId);
+                }
             }
-        }
+            document->setBaseBodyIds(baseBodies);
+
+            // Continue on failure - partial document may be usable
+            regenerateFromHistory(document.get(), errorMessage);
 
-        // Apply metadata for regenerated bodies (including base bodies)
-        for (const auto& [bodyId, meta] : bodyMeta) {
-            if (document->getBodyShape(bodyId)) {
-                if (!meta.name.isEmpty()) {
-                    document->setBodyName(bodyId, meta.name.toStdString());
+            // Apply metadata for regenerated bodies (including base bodies)
+            for (const auto& [bodyId, meta] : bodyMeta) {
+                if (document->getBodyShape(bodyId)) {
+                    if (!meta.name.isEmpty()) {
+                        document->setBodyName(bodyId, meta.name.toStdString());
+                    }
+                    document->setBodyVisible(bodyId, meta.visible);
                 }
-                document->setBodyVisible(bodyId, meta.visible);
             }
         }
     } else {
         // 5b. No operations - fallback to BREP cache (backward compat)
+        std::vector<std::string> neededIds;
         bool loadedBodies = false;
         std::unordered_set<std::string> baseBodies;
-        for (const auto& [bodyId, meta] : bodyMeta) {
-            if (loadBodyFromBrep(bodyId, meta)) {
+        for (const auto& bodyId : allBodyIds) {
+            if (deferBody(bodyId)) {
+                loadedBodies = true;
+                baseBodies.insert(bodyId);
+            } else {
+                neededIds.push_back(bodyId);
+            }
+        }
+        auto shapes = readBreps(neededIds);
+        for (const auto& bodyId : neededIds) {
+            if (addBody(bodyId, bodyMeta[bodyId], shapes[bodyId])) {
                 loadedBodies = true;
                 baseBodies.insert(bodyId);
             }
@@ -292,6 +470,44 @@ std::unique_ptr<app::Document> DocumentIO::loadDocument(Package* package,
     return document;
 }
 
+bool DocumentIO::regenerateFromHistory(app::Document* document, QString& errorMessage) {
+    ONECAD_TRACE_SCOPE("io", "regenerateFromHistory");
+    // Replay starts from base bodies only, exactly as a fresh load does
+    for (const auto& bodyId : document->getBodyIds()) {
+        if (!document->isBaseBody(bodyId)) {
+            document->removeBodyPreserveElementMap(bodyId);
+        }
+    }
+    document->setHistoryVerificationPending(false);
+
+    app::history::RegenerationEngine regen(document);
+    auto result = regen.regenerateAll();
+
+    if (result.status == app::history::RegenStatus::CriticalFailure) {
+        // All ops failed - store for UI to show RegenFailureDialog
+        QString failedOps;
+        for (const auto& f : result.failedOps) {
+            if (!failedOps.isEmpty()) failedOps += "; ";
+            failedOps += QString::fromStdString(f.opId + ": " + f.errorMessage);
+        }
+        if (failedOps.isEmpty()) {
+            errorMessage = "Regeneration failed: dependency cycle or invalid history";
+        } else {
+            errorMessage = QString("Regeneration failed: %1").arg(failedOps);
+        }
+        return false;
+    }
+    if (result.status == app::history::RegenStatus::PartialFailure) {
+        // Some ops failed - log warning
+        qWarning() << "Some operations failed during regeneration:";
+        for (const auto& f : result.failedOps) {
+            qWarning() << "  " << QString::fromStdString(f.opId)
+                       << ":" << QString::fromStdString(f.errorMessage);
+        }
+    }
+    return true;
+}
+
 QJsonObject DocumentIO::createDocumentJson(const app::Document* document) {
     QJsonObject json;
     
@@ -5,6 +5,8 @@
 
 #pragma once
 
+#include "BRepIO.h"
+
 #include <QJsonObject>
 #include <QString>
 #include <memory>
@@ -16,6 +18,7 @@ class Document;
 namespace onecad::io {
 
 class Package;
+class PackageEntryLoader;
 
 /**
  * @brief Serialization for document.json
@@ -29,20 +32,49 @@ public:
      * @brief Save document structure to package
      * @param package Package to write to
      * @param document Document to serialize
+     * @param brepFormat Encoding for bodies/{uuid}.brep
      * @return true on success
      */
-    static bool saveDocument(Package* package, const app::Document* document);
+    static bool saveDocument(Package* package, const app::Document* document,
+                             BRepFormat brepFormat = BRepFormat::Text);
     
     /**
      * @brief Load document structure from package
+     *
+     * If the manifest vouches for the BREP cache (ManifestIO::checkBodyCache),
+     * all bodies are read from bodies/{id}.brep and history regeneration is
+     * deferred: the document is flagged with isHistoryVerificationPending()
+     * (see HistoryVerificationJob).
+     * Otherwise bodies are regenerated from history as usual.
+     *
+     * With a lazy loader, sketches and hidden bodies are only listed (names,
+     * visibility) and load through the loader on first access; the document
+     * keeps the loader. Operations and the ElementMap are always read.
+     *
      * @param package Package to read from
      * @param parent QObject parent for new Document
      * @param errorMessage Output error message on failure
+     * @param manifest Validated manifest.json (empty disables the cache path)
+     * @param lazyLoader Loader over the same package, or null to load everything now
      * @return Loaded document, or nullptr on error
      */
     static std::unique_ptr<app::Document> loadDocument(Package* package,
                                                         QObject* parent,
-                                                        QString& errorMessage);
+                                                        QString& errorMessage,
+                                                        const QJsonObject& manifest = {},
+                                                        std::shared_ptr<PackageEntryLoader> lazyLoader = nullptr);
+
+    /**
+     * @brief Rebuild all history-created bodies from base bodies
+     *
+     * Bodies not in the base set are dropped first (names, visibility and
+     * ElementMap entries are kept), then every operation is replayed.
+     * Clears the history verification flag.
+     *
+     * @param errorMessage Set if regeneration failed critically
+     * @return false on critical failure (partial document may still be usable)
+     */
+    static bool regenerateFromHistory(app::Document* document, QString& errorMessage);
     
     /**
      * @brief Create document.json content
@@ -4,14 +4,17 @@
  */
 
 #include "ElementMapIO.h"
+#include "IODeviceStream.h"
 #include "Package.h"
 #include "JSONUtils.h"
 #include "../kernel/elementmap/ElementMap.h"
 
+#include <QCryptographicHash>
 #include <QJsonDocument>
 #include <QJsonArray>
 #include <cmath>
 #include <optional>
+#include <ostream>
 #include <gp_Vec.hxx>
 
 namespace onecad::io {
@@ -20,6 +23,10 @@ using namespace kernel::elementmap;
 
 namespace {
 
+constexpr const char* kSchemaVersion = "1.0.0";
+constexpr const char* kHashAlgorithm = "fnv1a64";
+constexpr double kQuantizationEpsilon = 1e-6;
+
 QString kindToString(ElementKind kind) {
     switch (kind) {
         case ElementKind::Body: return "Body";
@@ -136,6 +143,24 @@ QJsonObject serializeDescriptor(const ElementDescriptor& desc) {
     return json;
 }
 
+QJsonObject serializeEntry(const ElementId& id, const Entry& entry) {
+    QJsonObject entryJson;
+    entryJson["id"] = QString::fromStdString(id.value);
+    entryJson["kind"] = kindToString(entry.kind);
+    entryJson["opId"] = QString::fromStdString(entry.opId);
+    
+    // Sources
+    QJsonArray sources;
+    for (const auto& sourceId : entry.sources) {
+        sources.append(QString::fromStdString(sourceId.value));
+    }
+    entryJson["sources"] = sources;
+    
+    // Descriptor
+    entryJson["descriptor"] = serializeDescriptor(entry.descriptor);
+    return entryJson;
+}
+
 std::optional<ElementDescriptor> deserializeDescriptor(const QJsonObject& json, QString& error) {
     ElementDescriptor desc;
 
@@ -217,8 +242,53 @@ std::optional<ElementDescriptor> deserializeDescriptor(const QJsonObject& json,
 
 bool ElementMapIO::saveElementMap(Package* package,
                                    const ElementMap& elementMap) {
-    QJsonObject json = serializeElementMap(elementMap);
-    return package->writeFile("topology/elementmap.json", JSONUtils::toCanonicalJson(json));
+    return package->writeFileStreamed("topology/elementmap.json", [&](std::ostream& stream) {
+        return writeElementMap(stream, elementMap);
+    });
+}
+
+bool ElementMapIO::writeElementMap(std::ostream& stream, const ElementMap& elementMap) {
+    // Keys in sorted order, matching JSONUtils::toCanonicalJson
+    stream << "{\n    \"entries\": [";
+    bool first = true;
+    for (const auto& id : elementMap.ids()) {
+        const Entry* entry = elementMap.find(id);
+        if (!entry) continue;
+
+        const QByteArray entryData =
+            QJsonDocument(serializeEntry(id, *entry)).toJson(QJsonDocument::Compact);
+        stream << (first ? "\n        " : ",\n        ");
+        stream.write(entryData.constData(), entryData.size());
+        first = false;
+    }
+    const QByteArray epsilon = QByteArray::number(kQuantizationEpsilon);
+    stream << (first ? "]" : "\n    ]") << ",\n"
+           << "    \"hashAlgorithm\": \"" << kHashAlgorithm << "\",\n"
+           << "    \"quantizationEpsilon\": " << epsilon.constData() << ",\n"
+           << "    \"schemaVersion\": \"" << kSchemaVersion << "\"\n"
+           << "}\n";
+    return stream.good();
+}
+
+QString ElementMapIO::computeElementMapHash(const ElementMap& elementMap) {
+    QCryptographicHash hash(QCryptographicHash::Sha256);
+    {
+        HashingStreamBuf streamBuf(hash);
+        std::ostream stream(&streamBuf);
+        writeElementMap(stream, elementMap);
+    }
+    return QString::fromLatin1(hash.result().toHex());
+}
+
+QString ElementMapIO::computeStoredElementMapHash(Package* package) {
+    QCryptographicHash hash(QCryptographicHash::Sha256);
+    bool hashed = package->readFileStreamed("topology/elementmap.json", [&](QIODevice& device) {
+        return hash.addData(&device);
+    });
+    if (!hashed) {
+        return {};
+    }
+    return QString::fromLatin1(hash.result().toHex());
 }
 
 bool ElementMapIO::loadElementMap(Package* package,
@@ -244,32 +314,16 @@ QJsonObject ElementMapIO::serializeElementMap(const ElementMap& elementMap) {
     QJsonObject json;
     
     // Metadata
-    json["schemaVersion"] = "1.0.0";
-    json["hashAlgorithm"] = "fnv1a64";
-    json["quantizationEpsilon"] = 1e-6;
+    json["schemaVersion"] = kSchemaVersion;
+    json["hashAlgorithm"] = kHashAlgorithm;
+    json["quantizationEpsilon"] = kQuantizationEpsilon;
     
     // Serialize all entries
     QJsonArray entries;
     for (const auto& id : elementMap.ids()) {
         const Entry* entry = elementMap.find(id);
         if (!entry) continue;
-        
-        QJsonObject entryJson;
-        entryJson["id"] = QString::fromStdString(id.value);
-        entryJson["kind"] = kindToString(entry->kind);
-        entryJson["opId"] = QString::fromStdString(entry->opId);
-        
-        // Sources
-        QJsonArray sources;
-        for (const auto& sourceId : entry->sources) {
-            sources.append(QString::fromStdString(sourceId.value));
-        }
-        entryJson["sources"] = sources;
-        
-        // Descriptor
-        entryJson["descriptor"] = serializeDescriptor(entry->descriptor);
-        
-        entries.append(entryJson);
+        entries.append(serializeEntry(id, *entry));
     }
     json["entries"] = entries;
     
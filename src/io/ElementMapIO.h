@@ -7,6 +7,7 @@
 
 #include <QJsonObject>
 #include <QString>
+#include <iosfwd>
 
 namespace onecad::kernel::elementmap {
 class ElementMap;
@@ -37,6 +38,15 @@ public:
                                 kernel::elementmap::ElementMap& elementMap,
                                 QString& errorMessage);
     
+    /**
+     * @brief Stream elementmap.json content (one compact entry per line)
+     *
+     * Used by saveElementMap(); entries are serialized one at a time so the
+     * whole document never exists in memory.
+     */
+    static bool writeElementMap(std::ostream& stream,
+                                const kernel::elementmap::ElementMap& elementMap);
+
     /**
      * @brief Serialize ElementMap to JSON
      */
@@ -48,6 +58,16 @@ public:
     static bool deserializeElementMap(const QJsonObject& json,
                                        kernel::elementmap::ElementMap& elementMap,
                                        QString& errorMessage);
+
+    /**
+     * @brief SHA-256 of the elementmap.json content saveElementMap() writes
+     */
+    static QString computeElementMapHash(const kernel::elementmap::ElementMap& elementMap);
+
+    /**
+     * @brief SHA-256 of topology/elementmap.json in a package (empty if absent)
+     */
+    static QString computeStoredElementMapHash(Package* package);
     
 private:
     ElementMapIO() = delete;
@@ -0,0 +1,154 @@
+/**
+ * @file HistoryVerificationJob.cpp
+ * @brief Implementation of background history verification
+ */
+
+#include "HistoryVerificationJob.h"
+#include "DocumentIO.h"
+#include "HistoryIO.h"
+#include "../app/document/Document.h"
+#include "../core/trace/Trace.h"
+
+#include <BRepBuilderAPI_Copy.hxx>
+#include <BRepGProp.hxx>
+#include <GProp_GProps.hxx>
+
+#include <QElapsedTimer>
+#include <QLoggingCategory>
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+
+Q_LOGGING_CATEGORY(logHistoryVerification, "onecad.io.verify")
+
+namespace onecad::io {
+
+namespace {
+
+bool nearlyEqual(double a, double b) {
+    constexpr double kRelativeTolerance = 1e-6;
+    return std::abs(a - b) <= kRelativeTolerance * std::max({1.0, std::abs(a), std::abs(b)});
+}
+
+// Volume and area catch a stale cache; equal topology is not required
+bool sameGeometry(const TopoDS_Shape& cached, const TopoDS_Shape& regenerated) {
+    GProp_GProps cachedVolume;
+    GProp_GProps regeneratedVolume;
+    BRepGProp::VolumeProperties(cached, cachedVolume);
+    BRepGProp::VolumeProperties(regenerated, regeneratedVolume);
+    if (!nearlyEqual(cachedVolume.Mass(), regeneratedVolume.Mass())) {
+        return false;
+    }
+    GProp_GProps cachedArea;
+    GProp_GProps regeneratedArea;
+    BRepGProp::SurfaceProperties(cached, cachedArea);
+    BRepGProp::SurfaceProperties(regenerated, regeneratedArea);
+    return nearlyEqual(cachedArea.Mass(), regeneratedArea.Mass());
+}
+
+} // namespace
+
+HistoryVerificationJob::HistoryVerificationJob(QObject* parent)
+    : QObject(parent) {
+    pool_.setMaxThreadCount(1);
+}
+
+HistoryVerificationJob::~HistoryVerificationJob() {
+    ++generation_;
+    pool_.waitForDone();
+}
+
+void HistoryVerificationJob::start(const app::Document* document) {
+    if (!document) {
+        return;
+    }
+    const uint64_t generation = ++generation_;
+    std::shared_ptr<app::Document> snapshot = document->createSnapshot();
+    const QString opsHash = HistoryIO::computeOpsHash(document->operations());
+
+    pool_.start([this, generation, snapshot, opsHash]() {
+        QElapsedTimer timer;
+        timer.start();
+
+        HistoryVerificationResult result;
+        try {
+            result = verify(*snapshot);
+        } catch (...) {
+            result.success = false;
+            result.errorMessage = "Unexpected exception while regenerating history";
+        }
+        result.opsHash = opsHash;
+        qCInfo(logHistoryVerification) << "Verified" << snapshot->operations().size()
+                                       << "operations in" << timer.elapsed() << "ms,"
+                                       << result.changedBodies.size() << "bodies changed";
+
+        QMetaObject::invokeMethod(this, [this, generation, result]() {
+            if (generation == generation_) {
+                emit finished(result);
+            }
+        }, Qt::QueuedConnection);
+    });
+}
+
+void HistoryVerificationJob::cancel() {
+    ++generation_;
+}
+
+HistoryVerificationResult HistoryVerificationJob::verify(app::Document& snapshot) {
+    ONECAD_TRACE_SCOPE("io", "verifyHistory");
+    // Only loaded bodies are compared; pending ones were never shown
+    std::unordered_map<std::string, TopoDS_Shape> cached;
+    for (const auto& bodyId : snapshot.getBodyIds()) {
+        if (!snapshot.isBodyLoaded(bodyId)) {
+            continue;
+        }
+        const TopoDS_Shape shape = *snapshot.getBodyShape(bodyId);
+        if (snapshot.isBaseBody(bodyId)) {
+            // Shared with the open document; modelling algorithms may add to their inputs
+            snapshot.updateBodyShape(bodyId, BRepBuilderAPI_Copy(shape).Shape(), false);
+        } else {
+            cached[bodyId] = shape;
+        }
+    }
+
+    HistoryVerificationResult result;
+    result.success = DocumentIO::regenerateFromHistory(&snapshot, result.errorMessage);
+    result.failures = snapshot.operationFailures();
+
+    for (const auto& [bodyId, shape] : cached) {
+        if (!snapshot.isBodyLoaded(bodyId)) {
+            continue;  // Not produced again; reported through the failed operation
+        }
+        const TopoDS_Shape* regenerated = snapshot.getBodyShape(bodyId);
+        if (regenerated && !regenerated->IsNull() && !sameGeometry(shape, *regenerated)) {
+            result.changedBodies[bodyId] = *regenerated;
+        }
+    }
+    return result;
+}
+
+bool HistoryVerificationJob::apply(app::Document* document, const HistoryVerificationResult& result) {
+    if (!document || !document->isHistoryVerificationPending()) {
+        return true;
+    }
+    if (HistoryIO::computeOpsHash(document->operations()) != result.opsHash) {
+        return false;
+    }
+
+    const bool wasModified = document->isModified();
+    document->clearOperationFailures();
+    for (const auto& [opId, reason] : result.failures) {
+        document->setOperationFailed(opId, reason);
+    }
+    for (const auto& [bodyId, shape] : result.changedBodies) {
+        qCWarning(logHistoryVerification) << "Cached body differs from history:"
+                                          << QString::fromStdString(bodyId);
+        document->updateBodyShape(bodyId, shape);
+    }
+    document->setHistoryVerificationPending(false);
+    document->setModified(wasModified || !result.changedBodies.empty());
+    return true;
+}
+
+} // namespace onecad::io
@@ -0,0 +1,88 @@
+/**
+ * @file HistoryVerificationJob.h
+ * @brief Background replay of history for documents opened from the BREP cache
+ */
+
+#pragma once
+
+#include <QObject>
+#include <QString>
+#include <QThreadPool>
+
+#include <TopoDS_Shape.hxx>
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+
+namespace onecad::app {
+class Document;
+}
+
+namespace onecad::io {
+
+/**
+ * @brief Outcome of replaying history on a document snapshot
+ */
+struct HistoryVerificationResult {
+    bool success = false;   ///< false on critical regeneration failure
+    QString errorMessage;
+    QString opsHash;        ///< Operations the snapshot was taken with
+    std::unordered_map<std::string, std::string> failures;       ///< opId -> reason
+    std::unordered_map<std::string, TopoDS_Shape> changedBodies; ///< Regenerated shapes that differ from the cache
+};
+
+/**
+ * @brief Verifies a trusted BREP cache by regenerating a snapshot on a worker thread
+ *
+ * start() takes Document::createSnapshot() on the calling thread; the
+ * replay runs on the snapshot, so the open document stays responsive and
+ * its lazy entries stay unloaded. finished() is emitted on the thread that
+ * owns the job; apply() then transfers failures and any bodies whose cached
+ * shape differs from the regenerated one.
+ */
+class HistoryVerificationJob : public QObject {
+    Q_OBJECT
+
+public:
+    explicit HistoryVerificationJob(QObject* parent = nullptr);
+    /** @brief Waits for a running verification; its result is dropped */
+    ~HistoryVerificationJob() override;
+
+    HistoryVerificationJob(const HistoryVerificationJob&) = delete;
+    HistoryVerificationJob& operator=(const HistoryVerificationJob&) = delete;
+
+    /**
+     * @brief Verify the document's history; a verification still running is superseded
+     */
+    void start(const app::Document* document);
+
+    /**
+     * @brief Drop the result of a running verification (e.g. the document was replaced)
+     */
+    void cancel();
+
+    /**
+     * @brief Replay history on a snapshot and compare bodies with their cached shapes
+     */
+    static HistoryVerificationResult verify(app::Document& snapshot);
+
+    /**
+     * @brief Apply a result to the document it was started for
+     *
+     * Clears the verification flag. Bodies are only replaced if they differ,
+     * which also marks the document modified so the stale cache is rewritten.
+     *
+     * @return false if the operations changed since start(); verify again
+     */
+    static bool apply(app::Document* document, const HistoryVerificationResult& result);
+
+signals:
+    void finished(const onecad::io::HistoryVerificationResult& result);
+
+private:
+    QThreadPool pool_;
+    uint64_t generation_ = 0;  // Results of older runs are ignored
+};
+
+} // namespace onecad::io
@@ -0,0 +1,232 @@
+/**
+ * @file IODeviceStream.h
+ * @brief std::streambuf adapters for streaming OCCT data through Qt I/O
+ */
+
+#pragma once
+
+#include <QByteArray>
+#include <QByteArrayView>
+#include <QCryptographicHash>
+#include <QIODevice>
+
+#include <algorithm>
+#include <streambuf>
+#include <vector>
+
+namespace onecad::io {
+
+/**
+ * @brief Buffered output streambuf writing to a QIODevice
+ *
+ * Lets std::ostream writers (BRepTools, BinTools) write directly into a
+ * package entry. Any failed device write puts the stream into a bad state.
+ */
+class IODeviceStreamBuf : public std::streambuf {
+public:
+    explicit IODeviceStreamBuf(QIODevice* device, std::size_t bufferSize = 64 * 1024)
+        : device_(device), buffer_(bufferSize) {
+        setp(buffer_.data(), buffer_.data() + buffer_.size());
+    }
+
+    ~IODeviceStreamBuf() override { sync(); }
+
+    IODeviceStreamBuf(const IODeviceStreamBuf&) = delete;
+    IODeviceStreamBuf& operator=(const IODeviceStreamBuf&) = delete;
+
+protected:
+    int_type overflow(int_type ch) override {
+        if (!flushBuffer()) {
+            return traits_type::eof();
+        }
+        if (!traits_type::eq_int_type(ch, traits_type::eof())) {
+            *pptr() = traits_type::to_char_type(ch);
+            pbump(1);
+        }
+        return traits_type::not_eof(ch);
+    }
+
+    int sync() override { return flushBuffer() ? 0 : -1; }
+
+    std::streamsize xsputn(const char* data, std::streamsize count) override {
+        // Large blocks bypass the buffer
+        if (count >= static_cast<std::streamsize>(buffer_.size())) {
+            if (!flushBuffer()) {
+                return 0;
+            }
+            return device_->write(data, count) == count ? count : 0;
+        }
+        return std::streambuf::xsputn(data, count);
+    }
+
+private:
+    bool flushBuffer() {
+        const qint64 pending = pptr() - pbase();
+        if (pending > 0 && device_->write(pbase(), pending) != pending) {
+            return false;
+        }
+        setp(buffer_.data(), buffer_.data() + buffer_.size());
+        return true;
+    }
+
+    QIODevice* device_;
+    std::vector<char> buffer_;
+};
+
+/**
+ * @brief Buffered output streambuf hashing everything written
+ *
+ * Forwards the data to an optional target streambuf, so an entry can be
+ * hashed while it is streamed into a package, or hashed without storing it.
+ */
+class HashingStreamBuf : public std::streambuf {
+public:
+    explicit HashingStreamBuf(QCryptographicHash& hash, std::streambuf* target = nullptr,
+                              std::size_t bufferSize = 64 * 1024)
+        : hash_(hash), target_(target), buffer_(bufferSize) {
+        setp(buffer_.data(), buffer_.data() + buffer_.size());
+    }
+
+    ~HashingStreamBuf() override { sync(); }
+
+    HashingStreamBuf(const HashingStreamBuf&) = delete;
+    HashingStreamBuf& operator=(const HashingStreamBuf&) = delete;
+
+protected:
+    int_type overflow(int_type ch) override {
+        if (!flushBuffer()) {
+            return traits_type::eof();
+        }
+        if (!traits_type::eq_int_type(ch, traits_type::eof())) {
+            *pptr() = traits_type::to_char_type(ch);
+            pbump(1);
+        }
+        return traits_type::not_eof(ch);
+    }
+
+    int sync() override {
+        if (!flushBuffer()) {
+            return -1;
+        }
+        return target_ ? target_->pubsync() : 0;
+    }
+
+private:
+    bool flushBuffer() {
+        const std::streamsize pending = pptr() - pbase();
+        if (pending > 0) {
+            hash_.addData(QByteArrayView(pbase(), static_cast<qsizetype>(pending)));
+            if (target_ && target_->sputn(pbase(), pending) != pending) {
+                return false;
+            }
+        }
+        setp(buffer_.data(), buffer_.data() + buffer_.size());
+        return true;
+    }
+
+    QCryptographicHash& hash_;
+    std::streambuf* target_;
+    std::vector<char> buffer_;
+};
+
+/**
+ * @brief Buffered input streambuf reading from a QIODevice
+ *
+ * Lets std::istream readers (BRepTools, BinTools) parse a package entry
+ * without loading it whole. Seeking is forwarded to random-access devices;
+ * sequential devices (compressed ZIP entries) only report their position.
+ */
+class IODeviceInputStreamBuf : public std::streambuf {
+public:
+    explicit IODeviceInputStreamBuf(QIODevice* device, std::size_t bufferSize = 64 * 1024)
+        : device_(device), buffer_(bufferSize) {
+        setg(buffer_.data(), buffer_.data(), buffer_.data());
+    }
+
+    IODeviceInputStreamBuf(const IODeviceInputStreamBuf&) = delete;
+    IODeviceInputStreamBuf& operator=(const IODeviceInputStreamBuf&) = delete;
+
+protected:
+    int_type underflow() override {
+        if (gptr() < egptr()) {
+            return traits_type::to_int_type(*gptr());
+        }
+        const qint64 count = device_->read(buffer_.data(), static_cast<qint64>(buffer_.size()));
+        if (count <= 0) {
+            return traits_type::eof();
+        }
+        setg(buffer_.data(), buffer_.data(), buffer_.data() + count);
+        return traits_type::to_int_type(*gptr());
+    }
+
+    pos_type seekoff(off_type offset, std::ios_base::seekdir dir,
+                     std::ios_base::openmode which) override {
+        if (!(which & std::ios_base::in)) {
+            return pos_type(off_type(-1));
+        }
+        const off_type current = device_->pos() - (egptr() - gptr());
+        if (dir == std::ios_base::cur && offset == 0) {
+            return pos_type(current);
+        }
+        off_type base = current;
+        if (dir == std::ios_base::beg) {
+            base = 0;
+        } else if (dir == std::ios_base::end) {
+            base = device_->size();
+        }
+        return seekpos(pos_type(base + offset), which);
+    }
+
+    pos_type seekpos(pos_type position, std::ios_base::openmode which) override {
+        if (!(which & std::ios_base::in) || device_->isSequential() ||
+            !device_->seek(off_type(position))) {
+            return pos_type(off_type(-1));
+        }
+        setg(buffer_.data(), buffer_.data(), buffer_.data());
+        return position;
+    }
+
+private:
+    QIODevice* device_;
+    std::vector<char> buffer_;
+};
+
+/**
+ * @brief Read-only streambuf over QByteArray storage (no copy)
+ *
+ * The byte array must outlive the stream. Seeking is supported for readers
+ * that reposition within the data.
+ */
+class ByteArrayStreamBuf : public std::streambuf {
+public:
+    explicit ByteArrayStreamBuf(const QByteArray& data) {
+        char* begin = const_cast<char*>(data.constData());
+        setg(begin, begin, begin + data.size());
+    }
+
+protected:
+    pos_type seekoff(off_type offset, std::ios_base::seekdir dir,
+                     std::ios_base::openmode which) override {
+        if (!(which & std::ios_base::in)) {
+            return pos_type(off_type(-1));
+        }
+        off_type base = 0;
+        if (dir == std::ios_base::cur) {
+            base = gptr() - eback();
+        } else if (dir == std::ios_base::end) {
+            base = egptr() - eback();
+        }
+        return seekpos(pos_type(base + offset), which);
+    }
+
+    pos_type seekpos(pos_type position, std::ios_base::openmode which) override {
+        const off_type offset = off_type(position);
+        if (!(which & std::ios_base::in) || offset < 0 || offset > egptr() - eback()) {
+            return pos_type(off_type(-1));
+        }
+        setg(eback(), eback() + offset, egptr());
+        return position;
+    }
+};
+
+} // namespace onecad::io
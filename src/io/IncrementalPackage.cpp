@@ -0,0 +1,126 @@
+/**
+ * @file IncrementalPackage.cpp
+ * @brief Implementation of the incremental save package wrapper
+ */
+
+#include "IncrementalPackage.h"
+#include "IODeviceStream.h"
+#include "../core/trace/Trace.h"
+
+#include <QCryptographicHash>
+
+#include <ostream>
+
+namespace onecad::io {
+
+IncrementalPackage::IncrementalPackage(Package* target,
+                                       Package* baseline,
+                                       QJsonObject baselineEntries,
+                                       bool trustBaseline)
+    : target_(target),
+      baseline_(baseline),
+      baselineEntries_(std::move(baselineEntries)),
+      trustBaseline_(trustBaseline && baseline) {}
+
+QByteArray IncrementalPackage::readFile(const QString& path) {
+    return target_->readFile(path);
+}
+
+bool IncrementalPackage::readFileStreamed(const QString& path, const DeviceReader& reader) {
+    return target_->readFileStreamed(path, reader);
+}
+
+bool IncrementalPackage::fileExists(const QString& path) const {
+    return target_->fileExists(path);
+}
+
+QStringList IncrementalPackage::listFiles(const QString& prefix) const {
+    return target_->listFiles(prefix);
+}
+
+bool IncrementalPackage::writeFile(const QString& path, const QByteArray& data) {
+    const QString hash = hashData(data);
+    if (baselineEntries_.value(path).toString() == hash && copyFromBaseline(path, hash)) {
+        return true;
+    }
+
+    if (!target_->writeFile(path, data)) {
+        return false;
+    }
+    entryHashes_[path] = hash;
+    ++writtenCount_;
+    return true;
+}
+
+bool IncrementalPackage::writeFileStreamed(const QString& path, const StreamWriter& writer) {
+    QCryptographicHash hash(QCryptographicHash::Sha256);
+    bool ok = target_->writeFileStreamed(path, [&](std::ostream& stream) {
+        HashingStreamBuf streamBuf(hash, stream.rdbuf());
+        std::ostream hashingStream(&streamBuf);
+        bool written = writer(hashingStream);
+        hashingStream.flush();
+        return written && hashingStream.good();
+    });
+    if (!ok) {
+        return false;
+    }
+    entryHashes_[path] = QString::fromLatin1(hash.result().toHex());
+    ++writtenCount_;
+    return true;
+}
+
+bool IncrementalPackage::reuseFile(const QString& path, const QString& contentHash) {
+    if (!baseline_) {
+        return false;
+    }
+    const QString storedHash = baselineEntries_.value(path).toString();
+    if (storedHash.isEmpty()) {
+        return false;
+    }
+    if (contentHash.isEmpty() ? !trustBaseline_ : contentHash != storedHash) {
+        return false;
+    }
+    return copyFromBaseline(path, storedHash);
+}
+
+bool IncrementalPackage::readReusableFileStreamed(const QString& path,
+                                                  const DeviceReader& reader) {
+    if (!baseline_ || baselineEntries_.value(path).toString().isEmpty()) {
+        return false;
+    }
+    return baseline_->readFileStreamed(path, reader);
+}
+
+bool IncrementalPackage::copyFromBaseline(const QString& path, const QString& hash) {
+    if (!baseline_ || !target_->copyFile(*baseline_, path)) {
+        return false;
+    }
+    entryHashes_[path] = hash;
+    ++reusedCount_;
+    return true;
+}
+
+bool IncrementalPackage::finalize() {
+    ONECAD_TRACE_SCOPE("io", "finalize");
+    // Entries of the baseline that this save no longer produces
+    for (auto it = baselineEntries_.begin(); it != baselineEntries_.end(); ++it) {
+        if (!entryHashes_.contains(it.key())) {
+            target_->removeFile(it.key());
+        }
+    }
+    return target_->finalize();
+}
+
+QString IncrementalPackage::errorString() const {
+    return target_->errorString();
+}
+
+bool IncrementalPackage::isValid() const {
+    return target_ && target_->isValid();
+}
+
+QString IncrementalPackage::hashData(const QByteArray& data) {
+    return QString::fromLatin1(QCryptographicHash::hash(data, QCryptographicHash::Sha256).toHex());
+}
+
+} // namespace onecad::io
@@ -0,0 +1,80 @@
+/**
+ * @file IncrementalPackage.h
+ * @brief Package decorator that records entry hashes and reuses unchanged entries
+ */
+
+#pragma once
+
+#include "Package.h"
+
+#include <QJsonObject>
+
+namespace onecad::io {
+
+/**
+ * @brief Write-side package wrapper used by OneCADFileIO::save
+ *
+ * Every entry written through it is hashed (SHA-256) so the manifest can
+ * list the package contents. Given the package being replaced (the
+ * baseline) and the hashes from its manifest, entries whose content did
+ * not change are copied from the baseline instead of being written:
+ * - writeFile(): the data is hashed and compared with the baseline
+ * - reuseFile(): the caller vouches for the content (e.g. an unmodified
+ *   body BREP) or supplies its hash, so it is never serialized
+ *
+ * On finalize(), baseline entries that were neither written nor reused
+ * are removed from the target (directory packages saved in place).
+ */
+class IncrementalPackage : public Package {
+public:
+    /**
+     * @param target Package being written
+     * @param baseline Package this save replaces (may be null)
+     * @param baselineEntries Manifest "entries" of the baseline (path -> SHA-256)
+     * @param trustBaseline Allow reuseFile() without a hash; the caller's
+     *        change tracking refers to this baseline
+     */
+    IncrementalPackage(Package* target,
+                       Package* baseline = nullptr,
+                       QJsonObject baselineEntries = {},
+                       bool trustBaseline = false);
+
+    // Package interface
+    QByteArray readFile(const QString& path) override;
+    bool readFileStreamed(const QString& path, const DeviceReader& reader) override;
+    bool fileExists(const QString& path) const override;
+    QStringList listFiles(const QString& prefix) const override;
+    bool writeFile(const QString& path, const QByteArray& data) override;
+    bool writeFileStreamed(const QString& path, const StreamWriter& writer) override;
+    bool reuseFile(const QString& path, const QString& contentHash = {}) override;
+    bool readReusableFileStreamed(const QString& path, const DeviceReader& reader) override;
+    bool finalize() override;
+    QString errorString() const override;
+    bool isValid() const override;
+
+    /**
+     * @brief Hex SHA-256 of every entry in the package (path -> hash)
+     */
+    const QJsonObject& entryHashes() const { return entryHashes_; }
+
+    /**
+     * @brief SHA-256 hex digest of entry data
+     */
+    static QString hashData(const QByteArray& data);
+
+    size_t writtenCount() const { return writtenCount_; }
+    size_t reusedCount() const { return reusedCount_; }
+
+private:
+    bool copyFromBaseline(const QString& path, const QString& hash);
+
+    Package* target_;
+    Package* baseline_;
+    QJsonObject baselineEntries_;
+    bool trustBaseline_;
+    QJsonObject entryHashes_;
+    size_t writtenCount_ = 0;
+    size_t reusedCount_ = 0;
+};
+
+} // namespace onecad::io
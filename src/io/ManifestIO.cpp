@@ -8,11 +8,14 @@
 #include "../app/document/Document.h"
 
 #include <QCoreApplication>
+#include <Standard_Version.hxx>
 
 namespace onecad::io {
 
 QJsonObject ManifestIO::createManifest(const app::Document* document,
-                                        const QString& opsHash) {
+                                        const QString& opsHash,
+                                        const QString& elementMapHash,
+                                        const QJsonObject& entryHashes) {
     QJsonObject manifest;
     
     // Magic and version
@@ -43,14 +46,42 @@ QJsonObject ManifestIO::createManifest(const app::Document* document,
     contents["sketchCount"] = static_cast<int>(document->sketchCount());
     contents["bodyCount"] = static_cast<int>(document->bodyCount());
     contents["operationCount"] = static_cast<int>(document->operations().size());
+
+    // BREP cache is only complete if every body reflects a successful regeneration
+    bool bodyCacheComplete = document->operationFailures().empty();
+    for (const auto& bodyId : document->getBodyIds()) {
+        if (!document->isBodyLoaded(bodyId)) {
+            continue;  // Still pending from a trusted cache; loading it here would defeat lazy loading
+        }
+        const TopoDS_Shape* shape = document->getBodyShape(bodyId);
+        if (!shape || shape->IsNull()) {
+            bodyCacheComplete = false;
+        }
+    }
+    contents["bodyCacheComplete"] = bodyCacheComplete;
     manifest["contents"] = contents;
+
+    QJsonObject kernel;
+    kernel["name"] = "OCCT";
+    kernel["version"] = kernelVersion();
+    manifest["kernel"] = kernel;
     
     // Hashes for integrity checking
-    if (!opsHash.isEmpty()) {
+    if (!opsHash.isEmpty() || !elementMapHash.isEmpty()) {
         QJsonObject hashes;
-        hashes["opsHash"] = opsHash;
+        if (!opsHash.isEmpty()) {
+            hashes["opsHash"] = opsHash;
+        }
+        if (!elementMapHash.isEmpty()) {
+            hashes["elementMapHash"] = elementMapHash;
+        }
         manifest["hashes"] = hashes;
     }
+
+    // Table of contents with content hashes (incremental save)
+    if (!entryHashes.isEmpty()) {
+        manifest["entries"] = entryHashes;
+    }
     
     return manifest;
 }
@@ -94,4 +125,31 @@ bool ManifestIO::isVersionCompatible(const QString& version) {
     return false;
 }
 
+QString ManifestIO::kernelVersion() {
+    return QString::fromLatin1(OCC_VERSION_COMPLETE);
+}
+
+QString ManifestIO::checkBodyCache(const QJsonObject& manifest,
+                                   const QString& opsHash,
+                                   const QString& elementMapHash) {
+    if (!manifest["contents"].toObject()["bodyCacheComplete"].toBool(false)) {
+        return "BREP cache not marked complete";
+    }
+
+    QString storedKernel = manifest["kernel"].toObject()["version"].toString();
+    if (storedKernel != kernelVersion()) {
+        return QString("Kernel version changed: %1 -> %2").arg(storedKernel, kernelVersion());
+    }
+
+    QJsonObject hashes = manifest["hashes"].toObject();
+    if (opsHash.isEmpty() || hashes["opsHash"].toString() != opsHash) {
+        return "Operations hash mismatch";
+    }
+    if (elementMapHash.isEmpty() || hashes["elementMapHash"].toString() != elementMapHash) {
+        return "ElementMap hash mismatch";
+    }
+
+    return {};  // Trusted
+}
+
 } // namespace onecad::io
@@ -33,9 +33,13 @@ class ManifestIO {
 public:
     /**
      * @brief Create manifest JSON for document
+     * @param entryHashes Package contents (path -> SHA-256), written as "entries";
+     *        incremental saves compare against it
      */
     static QJsonObject createManifest(const app::Document* document,
-                                       const QString& opsHash = {});
+                                       const QString& opsHash = {},
+                                       const QString& elementMapHash = {},
+                                       const QJsonObject& entryHashes = {});
     
     /**
      * @brief Validate manifest JSON
@@ -52,6 +56,24 @@ public:
      * @brief Check if format version is compatible
      */
     static bool isVersionCompatible(const QString& version);
+
+    /**
+     * @brief Geometry kernel version recorded with the BREP cache
+     */
+    static QString kernelVersion();
+
+    /**
+     * @brief Check whether stored body BREPs can be used instead of regenerating
+     *
+     * The cache is trusted when it was written from a fully regenerated
+     * document by the same kernel version, and the ops and element map hashes
+     * match the loaded history and topology/elementmap.json.
+     *
+     * @return Empty string if trusted, reason otherwise
+     */
+    static QString checkBodyCache(const QJsonObject& manifest,
+                                  const QString& opsHash,
+                                  const QString& elementMapHash);
     
 private:
     ManifestIO() = delete;
@@ -9,17 +9,26 @@
 #include "ManifestIO.h"
 #include "DocumentIO.h"
 #include "HistoryIO.h"
+#include "IncrementalPackage.h"
+#include "PackageEntryLoader.h"
 #include "../app/document/Document.h"
+#include "../core/trace/Trace.h"
 
 #include <QJsonDocument>
 #include <QBuffer>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <filesystem>
 #include <optional>
+#include <system_error>
 
 namespace onecad::io {
 
 namespace {
 
 std::optional<QJsonObject> readAndValidateManifest(Package* package, QString& errorMessage) {
+    ONECAD_TRACE_SCOPE("io", "readManifest");
     if (!package) {
         errorMessage = "Invalid package";
         return std::nullopt;
@@ -50,35 +59,69 @@ std::optional<QJsonObject> readAndValidateManifest(Package* package, QString& er
 } // namespace
 
 FileIOResult OneCADFileIO::save(const QString& filepath,
-                                 const app::Document* document,
+                                 app::Document* document,
                                  const QImage& thumbnail) {
+    ONECAD_TRACE_SCOPE("io", "save");
     FileIOResult result;
     result.filepath = filepath;
 
-    // 1. Create package for writing
-    auto package = Package::createForWrite(filepath);
-    if (!package) {
-        result.errorMessage = QString("Failed to create file: %1").arg(filepath);
-        return result;
+    QElapsedTimer timer;
+    timer.start();
+    const QString absolutePath = QFileInfo(filepath).absoluteFilePath();
+
+    // 1. Package this save replaces: unchanged entries are carried over
+    std::unique_ptr<Package> baseline;
+    QJsonObject baselineEntries;
+    if (QFileInfo::exists(filepath)) {
+        baseline = Package::openForRead(filepath);
+        QString ignored;
+        std::optional<QJsonObject> baselineManifest;
+        if (baseline) {
+            baselineManifest = readAndValidateManifest(baseline.get(), ignored);
+        }
+        if (baselineManifest) {
+            baselineEntries = (*baselineManifest)["entries"].toObject();
+        }
+        if (baselineEntries.isEmpty()) {
+            baseline.reset();  // Older file without a table of contents
+        }
     }
+    // Body change tracking only refers to the file the document came from
+    const bool trustBaseline = baseline && document->saveBaselinePath() == absolutePath;
 
-    // 2. Compute operations hash for manifest
-    QString opsHash = HistoryIO::computeOpsHash(document->operations());
+    // 2. Directories are updated in place; ZIPs are written beside the file
+    //    and renamed over it, so the baseline stays readable until then
+    const bool inPlace = Package::writesDirectory(filepath);
+    const QString writePath = inPlace ? filepath : filepath + ".saving";
+    if (!inPlace) {
+        QFile::remove(writePath);
+    }
 
-    // 3. Write manifest.json first
-    QJsonObject manifest = ManifestIO::createManifest(document, opsHash);
-    if (!package->writeFile("manifest.json", JSONUtils::toCanonicalJson(manifest))) {
-        result.errorMessage = "Failed to write manifest.json";
+    auto target = Package::createForWrite(writePath);
+    if (!target) {
+        result.errorMessage = QString("Failed to create file: %1").arg(filepath);
         return result;
     }
+    IncrementalPackage package(target.get(), baseline.get(), baselineEntries, trustBaseline);
 
-    // 4. Save all document components
-    if (!DocumentIO::saveDocument(package.get(), document)) {
-        result.errorMessage = "Failed to save document contents: " + package->errorString();
+    auto fail = [&](const QString& message) {
+        result.errorMessage = message;
+        target.reset();
+        if (!inPlace) {
+            QFile::remove(writePath);
+        }
         return result;
+    };
+
+    // 3. Save all document components (binary BREP in ZIPs, text in Git-friendly directories)
+    const BRepFormat brepFormat = filepath.endsWith(".onecadpkg", Qt::CaseInsensitive)
+                                      ? BRepFormat::Text
+                                      : BRepFormat::Binary;
+    if (!DocumentIO::saveDocument(&package, document, brepFormat)) {
+        return fail("Failed to save document contents: " + package.errorString());
     }
 
-    // 5. Write thumbnail if provided
+    // 4. Write thumbnail if provided
     if (!thumbnail.isNull()) {
         QByteArray pngData;
         QBuffer buffer(&pngData);
@@ -86,18 +129,63 @@ FileIOResult OneCADFileIO::save(const QString& filepath,
         thumbnail.save(&buffer, "PNG");
         buffer.close();
 
-        if (!package->writeFile("thumbnail.png", pngData)) {
-            qWarning() << "Thumbnail write failed:" << package->errorString();
+        if (!package.writeFile("thumbnail.png", pngData)) {
+            qWarning() << "Thumbnail write failed:" << package.errorString();
             // Don't fail save - thumbnail is optional
         }
     }
 
-    // 6. Finalize package
-    if (!package->finalize()) {
-        result.errorMessage = "Failed to finalize file: " + package->errorString();
-        return result;
+    // 5. Write manifest.json last, with hashes of the final content
+    //    (ops hash and ElementMap hash validate the BREP cache on load)
+    const QJsonObject entryHashes = package.entryHashes();
+    QJsonObject manifest = ManifestIO::createManifest(
+        document,
+        HistoryIO::computeOpsHash(document->operations()),
+        entryHashes["topology/elementmap.json"].toString(),
+        entryHashes);
+    if (!target->writeFile("manifest.json", JSONUtils::toCanonicalJson(manifest))) {
+        return fail("Failed to write manifest.json");
     }
 
+    // 6. Finalize package (drops entries the document no longer has)
+    if (!package.finalize()) {
+        return fail("Failed to finalize file: " + target->errorString());
+    }
+    baseline.reset();
+    target.reset();
+
+    // Pending entries are read from the file being replaced; release it meanwhile
+    auto* lazySource = dynamic_cast<PackageEntryLoader*>(document->entryLoader());
+    const bool reopenSource = !inPlace && lazySource && lazySource->filepath() == absolutePath;
+    if (reopenSource) {
+        lazySource->close();
+    }
+
+    if (!inPlace) {
+        std::error_code error;
+        std::filesystem::rename(std::filesystem::path(writePath.toStdU16String()),
+                                std::filesystem::path(filepath.toStdU16String()), error);
+        if (reopenSource && !lazySource->reopen(absolutePath)) {
+            // The entries are in the saved file and later in-place saves keep them
+            qWarning() << "Failed to reopen" << filepath << "for pending entries";
+            result.warnings.append(
+                QString("%1 was saved, but %2 item(s) not opened yet cannot be loaded "
+                        "until the file is reopened.")
+                    .arg(filepath)
+                    .arg(document->pendingEntryCount()));
+        }
+        if (error) {
+            return fail(QString("Failed to replace %1: %2")
+                            .arg(filepath, QString::fromStdString(error.message())));
+        }
+    }
+
+    document->markAllBodyShapesSaved();
+    document->setSaveBaselinePath(absolutePath);
+
+    qInfo() << "Saved" << filepath << "in" << timer.elapsed() << "ms:"
+            << package.writtenCount() << "entries written," << package.reusedCount() << "reused";
+
     result.success = true;
     return result;
 }
@@ -105,6 +193,7 @@ FileIOResult OneCADFileIO::save(const QString& filepath,
 std::unique_ptr<app::Document> OneCADFileIO::load(const QString& filepath,
                                                    QString& errorMessage,
                                                    QObject* parent) {
+    ONECAD_TRACE_SCOPE("io", "load");
     // 1. Open package for reading
     auto package = Package::openForRead(filepath);
     if (!package) {
@@ -113,12 +202,24 @@ std::unique_ptr<app::Document> OneCADFileIO::load(const QString& filepath,
     }
     
     // 2. Read and validate manifest
-    if (!readAndValidateManifest(package.get(), errorMessage)) {
+    auto manifest = readAndValidateManifest(package.get(), errorMessage);
+    if (!manifest) {
         return nullptr;
     }
     
-    // 3. Load document
-    return DocumentIO::loadDocument(package.get(), parent, errorMessage);
+    // 3. Load document (manifest decides whether the BREP cache is trusted);
+    //    the package stays open for sketches and hidden bodies loaded on demand
+    const QString absolutePath = QFileInfo(filepath).absoluteFilePath();
+    auto loader = std::make_shared<PackageEntryLoader>(absolutePath, std::move(package));
+    auto document = DocumentIO::loadDocument(loader->package(), parent, errorMessage,
+                                             *manifest, loader);
+    if (document) {
+        document->setSaveBaselinePath(absolutePath);
+        if (document->pendingEntryCount() == 0) {
+            document->setEntryLoader(nullptr);  // Everything is loaded; release the file
+        }
+    }
+    return document;
 }
 
 FileIOResult OneCADFileIO::validate(const QString& filepath) {
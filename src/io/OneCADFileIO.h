@@ -6,6 +6,7 @@
 #pragma once
 
 #include <QString>
+#include <QStringList>
 #include <QImage>
 #include <memory>
 
@@ -22,6 +23,7 @@ struct FileIOResult {
     bool success = false;
     QString errorMessage;
     QString filepath;
+    QStringList warnings;  ///< Problems that did not fail the operation
     
     operator bool() const { return success; }
 };
@@ -37,16 +39,25 @@ public:
     /**
      * @brief Save document to .onecad file
      * @param filepath Path to save (creates/overwrites)
-     * @param document Document to save
+     * @param document Document to save; its save baseline is updated on success
      * @param thumbnail Optional viewport thumbnail (stored as thumbnail.png)
      * @return Result with success status and any error message
+     *
+     * Saving over an existing package is incremental: entries whose content
+     * is unchanged (per the old manifest's hashes, or unmodified bodies when
+     * saving back to the file the document came from) are copied over
+     * instead of being serialized again.
      */
     static FileIOResult save(const QString& filepath,
-                             const app::Document* document,
+                             app::Document* document,
                              const QImage& thumbnail = QImage());
     
     /**
      * @brief Load document from .onecad file
+     *
+     * Sketches and hidden bodies are loaded on first access; the document
+     * keeps the package open for them (see PackageEntryLoader).
+     *
      * @param filepath Path to load
      * @param parent QObject parent for the new Document
      * @return Loaded document, or nullptr on error
@@ -6,9 +6,13 @@
 #include "Package.h"
 #include "ZipPackage.h"
 #include "DirectoryPackage.h"
+#include "IODeviceStream.h"
 
+#include <QBuffer>
 #include <QFileInfo>
 
+#include <ostream>
+
 namespace onecad::io {
 
 std::unique_ptr<Package> Package::openForRead(const QString& path) {
@@ -33,19 +37,75 @@ std::unique_ptr<Package> Package::openForRead(const QString& path) {
 }
 
 std::unique_ptr<Package> Package::createForWrite(const QString& path) {
-    // If it ends with .onecadpkg, use DirectoryPackage
-    if (path.endsWith(".onecadpkg", Qt::CaseInsensitive)) {
+    if (writesDirectory(path)) {
         return DirectoryPackage::createWrite(path);
     }
-    
-    // Check if ZIP is supported
-    if (ZipPackage::isSupported()) {
-        return ZipPackage::createWrite(path);
+    return ZipPackage::createWrite(path);
+}
+
+bool Package::writesDirectory(const QString& path) {
+    // .onecadpkg is always a directory; without ZIP support every package is
+    // a directory so saving still works on systems without QuaZip
+    return path.endsWith(".onecadpkg", Qt::CaseInsensitive) || !ZipPackage::isSupported();
+}
+
+bool Package::readFileStreamed(const QString& path, const DeviceReader& reader) {
+    QByteArray data = readFile(path);
+    if (data.isEmpty()) {
+        return false;
     }
-    
-    // Fallback: If ZIP not supported, use DirectoryPackage regardless of extension
-    // This allows saving on systems without QuaZip
-    return DirectoryPackage::createWrite(path);
+    QBuffer buffer(&data);
+    buffer.open(QIODevice::ReadOnly);
+    return reader(buffer);
+}
+
+bool Package::writeFileStreamed(const QString& path, const StreamWriter& writer) {
+    QByteArray data;
+    QBuffer buffer(&data);
+    buffer.open(QIODevice::WriteOnly);
+    if (!writeToDevice(&buffer, writer)) {
+        return false;
+    }
+    buffer.close();
+    return writeFile(path, data);
+}
+
+bool Package::copyFile(Package& source, const QString& path) {
+    return source.readFileStreamed(path, [&](QIODevice& device) {
+        return writeFileStreamed(path, [&](std::ostream& stream) {
+            char buffer[64 * 1024];
+            qint64 count = 0;
+            while ((count = device.read(buffer, sizeof(buffer))) > 0) {
+                stream.write(buffer, count);
+            }
+            return count == 0 && stream.good();
+        });
+    });
+}
+
+bool Package::reuseFile(const QString& path, const QString& contentHash) {
+    Q_UNUSED(path);
+    Q_UNUSED(contentHash);
+    return false;
+}
+
+bool Package::readReusableFileStreamed(const QString& path, const DeviceReader& reader) {
+    Q_UNUSED(path);
+    Q_UNUSED(reader);
+    return false;
+}
+
+bool Package::removeFile(const QString& path) {
+    Q_UNUSED(path);
+    return false;
+}
+
+bool Package::writeToDevice(QIODevice* device, const StreamWriter& writer) {
+    IODeviceStreamBuf streamBuf(device);
+    std::ostream stream(&streamBuf);
+    bool ok = writer(stream);
+    stream.flush();
+    return ok && stream.good();
 }
 
 } // namespace onecad::io
@@ -12,8 +12,12 @@
 #include <QByteArray>
 #include <QString>
 #include <QStringList>
+#include <functional>
+#include <iosfwd>
 #include <memory>
 
+class QIODevice;
+
 namespace onecad::io {
 
 /**
@@ -44,6 +48,26 @@ public:
      * @return File contents, or empty QByteArray if not found
      */
     virtual QByteArray readFile(const QString& path) = 0;
+
+    /**
+     * @brief Callback consuming file contents from an open device
+     *
+     * The device is read-only and positioned at the start of the entry;
+     * peek() can be used to inspect headers. It is closed after the callback.
+     * @return false to report a read failure
+     */
+    using DeviceReader = std::function<bool(QIODevice& device)>;
+
+    /**
+     * @brief Read file from package without buffering it whole
+     * @param path Internal path
+     * @param reader Callback that consumes the contents
+     * @return false if the file is missing or the reader failed
+     *
+     * Backends hand out the package entry device directly; the default
+     * implementation wraps readFile() in a QBuffer.
+     */
+    virtual bool readFileStreamed(const QString& path, const DeviceReader& reader);
     
     /**
      * @brief Check if file exists in package
@@ -68,6 +92,58 @@ public:
      * @return true on success
      */
     virtual bool writeFile(const QString& path, const QByteArray& data) = 0;
+
+    /**
+     * @brief Callback producing file contents on a stream
+     * @return false to abort the write
+     */
+    using StreamWriter = std::function<bool(std::ostream&)>;
+
+    /**
+     * @brief Write file to package from a stream writer
+     * @param path Internal path
+     * @param writer Callback that writes the contents
+     * @return true on success
+     *
+     * Backends stream straight into the package entry; the default
+     * implementation buffers into writeFile().
+     */
+    virtual bool writeFileStreamed(const QString& path, const StreamWriter& writer);
+
+    /**
+     * @brief Copy an entry unchanged from another package
+     * @return true on success
+     *
+     * Backends copy stored bytes without re-encoding where they can (raw ZIP
+     * entries, nothing at all for the same directory); the default reads the
+     * entry and writes it again.
+     */
+    virtual bool copyFile(Package& source, const QString& path);
+
+    /**
+     * @brief Keep an entry from the package this save replaces
+     * @param contentHash SHA-256 the entry must have been stored with; empty
+     *        when the caller already knows the content is unchanged
+     * @return false if nothing was kept; the caller then writes the entry
+     *
+     * Only incremental save packages have a baseline; others return false.
+     */
+    virtual bool reuseFile(const QString& path, const QString& contentHash = {});
+
+    /**
+     * @brief Read the stored entry reuseFile() would keep, e.g. to peek its header
+     * @return false if there is no such entry (always, without a baseline)
+     */
+    virtual bool readReusableFileStreamed(const QString& path, const DeviceReader& reader);
+
+    /**
+     * @brief Remove an entry left over from an earlier save
+     * @return true if the entry was removed
+     *
+     * Only meaningful for directory packages; a ZIP being written contains
+     * nothing but what was written.
+     */
+    virtual bool removeFile(const QString& path);
     
     /**
      * @brief Finalize writing and close package
@@ -112,6 +188,17 @@ public:
      * If path ends with ".onecadpkg" or is a directory, creates directory package.
      */
     static std::unique_ptr<Package> createForWrite(const QString& path);
+
+    /**
+     * @brief Whether createForWrite() would write a directory package at path
+     */
+    static bool writesDirectory(const QString& path);
+
+    /**
+     * @brief Run a stream writer against an open device
+     * @return true if the writer succeeded and all data reached the device
+     */
+    static bool writeToDevice(QIODevice* device, const StreamWriter& writer);
     
 protected:
     Package() = default;
@@ -0,0 +1,89 @@
+/**
+ * @file PackageEntryLoader.cpp
+ * @brief Implementation of lazy sketch/body loading
+ */
+
+#include "PackageEntryLoader.h"
+#include "BRepIO.h"
+#include "Package.h"
+#include "SketchIO.h"
+#include "../core/sketch/Sketch.h"
+
+#include <QElapsedTimer>
+#include <QLoggingCategory>
+#include <QMutexLocker>
+
+Q_LOGGING_CATEGORY(logEntryLoader, "onecad.io.lazy")
+
+namespace onecad::io {
+
+PackageEntryLoader::PackageEntryLoader(const QString& filepath, std::unique_ptr<Package> package)
+    : filepath_(filepath), package_(std::move(package)) {}
+
+PackageEntryLoader::~PackageEntryLoader() = default;
+
+QString PackageEntryLoader::filepath() const {
+    QMutexLocker locker(&mutex_);
+    return filepath_;
+}
+
+void PackageEntryLoader::setBodyPath(const std::string& bodyId, const QString& brepPath) {
+    QMutexLocker locker(&mutex_);
+    bodyPaths_.insert(QString::fromStdString(bodyId), brepPath);
+}
+
+void PackageEntryLoader::close() {
+    QMutexLocker locker(&mutex_);
+    package_.reset();
+}
+
+bool PackageEntryLoader::reopen(const QString& filepath) {
+    QMutexLocker locker(&mutex_);
+    filepath_ = filepath;
+    package_ = Package::openForRead(filepath);
+    return package_ != nullptr;
+}
+
+std::unique_ptr<core::sketch::Sketch> PackageEntryLoader::loadSketch(const std::string& id,
+                                                                     std::string& errorMessage) {
+    QMutexLocker locker(&mutex_);
+    if (!package_) {
+        errorMessage = "Package is closed: " + filepath_.toStdString();
+        return nullptr;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    QString error;
+    auto sketch = SketchIO::loadSketch(package_.get(), QString::fromStdString(id), error);
+    if (!sketch) {
+        errorMessage = error.toStdString();
+        return nullptr;
+    }
+    qCDebug(logEntryLoader) << "sketch" << QString::fromStdString(id) << timer.elapsed() << "ms";
+    return sketch;
+}
+
+TopoDS_Shape PackageEntryLoader::loadBodyShape(const std::string& id, std::string& errorMessage) {
+    QMutexLocker locker(&mutex_);
+    if (!package_) {
+        errorMessage = "Package is closed: " + filepath_.toStdString();
+        return {};
+    }
+
+    const QString bodyId = QString::fromStdString(id);
+    const QString path = bodyPaths_.value(bodyId, QString("bodies/%1.brep").arg(bodyId));
+
+    QElapsedTimer timer;
+    timer.start();
+    QString error;
+    TopoDS_Shape shape = BRepIO::readShape(package_.get(), path, error);
+    if (shape.IsNull()) {
+        errorMessage = error.toStdString();
+        return {};
+    }
+    qCDebug(logEntryLoader) << "body" << bodyId << timer.elapsed() << "ms";
+    return shape;
+}
+
+} // namespace onecad::io
@@ -0,0 +1,73 @@
+/**
+ * @file PackageEntryLoader.h
+ * @brief Lazy sketch/body loading from an open package
+ */
+
+#pragma once
+
+#include "../app/document/DocumentEntryLoader.h"
+
+#include <QHash>
+#include <QMutex>
+#include <QString>
+
+#include <memory>
+
+namespace onecad::io {
+
+class Package;
+
+/**
+ * @brief Serves a document's pending entries from the package it was opened from
+ *
+ * Keeps the package open for the lifetime of the document (or until every
+ * entry is loaded). Reads are serialized with a mutex, so snapshots used
+ * by background saves may share the loader.
+ *
+ * OneCADFileIO::save() closes the package before replacing the file and
+ * reopens it afterwards; the new file holds the same pending entries.
+ */
+class PackageEntryLoader : public app::DocumentEntryLoader {
+public:
+    PackageEntryLoader(const QString& filepath, std::unique_ptr<Package> package);
+    ~PackageEntryLoader() override;
+
+    /**
+     * @brief Package file the entries are read from
+     */
+    QString filepath() const;
+
+    /**
+     * @brief Package while it is open (for the initial load on the calling thread)
+     */
+    Package* package() const { return package_.get(); }
+
+    /**
+     * @brief Record where a body's BREP is stored (bodies/{id}.json "brepPath")
+     */
+    void setBodyPath(const std::string& bodyId, const QString& brepPath);
+
+    /**
+     * @brief Release the package file (before it is replaced)
+     */
+    void close();
+
+    /**
+     * @brief Open the package at filepath again
+     * @return false if it cannot be opened; later loads then fail
+     */
+    bool reopen(const QString& filepath);
+
+    // DocumentEntryLoader interface
+    std::unique_ptr<core::sketch::Sketch> loadSketch(const std::string& id,
+                                                    std::string& errorMessage) override;
+    TopoDS_Shape loadBodyShape(const std::string& id, std::string& errorMessage) override;
+
+private:
+    mutable QMutex mutex_;
+    QString filepath_;
+    std::unique_ptr<Package> package_;
+    QHash<QString, QString> bodyPaths_;
+};
+
+} // namespace onecad::io
@@ -0,0 +1,244 @@
+/**
+ * @file PackageEntryPipeline.cpp
+ * @brief Implementation of concurrent package entry (de)serialization
+ */
+
+#include "PackageEntryPipeline.h"
+#include "Package.h"
+#include "../core/trace/Trace.h"
+
+#include <QElapsedTimer>
+#include <QLoggingCategory>
+#include <QTemporaryFile>
+#include <QThread>
+
+#include <ostream>
+
+Q_LOGGING_CATEGORY(logEntryPipeline, "onecad.io.pipeline")
+
+namespace onecad::io {
+
+struct PackageEntryPipeline::Entry {
+    QString path;
+    bool isWrite = false;
+    bool isStreamed = false;
+    bool spooled = false;  ///< Encoded on a worker into spool
+    bool tryReuse = false;
+    bool reused = false;
+    QString reuseHash;
+    Package::StreamWriter streamWriter;
+    std::unique_ptr<QTemporaryFile> spool;  ///< Encoded streamed entry, written by a worker
+    QByteArray data;
+    qint64 size = 0;
+    bool ok = false;
+    QString error;
+    double codecMs = 0.0;  ///< Encode or decode time on the worker
+    double ioMs = 0.0;     ///< Package read or write time on the owning thread
+    std::promise<void> done;
+    std::future<void> ready = done.get_future();
+};
+
+namespace {
+
+double elapsedMs(const QElapsedTimer& timer) {
+    return static_cast<double>(timer.nsecsElapsed()) / 1.0e6;
+}
+
+bool copyDevice(QIODevice& device, std::ostream& stream) {
+    char buffer[64 * 1024];
+    qint64 count = 0;
+    while ((count = device.read(buffer, sizeof(buffer))) > 0) {
+        stream.write(buffer, count);
+    }
+    return count == 0 && stream.good();
+}
+
+} // anonymous namespace
+
+PackageEntryPipeline::PackageEntryPipeline(Package* package, int maxThreads)
+    : package_(package) {
+    pool_.setMaxThreadCount(maxThreads > 0 ? maxThreads : QThread::idealThreadCount());
+}
+
+PackageEntryPipeline::~PackageEntryPipeline() {
+    pool_.waitForDone();
+}
+
+void PackageEntryPipeline::run(Entry* entry, std::function<void()> task) {
+    pool_.start([entry, task = std::move(task)]() {
+        ONECAD_TRACE_NAMED_SCOPE(trace, "io", entry->isWrite ? "encodeEntry" : "decodeEntry");
+        ONECAD_TRACE_ARG(trace, "path", entry->path.toStdString());
+        QElapsedTimer timer;
+        timer.start();
+        try {
+            task();
+        } catch (...) {
+            // OCCT failures are not std::exceptions; never let one escape a worker
+            entry->ok = false;
+            entry->error = "Unexpected exception";
+        }
+        entry->codecMs = elapsedMs(timer);
+        entry->done.set_value();
+    });
+}
+
+void PackageEntryPipeline::write(const QString& path, Encoder encoder) {
+    auto entry = std::make_unique<Entry>();
+    entry->path = path;
+    entry->isWrite = true;
+    Entry* raw = entry.get();
+    entries_.push_back(std::move(entry));
+
+    run(raw, [raw, encoder = std::move(encoder)]() {
+        raw->ok = encoder(raw->data);
+        if (!raw->ok) {
+            raw->error = "Encoding failed";
+        }
+    });
+}
+
+void PackageEntryPipeline::writeStreamed(const QString& path, Package::StreamWriter writer) {
+    auto entry = std::make_unique<Entry>();
+    entry->path = path;
+    entry->isWrite = true;
+    entry->isStreamed = true;
+    entry->spooled = true;
+    entry->spool = std::make_unique<QTemporaryFile>();
+    Entry* raw = entry.get();
+    entries_.push_back(std::move(entry));
+
+    if (!raw->spool->open()) {
+        raw->error = "Cannot create temporary file: " + raw->spool->errorString();
+        raw->done.set_value();
+        return;
+    }
+    run(raw, [raw, writer = std::move(writer)]() {
+        raw->ok = Package::writeToDevice(raw->spool.get(), writer);
+        raw->size = raw->spool->size();
+        if (!raw->ok) {
+            raw->error = "Encoding failed";
+        }
+    });
+}
+
+PackageEntryPipeline::Entry* PackageEntryPipeline::queueStreamed(const QString& path,
+                                                                 Package::StreamWriter writer) {
+    auto entry = std::make_unique<Entry>();
+    entry->path = path;
+    entry->isWrite = true;
+    entry->isStreamed = true;
+    entry->ok = true;
+    entry->streamWriter = std::move(writer);
+    entry->done.set_value();
+    entries_.push_back(std::move(entry));
+    return entries_.back().get();
+}
+
+void PackageEntryPipeline::reuseOrWriteStreamed(const QString& path,
+                                                const QString& contentHash,
+                                                Package::StreamWriter writer) {
+    Entry* entry = queueStreamed(path, std::move(writer));
+    entry->tryReuse = true;
+    entry->reuseHash = contentHash;
+}
+
+void PackageEntryPipeline::read(const QString& path, Decoder decoder) {
+    ONECAD_TRACE_NAMED_SCOPE(trace, "io", "readEntry");
+    ONECAD_TRACE_ARG(trace, "path", path.toStdString());
+    auto entry = std::make_unique<Entry>();
+    entry->path = path;
+    Entry* raw = entry.get();
+    entries_.push_back(std::move(entry));
+
+    QElapsedTimer timer;
+    timer.start();
+    raw->data = package_->readFile(path);
+    raw->ioMs = elapsedMs(timer);
+    raw->size = raw->data.size();
+
+    if (raw->data.isEmpty()) {
+        raw->error = "Missing or empty entry";
+        raw->done.set_value();
+        return;
+    }
+
+    run(raw, [raw, decoder = std::move(decoder)]() {
+        raw->ok = decoder(raw->data, raw->error);
+        raw->data = QByteArray();
+    });
+}
+
+bool PackageEntryPipeline::finish() {
+    ONECAD_TRACE_SCOPE("io", "pipelineFinish");
+    QElapsedTimer total;
+    total.start();
+
+    bool allOk = true;
+    for (auto& entry : entries_) {
+        entry->ready.wait();
+
+        if (entry->isWrite && entry->ok) {
+            ONECAD_TRACE_NAMED_SCOPE(trace, "io", "writeEntry");
+            ONECAD_TRACE_ARG(trace, "path", entry->path.toStdString());
+            // Single writer: package backends are only touched from this thread
+            QElapsedTimer timer;
+            timer.start();
+            if (entry->isStreamed) {
+                entry->reused = entry->tryReuse &&
+                                package_->reuseFile(entry->path, entry->reuseHash);
+                if (entry->reused) {
+                    // Nothing to write
+                } else if (entry->spool) {
+                    QTemporaryFile& spool = *entry->spool;
+                    entry->ok = spool.seek(0) &&
+                                package_->writeFileStreamed(entry->path, [&spool](std::ostream& stream) {
+                                    return copyDevice(spool, stream);
+                                });
+                } else {
+                    entry->ok = package_->writeFileStreamed(entry->path, entry->streamWriter);
+                }
+                entry->streamWriter = nullptr;
+                entry->spool.reset();
+            } else {
+                entry->size = entry->data.size();
+                entry->ok = package_->writeFile(entry->path, entry->data);
+                entry->data = QByteArray();
+            }
+            entry->ioMs = elapsedMs(timer);
+            if (!entry->ok) {
+                entry->error = package_->errorString();
+            }
+        }
+
+        if (!entry->isWrite) {
+            qCDebug(logEntryPipeline).nospace()
+                << "read " << entry->path << " size=" << entry->size
+                << " readMs=" << entry->ioMs << " decodeMs=" << entry->codecMs
+                << (entry->ok ? "" : " FAILED");
+        } else if (entry->isStreamed) {
+            qCDebug(logEntryPipeline).nospace()
+                << (entry->reused ? "reuse " : (entry->spooled ? "spool " : "stream "))
+                << entry->path << " size=" << entry->size << " encodeMs=" << entry->codecMs
+                << " streamMs=" << entry->ioMs << (entry->ok ? "" : " FAILED");
+        } else {
+            qCDebug(logEntryPipeline).nospace()
+                << "write " << entry->path << " size=" << entry->size
+                << " encodeMs=" << entry->codecMs << " writeMs=" << entry->ioMs
+                << (entry->ok ? "" : " FAILED");
+        }
+
+        if (!entry->ok) {
+            allOk = false;
+            errors_.append(QString("%1: %2").arg(entry->path, entry->error));
+        }
+    }
+
+    qCDebug(logEntryPipeline) << "finish:" << entries_.size() << "entries,"
+                              << pool_.maxThreadCount() << "threads,"
+                              << "waitMs=" << elapsedMs(total);
+
+    entries_.clear();
+    return allOk;
+}
+
+} // namespace onecad::io
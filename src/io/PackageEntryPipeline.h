@@ -0,0 +1,113 @@
+/**
+ * @file PackageEntryPipeline.h
+ * @brief Concurrent encode/decode of independent package entries
+ *
+ * Sketch JSON and body BREP entries do not depend on each other, so their
+ * (de)serialization runs on a worker pool. Package backends are not
+ * thread-safe, so every readFile/writeFile happens on the thread that owns
+ * the pipeline: reads when an entry is submitted, writes in submission
+ * order from finish(). Entry order in the package is therefore unchanged.
+ *
+ * Large entries (body BREPs) use writeStreamed(): a worker encodes each one
+ * into its own temporary file, which the writer then copies into the package
+ * in chunks. Encoding stays concurrent while save memory does not grow with
+ * document size; the cost is one extra sequential pass over a local file.
+ * Entries that are usually reused (reuseOrWriteStreamed()) are only encoded
+ * by the writer, and only when reuse fails.
+ */
+
+#pragma once
+
+#include "Package.h"
+
+#include <QByteArray>
+#include <QString>
+#include <QStringList>
+#include <QThreadPool>
+
+#include <functional>
+#include <future>
+#include <memory>
+#include <vector>
+
+namespace onecad::io {
+
+/**
+ * @brief Worker-pool pipeline for package entry (de)serialization
+ */
+class PackageEntryPipeline {
+public:
+    /**
+     * @brief Produce entry data on a worker thread
+     * @return false if encoding failed (entry is not written)
+     */
+    using Encoder = std::function<bool(QByteArray& data)>;
+
+    /**
+     * @brief Consume entry data on a worker thread
+     * @return false if decoding failed (errorMessage set)
+     */
+    using Decoder = std::function<bool(const QByteArray& data, QString& errorMessage)>;
+
+    /**
+     * @param maxThreads Worker count, 0 = QThread::idealThreadCount()
+     */
+    explicit PackageEntryPipeline(Package* package, int maxThreads = 0);
+    ~PackageEntryPipeline();
+
+    PackageEntryPipeline(const PackageEntryPipeline&) = delete;
+    PackageEntryPipeline& operator=(const PackageEntryPipeline&) = delete;
+
+    /**
+     * @brief Queue an entry write; encoding starts immediately on the pool
+     */
+    void write(const QString& path, Encoder encoder);
+
+    /**
+     * @brief Queue a large entry; encoding starts immediately on the pool
+     *
+     * The writer streams into a temporary file on a worker, so the encoded
+     * entry is never buffered whole in memory. finish() copies it into the
+     * package in submission order.
+     */
+    void writeStreamed(const QString& path, Package::StreamWriter writer);
+
+    /**
+     * @brief Keep the entry from the replaced package, or stream it from the writer
+     * @param contentHash Passed to Package::reuseFile(); the writer only runs
+     *        if nothing was reused, on the owning thread during finish()
+     */
+    void reuseOrWriteStreamed(const QString& path, const QString& contentHash,
+                              Package::StreamWriter writer);
+
+    /**
+     * @brief Read an entry now and queue its decoding on the pool
+     *
+     * The decoder is not called for missing or empty entries.
+     */
+    void read(const QString& path, Decoder decoder);
+
+    /**
+     * @brief Write encoded entries in order and wait for all decoders
+     * @return true if every entry succeeded
+     */
+    bool finish();
+
+    /**
+     * @brief "path: reason" for each failed entry
+     */
+    const QStringList& errors() const { return errors_; }
+
+private:
+    struct Entry;
+
+    void run(Entry* entry, std::function<void()> task);
+    Entry* queueStreamed(const QString& path, Package::StreamWriter writer);
+
+    Package* package_;
+    std::vector<std::unique_ptr<Entry>> entries_;
+    QStringList errors_;
+    QThreadPool pool_;
+};
+
+} // namespace onecad::io
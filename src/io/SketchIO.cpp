@@ -77,9 +77,8 @@ void ensurePlaneNormal(QJsonObject& plane) {
 bool SketchIO::saveSketch(Package* package, 
                           const QString& sketchId,
                           const Sketch* sketch) {
-    QJsonObject json = serializeSketch(sketchId, sketch);
     QString path = QString("sketches/%1.json").arg(sketchId);
-    return package->writeFile(path, JSONUtils::toCanonicalJson(json));
+    return package->writeFile(path, encodeSketch(sketchId, sketch));
 }
 
 std::unique_ptr<Sketch> SketchIO::loadSketch(Package* package,
@@ -93,6 +92,16 @@ std::unique_ptr<Sketch> SketchIO::loadSketch(Package* package,
         return nullptr;
     }
     
+    return decodeSketch(data, path, errorMessage);
+}
+
+QByteArray SketchIO::encodeSketch(const QString& sketchId, const Sketch* sketch) {
+    return JSONUtils::toCanonicalJson(serializeSketch(sketchId, sketch));
+}
+
+std::unique_ptr<Sketch> SketchIO::decodeSketch(const QByteArray& data,
+                                               const QString& path,
+                                               QString& errorMessage) {
     QJsonParseError parseError;
     QJsonDocument jsonDoc = QJsonDocument::fromJson(data, &parseError);
     if (parseError.error != QJsonParseError::NoError) {
@@ -100,8 +109,7 @@ std::unique_ptr<Sketch> SketchIO::loadSketch(Package* package,
         return nullptr;
     }
     
-    auto sketch = deserializeSketch(jsonDoc.object(), errorMessage);
-    return sketch;
+    return deserializeSketch(jsonDoc.object(), errorMessage);
 }
 
 QJsonObject SketchIO::serializeSketch(const QString& sketchId,
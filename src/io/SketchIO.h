@@ -5,6 +5,7 @@
 
 #pragma once
 
+#include <QByteArray>
 #include <QJsonObject>
 #include <QString>
 #include <memory>
@@ -40,6 +41,21 @@ public:
         const QString& sketchId,
         QString& errorMessage);
     
+    /**
+     * @brief Encode sketch as canonical JSON entry data (thread-safe)
+     */
+    static QByteArray encodeSketch(const QString& sketchId,
+                                   const core::sketch::Sketch* sketch);
+
+    /**
+     * @brief Decode sketch from entry data (thread-safe)
+     * @param path Entry path, used in error messages
+     */
+    static std::unique_ptr<core::sketch::Sketch> decodeSketch(
+        const QByteArray& data,
+        const QString& path,
+        QString& errorMessage);
+
     /**
      * @brief Serialize sketch to JSON
      */
@@ -13,6 +13,7 @@
 
 #include <quazip/quazip.h>
 #include <quazip/quazipfile.h>
+#include <quazip/quazipfileinfo.h>
 #include <quazip/quazipnewinfo.h>
 
 namespace onecad::io {
@@ -108,6 +109,30 @@ QByteArray ZipPackage::readFile(const QString& path) {
     return data;
 }
 
+bool ZipPackage::readFileStreamed(const QString& path, const DeviceReader& reader) {
+    if (!pImpl_) return false;
+    if (!pImpl_->zip.isOpen() || pImpl_->isWriteMode) {
+        pImpl_->errorString = "ZIP not open for reading";
+        return false;
+    }
+
+    if (!pImpl_->zip.setCurrentFile(path)) {
+        pImpl_->errorString = QString("File not found in ZIP: %1").arg(path);
+        return false;
+    }
+
+    // Entry is inflated on demand as the reader consumes it
+    QuaZipFile file(&pImpl_->zip);
+    if (!file.open(QIODevice::ReadOnly)) {
+        pImpl_->errorString = QString("Failed to open file in ZIP: %1").arg(path);
+        return false;
+    }
+
+    bool ok = reader(file);
+    file.close();
+    return ok;
+}
+
 bool ZipPackage::fileExists(const QString& path) const {
     if (!pImpl_->zip.isOpen()) {
         return false;
@@ -169,6 +194,96 @@ bool ZipPackage::writeFile(const QString& path, const QByteArray& data) {
     return true;
 }
 
+bool ZipPackage::writeFileStreamed(const QString& path, const StreamWriter& writer) {
+    if (!pImpl_) return false;
+    if (!pImpl_->zip.isOpen() || !pImpl_->isWriteMode) {
+        pImpl_->errorString = "ZIP not open for writing";
+        return false;
+    }
+
+    if (pImpl_->finalized) {
+        pImpl_->errorString = "Cannot write to finalized ZIP";
+        return false;
+    }
+
+    QuaZipFile file(&pImpl_->zip);
+
+    QuaZipNewInfo info(path);
+    info.dateTime = QDateTime(QDate(1980, 1, 1), QTime(0, 0, 0));
+
+    if (!file.open(QIODevice::WriteOnly, info, nullptr, 0, 0, 0, false)) {
+        pImpl_->errorString = QString("Failed to create file in ZIP: %1").arg(path);
+        return false;
+    }
+
+    bool ok = writeToDevice(&file, writer);
+    file.close();
+
+    if (!ok || file.getZipError() != 0) {
+        pImpl_->errorString = QString("Failed to write all data to: %1").arg(path);
+        return false;
+    }
+
+    return true;
+}
+
+bool ZipPackage::copyFile(Package& source, const QString& path) {
+    auto* zipSource = dynamic_cast<ZipPackage*>(&source);
+    if (!pImpl_ || !zipSource || !zipSource->pImpl_->zip.isOpen() ||
+        zipSource->pImpl_->isWriteMode) {
+        return Package::copyFile(source, path);
+    }
+    if (!pImpl_->zip.isOpen() || !pImpl_->isWriteMode || pImpl_->finalized) {
+        pImpl_->errorString = "ZIP not open for writing";
+        return false;
+    }
+
+    QuaZip& sourceZip = zipSource->pImpl_->zip;
+    QuaZipFileInfo64 sourceInfo;
+    if (!sourceZip.setCurrentFile(path) || !sourceZip.getCurrentFileInfo(&sourceInfo)) {
+        pImpl_->errorString = QString("File not found in ZIP: %1").arg(path);
+        return false;
+    }
+
+    // Copy the stored (possibly compressed) bytes as-is, with the original CRC
+    int method = 0;
+    int level = 0;
+    QuaZipFile in(&sourceZip);
+    if (!in.open(QIODevice::ReadOnly, &method, &level, true)) {
+        pImpl_->errorString = QString("Failed to open file in ZIP: %1").arg(path);
+        return false;
+    }
+
+    QuaZipNewInfo info(path);
+    info.dateTime = QDateTime(QDate(1980, 1, 1), QTime(0, 0, 0));
+    info.uncompressedSize = sourceInfo.uncompressedSize;
+
+    QuaZipFile out(&pImpl_->zip);
+    if (!out.open(QIODevice::WriteOnly, info, nullptr, sourceInfo.crc, method, level, true)) {
+        pImpl_->errorString = QString("Failed to create file in ZIP: %1").arg(path);
+        return false;
+    }
+
+    char buffer[64 * 1024];
+    qint64 count = 0;
+    bool ok = true;
+    while ((count = in.read(buffer, sizeof(buffer))) > 0) {
+        if (out.write(buffer, count) != count) {
+            ok = false;
+            break;
+        }
+    }
+    ok = ok && count == 0;
+    out.close();
+    in.close();
+
+    if (!ok || out.getZipError() != 0) {
+        pImpl_->errorString = QString("Failed to copy ZIP entry: %1").arg(path);
+        return false;
+    }
+    return true;
+}
+
 bool ZipPackage::finalize() {
     if (!pImpl_->zip.isOpen()) {
         pImpl_->errorString = "ZIP not open";
@@ -309,6 +424,17 @@ QByteArray ZipPackage::readFile(const QString& path) {
     return file.readAll();
 }
 
+bool ZipPackage::readFileStreamed(const QString& path, const DeviceReader& reader) {
+    if (!pImpl_ || !pImpl_->tempDir.isValid()) return false;
+
+    QFile file(QDir(pImpl_->tempDir.path()).filePath(path));
+    if (!file.open(QIODevice::ReadOnly)) {
+        pImpl_->errorString = QString("Failed to open file: %1").arg(path);
+        return false;
+    }
+    return reader(file);
+}
+
 bool ZipPackage::fileExists(const QString& path) const {
     if (!pImpl_ || !pImpl_->tempDir.isValid()) return false;
     return QFile::exists(QDir(pImpl_->tempDir.path()).filePath(path));
@@ -357,6 +483,34 @@ bool ZipPackage::writeFile(const QString& path, const QByteArray& data) {
     return true;
 }
 
+bool ZipPackage::writeFileStreamed(const QString& path, const StreamWriter& writer) {
+    if (!pImpl_ || !pImpl_->tempDir.isValid()) return false;
+
+    QString fullPath = QDir(pImpl_->tempDir.path()).filePath(path);
+
+    // Ensure parent dir exists
+    QFileInfo fi(fullPath);
+    QDir().mkpath(fi.absolutePath());
+
+    QFile file(fullPath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        pImpl_->errorString = QString("Failed to create file: %1").arg(path);
+        return false;
+    }
+
+    if (!writeToDevice(&file, writer)) {
+        pImpl_->errorString = QString("Failed to write data: %1").arg(path);
+        return false;
+    }
+
+    return true;
+}
+
+bool ZipPackage::copyFile(Package& source, const QString& path) {
+    // Entries are plain files until finalize() zips them
+    return Package::copyFile(source, path);
+}
+
 bool ZipPackage::finalize() {
     if (!pImpl_->isWriteMode) return true;
     if (pImpl_->finalized) return true;
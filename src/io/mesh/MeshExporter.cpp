@@ -0,0 +1,650 @@
+/**
+ * @file MeshExporter.cpp
+ * @brief Implementation of streaming mesh export
+ */
+
+#include "MeshExporter.h"
+#include "../IODeviceStream.h"
+#include "../ZipPackage.h"
+#include "../../app/document/Document.h"
+
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QLoggingCategory>
+#include <QObject>
+#include <QSaveFile>
+#include <QThread>
+#include <QThreadPool>
+#include <QtEndian>
+
+#include <BRepBuilderAPI_Copy.hxx>
+#include <BRepMesh_IncrementalMesh.hxx>
+#include <BRep_Tool.hxx>
+#include <Poly_Triangulation.hxx>
+#include <Standard_Failure.hxx>
+#include <TopExp_Explorer.hxx>
+#include <TopLoc_Location.hxx>
+#include <TopoDS.hxx>
+#include <TopoDS_Face.hxx>
+#include <gp_Trsf.hxx>
+#include <gp_Vec.hxx>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <future>
+#include <limits>
+#include <memory>
+#include <ostream>
+
+Q_LOGGING_CATEGORY(logMeshExport, "onecad.io.mesh")
+
+namespace onecad::io {
+
+namespace {
+
+// Used for bodies without a stored triangulation when none was requested;
+// matches the TessellationCache default
+constexpr double kFallbackLinearDeflection = 0.05;
+
+/**
+ * @brief Triangulation of one face with its placement and orientation
+ */
+struct FaceMesh {
+    Handle(Poly_Triangulation) triangulation;
+    gp_Trsf transform;
+    bool transformed = false;
+    bool reversed = false;
+
+    gp_Pnt node(int index) const {
+        gp_Pnt point = triangulation->Node(index);
+        if (transformed) {
+            point.Transform(transform);
+        }
+        return point;
+    }
+
+    void triangle(int index, int& n1, int& n2, int& n3) const {
+        triangulation->Triangle(index).Get(n1, n2, n3);
+        if (reversed) {
+            std::swap(n2, n3);
+        }
+    }
+};
+
+/**
+ * @brief Body ready for writing; holds the triangulations, not the shape
+ */
+struct PreparedBody {
+    std::vector<FaceMesh> faces;
+    uint64_t triangleCount = 0;
+    QString errorMessage;
+};
+
+/**
+ * @brief Triangulated faces of a shape
+ * @return false if a face has no triangulation
+ */
+bool collectFaces(const TopoDS_Shape& shape, PreparedBody& body) {
+    body.faces.clear();
+    body.triangleCount = 0;
+    bool complete = true;
+    for (TopExp_Explorer exp(shape, TopAbs_FACE); exp.More(); exp.Next()) {
+        const TopoDS_Face& face = TopoDS::Face(exp.Current());
+        TopLoc_Location location;
+        FaceMesh mesh;
+        mesh.triangulation = BRep_Tool::Triangulation(face, location);
+        if (mesh.triangulation.IsNull()) {
+            complete = false;
+            continue;
+        }
+        mesh.transformed = !location.IsIdentity();
+        mesh.transform = location.Transformation();
+        mesh.reversed = face.Orientation() == TopAbs_REVERSED;
+        body.triangleCount += static_cast<uint64_t>(mesh.triangulation->NbTriangles());
+        body.faces.push_back(mesh);
+    }
+    return complete;
+}
+
+/**
+ * @brief Mesh a copy of the shape so the document's display mesh is untouched
+ */
+void meshCopy(const TopoDS_Shape& shape, double linearDeflection, double angularDeflection,
+              bool parallel, PreparedBody& body) {
+    // Topology copy (geometry shared): the triangulation lands on the new faces
+    TopoDS_Shape copy = BRepBuilderAPI_Copy(shape, Standard_False, Standard_False).Shape();
+    BRepMesh_IncrementalMesh mesher(copy, linearDeflection, parallel, angularDeflection, true);
+    mesher.Perform();
+    collectFaces(copy, body);
+}
+
+PreparedBody prepareBody(const MeshExportBody& input, const MeshExportOptions& options,
+                         bool parallelFaces) {
+    PreparedBody body;
+    if (options.cancelFlag && options.cancelFlag->load(std::memory_order_relaxed)) {
+        return body;
+    }
+    try {
+        if (options.linearDeflection > 0.0) {
+            meshCopy(input.shape, options.linearDeflection, options.angularDeflection,
+                     parallelFaces, body);
+        } else if (!collectFaces(input.shape, body)) {
+            meshCopy(input.shape, kFallbackLinearDeflection, options.angularDeflection,
+                     parallelFaces, body);
+        }
+    } catch (const Standard_Failure& failure) {
+        body.errorMessage = QString("Failed to mesh %1: %2")
+                                .arg(QString::fromStdString(input.name),
+                                     QString::fromLatin1(failure.GetMessageString()));
+    }
+    return body;
+}
+
+// =============================================================================
+// Number formatting (locale independent, no allocation)
+// =============================================================================
+
+char* formatUnsigned(char* out, uint64_t value) {
+    char digits[20];
+    int count = 0;
+    do {
+        digits[count++] = static_cast<char>('0' + value % 10);
+        value /= 10;
+    } while (value != 0);
+    while (count > 0) {
+        *out++ = digits[--count];
+    }
+    return out;
+}
+
+/// Coordinates in mm with up to 6 decimals (1 nm), trailing zeros trimmed
+char* formatCoordinate(char* out, double value) {
+    if (!std::isfinite(value) || std::abs(value) >= 1e12) {
+        return out + std::snprintf(out, 32, "%.9g", value);
+    }
+    const uint64_t scaled = static_cast<uint64_t>(std::llround(std::abs(value) * 1e6));
+    if (scaled == 0) {
+        *out++ = '0';
+        return out;
+    }
+    if (value < 0.0) {
+        *out++ = '-';
+    }
+    out = formatUnsigned(out, scaled / 1000000);
+    uint64_t fraction = scaled % 1000000;
+    if (fraction != 0) {
+        *out++ = '.';
+        int decimals = 6;
+        while (fraction % 10 == 0) {
+            fraction /= 10;
+            --decimals;
+        }
+        char* end = out + decimals;
+        for (char* p = end - 1; p >= out; --p) {
+            *p = static_cast<char>('0' + fraction % 10);
+            fraction /= 10;
+        }
+        out = end;
+    }
+    return out;
+}
+
+char* appendLiteral(char* out, const char* text) {
+    const size_t length = std::strlen(text);
+    std::memcpy(out, text, length);
+    return out + length;
+}
+
+// =============================================================================
+// Format writers
+// =============================================================================
+
+/**
+ * @brief Streams bodies in one format
+ */
+class MeshStreamWriter {
+public:
+    virtual ~MeshStreamWriter() = default;
+    virtual bool writeBody(std::ostream& out, const std::string& name,
+                           const PreparedBody& body) = 0;
+};
+
+class StlWriter : public MeshStreamWriter {
+public:
+    static constexpr qint64 kCountOffset = 80;
+
+    static void writeHeader(std::ostream& out) {
+        char header[84] = {};
+        std::snprintf(header, 80, "OneCAD binary STL");
+        out.write(header, sizeof(header));  // Triangle count patched at the end
+    }
+
+    bool writeBody(std::ostream& out, const std::string& /*name*/,
+                   const PreparedBody& body) override {
+        char record[50] = {};
+        for (const FaceMesh& face : body.faces) {
+            for (int t = 1; t <= face.triangulation->NbTriangles(); ++t) {
+                int n1 = 0, n2 = 0, n3 = 0;
+                face.triangle(t, n1, n2, n3);
+                const gp_Pnt p1 = face.node(n1);
+                const gp_Pnt p2 = face.node(n2);
+                const gp_Pnt p3 = face.node(n3);
+                gp_Vec normal = gp_Vec(p1, p2).Crossed(gp_Vec(p1, p3));
+                const double magnitude = normal.Magnitude();
+                if (magnitude > std::numeric_limits<double>::min()) {
+                    normal /= magnitude;
+                }
+
+                const float values[12] = {
+                    float(normal.X()), float(normal.Y()), float(normal.Z()),
+                    float(p1.X()), float(p1.Y()), float(p1.Z()),
+                    float(p2.X()), float(p2.Y()), float(p2.Z()),
+                    float(p3.X()), float(p3.Y()), float(p3.Z()),
+                };
+                for (int i = 0; i < 12; ++i) {
+                    qToLittleEndian(values[i], record + 4 * i);
+                }
+                out.write(record, sizeof(record));
+            }
+        }
+        triangleCount_ += body.triangleCount;
+        return out.good();
+    }
+
+    uint64_t triangleCount() const { return triangleCount_; }
+
+private:
+    uint64_t triangleCount_ = 0;
+};
+
+class ObjWriter : public MeshStreamWriter {
+public:
+    static void writeHeader(std::ostream& out) {
+        out << "# OneCAD mesh export\n";
+    }
+
+    bool writeBody(std::ostream& out, const std::string& name,
+                   const PreparedBody& body) override {
+        out << "o " << (name.empty() ? std::string("Body") : name) << '\n';
+        char line[128];
+        for (const FaceMesh& face : body.faces) {
+            const int nodeCount = face.triangulation->NbNodes();
+            for (int n = 1; n <= nodeCount; ++n) {
+                const gp_Pnt p = face.node(n);
+                char* end = appendLiteral(line, "v ");
+                end = formatCoordinate(end, p.X());
+                *end++ = ' ';
+                end = formatCoordinate(end, p.Y());
+                *end++ = ' ';
+                end = formatCoordinate(end, p.Z());
+                *end++ = '\n';
+                out.write(line, end - line);
+            }
+            // OBJ indices are 1-based and global
+            const uint64_t base = nextVertex_ - 1;
+            for (int t = 1; t <= face.triangulation->NbTriangles(); ++t) {
+                int n1 = 0, n2 = 0, n3 = 0;
+                face.triangle(t, n1, n2, n3);
+                char* end = appendLiteral(line, "f ");
+                end = formatUnsigned(end, base + n1);
+                *end++ = ' ';
+                end = formatUnsigned(end, base + n2);
+                *end++ = ' ';
+                end = formatUnsigned(end, base + n3);
+                *end++ = '\n';
+                out.write(line, end - line);
+            }
+            nextVertex_ += static_cast<uint64_t>(nodeCount);
+        }
+        return out.good();
+    }
+
+private:
+    uint64_t nextVertex_ = 1;
+};
+
+class ThreeMfWriter : public MeshStreamWriter {
+public:
+    static QByteArray contentTypes() {
+        return "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+               "<Types xmlns=\"http://schemas.openxmlformats.org/package/2006/content-types\">"
+               "<Default Extension=\"rels\" "
+               "ContentType=\"application/vnd.openxmlformats-package.relationships+xml\"/>"
+               "<Default Extension=\"model\" "
+               "ContentType=\"application/vnd.ms-package.3dmanufacturing-3dmodel+xml\"/>"
+               "</Types>\n";
+    }
+
+    static QByteArray relationships() {
+        return "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+               "<Relationships xmlns=\"http://schemas.openxmlformats.org/package/2006/relationships\">"
+               "<Relationship Target=\"/3D/3dmodel.model\" Id=\"rel0\" "
+               "Type=\"http://schemas.microsoft.com/3dmanufacturing/2013/01/3dmodel\"/>"
+               "</Relationships>\n";
+    }
+
+    static void writeHeader(std::ostream& out) {
+        out << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+               "<model unit=\"millimeter\" xml:lang=\"en-US\" "
+               "xmlns=\"http://schemas.microsoft.com/3dmanufacturing/core/2015/02\">\n"
+               " <resources>\n";
+    }
+
+    void writeFooter(std::ostream& out) const {
+        out << " </resources>\n <build>\n";
+        for (int id : objectIds_) {
+            out << "  <item objectid=\"" << id << "\"/>\n";
+        }
+        out << " </build>\n</model>\n";
+    }
+
+    bool writeBody(std::ostream& out, const std::string& name,
+                   const PreparedBody& body) override {
+        if (body.triangleCount == 0) {
+            return true;  // 3MF objects must not be empty
+        }
+        const int id = static_cast<int>(objectIds_.size()) + 1;
+        objectIds_.push_back(id);
+        out << "  <object id=\"" << id << "\" type=\"model\" name=\""
+            << QString::fromStdString(name).toHtmlEscaped().toStdString() << "\">\n"
+            << "   <mesh>\n    <vertices>\n";
+
+        // Vertices of all faces first, then triangles with body-local indices
+        char line[160];
+        for (const FaceMesh& face : body.faces) {
+            for (int n = 1; n <= face.triangulation->NbNodes(); ++n) {
+                const gp_Pnt p = face.node(n);
+                char* end = appendLiteral(line, "     <vertex x=\"");
+                end = formatCoordinate(end, p.X());
+                end = appendLiteral(end, "\" y=\"");
+                end = formatCoordinate(end, p.Y());
+                end = appendLiteral(end, "\" z=\"");
+                end = formatCoordinate(end, p.Z());
+                end = appendLiteral(end, "\"/>\n");
+                out.write(line, end - line);
+            }
+        }
+        out << "    </vertices>\n    <triangles>\n";
+        uint64_t base = 0;
+        for (const FaceMesh& face : body.faces) {
+            for (int t = 1; t <= face.triangulation->NbTriangles(); ++t) {
+                int n1 = 0, n2 = 0, n3 = 0;
+                face.triangle(t, n1, n2, n3);
+                char* end = appendLiteral(line, "     <triangle v1=\"");
+                end = formatUnsigned(end, base + n1 - 1);
+                end = appendLiteral(end, "\" v2=\"");
+                end = formatUnsigned(end, base + n2 - 1);
+                end = appendLiteral(end, "\" v3=\"");
+                end = formatUnsigned(end, base + n3 - 1);
+                end = appendLiteral(end, "\"/>\n");
+                out.write(line, end - line);
+            }
+            base += static_cast<uint64_t>(face.triangulation->NbNodes());
+        }
+        out << "    </triangles>\n   </mesh>\n  </object>\n";
+        return out.good();
+    }
+
+private:
+    std::vector<int> objectIds_;
+};
+
+// =============================================================================
+// Pipeline
+// =============================================================================
+
+/**
+ * @brief Mesh bodies on a pool and write them in order
+ *
+ * At most two bodies per thread are meshed ahead of the writer.
+ */
+bool writeBodies(std::ostream& out, MeshStreamWriter& writer,
+                 const std::vector<MeshExportBody>& bodies,
+                 const MeshExportOptions& options, MeshExportResult& result) {
+    auto isCancelled = [&options]() {
+        return options.cancelFlag && options.cancelFlag->load(std::memory_order_relaxed);
+    };
+
+    const int threads = options.maxThreads > 0 ? options.maxThreads
+                                               : std::max(1, QThread::idealThreadCount());
+    const size_t window = static_cast<size_t>(threads) * 2;
+    // Few bodies: let BRepMesh parallelize over faces instead
+    const bool parallelFaces = bodies.size() < static_cast<size_t>(threads);
+
+    std::vector<std::future<PreparedBody>> pending(bodies.size());
+    QThreadPool pool;  // Destroyed first: waits for tasks still referencing bodies
+    pool.setMaxThreadCount(threads);
+
+    size_t submitted = 0;
+    for (size_t i = 0; i < bodies.size(); ++i) {
+        for (; submitted < bodies.size() && submitted < i + window; ++submitted) {
+            auto task = std::make_shared<std::packaged_task<PreparedBody()>>(
+                [&bodies, &options, parallelFaces, index = submitted]() {
+                    return prepareBody(bodies[index], options, parallelFaces);
+                });
+            pending[submitted] = task->get_future();
+            pool.start([task]() { (*task)(); });
+        }
+
+        PreparedBody body = pending[i].get();
+        if (isCancelled()) {
+            return false;
+        }
+        if (!body.errorMessage.isEmpty()) {
+            result.errorMessage = body.errorMessage;
+            return false;
+        }
+        if (!writer.writeBody(out, bodies[i].name, body)) {
+            result.errorMessage = "Failed to write mesh data";
+            return false;
+        }
+        ++result.bodyCount;
+        result.triangleCount += body.triangleCount;
+
+        if (options.onProgress) {
+            options.onProgress(static_cast<double>(i + 1) / static_cast<double>(bodies.size()),
+                               QObject::tr("Writing bodies"));
+        }
+    }
+    return out.good();
+}
+
+/**
+ * @brief Move source over target, keeping target if the move fails
+ *
+ * An existing target is first moved aside and restored if the rename
+ * fails; it is deleted only once source is in place.
+ */
+bool replaceFile(const QString& source, const QString& target) {
+    if (!QFile::exists(target)) {
+        return QFile::rename(source, target);
+    }
+    const QString backup = target + ".bak";
+    QFile::remove(backup);
+    if (!QFile::rename(target, backup)) {
+        return false;
+    }
+    if (!QFile::rename(source, target)) {
+        QFile::rename(backup, target);
+        return false;
+    }
+    QFile::remove(backup);
+    return true;
+}
+
+} // anonymous namespace
+
+MeshExportResult MeshExporter::exportBodies(const QString& filepath,
+                                            const std::vector<MeshExportBody>& bodies,
+                                            const MeshExportOptions& options) {
+    MeshExportResult result;
+    if (bodies.empty()) {
+        result.errorMessage = "No bodies to export";
+        return result;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    if (options.onProgress) {
+        options.onProgress(0.0, QObject::tr("Meshing bodies"));
+    }
+
+    bool ok = false;
+    if (options.format == MeshFormat::ThreeMf) {
+        if (!ZipPackage::isSupported()) {
+            result.errorMessage = "3MF export requires ZIP support";
+            return result;
+        }
+        // 3MF is a ZIP package; build it next to the target and move it into place
+        const QString partPath = filepath + ".part";
+        {
+            auto package = ZipPackage::createWrite(partPath);
+            if (!package) {
+                result.errorMessage = QString("Failed to create file: %1").arg(filepath);
+                return result;
+            }
+            ThreeMfWriter writer;
+            ok = package->writeFile("[Content_Types].xml", ThreeMfWriter::contentTypes()) &&
+                 package->writeFile("_rels/.rels", ThreeMfWriter::relationships()) &&
+                 package->writeFileStreamed("3D/3dmodel.model", [&](std::ostream& out) {
+                     ThreeMfWriter::writeHeader(out);
+                     if (!writeBodies(out, writer, bodies, options, result)) {
+                         return false;
+                     }
+                     writer.writeFooter(out);
+                     return out.good();
+                 });
+            ok = package->finalize() && ok;
+        }
+        ok = ok && replaceFile(partPath, filepath);
+        if (!ok) {
+            QFile::remove(partPath);
+        }
+    } else {
+        QSaveFile file(filepath);
+        if (!file.open(QIODevice::WriteOnly)) {
+            result.errorMessage = QString("Failed to create file: %1").arg(filepath);
+            return result;
+        }
+        StlWriter stl;
+        ObjWriter obj;
+        {
+            IODeviceStreamBuf buffer(&file, 1024 * 1024);
+            std::ostream out(&buffer);
+            if (options.format == MeshFormat::BinaryStl) {
+                StlWriter::writeHeader(out);
+                ok = writeBodies(out, stl, bodies, options, result);
+            } else {
+                ObjWriter::writeHeader(out);
+                ok = writeBodies(out, obj, bodies, options, result);
+            }
+            out.flush();
+            ok = ok && out.good();
+        }
+        if (ok && options.format == MeshFormat::BinaryStl) {
+            if (stl.triangleCount() > std::numeric_limits<quint32>::max()) {
+                result.errorMessage = "Too many triangles for binary STL";
+                ok = false;
+            } else {
+                char count[4];
+                qToLittleEndian(static_cast<quint32>(stl.triangleCount()), count);
+                ok = file.seek(StlWriter::kCountOffset) && file.write(count, 4) == 4;
+            }
+        }
+        if (ok) {
+            ok = file.commit();
+        } else {
+            file.cancelWriting();
+        }
+    }
+
+    if (options.cancelFlag && options.cancelFlag->load(std::memory_order_relaxed)) {
+        result.cancelled = true;
+        result.errorMessage = "Mesh export cancelled";
+        return result;
+    }
+    if (!ok) {
+        if (result.errorMessage.isEmpty()) {
+            result.errorMessage = QString("Failed to write file: %1").arg(filepath);
+        }
+        return result;
+    }
+
+    result.bytesWritten = QFileInfo(filepath).size();
+    result.success = true;
+    if (options.onProgress) {
+        options.onProgress(1.0, QObject::tr("Done"));
+    }
+
+    const qint64 elapsed = std::max<qint64>(1, timer.elapsed());
+    qCInfo(logMeshExport) << "Exported" << result.bodyCount << "bodies,"
+                          << result.triangleCount << "triangles," << result.bytesWritten
+                          << "bytes to" << filepath << "in" << elapsed << "ms ("
+                          << (result.triangleCount * 1000 / elapsed) << "triangles/s)";
+    return result;
+}
+
+MeshExportResult MeshExporter::exportDocument(const QString& filepath,
+                                              const app::Document* document,
+                                              const MeshExportOptions& options) {
+    if (!document) {
+        MeshExportResult result;
+        result.errorMessage = "Document is null";
+        return result;
+    }
+    std::vector<MeshExportBody> bodies = collectBodies(document);
+    if (bodies.empty()) {
+        MeshExportResult result;
+        result.errorMessage = "No visible bodies to export";
+        return result;
+    }
+    return exportBodies(filepath, bodies, options);
+}
+
+std::vector<MeshExportBody> MeshExporter::collectBodies(const app::Document* document) {
+    std::vector<MeshExportBody> bodies;
+    if (!document) {
+        return bodies;
+    }
+    for (const auto& bodyId : document->getBodyIds()) {
+        if (!document->isBodyVisible(bodyId)) {
+            continue;
+        }
+        const TopoDS_Shape* shape = document->getBodyShape(bodyId);
+        if (shape && !shape->IsNull()) {
+            bodies.push_back({document->getBodyName(bodyId), *shape});
+        }
+    }
+    return bodies;
+}
+
+std::optional<MeshFormat> MeshExporter::formatForPath(const QString& filepath) {
+    const QString suffix = QFileInfo(filepath).suffix().toLower();
+    if (suffix == "stl") {
+        return MeshFormat::BinaryStl;
+    }
+    if (suffix == "obj") {
+        return MeshFormat::Obj;
+    }
+    if (suffix == "3mf") {
+        return MeshFormat::ThreeMf;
+    }
+    return std::nullopt;
+}
+
+QString MeshExporter::formatName(MeshFormat format) {
+    switch (format) {
+        case MeshFormat::BinaryStl:
+            return "STL";
+        case MeshFormat::Obj:
+            return "OBJ";
+        case MeshFormat::ThreeMf:
+            return "3MF";
+    }
+    return {};
+}
+
+} // namespace onecad::io
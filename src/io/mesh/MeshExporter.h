@@ -0,0 +1,117 @@
+/**
+ * @file MeshExporter.h
+ * @brief Streaming triangle mesh export (binary STL, OBJ, 3MF)
+ */
+
+#pragma once
+
+#include <QString>
+
+#include <TopoDS_Shape.hxx>
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace onecad::app {
+class Document;
+}
+
+namespace onecad::io {
+
+/**
+ * @brief Mesh file formats
+ */
+enum class MeshFormat {
+    BinaryStl,
+    Obj,
+    ThreeMf
+};
+
+/**
+ * @brief Body to export
+ */
+struct MeshExportBody {
+    std::string name;
+    TopoDS_Shape shape;
+};
+
+/**
+ * @brief Export settings, progress and cancellation
+ */
+struct MeshExportOptions {
+    MeshFormat format = MeshFormat::BinaryStl;
+    /// 0 reuses the triangulation stored on the shapes (TessellationCache
+    /// output); > 0 re-meshes copies of the shapes at this deflection (mm)
+    double linearDeflection = 0.0;
+    double angularDeflection = 0.2;
+    /// Bodies meshed concurrently; 0 uses QThread::idealThreadCount()
+    int maxThreads = 0;
+    /// Overall fraction in [0, 1] and the current stage (exporting thread)
+    std::function<void(double fraction, const QString& stage)> onProgress;
+    /// Set from any thread to abort; the target file is left untouched
+    const std::atomic<bool>* cancelFlag = nullptr;
+};
+
+/**
+ * @brief Result of mesh export
+ */
+struct MeshExportResult {
+    bool success = false;
+    bool cancelled = false;
+    QString errorMessage;
+    int bodyCount = 0;
+    uint64_t triangleCount = 0;
+    qint64 bytesWritten = 0;
+};
+
+/**
+ * @brief Writes body triangulations straight to disk
+ *
+ * Bodies are written one at a time in order. Meshing runs on a thread
+ * pool a bounded number of bodies ahead of the writer, and each body's
+ * mesh is released once written, so memory stays proportional to a few
+ * bodies rather than the whole model. Triangles are encoded face by face
+ * from the OCCT triangulation without an intermediate mesh copy.
+ *
+ * Files are written to a temporary file and moved into place on success.
+ */
+class MeshExporter {
+public:
+    /**
+     * @brief Export bodies to filepath in options.format
+     */
+    static MeshExportResult exportBodies(const QString& filepath,
+                                         const std::vector<MeshExportBody>& bodies,
+                                         const MeshExportOptions& options);
+
+    /**
+     * @brief Export the visible bodies of a document
+     *
+     * Collects shapes on the calling thread; the document may change
+     * afterwards if the rest runs elsewhere.
+     */
+    static MeshExportResult exportDocument(const QString& filepath,
+                                           const app::Document* document,
+                                           const MeshExportOptions& options);
+
+    /**
+     * @brief Visible bodies of a document, in body order
+     */
+    static std::vector<MeshExportBody> collectBodies(const app::Document* document);
+
+    /**
+     * @brief Format from a file extension (.stl, .obj, .3mf)
+     */
+    static std::optional<MeshFormat> formatForPath(const QString& filepath);
+
+    static QString formatName(MeshFormat format);
+
+private:
+    MeshExporter() = delete;
+};
+
+} // namespace onecad::io
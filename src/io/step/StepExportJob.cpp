@@ -0,0 +1,84 @@
+/**
+ * @file StepExportJob.cpp
+ * @brief Implementation of background STEP export
+ */
+
+#include "StepExportJob.h"
+
+#include <QElapsedTimer>
+#include <QLoggingCategory>
+
+#include <BRepBuilderAPI_Copy.hxx>
+
+#include <algorithm>
+
+Q_LOGGING_CATEGORY(logStepExport, "onecad.io.step.export")
+
+namespace onecad::io {
+
+StepExportJob::StepExportJob(QObject* parent)
+    : QObject(parent) {
+    pool_.setMaxThreadCount(1);
+}
+
+StepExportJob::~StepExportJob() {
+    cancelled_ = true;
+    pool_.waitForDone();
+}
+
+bool StepExportJob::start(const QString& filepath, std::vector<TopoDS_Shape> shapes) {
+    if (running_) {
+        return false;
+    }
+    running_ = true;
+    cancelled_ = false;
+    lastPercent_ = -1;
+
+    // The document keeps meshing its shapes in place, which writes
+    // triangulations into the shared TFace/TEdge objects the writer walks.
+    // Deep copies give the worker topology and geometry of its own.
+    for (TopoDS_Shape& shape : shapes) {
+        if (!shape.IsNull()) {
+            shape = BRepBuilderAPI_Copy(shape, Standard_True, Standard_False).Shape();
+        }
+    }
+
+    pool_.start([this, filepath, shapes = std::move(shapes)]() {
+        QElapsedTimer timer;
+        timer.start();
+
+        StepExportControl control;
+        control.cancelFlag = &cancelled_;
+        control.onProgress = [this](double fraction, const QString& stage) {
+            const int percent = std::clamp(static_cast<int>(fraction * 100.0), 0, 100);
+            if (lastPercent_.exchange(percent) == percent) {
+                return;
+            }
+            QMetaObject::invokeMethod(this, [this, percent, stage]() {
+                emit progressChanged(percent, stage);
+            }, Qt::QueuedConnection);
+        };
+
+        StepExportResult result;
+        try {
+            result = StepExporter::exportShapes(filepath, shapes, control);
+        } catch (...) {
+            result.success = false;
+            result.errorMessage = "Unexpected exception while exporting STEP file";
+        }
+        qCInfo(logStepExport) << "Exported" << result.bodyCount << "bodies to" << filepath
+                              << "in" << timer.elapsed() << "ms";
+
+        QMetaObject::invokeMethod(this, [this, result]() {
+            running_ = false;
+            emit finished(result);
+        }, Qt::QueuedConnection);
+    });
+    return true;
+}
+
+void StepExportJob::cancel() {
+    cancelled_ = true;
+}
+
+} // namespace onecad::io
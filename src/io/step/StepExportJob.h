@@ -0,0 +1,66 @@
+/**
+ * @file StepExportJob.h
+ * @brief Background STEP export with progress and cancellation
+ */
+
+#pragma once
+
+#include "StepExporter.h"
+
+#include <QObject>
+#include <QString>
+#include <QThreadPool>
+
+#include <TopoDS_Shape.hxx>
+
+#include <atomic>
+#include <vector>
+
+namespace onecad::io {
+
+/**
+ * @brief Runs StepExporter::exportShapes() on a worker thread
+ *
+ * start() deep-copies the shapes on the calling thread (without their
+ * meshes), so the worker never touches topology the document may
+ * re-mesh while modeling continues. All signals are emitted on the
+ * thread that owns the job.
+ */
+class StepExportJob : public QObject {
+    Q_OBJECT
+
+public:
+    explicit StepExportJob(QObject* parent = nullptr);
+    /** @brief Cancels a running export and waits for the worker */
+    ~StepExportJob() override;
+
+    StepExportJob(const StepExportJob&) = delete;
+    StepExportJob& operator=(const StepExportJob&) = delete;
+
+    /**
+     * @brief Start exporting shapes to filepath
+     *
+     * Must be called on the thread that owns the document's shapes.
+     * @return false if an export is already running
+     */
+    bool start(const QString& filepath, std::vector<TopoDS_Shape> shapes);
+
+    /**
+     * @brief Request cancellation; finished() reports StepExportResult::cancelled
+     */
+    void cancel();
+
+    bool isRunning() const { return running_; }
+
+signals:
+    void progressChanged(int percent, const QString& stage);
+    void finished(const onecad::io::StepExportResult& result);
+
+private:
+    QThreadPool pool_;
+    std::atomic<bool> cancelled_{false};
+    std::atomic<int> lastPercent_{-1};
+    bool running_ = false;
+};
+
+} // namespace onecad::io
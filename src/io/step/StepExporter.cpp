@@ -4,8 +4,12 @@
  */
 
 #include "StepExporter.h"
+#include "StepProgress.h"
+#include "StepTranslatorLock.h"
 #include "../../app/document/Document.h"
 
+#include <QObject>
+
 #include <STEPControl_Writer.hxx>
 #include <STEPControl_StepModelType.hxx>
 #include <Interface_Static.hxx>
@@ -44,13 +48,26 @@ StepExportResult StepExporter::exportDocument(const QString& filepath,
 
 StepExportResult StepExporter::exportShapes(const QString& filepath,
                                              const std::vector<TopoDS_Shape>& shapes) {
+    return exportShapes(filepath, shapes, StepExportControl{});
+}
+
+StepExportResult StepExporter::exportShapes(const QString& filepath,
+                                             const std::vector<TopoDS_Shape>& shapes,
+                                             const StepExportControl& control) {
     StepExportResult result;
     
     if (shapes.empty()) {
         result.errorMessage = "No shapes to export";
         return result;
     }
+
+    Handle(StepProgressIndicator) progress =
+        new StepProgressIndicator(control.onProgress, control.cancelFlag);
+    Message_ProgressScope exportScope(progress->Start(), "STEP export", 100);
     
+    // Writer parameters are process-global and read until Write() returns
+    std::lock_guard<std::mutex> translatorLock(stepTranslatorMutex());
+
     // Configure STEP writer
     STEPControl_Writer writer;
     
@@ -60,11 +77,24 @@ StepExportResult StepExporter::exportShapes(const QString& filepath,
     // Set schema to AP214 (most compatible)
     Interface_Static::SetCVal("write.step.schema", "AP214");
     
-    // Transfer each shape
+    // Transfer each shape (one shared model, so bodies are translated in turn)
+    progress->setStage(QObject::tr("Translating bodies"));
+    Message_ProgressScope transferScope(exportScope.Next(80), "Transfer",
+                                        static_cast<Standard_Real>(shapes.size()));
     for (const auto& shape : shapes) {
-        if (shape.IsNull()) continue;
+        if (!transferScope.More()) {
+            break;
+        }
+        if (shape.IsNull()) {
+            transferScope.Next();
+            continue;
+        }
         
-        IFSelect_ReturnStatus status = writer.Transfer(shape, STEPControl_AsIs);
+        IFSelect_ReturnStatus status =
+            writer.Transfer(shape, STEPControl_AsIs, Standard_True, transferScope.Next());
+        if (progress->isCancelled()) {
+            break;
+        }
         if (status != IFSelect_RetDone) {
             result.errorMessage = QString("Failed to transfer shape %1 to STEP")
                 .arg(result.bodyCount + 1);
@@ -72,9 +102,17 @@ StepExportResult StepExporter::exportShapes(const QString& filepath,
         }
         result.bodyCount++;
     }
+
+    if (progress->isCancelled()) {
+        result.cancelled = true;
+        result.errorMessage = "STEP export cancelled";
+        return result;
+    }
     
-    // Write file
+    // Write file (no progress reporting in OCCT; weighted as a fixed share)
+    progress->setStage(QObject::tr("Writing file"));
     IFSelect_ReturnStatus writeStatus = writer.Write(filepath.toStdString().c_str());
+    exportScope.Next(20);
     
     if (writeStatus != IFSelect_RetDone) {
         result.errorMessage = QString("Failed to write STEP file: %1").arg(filepath);
@@ -7,6 +7,9 @@
 
 #include <QString>
 #include <QStringList>
+
+#include <atomic>
+#include <functional>
 #include <vector>
 
 class TopoDS_Shape;
@@ -22,10 +25,24 @@ namespace onecad::io {
  */
 struct StepExportResult {
     bool success = false;
+    bool cancelled = false;
     QString errorMessage;
     int bodyCount = 0;
 };
 
+/**
+ * @brief Progress and cancellation hooks for StepExporter::exportShapes()
+ *
+ * Callbacks run on the exporting thread. Cancellation is checked during
+ * each body's translation; once writing has started the file is completed.
+ */
+struct StepExportControl {
+    /// Overall fraction in [0, 1] and the current stage
+    std::function<void(double fraction, const QString& stage)> onProgress;
+    /// Set from any thread to abort; nothing is written after a cancel
+    const std::atomic<bool>* cancelFlag = nullptr;
+};
+
 /**
  * @brief STEP file export using OCCT's STEPControl_Writer
  */
@@ -42,6 +59,13 @@ public:
      */
     static StepExportResult exportShapes(const QString& filepath,
                                           const std::vector<TopoDS_Shape>& shapes);
+
+    /**
+     * @brief Export shapes with progress and cancellation (for background jobs)
+     */
+    static StepExportResult exportShapes(const QString& filepath,
+                                          const std::vector<TopoDS_Shape>& shapes,
+                                          const StepExportControl& control);
     
     /**
      * @brief Export single shape to STEP file
@@ -0,0 +1,86 @@
+/**
+ * @file StepImportJob.cpp
+ * @brief Implementation of background STEP import
+ */
+
+#include "StepImportJob.h"
+#include "../../app/document/Document.h"
+
+#include <QElapsedTimer>
+#include <QLoggingCategory>
+
+#include <algorithm>
+
+Q_LOGGING_CATEGORY(logStepImport, "onecad.io.step")
+
+namespace onecad::io {
+
+StepImportJob::StepImportJob(QObject* parent)
+    : QObject(parent) {
+    pool_.setMaxThreadCount(1);
+}
+
+StepImportJob::~StepImportJob() {
+    cancelled_ = true;
+    pool_.waitForDone();
+}
+
+bool StepImportJob::start(const QString& filepath, const app::Document* document) {
+    if (running_) {
+        return false;
+    }
+    running_ = true;
+    cancelled_ = false;
+    lastPercent_ = -1;
+
+    pool_.start([this, filepath, document]() {
+        QElapsedTimer timer;
+        timer.start();
+
+        StepImportControl control;
+        control.cancelFlag = &cancelled_;
+        control.onProgress = [this](double fraction, const QString& stage) {
+            const int percent = std::clamp(static_cast<int>(fraction * 100.0), 0, 100);
+            if (lastPercent_.exchange(percent) == percent) {
+                return;
+            }
+            QMetaObject::invokeMethod(this, [this, percent, stage]() {
+                emit progressChanged(percent, stage);
+            }, Qt::QueuedConnection);
+        };
+        if (document) {
+            control.prepareBody = [document](const TopoDS_Shape& shape) {
+                document->prepareBodyMesh(shape);
+            };
+        }
+        control.onBody = [this](ImportedBody body) {
+            QMetaObject::invokeMethod(this, [this, body]() {
+                if (!cancelled_) {
+                    emit bodyImported(body);
+                }
+            }, Qt::QueuedConnection);
+        };
+
+        StepImportResult result;
+        try {
+            result = StepImporter::import(filepath, control);
+        } catch (...) {
+            result.success = false;
+            result.errorMessage = "Unexpected exception while importing STEP file";
+        }
+        qCInfo(logStepImport) << "Imported" << result.bodyCount << "bodies from" << filepath
+                              << "in" << timer.elapsed() << "ms";
+
+        QMetaObject::invokeMethod(this, [this, result]() {
+            running_ = false;
+            emit finished(result);
+        }, Qt::QueuedConnection);
+    });
+    return true;
+}
+
+void StepImportJob::cancel() {
+    cancelled_ = true;
+}
+
+} // namespace onecad::io
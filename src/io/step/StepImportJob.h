@@ -0,0 +1,68 @@
+/**
+ * @file StepImportJob.h
+ * @brief Background STEP import with progress and cancellation
+ */
+
+#pragma once
+
+#include "StepImporter.h"
+
+#include <QObject>
+#include <QString>
+#include <QThreadPool>
+
+#include <atomic>
+
+namespace onecad::app {
+class Document;
+}
+
+namespace onecad::io {
+
+/**
+ * @brief Runs StepImporter::import() on a worker thread
+ *
+ * Bodies are triangulated on the worker with Document::prepareBodyMesh()
+ * and handed to the UI thread through bodyImported() as each STEP root
+ * completes, so they can be added and displayed while the rest of the
+ * file is still transferring. All signals are emitted on the thread that
+ * owns the job.
+ */
+class StepImportJob : public QObject {
+    Q_OBJECT
+
+public:
+    explicit StepImportJob(QObject* parent = nullptr);
+    /** @brief Cancels a running import and waits for the worker */
+    ~StepImportJob() override;
+
+    StepImportJob(const StepImportJob&) = delete;
+    StepImportJob& operator=(const StepImportJob&) = delete;
+
+    /**
+     * @brief Start importing filepath
+     * @param document Used for its tessellation settings only; must outlive the job
+     * @return false if an import is already running
+     */
+    bool start(const QString& filepath, const app::Document* document);
+
+    /**
+     * @brief Request cancellation; finished() reports StepImportResult::cancelled
+     */
+    void cancel();
+
+    bool isRunning() const { return running_; }
+
+signals:
+    void progressChanged(int percent, const QString& stage);
+    void bodyImported(const onecad::io::ImportedBody& body);
+    void finished(const onecad::io::StepImportResult& result);
+
+private:
+    QThreadPool pool_;
+    std::atomic<bool> cancelled_{false};
+    std::atomic<int> lastPercent_{-1};
+    bool running_ = false;
+};
+
+} // namespace onecad::io
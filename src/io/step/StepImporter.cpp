@@ -4,8 +4,13 @@
  */
 
 #include "StepImporter.h"
+#include "StepProgress.h"
+#include "StepTranslatorLock.h"
 #include "../../app/document/Document.h"
 
+#include <QObject>
+#include <QThreadPool>
+
 #include <STEPControl_Reader.hxx>
 #include <IFSelect_ReturnStatus.hxx>
 #include <Interface_Static.hxx>
@@ -17,82 +22,162 @@
 
 namespace onecad::io {
 
+namespace {
+
+/**
+ * @brief Split a transferred root into bodies
+ *
+ * Solids become bodies; a root without solids contributes its shells,
+ * and a root without either is kept whole.
+ */
+std::vector<ImportedBody> extractBodies(const TopoDS_Shape& rootShape,
+                                        int& bodyIndex, int& geometryIndex) {
+    std::vector<ImportedBody> bodies;
+
+    for (TopExp_Explorer solidExp(rootShape, TopAbs_SOLID); solidExp.More(); solidExp.Next()) {
+        TopoDS_Solid solid = TopoDS::Solid(solidExp.Current());
+        if (!solid.IsNull()) {
+            ImportedBody body;
+            body.shape = solid;
+            body.name = QString("Imported Body %1").arg(bodyIndex++);
+            bodies.push_back(body);
+        }
+    }
+
+    if (bodies.empty()) {
+        for (TopExp_Explorer shellExp(rootShape, TopAbs_SHELL); shellExp.More(); shellExp.Next()) {
+            TopoDS_Shell shell = TopoDS::Shell(shellExp.Current());
+            if (!shell.IsNull()) {
+                ImportedBody body;
+                body.shape = shell;
+                body.name = QString("Imported Surface %1").arg(bodyIndex++);
+                bodies.push_back(body);
+            }
+        }
+    }
+
+    if (bodies.empty() && !rootShape.IsNull()) {
+        ImportedBody body;
+        body.shape = rootShape;
+        body.name = geometryIndex == 1 ? QString("Imported Geometry")
+                                       : QString("Imported Geometry %1").arg(geometryIndex);
+        ++geometryIndex;
+        bodies.push_back(body);
+    }
+
+    return bodies;
+}
+
+} // anonymous namespace
+
 StepImportResult StepImporter::import(const QString& filepath) {
+    return import(filepath, StepImportControl{});
+}
+
+StepImportResult StepImporter::import(const QString& filepath, const StepImportControl& control) {
     StepImportResult result;
-    
+    Handle(StepProgressIndicator) progress =
+        new StepProgressIndicator(control.onProgress, control.cancelFlag);
+    auto isCancelled = [&progress]() { return progress->isCancelled(); };
+    Message_ProgressScope importScope(progress->Start(), "STEP import", 100);
+
+    // Reader parameters are process-global and read throughout the transfer
+    std::lock_guard<std::mutex> translatorLock(stepTranslatorMutex());
+
     // Create STEP reader
     STEPControl_Reader reader;
-    
+
     // Set unit interpretation
     Interface_Static::SetCVal("xstep.cascade.unit", "MM");
-    
-    // Read file
+
+    // Read file (no progress reporting in OCCT; weighted as a fixed share)
+    progress->setStage(QObject::tr("Reading file"));
     IFSelect_ReturnStatus readStatus = reader.ReadFile(filepath.toStdString().c_str());
-    
+    importScope.Next(20);
+
     if (readStatus != IFSelect_RetDone) {
         result.errorMessage = QString("Failed to read STEP file: %1").arg(filepath);
         return result;
     }
-    
+
     // Check for roots
-    int numRoots = reader.NbRootsForTransfer();
+    const int numRoots = reader.NbRootsForTransfer();
     if (numRoots == 0) {
         result.errorMessage = "STEP file contains no geometry roots";
         return result;
     }
-    
-    // Transfer all roots
-    reader.TransferRoots();
-    
-    // Get the combined shape
-    TopoDS_Shape combinedShape = reader.OneShape();
-    
-    if (combinedShape.IsNull()) {
-        result.errorMessage = "Failed to transfer geometry from STEP file";
-        return result;
-    }
-    
-    // Extract individual solids (per user decision: each solid becomes separate body)
+
+    // Bodies are prepared and delivered in root order, overlapping the transfer.
+    // One helper thread: roots may share geometry, and BRepMesh already meshes
+    // the faces of one body in parallel.
+    QThreadPool helper;
+    helper.setMaxThreadCount(1);
+    auto deliver = [&control, &result, &isCancelled](ImportedBody body) {
+        if (isCancelled()) {
+            return;
+        }
+        if (control.prepareBody) {
+            control.prepareBody(body.shape);
+        }
+        ++result.bodyCount;
+        if (control.onBody) {
+            control.onBody(std::move(body));
+        } else {
+            result.bodies.push_back(std::move(body));
+        }
+    };
+
+    // Transfer root by root so bodies can be used before the whole file is done
+    progress->setStage(QObject::tr("Transferring geometry"));
+    Message_ProgressScope transferScope(importScope.Next(80), "Transfer", numRoots);
     int bodyIndex = 1;
-    TopExp_Explorer solidExp(combinedShape, TopAbs_SOLID);
-    
-    for (; solidExp.More(); solidExp.Next()) {
-        TopoDS_Solid solid = TopoDS::Solid(solidExp.Current());
-        if (!solid.IsNull()) {
-            ImportedBody body;
-            body.shape = solid;
-            body.name = QString("Imported Body %1").arg(bodyIndex++);
-            result.bodies.push_back(body);
+    int geometryIndex = 1;
+    bool transferred = false;
+    for (int root = 1; root <= numRoots && transferScope.More(); ++root) {
+        const int shapesBefore = reader.NbShapes();
+        reader.TransferRoot(root, transferScope.Next());
+        if (isCancelled()) {
+            break;
         }
-    }
-    
-    // If no solids, try shells
-    if (result.bodies.empty()) {
-        TopExp_Explorer shellExp(combinedShape, TopAbs_SHELL);
-        for (; shellExp.More(); shellExp.Next()) {
-            TopoDS_Shell shell = TopoDS::Shell(shellExp.Current());
-            if (!shell.IsNull()) {
-                ImportedBody body;
-                body.shape = shell;
-                body.name = QString("Imported Surface %1").arg(bodyIndex++);
-                result.bodies.push_back(body);
+
+        for (int shapeIndex = shapesBefore + 1; shapeIndex <= reader.NbShapes(); ++shapeIndex) {
+            const TopoDS_Shape rootShape = reader.Shape(shapeIndex);
+            if (rootShape.IsNull()) {
+                continue;
+            }
+            transferred = true;
+            for (ImportedBody& body : extractBodies(rootShape, bodyIndex, geometryIndex)) {
+                if (control.pipelined) {
+                    helper.start([&deliver, body = std::move(body)]() mutable {
+                        deliver(std::move(body));
+                    });
+                } else {
+                    deliver(std::move(body));
+                }
             }
         }
     }
-    
-    // If still empty and we have a compound, use it directly
-    if (result.bodies.empty() && !combinedShape.IsNull()) {
-        ImportedBody body;
-        body.shape = combinedShape;
-        body.name = "Imported Geometry";
-        result.bodies.push_back(body);
+    helper.waitForDone();
+
+    if (isCancelled()) {
+        result.cancelled = true;
+        result.errorMessage = "STEP import cancelled";
+        return result;
     }
-    
-    if (result.bodies.empty()) {
+
+    if (!transferred) {
+        result.errorMessage = "Failed to transfer geometry from STEP file";
+        return result;
+    }
+
+    if (result.bodyCount == 0) {
         result.errorMessage = "STEP file contains no usable geometry";
         return result;
     }
-    
+
+    if (control.onProgress) {
+        control.onProgress(1.0, QObject::tr("Done"));
+    }
     result.success = true;
     return result;
 }
@@ -108,12 +193,9 @@ StepImportResult StepImporter::importIntoDocument(const QString& filepath,
     
     // Add each body to document
     for (const auto& body : result.bodies) {
-        document->addBody(body.shape);
-        
-        // Get the ID of the just-added body and set its name
-        auto bodyIds = document->getBodyIds();
-        if (!bodyIds.empty()) {
-            document->setBodyName(bodyIds.back(), body.name.toStdString());
+        const std::string bodyId = document->addBody(body.shape);
+        if (!bodyId.empty()) {
+            document->setBodyName(bodyId, body.name.toStdString());
         }
     }
     
@@ -6,6 +6,10 @@
 #pragma once
 
 #include <QString>
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
 #include <vector>
 
 #include <TopoDS_Shape.hxx>
@@ -30,8 +34,31 @@ struct ImportedBody {
  */
 struct StepImportResult {
     bool success = false;
+    bool cancelled = false;
     QString errorMessage;
-    std::vector<ImportedBody> bodies;
+    std::vector<ImportedBody> bodies;  ///< Empty when streamed through StepImportControl::onBody
+    size_t bodyCount = 0;              ///< Bodies produced, streamed or not
+};
+
+/**
+ * @brief Progress, cancellation and streaming hooks for StepImporter::import()
+ *
+ * Roots are transferred one at a time on the calling thread, which also
+ * runs onProgress. Each body is passed to prepareBody and then onBody as
+ * soon as its root is transferred; with pipelined set both run on a single
+ * helper thread while later roots are still transferring.
+ */
+struct StepImportControl {
+    /// Overall fraction in [0, 1] and the current stage
+    std::function<void(double fraction, const QString& stage)> onProgress;
+    /// Runs before onBody, e.g. Document::prepareBodyMesh()
+    std::function<void(const TopoDS_Shape& shape)> prepareBody;
+    /// Receives bodies as they become ready instead of StepImportResult::bodies
+    std::function<void(ImportedBody body)> onBody;
+    /// Set from any thread to abort; checked between roots and inside OCCT transfer
+    const std::atomic<bool>* cancelFlag = nullptr;
+    /// Prepare and deliver bodies on a helper thread, overlapping the transfer
+    bool pipelined = true;
 };
 
 /**
@@ -46,6 +73,14 @@ public:
      * @brief Import STEP file and return shapes
      */
     static StepImportResult import(const QString& filepath);
+
+    /**
+     * @brief Import STEP file root by root with progress and cancellation
+     *
+     * Reading the file itself cannot be interrupted; cancellation takes
+     * effect from the transfer stage on.
+     */
+    static StepImportResult import(const QString& filepath, const StepImportControl& control);
     
     /**
      * @brief Import STEP file directly into document
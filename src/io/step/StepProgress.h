@@ -0,0 +1,64 @@
+/**
+ * @file StepProgress.h
+ * @brief OCCT progress indicator shared by STEP import and export
+ */
+
+#pragma once
+
+#include <QString>
+
+#include <Message_ProgressIndicator.hxx>
+#include <Message_ProgressScope.hxx>
+
+#include <atomic>
+#include <functional>
+
+namespace onecad::io {
+
+/**
+ * @brief Forwards OCCT progress to a callback and reports cancellation
+ *
+ * Only visible changes (per mille) are forwarded. The stage label is set
+ * by the caller between phases.
+ */
+class StepProgressIndicator : public Message_ProgressIndicator {
+public:
+    using Callback = std::function<void(double fraction, const QString& stage)>;
+
+    StepProgressIndicator(const Callback& onProgress, const std::atomic<bool>* cancelFlag)
+        : onProgress_(onProgress), cancelFlag_(cancelFlag) {}
+
+    void setStage(const QString& stage) {
+        stage_ = stage;
+        if (onProgress_) {
+            onProgress_(GetPosition(), stage_);
+        }
+    }
+
+    bool isCancelled() const {
+        return cancelFlag_ && cancelFlag_->load(std::memory_order_relaxed);
+    }
+
+    Standard_Boolean UserBreak() override { return isCancelled(); }
+
+    void Show(const Message_ProgressScope& /*scope*/, const Standard_Boolean isForce) override {
+        if (!onProgress_) {
+            return;
+        }
+        const double position = GetPosition();
+        const int permille = static_cast<int>(position * 1000.0);
+        if (!isForce && permille == lastPermille_) {
+            return;
+        }
+        lastPermille_ = permille;
+        onProgress_(position, stage_);
+    }
+
+private:
+    const Callback& onProgress_;
+    const std::atomic<bool>* cancelFlag_;
+    QString stage_;
+    int lastPermille_ = -1;
+};
+
+} // namespace onecad::io
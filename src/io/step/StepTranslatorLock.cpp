@@ -0,0 +1,15 @@
+/**
+ * @file StepTranslatorLock.cpp
+ * @brief Shared STEP translator mutex
+ */
+
+#include "StepTranslatorLock.h"
+
+namespace onecad::io {
+
+std::mutex& stepTranslatorMutex() {
+    static std::mutex mutex;
+    return mutex;
+}
+
+} // namespace onecad::io
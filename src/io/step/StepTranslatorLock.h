@@ -0,0 +1,21 @@
+/**
+ * @file StepTranslatorLock.h
+ * @brief Serializes STEP translation across import and export workers
+ */
+
+#pragma once
+
+#include <mutex>
+
+namespace onecad::io {
+
+/**
+ * @brief Mutex guarding OCCT's process-global STEP translator state
+ *
+ * Interface_Static parameters are shared by every STEPControl_Reader and
+ * STEPControl_Writer and are read during transfer, so a translator holds
+ * this lock from setup until it is done with the file.
+ */
+std::mutex& stepTranslatorMutex();
+
+} // namespace onecad::io
@@ -38,6 +38,8 @@
 #include <gp_Pnt.hxx>
 #include <gp_Vec.hxx>
 
+#include "../../core/memory/MemoryEstimate.h"
+
 namespace onecad::kernel::elementmap {
 
 enum class ElementKind {
@@ -105,6 +107,10 @@ public:
     std::string toString() const;
     bool fromString(const std::string& data);
 
+    std::size_t size() const { return entries_.size(); }
+    // Approximate bytes of entries and the shape index; the shapes themselves are not counted.
+    std::size_t memoryBytes() const;
+
 private:
     enum class ChildReason {
         Split,
@@ -1092,6 +1098,28 @@ inline bool ElementMap::read(std::istream& is) {
     return true;
 }
 
+inline std::size_t ElementMap::memoryBytes() const {
+    std::size_t bytes = core::memory::stringMapBytes(entries_);
+    for (const auto& [key, entry] : entries_) {
+        (void)key;
+        bytes += core::memory::stringBytes(entry.id.value) + core::memory::stringBytes(entry.opId);
+        bytes += core::memory::vectorBytes(entry.sources);
+        for (const auto& source : entry.sources) {
+            bytes += core::memory::stringBytes(source.value);
+        }
+    }
+
+    using ShapeIdsMap = decltype(shapeToIds_);
+    bytes += static_cast<std::size_t>(shapeToIds_.NbBuckets() + 1) * sizeof(void*);
+    for (ShapeIdsMap::Iterator it(shapeToIds_); it.More(); it.Next()) {
+        bytes += sizeof(ShapeIdsMap::DataMapNode) + core::memory::vectorBytes(it.Value());
+        for (const auto& id : it.Value()) {
+            bytes += core::memory::stringBytes(id);
+        }
+    }
+    return bytes;
+}
+
 inline std::string ElementMap::toString() const {
     std::ostringstream oss;
     write(oss);
@@ -10,6 +10,7 @@
 
 #include "app/Application.h"
 #include "app/Logging.h"
+#include "core/trace/Trace.h"
 #include "ui/mainwindow/MainWindow.h"
 
 // Eigen3
@@ -180,6 +181,13 @@ int main(int argc, char* argv[]) {
 
     QApplication app(argc, argv);
 
+    // ONECAD_TRACE=<file.json> records a Chrome/Perfetto trace of the session
+    const QString tracePath = qEnvironmentVariable("ONECAD_TRACE").trimmed();
+    if (!tracePath.isEmpty()) {
+        onecad::core::trace::start();
+        qCInfo(logMain) << "Trace recording enabled" << "traceFile=" << tracePath;
+    }
+
     UserActionEventFilter debugEventFilter;
     if (onecad::app::Logging::isDebugLoggingEnabled()) {
         app.installEventFilter(&debugEventFilter);
@@ -209,6 +217,9 @@ int main(int argc, char* argv[]) {
     qCInfo(logMain) << "Qt event loop exited" << "exitCode=" << result;
 
     oneCAD.shutdown();
+    if (!tracePath.isEmpty()) {
+        onecad::core::trace::stop(tracePath.toStdString());
+    }
     onecad::app::Logging::shutdown();
     return result;
 }
@@ -285,7 +285,6 @@ void BodyRenderer::initialize() {
         return;
     }
 
-    ensureBuffers(&m_mainBuffers, QOpenGLBuffer::StaticDraw);
     ensureBuffers(&m_previewBuffers, QOpenGLBuffer::DynamicDraw);
 
     m_initialized = true;
@@ -296,15 +295,21 @@ void BodyRenderer::cleanup() {
         return;
     }
 
-    m_mainBuffers.triangles.vao.destroy();
-    m_mainBuffers.triangles.vbo.destroy();
-    m_mainBuffers.edges.vao.destroy();
-    m_mainBuffers.edges.vbo.destroy();
+    // Uploaded bodies keep only their GPU copy, so they go with it
+    for (auto& [bodyId, body] : m_bodies) {
+        (void)bodyId;
+        destroyBuffers(&body->gpu);
+    }
+    for (auto& body : m_retiredBodies) {
+        destroyBuffers(&body->gpu);
+    }
+    m_bodies.clear();
+    m_retiredBodies.clear();
+    m_bodyBatch.clear();
+    m_bodyBounds = Bounds{};
+    m_bodiesDirty = false;
 
-    m_previewBuffers.triangles.vao.destroy();
-    m_previewBuffers.triangles.vbo.destroy();
-    m_previewBuffers.edges.vao.destroy();
-    m_previewBuffers.edges.vbo.destroy();
+    destroyBuffers(&m_previewBuffers);
 
     m_triangleShader.reset();
     m_edgeShader.reset();
@@ -312,13 +317,72 @@ void BodyRenderer::cleanup() {
 }
 
 void BodyRenderer::setMeshes(const std::vector<SceneMeshStore::Mesh>& meshes) {
-    buildBuffers(meshes, &m_mainCpu);
-    m_mainDirty = true;
+    std::unordered_set<std::string> seen;
+    for (const auto& mesh : meshes) {
+        if (seen.insert(mesh.bodyId).second) {
+            resetBody(mesh.bodyId);
+        }
+        appendMeshBuffers(mesh, &m_bodies[mesh.bodyId]->cpu);
+    }
+    retireBodiesExcept(seen);
 }
 
 void BodyRenderer::setMeshes(const SceneMeshStore& store) {
-    buildBuffers(store, &m_mainCpu);
-    m_mainDirty = true;
+    std::unordered_set<std::string> seen;
+    store.forEachMesh([&](const SceneMeshStore::Mesh& mesh) {
+        if (seen.insert(mesh.bodyId).second) {
+            resetBody(mesh.bodyId);
+        }
+        appendMeshBuffers(mesh, &m_bodies[mesh.bodyId]->cpu);
+    });
+    retireBodiesExcept(seen);
+}
+
+void BodyRenderer::setBodyMesh(const SceneMeshStore::Mesh& mesh) {
+    appendMeshBuffers(mesh, &resetBody(mesh.bodyId).cpu);
+}
+
+void BodyRenderer::removeBodyMesh(const std::string& bodyId) {
+    auto it = m_bodies.find(bodyId);
+    if (it == m_bodies.end()) {
+        return;
+    }
+    retireBody(std::move(it->second));
+    m_bodies.erase(it);
+    m_bodiesDirty = true;
+}
+
+BodyRenderer::BodyBuffers& BodyRenderer::resetBody(const std::string& bodyId) {
+    auto& body = m_bodies[bodyId];
+    if (!body) {
+        body = std::make_unique<BodyBuffers>();
+    }
+    body->cpu.triangles.clear();
+    body->cpu.edges.clear();
+    body->cpu.bounds = Bounds{};
+    body->dirty = true;
+    m_bodiesDirty = true;
+    return *body;
+}
+
+void BodyRenderer::retireBodiesExcept(const std::unordered_set<std::string>& keep) {
+    for (auto it = m_bodies.begin(); it != m_bodies.end();) {
+        if (keep.count(it->first) == 0) {
+            retireBody(std::move(it->second));
+            it = m_bodies.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    m_bodiesDirty = true;
+}
+
+void BodyRenderer::retireBody(std::unique_ptr<BodyBuffers> body) {
+    // GL objects can only be destroyed with the context current, which is
+    // guaranteed in render() but not in the mesh setters.
+    if (body) {
+        m_retiredBodies.push_back(std::move(body));
+    }
 }
 
 void BodyRenderer::setPreviewMeshes(const std::vector<SceneMeshStore::Mesh>& meshes) {
@@ -333,6 +397,25 @@ void BodyRenderer::clearPreview() {
     m_previewDirty = true;
 }
 
+std::size_t BodyRenderer::cpuBytes(const CpuBuffers& buffers) {
+    return (buffers.triangles.capacity() + buffers.edges.capacity()) * sizeof(float);
+}
+
+BodyRenderer::MemoryUsage BodyRenderer::memoryUsage() const {
+    MemoryUsage usage;
+    usage.perBodyBytes.reserve(m_bodies.size());
+    for (const auto& [bodyId, body] : m_bodies) {
+        const std::size_t cpu = cpuBytes(body->cpu);
+        const std::size_t gpu = body->gpu.triangles.allocatedBytes + body->gpu.edges.allocatedBytes;
+        usage.perBodyBytes[bodyId] = cpu + gpu;
+        usage.bodyCpuBytes += cpu;
+        usage.gpuBytes += gpu;
+    }
+    usage.previewCpuBytes = cpuBytes(m_previewCpu);
+    usage.gpuBytes += m_previewBuffers.triangles.allocatedBytes + m_previewBuffers.edges.allocatedBytes;
+    return usage;
+}
+
 void BodyRenderer::render(const QMatrix4x4& viewProjection,
                           const QMatrix4x4& view,
                           const RenderStyle& style) {
@@ -340,9 +423,9 @@ void BodyRenderer::render(const QMatrix4x4& viewProjection,
         return;
     }
 
-    if (m_mainDirty) {
-        uploadBuffers(m_mainCpu, &m_mainBuffers);
-        m_mainDirty = false;
+    if (m_bodiesDirty) {
+        syncBodyBuffers();
+        m_bodiesDirty = false;
     }
     if (m_previewDirty) {
         uploadBuffers(m_previewCpu, &m_previewBuffers);
@@ -350,9 +433,9 @@ void BodyRenderer::render(const QMatrix4x4& viewProjection,
     }
 
     const QMatrix3x3 viewNormal = view.normalMatrix();
-    renderBatch(m_mainBuffers, viewProjection, view, viewNormal, m_mainCpu.bounds, style, -1.0f);
+    renderBatch(m_bodyBatch, viewProjection, view, viewNormal, m_bodyBounds, style, -1.0f);
     if (m_previewBuffers.triangles.vertexCount > 0 || m_previewBuffers.edges.vertexCount > 0) {
-        renderBatch(m_previewBuffers, viewProjection, view, viewNormal, m_previewCpu.bounds, style, style.previewAlpha);
+        renderBatch({&m_previewBuffers}, viewProjection, view, viewNormal, m_previewCpu.bounds, style, style.previewAlpha);
     }
 }
 
@@ -370,17 +453,43 @@ void BodyRenderer::buildBuffers(const std::vector<SceneMeshStore::Mesh>& meshes,
     }
 }
 
-void BodyRenderer::buildBuffers(const SceneMeshStore& store, CpuBuffers* outBuffers) const {
-    if (!outBuffers) {
-        return;
-    }
-    outBuffers->triangles.clear();
-    outBuffers->edges.clear();
-    outBuffers->bounds.valid = false;
+void BodyRenderer::syncBodyBuffers() {
+    for (auto& body : m_retiredBodies) {
+        destroyBuffers(&body->gpu);
+    }
+    m_retiredBodies.clear();
+
+    m_bodyBatch.clear();
+    m_bodyBatch.reserve(m_bodies.size());
+    m_bodyBounds = Bounds{};
+    for (auto& [bodyId, body] : m_bodies) {
+        (void)bodyId;
+        if (body->dirty) {
+            ensureBuffers(&body->gpu, QOpenGLBuffer::StaticDraw);
+            uploadBuffers(body->cpu, &body->gpu);
+            // The GPU copy is authoritative from here on
+            std::vector<float>().swap(body->cpu.triangles);
+            std::vector<float>().swap(body->cpu.edges);
+            body->dirty = false;
+        }
+        m_bodyBatch.push_back(&body->gpu);
 
-    store.forEachMesh([&](const SceneMeshStore::Mesh& mesh) {
-        appendMeshBuffers(mesh, outBuffers);
-    });
+        const Bounds& bodyBounds = body->cpu.bounds;
+        if (!bodyBounds.valid) {
+            continue;
+        }
+        if (!m_bodyBounds.valid) {
+            m_bodyBounds = bodyBounds;
+            continue;
+        }
+        Bounds& bounds = m_bodyBounds;
+        bounds.min.setX(std::min(bounds.min.x(), bodyBounds.min.x()));
+        bounds.min.setY(std::min(bounds.min.y(), bodyBounds.min.y()));
+        bounds.min.setZ(std::min(bounds.min.z(), bodyBounds.min.z()));
+        bounds.max.setX(std::max(bounds.max.x(), bodyBounds.max.x()));
+        bounds.max.setY(std::max(bounds.max.y(), bodyBounds.max.y()));
+        bounds.max.setZ(std::max(bounds.max.z(), bodyBounds.max.z()));
+    }
 }
 
 void BodyRenderer::appendMeshBuffers(const SceneMeshStore::Mesh& mesh, CpuBuffers* outBuffers) const {
@@ -533,6 +642,15 @@ void BodyRenderer::ensureBuffers(RenderBuffers* buffers, QOpenGLBuffer::UsagePat
     }
 }
 
+void BodyRenderer::destroyBuffers(RenderBuffers* buffers) {
+    for (DrawBuffers* draw : {&buffers->triangles, &buffers->edges}) {
+        draw->vao.destroy();
+        draw->vbo.destroy();
+        draw->vertexCount = 0;
+        draw->allocatedBytes = 0;
+    }
+}
+
 void BodyRenderer::uploadBuffers(const CpuBuffers& cpu, RenderBuffers* buffers) {
     if (!buffers) {
         return;
@@ -543,12 +661,14 @@ void BodyRenderer::uploadBuffers(const CpuBuffers& cpu, RenderBuffers* buffers)
     }
 
     buffers->triangles.vertexCount = 0;
+    buffers->triangles.allocatedBytes = 0;
     if (!cpu.triangles.empty()) {
         buffers->triangles.vertexCount = static_cast<int>(cpu.triangles.size() / 6);
         buffers->triangles.vao.bind();
         buffers->triangles.vbo.bind();
         buffers->triangles.vbo.allocate(cpu.triangles.data(),
                                         static_cast<int>(cpu.triangles.size() * sizeof(float)));
+        buffers->triangles.allocatedBytes = cpu.triangles.size() * sizeof(float);
         glEnableVertexAttribArray(0);
         glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float),
                               reinterpret_cast<void*>(0));
@@ -560,12 +680,14 @@ void BodyRenderer::uploadBuffers(const CpuBuffers& cpu, RenderBuffers* buffers)
     }
 
     buffers->edges.vertexCount = 0;
+    buffers->edges.allocatedBytes = 0;
     if (!cpu.edges.empty()) {
         buffers->edges.vertexCount = static_cast<int>(cpu.edges.size() / 3);
         buffers->edges.vao.bind();
         buffers->edges.vbo.bind();
         buffers->edges.vbo.allocate(cpu.edges.data(),
                                     static_cast<int>(cpu.edges.size() * sizeof(float)));
+        buffers->edges.allocatedBytes = cpu.edges.size() * sizeof(float);
         glEnableVertexAttribArray(0);
         glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float),
                               reinterpret_cast<void*>(0));
@@ -574,7 +696,7 @@ void BodyRenderer::uploadBuffers(const CpuBuffers& cpu, RenderBuffers* buffers)
     }
 }
 
-void BodyRenderer::renderBatch(RenderBuffers& buffers,
+void BodyRenderer::renderBatch(const std::vector<RenderBuffers*>& batch,
                                const QMatrix4x4& viewProjection,
                                const QMatrix4x4& view,
                                const QMatrix3x3& viewNormal,
@@ -610,8 +732,26 @@ void BodyRenderer::renderBatch(RenderBuffers& buffers,
         gradientStrength = 0.0f;
     }
 
+    int triangleVertices = 0;
+    int edgeVertices = 0;
+    for (const RenderBuffers* buffers : batch) {
+        triangleVertices += buffers->triangles.vertexCount;
+        edgeVertices += buffers->edges.vertexCount;
+    }
+    const auto drawAll = [&batch, this](DrawBuffers RenderBuffers::*draw, GLenum mode) {
+        for (RenderBuffers* buffers : batch) {
+            DrawBuffers& target = buffers->*draw;
+            if (target.vertexCount == 0) {
+                continue;
+            }
+            target.vao.bind();
+            glDrawArrays(mode, 0, target.vertexCount);
+            target.vao.release();
+        }
+    };
+
     // Skip triangle pass in wireframe-only mode
-    if (buffers.triangles.vertexCount > 0 && !style.wireframeOnly) {
+    if (triangleVertices > 0 && !style.wireframeOnly) {
         glEnable(GL_DEPTH_TEST);
         glDepthFunc(GL_LESS);
         glDisable(GL_CULL_FACE);
@@ -663,9 +803,7 @@ void BodyRenderer::renderBatch(RenderBuffers& buffers,
         m_triangleShader->setUniformValue("uFar", farPlane);
         m_triangleShader->setUniformValue("uIsOrtho", style.isOrtho);
 
-        buffers.triangles.vao.bind();
-        glDrawArrays(GL_TRIANGLES, 0, buffers.triangles.vertexCount);
-        buffers.triangles.vao.release();
+        drawAll(&RenderBuffers::triangles, GL_TRIANGLES);
 
         m_triangleShader->release();
 
@@ -673,7 +811,7 @@ void BodyRenderer::renderBatch(RenderBuffers& buffers,
         glDisable(GL_BLEND);
     }
 
-    if (style.drawGlow && buffers.edges.vertexCount > 0 && glowAlpha > 0.0f) {
+    if (style.drawGlow && edgeVertices > 0 && glowAlpha > 0.0f) {
         glEnable(GL_DEPTH_TEST);
         glDepthFunc(GL_LEQUAL);
 
@@ -685,9 +823,7 @@ void BodyRenderer::renderBatch(RenderBuffers& buffers,
         m_edgeShader->setUniformValue("uColor", QVector4D(glowColor, glowAlpha));
 
         glLineWidth(3.0f);
-        buffers.edges.vao.bind();
-        glDrawArrays(GL_LINES, 0, buffers.edges.vertexCount);
-        buffers.edges.vao.release();
+        drawAll(&RenderBuffers::edges, GL_LINES);
         glLineWidth(1.0f);
 
         m_edgeShader->release();
@@ -695,7 +831,7 @@ void BodyRenderer::renderBatch(RenderBuffers& buffers,
         glDisable(GL_BLEND);
     }
 
-    if (style.drawEdges && buffers.edges.vertexCount > 0) {
+    if (style.drawEdges && edgeVertices > 0) {
         glEnable(GL_DEPTH_TEST);
         glDepthFunc(GL_LEQUAL);
 
@@ -711,9 +847,7 @@ void BodyRenderer::renderBatch(RenderBuffers& buffers,
         m_edgeShader->setUniformValue("uColor", QVector4D(edgeColor, edgeAlpha));
 
         glLineWidth(1.5f);
-        buffers.edges.vao.bind();
-        glDrawArrays(GL_LINES, 0, buffers.edges.vertexCount);
-        buffers.edges.vao.release();
+        drawAll(&RenderBuffers::edges, GL_LINES);
         glLineWidth(1.0f);
 
         m_edgeShader->release();
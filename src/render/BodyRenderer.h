@@ -9,6 +9,9 @@
 #include <QOpenGLVertexArrayObject>
 #include <QVector3D>
 #include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include "scene/SceneMeshStore.h"
@@ -57,6 +60,20 @@ public:
         bool isOrtho = false;
     };
 
+    /**
+     * @brief Approximate bytes held by the renderer
+     *
+     * GPU bytes are the sizes last uploaded to the vertex buffers; the
+     * driver may keep additional copies. Body vertex arrays are released
+     * once uploaded, so bodyCpuBytes only counts pending uploads.
+     */
+    struct MemoryUsage {
+        std::size_t bodyCpuBytes = 0;     // Body vertex arrays awaiting upload
+        std::size_t previewCpuBytes = 0;
+        std::size_t gpuBytes = 0;
+        std::unordered_map<std::string, std::size_t> perBodyBytes;  // CPU + GPU
+    };
+
     BodyRenderer();
     ~BodyRenderer();
     BodyRenderer(const BodyRenderer&) = delete;
@@ -70,9 +87,20 @@ public:
 
     void setMeshes(const SceneMeshStore& store);
     void setMeshes(const std::vector<SceneMeshStore::Mesh>& meshes);
+    /**
+     * @brief Add or replace a single body's mesh (keyed by Mesh::bodyId)
+     *
+     * Each body owns its vertex buffers; only this body's buffers are
+     * uploaded on the next render.
+     */
+    void setBodyMesh(const SceneMeshStore::Mesh& mesh);
+    void removeBodyMesh(const std::string& bodyId);
+    bool hasBodyMesh(const std::string& bodyId) const { return m_bodies.count(bodyId) > 0; }
     void setPreviewMeshes(const std::vector<SceneMeshStore::Mesh>& meshes);
     void clearPreview();
 
+    MemoryUsage memoryUsage() const;
+
     void render(const QMatrix4x4& viewProjection,
                 const QMatrix4x4& view,
                 const RenderStyle& style);
@@ -94,6 +122,7 @@ private:
         QOpenGLVertexArrayObject vao;
         QOpenGLBuffer vbo{QOpenGLBuffer::VertexBuffer};
         int vertexCount = 0;
+        std::size_t allocatedBytes = 0;  // Size of the last vbo.allocate()
     };
 
     struct RenderBuffers {
@@ -101,12 +130,23 @@ private:
         DrawBuffers edges;
     };
 
+    struct BodyBuffers {
+        CpuBuffers cpu;       // Cleared after upload; bounds are kept
+        RenderBuffers gpu;
+        bool dirty = true;
+    };
+
+    static std::size_t cpuBytes(const CpuBuffers& buffers);
     void buildBuffers(const std::vector<SceneMeshStore::Mesh>& meshes, CpuBuffers* outBuffers) const;
-    void buildBuffers(const SceneMeshStore& store, CpuBuffers* outBuffers) const;
+    BodyBuffers& resetBody(const std::string& bodyId);
+    void retireBodiesExcept(const std::unordered_set<std::string>& keep);
+    void retireBody(std::unique_ptr<BodyBuffers> body);
+    void syncBodyBuffers();
+    static void destroyBuffers(RenderBuffers* buffers);
     void appendMeshBuffers(const SceneMeshStore::Mesh& mesh, CpuBuffers* outBuffers) const;
     void ensureBuffers(RenderBuffers* buffers, QOpenGLBuffer::UsagePattern usage);
     void uploadBuffers(const CpuBuffers& cpu, RenderBuffers* buffers);
-    void renderBatch(RenderBuffers& buffers,
+    void renderBatch(const std::vector<RenderBuffers*>& batch,
                      const QMatrix4x4& viewProjection,
                      const QMatrix4x4& view,
                      const QMatrix3x3& viewNormal,
@@ -116,11 +156,13 @@ private:
 
     std::unique_ptr<QOpenGLShaderProgram> m_triangleShader;
     std::unique_ptr<QOpenGLShaderProgram> m_edgeShader;
-    RenderBuffers m_mainBuffers;
     RenderBuffers m_previewBuffers;
-    CpuBuffers m_mainCpu;
+    std::unordered_map<std::string, std::unique_ptr<BodyBuffers>> m_bodies;
+    std::vector<std::unique_ptr<BodyBuffers>> m_retiredBodies;  // Destroyed on the next render
+    std::vector<RenderBuffers*> m_bodyBatch;
+    Bounds m_bodyBounds;
     CpuBuffers m_previewCpu;
-    bool m_mainDirty = false;
+    bool m_bodiesDirty = false;
     bool m_previewDirty = false;
     bool m_initialized = false;
 };
@@ -1,5 +1,7 @@
 #include "SceneMeshStore.h"
 
+#include "../../core/memory/MemoryEstimate.h"
+
 namespace onecad::render {
 
 void SceneMeshStore::setBodyMesh(const std::string& bodyId, Mesh mesh) {
@@ -32,4 +34,42 @@ const SceneMeshStore::Mesh* SceneMeshStore::findMesh(const std::string& bodyId)
     return &it->second;
 }
 
+std::size_t SceneMeshStore::meshBytes(const Mesh& mesh) {
+    using core::memory::stringBytes;
+    using core::memory::stringMapBytes;
+    using core::memory::vectorBytes;
+
+    std::size_t bytes = sizeof(Mesh) + stringBytes(mesh.bodyId);
+    bytes += vectorBytes(mesh.vertices) + vectorBytes(mesh.normals) + vectorBytes(mesh.triangles);
+    for (const auto& triangle : mesh.triangles) {
+        bytes += stringBytes(triangle.faceId);
+    }
+    bytes += stringMapBytes(mesh.topologyByFace);
+    for (const auto& [faceId, topology] : mesh.topologyByFace) {
+        (void)faceId;
+        bytes += stringBytes(topology.faceId);
+        bytes += vectorBytes(topology.edges) + vectorBytes(topology.vertices);
+        for (const auto& edge : topology.edges) {
+            bytes += stringBytes(edge.edgeId) + vectorBytes(edge.points);
+        }
+        for (const auto& vertex : topology.vertices) {
+            bytes += stringBytes(vertex.vertexId);
+        }
+    }
+    bytes += stringMapBytes(mesh.faceGroupByFaceId);
+    for (const auto& [faceId, group] : mesh.faceGroupByFaceId) {
+        (void)faceId;
+        bytes += stringBytes(group);
+    }
+    return bytes;
+}
+
+std::size_t SceneMeshStore::memoryBytes() const {
+    std::size_t bytes = core::memory::hashBytes(meshes_);
+    for (const auto& [id, mesh] : meshes_) {
+        bytes += core::memory::stringBytes(id) + meshBytes(mesh) - sizeof(Mesh);
+    }
+    return bytes;
+}
+
 } // namespace onecad::render
@@ -56,6 +56,10 @@ public:
     [[nodiscard]] std::size_t size() const { return meshes_.size(); }
     [[nodiscard]] bool empty() const { return meshes_.empty(); }
 
+    // Approximate heap bytes of one mesh (geometry, face ids and topology samples).
+    [[nodiscard]] static std::size_t meshBytes(const Mesh& mesh);
+    [[nodiscard]] std::size_t memoryBytes() const;
+
     template <typename Func>
     void forEachMesh(Func&& func) const {
         for (const auto& [id, mesh] : meshes_) {
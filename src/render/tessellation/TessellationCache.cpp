@@ -1,4 +1,5 @@
 #include "TessellationCache.h"
+#include "../../core/trace/Trace.h"
 
 #include <BRepMesh_IncrementalMesh.hxx>
 #include <BRep_Tool.hxx>
@@ -287,15 +288,10 @@ void TessellationCache::computeSmoothNormals(SceneMeshStore::Mesh& mesh) {
     mesh.normals = std::move(newNormals);
 }
 
-SceneMeshStore::Mesh TessellationCache::buildMesh(const std::string& bodyId,
-                                                  const TopoDS_Shape& shape,
-                                                  kernel::elementmap::ElementMap& elementMap) const {
-    SceneMeshStore::Mesh mesh;
-    mesh.bodyId = bodyId;
-    mesh.modelMatrix.setToIdentity();
-
+bool TessellationCache::triangulate(const TopoDS_Shape& shape) const {
+    ONECAD_TRACE_SCOPE("tessellation", "triangulate");
     if (shape.IsNull()) {
-        return mesh;
+        return false;
     }
 
     // Compute adaptive deflection based on bounding box
@@ -319,7 +315,19 @@ SceneMeshStore::Mesh TessellationCache::buildMesh(const std::string& bodyId,
     BRepMesh_IncrementalMesh mesher(shape, linearDeflection,
                                     settings_.parallel, settings_.angularDeflection, true);
     mesher.Perform();
-    if (!mesher.IsDone()) {
+    return mesher.IsDone();
+}
+
+SceneMeshStore::Mesh TessellationCache::buildMesh(const std::string& bodyId,
+                                                  const TopoDS_Shape& shape,
+                                                  kernel::elementmap::ElementMap& elementMap) const {
+    ONECAD_TRACE_NAMED_SCOPE(trace, "tessellation", "buildMesh");
+    ONECAD_TRACE_ARG(trace, "bodyId", bodyId);
+    SceneMeshStore::Mesh mesh;
+    mesh.bodyId = bodyId;
+    mesh.modelMatrix.setToIdentity();
+
+    if (!triangulate(shape)) {
         return mesh;
     }
 
@@ -32,6 +32,15 @@ public:
                                    const TopoDS_Shape& shape,
                                    kernel::elementmap::ElementMap& elementMap) const;
 
+    /**
+     * @brief Triangulate a shape in place with the settings buildMesh() uses
+     *
+     * Safe to call from worker threads for shapes not yet shared with the
+     * document; a later buildMesh() then reuses the stored triangulation.
+     * @return false if meshing failed
+     */
+    bool triangulate(const TopoDS_Shape& shape) const;
+
 private:
     using VisibleEdgeSet = std::unordered_set<TopoDS_Edge, TopTools_ShapeMapHasher, TopTools_ShapeMapHasher>;
 
@@ -0,0 +1,137 @@
+/**
+ * @file VisibleRowWidgets.cpp
+ */
+#include "VisibleRowWidgets.h"
+
+#include <QAbstractItemModel>
+#include <QEvent>
+#include <QScrollBar>
+#include <QTreeView>
+
+#include <algorithm>
+
+namespace onecad::ui {
+
+VisibleRowWidgets::VisibleRowWidgets(QTreeView* view, Factory factory, Binder bind)
+    : QObject(view),
+      view_(view),
+      factory_(std::move(factory)),
+      bind_(std::move(bind)) {
+    connect(view_->verticalScrollBar(), &QScrollBar::valueChanged,
+            this, &VisibleRowWidgets::scheduleSync);
+    connect(view_, &QTreeView::expanded, this, &VisibleRowWidgets::scheduleSync);
+    connect(view_, &QTreeView::collapsed, this, &VisibleRowWidgets::scheduleSync);
+    view_->viewport()->installEventFilter(this);
+
+    QAbstractItemModel* model = view_->model();
+    if (!model) {
+        return;
+    }
+    connect(model, &QAbstractItemModel::rowsInserted, this, &VisibleRowWidgets::scheduleSync);
+    connect(model, &QAbstractItemModel::rowsRemoved, this, &VisibleRowWidgets::scheduleSync);
+    connect(model, &QAbstractItemModel::rowsMoved, this, &VisibleRowWidgets::scheduleSync);
+    connect(model, &QAbstractItemModel::layoutChanged, this, &VisibleRowWidgets::scheduleSync);
+    connect(model, &QAbstractItemModel::modelReset, this, [this]() {
+        // The view has already released every index widget
+        live_.clear();
+        scheduleSync();
+    });
+    connect(model, &QAbstractItemModel::dataChanged, this,
+            [this](const QModelIndex& topLeft, const QModelIndex& bottomRight) {
+                for (const auto& index : live_) {
+                    if (!index.isValid() || index.parent() != topLeft.parent() ||
+                        index.row() < topLeft.row() || index.row() > bottomRight.row()) {
+                        continue;
+                    }
+                    if (QWidget* widget = view_->indexWidget(index)) {
+                        bind_(widget, index);
+                    }
+                }
+            });
+}
+
+QWidget* VisibleRowWidgets::widgetFor(const QModelIndex& index) const {
+    return index.isValid() ? view_->indexWidget(index) : nullptr;
+}
+
+void VisibleRowWidgets::scheduleSync() {
+    if (syncScheduled_) {
+        return;
+    }
+    syncScheduled_ = true;
+    QMetaObject::invokeMethod(this, &VisibleRowWidgets::syncNow, Qt::QueuedConnection);
+}
+
+void VisibleRowWidgets::syncNow() {
+    syncScheduled_ = false;
+    if (!view_->model()) {
+        return;
+    }
+
+    std::vector<QModelIndex> visible;
+    const int height = view_->viewport()->height();
+    for (QModelIndex index = view_->indexAt(QPoint(0, 0)); index.isValid();
+         index = view_->indexBelow(index)) {
+        if (view_->visualRect(index).top() >= height) {
+            break;
+        }
+        visible.push_back(index);
+    }
+
+    std::vector<QPersistentModelIndex> kept;
+    kept.reserve(visible.size());
+    for (const auto& index : live_) {
+        if (!index.isValid()) {
+            continue;  // Row removed; the view deleted its widget
+        }
+        const bool onScreen = std::any_of(visible.begin(), visible.end(),
+                                          [&](const QModelIndex& v) { return index == v; });
+        if (onScreen) {
+            kept.push_back(index);
+        } else {
+            view_->setIndexWidget(index, nullptr);
+        }
+    }
+
+    for (const auto& index : visible) {
+        if (view_->indexWidget(index)) {
+            continue;
+        }
+        QWidget* widget = factory_(index);
+        if (!widget) {
+            continue;  // Row is painted by the view (e.g. placeholders)
+        }
+        view_->setIndexWidget(index, widget);
+        bind_(widget, index);
+        kept.emplace_back(index);
+    }
+    live_ = std::move(kept);
+}
+
+void VisibleRowWidgets::rebindAll() {
+    for (const auto& index : live_) {
+        if (QWidget* widget = widgetFor(index)) {
+            bind_(widget, index);
+        }
+    }
+}
+
+void VisibleRowWidgets::recreateAll() {
+    for (const auto& index : live_) {
+        if (index.isValid()) {
+            view_->setIndexWidget(index, nullptr);
+        }
+    }
+    live_.clear();
+    scheduleSync();
+}
+
+bool VisibleRowWidgets::eventFilter(QObject* watched, QEvent* event) {
+    if (watched == view_->viewport() &&
+        (event->type() == QEvent::Resize || event->type() == QEvent::Show)) {
+        scheduleSync();
+    }
+    return QObject::eventFilter(watched, event);
+}
+
+} // namespace onecad::ui
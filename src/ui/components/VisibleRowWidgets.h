@@ -0,0 +1,75 @@
+/**
+ * @file VisibleRowWidgets.h
+ * @brief Index widgets for the rows currently on screen of a tree view.
+ */
+#ifndef ONECAD_UI_COMPONENTS_VISIBLEROWWIDGETS_H
+#define ONECAD_UI_COMPONENTS_VISIBLEROWWIDGETS_H
+
+#include <QObject>
+#include <QPersistentModelIndex>
+
+#include <functional>
+#include <vector>
+
+class QModelIndex;
+class QTreeView;
+class QWidget;
+
+namespace onecad::ui {
+
+/**
+ * @brief Keeps QAbstractItemView::setIndexWidget() widgets for visible rows only
+ *
+ * Widgets are created through the factory when a row scrolls into view
+ * (or is inserted/expanded into view) and deleted when it leaves, so the
+ * number of live widgets depends on the viewport height rather than on
+ * the model size. bind() refreshes a widget from its row's data and runs
+ * on creation and whenever the model reports the row changed.
+ *
+ * Updates are coalesced to one pass per event-loop iteration.
+ */
+class VisibleRowWidgets : public QObject {
+    Q_OBJECT
+
+public:
+    using Factory = std::function<QWidget*(const QModelIndex& index)>;
+    using Binder = std::function<void(QWidget* widget, const QModelIndex& index)>;
+
+    VisibleRowWidgets(QTreeView* view, Factory factory, Binder bind);
+
+    /**
+     * @brief Widget of a row if it is currently materialized
+     */
+    QWidget* widgetFor(const QModelIndex& index) const;
+
+    /**
+     * @brief Materialize the rows on screen now (e.g. after scrollTo())
+     */
+    void syncNow();
+
+    /**
+     * @brief Rebind every live widget (selection or theme changes)
+     */
+    void rebindAll();
+
+    /**
+     * @brief Drop all widgets; visible ones are recreated on the next pass
+     */
+    void recreateAll();
+
+    void scheduleSync();
+
+protected:
+    bool eventFilter(QObject* watched, QEvent* event) override;
+
+private:
+    QTreeView* view_;
+    Factory factory_;
+    Binder bind_;
+    std::vector<QPersistentModelIndex> live_;
+    bool syncScheduled_ = false;
+};
+
+} // namespace onecad::ui
+
+#endif // ONECAD_UI_COMPONENTS_VISIBLEROWWIDGETS_H
@@ -37,7 +37,7 @@ constexpr double kMaxDraft = 89.0;
 std::unique_ptr<app::Document> makePreviewDocument(const app::Document& source) {
     auto preview = std::make_unique<app::Document>();
 
-    preview->elementMap().fromString(source.elementMap().toString());
+    preview->mutableElementMap().fromString(source.elementMap().toString());
 
     for (const auto& sketchId : source.getSketchIds()) {
         const auto* sketch = source.getSketch(sketchId);
@@ -275,7 +275,7 @@ void EditParameterDialog::updatePreview() {
         if (!shape || shape->IsNull()) {
             continue;
         }
-        meshes.push_back(tessellator.buildMesh(bodyId, *shape, previewDoc->elementMap()));
+        meshes.push_back(tessellator.buildMesh(bodyId, *shape, previewDoc->mutableElementMap()));
     }
     viewport_->setModelPreviewMeshes(meshes);
     qCDebug(logEditParamsDialog) << "updatePreview:done"
@@ -0,0 +1,529 @@
+/**
+ * @file HistoryModel.cpp
+ * @brief Implementation of the feature history item model.
+ */
+#include "HistoryModel.h"
+#include "../../app/document/Document.h"
+#include "../../app/document/OperationRecord.h"
+#include "../../app/history/DependencyGraph.h"
+#include "../theme/ThemeManager.h"
+
+#include <QColor>
+
+namespace onecad::ui {
+
+HistoryModel::HistoryModel(QObject* parent)
+    : QAbstractItemModel(parent) {
+}
+
+HistoryModel::~HistoryModel() = default;
+
+void HistoryModel::setDocument(const app::Document* doc) {
+    document_ = doc;
+    reset();
+}
+
+void HistoryModel::reset() {
+    beginResetModel();
+    root_.children.clear();
+    opNodes_.clear();
+    sketchNodes_.clear();
+    bodyProducers_.clear();
+
+    auto append = [](Node* parent, std::unique_ptr<Node> node) {
+        node->parent = parent;
+        node->row = static_cast<int>(parent->children.size());
+        Node* raw = node.get();
+        parent->children.push_back(std::move(node));
+        return raw;
+    };
+
+    if (document_ && !document_->operations().empty()) {
+        const auto& ops = document_->operations();
+
+        // Build dependency graph for ordering
+        app::history::DependencyGraph graph;
+        graph.rebuildFromOperations(ops);
+        auto sorted = graph.topologicalSort();
+        if (sorted.empty()) {
+            sorted.reserve(ops.size());
+            for (const auto& op : ops) {
+                sorted.push_back(op.opId);
+            }
+        }
+        std::unordered_map<std::string, const app::OperationRecord*> opById;
+        opById.reserve(ops.size());
+        for (const auto& op : ops) {
+            opById[op.opId] = &op;
+        }
+
+        for (const auto& opId : sorted) {
+            auto opIt = opById.find(opId);
+            if (opIt == opById.end() || opNodes_.count(opId) > 0) {
+                continue;
+            }
+            const app::OperationRecord& op = *opIt->second;
+
+            Node* parent = parentNodeFor(op, false);
+            if (!parent) {
+                const auto& ref = std::get<app::SketchRegionRef>(op.input);
+                auto group = std::make_unique<Node>();
+                group->kind = RowKind::SketchGroup;
+                group->id = ref.sketchId;
+                parent = append(&root_, std::move(group));
+                sketchNodes_[ref.sketchId] = parent;
+            }
+
+            auto node = std::make_unique<Node>();
+            node->id = opId;
+            fillOperation(*node, op);
+            opNodes_[opId] = append(parent, std::move(node));
+            for (const auto& bodyId : op.resultBodyIds) {
+                bodyProducers_[bodyId] = opId;
+            }
+        }
+    } else if (document_) {
+        auto placeholder = std::make_unique<Node>();
+        placeholder->kind = RowKind::Placeholder;
+        append(&root_, std::move(placeholder));
+    }
+    endResetModel();
+}
+
+void HistoryModel::addOperation(const std::string& opId) {
+    if (!document_) {
+        return;
+    }
+    if (opNodes_.count(opId) > 0) {
+        updateOperation(opId);
+        return;
+    }
+    const app::OperationRecord* op = findRecord(opId);
+    if (!op) {
+        return;
+    }
+
+    showPlaceholder(false);
+    Node* parent = parentNodeFor(*op, true);
+
+    auto node = std::make_unique<Node>();
+    node->id = opId;
+    fillOperation(*node, *op);
+    Node* raw = node.get();
+    insertNode(parent, std::move(node));
+    opNodes_[opId] = raw;
+    for (const auto& bodyId : op->resultBodyIds) {
+        bodyProducers_[bodyId] = opId;
+    }
+}
+
+void HistoryModel::removeOperation(const std::string& opId) {
+    auto it = opNodes_.find(opId);
+    if (it == opNodes_.end()) {
+        return;
+    }
+    Node* node = it->second;
+    if (!node->children.empty()) {
+        // Dependents have to be re-parented; lay the tree out again
+        reset();
+        return;
+    }
+
+    Node* parent = node->parent;
+    opNodes_.erase(it);
+    removeNode(node);
+    if (parent->kind == RowKind::SketchGroup && parent->children.empty()) {
+        sketchNodes_.erase(parent->id);
+        removeNode(parent);
+    }
+
+    for (const auto& [bodyId, producerId] : bodyProducers_) {
+        (void)bodyId;
+        if (producerId == opId) {
+            rebuildBodyProducers();
+            break;
+        }
+    }
+    if (opNodes_.empty()) {
+        showPlaceholder(true);
+    }
+}
+
+void HistoryModel::updateOperation(const std::string& opId) {
+    auto it = opNodes_.find(opId);
+    if (it == opNodes_.end()) {
+        addOperation(opId);
+        return;
+    }
+    const app::OperationRecord* op = findRecord(opId);
+    if (!op) {
+        return;
+    }
+    Node* node = it->second;
+    if (node->anchor != anchorFor(*op)) {
+        // Input changed: the row belongs somewhere else
+        reset();
+        return;
+    }
+    fillOperation(*node, *op);
+    for (const auto& bodyId : op->resultBodyIds) {
+        bodyProducers_.try_emplace(bodyId, opId);
+    }
+    const QModelIndex index = indexForNode(node);
+    emit dataChanged(index, index);
+}
+
+void HistoryModel::setOperationFailed(const std::string& opId, bool failed, const QString& reason) {
+    auto it = opNodes_.find(opId);
+    if (it == opNodes_.end()) {
+        return;
+    }
+    Node* node = it->second;
+    if (node->failed == failed && node->failureReason == reason) {
+        return;
+    }
+    node->failed = failed;
+    node->failureReason = reason;
+    const QModelIndex index = indexForNode(node);
+    emit dataChanged(index, index, {FailedRole, FailureReasonRole});
+}
+
+void HistoryModel::setOperationSuppressed(const std::string& opId, bool suppressed) {
+    auto it = opNodes_.find(opId);
+    if (it == opNodes_.end() || it->second->suppressed == suppressed) {
+        return;
+    }
+    it->second->suppressed = suppressed;
+    const QModelIndex index = indexForNode(it->second);
+    emit dataChanged(index, index, {SuppressedRole});
+}
+
+QModelIndex HistoryModel::indexForOperation(const std::string& opId) const {
+    auto it = opNodes_.find(opId);
+    return it != opNodes_.end() ? indexForNode(it->second) : QModelIndex();
+}
+
+HistoryModel::RowKind HistoryModel::rowKind(const QModelIndex& index) const {
+    const Node* node = nodeFor(index);
+    return node ? node->kind : RowKind::Placeholder;
+}
+
+std::string HistoryModel::operationId(const QModelIndex& index) const {
+    const Node* node = nodeFor(index);
+    return node && node->kind == RowKind::Operation ? node->id : std::string();
+}
+
+QString HistoryModel::operationName(app::OperationType type) {
+    switch (type) {
+        case app::OperationType::Extrude: return "Extrude";
+        case app::OperationType::Revolve: return "Revolve";
+        case app::OperationType::Fillet: return "Fillet";
+        case app::OperationType::Chamfer: return "Chamfer";
+        case app::OperationType::Shell: return "Shell";
+        case app::OperationType::Boolean: return "Boolean";
+        default: return "Operation";
+    }
+}
+
+QString HistoryModel::operationDetails(const app::OperationRecord& op) {
+    QString params;
+
+    switch (op.type) {
+        case app::OperationType::Extrude:
+            if (std::holds_alternative<app::ExtrudeParams>(op.params)) {
+                const auto& p = std::get<app::ExtrudeParams>(op.params);
+                params = QString("%1mm").arg(p.distance, 0, 'f', 1);
+            }
+            break;
+        case app::OperationType::Revolve:
+            if (std::holds_alternative<app::RevolveParams>(op.params)) {
+                const auto& p = std::get<app::RevolveParams>(op.params);
+                params = QString("%1°").arg(p.angleDeg, 0, 'f', 0);
+            }
+            break;
+        case app::OperationType::Fillet:
+            if (std::holds_alternative<app::FilletChamferParams>(op.params)) {
+                const auto& p = std::get<app::FilletChamferParams>(op.params);
+                params = QString("R%1").arg(p.radius, 0, 'f', 1);
+            }
+            break;
+        case app::OperationType::Chamfer:
+            if (std::holds_alternative<app::FilletChamferParams>(op.params)) {
+                const auto& p = std::get<app::FilletChamferParams>(op.params);
+                params = QString("%1mm").arg(p.radius, 0, 'f', 1);
+            }
+            break;
+        case app::OperationType::Shell:
+            if (std::holds_alternative<app::ShellParams>(op.params)) {
+                const auto& p = std::get<app::ShellParams>(op.params);
+                params = QString("%1mm").arg(p.thickness, 0, 'f', 1);
+            }
+            break;
+        case app::OperationType::Boolean:
+            if (std::holds_alternative<app::BooleanParams>(op.params)) {
+                const auto& p = std::get<app::BooleanParams>(op.params);
+                switch (p.operation) {
+                    case app::BooleanParams::Op::Union: params = "Union"; break;
+                    case app::BooleanParams::Op::Cut: params = "Cut"; break;
+                    case app::BooleanParams::Op::Intersect: params = "Intersect"; break;
+                }
+            }
+            break;
+    }
+
+    return params;
+}
+
+QString HistoryModel::operationIconPath(app::OperationType type) {
+    switch (type) {
+        case app::OperationType::Extrude: return ":/icons/ic_extrude.svg";
+        case app::OperationType::Revolve: return ":/icons/ic_revolve.svg";
+        case app::OperationType::Fillet: return ":/icons/ic_fillet.svg";
+        case app::OperationType::Chamfer: return ":/icons/ic_chamfer.svg";
+        case app::OperationType::Shell: return ":/icons/ic_shell.svg";
+        case app::OperationType::Boolean: return ":/icons/ic_boolean_union.svg"; // Default generic boolean
+        default: return ":/icons/ic_settings.svg";
+    }
+}
+
+QModelIndex HistoryModel::index(int row, int column, const QModelIndex& parent) const {
+    const Node* parentNode = parent.isValid() ? nodeFor(parent) : &root_;
+    if (!parentNode || column != 0 || row < 0 ||
+        row >= static_cast<int>(parentNode->children.size())) {
+        return {};
+    }
+    return createIndex(row, 0, parentNode->children[row].get());
+}
+
+QModelIndex HistoryModel::parent(const QModelIndex& child) const {
+    const Node* node = nodeFor(child);
+    if (!node || !node->parent || node->parent == &root_) {
+        return {};
+    }
+    return indexForNode(node->parent);
+}
+
+int HistoryModel::rowCount(const QModelIndex& parent) const {
+    if (parent.column() > 0) {
+        return 0;
+    }
+    const Node* node = parent.isValid() ? nodeFor(parent) : &root_;
+    return node ? static_cast<int>(node->children.size()) : 0;
+}
+
+int HistoryModel::columnCount(const QModelIndex&) const {
+    return 1;
+}
+
+QVariant HistoryModel::data(const QModelIndex& index, int role) const {
+    const Node* node = nodeFor(index);
+    if (!node) {
+        return {};
+    }
+    if (role == KindRole) {
+        return static_cast<int>(node->kind);
+    }
+
+    switch (node->kind) {
+        case RowKind::Placeholder:
+            if (role == Qt::DisplayRole) {
+                return tr("No operations");
+            }
+            if (role == Qt::ForegroundRole) {
+                return ThemeManager::instance().currentTheme().navigator.placeholderText;
+            }
+            return {};
+        case RowKind::SketchGroup:
+            if (role == Qt::DisplayRole) {
+                return document_ ? QString::fromStdString(document_->getSketchName(node->id)) : QString();
+            }
+            if (role == IdRole) {
+                return QString::fromStdString(node->id);
+            }
+            return {};
+        case RowKind::Operation:
+            break;
+    }
+
+    switch (role) {
+        case Qt::DisplayRole: return node->name;
+        case IdRole: return QString::fromStdString(node->id);
+        case DetailsRole: return node->details;
+        case IconPathRole: return node->iconPath;
+        case TypeRole: return node->type;
+        case FailedRole: return node->failed;
+        case FailureReasonRole: return node->failureReason;
+        case SuppressedRole: return node->suppressed;
+        default: return {};
+    }
+}
+
+Qt::ItemFlags HistoryModel::flags(const QModelIndex& index) const {
+    const Node* node = nodeFor(index);
+    if (!node || node->kind == RowKind::Placeholder) {
+        return Qt::NoItemFlags;
+    }
+    if (node->kind == RowKind::SketchGroup) {
+        return Qt::ItemIsEnabled;
+    }
+    return Qt::ItemIsEnabled | Qt::ItemIsSelectable;
+}
+
+const app::OperationRecord* HistoryModel::findRecord(const std::string& opId) const {
+    if (!document_) {
+        return nullptr;
+    }
+    for (const auto& op : document_->operations()) {
+        if (op.opId == opId) {
+            return &op;
+        }
+    }
+    return nullptr;
+}
+
+HistoryModel::Node* HistoryModel::producerNode(const std::string& bodyId,
+                                               const std::string& excludeOpId) const {
+    auto producerIt = bodyProducers_.find(bodyId);
+    if (producerIt == bodyProducers_.end() || producerIt->second == excludeOpId) {
+        return nullptr;
+    }
+    auto nodeIt = opNodes_.find(producerIt->second);
+    return nodeIt != opNodes_.end() ? nodeIt->second : nullptr;
+}
+
+HistoryModel::Node* HistoryModel::parentNodeFor(const app::OperationRecord& op, bool createGroup) {
+    Node* parent = &root_;
+    if (std::holds_alternative<app::SketchRegionRef>(op.input)) {
+        const auto& ref = std::get<app::SketchRegionRef>(op.input);
+        auto groupIt = sketchNodes_.find(ref.sketchId);
+        if (groupIt != sketchNodes_.end()) {
+            parent = groupIt->second;
+        } else if (createGroup) {
+            auto group = std::make_unique<Node>();
+            group->kind = RowKind::SketchGroup;
+            group->id = ref.sketchId;
+            Node* raw = group.get();
+            insertNode(&root_, std::move(group));
+            sketchNodes_[ref.sketchId] = raw;
+            parent = raw;
+        } else {
+            parent = nullptr;  // Caller creates the group
+        }
+    } else if (std::holds_alternative<app::FaceRef>(op.input)) {
+        if (Node* producer = producerNode(std::get<app::FaceRef>(op.input).bodyId, op.opId)) {
+            parent = producer;
+        }
+    } else if (std::holds_alternative<app::BodyRef>(op.input)) {
+        if (Node* producer = producerNode(std::get<app::BodyRef>(op.input).bodyId, op.opId)) {
+            parent = producer;
+        }
+    }
+
+    if (op.type == app::OperationType::Boolean &&
+        std::holds_alternative<app::BooleanParams>(op.params)) {
+        const auto& params = std::get<app::BooleanParams>(op.params);
+        if (Node* producer = producerNode(params.targetBodyId, op.opId)) {
+            parent = producer;
+        }
+    }
+    return parent;
+}
+
+std::string HistoryModel::anchorFor(const app::OperationRecord& op) {
+    std::string anchor;
+    if (std::holds_alternative<app::SketchRegionRef>(op.input)) {
+        anchor = "sketch:" + std::get<app::SketchRegionRef>(op.input).sketchId;
+    } else if (std::holds_alternative<app::FaceRef>(op.input)) {
+        anchor = "body:" + std::get<app::FaceRef>(op.input).bodyId;
+    } else if (std::holds_alternative<app::BodyRef>(op.input)) {
+        anchor = "body:" + std::get<app::BodyRef>(op.input).bodyId;
+    }
+    if (op.type == app::OperationType::Boolean &&
+        std::holds_alternative<app::BooleanParams>(op.params)) {
+        anchor += "|target:" + std::get<app::BooleanParams>(op.params).targetBodyId;
+    }
+    return anchor;
+}
+
+void HistoryModel::fillOperation(Node& node, const app::OperationRecord& op) const {
+    node.kind = RowKind::Operation;
+    node.anchor = anchorFor(op);
+    node.type = static_cast<int>(op.type);
+    node.name = operationName(op.type);
+    node.details = operationDetails(op);
+    node.iconPath = operationIconPath(op.type);
+    if (document_) {
+        node.failed = document_->isOperationFailed(op.opId);
+        node.suppressed = document_->isOperationSuppressed(op.opId);
+        node.failureReason = node.failed
+            ? QString::fromStdString(document_->operationFailureReason(op.opId))
+            : QString();
+    }
+}
+
+HistoryModel::Node* HistoryModel::nodeFor(const QModelIndex& index) const {
+    if (!index.isValid() || index.model() != this) {
+        return nullptr;
+    }
+    return static_cast<Node*>(index.internalPointer());
+}
+
+QModelIndex HistoryModel::indexForNode(const Node* node) const {
+    if (!node || node == &root_) {
+        return {};
+    }
+    return createIndex(node->row, 0, const_cast<Node*>(node));
+}
+
+void HistoryModel::insertNode(Node* parent, std::unique_ptr<Node> node) {
+    const int row = static_cast<int>(parent->children.size());
+    beginInsertRows(indexForNode(parent), row, row);
+    node->parent = parent;
+    node->row = row;
+    parent->children.push_back(std::move(node));
+    endInsertRows();
+}
+
+void HistoryModel::removeNode(Node* node) {
+    Node* parent = node->parent;
+    const int row = node->row;
+    beginRemoveRows(indexForNode(parent), row, row);
+    parent->children.erase(parent->children.begin() + row);
+    renumber(parent, row);
+    endRemoveRows();
+}
+
+void HistoryModel::renumber(Node* parent, int from) {
+    for (int i = from; i < static_cast<int>(parent->children.size()); ++i) {
+        parent->children[i]->row = i;
+    }
+}
+
+void HistoryModel::rebuildBodyProducers() {
+    bodyProducers_.clear();
+    if (!document_) {
+        return;
+    }
+    for (const auto& op : document_->operations()) {
+        if (opNodes_.count(op.opId) == 0) {
+            continue;
+        }
+        for (const auto& bodyId : op.resultBodyIds) {
+            bodyProducers_[bodyId] = op.opId;
+        }
+    }
+}
+
+void HistoryModel::showPlaceholder(bool show) {
+    const bool shown = !root_.children.empty() &&
+                       root_.children.front()->kind == RowKind::Placeholder;
+    if (show && !shown && root_.children.empty()) {
+        auto placeholder = std::make_unique<Node>();
+        placeholder->kind = RowKind::Placeholder;
+        insertNode(&root_, std::move(placeholder));
+    } else if (!show && shown) {
+        removeNode(root_.children.front().get());
+    }
+}
+
+} // namespace onecad::ui
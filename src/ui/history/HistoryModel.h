@@ -0,0 +1,125 @@
+/**
+ * @file HistoryModel.h
+ * @brief Item model of the feature history tree.
+ */
+#ifndef ONECAD_UI_HISTORY_HISTORYMODEL_H
+#define ONECAD_UI_HISTORY_HISTORYMODEL_H
+
+#include <QAbstractItemModel>
+#include <QString>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace onecad {
+namespace app {
+class Document;
+struct OperationRecord;
+enum class OperationType;
+}
+
+namespace ui {
+
+/**
+ * @brief Feature history as a tree of sketch groups and operations.
+ *
+ * Operations built from a sketch region are grouped under that sketch;
+ * operations on a face or body (and booleans on a target body) are nested
+ * under the operation that produced the body. The initial layout follows
+ * the dependency order; later edits are applied row by row, so adding,
+ * removing or updating an operation costs O(siblings) instead of a
+ * rebuild of the whole tree.
+ */
+class HistoryModel : public QAbstractItemModel {
+    Q_OBJECT
+
+public:
+    enum class RowKind { SketchGroup, Operation, Placeholder };
+
+    enum Role {
+        IdRole = Qt::UserRole + 1,  ///< Operation or sketch id (QString)
+        KindRole,                   ///< RowKind as int
+        DetailsRole,                ///< Parameter summary, e.g. "10.0mm"
+        IconPathRole,
+        TypeRole,                   ///< app::OperationType as int
+        FailedRole,
+        FailureReasonRole,
+        SuppressedRole
+    };
+
+    explicit HistoryModel(QObject* parent = nullptr);
+    ~HistoryModel() override;
+
+    void setDocument(const app::Document* doc);
+
+    /**
+     * @brief Rebuild every row from the document in dependency order
+     */
+    void reset();
+
+    void addOperation(const std::string& opId);
+    void removeOperation(const std::string& opId);
+    void updateOperation(const std::string& opId);
+    void setOperationFailed(const std::string& opId, bool failed, const QString& reason);
+    void setOperationSuppressed(const std::string& opId, bool suppressed);
+
+    QModelIndex indexForOperation(const std::string& opId) const;
+    RowKind rowKind(const QModelIndex& index) const;
+    std::string operationId(const QModelIndex& index) const;
+    size_t operationCount() const { return opNodes_.size(); }
+
+    static QString operationName(app::OperationType type);
+    static QString operationDetails(const app::OperationRecord& op);
+    static QString operationIconPath(app::OperationType type);
+
+    QModelIndex index(int row, int column, const QModelIndex& parent = {}) const override;
+    QModelIndex parent(const QModelIndex& child) const override;
+    int rowCount(const QModelIndex& parent = {}) const override;
+    int columnCount(const QModelIndex& parent = {}) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    Qt::ItemFlags flags(const QModelIndex& index) const override;
+
+private:
+    struct Node {
+        RowKind kind = RowKind::Operation;
+        std::string id;
+        Node* parent = nullptr;
+        int row = 0;  ///< Position in parent->children, kept current on edits
+        std::vector<std::unique_ptr<Node>> children;
+        std::string anchor;  ///< Inputs that decide the parent row
+
+        // Operation rows
+        int type = 0;
+        QString name;
+        QString details;
+        QString iconPath;
+        bool failed = false;
+        bool suppressed = false;
+        QString failureReason;
+    };
+
+    const app::OperationRecord* findRecord(const std::string& opId) const;
+    Node* producerNode(const std::string& bodyId, const std::string& excludeOpId) const;
+    Node* parentNodeFor(const app::OperationRecord& op, bool createGroup);
+    static std::string anchorFor(const app::OperationRecord& op);
+    void fillOperation(Node& node, const app::OperationRecord& op) const;
+    Node* nodeFor(const QModelIndex& index) const;
+    QModelIndex indexForNode(const Node* node) const;
+    void insertNode(Node* parent, std::unique_ptr<Node> node);
+    void removeNode(Node* node);
+    void renumber(Node* parent, int from);
+    void rebuildBodyProducers();
+    void showPlaceholder(bool show);
+
+    const app::Document* document_ = nullptr;
+    Node root_;
+    std::unordered_map<std::string, Node*> opNodes_;
+    std::unordered_map<std::string, Node*> sketchNodes_;
+    std::unordered_map<std::string, std::string> bodyProducers_;  // body id -> op id
+};
+
+} // namespace ui
+} // namespace onecad
+
+#endif // ONECAD_UI_HISTORY_HISTORYMODEL_H
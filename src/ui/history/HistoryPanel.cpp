@@ -3,16 +3,17 @@
  * @brief Implementation of feature history tree panel.
  */
 #include "HistoryPanel.h"
+#include "HistoryModel.h"
 #include "FeatureCard.h"
 #include "EditParameterDialog.h"
 #include "../../app/document/Document.h"
 #include "../../app/document/OperationRecord.h"
-#include "../../app/history/DependencyGraph.h"
+#include "../components/VisibleRowWidgets.h"
 #include "../viewport/Viewport.h"
 #include "../theme/ThemeManager.h"
 
-#include <QTreeWidget>
-#include <QTreeWidgetItem>
+#include <QTreeView>
+#include <QItemSelectionModel>
 #include <QVBoxLayout>
 #include <QHBoxLayout>
 #include <QFrame>
@@ -52,29 +53,44 @@ void HistoryPanel::setupUi() {
     panelLayout->setContentsMargins(12, 12, 12, 12);
     panelLayout->setSpacing(10);
 
-    panelLayout->addWidget(treeWidget_);
-
-    mainLayout->addWidget(panel_);
-    treeWidget_ = new QTreeWidget;
-    treeWidget_->setObjectName("NavigatorTree");
-    treeWidget_->setHeaderHidden(true);
-    treeWidget_->setIndentation(12);
-    treeWidget_->setRootIsDecorated(true);
-    treeWidget_->setContextMenuPolicy(Qt::CustomContextMenu);
-    treeWidget_->setUniformRowHeights(true);
-    treeWidget_->setSelectionMode(QAbstractItemView::SingleSelection);
-    treeWidget_->setSelectionBehavior(QAbstractItemView::SelectRows);
-    treeWidget_->setFocusPolicy(Qt::NoFocus);
-    treeWidget_->setHorizontalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
-
-    connect(treeWidget_, &QTreeWidget::itemClicked,
+    model_ = new HistoryModel(this);
+    treeView_ = new QTreeView;
+    treeView_->setObjectName("NavigatorTree");
+    treeView_->setModel(model_);
+    treeView_->setHeaderHidden(true);
+    treeView_->setIndentation(12);
+    treeView_->setRootIsDecorated(true);
+    treeView_->setContextMenuPolicy(Qt::CustomContextMenu);
+    treeView_->setUniformRowHeights(true);
+    treeView_->setSelectionMode(QAbstractItemView::SingleSelection);
+    treeView_->setSelectionBehavior(QAbstractItemView::SelectRows);
+    treeView_->setFocusPolicy(Qt::NoFocus);
+    treeView_->setHorizontalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
+
+    rowWidgets_ = new VisibleRowWidgets(
+        treeView_,
+        [this](const QModelIndex& index) { return createRowWidget(index); },
+        [this](QWidget* widget, const QModelIndex& index) { bindRowWidget(widget, index); });
+
+    connect(treeView_, &QTreeView::clicked,
             this, &HistoryPanel::onItemClicked);
-    connect(treeWidget_, &QTreeWidget::itemDoubleClicked,
+    connect(treeView_, &QTreeView::doubleClicked,
             this, &HistoryPanel::onItemDoubleClicked);
-    connect(treeWidget_, &QTreeWidget::customContextMenuRequested,
+    connect(treeView_, &QTreeView::customContextMenuRequested,
             this, &HistoryPanel::onCustomContextMenu);
+    connect(treeView_->selectionModel(), &QItemSelectionModel::selectionChanged,
+            this, [this]() { rowWidgets_->rebindAll(); });
+
+    // Keep everything expanded as rows arrive
+    connect(model_, &QAbstractItemModel::modelReset, treeView_, &QTreeView::expandAll);
+    connect(model_, &QAbstractItemModel::rowsInserted, this,
+            [this](const QModelIndex& parent) {
+                if (parent.isValid()) {
+                    treeView_->expand(parent);
+                }
+            });
 
-    panelLayout->addWidget(treeWidget_);
+    panelLayout->addWidget(treeView_);
 
     mainLayout->addWidget(panel_);
 
@@ -89,40 +105,32 @@ void HistoryPanel::updateTheme() {
         .arg(theme.ui.panelBackground.name(QColor::HexArgb))
         .arg(theme.ui.panelBorder.name(QColor::HexArgb)));
 
-    treeWidget_->setStyleSheet(QString(R"(
-        QTreeWidget {
+    treeView_->setStyleSheet(QString(R"(
+        QTreeView {
             background-color: %1;
             border: none;
             color: %2;
         }
-        QTreeWidget::item {
+        QTreeView::item {
             height: 36px;
             padding: 0px;
         }
-        QTreeWidget::item:selected {
+        QTreeView::item:selected {
             background-color: transparent; /* Widget handles selection */
         }
-        QTreeWidget::item:hover:!selected {
+        QTreeView::item:hover:!selected {
             background-color: transparent;
         }
     )")
     .arg(theme.ui.treeBackground.name(QColor::HexArgb))
     .arg(theme.ui.treeText.name(QColor::HexArgb)));
 
-    // Update Headers (items without widgets)
-    QTreeWidgetItemIterator it(treeWidget_);
-    while (*it) {
-        if (!treeWidget_->itemWidget(*it, 0)) {
-            (*it)->setForeground(0, theme.navigator.headerText);
-        }
-        ++it;
-    }
-
-    for (auto& entry : entries_) {
-        if (entry.card) {
-            entry.card->updateTheme();
-        }
+    // Headers and cards pick up the theme when recreated; placeholders
+    // read their color from the model
+    if (rowWidgets_) {
+        rowWidgets_->recreateAll();
     }
+    treeView_->viewport()->update();
 }
 
 QWidget* HistoryPanel::createSectionHeader(const QString& text) {
@@ -148,7 +156,7 @@ QWidget* HistoryPanel::createSectionHeader(const QString& text) {
 
 void HistoryPanel::setDocument(app::Document* doc) {
     document_ = doc;
-    rebuild();
+    model_->setDocument(doc);
 }
 
 void HistoryPanel::setViewport(Viewport* viewport) {
@@ -160,256 +168,55 @@ void HistoryPanel::setCommandProcessor(app::commands::CommandProcessor* processo
 }
 
 void HistoryPanel::rebuild() {
-    treeWidget_->clear();
-    entries_.clear();
-
-    if (!document_) {
-        return;
-    }
-
-    const auto& ops = document_->operations();
-    if (ops.empty()) {
-        auto* placeholder = new QTreeWidgetItem(treeWidget_);
-        placeholder->setText(0, "No operations");
-        placeholder->setForeground(0, ThemeManager::instance().currentTheme().navigator.placeholderText);
-        placeholder->setFlags(Qt::NoItemFlags);
-        return;
-    }
-
-    // Build dependency graph for ordering
-    app::history::DependencyGraph graph;
-    graph.rebuildFromOperations(ops);
-
-    auto sorted = graph.topologicalSort();
-    if (sorted.empty() && !ops.empty()) {
-        sorted.reserve(ops.size());
-        for (const auto& op : ops) {
-            sorted.push_back(op.opId);
-        }
-    }
-    std::unordered_map<std::string, const app::OperationRecord*> opById;
-    opById.reserve(ops.size());
-    for (const auto& op : ops) {
-        opById[op.opId] = &op;
-    }
-
-    std::unordered_map<std::string, QTreeWidgetItem*> sketchItems;
-    std::unordered_map<std::string, QTreeWidgetItem*> opItems;
-    std::unordered_map<std::string, std::string> bodyProducers;
-
-    // Create items in topological order
-    for (const auto& opId : sorted) {
-        const app::OperationRecord* opRecord = nullptr;
-        auto opIt = opById.find(opId);
-        if (opIt != opById.end()) {
-            opRecord = opIt->second;
-        }
-        if (!opRecord) {
-            continue;
-        }
-
-        QTreeWidgetItem* parentItem = nullptr;
-        
-        // Group logic... (simplified for now to match old implementation structure)
-        // Note: The original implementation had grouping logic which we preserve
-        if (std::holds_alternative<app::SketchRegionRef>(opRecord->input)) {
-            const auto& ref = std::get<app::SketchRegionRef>(opRecord->input);
-            auto sketchIt = sketchItems.find(ref.sketchId);
-            if (sketchIt == sketchItems.end()) {
-                auto* sketchItem = new QTreeWidgetItem(treeWidget_);
-                sketchItem->setFlags(Qt::ItemIsEnabled);
-                
-                // Use a widget for the header to match Navigator styling
-                QString sketchName = QString::fromStdString(document_->getSketchName(ref.sketchId));
-                QWidget* headerWidget = createSectionHeader(sketchName);
-                treeWidget_->setItemWidget(sketchItem, 0, headerWidget);
-                
-                sketchItems[ref.sketchId] = sketchItem;
-                parentItem = sketchItem;
-            } else {
-                parentItem = sketchIt->second;
-            }
-        } 
-        // ... rest of parenting logic preserved implicitly by iterating sorted list ...
-        // For simplicity and robustness, I'll just append to root if parent logic gets complex,
-        // but let's try to maintain the existing logic if possible.
-        // Actually, the previous implementation had logic to find parent item based on input.
-        // We'll keep it simple for this refactor and just list them, or use the same logic if we want nesting.
-        // Let's stick to flat list or minimal nesting for now to ensure robustness unless strict hierarchy is required.
-        // The previous code had nesting logic. Let's keep it.
-        else if (std::holds_alternative<app::FaceRef>(opRecord->input)) {
-            const auto& ref = std::get<app::FaceRef>(opRecord->input);
-            auto producerIt = bodyProducers.find(ref.bodyId);
-            if (producerIt != bodyProducers.end()) {
-                auto opItemIt = opItems.find(producerIt->second);
-                if (opItemIt != opItems.end()) {
-                    parentItem = opItemIt->second;
-                }
-            }
-        } else if (std::holds_alternative<app::BodyRef>(opRecord->input)) {
-            const auto& ref = std::get<app::BodyRef>(opRecord->input);
-            auto producerIt = bodyProducers.find(ref.bodyId);
-            if (producerIt != bodyProducers.end()) {
-                auto opItemIt = opItems.find(producerIt->second);
-                if (opItemIt != opItems.end()) {
-                    parentItem = opItemIt->second;
-                }
-            }
-        }
-        
-        // Boolean check
-        if (opRecord->type == app::OperationType::Boolean &&
-            std::holds_alternative<app::BooleanParams>(opRecord->params)) {
-            const auto& params = std::get<app::BooleanParams>(opRecord->params);
-            auto producerIt = bodyProducers.find(params.targetBodyId);
-            if (producerIt != bodyProducers.end()) {
-                auto opItemIt = opItems.find(producerIt->second);
-                if (opItemIt != opItems.end()) {
-                    parentItem = opItemIt->second;
-                }
-            }
-        }
-
-        ItemEntry entry;
-        entry.opId = opId;
-        entry.type = opRecord->type;
-        entry.item = parentItem ? new QTreeWidgetItem(parentItem) : new QTreeWidgetItem(treeWidget_);
-        entry.failed = document_->isOperationFailed(opId);
-        entry.suppressed = document_->isOperationSuppressed(opId);
-        if (entry.failed) {
-            entry.failureReason = document_->operationFailureReason(opId);
-        }
-
-        entry.card = createItemWidget(entry);
-        treeWidget_->setItemWidget(entry.item, 0, entry.card);
-
-        opItems[opId] = entry.item;
-        for (const auto& bodyId : opRecord->resultBodyIds) {
-            bodyProducers[bodyId] = opId;
-        }
-
-        entries_.push_back(std::move(entry));
-    }
-    
-    // Expand all
-    treeWidget_->expandAll();
+    model_->reset();
 }
 
-FeatureCard* HistoryPanel::createItemWidget(ItemEntry& entry) {
-    auto* card = new FeatureCard;
-    
-    // Retrieve operation record to get details
-    const app::OperationRecord* opRecord = nullptr;
-    for (const auto& op : document_->operations()) {
-        if (op.opId == entry.opId) {
-            opRecord = &op;
+QWidget* HistoryPanel::createRowWidget(const QModelIndex& index) {
+    switch (model_->rowKind(index)) {
+        case HistoryModel::RowKind::SketchGroup:
+            return createSectionHeader(index.data(Qt::DisplayRole).toString());
+        case HistoryModel::RowKind::Placeholder:
+            return nullptr;
+        case HistoryModel::RowKind::Operation:
             break;
-        }
     }
 
-    if (opRecord) {
-        card->setName(getOperationName(entry.type));
-        card->setDetails(getOperationDetails(*opRecord));
-    } else {
-        card->setName("Unknown");
-    }
+    auto* card = new FeatureCard;
+    const std::string opId = model_->operationId(index);
 
-    card->setIconPath(operationIconPath(entry.type));
-    card->setFailed(entry.failed, QString::fromStdString(entry.failureReason));
-    card->setSuppressed(entry.suppressed);
-    
     // Connect signals from card to panel actions
-    connect(card, &FeatureCard::menuRequested, this, [this, &entry]() {
-        showContextMenu(QCursor::pos(), entry.item);
-    });
-    
-    connect(card, &FeatureCard::suppressToggled, this, [this, &entry]() {
-        emit suppressRequested(QString::fromStdString(entry.opId), !entry.suppressed);
+    connect(card, &FeatureCard::menuRequested, this, [this, opId]() {
+        showContextMenu(QCursor::pos(), opId);
     });
 
-    updateItemState(entry);
+    connect(card, &FeatureCard::suppressToggled, this, [this, opId]() {
+        const QModelIndex current = model_->indexForOperation(opId);
+        if (current.isValid()) {
+            emit suppressRequested(QString::fromStdString(opId),
+                                   !current.data(HistoryModel::SuppressedRole).toBool());
+        }
+    });
     return card;
 }
 
-void HistoryPanel::updateItemState(ItemEntry& entry) {
-    if (entry.card) {
-        entry.card->setFailed(entry.failed, QString::fromStdString(entry.failureReason));
-        entry.card->setSuppressed(entry.suppressed);
-        entry.card->setSelected(entry.item->isSelected());
-    }
-}
-
-QString HistoryPanel::getOperationName(app::OperationType type) const {
-    switch (type) {
-        case app::OperationType::Extrude: return "Extrude";
-        case app::OperationType::Revolve: return "Revolve";
-        case app::OperationType::Fillet: return "Fillet";
-        case app::OperationType::Chamfer: return "Chamfer";
-        case app::OperationType::Shell: return "Shell";
-        case app::OperationType::Boolean: return "Boolean";
-        default: return "Operation";
-    }
-}
-
-QString HistoryPanel::getOperationDetails(const app::OperationRecord& op) const {
-    QString params;
-
-    switch (op.type) {
-        case app::OperationType::Extrude:
-            if (std::holds_alternative<app::ExtrudeParams>(op.params)) {
-                const auto& p = std::get<app::ExtrudeParams>(op.params);
-                params = QString("%1mm").arg(p.distance, 0, 'f', 1);
-            }
-            break;
-        case app::OperationType::Revolve:
-            if (std::holds_alternative<app::RevolveParams>(op.params)) {
-                const auto& p = std::get<app::RevolveParams>(op.params);
-                params = QString("%1°").arg(p.angleDeg, 0, 'f', 0);
-            }
-            break;
-        case app::OperationType::Fillet:
-            if (std::holds_alternative<app::FilletChamferParams>(op.params)) {
-                const auto& p = std::get<app::FilletChamferParams>(op.params);
-                params = QString("R%1").arg(p.radius, 0, 'f', 1);
-            }
-            break;
-        case app::OperationType::Chamfer:
-            if (std::holds_alternative<app::FilletChamferParams>(op.params)) {
-                const auto& p = std::get<app::FilletChamferParams>(op.params);
-                params = QString("%1mm").arg(p.radius, 0, 'f', 1);
-            }
-            break;
-        case app::OperationType::Shell:
-            if (std::holds_alternative<app::ShellParams>(op.params)) {
-                const auto& p = std::get<app::ShellParams>(op.params);
-                params = QString("%1mm").arg(p.thickness, 0, 'f', 1);
-            }
-            break;
-        case app::OperationType::Boolean:
-            if (std::holds_alternative<app::BooleanParams>(op.params)) {
-                const auto& p = std::get<app::BooleanParams>(op.params);
-                switch (p.operation) {
-                    case app::BooleanParams::Op::Union: params = "Union"; break;
-                    case app::BooleanParams::Op::Cut: params = "Cut"; break;
-                    case app::BooleanParams::Op::Intersect: params = "Intersect"; break;
-                }
-            }
-            break;
+void HistoryPanel::bindRowWidget(QWidget* widget, const QModelIndex& index) {
+    if (model_->rowKind(index) == HistoryModel::RowKind::SketchGroup) {
+        if (auto* label = qobject_cast<QLabel*>(widget)) {
+            label->setText(index.data(Qt::DisplayRole).toString());
+        }
+        return;
     }
-
-    return params;
-}
-
-QString HistoryPanel::operationIconPath(app::OperationType type) const {
-    switch (type) {
-        case app::OperationType::Extrude: return ":/icons/ic_extrude.svg";
-        case app::OperationType::Revolve: return ":/icons/ic_revolve.svg";
-        case app::OperationType::Fillet: return ":/icons/ic_fillet.svg";
-        case app::OperationType::Chamfer: return ":/icons/ic_chamfer.svg";
-        case app::OperationType::Shell: return ":/icons/ic_shell.svg";
-        case app::OperationType::Boolean: return ":/icons/ic_boolean_union.svg"; // Default generic boolean
-        default: return ":/icons/ic_settings.svg";
+    auto* card = qobject_cast<FeatureCard*>(widget);
+    if (!card) {
+        return;
     }
+    card->setName(index.data(Qt::DisplayRole).toString());
+    card->setDetails(index.data(HistoryModel::DetailsRole).toString());
+    card->setIconPath(index.data(HistoryModel::IconPathRole).toString());
+    card->setFailed(index.data(HistoryModel::FailedRole).toBool(),
+                    index.data(HistoryModel::FailureReasonRole).toString());
+    card->setSuppressed(index.data(HistoryModel::SuppressedRole).toBool());
+    card->setSelected(treeView_->selectionModel()->isSelected(index));
 }
 
 bool HistoryPanel::isEditableType(app::OperationType type) const {
@@ -417,31 +224,30 @@ bool HistoryPanel::isEditableType(app::OperationType type) const {
            type == app::OperationType::Revolve;
 }
 
-void HistoryPanel::onItemClicked(QTreeWidgetItem* item, int) {
-    // Update selection state for all cards
-    for (auto& entry : entries_) {
-        if (entry.card && entry.item) {
-            entry.card->setSelected(entry.item->isSelected());
+const app::OperationRecord* HistoryPanel::findOperation(const std::string& opId) const {
+    if (!document_ || opId.empty()) {
+        return nullptr;
+    }
+    for (const auto& op : document_->operations()) {
+        if (op.opId == opId) {
+            return &op;
         }
     }
+    return nullptr;
+}
 
-    auto* entry = entryForItem(item);
-    if (entry) {
-        emit operationSelected(QString::fromStdString(entry->opId));
+void HistoryPanel::onItemClicked(const QModelIndex& index) {
+    const std::string opId = model_->operationId(index);
+    if (!opId.empty()) {
+        emit operationSelected(QString::fromStdString(opId));
     }
 }
 
-void HistoryPanel::onItemDoubleClicked(QTreeWidgetItem* item, int) {
-    auto* entry = entryForItem(item);
-    if (!entry || !document_) return;
-
-    for (const auto& op : document_->operations()) {
-        if (op.opId == entry->opId) {
-            if (isEditableType(op.type)) {
-                showEditDialog(entry->opId);
-            }
-            break;
-        }
+void HistoryPanel::onItemDoubleClicked(const QModelIndex& index) {
+    const std::string opId = model_->operationId(index);
+    const app::OperationRecord* op = findOperation(opId);
+    if (op && isEditableType(op->type)) {
+        showEditDialog(opId);
     }
 }
 
@@ -450,83 +256,57 @@ void HistoryPanel::showEditDialog(const std::string& opId) {
 
     EditParameterDialog dialog(document_, viewport_, commandProcessor_, opId, this);
     if (dialog.exec() == QDialog::Accepted) {
-        rebuild();
+        model_->updateOperation(opId);
         viewport_->update();
     }
 }
 
 void HistoryPanel::onCustomContextMenu(const QPoint& pos) {
-    QTreeWidgetItem* item = treeWidget_->itemAt(pos);
-    if (item) {
-        showContextMenu(treeWidget_->viewport()->mapToGlobal(pos), item);
+    const std::string opId = model_->operationId(treeView_->indexAt(pos));
+    if (!opId.empty()) {
+        showContextMenu(treeView_->viewport()->mapToGlobal(pos), opId);
     }
 }
 
-void HistoryPanel::showContextMenu(const QPoint& pos, QTreeWidgetItem* item) {
-    auto* entry = entryForItem(item);
-    if (!entry || !document_) return;
-
-    // Find the operation
-    const app::OperationRecord* opRecord = nullptr;
-    for (const auto& op : document_->operations()) {
-        if (op.opId == entry->opId) {
-            opRecord = &op;
-            break;
-        }
-    }
+void HistoryPanel::showContextMenu(const QPoint& pos, const std::string& opId) {
+    const app::OperationRecord* opRecord = findOperation(opId);
     if (!opRecord) return;
+    const bool suppressed = document_->isOperationSuppressed(opId);
+    const QString qOpId = QString::fromStdString(opId);
 
     QMenu menu;
 
     if (isEditableType(opRecord->type)) {
         QAction* editAction = menu.addAction(tr("Edit Parameters..."));
-        connect(editAction, &QAction::triggered, this, [this, entry]() {
-            showEditDialog(entry->opId);
+        connect(editAction, &QAction::triggered, this, [this, opId]() {
+            showEditDialog(opId);
         });
     }
 
     menu.addSeparator();
 
     QAction* rollbackAction = menu.addAction(tr("Rollback to Here"));
-    connect(rollbackAction, &QAction::triggered, this, [this, entry]() {
-        emit rollbackRequested(QString::fromStdString(entry->opId));
+    connect(rollbackAction, &QAction::triggered, this, [this, qOpId]() {
+        emit rollbackRequested(qOpId);
     });
 
-    QString suppressText = entry->suppressed ? tr("Unsuppress") : tr("Suppress");
+    QString suppressText = suppressed ? tr("Unsuppress") : tr("Suppress");
     QAction* suppressAction = menu.addAction(suppressText);
-    connect(suppressAction, &QAction::triggered, this, [this, entry]() {
-        emit suppressRequested(QString::fromStdString(entry->opId), !entry->suppressed);
+    connect(suppressAction, &QAction::triggered, this, [this, qOpId, suppressed]() {
+        emit suppressRequested(qOpId, !suppressed);
     });
 
     menu.addSeparator();
 
     QAction* deleteAction = menu.addAction(tr("Delete"));
     deleteAction->setShortcut(QKeySequence::Delete);
-    connect(deleteAction, &QAction::triggered, this, [this, entry]() {
-        emit deleteRequested(QString::fromStdString(entry->opId));
+    connect(deleteAction, &QAction::triggered, this, [this, qOpId]() {
+        emit deleteRequested(qOpId);
     });
 
     menu.exec(pos);
 }
 
-HistoryPanel::ItemEntry* HistoryPanel::entryForItem(QTreeWidgetItem* item) {
-    for (auto& entry : entries_) {
-        if (entry.item == item) {
-            return &entry;
-        }
-    }
-    return nullptr;
-}
-
-HistoryPanel::ItemEntry* HistoryPanel::entryForId(const std::string& opId) {
-    for (auto& entry : entries_) {
-        if (entry.opId == opId) {
-            return &entry;
-        }
-    }
-    return nullptr;
-}
-
 void HistoryPanel::setCollapsed(bool collapsed) {
     if (collapsed_ == collapsed) return;
     collapsed_ = collapsed;
@@ -573,38 +353,27 @@ void HistoryPanel::applyCollapseState(bool animate) {
 }
 
 void HistoryPanel::onOperationAdded(const QString& opId) {
-    rebuild();
+    model_->addOperation(opId.toStdString());
 }
 
 void HistoryPanel::onOperationRemoved(const QString& opId) {
-    rebuild();
+    model_->removeOperation(opId.toStdString());
+}
+
+void HistoryPanel::onOperationUpdated(const QString& opId) {
+    model_->updateOperation(opId.toStdString());
 }
 
 void HistoryPanel::onOperationFailed(const QString& opId, const QString& reason) {
-    auto* entry = entryForId(opId.toStdString());
-    if (entry) {
-        entry->failed = true;
-        entry->failureReason = reason.toStdString();
-        updateItemState(*entry);
-    }
+    model_->setOperationFailed(opId.toStdString(), true, reason);
 }
 
 void HistoryPanel::onOperationSucceeded(const QString& opId) {
-    auto* entry = entryForId(opId.toStdString());
-    if (entry) {
-        entry->failed = false;
-        entry->failureReason.clear();
-        updateItemState(*entry);
-    }
+    model_->setOperationFailed(opId.toStdString(), false, QString());
 }
 
 void HistoryPanel::onOperationSuppressed(const QString& opId, bool suppressed) {
-    auto* entry = entryForId(opId.toStdString());
-    if (entry) {
-        entry->suppressed = suppressed;
-        updateItemState(*entry);
-    }
+    model_->setOperationSuppressed(opId.toStdString(), suppressed);
 }
 
 } // namespace onecad::ui
-
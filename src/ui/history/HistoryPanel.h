@@ -11,8 +11,8 @@
 #include <unordered_map>
 #include <string>
 
-class QTreeWidget;
-class QTreeWidgetItem;
+class QTreeView;
+class QModelIndex;
 class QFrame;
 class QPropertyAnimation;
 class QLabel;
@@ -32,7 +32,8 @@ class CommandProcessor;
 namespace ui {
 
 class Viewport;
-class FeatureCard;
+class HistoryModel;
+class VisibleRowWidgets;
 
 /**
  * @brief Feature history panel showing parametric operation tree.
@@ -46,6 +47,9 @@ class FeatureCard;
  * - Selected: bold
  * - Failed: red background, strikethrough
  * - Suppressed: gray, italic
+ *
+ * Rows live in a HistoryModel that is edited row by row as operations
+ * change; FeatureCard widgets exist only for rows on screen.
  */
 class HistoryPanel : public QWidget {
     Q_OBJECT
@@ -73,49 +77,36 @@ public slots:
     void rebuild();
     void onOperationAdded(const QString& opId);
     void onOperationRemoved(const QString& opId);
+    void onOperationUpdated(const QString& opId);
     void onOperationFailed(const QString& opId, const QString& reason);
     void onOperationSucceeded(const QString& opId);
     void onOperationSuppressed(const QString& opId, bool suppressed);
 
 private slots:
-    void onItemClicked(QTreeWidgetItem* item, int column);
-    void onItemDoubleClicked(QTreeWidgetItem* item, int column);
+    void onItemClicked(const QModelIndex& index);
+    void onItemDoubleClicked(const QModelIndex& index);
     void onCustomContextMenu(const QPoint& pos);
     void updateTheme();
 
 private:
-    struct ItemEntry {
-        std::string opId;
-        app::OperationType type{};
-        QTreeWidgetItem* item = nullptr;
-        FeatureCard* card = nullptr;
-        bool failed = false;
-        bool suppressed = false;
-        std::string failureReason;
-    };
-
     void setupUi();
     void applyCollapseState(bool animate);
-    FeatureCard* createItemWidget(ItemEntry& entry);
-    void updateItemState(ItemEntry& entry);
+    QWidget* createRowWidget(const QModelIndex& index);
+    void bindRowWidget(QWidget* widget, const QModelIndex& index);
     QWidget* createSectionHeader(const QString& text);
-    QString getOperationName(app::OperationType type) const;
-    QString getOperationDetails(const app::OperationRecord& op) const;
-    QString operationIconPath(app::OperationType type) const;
     bool isEditableType(app::OperationType type) const;
-    ItemEntry* entryForItem(QTreeWidgetItem* item);
-    ItemEntry* entryForId(const std::string& opId);
-    void showContextMenu(const QPoint& pos, QTreeWidgetItem* item);
+    const app::OperationRecord* findOperation(const std::string& opId) const;
+    void showContextMenu(const QPoint& pos, const std::string& opId);
     void showEditDialog(const std::string& opId);
 
     QFrame* panel_ = nullptr;
-    QTreeWidget* treeWidget_ = nullptr;
+    QTreeView* treeView_ = nullptr;
+    HistoryModel* model_ = nullptr;
+    VisibleRowWidgets* rowWidgets_ = nullptr;
 
-    
     app::Document* document_ = nullptr;
     Viewport* viewport_ = nullptr;
     app::commands::CommandProcessor* commandProcessor_ = nullptr;
-    std::vector<ItemEntry> entries_;
     bool collapsed_ = false;
     QPropertyAnimation* widthAnimation_ = nullptr;
     int expandedWidth_ = 260;
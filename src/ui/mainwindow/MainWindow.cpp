@@ -15,6 +15,7 @@
 #include "../../app/commands/RollbackCommand.h"
 #include "../../app/commands/SetOperationSuppressionCommand.h"
 #include "../../app/commands/ToggleVisibilityCommand.h"
+#include "../../app/diagnostics/MemoryReport.h"
 #include "../../app/document/Document.h"
 #include "../../app/history/RegenerationEngine.h"
 #include "../navigator/ModelNavigator.h"
@@ -45,11 +46,19 @@
 #include <QShortcut>
 #include <QDebug>
 #include <QLoggingCategory>
+#include <QLocale>
+#include <QProgressDialog>
 #include <algorithm>
+#include <utility>
 
 #include "../../io/OneCADFileIO.h"
+#include "../../io/AutosaveService.h"
+#include "../../io/DocumentIO.h"
+#include "../../io/HistoryVerificationJob.h"
 #include "../../io/step/StepImporter.h"
+#include "../../io/step/StepImportJob.h"
 #include "../../io/step/StepExporter.h"
+#include "../../io/step/StepExportJob.h"
 
 #include "../components/SidebarToolButton.h"
 #include "../start/StartOverlay.h"
@@ -134,6 +143,15 @@ MainWindow::MainWindow(QWidget* parent)
     // Create document model (no Qt parent - unique_ptr manages lifetime)
     m_document = std::make_unique<app::Document>();
     m_commandProcessor = std::make_unique<app::commands::CommandProcessor>();
+    m_commandProcessor->setDocument(m_document.get());
+    m_autosave = std::make_unique<io::AutosaveService>();
+    m_autosave->setDocument(m_document.get());
+    connect(m_autosave.get(), &io::AutosaveService::autosaveFailed, this,
+            [this](const QString& errorMessage) {
+                if (m_toolStatus) {
+                    m_toolStatus->setText(tr("Autosave failed: %1").arg(errorMessage));
+                }
+            });
 
     applyTheme();
     setupMenuBar();
@@ -171,7 +189,11 @@ MainWindow::MainWindow(QWidget* parent)
 
     loadSettings();
 
-    QTimer::singleShot(0, this, &MainWindow::showStartDialog);
+    QTimer::singleShot(0, this, [this]() {
+        if (!offerCrashRecovery()) {
+            showStartDialog();
+        }
+    });
 }
 
 MainWindow::~MainWindow() {
@@ -204,6 +226,14 @@ void MainWindow::connectDocumentSignals() {
             m_navigator, &ModelNavigator::onBodyVisibilityChanged);
     connect(m_document.get(), &app::Document::sketchVisibilityChanged,
             m_navigator, &ModelNavigator::onSketchVisibilityChanged);
+    // Entries load on first access, possibly while painting; report afterwards
+    connect(m_document.get(), &app::Document::pendingEntryLoadFailed, this,
+            [this](const QString& id, const QString& name, const QString& error) {
+        if (m_pendingEntryFailures.isEmpty()) {
+            QTimer::singleShot(0, this, &MainWindow::reportPendingEntryFailures);
+        }
+        m_pendingEntryFailures.append(tr("%1: %2").arg(name.isEmpty() ? id : name, error));
+    });
 
     if (m_historyPanel) {
         connect(m_document.get(), &app::Document::operationAdded,
@@ -211,7 +241,7 @@ void MainWindow::connectDocumentSignals() {
         connect(m_document.get(), &app::Document::operationRemoved,
                 m_historyPanel, &HistoryPanel::onOperationRemoved);
         connect(m_document.get(), &app::Document::operationUpdated,
-                m_historyPanel, &HistoryPanel::onOperationAdded);
+                m_historyPanel, &HistoryPanel::onOperationUpdated);
         connect(m_document.get(), &app::Document::operationSuppressionChanged,
                 m_historyPanel, &HistoryPanel::onOperationSuppressed);
         connect(m_document.get(), &app::Document::operationFailed,
@@ -719,6 +749,9 @@ void MainWindow::setupRenderDebugOverlay() {
         }
         const bool visible = !m_renderDebugPanel->isVisible();
         m_renderDebugPanel->setVisible(visible);
+        if (visible) {
+            refreshMemoryReport();
+        }
         positionRenderDebugPanel();
     });
 
@@ -755,6 +788,11 @@ void MainWindow::setupRenderDebugOverlay() {
         applyRenderDebugDefaults();
     });
 
+    connect(m_renderDebugPanel, &RenderDebugPanel::memoryRefreshRequested,
+            this, &MainWindow::refreshMemoryReport);
+    connect(m_renderDebugPanel, &RenderDebugPanel::memoryDumpRequested,
+            this, &MainWindow::dumpMemoryReport);
+
     connect(m_viewport, &Viewport::debugTogglesChanged, this,
             [this](bool normals, bool depth, bool wireframe, bool disableGamma, bool matcap) {
                 if (!m_renderDebugPanel) {
@@ -834,6 +872,49 @@ void MainWindow::applyRenderDebugDefaults() {
                                   rig.gradientStrength);
 }
 
+app::diagnostics::MemoryReport MainWindow::collectMemoryReport() const {
+    app::diagnostics::MemoryReport report;
+    if (m_document) {
+        report = app::diagnostics::MemoryReport::collect(*m_document, m_commandProcessor.get());
+    }
+    if (m_viewport) {
+        m_viewport->appendMemoryReport(report);
+    }
+    return report;
+}
+
+void MainWindow::refreshMemoryReport() {
+    if (!m_renderDebugPanel) {
+        return;
+    }
+    m_renderDebugPanel->setMemorySummary(collectMemoryReport().summary());
+}
+
+void MainWindow::dumpMemoryReport() {
+    QString fileName = QFileDialog::getSaveFileName(this,
+        tr("Save Memory Report"), QStringLiteral("onecad-memory.json"),
+        tr("JSON Files (*.json)"));
+    if (fileName.isEmpty()) {
+        return;
+    }
+    if (!fileName.endsWith(".json", Qt::CaseInsensitive)) {
+        fileName += ".json";
+    }
+
+    const app::diagnostics::MemoryReport report = collectMemoryReport();
+    if (m_renderDebugPanel) {
+        m_renderDebugPanel->setMemorySummary(report.summary());
+    }
+    if (!report.writeJson(fileName)) {
+        QMessageBox::warning(this, tr("Memory Report"),
+                             tr("Could not write %1.").arg(QDir::toNativeSeparators(fileName)));
+        return;
+    }
+    statusBar()->showMessage(tr("Memory report saved (%1)")
+                                 .arg(app::diagnostics::MemoryReport::formatBytes(report.totalBytes())),
+                             3000);
+}
+
 void MainWindow::positionConstraintPanel() {
     if (!m_viewport || !m_constraintPanel) {
         return;
@@ -929,6 +1010,17 @@ void MainWindow::setupViewport() {
             return;
         }
 
+        // The open document may still load entries from the file
+        if (m_document && !m_currentFilePath.isEmpty() &&
+            QFileInfo(m_currentFilePath).absoluteFilePath() == info.absoluteFilePath()) {
+            if (!m_document->loadPendingEntries()) {
+                QMessageBox::warning(this, tr("Delete Project"),
+                    tr("\"%1\" was not deleted: some of its items could not be loaded "
+                       "and would be lost.").arg(name));
+                return;
+            }
+        }
+
         if (!deleteProjectFromPath(path)) {
             QMessageBox::warning(this, tr("Delete Failed"),
                 tr("Could not delete \"%1\".").arg(name));
@@ -1277,35 +1369,95 @@ void MainWindow::onSketchModeChanged(bool inSketchMode) {
 }
 
 void MainWindow::onImport() {
+    if (m_stepImport && m_stepImport->isRunning()) {
+        return;
+    }
+
     QString fileName = QFileDialog::getOpenFileName(this,
         tr("Import STEP File"), QString(),
         tr("STEP Files (*.step *.stp);;All Files (*)"));
     
     if (fileName.isEmpty()) return;
-    
-    m_toolStatus->setText(tr("Importing: %1").arg(QFileInfo(fileName).fileName()));
-    auto result = io::StepImporter::import(fileName);
-    
-    if (!result.success) {
-        QMessageBox::critical(this, tr("Import Failed"), result.errorMessage);
-        m_toolStatus->setText(tr("Import failed"));
-        return;
+
+    if (!m_stepImport) {
+        m_stepImport = std::make_unique<io::StepImportJob>();
     }
-    
-    for (auto& body : result.bodies) {
+    io::StepImportJob* job = m_stepImport.get();
+    job->disconnect(this);
+
+    // Window-modal: the document must not be replaced while bodies stream in
+    const QString displayName = QFileInfo(fileName).fileName();
+    auto* progress = new QProgressDialog(tr("Importing %1...").arg(displayName),
+                                         tr("Cancel"), 0, 100, this);
+    progress->setWindowTitle(tr("Import STEP File"));
+    progress->setWindowModality(Qt::WindowModal);
+    progress->setMinimumDuration(300);
+    progress->setAutoClose(false);
+    progress->setAutoReset(false);
+    progress->setValue(0);
+
+    auto importedIds = std::make_shared<std::vector<std::string>>();
+
+    connect(progress, &QProgressDialog::canceled, this, [this, job]() {
+        job->cancel();
+        m_toolStatus->setText(tr("Cancelling import..."));
+    });
+    connect(job, &io::StepImportJob::progressChanged, progress,
+            [progress, displayName](int percent, const QString& stage) {
+        progress->setLabelText(tr("Importing %1\n%2").arg(displayName, stage));
+        progress->setValue(percent);
+    });
+    connect(job, &io::StepImportJob::bodyImported, this,
+            [this, importedIds, displayName](const io::ImportedBody& body) {
+        // Already triangulated on the worker; adding only builds the scene mesh
         std::string bodyId = m_document->addBody(body.shape);
-        if (!bodyId.empty()) {
-            m_document->addBaseBodyId(bodyId);
+        if (bodyId.empty()) {
+            return;
         }
-    }
-    
-    if (m_viewport) {
-        m_viewport->update();
-    }
-    m_toolStatus->setText(tr("Imported %1 body(ies)").arg(result.bodies.size()));
+        m_document->addBaseBodyId(bodyId);
+        importedIds->push_back(bodyId);
+        m_toolStatus->setText(tr("Importing: %1 (%2 body(ies))")
+                                  .arg(displayName)
+                                  .arg(importedIds->size()));
+        if (m_viewport) {
+            m_viewport->update();
+        }
+    });
+    connect(job, &io::StepImportJob::finished, this,
+            [this, progress, importedIds](const io::StepImportResult& result) {
+        progress->close();
+        progress->deleteLater();
+
+        if (!result.success) {
+            // Cancelled or failed imports leave the document unchanged
+            for (const auto& bodyId : *importedIds) {
+                m_document->removeBody(bodyId);
+            }
+            if (result.cancelled) {
+                m_toolStatus->setText(tr("Import cancelled"));
+            } else {
+                QMessageBox::critical(this, tr("Import Failed"), result.errorMessage);
+                m_toolStatus->setText(tr("Import failed"));
+            }
+        } else {
+            m_toolStatus->setText(tr("Imported %1 body(ies)").arg(importedIds->size()));
+        }
+
+        if (m_viewport) {
+            m_viewport->update();
+        }
+    });
+
+    m_toolStatus->setText(tr("Importing: %1").arg(displayName));
+    job->start(fileName, m_document.get());
 }
 
 void MainWindow::onExportStep() {
+    if (m_stepExport && m_stepExport->isRunning()) {
+        QMessageBox::information(this, tr("Export"), tr("A STEP export is already running."));
+        return;
+    }
+
     auto bodyIds = m_document->getBodyIds();
     if (bodyIds.empty()) {
         QMessageBox::warning(this, tr("Export"), tr("No bodies to export."));
@@ -1323,20 +1475,57 @@ void MainWindow::onExportStep() {
         fileName += ".step";
     }
     
+    // The job deep-copies these before handing them to its worker
     std::vector<TopoDS_Shape> shapes;
     for (const auto& id : bodyIds) {
         if (auto* s = m_document->getBodyShape(id)) {
             shapes.push_back(*s);
         }
     }
-    
-    auto result = io::StepExporter::exportShapes(fileName, shapes);
-    if (!result.success) {
-        QMessageBox::critical(this, tr("Export Failed"), result.errorMessage);
-        return;
+
+    if (!m_stepExport) {
+        m_stepExport = std::make_unique<io::StepExportJob>();
     }
-    
-    m_toolStatus->setText(tr("Exported %1 body(ies) to STEP").arg(shapes.size()));
+    io::StepExportJob* job = m_stepExport.get();
+    job->disconnect(this);
+
+    // Non-modal: modeling continues while the file is written
+    const QString displayName = QFileInfo(fileName).fileName();
+    auto* progress = new QProgressDialog(tr("Exporting %1...").arg(displayName),
+                                         tr("Cancel"), 0, 100, this);
+    progress->setWindowTitle(tr("Export STEP File"));
+    progress->setWindowModality(Qt::NonModal);
+    progress->setMinimumDuration(500);
+    progress->setAutoClose(false);
+    progress->setAutoReset(false);
+    progress->setValue(0);
+
+    connect(progress, &QProgressDialog::canceled, this, [this, job]() {
+        job->cancel();
+        m_toolStatus->setText(tr("Cancelling export..."));
+    });
+    connect(job, &io::StepExportJob::progressChanged, progress,
+            [progress, displayName](int percent, const QString& stage) {
+        progress->setLabelText(tr("Exporting %1\n%2").arg(displayName, stage));
+        progress->setValue(percent);
+    });
+    connect(job, &io::StepExportJob::finished, this,
+            [this, progress](const io::StepExportResult& result) {
+        progress->close();
+        progress->deleteLater();
+
+        if (result.cancelled) {
+            m_toolStatus->setText(tr("Export cancelled"));
+        } else if (!result.success) {
+            QMessageBox::critical(this, tr("Export Failed"), result.errorMessage);
+            m_toolStatus->setText(tr("Export failed"));
+        } else {
+            m_toolStatus->setText(tr("Exported %1 body(ies) to STEP").arg(result.bodyCount));
+        }
+    });
+
+    m_toolStatus->setText(tr("Exporting: %1").arg(displayName));
+    job->start(fileName, std::move(shapes));
 }
 
 bool MainWindow::maybeSave() {
@@ -1367,6 +1556,8 @@ void MainWindow::onNewDocument() {
     
     m_document->clear();
     m_currentFilePath.clear();
+    m_autosave->discardRecovery();
+    m_autosave->setSourcePath({});
     setWindowTitle(tr("OneCAD - Untitled"));
     m_toolStatus->setText(tr("New document"));
     if (m_startOverlay && m_startOverlay->isVisible()) {
@@ -1407,9 +1598,14 @@ bool MainWindow::loadDocumentFromPath(const QString& fileName) {
     }
 
     // Replace current document with loaded one
+    if (m_historyVerification) {
+        m_historyVerification->cancel();
+    }
     m_document = std::move(loadedDoc);
+    m_autosave->setDocument(m_document.get());
     if (m_commandProcessor) {
         m_commandProcessor->clear();
+        m_commandProcessor->setDocument(m_document.get());
     }
     m_viewport->setDocument(m_document.get());
 
@@ -1424,6 +1620,7 @@ bool MainWindow::loadDocumentFromPath(const QString& fileName) {
     m_navigator->rebuild(m_document.get());
 
     m_currentFilePath = resolvedPath;
+    m_autosave->setSourcePath(resolvedPath);
     setWindowTitle(tr("OneCAD - %1").arg(QFileInfo(resolvedPath).fileName()));
     m_toolStatus->setText(tr("Loaded successfully"));
 
@@ -1433,6 +1630,11 @@ bool MainWindow::loadDocumentFromPath(const QString& fileName) {
 
     handleRegenerationFailures();
 
+    // Bodies came from the BREP cache: replay history once the viewport has painted
+    if (m_document->isHistoryVerificationPending()) {
+        QTimer::singleShot(0, this, &MainWindow::verifyCachedHistory);
+    }
+
     if (m_startOverlay && m_startOverlay->isVisible()) {
         m_startOverlay->hide();
     }
@@ -1440,6 +1642,53 @@ bool MainWindow::loadDocumentFromPath(const QString& fileName) {
     return true;
 }
 
+void MainWindow::verifyCachedHistory() {
+    if (!m_document || !m_document->isHistoryVerificationPending()) {
+        return;
+    }
+
+    // Replays a snapshot on a worker; the document stays usable meanwhile
+    if (!m_historyVerification) {
+        m_historyVerification = std::make_unique<io::HistoryVerificationJob>();
+        connect(m_historyVerification.get(), &io::HistoryVerificationJob::finished,
+                this, &MainWindow::onHistoryVerified);
+    }
+    m_toolStatus->setText(tr("Verifying history..."));
+    m_historyVerification->start(m_document.get());
+}
+
+void MainWindow::onHistoryVerified(const io::HistoryVerificationResult& result) {
+    if (!result.success) {
+        qWarning() << "History verification failed:" << result.errorMessage;
+    }
+    if (!io::HistoryVerificationJob::apply(m_document.get(), result)) {
+        // History was edited while verifying; check the current state
+        verifyCachedHistory();
+        return;
+    }
+
+    if (m_historyPanel) {
+        m_historyPanel->rebuild();
+    }
+    if (m_viewport) {
+        m_viewport->update();
+    }
+    m_toolStatus->setText(tr("Ready"));
+
+    handleRegenerationFailures();
+}
+
+void MainWindow::reportPendingEntryFailures() {
+    if (m_pendingEntryFailures.isEmpty()) {
+        return;
+    }
+    const QStringList failures = std::exchange(m_pendingEntryFailures, {});
+    m_toolStatus->setText(tr("Some items could not be loaded"));
+    QMessageBox::warning(this, tr("Load Failed"),
+        tr("These items could not be loaded from the file. They are kept in it "
+           "unchanged when saving in place:\n\n%1").arg(failures.join("\n")));
+}
+
 void MainWindow::handleRegenerationFailures() {
     if (!m_document) {
         return;
@@ -1536,8 +1785,13 @@ bool MainWindow::saveDocumentToPath(const QString& filePath) {
         }
         return false;
     }
+    if (!result.warnings.isEmpty()) {
+        QMessageBox::warning(this, tr("Save"), result.warnings.join("\n"));
+    }
 
     m_document->setModified(false);
+    m_autosave->discardRecovery();
+    m_autosave->setSourcePath(filePath);
     if (m_toolStatus) {
         m_toolStatus->setText(tr("Saved"));
     }
@@ -1575,6 +1829,10 @@ void MainWindow::resetDocumentState() {
 
     m_activeSketchId.clear();
     m_currentFilePath.clear();
+    if (m_autosave) {
+        m_autosave->discardRecovery();
+        m_autosave->setSourcePath({});
+    }
     setWindowTitle(tr("OneCAD - Untitled"));
     if (m_toolStatus) {
         m_toolStatus->setText(tr("Ready"));
@@ -1666,6 +1924,66 @@ void MainWindow::showStartDialog() {
     m_startOverlay->setFocus(Qt::OtherFocusReason);
 }
 
+bool MainWindow::offerCrashRecovery() {
+    const auto recoveries = io::AutosaveService::findOrphanedRecoveries();
+    if (recoveries.empty()) {
+        return false;
+    }
+
+    // Offer the newest session; older leftovers are superseded by it
+    const auto& latest = recoveries.front();
+    const QString name = latest.sourcePath.isEmpty() ? tr("Untitled")
+                                                     : QFileInfo(latest.sourcePath).fileName();
+    auto choice = QMessageBox::question(this, tr("Recover Unsaved Changes"),
+        tr("OneCAD did not shut down cleanly.\n"
+           "Recover the unsaved changes to \"%1\" autosaved at %2?\n\n"
+           "Choose Discard to delete them, or No to be asked again next time.")
+            .arg(name, QLocale().toString(latest.savedAt.toLocalTime(), QLocale::ShortFormat)),
+        QMessageBox::Yes | QMessageBox::No | QMessageBox::Discard, QMessageBox::Yes);
+
+    auto removeAll = [&recoveries]() {
+        for (const auto& info : recoveries) {
+            io::AutosaveService::removeRecovery(info);
+        }
+    };
+    if (choice == QMessageBox::Discard) {
+        removeAll();
+        return false;
+    }
+    if (choice != QMessageBox::Yes) {
+        return false;
+    }
+
+    // Recovery files are only deleted once everything was read from them
+    auto keepRecovery = [this, &latest](const QString& reason) {
+        QMessageBox::warning(this, tr("Recover Unsaved Changes"),
+            tr("%1\n\nThe autosaved copy was kept at:\n%2")
+                .arg(reason, QDir::toNativeSeparators(latest.packagePath)));
+    };
+    if (!loadDocumentFromPath(latest.packagePath)) {
+        keepRecovery(tr("The autosaved changes could not be opened."));
+        return false;
+    }
+
+    // Saving goes to the original file, never to the recovery package
+    m_currentFilePath = latest.sourcePath;
+    m_autosave->setSourcePath(latest.sourcePath);
+    m_document->setSaveBaselinePath({});
+    m_document->setModified(true);
+    setWindowTitle(tr("OneCAD - %1").arg(name));
+
+    if (!m_document->loadPendingEntries()) {
+        // The document keeps reading the remaining entries from the package
+        m_toolStatus->setText(tr("Recovered with errors"));
+        keepRecovery(tr("Some of the autosaved items could not be loaded."));
+        return true;
+    }
+
+    m_toolStatus->setText(tr("Recovered unsaved changes"));
+    removeAll();
+    return true;
+}
+
 bool MainWindow::deleteProjectFromPath(const QString& filePath) {
     QFileInfo info(filePath);
     if (!info.exists()) {
@@ -1978,6 +2296,10 @@ void MainWindow::loadSettings() {
     if (m_viewport) {
         m_viewport->setCameraAngle(savedAngle);
     }
+
+    // Background autosave interval (0 disables)
+    m_autosave->setIntervalSeconds(
+        settings.value("autosave/intervalSeconds", io::AutosaveService::kDefaultIntervalSeconds).toInt());
 }
 
 void MainWindow::saveSettings() {
@@ -23,6 +23,16 @@ namespace app {
     namespace commands {
         class CommandProcessor;
     }
+    namespace diagnostics {
+        class MemoryReport;
+    }
+}
+namespace io {
+    class AutosaveService;
+    class HistoryVerificationJob;
+    struct HistoryVerificationResult;
+    class StepImportJob;
+    class StepExportJob;
 }
 namespace core::sketch {
     class Sketch;
@@ -98,6 +108,9 @@ private:
     void positionRenderDebugButton();
     void positionRenderDebugPanel();
     void applyRenderDebugDefaults();
+    app::diagnostics::MemoryReport collectMemoryReport() const;
+    void refreshMemoryReport();
+    void dumpMemoryReport();
     void positionConstraintPanel();
     void positionSketchModePanel();
     void positionStartOverlay();
@@ -107,7 +120,11 @@ private:
     void positionSnapOverlay();
     void positionSnapSettingsPanel();
     void handleRegenerationFailures();
+    void reportPendingEntryFailures();
+    void verifyCachedHistory();
+    void onHistoryVerified(const io::HistoryVerificationResult& result);
     void showStartDialog();
+    bool offerCrashRecovery();
     bool loadDocumentFromPath(const QString& fileName);
     bool saveDocumentToPath(const QString& filePath);
     bool hasOpenProject() const;
@@ -138,6 +155,10 @@ private:
     // Document model (owns all sketches)
     std::unique_ptr<app::Document> m_document;
     std::unique_ptr<app::commands::CommandProcessor> m_commandProcessor;
+    std::unique_ptr<io::AutosaveService> m_autosave;  // Destroyed before m_document
+    std::unique_ptr<io::StepImportJob> m_stepImport;  // Destroyed before m_document
+    std::unique_ptr<io::StepExportJob> m_stepExport;
+    std::unique_ptr<io::HistoryVerificationJob> m_historyVerification;
 
     // Active editing state
     std::string m_activeSketchId;  // Currently editing sketch ID (empty if not in sketch mode)
@@ -158,6 +179,7 @@ private:
 
     // File state
     QString m_currentFilePath;  // Empty = untitled document
+    QStringList m_pendingEntryFailures;  // Reported together once control returns to the event loop
     bool maybeSave();  // Returns true if safe to proceed
 
     void loadSettings();
@@ -1,5 +1,7 @@
 #include "ModelNavigator.h"
+#include "NavigatorModel.h"
 #include "../../app/document/Document.h"
+#include "../components/VisibleRowWidgets.h"
 #include "../theme/ThemeManager.h"
 #include <QFrame>
 #include <QHeaderView>
@@ -17,11 +19,10 @@
 #include <QItemSelection>
 #include <QAbstractItemView>
 #include <QToolButton>
-#include <QTreeWidget>
+#include <QTreeView>
 #include <QVBoxLayout>
 #include <QEasingCurve>
 #include <QRect>
-#include <algorithm>
 
 namespace onecad {
 namespace ui {
@@ -43,14 +44,63 @@ QPixmap tintIcon(const QString& path, const QColor& color) {
 }
 } // namespace
 
+/**
+ * @brief Row widget of a body or sketch: icon, name, eye and overflow buttons
+ */
+class ModelNavigator::ItemRow : public QWidget {
+public:
+    ItemRow() {
+        setProperty("nav-item", true);
+        auto* layout = new QHBoxLayout(this);
+        layout->setContentsMargins(8, 6, 8, 6);
+        layout->setSpacing(8);
+
+        iconLabel = new QLabel(this);
+        iconLabel->setProperty("nav-item-icon", true);
+        iconLabel->setFixedSize(20, 20);
+        iconLabel->setScaledContents(true);
+        iconLabel->setAutoFillBackground(false);
+        iconLabel->setAttribute(Qt::WA_TranslucentBackground);
+
+        textLabel = new QLabel(this);
+        textLabel->setProperty("nav-item-label", true);
+        textLabel->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Preferred);
+        textLabel->setAutoFillBackground(false);
+        textLabel->setAttribute(Qt::WA_TranslucentBackground);
+
+        eyeButton = new QToolButton(this);
+        eyeButton->setProperty("nav-inline", true);
+        eyeButton->setAutoRaise(true);
+        eyeButton->setCursor(Qt::PointingHandCursor);
+        eyeButton->setFocusPolicy(Qt::NoFocus);
+        eyeButton->setToolTip(ModelNavigator::tr("Toggle visibility"));
+
+        overflowButton = new QToolButton(this);
+        overflowButton->setProperty("nav-inline", true);
+        overflowButton->setAutoRaise(true);
+        overflowButton->setCursor(Qt::PointingHandCursor);
+        overflowButton->setFocusPolicy(Qt::NoFocus);
+        overflowButton->setToolTip(ModelNavigator::tr("More actions"));
+
+        layout->addWidget(iconLabel);
+        layout->addWidget(textLabel, 1);
+        layout->addSpacing(8);
+        layout->addWidget(eyeButton);
+        layout->addWidget(overflowButton);
+    }
+
+    QLabel* iconLabel = nullptr;
+    QLabel* textLabel = nullptr;
+    QToolButton* eyeButton = nullptr;
+    QToolButton* overflowButton = nullptr;
+};
+
 ModelNavigator::ModelNavigator(QWidget* parent)
     : QWidget(parent) {
     setupUi();
-    setupRoots();
     m_themeConnection = connect(&ThemeManager::instance(), &ThemeManager::themeChanged,
                                 this, &ModelNavigator::updateTheme, Qt::UniqueConnection);
     updateTheme();
-    createPlaceholderItems();
     applyCollapseState(false);
 }
 
@@ -70,62 +120,61 @@ void ModelNavigator::setupUi() {
     panelLayout->setContentsMargins(12, 12, 12, 12);
     panelLayout->setSpacing(10);
 
-    m_treeWidget = new QTreeWidget(m_panel);
-    m_treeWidget->setObjectName("NavigatorTree");
-    m_treeWidget->setHeaderHidden(true);
-    m_treeWidget->setIndentation(12);
-    m_treeWidget->setAnimated(true);
-    m_treeWidget->setExpandsOnDoubleClick(false);
-    m_treeWidget->setSelectionMode(QAbstractItemView::SingleSelection);
-    m_treeWidget->setSelectionBehavior(QAbstractItemView::SelectRows);
-    m_treeWidget->setRootIsDecorated(true);
-    m_treeWidget->setUniformRowHeights(true);
-    m_treeWidget->setContextMenuPolicy(Qt::CustomContextMenu);
-    m_treeWidget->setFocusPolicy(Qt::NoFocus);
-    m_treeWidget->header()->setSectionResizeMode(QHeaderView::Stretch);
-    m_treeWidget->setHorizontalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
-    m_treeWidget->viewport()->installEventFilter(this);
-
-    connect(m_treeWidget, &QTreeWidget::itemClicked,
+    m_model = new NavigatorModel(this);
+    m_treeView = new QTreeView(m_panel);
+    m_treeView->setObjectName("NavigatorTree");
+    m_treeView->setModel(m_model);
+    m_treeView->setHeaderHidden(true);
+    m_treeView->setIndentation(12);
+    m_treeView->setAnimated(true);
+    m_treeView->setExpandsOnDoubleClick(false);
+    m_treeView->setSelectionMode(QAbstractItemView::SingleSelection);
+    m_treeView->setSelectionBehavior(QAbstractItemView::SelectRows);
+    m_treeView->setRootIsDecorated(true);
+    m_treeView->setUniformRowHeights(true);
+    m_treeView->setContextMenuPolicy(Qt::CustomContextMenu);
+    m_treeView->setFocusPolicy(Qt::NoFocus);
+    m_treeView->header()->setSectionResizeMode(QHeaderView::Stretch);
+    m_treeView->setHorizontalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
+    m_treeView->viewport()->installEventFilter(this);
+    m_treeView->expandAll();
+
+    m_rowWidgets = new VisibleRowWidgets(
+        m_treeView,
+        [this](const QModelIndex& index) { return createRowWidget(index); },
+        [this](QWidget* widget, const QModelIndex& index) { bindRowWidget(widget, index); });
+
+    connect(m_treeView, &QTreeView::clicked,
             this, &ModelNavigator::onItemClicked);
-    connect(m_treeWidget, &QTreeWidget::itemDoubleClicked,
+    connect(m_treeView, &QTreeView::doubleClicked,
             this, &ModelNavigator::onItemDoubleClicked);
-    connect(m_treeWidget, &QTreeWidget::customContextMenuRequested, this, [this](const QPoint& pos) {
-        if (QTreeWidgetItem* item = m_treeWidget->itemAt(pos)) {
-            if (item != m_bodiesRoot && item != m_sketchesRoot) {
-                showContextMenu(m_treeWidget->viewport()->mapToGlobal(pos), item);
-            }
+    connect(m_treeView, &QTreeView::customContextMenuRequested, this, [this](const QPoint& pos) {
+        const QString id = m_model->itemId(m_treeView->indexAt(pos));
+        if (!id.isEmpty()) {
+            showContextMenu(m_treeView->viewport()->mapToGlobal(pos), id);
         }
     });
-    connect(m_treeWidget->selectionModel(), &QItemSelectionModel::selectionChanged,
+    connect(m_treeView->selectionModel(), &QItemSelectionModel::selectionChanged,
             this, [this](const QItemSelection& selected, const QItemSelection& deselected) {
                 Q_UNUSED(selected);
                 Q_UNUSED(deselected);
-                updateSelectionState();
-                if (m_treeWidget->selectedItems().isEmpty()) {
+                m_rowWidgets->rebindAll();
+                if (!m_treeView->selectionModel()->hasSelection()) {
                     emit sketchSelected(QString());
                 }
             });
 
-    panelLayout->addWidget(m_treeWidget, 1);
+    // Sections stay expanded across rebuilds and as items arrive
+    connect(m_model, &QAbstractItemModel::modelReset, m_treeView, &QTreeView::expandAll);
+    connect(m_model, &QAbstractItemModel::rowsInserted, this, [this](const QModelIndex& parent) {
+        if (parent.isValid()) {
+            m_treeView->expand(parent);
+        }
+    });
 
-    layout->addWidget(m_panel);
-}
+    panelLayout->addWidget(m_treeView, 1);
 
-void ModelNavigator::setupRoots() {
-    m_bodiesRoot = new QTreeWidgetItem(m_treeWidget);
-    m_bodiesRoot->setFlags(m_bodiesRoot->flags() & ~Qt::ItemIsSelectable);
-    m_bodiesRoot->setChildIndicatorPolicy(QTreeWidgetItem::ShowIndicator);
-    m_bodiesRoot->setFirstColumnSpanned(true);
-    m_bodiesRoot->setExpanded(true);
-    m_treeWidget->setItemWidget(m_bodiesRoot, 0, createSectionHeader(tr("Bodies")));
-
-    m_sketchesRoot = new QTreeWidgetItem(m_treeWidget);
-    m_sketchesRoot->setFlags(m_sketchesRoot->flags() & ~Qt::ItemIsSelectable);
-    m_sketchesRoot->setChildIndicatorPolicy(QTreeWidgetItem::ShowIndicator);
-    m_sketchesRoot->setFirstColumnSpanned(true);
-    m_sketchesRoot->setExpanded(true);
-    m_treeWidget->setItemWidget(m_sketchesRoot, 0, createSectionHeader(tr("Sketches")));
+    layout->addWidget(m_panel);
 }
 
 QWidget* ModelNavigator::createSectionHeader(const QString& text) {
@@ -135,196 +184,75 @@ QWidget* ModelNavigator::createSectionHeader(const QString& text) {
     return label;
 }
 
-void ModelNavigator::createPlaceholder(QTreeWidgetItem* root, const QString& text) {
-    auto* placeholder = new QTreeWidgetItem(root);
-    placeholder->setText(0, text);
-    placeholder->setFlags(placeholder->flags() & ~Qt::ItemIsSelectable);
-    placeholder->setForeground(0, m_placeholderColor);
-    placeholder->setSizeHint(0, QSize(0, 32));
-}
-
-void ModelNavigator::createPlaceholderItems() {
-    createPlaceholder(m_bodiesRoot, tr("(No bodies)"));
-    createPlaceholder(m_sketchesRoot, tr("(No sketches)"));
-}
-
-QWidget* ModelNavigator::createItemWidget(ItemEntry& entry, const QString& text, ItemType type, bool visible) {
-    auto* container = new QWidget();
-    container->setProperty("nav-item", true);
-    auto* layout = new QHBoxLayout(container);
-    layout->setContentsMargins(8, 6, 8, 6);
-    layout->setSpacing(8);
-
-    entry.iconLabel = new QLabel(container);
-    entry.iconLabel->setProperty("nav-item-icon", true);
-    entry.iconLabel->setFixedSize(20, 20);
-    entry.iconLabel->setScaledContents(true);
-    entry.iconLabel->setAutoFillBackground(false);
-    entry.iconLabel->setAttribute(Qt::WA_TranslucentBackground);
-
-    entry.textLabel = new QLabel(text, container);
-    entry.textLabel->setProperty("nav-item-label", true);
-    entry.textLabel->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Preferred);
-    entry.textLabel->setAutoFillBackground(false);
-    entry.textLabel->setAttribute(Qt::WA_TranslucentBackground);
-
-    entry.eyeButton = new QToolButton(container);
-    entry.eyeButton->setProperty("nav-inline", true);
-    entry.eyeButton->setAutoRaise(true);
-    entry.eyeButton->setCursor(Qt::PointingHandCursor);
-    entry.eyeButton->setFocusPolicy(Qt::NoFocus);
-    entry.eyeButton->setToolTip(tr("Toggle visibility"));
-
-    entry.overflowButton = new QToolButton(container);
-    entry.overflowButton->setProperty("nav-inline", true);
-    entry.overflowButton->setAutoRaise(true);
-    entry.overflowButton->setCursor(Qt::PointingHandCursor);
-    entry.overflowButton->setFocusPolicy(Qt::NoFocus);
-    entry.overflowButton->setToolTip(tr("More actions"));
-
-    layout->addWidget(entry.iconLabel);
-    layout->addWidget(entry.textLabel, 1);
-    layout->addSpacing(8);
-    layout->addWidget(entry.eyeButton);
-    layout->addWidget(entry.overflowButton);
-
-    entry.type = type;
-    entry.visible = visible;
-    entry.widget = container;
-    return container;
-}
-
-void ModelNavigator::refreshItemWidget(ItemEntry& entry) {
-    const auto& theme = ThemeManager::instance().currentTheme();
-    const bool selected = entry.item && entry.item->isSelected();
-
-    entry.widget->setProperty("nav-selected", selected);
-    entry.widget->style()->unpolish(entry.widget);
-    entry.widget->style()->polish(entry.widget);
-
-    const QColor textColor = selected ? theme.navigator.itemSelectedText : theme.navigator.itemText;
-    entry.textLabel->setStyleSheet(QStringLiteral("color: %1;").arg(textColor.name(QColor::HexArgb)));
-
-    const QColor iconColor = selected ? theme.navigator.itemSelectedText : theme.navigator.itemIcon;
-    const QString iconPath = (entry.type == ItemType::Body) ? QStringLiteral(":/icons/ic_body.svg")
-                                                           : QStringLiteral(":/icons/ic_sketch.svg");
-    entry.iconLabel->setPixmap(tintIcon(iconPath, iconColor));
-
-    const QString eyePath = entry.visible ? QStringLiteral(":/icons/ic_eye_on.svg")
-                                          : QStringLiteral(":/icons/ic_eye_off.svg");
-    entry.eyeButton->setIcon(QIcon(tintIcon(eyePath, iconColor)));
-    entry.eyeButton->setToolTip(entry.visible ? tr("Hide") : tr("Show"));
-
-    entry.overflowButton->setIcon(QIcon(tintIcon(QStringLiteral(":/icons/ic_overflow.svg"), iconColor)));
-}
+QWidget* ModelNavigator::createRowWidget(const QModelIndex& index) {
+    switch (m_model->rowKind(index)) {
+        case NavigatorModel::RowKind::Section:
+            return createSectionHeader(index.data(Qt::DisplayRole).toString());
+        case NavigatorModel::RowKind::Placeholder:
+            return nullptr;
+        case NavigatorModel::RowKind::Item:
+            break;
+    }
 
-void ModelNavigator::setupItemConnections(ItemEntry& entry) {
-    QTreeWidgetItem* itemPtr = entry.item;
-    QToolButton* eyeBtn = entry.eyeButton;
-    QToolButton* overflowBtn = entry.overflowButton;
+    auto* row = new ItemRow;
+    const QString id = m_model->itemId(index);
+    QToolButton* overflowBtn = row->overflowButton;
 
-    connect(eyeBtn, &QToolButton::clicked, this, [this, itemPtr]() {
-        if (ItemEntry* found = entryForItem(itemPtr)) {
-            handleVisibilityToggle(*found);
-        }
+    connect(row->eyeButton, &QToolButton::clicked, this, [this, id]() {
+        toggleVisibility(id);
     });
 
-    connect(overflowBtn, &QToolButton::clicked, this, [this, itemPtr, overflowBtn]() {
-        if (ItemEntry* found = entryForItem(itemPtr)) {
-            const QPoint globalPos = overflowBtn->mapToGlobal(overflowBtn->rect().bottomRight());
-            showContextMenu(globalPos, found->item);
-        }
+    connect(overflowBtn, &QToolButton::clicked, this, [this, id, overflowBtn]() {
+        const QPoint globalPos = overflowBtn->mapToGlobal(overflowBtn->rect().bottomRight());
+        showContextMenu(globalPos, id);
     });
+    return row;
 }
 
-void ModelNavigator::addItem(ItemCollection& collection, const QString& id) {
-    if (collection.items.empty() && collection.root->childCount() > 0) {
-        QTreeWidgetItem* firstChild = collection.root->child(0);
-        if (firstChild && !(firstChild->flags() & Qt::ItemIsSelectable)) {
-            delete firstChild;
-        }
+void ModelNavigator::bindRowWidget(QWidget* widget, const QModelIndex& index) {
+    if (m_model->rowKind(index) != NavigatorModel::RowKind::Item) {
+        return;
     }
+    auto* row = static_cast<ItemRow*>(widget);
+    const auto& theme = ThemeManager::instance().currentTheme();
+    const bool selected = m_treeView->selectionModel()->isSelected(index);
+    const bool visible = m_model->isItemVisible(index);
 
-    ++collection.counter;
-    auto* item = new QTreeWidgetItem(collection.root);
-    const QString displayName = collection.namePrefix.arg(collection.counter);
-    item->setText(0, QString());
-    item->setData(0, Qt::UserRole, id);
-    item->setFlags(item->flags() | Qt::ItemIsSelectable);
-    item->setSizeHint(0, QSize(0, 32));
-
-    ItemEntry entry;
-    entry.item = item;
-    entry.type = (collection.root == m_bodiesRoot) ? ItemType::Body : ItemType::Sketch;
-    entry.visible = true;
-
-    QWidget* widget = createItemWidget(entry, displayName, entry.type, entry.visible);
-    m_entries.push_back(entry);
-    ItemEntry& stored = m_entries.back();
-
-    m_treeWidget->setItemWidget(item, 0, widget);
-    collection.items[id.toStdString()] = item;
-    collection.root->setExpanded(true);
-
-    setupItemConnections(stored);
-    refreshItemWidget(stored);
-}
+    row->setProperty("nav-selected", selected);
+    row->style()->unpolish(row);
+    row->style()->polish(row);
 
-void ModelNavigator::removeItem(ItemCollection& collection, const QString& id) {
-    std::string stdId = id.toStdString();
-    auto it = collection.items.find(stdId);
-    if (it != collection.items.end()) {
-        QTreeWidgetItem* item = it->second;
-        auto entryIt = std::remove_if(m_entries.begin(), m_entries.end(), [item](const ItemEntry& entry) {
-            return entry.item == item;
-        });
-        m_entries.erase(entryIt, m_entries.end());
-
-        delete item;
-        collection.items.erase(it);
-    }
+    const QColor textColor = selected ? theme.navigator.itemSelectedText : theme.navigator.itemText;
+    row->textLabel->setText(index.data(Qt::DisplayRole).toString());
+    row->textLabel->setStyleSheet(QStringLiteral("color: %1;").arg(textColor.name(QColor::HexArgb)));
 
-    if (collection.items.empty()) {
-        createPlaceholder(collection.root, collection.placeholderText);
-    }
-}
+    const QColor iconColor = selected ? theme.navigator.itemSelectedText : theme.navigator.itemIcon;
+    const QString iconPath = (m_model->section(index) == NavigatorModel::Section::Bodies)
+        ? QStringLiteral(":/icons/ic_body.svg")
+        : QStringLiteral(":/icons/ic_sketch.svg");
+    row->iconLabel->setPixmap(tintIcon(iconPath, iconColor));
 
-void ModelNavigator::updateTheme() {
-    m_placeholderColor = ThemeManager::instance().currentTheme().navigator.placeholderText;
-    updatePlaceholderColors();
-    for (auto& entry : m_entries) {
-        refreshItemWidget(entry);
-    }
-}
+    const QString eyePath = visible ? QStringLiteral(":/icons/ic_eye_on.svg")
+                                    : QStringLiteral(":/icons/ic_eye_off.svg");
+    row->eyeButton->setIcon(QIcon(tintIcon(eyePath, iconColor)));
+    row->eyeButton->setToolTip(visible ? tr("Hide") : tr("Show"));
 
-void ModelNavigator::updatePlaceholderColors() {
-    applyPlaceholderColor(m_bodiesRoot);
-    applyPlaceholderColor(m_sketchesRoot);
+    row->overflowButton->setIcon(QIcon(tintIcon(QStringLiteral(":/icons/ic_overflow.svg"), iconColor)));
 }
 
-void ModelNavigator::applyPlaceholderColor(QTreeWidgetItem* item) {
-    if (!item) {
-        return;
-    }
-    for (int i = 0; i < item->childCount(); ++i) {
-        QTreeWidgetItem* child = item->child(i);
-        if (child && !(child->flags() & Qt::ItemIsSelectable)) {
-            child->setForeground(0, m_placeholderColor);
-        }
+ModelNavigator::ItemRow* ModelNavigator::rowWidgetForId(const QString& id) {
+    const QModelIndex index = m_model->indexForId(id);
+    if (!index.isValid()) {
+        return nullptr;
     }
+    return static_cast<ItemRow*>(m_rowWidgets->widgetFor(index));
 }
 
-void ModelNavigator::renameItem(ItemCollection& collection,
-                                const QString& id,
-                                const QString& newName) {
-    std::string stdId = id.toStdString();
-    auto it = collection.items.find(stdId);
-    if (it != collection.items.end()) {
-        if (ItemEntry* entry = entryForItem(it->second)) {
-            entry->textLabel->setText(newName);
-            refreshItemWidget(*entry);
-        }
-    }
+void ModelNavigator::updateTheme() {
+    // Placeholders read their color from the model; item rows re-tint
+    cancelInlineEdit();
+    m_rowWidgets->rebindAll();
+    m_treeView->viewport()->update();
 }
 
 void ModelNavigator::setCollapsed(bool collapsed) {
@@ -375,44 +303,19 @@ void ModelNavigator::applyCollapseState(bool animate) {
     m_widthAnimation->start();
 }
 
-ModelNavigator::ItemEntry* ModelNavigator::entryForItem(QTreeWidgetItem* item) {
-    for (auto& entry : m_entries) {
-        if (entry.item == item) {
-            return &entry;
-        }
-    }
-    return nullptr;
-}
-
-ModelNavigator::ItemEntry* ModelNavigator::entryForId(const std::string& id) {
-    auto bodyIt = m_bodyItems.find(id);
-    if (bodyIt != m_bodyItems.end()) {
-        return entryForItem(bodyIt->second);
-    }
-    auto sketchIt = m_sketchItems.find(id);
-    if (sketchIt != m_sketchItems.end()) {
-        return entryForItem(sketchIt->second);
-    }
-    return nullptr;
-}
-
-void ModelNavigator::updateSelectionState() {
-    for (auto& entry : m_entries) {
-        refreshItemWidget(entry);
-    }
-}
-
-void ModelNavigator::handleVisibilityToggle(ItemEntry& entry) {
-    entry.visible = !entry.visible;
-    refreshItemWidget(entry);
-    if (entry.item) {
-        emit visibilityToggled(entry.item->data(0, Qt::UserRole).toString(), entry.visible);
+void ModelNavigator::toggleVisibility(const QString& id) {
+    const QModelIndex index = m_model->indexForId(id);
+    if (!index.isValid()) {
+        return;
     }
+    const bool visible = !m_model->isItemVisible(index);
+    m_model->setItemVisible(m_model->section(index), id, visible);
+    emit visibilityToggled(id, visible);
 }
 
-void ModelNavigator::showContextMenu(const QPoint& pos, QTreeWidgetItem* item) {
-    ItemEntry* entry = entryForItem(item);
-    if (!entry) {
+void ModelNavigator::showContextMenu(const QPoint& pos, const QString& id) {
+    const QModelIndex index = m_model->indexForId(id);
+    if (!index.isValid()) {
         return;
     }
 
@@ -421,14 +324,13 @@ void ModelNavigator::showContextMenu(const QPoint& pos, QTreeWidgetItem* item) {
     QAction* isolateAction = menu.addAction(tr("Isolate"));
     QAction* deleteAction = menu.addAction(tr("Delete"));
     menu.addSeparator();
-    QAction* visibilityAction = menu.addAction(entry->visible ? tr("Hide") : tr("Show"));
+    QAction* visibilityAction = menu.addAction(m_model->isItemVisible(index) ? tr("Hide") : tr("Show"));
 
     QAction* chosen = menu.exec(pos);
     if (!chosen) {
         return;
     }
 
-    const QString id = item->data(0, Qt::UserRole).toString();
     if (chosen == renameAction) {
         emit renameRequested(id);
     } else if (chosen == isolateAction) {
@@ -436,31 +338,27 @@ void ModelNavigator::showContextMenu(const QPoint& pos, QTreeWidgetItem* item) {
     } else if (chosen == deleteAction) {
         emit deleteRequested(id);
     } else if (chosen == visibilityAction) {
-        handleVisibilityToggle(*entry);
+        toggleVisibility(id);
     }
 }
 
-void ModelNavigator::onItemClicked(QTreeWidgetItem* item, int column) {
-    Q_UNUSED(column);
-    if (item && item != m_bodiesRoot && item != m_sketchesRoot) {
-        QString itemId = item->data(0, Qt::UserRole).toString();
-        emit itemSelected(itemId);
+void ModelNavigator::onItemClicked(const QModelIndex& index) {
+    const QString itemId = m_model->itemId(index);
+    if (itemId.isEmpty()) {
+        return;
+    }
+    emit itemSelected(itemId);
 
-        std::string stdId = itemId.toStdString();
-        auto sketchIt = m_sketchItems.find(stdId);
-        if (sketchIt != m_sketchItems.end() && sketchIt->second == item) {
-            emit sketchSelected(itemId);
-        }
-        auto bodyIt = m_bodyItems.find(stdId);
-        if (bodyIt != m_bodyItems.end() && bodyIt->second == item) {
-            emit bodySelected(itemId);
-        }
+    if (m_model->section(index) == NavigatorModel::Section::Sketches) {
+        emit sketchSelected(itemId);
+    } else {
+        emit bodySelected(itemId);
     }
 }
 
 bool ModelNavigator::eventFilter(QObject* obj, QEvent* event) {
     // Handle inline editor escape key
-    if (obj == m_inlineEditor && event->type() == QEvent::KeyPress) {
+    if (m_inlineEditor && obj == m_inlineEditor.data() && event->type() == QEvent::KeyPress) {
         auto* keyEvent = static_cast<QKeyEvent*>(event);
         if (keyEvent->key() == Qt::Key_Escape) {
             cancelInlineEdit();
@@ -468,13 +366,13 @@ bool ModelNavigator::eventFilter(QObject* obj, QEvent* event) {
         }
     }
 
-    if (obj == m_treeWidget->viewport() && event->type() == QEvent::MouseButtonPress) {
+    if (obj == m_treeView->viewport() && event->type() == QEvent::MouseButtonPress) {
         auto* mouseEvent = static_cast<QMouseEvent*>(event);
         if (mouseEvent->button() == Qt::LeftButton) {
-            if (!m_treeWidget->itemAt(mouseEvent->pos())) {
-                if (!m_treeWidget->selectedItems().isEmpty()) {
-                    m_treeWidget->clearSelection();
-                    m_treeWidget->setCurrentItem(nullptr);
+            if (!m_treeView->indexAt(mouseEvent->pos()).isValid()) {
+                if (m_treeView->selectionModel()->hasSelection()) {
+                    m_treeView->clearSelection();
+                    m_treeView->setCurrentIndex(QModelIndex());
                 }
                 return true;
             }
@@ -484,133 +382,59 @@ bool ModelNavigator::eventFilter(QObject* obj, QEvent* event) {
     return QWidget::eventFilter(obj, event);
 }
 
-void ModelNavigator::onItemDoubleClicked(QTreeWidgetItem* item, int column) {
-    Q_UNUSED(column);
-    if (item && item != m_bodiesRoot && item != m_sketchesRoot) {
-        QString itemId = item->data(0, Qt::UserRole).toString();
-        emit itemDoubleClicked(itemId);
+void ModelNavigator::onItemDoubleClicked(const QModelIndex& index) {
+    const QString itemId = m_model->itemId(index);
+    if (itemId.isEmpty()) {
+        return;
+    }
+    emit itemDoubleClicked(itemId);
 
-        std::string stdId = itemId.toStdString();
-        auto it = m_sketchItems.find(stdId);
-        if (it != m_sketchItems.end() && it->second == item) {
-            emit editSketchRequested(itemId);
-        }
+    if (m_model->section(index) == NavigatorModel::Section::Sketches) {
+        emit editSketchRequested(itemId);
     }
 }
 
 void ModelNavigator::rebuild(const app::Document* doc) {
-    // Clear existing items
-    m_sketchItems.clear();
-    m_bodyItems.clear();
-    m_entries.clear();
-    
-    // Clear UI roots (delete children)
-    qDeleteAll(m_bodiesRoot->takeChildren());
-    qDeleteAll(m_sketchesRoot->takeChildren());
-    m_sketchesRoot->setExpanded(true);
-    m_bodiesRoot->setExpanded(true);
-    
-    createPlaceholderItems();
-    m_sketchCounter = 0;
-    m_bodyCounter = 0;
-    
-    if (!doc) {
-        return;
-    }
-    
-    // Add sketches
-    std::vector<std::string> sketchIds = doc->getSketchIds();
-    for (const auto& id : sketchIds) {
-        QString qId = QString::fromStdString(id);
-        
-        // Add item
-        ItemCollection collection{m_sketchItems, m_sketchCounter, m_sketchesRoot,
-                                  QStringLiteral("Sketch %1"), tr("(No sketches)")};
-        
-        addItem(collection, qId);
-        
-        // Update name from document
-        std::string name = doc->getSketchName(id);
-        renameItem(collection, qId, QString::fromStdString(name));
-        
-        // Update visibility
-        bool visible = doc->isSketchVisible(id);
-        onSketchVisibilityChanged(qId, visible);
-    }
-    
-    // Add bodies
-    std::vector<std::string> bodyIds = doc->getBodyIds();
-    for (const auto& id : bodyIds) {
-        QString qId = QString::fromStdString(id);
-        
-        ItemCollection collection{m_bodyItems, m_bodyCounter, m_bodiesRoot,
-                                  QStringLiteral("Body %1"), tr("(No bodies)")};
-        addItem(collection, qId);
-        
-        std::string name = doc->getBodyName(id);
-        renameItem(collection, qId, QString::fromStdString(name));
-        
-        bool visible = doc->isBodyVisible(id);
-        onBodyVisibilityChanged(qId, visible);
-    }
+    cancelInlineEdit();
+    m_model->reset(doc);
 }
 
 void ModelNavigator::onSketchAdded(const QString& id) {
-    ItemCollection collection{m_sketchItems, m_sketchCounter, m_sketchesRoot,
-                              QStringLiteral("Sketch %1"), tr("(No sketches)")};
-    addItem(collection, id);
+    m_model->addItem(NavigatorModel::Section::Sketches, id);
 }
 
 void ModelNavigator::onSketchRemoved(const QString& id) {
-    ItemCollection collection{m_sketchItems, m_sketchCounter, m_sketchesRoot,
-                              QStringLiteral("Sketch %1"), tr("(No sketches)")};
-    removeItem(collection, id);
+    if (id == m_editingItemId) {
+        cancelInlineEdit();
+    }
+    m_model->removeItem(NavigatorModel::Section::Sketches, id);
 }
 
 void ModelNavigator::onSketchRenamed(const QString& id, const QString& newName) {
-    ItemCollection collection{m_sketchItems, m_sketchCounter, m_sketchesRoot,
-                              QStringLiteral("Sketch %1"), tr("(No sketches)")};
-    renameItem(collection, id, newName);
+    m_model->renameItem(NavigatorModel::Section::Sketches, id, newName);
 }
 
 void ModelNavigator::onBodyAdded(const QString& id) {
-    ItemCollection collection{m_bodyItems, m_bodyCounter, m_bodiesRoot,
-                              QStringLiteral("Body %1"), tr("(No bodies)")};
-    addItem(collection, id);
+    m_model->addItem(NavigatorModel::Section::Bodies, id);
 }
 
 void ModelNavigator::onBodyRemoved(const QString& id) {
-    ItemCollection collection{m_bodyItems, m_bodyCounter, m_bodiesRoot,
-                              QStringLiteral("Body %1"), tr("(No bodies)")};
-    removeItem(collection, id);
+    if (id == m_editingItemId) {
+        cancelInlineEdit();
+    }
+    m_model->removeItem(NavigatorModel::Section::Bodies, id);
 }
 
 void ModelNavigator::onBodyRenamed(const QString& id, const QString& newName) {
-    ItemCollection collection{m_bodyItems, m_bodyCounter, m_bodiesRoot,
-                              QStringLiteral("Body %1"), tr("(No bodies)")};
-    renameItem(collection, id, newName);
+    m_model->renameItem(NavigatorModel::Section::Bodies, id, newName);
 }
 
 void ModelNavigator::onBodyVisibilityChanged(const QString& id, bool visible) {
-    std::string stdId = id.toStdString();
-    auto it = m_bodyItems.find(stdId);
-    if (it != m_bodyItems.end()) {
-        if (ItemEntry* entry = entryForItem(it->second)) {
-            entry->visible = visible;
-            refreshItemWidget(*entry);
-        }
-    }
+    m_model->setItemVisible(NavigatorModel::Section::Bodies, id, visible);
 }
 
 void ModelNavigator::onSketchVisibilityChanged(const QString& id, bool visible) {
-    std::string stdId = id.toStdString();
-    auto it = m_sketchItems.find(stdId);
-    if (it != m_sketchItems.end()) {
-        if (ItemEntry* entry = entryForItem(it->second)) {
-            entry->visible = visible;
-            refreshItemWidget(*entry);
-        }
-    }
+    m_model->setItemVisible(NavigatorModel::Section::Sketches, id, visible);
 }
 
 void ModelNavigator::startInlineEdit(const QString& itemId) {
@@ -619,22 +443,28 @@ void ModelNavigator::startInlineEdit(const QString& itemId) {
         cancelInlineEdit();
     }
 
-    std::string stdId = itemId.toStdString();
-    ItemEntry* entry = entryForId(stdId);
-    if (!entry || !entry->textLabel) {
+    const QModelIndex index = m_model->indexForId(itemId);
+    if (!index.isValid()) {
+        return;
+    }
+
+    // The row needs a widget to host the editor
+    m_treeView->scrollTo(index);
+    m_rowWidgets->syncNow();
+    ItemRow* row = rowWidgetForId(itemId);
+    if (!row) {
         return;
     }
 
-    m_editingEntry = entry;
     m_editingItemId = itemId;
 
     // Create inline editor positioned over the text label
-    m_inlineEditor = new QLineEdit(entry->widget);
-    m_inlineEditor->setText(entry->textLabel->text());
+    m_inlineEditor = new QLineEdit(row);
+    m_inlineEditor->setText(row->textLabel->text());
     m_inlineEditor->selectAll();
 
     // Position over text label
-    QRect labelRect = entry->textLabel->geometry();
+    QRect labelRect = row->textLabel->geometry();
     m_inlineEditor->setGeometry(labelRect);
 
     // Style to match
@@ -646,7 +476,7 @@ void ModelNavigator::startInlineEdit(const QString& itemId) {
         .arg(theme.navigator.itemSelectedBackground.name(QColor::HexArgb)));
 
     // Hide the text label
-    entry->textLabel->hide();
+    row->textLabel->hide();
 
     m_inlineEditor->show();
     m_inlineEditor->setFocus();
@@ -660,22 +490,16 @@ void ModelNavigator::startInlineEdit(const QString& itemId) {
 }
 
 void ModelNavigator::finishInlineEdit() {
-    if (!m_inlineEditor || !m_editingEntry) {
+    if (!m_inlineEditor) {
+        m_editingItemId.clear();
         return;
     }
 
     QString newName = m_inlineEditor->text().trimmed();
     QString itemId = m_editingItemId;
-    QString oldName = m_editingEntry->textLabel->text();
+    QString oldName = m_model->indexForId(itemId).data(Qt::DisplayRole).toString();
 
-    // Restore text label
-    m_editingEntry->textLabel->show();
-
-    // Clean up editor
-    m_inlineEditor->deleteLater();
-    m_inlineEditor = nullptr;
-    m_editingEntry = nullptr;
-    m_editingItemId.clear();
+    endInlineEdit();
 
     // Emit rename signal if name changed and not empty
     if (!newName.isEmpty() && newName != oldName) {
@@ -684,17 +508,22 @@ void ModelNavigator::finishInlineEdit() {
 }
 
 void ModelNavigator::cancelInlineEdit() {
-    if (!m_inlineEditor || !m_editingEntry) {
+    if (!m_inlineEditor) {
+        m_editingItemId.clear();
         return;
     }
+    endInlineEdit();
+}
 
+void ModelNavigator::endInlineEdit() {
     // Restore text label
-    m_editingEntry->textLabel->show();
+    if (ItemRow* row = rowWidgetForId(m_editingItemId)) {
+        row->textLabel->show();
+    }
 
     // Clean up editor
     m_inlineEditor->deleteLater();
     m_inlineEditor = nullptr;
-    m_editingEntry = nullptr;
     m_editingItemId.clear();
 }
 
@@ -2,15 +2,12 @@
 #define ONECAD_UI_NAVIGATOR_MODELNAVIGATOR_H
 
 #include <QMetaObject>
+#include <QPointer>
 #include <QWidget>
 #include <QString>
-#include <QColor>
-#include <vector>
-#include <unordered_map>
-#include <string>
 
-class QTreeWidget;
-class QTreeWidgetItem;
+class QTreeView;
+class QModelIndex;
 class QFrame;
 class QPropertyAnimation;
 class QLabel;
@@ -22,6 +19,9 @@ namespace onecad {
 namespace app { class Document; }
 namespace ui {
 
+class NavigatorModel;
+class VisibleRowWidgets;
+
 /**
  * @brief Model navigator showing document structure.
  * 
@@ -29,6 +29,10 @@ namespace ui {
  * - Bodies
  * - Sketches  
  * - Feature History (when parametric mode)
+ *
+ * Rows live in a NavigatorModel that is edited item by item; row widgets
+ * (icon, name, visibility and overflow buttons) exist only while the row
+ * is on screen.
  */
 class ModelNavigator : public QWidget {
     Q_OBJECT
@@ -70,80 +74,41 @@ public slots:
     void startInlineEdit(const QString& itemId);
 
 private slots:
-    void onItemClicked(QTreeWidgetItem* item, int column);
-    void onItemDoubleClicked(QTreeWidgetItem* item, int column);
+    void onItemClicked(const QModelIndex& index);
+    void onItemDoubleClicked(const QModelIndex& index);
 
 protected:
     bool eventFilter(QObject* obj, QEvent* event) override;
 
 private:
-    struct ItemCollection {
-        std::unordered_map<std::string, QTreeWidgetItem*>& items;
-        unsigned int& counter;
-        QTreeWidgetItem* root = nullptr;
-        QString namePrefix;
-        QString placeholderText;
-    };
-
-    enum class ItemType { Body, Sketch };
-
-    struct ItemEntry {
-        ItemType type;
-        QTreeWidgetItem* item;
-        QWidget* widget;
-        QLabel* iconLabel;
-        QLabel* textLabel;
-        QToolButton* eyeButton;
-        QToolButton* overflowButton;
-        bool visible;
-    };
+    class ItemRow;
 
     void setupUi();
-    void setupRoots();
-    void createPlaceholderItems();
-    void createPlaceholder(QTreeWidgetItem* root, const QString& text);
     QWidget* createSectionHeader(const QString& text);
-    QWidget* createItemWidget(ItemEntry& entry, const QString& text, ItemType type, bool visible);
-    void refreshItemWidget(ItemEntry& entry);
-    void setupItemConnections(ItemEntry& entry);
-    void updateSelectionState();
-    ItemEntry* entryForItem(QTreeWidgetItem* item);
-    ItemEntry* entryForId(const std::string& id);
-    void showContextMenu(const QPoint& pos, QTreeWidgetItem* item);
-    void handleVisibilityToggle(ItemEntry& entry);
+    QWidget* createRowWidget(const QModelIndex& index);
+    void bindRowWidget(QWidget* widget, const QModelIndex& index);
+    ItemRow* rowWidgetForId(const QString& id);
+    void showContextMenu(const QPoint& pos, const QString& id);
+    void toggleVisibility(const QString& id);
     void applyCollapseState(bool animate);
-    void addItem(ItemCollection& collection, const QString& id);
     void finishInlineEdit();
     void cancelInlineEdit();
-    void removeItem(ItemCollection& collection, const QString& id);
-    void renameItem(ItemCollection& collection, const QString& id, const QString& newName);
+    void endInlineEdit();
     void updateTheme();
-    void updatePlaceholderColors();
-    void applyPlaceholderColor(QTreeWidgetItem* item);
 
     QFrame* m_panel = nullptr;
-    QTreeWidget* m_treeWidget = nullptr;
-    QTreeWidgetItem* m_bodiesRoot = nullptr;
-    QTreeWidgetItem* m_sketchesRoot = nullptr;
-    std::vector<ItemEntry> m_entries;
+    QTreeView* m_treeView = nullptr;
+    NavigatorModel* m_model = nullptr;
+    VisibleRowWidgets* m_rowWidgets = nullptr;
     bool m_collapsed = false;
     QPropertyAnimation* m_widthAnimation = nullptr;
     int m_expandedWidth = 260;
     int m_collapsedWidth = 0;
-    QColor m_placeholderColor;
     QMetaObject::Connection m_themeConnection;
 
-    // Map sketch IDs to tree items
-    std::unordered_map<std::string, QTreeWidgetItem*> m_sketchItems;
-    std::unordered_map<std::string, QTreeWidgetItem*> m_bodyItems;
-
-    // Counter for unique sketch naming
-    unsigned int m_sketchCounter = 0;
-    unsigned int m_bodyCounter = 0;
-
-    // Inline editing state
-    QLineEdit* m_inlineEditor = nullptr;
-    ItemEntry* m_editingEntry = nullptr;
+    // Inline editing state; the editor lives inside the row widget and
+    // goes away with it if the row scrolls out of view
+    QPointer<QLineEdit> m_inlineEditor;
     QString m_editingItemId;
 };
 
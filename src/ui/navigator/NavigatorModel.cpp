@@ -0,0 +1,274 @@
+/**
+ * @file NavigatorModel.cpp
+ * @brief Implementation of the model navigator item model.
+ */
+#include "NavigatorModel.h"
+#include "../../app/document/Document.h"
+#include "../theme/ThemeManager.h"
+
+#include <QColor>
+#include <QSize>
+
+namespace onecad {
+namespace ui {
+
+namespace {
+constexpr int kRowHeight = 32;
+}
+
+NavigatorModel::NavigatorModel(QObject* parent)
+    : QAbstractItemModel(parent) {
+}
+
+void NavigatorModel::reset(const app::Document* doc) {
+    beginResetModel();
+    for (auto& section : m_sections) {
+        section = SectionData{};
+    }
+
+    if (doc) {
+        auto fill = [this](Section section, const std::vector<std::string>& ids,
+                           auto nameOf, auto visibleOf) {
+            SectionData& target = sectionData(section);
+            target.items.reserve(ids.size());
+            for (const auto& id : ids) {
+                ++target.counter;
+                target.rows[id] = static_cast<int>(target.items.size());
+                target.items.push_back(Item{QString::fromStdString(id),
+                                            QString::fromStdString(nameOf(id)),
+                                            visibleOf(id)});
+            }
+        };
+        fill(Section::Sketches, doc->getSketchIds(),
+             [doc](const std::string& id) { return doc->getSketchName(id); },
+             [doc](const std::string& id) { return doc->isSketchVisible(id); });
+        fill(Section::Bodies, doc->getBodyIds(),
+             [doc](const std::string& id) { return doc->getBodyName(id); },
+             [doc](const std::string& id) { return doc->isBodyVisible(id); });
+    }
+    for (auto& section : m_sections) {
+        section.placeholder = section.items.empty();
+    }
+    endResetModel();
+}
+
+void NavigatorModel::addItem(Section section, const QString& id, const QString& name, bool visible) {
+    SectionData& target = sectionData(section);
+    if (target.rows.count(id.toStdString()) > 0) {
+        return;
+    }
+
+    ++target.counter;
+    QString displayName = name;
+    if (displayName.isEmpty()) {
+        displayName = (section == Section::Bodies ? QStringLiteral("Body %1")
+                                                  : QStringLiteral("Sketch %1"))
+                          .arg(target.counter);
+    }
+    appendItem(section, Item{id, displayName, visible});
+}
+
+void NavigatorModel::appendItem(Section section, Item item) {
+    SectionData& target = sectionData(section);
+    const QModelIndex parentIndex = sectionIndex(section);
+
+    if (target.placeholder) {
+        beginRemoveRows(parentIndex, 0, 0);
+        target.placeholder = false;
+        endRemoveRows();
+    }
+
+    const int row = static_cast<int>(target.items.size());
+    beginInsertRows(parentIndex, row, row);
+    target.rows[item.id.toStdString()] = row;
+    target.items.push_back(std::move(item));
+    endInsertRows();
+}
+
+void NavigatorModel::removeItem(Section section, const QString& id) {
+    const int row = rowOf(section, id);
+    if (row < 0) {
+        return;
+    }
+    SectionData& target = sectionData(section);
+    const QModelIndex parentIndex = sectionIndex(section);
+
+    beginRemoveRows(parentIndex, row, row);
+    target.rows.erase(id.toStdString());
+    target.items.erase(target.items.begin() + row);
+    for (int i = row; i < static_cast<int>(target.items.size()); ++i) {
+        target.rows[target.items[i].id.toStdString()] = i;
+    }
+    endRemoveRows();
+
+    if (target.items.empty()) {
+        beginInsertRows(parentIndex, 0, 0);
+        target.placeholder = true;
+        endInsertRows();
+    }
+}
+
+void NavigatorModel::renameItem(Section section, const QString& id, const QString& name) {
+    const int row = rowOf(section, id);
+    if (row < 0) {
+        return;
+    }
+    sectionData(section).items[row].name = name;
+    const QModelIndex changed = index(row, 0, sectionIndex(section));
+    emit dataChanged(changed, changed, {Qt::DisplayRole});
+}
+
+void NavigatorModel::setItemVisible(Section section, const QString& id, bool visible) {
+    const int row = rowOf(section, id);
+    if (row < 0) {
+        return;
+    }
+    Item& item = sectionData(section).items[row];
+    if (item.visible == visible) {
+        return;
+    }
+    item.visible = visible;
+    const QModelIndex changed = index(row, 0, sectionIndex(section));
+    emit dataChanged(changed, changed, {VisibleRole});
+}
+
+QModelIndex NavigatorModel::indexForId(const QString& id) const {
+    for (Section section : {Section::Bodies, Section::Sketches}) {
+        const int row = rowOf(section, id);
+        if (row >= 0) {
+            return index(row, 0, sectionIndex(section));
+        }
+    }
+    return {};
+}
+
+QModelIndex NavigatorModel::sectionIndex(Section section) const {
+    return createIndex(static_cast<int>(section), 0, kSectionRow);
+}
+
+NavigatorModel::RowKind NavigatorModel::rowKind(const QModelIndex& index) const {
+    if (!index.isValid() || index.internalId() == kSectionRow) {
+        return RowKind::Section;
+    }
+    return sectionData(section(index)).placeholder ? RowKind::Placeholder : RowKind::Item;
+}
+
+NavigatorModel::Section NavigatorModel::section(const QModelIndex& index) const {
+    if (index.isValid() && index.internalId() != kSectionRow) {
+        return static_cast<Section>(index.internalId() - 1);
+    }
+    return index.row() == static_cast<int>(Section::Sketches) ? Section::Sketches : Section::Bodies;
+}
+
+QString NavigatorModel::itemId(const QModelIndex& index) const {
+    if (rowKind(index) != RowKind::Item) {
+        return {};
+    }
+    return sectionData(section(index)).items[index.row()].id;
+}
+
+bool NavigatorModel::isItemVisible(const QModelIndex& index) const {
+    if (rowKind(index) != RowKind::Item) {
+        return false;
+    }
+    return sectionData(section(index)).items[index.row()].visible;
+}
+
+int NavigatorModel::itemCount(Section section) const {
+    return static_cast<int>(sectionData(section).items.size());
+}
+
+int NavigatorModel::rowOf(Section section, const QString& id) const {
+    const SectionData& target = sectionData(section);
+    auto it = target.rows.find(id.toStdString());
+    return it != target.rows.end() ? it->second : -1;
+}
+
+QModelIndex NavigatorModel::index(int row, int column, const QModelIndex& parent) const {
+    if (column != 0 || row < 0 || row >= rowCount(parent)) {
+        return {};
+    }
+    if (!parent.isValid()) {
+        return createIndex(row, 0, kSectionRow);
+    }
+    return createIndex(row, 0, childTag(section(parent)));
+}
+
+QModelIndex NavigatorModel::parent(const QModelIndex& child) const {
+    if (!child.isValid() || child.internalId() == kSectionRow) {
+        return {};
+    }
+    return sectionIndex(section(child));
+}
+
+int NavigatorModel::rowCount(const QModelIndex& parent) const {
+    if (!parent.isValid()) {
+        return static_cast<int>(m_sections.size());
+    }
+    if (parent.column() > 0 || parent.internalId() != kSectionRow) {
+        return 0;
+    }
+    const SectionData& target = sectionData(section(parent));
+    return static_cast<int>(target.items.size()) + (target.placeholder ? 1 : 0);
+}
+
+int NavigatorModel::columnCount(const QModelIndex&) const {
+    return 1;
+}
+
+QVariant NavigatorModel::data(const QModelIndex& index, int role) const {
+    if (!index.isValid()) {
+        return {};
+    }
+    const RowKind kind = rowKind(index);
+    const Section itemSection = section(index);
+    if (role == KindRole) {
+        return static_cast<int>(kind);
+    }
+    if (role == SectionRole) {
+        return static_cast<int>(itemSection);
+    }
+
+    switch (kind) {
+        case RowKind::Section:
+            if (role == Qt::DisplayRole) {
+                return itemSection == Section::Bodies ? tr("Bodies") : tr("Sketches");
+            }
+            return {};
+        case RowKind::Placeholder:
+            if (role == Qt::DisplayRole) {
+                return itemSection == Section::Bodies ? tr("(No bodies)") : tr("(No sketches)");
+            }
+            if (role == Qt::ForegroundRole) {
+                return ThemeManager::instance().currentTheme().navigator.placeholderText;
+            }
+            if (role == Qt::SizeHintRole) {
+                return QSize(0, kRowHeight);
+            }
+            return {};
+        case RowKind::Item:
+            break;
+    }
+
+    const Item& item = sectionData(itemSection).items[index.row()];
+    switch (role) {
+        case Qt::DisplayRole: return item.name;
+        case IdRole: return item.id;
+        case VisibleRole: return item.visible;
+        case Qt::SizeHintRole: return QSize(0, kRowHeight);
+        default: return {};
+    }
+}
+
+Qt::ItemFlags NavigatorModel::flags(const QModelIndex& index) const {
+    if (!index.isValid()) {
+        return Qt::NoItemFlags;
+    }
+    if (rowKind(index) == RowKind::Item) {
+        return Qt::ItemIsEnabled | Qt::ItemIsSelectable;
+    }
+    return Qt::ItemIsEnabled;
+}
+
+} // namespace ui
+} // namespace onecad
@@ -0,0 +1,98 @@
+/**
+ * @file NavigatorModel.h
+ * @brief Item model behind the model navigator tree.
+ */
+#ifndef ONECAD_UI_NAVIGATOR_NAVIGATORMODEL_H
+#define ONECAD_UI_NAVIGATOR_NAVIGATORMODEL_H
+
+#include <QAbstractItemModel>
+#include <QString>
+#include <array>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace onecad {
+namespace app { class Document; }
+namespace ui {
+
+/**
+ * @brief Two fixed sections (Bodies, Sketches) holding one row per item.
+ *
+ * A section without items shows a single placeholder row. Items are
+ * added, removed, renamed and shown/hidden row by row, so the cost of an
+ * edit does not grow with the number of items in the document.
+ */
+class NavigatorModel : public QAbstractItemModel {
+    Q_OBJECT
+
+public:
+    enum class Section { Bodies = 0, Sketches = 1 };
+    enum class RowKind { Section, Item, Placeholder };
+
+    enum Role {
+        IdRole = Qt::UserRole,  ///< Item id (QString), matches the old item data
+        KindRole,               ///< RowKind as int
+        SectionRole,            ///< Section as int
+        VisibleRole
+    };
+
+    explicit NavigatorModel(QObject* parent = nullptr);
+
+    /**
+     * @brief Replace all items with the document's sketches and bodies
+     */
+    void reset(const app::Document* doc);
+
+    /**
+     * @brief Append an item; an empty name falls back to "Body N"/"Sketch N"
+     */
+    void addItem(Section section, const QString& id, const QString& name = {}, bool visible = true);
+    void removeItem(Section section, const QString& id);
+    void renameItem(Section section, const QString& id, const QString& name);
+    void setItemVisible(Section section, const QString& id, bool visible);
+
+    QModelIndex indexForId(const QString& id) const;
+    QModelIndex sectionIndex(Section section) const;
+    RowKind rowKind(const QModelIndex& index) const;
+    Section section(const QModelIndex& index) const;
+    QString itemId(const QModelIndex& index) const;
+    bool isItemVisible(const QModelIndex& index) const;
+    int itemCount(Section section) const;
+
+    QModelIndex index(int row, int column, const QModelIndex& parent = {}) const override;
+    QModelIndex parent(const QModelIndex& child) const override;
+    int rowCount(const QModelIndex& parent = {}) const override;
+    int columnCount(const QModelIndex& parent = {}) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    Qt::ItemFlags flags(const QModelIndex& index) const override;
+
+private:
+    struct Item {
+        QString id;
+        QString name;
+        bool visible = true;
+    };
+
+    struct SectionData {
+        std::vector<Item> items;
+        std::unordered_map<std::string, int> rows;  ///< id -> row, kept current on edits
+        unsigned int counter = 0;                   ///< Default-name numbering
+        bool placeholder = true;                    ///< Showing the "(No ...)" row
+    };
+
+    static constexpr quintptr kSectionRow = 0;
+    static quintptr childTag(Section section) { return static_cast<quintptr>(section) + 1; }
+
+    SectionData& sectionData(Section section) { return m_sections[static_cast<size_t>(section)]; }
+    const SectionData& sectionData(Section section) const { return m_sections[static_cast<size_t>(section)]; }
+    int rowOf(Section section, const QString& id) const;
+    void appendItem(Section section, Item item);
+
+    std::array<SectionData, 2> m_sections;
+};
+
+} // namespace ui
+} // namespace onecad
+
+#endif // ONECAD_UI_NAVIGATOR_NAVIGATORMODEL_H
@@ -1,5 +1,6 @@
 #include "ModelPickerAdapter.h"
-
+#include "../../core/memory/MemoryEstimate.h"
+#include "../../core/trace/Trace.h"
 #include <algorithm>
 #include <cmath>
 #include <limits>
@@ -82,136 +83,215 @@ void ModelPickerAdapter::setMeshes(std::vector<Mesh>&& meshes) {
     meshes_.reserve(meshes.size());
 
     for (auto& mesh : meshes) {
-        MeshCache cache;
-        cache.bodyId = mesh.bodyId;
-        cache.vertices = std::move(mesh.vertices);
-        cache.triangles = std::move(mesh.triangles);
+        meshes_.push_back(buildCache(std::move(mesh)));
+    }
+}
+
+void ModelPickerAdapter::setMesh(Mesh&& mesh) {
+    auto it = std::find_if(meshes_.begin(), meshes_.end(),
+                           [&](const MeshCache& cache) { return cache.bodyId == mesh.bodyId; });
+    if (it != meshes_.end()) {
+        *it = buildCache(std::move(mesh));
+    } else {
+        meshes_.push_back(buildCache(std::move(mesh)));
+    }
+}
+
+void ModelPickerAdapter::removeMesh(const std::string& bodyId) {
+    meshes_.erase(std::remove_if(meshes_.begin(), meshes_.end(),
+                                 [&](const MeshCache& cache) { return cache.bodyId == bodyId; }),
+                  meshes_.end());
+}
+
+bool ModelPickerAdapter::hasMesh(const std::string& bodyId) const {
+    return std::any_of(meshes_.begin(), meshes_.end(),
+                       [&](const MeshCache& cache) { return cache.bodyId == bodyId; });
+}
+
+std::unordered_map<std::string, std::size_t> ModelPickerAdapter::memoryBytesByBody() const {
+    using core::memory::stringBytes;
+    using core::memory::stringMapBytes;
+    using core::memory::vectorBytes;
+
+    auto stringsBytes = [](const std::vector<std::string>& values) {
+        std::size_t bytes = vectorBytes(values);
+        for (const auto& value : values) {
+            bytes += stringBytes(value);
+        }
+        return bytes;
+    };
+
+    std::unordered_map<std::string, std::size_t> result;
+    for (const MeshCache& cache : meshes_) {
+        std::size_t bytes = sizeof(MeshCache) + stringBytes(cache.bodyId);
+        bytes += vectorBytes(cache.vertices);
+        bytes += vectorBytes(cache.triangles);
+        for (const auto& triangle : cache.triangles) {
+            bytes += stringBytes(triangle.faceId);
+        }
+        bytes += stringMapBytes(cache.vertexMap);
+        bytes += core::memory::stringSetBytes(cache.pickableVertices);
+        bytes += stringMapBytes(cache.edgePolylines);
+        for (const auto& [id, points] : cache.edgePolylines) {
+            (void)id;
+            bytes += vectorBytes(points);
+        }
+        bytes += stringMapBytes(cache.faceMap);
+        for (const auto& [id, triangles] : cache.faceMap) {
+            (void)id;
+            bytes += vectorBytes(triangles);
+        }
+        bytes += stringMapBytes(cache.faceGroupLeaderByFaceId);
+        for (const auto& [id, leader] : cache.faceGroupLeaderByFaceId) {
+            (void)id;
+            bytes += stringBytes(leader);
+        }
+        bytes += stringMapBytes(cache.faceGroupMembers);
+        for (const auto& [id, members] : cache.faceGroupMembers) {
+            (void)id;
+            bytes += stringsBytes(members);
+        }
+        bytes += stringMapBytes(cache.faceTopology);
+        for (const auto& [id, topology] : cache.faceTopology) {
+            (void)id;
+            bytes += stringsBytes(topology.edgeIds) + stringsBytes(topology.vertexIds);
+        }
+        result[cache.bodyId] += bytes;
+    }
+    return result;
+}
+
+ModelPickerAdapter::MeshCache ModelPickerAdapter::buildCache(Mesh&& mesh) {
+    MeshCache cache;
+    cache.bodyId = mesh.bodyId;
+    cache.vertices = std::move(mesh.vertices);
+    cache.triangles = std::move(mesh.triangles);
+
+    for (const auto& tri : cache.triangles) {
+        if (tri.i0 >= cache.vertices.size() ||
+            tri.i1 >= cache.vertices.size() ||
+            tri.i2 >= cache.vertices.size()) {
+            continue;
+        }
+        std::array<QVector3D, 3> triVerts = {
+            cache.vertices[tri.i0],
+            cache.vertices[tri.i1],
+            cache.vertices[tri.i2]
+        };
+        cache.faceMap[tri.faceId].push_back(triVerts);
+    }
+
+    if (!mesh.topologyByFace.empty()) {
+        for (const auto& [faceId, topo] : mesh.topologyByFace) {
+            MeshCache::FaceTopologyCache faceCache;
+
+            for (const auto& edge : topo.edges) {
+                if (edge.points.size() < 2) {
+                    continue;
+                }
+                if (cache.edgePolylines.find(edge.edgeId) == cache.edgePolylines.end()) {
+                    cache.edgePolylines[edge.edgeId] = edge.points;
+                }
+                faceCache.edgeIds.push_back(edge.edgeId);
+            }
+
+            for (const auto& vertex : topo.vertices) {
+                if (cache.vertexMap.find(vertex.vertexId) == cache.vertexMap.end()) {
+                    cache.vertexMap[vertex.vertexId] = vertex.position;
+                }
+                cache.pickableVertices.insert(vertex.vertexId);
+                faceCache.vertexIds.push_back(vertex.vertexId);
+            }
 
+            cache.faceTopology[faceId] = std::move(faceCache);
+        }
+    } else {
+        std::unordered_map<std::string, std::unordered_map<std::string, int>> edgeCountsByFace;
         for (const auto& tri : cache.triangles) {
             if (tri.i0 >= cache.vertices.size() ||
                 tri.i1 >= cache.vertices.size() ||
                 tri.i2 >= cache.vertices.size()) {
                 continue;
             }
-            std::array<QVector3D, 3> triVerts = {
-                cache.vertices[tri.i0],
-                cache.vertices[tri.i1],
-                cache.vertices[tri.i2]
-            };
-            cache.faceMap[tri.faceId].push_back(triVerts);
+            std::array<std::pair<std::uint32_t, std::uint32_t>, 3> edges = {{
+                {tri.i0, tri.i1},
+                {tri.i1, tri.i2},
+                {tri.i2, tri.i0}
+            }};
+            for (const auto& edge : edges) {
+                std::string edgeId = edgeIdForIndices(edge.first, edge.second);
+                edgeCountsByFace[tri.faceId][edgeId]++;
+            }
         }
 
-        if (!mesh.topologyByFace.empty()) {
-            for (const auto& [faceId, topo] : mesh.topologyByFace) {
-                MeshCache::FaceTopologyCache faceCache;
-
-                for (const auto& edge : topo.edges) {
-                    if (edge.points.size() < 2) {
-                        continue;
-                    }
-                    if (cache.edgePolylines.find(edge.edgeId) == cache.edgePolylines.end()) {
-                        cache.edgePolylines[edge.edgeId] = edge.points;
-                    }
-                    faceCache.edgeIds.push_back(edge.edgeId);
+        for (const auto& [faceId, edges] : edgeCountsByFace) {
+            MeshCache::FaceTopologyCache faceCache;
+            std::unordered_set<std::string> addedVertices;
+            for (const auto& [edgeId, count] : edges) {
+                if (count != 1) {
+                    continue;
                 }
-
-                for (const auto& vertex : topo.vertices) {
-                    if (cache.vertexMap.find(vertex.vertexId) == cache.vertexMap.end()) {
-                        cache.vertexMap[vertex.vertexId] = vertex.position;
-                    }
-                    cache.pickableVertices.insert(vertex.vertexId);
-                    faceCache.vertexIds.push_back(vertex.vertexId);
+                size_t underscore = edgeId.find('_');
+                if (underscore == std::string::npos) {
+                    continue;
                 }
-
-                cache.faceTopology[faceId] = std::move(faceCache);
-            }
-        } else {
-            std::unordered_map<std::string, std::unordered_map<std::string, int>> edgeCountsByFace;
-            for (const auto& tri : cache.triangles) {
-                if (tri.i0 >= cache.vertices.size() ||
-                    tri.i1 >= cache.vertices.size() ||
-                    tri.i2 >= cache.vertices.size()) {
+                std::uint32_t a = static_cast<std::uint32_t>(
+                    std::stoul(edgeId.substr(1, underscore - 1)));
+                std::uint32_t b = static_cast<std::uint32_t>(
+                    std::stoul(edgeId.substr(underscore + 1)));
+                if (static_cast<size_t>(a) >= cache.vertices.size() ||
+                    static_cast<size_t>(b) >= cache.vertices.size()) {
                     continue;
                 }
-                std::array<std::pair<std::uint32_t, std::uint32_t>, 3> edges = {{
-                    {tri.i0, tri.i1},
-                    {tri.i1, tri.i2},
-                    {tri.i2, tri.i0}
-                }};
-                for (const auto& edge : edges) {
-                    std::string edgeId = edgeIdForIndices(edge.first, edge.second);
-                    edgeCountsByFace[tri.faceId][edgeId]++;
+                std::vector<QVector3D> polyline = {cache.vertices[a], cache.vertices[b]};
+                if (cache.edgePolylines.find(edgeId) == cache.edgePolylines.end()) {
+                    cache.edgePolylines[edgeId] = polyline;
                 }
-            }
-
-            for (const auto& [faceId, edges] : edgeCountsByFace) {
-                MeshCache::FaceTopologyCache faceCache;
-                std::unordered_set<std::string> addedVertices;
-                for (const auto& [edgeId, count] : edges) {
-                    if (count != 1) {
-                        continue;
-                    }
-                    size_t underscore = edgeId.find('_');
-                    if (underscore == std::string::npos) {
-                        continue;
-                    }
-                    std::uint32_t a = static_cast<std::uint32_t>(
-                        std::stoul(edgeId.substr(1, underscore - 1)));
-                    std::uint32_t b = static_cast<std::uint32_t>(
-                        std::stoul(edgeId.substr(underscore + 1)));
-                    if (static_cast<size_t>(a) >= cache.vertices.size() ||
-                        static_cast<size_t>(b) >= cache.vertices.size()) {
-                        continue;
-                    }
-                    std::vector<QVector3D> polyline = {cache.vertices[a], cache.vertices[b]};
-                    if (cache.edgePolylines.find(edgeId) == cache.edgePolylines.end()) {
-                        cache.edgePolylines[edgeId] = polyline;
-                    }
-                    faceCache.edgeIds.push_back(edgeId);
-
-                    std::string vA = vertexIdForIndex(a);
-                    std::string vB = vertexIdForIndex(b);
-                    cache.vertexMap[vA] = cache.vertices[a];
-                    cache.vertexMap[vB] = cache.vertices[b];
-                    cache.pickableVertices.insert(vA);
-                    cache.pickableVertices.insert(vB);
-                    if (addedVertices.insert(vA).second) {
-                        faceCache.vertexIds.push_back(vA);
-                    }
-                    if (addedVertices.insert(vB).second) {
-                        faceCache.vertexIds.push_back(vB);
-                    }
+                faceCache.edgeIds.push_back(edgeId);
+
+                std::string vA = vertexIdForIndex(a);
+                std::string vB = vertexIdForIndex(b);
+                cache.vertexMap[vA] = cache.vertices[a];
+                cache.vertexMap[vB] = cache.vertices[b];
+                cache.pickableVertices.insert(vA);
+                cache.pickableVertices.insert(vB);
+                if (addedVertices.insert(vA).second) {
+                    faceCache.vertexIds.push_back(vA);
+                }
+                if (addedVertices.insert(vB).second) {
+                    faceCache.vertexIds.push_back(vB);
                 }
-                cache.faceTopology[faceId] = std::move(faceCache);
             }
+            cache.faceTopology[faceId] = std::move(faceCache);
         }
+    }
 
-        cache.faceGroupLeaderByFaceId = std::move(mesh.faceGroupByFaceId);
-        if (cache.faceGroupLeaderByFaceId.empty()) {
-            for (const auto& [faceId, tris] : cache.faceMap) {
-                (void)tris;
+    cache.faceGroupLeaderByFaceId = std::move(mesh.faceGroupByFaceId);
+    if (cache.faceGroupLeaderByFaceId.empty()) {
+        for (const auto& [faceId, tris] : cache.faceMap) {
+            (void)tris;
+            cache.faceGroupLeaderByFaceId[faceId] = faceId;
+        }
+    } else {
+        for (const auto& [faceId, tris] : cache.faceMap) {
+            (void)tris;
+            if (cache.faceGroupLeaderByFaceId.find(faceId) == cache.faceGroupLeaderByFaceId.end()) {
                 cache.faceGroupLeaderByFaceId[faceId] = faceId;
             }
-        } else {
-            for (const auto& [faceId, tris] : cache.faceMap) {
-                (void)tris;
-                if (cache.faceGroupLeaderByFaceId.find(faceId) == cache.faceGroupLeaderByFaceId.end()) {
-                    cache.faceGroupLeaderByFaceId[faceId] = faceId;
-                }
-            }
         }
-        for (const auto& [faceId, leaderId] : cache.faceGroupLeaderByFaceId) {
-            cache.faceGroupMembers[leaderId].push_back(faceId);
-        }
-
-        meshes_.push_back(std::move(cache));
     }
+    for (const auto& [faceId, leaderId] : cache.faceGroupLeaderByFaceId) {
+        cache.faceGroupMembers[leaderId].push_back(faceId);
+    }
+
+    return cache;
 }
 
 app::selection::PickResult ModelPickerAdapter::pick(const QPoint& screenPos,
                                                     double tolerancePixels,
                                                     const QMatrix4x4& viewProjection,
                                                     const QSize& viewportSize) const {
+    ONECAD_TRACE_SCOPE("picking", "modelPick");
     app::selection::PickResult result;
     if (meshes_.empty()) {
         return result;
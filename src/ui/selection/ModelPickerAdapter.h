@@ -54,6 +54,16 @@ public:
     };
 
     void setMeshes(std::vector<Mesh>&& meshes);
+    /**
+     * @brief Add or replace the mesh of one body, leaving the others untouched
+     */
+    void setMesh(Mesh&& mesh);
+    void removeMesh(const std::string& bodyId);
+    bool hasMesh(const std::string& bodyId) const;
+    /**
+     * @brief Approximate heap bytes of the pick caches, per body id
+     */
+    std::unordered_map<std::string, std::size_t> memoryBytesByBody() const;
 
     app::selection::PickResult pick(const QPoint& screenPos,
                                     double tolerancePixels,
@@ -99,6 +109,7 @@ private:
         std::vector<Triangle> triangles;
     };
 
+    static MeshCache buildCache(Mesh&& mesh);
     Ray buildRay(const QPoint& screenPos,
                  const QMatrix4x4& viewProjection,
                  const QSize& viewportSize) const;
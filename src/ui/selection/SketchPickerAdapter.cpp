@@ -3,6 +3,7 @@
 #include "../../core/sketch/Sketch.h"
 #include "../../core/sketch/SketchRenderer.h"
 #include "../../core/sketch/SketchTypes.h"
+#include "../../core/trace/Trace.h"
 
 namespace onecad::ui::selection {
 
@@ -51,7 +52,7 @@ PickResult SketchPickerAdapter::pick(const core::sketch::SketchRenderer& rendere
                                      double pixelScale,
                                      double tolerancePixels,
                                      Options options) const {
-    (void)sketch;
+    ONECAD_TRACE_SCOPE("picking", "sketchPick");
     PickResult result;
     const double pixelScaleSafe = (pixelScale > 0.0) ? pixelScale : 1.0;
     double toleranceWorld = tolerancePixels * pixelScaleSafe;
@@ -73,7 +74,10 @@ PickResult SketchPickerAdapter::pick(const core::sketch::SketchRenderer& rendere
         }
     }
 
-    auto hits = renderer.pickEntities(sketchPos, toleranceWorld);
+    // Broad-phase through the sketch R-tree; only nearby entities get the
+    // exact polyline distance test.
+    auto candidates = sketch.spatialIndex().queryRadius(sketchPos, toleranceWorld);
+    auto hits = renderer.pickEntities(sketchPos, toleranceWorld, candidates);
     for (const auto& hit : hits) {
         SelectionItem item;
         item.kind = kindForSketchEntity(hit.type);
@@ -181,31 +181,31 @@ QString ThemeManager::buildStyleSheet(const ThemeDefinition& theme) {
             background-color: @navigator-bg@;
             border: 1px solid @navigator-divider@;
         }
-        QTreeWidget#NavigatorTree {
+        QTreeView#NavigatorTree {
             background-color: transparent;
             color: @navigator-item-text@;
             border: none;
             outline: 0;
             padding: 0px 3px;
         }
-        QTreeWidget#NavigatorTree::item {
+        QTreeView#NavigatorTree::item {
             margin: 3px 0px;
             padding: 0px;
             height: 32px;
         }
-        QTreeWidget#NavigatorTree::item:selected,
-        QTreeWidget#NavigatorTree::item:hover,
-        QTreeWidget#NavigatorTree::branch:selected,
-        QTreeWidget#NavigatorTree::branch:hover {
+        QTreeView#NavigatorTree::item:selected,
+        QTreeView#NavigatorTree::item:hover,
+        QTreeView#NavigatorTree::branch:selected,
+        QTreeView#NavigatorTree::branch:hover {
             background: transparent;
             color: @navigator-item-text@;
         }
-        QTreeWidget#NavigatorTree::branch,
-        QTreeWidget#NavigatorTree::branch:has-children,
-        QTreeWidget#NavigatorTree::branch:closed,
-        QTreeWidget#NavigatorTree::branch:open,
-        QTreeWidget#NavigatorTree::branch:has-children:!has-siblings:adjoins-item,
-        QTreeWidget#NavigatorTree::branch:!has-children:!has-siblings:adjoins-item {
+        QTreeView#NavigatorTree::branch,
+        QTreeView#NavigatorTree::branch:has-children,
+        QTreeView#NavigatorTree::branch:closed,
+        QTreeView#NavigatorTree::branch:open,
+        QTreeView#NavigatorTree::branch:has-children:!has-siblings:adjoins-item,
+        QTreeView#NavigatorTree::branch:!has-children:!has-siblings:adjoins-item {
             background: transparent;
         }
         QWidget[nav-item="true"] {
@@ -312,14 +312,14 @@ QString ThemeManager::buildStyleSheet(const ThemeDefinition& theme) {
             border-top-left-radius: 12px;
             border-top-right-radius: 12px;
         }
-        QTreeWidget {
+        QTreeView {
             background-color: @tree-bg@;
             color: @tree-text@;
         }
-        QTreeWidget::item:hover {
+        QTreeView::item:hover {
             background-color: @tree-hover-bg@;
         }
-        QTreeWidget::item:selected {
+        QTreeView::item:selected {
             background-color: @tree-selected-bg@;
             color: @tree-selected-text@;
         }
@@ -6,6 +6,7 @@
 #include <QDoubleSpinBox>
 #include <QGridLayout>
 #include <QGroupBox>
+#include <QHBoxLayout>
 #include <QLabel>
 #include <QPushButton>
 #include <QSignalBlocker>
@@ -144,6 +145,30 @@ void RenderDebugPanel::setupUi() {
     gradientLayout->addWidget(m_gradientDirZ, 1, 3);
     layout->addWidget(gradientGroup);
 
+    auto* memoryGroup = new QGroupBox(tr("Memory"), this);
+    auto* memoryLayout = new QVBoxLayout(memoryGroup);
+    memoryLayout->setContentsMargins(6, 8, 6, 6);
+    memoryLayout->setSpacing(4);
+
+    m_memoryLabel = new QLabel(tr("Press Refresh to measure"), memoryGroup);
+    m_memoryLabel->setWordWrap(true);
+    m_memoryLabel->setTextInteractionFlags(Qt::TextSelectableByMouse);
+    memoryLayout->addWidget(m_memoryLabel);
+
+    auto* memoryButtons = new QHBoxLayout();
+    memoryButtons->setSpacing(6);
+    m_memoryRefreshButton = new QPushButton(tr("Refresh"), memoryGroup);
+    m_memoryDumpButton = new QPushButton(tr("Dump JSON..."), memoryGroup);
+    m_memoryRefreshButton->setFixedHeight(24);
+    m_memoryDumpButton->setFixedHeight(24);
+    memoryButtons->addWidget(m_memoryRefreshButton);
+    memoryButtons->addWidget(m_memoryDumpButton);
+    memoryLayout->addLayout(memoryButtons);
+    layout->addWidget(memoryGroup);
+
+    connect(m_memoryRefreshButton, &QPushButton::clicked, this, &RenderDebugPanel::memoryRefreshRequested);
+    connect(m_memoryDumpButton, &QPushButton::clicked, this, &RenderDebugPanel::memoryDumpRequested);
+
     m_resetButton = new QPushButton(tr("Reset To Theme"), this);
     m_resetButton->setFixedHeight(24);
     layout->addWidget(m_resetButton);
@@ -221,6 +246,10 @@ void RenderDebugPanel::setVector(QDoubleSpinBox* x, QDoubleSpinBox* y, QDoubleSp
     z->setValue(v.z());
 }
 
+void RenderDebugPanel::setMemorySummary(const QString& summary) {
+    m_memoryLabel->setText(summary);
+}
+
 RenderDebugPanel::DebugToggles RenderDebugPanel::debugToggles() const {
     DebugToggles toggles;
     toggles.normals = m_debugNormals->isChecked();
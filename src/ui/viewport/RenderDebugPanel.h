@@ -42,10 +42,17 @@ public:
     void setLightRig(const LightRig& rig);
     LightRig lightRig() const;
 
+    /**
+     * @brief Show the text of the last memory report (see MemoryReport::summary())
+     */
+    void setMemorySummary(const QString& summary);
+
 signals:
     void debugTogglesChanged();
     void lightRigChanged();
     void resetToThemeRequested();
+    void memoryRefreshRequested();
+    void memoryDumpRequested();
 
 private:
     void setupUi();
@@ -78,6 +85,9 @@ private:
     QDoubleSpinBox* m_gradientDirZ = nullptr;
     QDoubleSpinBox* m_gradientStrength = nullptr;
     QPushButton* m_resetButton = nullptr;
+    QLabel* m_memoryLabel = nullptr;
+    QPushButton* m_memoryRefreshButton = nullptr;
+    QPushButton* m_memoryDumpButton = nullptr;
 };
 
 } // namespace onecad::ui
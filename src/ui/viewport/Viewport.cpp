@@ -8,6 +8,8 @@
 #include "../../core/sketch/constraints/Constraints.h"
 #include "../../core/sketch/tools/SketchToolManager.h"
 #include "../../core/loop/RegionUtils.h"
+#include "../../core/trace/Trace.h"
+#include "../../app/diagnostics/MemoryReport.h"
 #include "../../app/document/Document.h"
 #include "../../app/selection/SelectionManager.h"
 #include "../../app/selection/SelectionTypes.h"
@@ -352,6 +354,49 @@ bool computePlaneBoundsXY(const QMatrix4x4& viewProjection, QRectF* outBounds) {
                         QPointF(maxPoint.x(), maxPoint.y())).normalized();
     return true;
 }
+
+// Pick mesh in world coordinates for a body mesh
+selection::ModelPickerAdapter::Mesh toPickMesh(const render::SceneMeshStore::Mesh& mesh) {
+    selection::ModelPickerAdapter::Mesh pickMesh;
+    pickMesh.bodyId = mesh.bodyId;
+    pickMesh.vertices.reserve(mesh.vertices.size());
+    for (const auto& v : mesh.vertices) {
+        QVector4D transformed = mesh.modelMatrix * QVector4D(v, 1.0f);
+        pickMesh.vertices.emplace_back(transformed.x(), transformed.y(), transformed.z());
+    }
+    pickMesh.triangles.reserve(mesh.triangles.size());
+    for (const auto& tri : mesh.triangles) {
+        selection::ModelPickerAdapter::Triangle pickTri;
+        pickTri.i0 = tri.i0;
+        pickTri.i1 = tri.i1;
+        pickTri.i2 = tri.i2;
+        pickTri.faceId = tri.faceId;
+        pickMesh.triangles.push_back(pickTri);
+    }
+    for (const auto& [faceId, topo] : mesh.topologyByFace) {
+        selection::ModelPickerAdapter::FaceTopology faceTopo;
+        for (const auto& edge : topo.edges) {
+            selection::ModelPickerAdapter::EdgePolyline edgeLine;
+            edgeLine.edgeId = edge.edgeId;
+            edgeLine.points.reserve(edge.points.size());
+            for (const auto& pt : edge.points) {
+                QVector4D transformed = mesh.modelMatrix * QVector4D(pt, 1.0f);
+                edgeLine.points.emplace_back(transformed.x(), transformed.y(), transformed.z());
+            }
+            faceTopo.edges.push_back(std::move(edgeLine));
+        }
+        for (const auto& vertex : topo.vertices) {
+            selection::ModelPickerAdapter::VertexSample sample;
+            sample.vertexId = vertex.vertexId;
+            QVector4D transformed = mesh.modelMatrix * QVector4D(vertex.position, 1.0f);
+            sample.position = QVector3D(transformed.x(), transformed.y(), transformed.z());
+            faceTopo.vertices.push_back(std::move(sample));
+        }
+        pickMesh.topologyByFace[faceId] = std::move(faceTopo);
+    }
+    pickMesh.faceGroupByFaceId = mesh.faceGroupByFaceId;
+    return pickMesh;
+}
 } // namespace
 
 Viewport::Viewport(QWidget* parent)
@@ -529,6 +574,7 @@ void Viewport::initializeGL() {
 
     m_bodyRenderer = std::make_unique<render::BodyRenderer>();
     m_bodyRenderer->initialize();
+    syncModelMeshes();  // Bodies added before the GL context existed
 
     // Create and initialize sketch renderer (requires OpenGL context)
     m_sketchRenderer = std::make_unique<sketch::SketchRenderer>();
@@ -583,6 +629,12 @@ void Viewport::resizeEvent(QResizeEvent* event) {
 }
 
 void Viewport::paintGL() {
+    ONECAD_TRACE_SCOPE("render", "paintGL");
+    // Apply body changes still waiting for the end of this event-loop iteration
+    if (m_document) {
+        m_document->flushChanges();
+    }
+
     // Ensure viewport is set correctly with correct device pixel ratio
     const qreal ratio = devicePixelRatio();
     glViewport(0, 0, static_cast<GLsizei>(m_width * ratio), static_cast<GLsizei>(m_height * ratio));
@@ -2012,6 +2064,8 @@ void Viewport::enterSketchMode(sketch::Sketch* sketch) {
     setRevolveToolActive(false);
 
     m_activeSketch = sketch;
+    // Loop cache counters cover one editing session (logged on exit)
+    m_activeSketch->resetLoopCacheStats();
     m_activeSketchId.clear();
     m_activeSketchId = resolveActiveSketchId();
     m_inSketchMode = true;
@@ -2121,6 +2175,7 @@ void Viewport::exitSketchMode() {
 
     if (m_activeSketch) {
         m_activeSketch->endPointDrag();
+        m_activeSketch->logLoopCacheStats("exitSketchMode");
     }
 
     m_inSketchMode = false;
@@ -3454,26 +3509,11 @@ void Viewport::setDocument(app::Document* document) {
             m_documentSketchesDirty = true;
             update();
         });
-        connect(m_document, &app::Document::bodyAdded, this, [this]() {
-            syncModelMeshes();
-            update();
-        });
-        connect(m_document, &app::Document::bodyRemoved, this, [this]() {
-            syncModelMeshes();
-            update();
-        });
-        connect(m_document, &app::Document::bodyUpdated, this, [this]() {
-            syncModelMeshes();
-            update();
-        });
-        connect(m_document, &app::Document::bodyVisibilityChanged, this, [this]() {
-            syncModelMeshes();
-            update();
-        });
-        connect(m_document, &app::Document::isolationChanged, this, [this]() {
-            syncModelMeshes();
-            update();
-        });
+        connect(m_document, &app::Document::changesCommitted, this,
+                [this](const app::DocumentChangeSet& changes) {
+                    applyDocumentChanges(changes);
+                    update();
+                });
         connect(m_document, &app::Document::documentCleared, this, [this]() {
             if (m_inSketchMode) {
                 exitSketchMode();
@@ -3487,7 +3527,6 @@ void Viewport::setDocument(app::Document* document) {
             clearModelPreviewMeshes();
             clearPreviewHiddenBody();
             updateModelSelectionFilter();
-            syncModelMeshes();
             update();
         });
     }
@@ -3562,6 +3601,27 @@ void Viewport::setModelPickMeshes(std::vector<selection::ModelPickerAdapter::Mes
     }
 }
 
+void Viewport::appendMemoryReport(app::diagnostics::MemoryReport& report) const {
+    if (m_bodyRenderer) {
+        const auto usage = m_bodyRenderer->memoryUsage();
+        report.addPart("bodyRenderer", "bodyCpu", usage.bodyCpuBytes);
+        report.addPart("bodyRenderer", "previewCpu", usage.previewCpuBytes);
+        report.addPart("bodyRenderer", "gpu", usage.gpuBytes);
+        for (const auto& [bodyId, bytes] : usage.perBodyBytes) {
+            report.addItem("bodyRenderer", bodyId, bytes);
+        }
+        report.setCount("bodyRenderer", usage.perBodyBytes.size());
+    }
+    if (m_modelPicker) {
+        const auto perBody = m_modelPicker->memoryBytesByBody();
+        for (const auto& [bodyId, bytes] : perBody) {
+            report.addPart("modelPicker", "meshCaches", bytes);
+            report.addItem("modelPicker", bodyId, bytes);
+        }
+        report.setCount("modelPicker", perBody.size());
+    }
+}
+
 std::vector<app::selection::SelectionItem> Viewport::modelSelection() const {
     if (!m_selectionManager) {
         return {};
@@ -3588,8 +3648,12 @@ void Viewport::setPreviewHiddenBody(const std::string& bodyId) {
     if (m_previewHiddenBodyId == bodyId) {
         return;
     }
+    const std::string previous = m_previewHiddenBodyId;
     m_previewHiddenBodyId = bodyId;
-    syncModelMeshes();
+    if (!previous.empty()) {
+        syncModelMesh(previous, false);
+    }
+    syncModelMesh(bodyId, false);
     update();
 }
 
@@ -3597,8 +3661,9 @@ void Viewport::clearPreviewHiddenBody() {
     if (m_previewHiddenBodyId.empty()) {
         return;
     }
+    const std::string previous = m_previewHiddenBodyId;
     m_previewHiddenBodyId.clear();
-    syncModelMeshes();
+    syncModelMesh(previous, false);
     update();
 }
 
@@ -3623,50 +3688,55 @@ void Viewport::syncModelMeshes() {
 
     // Build pick meshes from visible bodies only
     std::vector<selection::ModelPickerAdapter::Mesh> pickMeshes;
+    pickMeshes.reserve(visibleMeshes.size());
     for (const auto& mesh : visibleMeshes) {
-        selection::ModelPickerAdapter::Mesh pickMesh;
-        pickMesh.bodyId = mesh.bodyId;
-        pickMesh.vertices.reserve(mesh.vertices.size());
-        for (const auto& v : mesh.vertices) {
-            QVector4D transformed = mesh.modelMatrix * QVector4D(v, 1.0f);
-            pickMesh.vertices.emplace_back(transformed.x(), transformed.y(), transformed.z());
-        }
-        pickMesh.triangles.reserve(mesh.triangles.size());
-        for (const auto& tri : mesh.triangles) {
-            selection::ModelPickerAdapter::Triangle pickTri;
-            pickTri.i0 = tri.i0;
-            pickTri.i1 = tri.i1;
-            pickTri.i2 = tri.i2;
-            pickTri.faceId = tri.faceId;
-            pickMesh.triangles.push_back(pickTri);
-        }
-        for (const auto& [faceId, topo] : mesh.topologyByFace) {
-            selection::ModelPickerAdapter::FaceTopology faceTopo;
-            for (const auto& edge : topo.edges) {
-                selection::ModelPickerAdapter::EdgePolyline edgeLine;
-                edgeLine.edgeId = edge.edgeId;
-                edgeLine.points.reserve(edge.points.size());
-                for (const auto& pt : edge.points) {
-                    QVector4D transformed = mesh.modelMatrix * QVector4D(pt, 1.0f);
-                    edgeLine.points.emplace_back(transformed.x(), transformed.y(), transformed.z());
-                }
-                faceTopo.edges.push_back(std::move(edgeLine));
-            }
-            for (const auto& vertex : topo.vertices) {
-                selection::ModelPickerAdapter::VertexSample sample;
-                sample.vertexId = vertex.vertexId;
-                QVector4D transformed = mesh.modelMatrix * QVector4D(vertex.position, 1.0f);
-                sample.position = QVector3D(transformed.x(), transformed.y(), transformed.z());
-                faceTopo.vertices.push_back(std::move(sample));
-            }
-            pickMesh.topologyByFace[faceId] = std::move(faceTopo);
-        }
-        pickMesh.faceGroupByFaceId = mesh.faceGroupByFaceId;
-        pickMeshes.push_back(std::move(pickMesh));
+        pickMeshes.push_back(toPickMesh(mesh));
     }
     setModelPickMeshes(std::move(pickMeshes));
 }
 
+void Viewport::syncModelMesh(const std::string& bodyId, bool rebuild) {
+    if (!m_document || !m_modelPicker) {
+        return;
+    }
+    const render::SceneMeshStore::Mesh* mesh = m_document->meshStore().findMesh(bodyId);
+    const bool shown = mesh && m_document->isBodyVisible(bodyId) && bodyId != m_previewHiddenBodyId;
+    if (!shown) {
+        if (m_bodyRenderer) {
+            m_bodyRenderer->removeBodyMesh(bodyId);
+        }
+        m_modelPicker->removeMesh(bodyId);
+        return;
+    }
+    if (!rebuild && m_modelPicker->hasMesh(bodyId)) {
+        return;
+    }
+    if (m_bodyRenderer) {
+        m_bodyRenderer->setBodyMesh(*mesh);
+    }
+    m_modelPicker->setMesh(toPickMesh(*mesh));
+}
+
+void Viewport::applyDocumentChanges(const app::DocumentChangeSet& changes) {
+    if (changes.cleared) {
+        syncModelMeshes();
+        return;
+    }
+    for (const auto& bodyId : changes.removed) {
+        syncModelMesh(bodyId, false);
+    }
+    for (const auto& bodyId : changes.added) {
+        syncModelMesh(bodyId, true);
+    }
+    for (const auto& bodyId : changes.updated) {
+        syncModelMesh(bodyId, true);
+    }
+    // Isolation reports each body whose visibility flipped, so no full resync
+    for (const auto& bodyId : changes.visibilityChanged) {
+        syncModelMesh(bodyId, false);
+    }
+}
+
 void Viewport::notifySketchUpdated() {
     emit sketchUpdated();
 }
@@ -3736,8 +3806,10 @@ void Viewport::updateSnapGeometry() {
     // Iterate over all bodies in the document
     auto bodyIds = m_document->getBodyIds();
     for (const auto& bodyId : bodyIds) {
+        // Hidden bodies may still be pending; don't load them just to skip them
+        if (!m_document->isBodyVisible(bodyId)) continue;
         const auto* body = m_document->getBodyShape(bodyId);
-        if (!body || !m_document->isBodyVisible(bodyId)) continue;
+        if (!body) continue;
         
         // Extract Vertices
         TopExp_Explorer exV;
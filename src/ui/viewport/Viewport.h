@@ -25,6 +25,10 @@
 namespace onecad {
 namespace app {
     class Document;
+    struct DocumentChangeSet;
+    namespace diagnostics {
+        class MemoryReport;
+    }
     namespace commands {
         class CommandProcessor;
     }
@@ -114,6 +118,11 @@ public:
     // Thumbnail capture
     QImage captureThumbnail(int maxSize = 512);
 
+    /**
+     * @brief Add the body renderer buffers and model pick caches to a memory report
+     */
+    void appendMemoryReport(app::diagnostics::MemoryReport& report) const;
+
     // Document access (for rendering all sketches in 3D mode)
     void setDocument(app::Document* document);
     void setCommandProcessor(app::commands::CommandProcessor* processor);
@@ -242,6 +251,8 @@ private:
     QMatrix4x4 buildViewProjection() const;
     QSize viewportSize() const;
     void syncModelMeshes();
+    void syncModelMesh(const std::string& bodyId, bool rebuild);
+    void applyDocumentChanges(const app::DocumentChangeSet& changes);
     std::string resolveActiveSketchId() const;
     void updateSketchSelectionFromManager();
     void updateSketchHoverFromManager();
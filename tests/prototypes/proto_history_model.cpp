@@ -0,0 +1,147 @@
+#include "app/document/Document.h"
+#include "app/document/OperationRecord.h"
+#include "ui/history/HistoryModel.h"
+
+#include <QCoreApplication>
+#include <iostream>
+#include <string>
+
+using onecad::app::Document;
+using onecad::app::OperationRecord;
+using onecad::app::OperationType;
+using onecad::ui::HistoryModel;
+using RowKind = HistoryModel::RowKind;
+
+namespace {
+int failures = 0;
+
+void check(bool condition, const char* message) {
+    if (!condition) {
+        std::cerr << "FAIL: " << message << "\n";
+        ++failures;
+    }
+}
+
+OperationRecord extrude(const std::string& opId, const std::string& sketchId, const std::string& bodyId) {
+    OperationRecord op;
+    op.opId = opId;
+    op.type = OperationType::Extrude;
+    op.input = onecad::app::SketchRegionRef{sketchId, "r1"};
+    op.params = onecad::app::ExtrudeParams{10.0};
+    op.resultBodyIds = {bodyId};
+    return op;
+}
+
+OperationRecord fillet(const std::string& opId, const std::string& bodyId) {
+    OperationRecord op;
+    op.opId = opId;
+    op.type = OperationType::Fillet;
+    op.input = onecad::app::BodyRef{bodyId};
+    op.params = onecad::app::FilletChamferParams{};
+    op.resultBodyIds = {bodyId};
+    return op;
+}
+
+OperationRecord boolean(const std::string& opId, const std::string& targetId, const std::string& toolId) {
+    onecad::app::BooleanParams params;
+    params.targetBodyId = targetId;
+    params.toolBodyId = toolId;
+    OperationRecord op;
+    op.opId = opId;
+    op.type = OperationType::Boolean;
+    op.params = params;
+    op.resultBodyIds = {targetId};
+    return op;
+}
+} // namespace
+
+int main(int argc, char** argv) {
+    QCoreApplication app(argc, argv);
+    Document doc;
+    HistoryModel model;
+
+    int inserted = 0;
+    int removed = 0;
+    int resets = 0;
+    QObject::connect(&model, &QAbstractItemModel::rowsInserted, [&]() { ++inserted; });
+    QObject::connect(&model, &QAbstractItemModel::rowsRemoved, [&]() { ++removed; });
+    QObject::connect(&model, &QAbstractItemModel::modelReset, [&]() { ++resets; });
+
+    model.setDocument(&doc);
+    check(resets == 1, "setDocument resets the model");
+    check(model.rowCount() == 1 && model.rowKind(model.index(0, 0)) == RowKind::Placeholder,
+          "empty history shows a placeholder");
+
+    // Incremental inserts
+    doc.addOperation(extrude("ext1", "s1", "b1"));
+    model.addOperation("ext1");
+    check(removed == 1 && inserted == 2, "first operation replaces the placeholder with group and row");
+    check(model.rowCount() == 1 && model.rowKind(model.index(0, 0)) == RowKind::SketchGroup,
+          "extrude grouped under its sketch");
+
+    doc.addOperation(fillet("fil1", "b1"));
+    model.addOperation("fil1");
+    const QModelIndex ext1 = model.indexForOperation("ext1");
+    check(model.indexForOperation("fil1").parent() == ext1, "fillet nested under the producing extrude");
+
+    doc.addOperation(extrude("ext2", "s2", "b2"));
+    model.addOperation("ext2");
+    doc.addOperation(boolean("bool1", "b2", "b1"));
+    model.addOperation("bool1");
+    check(model.indexForOperation("bool1").parent() == model.indexForOperation("ext2"),
+          "boolean nested under the target body's producer");
+    check(model.rowCount() == 2 && model.operationCount() == 4, "two groups, four operations");
+    check(inserted == 6 && removed == 1 && resets == 1, "additions are incremental");
+
+    // Incremental remove of a leaf
+    doc.removeOperation("fil1");
+    model.removeOperation("fil1");
+    check(removed == 2 && resets == 1, "removing a leaf removes one row");
+    check(model.rowCount(model.indexForOperation("ext1")) == 0, "extrude has no children left");
+
+    // Fallback: the anchor changed, so the row moves through a reset
+    onecad::app::BooleanParams retarget;
+    retarget.targetBodyId = "b1";
+    retarget.toolBodyId = "b2";
+    doc.updateOperationParams("bool1", retarget);
+    model.updateOperation("bool1");
+    check(resets == 2, "changed boolean target resets the model");
+    check(model.indexForOperation("bool1").parent() == model.indexForOperation("ext1"),
+          "boolean moved under the new target's producer");
+
+    // Same anchor: updated in place
+    onecad::app::BooleanParams cut = retarget;
+    cut.operation = onecad::app::BooleanParams::Op::Cut;
+    doc.updateOperationParams("bool1", cut);
+    model.updateOperation("bool1");
+    check(resets == 2, "parameter change keeps the row in place");
+
+    // Fallback: removing a row with children resets
+    doc.removeOperation("ext1");
+    model.removeOperation("ext1");
+    check(resets == 3, "removing an operation with dependents resets the model");
+    check(!model.indexForOperation("bool1").parent().isValid(), "orphaned boolean moves to the top level");
+    check(model.rowCount() == 2, "sketch group s1 dropped on reset");
+
+    // The last operation of a sketch group takes the group with it
+    const int removedBefore = removed;
+    doc.removeOperation("ext2");
+    model.removeOperation("ext2");
+    check(removed == removedBefore + 2 && resets == 3, "operation and empty sketch group removed incrementally");
+    check(model.rowCount() == 1 && model.rowKind(model.index(0, 0)) == RowKind::Operation,
+          "only the boolean is left");
+
+    const int insertedBefore = inserted;
+    doc.removeOperation("bool1");
+    model.removeOperation("bool1");
+    check(removed == removedBefore + 3 && inserted == insertedBefore + 1 && resets == 3,
+          "placeholder returns when the last operation goes");
+    check(model.rowKind(model.index(0, 0)) == RowKind::Placeholder && model.operationCount() == 0,
+          "placeholder row");
+
+    if (failures > 0) {
+        return 1;
+    }
+    std::cout << "HistoryModel tests passed\n";
+    return 0;
+}
@@ -0,0 +1,172 @@
+#include "app/Logging.h"
+
+#include <QCoreApplication>
+#include <QFile>
+#include <QStringList>
+#include <QTemporaryDir>
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+using onecad::app::Logging;
+
+namespace {
+int failures = 0;
+
+void check(bool condition, const char* message) {
+    if (!condition) {
+        std::cerr << "FAIL: " << message << "\n";
+        ++failures;
+    }
+}
+
+// Installed before Logging::initialize(), so the writer forwards to it.
+// Blocking here wedges the writer while it holds the drain lock.
+std::atomic<bool> gHoldWriter{false};
+std::atomic<bool> gWriterHeld{false};
+std::atomic<int> gForwarded{0};
+
+void forwardingHandler(QtMsgType, const QMessageLogContext&, const QString& message) {
+    gForwarded.fetch_add(1);
+    if (message == QLatin1String("hold writer")) {
+        gWriterHeld.store(true);
+        while (gHoldWriter.load()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        gWriterHeld.store(false);
+    }
+}
+
+void holdWriter() {
+    gHoldWriter.store(true);
+    qInfo("hold writer");
+    while (!gWriterHeld.load()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+void releaseWriter() {
+    gHoldWriter.store(false);
+    while (gWriterHeld.load()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+// Message text of every log line, in file order
+QStringList readMessages(const QString& path) {
+    QFile file(path);
+    QStringList messages;
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        return messages;
+    }
+    while (!file.atEnd()) {
+        const QString line = QString::fromUtf8(file.readLine()).trimmed();
+        // "<time> [LEVEL] [tid] [category] [location] [function] message"
+        int pos = 0;
+        for (int field = 0; field < 5 && pos >= 0; ++field) {
+            pos = line.indexOf(QLatin1String("] "), pos);
+            if (pos >= 0) {
+                pos += 2;
+            }
+        }
+        messages.push_back(pos >= 0 ? line.mid(pos) : line);
+    }
+    return messages;
+}
+} // namespace
+
+int main(int argc, char** argv) {
+    QCoreApplication app(argc, argv);
+    QTemporaryDir dir;
+    qputenv("ONECAD_LOG_DIR", dir.path().toUtf8());
+
+    qInstallMessageHandler(forwardingHandler);
+    check(Logging::initialize("proto_logging", true), "logging initializes");
+    const QString logPath = Logging::logFilePath();
+    check(!logPath.isEmpty(), "log file path is set");
+
+    // Several threads: each thread's messages keep their order
+    constexpr int kThreads = 4;
+    constexpr int kPerThread = 200;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([t]() {
+            for (int i = 0; i < kPerThread; ++i) {
+                qInfo("ordered %d %d", t, i);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    // A thread that logs and exits before the writer gets to its queue
+    holdWriter();
+    std::thread exited([]() {
+        for (int i = 0; i < 10; ++i) {
+            qInfo("exited %d", i);
+        }
+    });
+    exited.join();
+    releaseWriter();
+
+    // Overflow: the writer is stuck, so this thread's queue fills up
+    holdWriter();
+    for (int i = 0; i < 2000; ++i) {
+        qInfo("flood %d", i);
+    }
+    releaseWriter();
+
+    // Still queued when shutdown starts
+    holdWriter();
+    for (int i = 0; i < 100; ++i) {
+        qInfo("pending %d", i);
+    }
+    releaseWriter();
+    Logging::shutdown();
+    check(Logging::logFilePath().isEmpty(), "shutdown clears the log file path");
+
+    const QStringList messages = readMessages(logPath);
+
+    std::vector<int> next(kThreads, 0);
+    bool inOrder = true;
+    for (const QString& message : messages) {
+        const QStringList parts = message.split(' ');
+        if (parts.size() == 3 && parts[0] == QLatin1String("ordered")) {
+            const int t = parts[1].toInt();
+            const int i = parts[2].toInt();
+            inOrder = inOrder && t >= 0 && t < kThreads && next[t] == i;
+            if (t >= 0 && t < kThreads) {
+                next[t] = i + 1;
+            }
+        }
+    }
+    check(inOrder, "messages of each thread are written in order");
+    check(next == std::vector<int>(kThreads, kPerThread), "every threaded message is written");
+
+    check(messages.contains(QStringLiteral("exited 0")) &&
+              messages.contains(QStringLiteral("exited 9")),
+          "messages of an exited thread are written");
+
+    bool droppedNotice = false;
+    for (const QString& message : messages) {
+        droppedNotice = droppedNotice ||
+                        message.endsWith(QLatin1String("log messages dropped (queue full)"));
+    }
+    check(droppedNotice, "overflow reports dropped messages");
+    check(messages.contains(QStringLiteral("flood 0")), "messages queued before the overflow are kept");
+
+    check(messages.contains(QStringLiteral("pending 0")) &&
+              messages.contains(QStringLiteral("pending 99")),
+          "shutdown drains queued messages");
+    check(gForwarded.load() > 0, "messages are forwarded to the previous handler");
+
+    if (failures > 0) {
+        return 1;
+    }
+    std::cout << "Logging tests passed\n";
+    return 0;
+}
@@ -1,13 +1,64 @@
+#include "loop/IncrementalLoopDetector.h"
 #include "loop/LoopDetector.h"
+#include "loop/LoopResultCache.h"
+#include "loop/RegionUtils.h"
 #include "sketch/Sketch.h"
+#include "sketch/SketchPoint.h"
 
 #include <cassert>
+#include <chrono>
+#include <cmath>
 #include <iostream>
 #include <numbers>
+#include <set>
+#include <string>
+#include <vector>
 
 using namespace onecad::core;
 
-int main() {
+namespace {
+
+// n x n overlapping circles plus an n-line lattice through their centers.
+std::vector<sketch::EntityID> buildOverlapField(sketch::Sketch& sketch, int n,
+                                                double originX = 0.0, double originY = 0.0) {
+    const double spacing = 10.0;
+    const double extent = spacing * static_cast<double>(n - 1);
+    std::vector<sketch::EntityID> centers;
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < n; ++j) {
+            centers.push_back(sketch.addPoint(originX + spacing * i, originY + spacing * j));
+            sketch.addCircle(centers.back(), 6.5);
+        }
+    }
+    for (int i = 0; i < n; ++i) {
+        const double offset = spacing * i + 2.5;
+        sketch.addLine(originX - 8.0, originY + offset, originX + extent + 8.0, originY + offset);
+        sketch.addLine(originX + offset, originY - 8.0, originX + offset, originY + extent + 8.0);
+    }
+    return centers;
+}
+
+std::set<std::string> regionKeys(const loop::LoopDetectionResult& result) {
+    std::set<std::string> keys;
+    for (const auto& region : loop::buildRegionDefinitions(result, 1e-6)) {
+        keys.insert(region.id);
+    }
+    return keys;
+}
+
+loop::LoopDetectorConfig planarConfig() {
+    loop::LoopDetectorConfig config;
+    config.planarizeIntersections = true;
+    config.findAllLoops = false;
+    config.resolveHoles = true;
+    return config;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const bool runBench = argc > 1 && std::string(argv[1]) == "--benchmark";
+
     {
         sketch::Sketch sketch;
 
@@ -77,6 +128,204 @@ int main() {
         assert(!result.faces.empty());
     }
 
+    {
+        // Two overlapping circles split into three regions.
+        sketch::Sketch sketch;
+        auto c1 = sketch.addPoint(0.0, 0.0);
+        auto c2 = sketch.addPoint(6.0, 0.0);
+        sketch.addCircle(c1, 5.0);
+        sketch.addCircle(c2, 5.0);
+
+        loop::LoopDetector detector(planarConfig());
+        auto result = detector.detect(sketch);
+
+        assert(result.success);
+        assert(result.faces.size() == 3);
+    }
+
+    {
+        // Planarized field: every crossing must be found by the broad-phase.
+        sketch::Sketch sketch;
+        buildOverlapField(sketch, 3);
+
+        loop::LoopDetector detector(planarConfig());
+        auto result = detector.detect(sketch);
+
+        assert(result.success);
+        assert(result.faces.size() == 64);
+    }
+
+    {
+        // Incremental detection matches a full pass and only redoes edited islands.
+        sketch::Sketch sketch;
+        std::vector<sketch::EntityID> firstIslandCenters;
+        for (int island = 0; island < 4; ++island) {
+            auto centers = buildOverlapField(sketch, 2, 100.0 * island, 0.0);
+            if (island == 0) {
+                firstIslandCenters = centers;
+            }
+        }
+        auto outerCenter = sketch.addPoint(160.0, 5.0);
+        sketch.addCircle(outerCenter, 200.0);
+
+        loop::IncrementalLoopDetector incremental(planarConfig());
+        loop::LoopDetector full(planarConfig());
+
+        auto first = incremental.detect(sketch);
+        assert(first.success);
+        assert(regionKeys(first) == regionKeys(full.detect(sketch)));
+        assert(incremental.lastStats().componentsRebuilt == incremental.lastStats().components);
+
+        auto again = incremental.detect(sketch);
+        assert(incremental.lastStats().componentsRebuilt == 0);
+        assert(incremental.lastStats().curvesRefreshed == 0);
+        assert(regionKeys(again) == regionKeys(first));
+
+        // Only the circle around the moved center is re-tessellated
+        sketch.getEntityAs<sketch::SketchPoint>(firstIslandCenters.front())->setPosition(1.5, -1.0);
+        auto moved = incremental.detect(sketch);
+        assert(incremental.lastStats().curvesRefreshed == 1);
+        assert(incremental.lastStats().componentsRebuilt == 1);
+        assert(incremental.lastStats().componentsReused == incremental.lastStats().components - 1);
+        assert(regionKeys(moved) == regionKeys(full.detect(sketch)));
+        assert(moved.faces.size() == full.detect(sketch).faces.size());
+    }
+
+    {
+        // Components merge and split around an added/removed curve.
+        sketch::Sketch sketch;
+        for (int island = 0; island < 3; ++island) {
+            buildOverlapField(sketch, 2, 100.0 * island, 0.0);
+        }
+
+        loop::IncrementalLoopDetector incremental(planarConfig());
+        loop::LoopDetector full(planarConfig());
+        auto before = incremental.detect(sketch);
+        assert(incremental.lastStats().components == 3);
+
+        auto bridge = sketch.addLine(5.0, 5.0, 105.0, 5.0);
+        auto bridged = incremental.detect(sketch);
+        assert(incremental.lastStats().curvesRefreshed == 1);
+        assert(incremental.lastStats().components == 2);
+        assert(incremental.lastStats().componentsRebuilt == 1);
+        assert(incremental.lastStats().componentsReused == 1);
+        assert(regionKeys(bridged) == regionKeys(full.detect(sketch)));
+
+        sketch.removeEntity(bridge);
+        auto split = incremental.detect(sketch);
+        assert(incremental.lastStats().components == 3);
+        assert(regionKeys(split) == regionKeys(before));
+    }
+
+    {
+        // Sketch-level region cache: hits while geometry is unchanged.
+        sketch::Sketch sketch;
+        auto p1 = sketch.addPoint(0.0, 0.0);
+        auto p2 = sketch.addPoint(10.0, 0.0);
+        auto p3 = sketch.addPoint(10.0, 5.0);
+        auto p4 = sketch.addPoint(0.0, 5.0);
+        auto bottom = sketch.addLine(p1, p2);
+        sketch.addLine(p2, p3);
+        sketch.addLine(p3, p4);
+        sketch.addLine(p4, p1);
+
+        const auto config = loop::makeRegionDetectionConfig();
+        const auto& regions = sketch.regionDefinitions(config);
+        assert(regions.size() == 1);
+        const std::string regionId = regions.front().id;
+        assert(sketch.loopCacheStats().regionMisses == 1);
+        assert(sketch.loopCacheStats().detectionMisses == 1);
+
+        // Typical selection / extrude lookups reuse the same pass
+        assert(loop::getRegionIdContainingEntity(sketch, bottom) == regionId);
+        assert(loop::getEntityIdsInRegion(sketch, regionId).size() == 8);
+        assert(loop::resolveRegionFace(sketch, regionId).has_value());
+        assert(sketch.loopCacheStats().regionHits == 3);
+        assert(sketch.loopCacheStats().detectionMisses == 1);
+
+        // Geometry edit invalidates
+        sketch.getEntityAs<sketch::SketchPoint>(p3)->setPosition(12.0, 6.0);
+        auto movedFace = loop::resolveRegionFace(sketch, regionId);
+        assert(movedFace.has_value());
+        assert(sketch.loopCacheStats().regionMisses == 2);
+        loop::LoopDetector detector(config);
+        assert(std::abs(movedFace->outerLoop.area() -
+                        detector.detect(sketch).faces.front().outerLoop.area()) < 1e-9);
+
+        // Construction toggle removes the region
+        sketch.getEntity(bottom)->setConstruction(true);
+        assert(sketch.regionDefinitions(config).empty());
+        assert(sketch.loopCacheStats().regionMisses == 3);
+
+        sketch.resetLoopCacheStats();
+        assert(sketch.loopCacheStats().regionHits == 0);
+    }
+
+    if (runBench) {
+        for (int n : {4, 8, 16, 32}) {
+            sketch::Sketch sketch;
+            buildOverlapField(sketch, n);
+
+            loop::LoopDetector detector(planarConfig());
+            auto t0 = std::chrono::steady_clock::now();
+            auto result = detector.detect(sketch);
+            auto t1 = std::chrono::steady_clock::now();
+            std::cout << "Benchmark: planarize " << n * n << " circles + " << 2 * n << " lines: "
+                      << std::chrono::duration<double, std::milli>(t1 - t0).count() << " ms, "
+                      << result.faces.size() << " faces" << std::endl;
+        }
+    }
+
+    if (runBench) {
+        // Short arc-tessellation chords plus one long diagonal across the field.
+        for (int n : {16, 32, 64}) {
+            sketch::Sketch sketch;
+            const double spacing = 3.0;
+            for (int i = 0; i < n; ++i) {
+                for (int j = 0; j < n; ++j) {
+                    sketch.addCircle(sketch.addPoint(spacing * i, spacing * j), 1.0);
+                }
+            }
+            const double extent = spacing * static_cast<double>(n - 1);
+            sketch.addLine(-2.0, -2.0, extent + 2.0, extent + 2.0);
+
+            loop::LoopDetector detector(planarConfig());
+            auto t0 = std::chrono::steady_clock::now();
+            auto result = detector.detect(sketch);
+            auto t1 = std::chrono::steady_clock::now();
+            std::cout << "Benchmark: planarize " << n * n << " small circles + 1 long diagonal: "
+                      << std::chrono::duration<double, std::milli>(t1 - t0).count() << " ms, "
+                      << result.faces.size() << " faces" << std::endl;
+        }
+    }
+
+    if (runBench) {
+        // 64 separate 3x3 islands; edit one and re-detect.
+        sketch::Sketch sketch;
+        std::vector<sketch::EntityID> centers;
+        for (int i = 0; i < 64; ++i) {
+            auto island = buildOverlapField(sketch, 3, 60.0 * (i % 8), 60.0 * (i / 8));
+            centers.push_back(island.front());
+        }
+
+        loop::LoopDetector full(planarConfig());
+        loop::IncrementalLoopDetector incremental(planarConfig());
+        (void)incremental.detect(sketch);
+
+        sketch.getEntityAs<sketch::SketchPoint>(centers[10])->setPosition(60.0 * 2 + 0.5, 60.0 + 0.5);
+        auto t0 = std::chrono::steady_clock::now();
+        auto fullResult = full.detect(sketch);
+        auto t1 = std::chrono::steady_clock::now();
+        auto incrementalResult = incremental.detect(sketch);
+        auto t2 = std::chrono::steady_clock::now();
+        std::cout << "Benchmark: one edit in 64 islands, full "
+                  << std::chrono::duration<double, std::milli>(t1 - t0).count() << " ms, incremental "
+                  << std::chrono::duration<double, std::milli>(t2 - t1).count() << " ms ("
+                  << incremental.lastStats().componentsRebuilt << "/" << incremental.lastStats().components
+                  << " components rebuilt, " << incrementalResult.faces.size() << "/"
+                  << fullResult.faces.size() << " faces)" << std::endl;
+    }
+
     std::cout << "Loop detector prototype: OK" << std::endl;
     return 0;
 }
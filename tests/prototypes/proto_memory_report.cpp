@@ -0,0 +1,105 @@
+#include "app/commands/CommandProcessor.h"
+#include "app/commands/DeleteBodyCommand.h"
+#include "app/diagnostics/MemoryReport.h"
+#include "app/document/Document.h"
+
+#include <BRepBuilderAPI_Copy.hxx>
+#include <BRepPrimAPI_MakeBox.hxx>
+#include <QCoreApplication>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <iostream>
+#include <memory>
+
+using onecad::app::diagnostics::MemoryReport;
+using onecad::app::diagnostics::ShapeMemoryEstimator;
+
+namespace {
+
+bool expect(bool condition, const char* message) {
+    if (!condition) {
+        std::cerr << "FAIL: " << message << "\n";
+    }
+    return condition;
+}
+
+std::size_t partBytes(const MemoryReport& report, const std::string& category, const std::string& part) {
+    const MemoryReport::Category* found = report.findCategory(category);
+    if (!found) {
+        return 0;
+    }
+    for (const auto& entry : found->parts) {
+        if (entry.name == part) {
+            return entry.bytes;
+        }
+    }
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    QCoreApplication app(argc, argv);
+    bool ok = true;
+
+    // Shared topology is counted once; a deep copy is counted again
+    {
+        const TopoDS_Shape box = BRepPrimAPI_MakeBox(10.0, 20.0, 30.0).Shape();
+        ShapeMemoryEstimator estimator;
+        const std::size_t first = estimator.add(box);
+        ok &= expect(first > 0, "box has BRep bytes");
+        ok &= expect(estimator.add(box) == 0, "same shape counted once");
+        ok &= expect(estimator.add(box.Reversed()) == 0, "reversed shape shares its TShapes");
+        const TopoDS_Shape copy = BRepBuilderAPI_Copy(box).Shape();
+        ok &= expect(estimator.add(copy) > 0, "deep copy counted separately");
+    }
+
+    // Parts sum into the category, items do not change totals
+    {
+        MemoryReport report;
+        report.addPart("cache", "a", 100);
+        report.addPart("cache", "b", 50);
+        report.addPart("cache", "a", 10);
+        report.addItem("cache", "body-1", 160);
+        report.setCount("cache", 1);
+        ok &= expect(report.totalBytes() == 160, "total is the sum of parts");
+        ok &= expect(partBytes(report, "cache", "a") == 110, "repeated part accumulates");
+
+        const QJsonObject json = report.toJson();
+        ok &= expect(json["totalBytes"].toInteger() == 160, "json total");
+        const QJsonObject category = json["categories"].toArray().at(0).toObject();
+        ok &= expect(category["name"].toString() == "cache", "json category name");
+        ok &= expect(category["items"].toObject()["body-1"].toInteger() == 160, "json item");
+        ok &= expect(category["count"].toInteger() == 1, "json count");
+    }
+
+    // Document report, with a deleted body held only by the undo stack
+    {
+        onecad::app::Document document;
+        onecad::app::commands::CommandProcessor processor;
+        processor.setDocument(&document);
+        const std::string kept = document.addBody(BRepPrimAPI_MakeBox(10.0, 10.0, 10.0).Shape());
+        const std::string removed = document.addBody(BRepPrimAPI_MakeBox(5.0, 5.0, 5.0).Shape());
+
+        MemoryReport before = MemoryReport::collect(document, &processor);
+        ok &= expect(partBytes(before, "brep", "bodies") > 0, "brep counted");
+        ok &= expect(partBytes(before, "sceneMeshes", "meshes") > 0, "scene meshes counted");
+        ok &= expect(partBytes(before, "elementMap", "entries") > 0, "element map counted");
+        ok &= expect(before.findCategory("brep")->count == 2, "two bodies");
+
+        processor.execute(std::make_unique<onecad::app::commands::DeleteBodyCommand>(&document, removed));
+        MemoryReport after = MemoryReport::collect(document, &processor);
+        ok &= expect(after.findCategory("brep")->count == 1, "one body after delete");
+        ok &= expect(partBytes(after, "undoStack", "retainedBrep") > 0,
+                     "deleted body is reported as retained by undo");
+        ok &= expect(partBytes(after, "undoStack", "undo") > 0, "undo command counted");
+
+        (void)kept;
+    }
+
+    if (!ok) {
+        return 1;
+    }
+    std::cout << "proto_memory_report: OK\n";
+    return 0;
+}
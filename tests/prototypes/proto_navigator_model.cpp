@@ -0,0 +1,74 @@
+#include "ui/navigator/NavigatorModel.h"
+
+#include <QCoreApplication>
+#include <iostream>
+
+using onecad::ui::NavigatorModel;
+using Section = NavigatorModel::Section;
+using RowKind = NavigatorModel::RowKind;
+
+namespace {
+int failures = 0;
+
+void check(bool condition, const char* message) {
+    if (!condition) {
+        std::cerr << "FAIL: " << message << "\n";
+        ++failures;
+    }
+}
+} // namespace
+
+int main(int argc, char** argv) {
+    QCoreApplication app(argc, argv);
+    NavigatorModel model;
+
+    int inserted = 0;
+    int removed = 0;
+    int resets = 0;
+    QObject::connect(&model, &QAbstractItemModel::rowsInserted, [&]() { ++inserted; });
+    QObject::connect(&model, &QAbstractItemModel::rowsRemoved, [&]() { ++removed; });
+    QObject::connect(&model, &QAbstractItemModel::modelReset, [&]() { ++resets; });
+
+    const QModelIndex bodies = model.sectionIndex(Section::Bodies);
+    const QModelIndex sketches = model.sectionIndex(Section::Sketches);
+    check(model.rowCount() == 2, "two section rows");
+    check(model.rowCount(bodies) == 1, "empty section shows a placeholder");
+    check(model.rowKind(model.index(0, 0, bodies)) == RowKind::Placeholder, "placeholder kind");
+
+    model.addItem(Section::Bodies, "b1");
+    check(removed == 1 && inserted == 1, "first item replaces the placeholder");
+    check(model.rowCount(bodies) == 1, "one body row");
+    check(model.index(0, 0, bodies).data().toString() == "Body 1", "default body name");
+
+    for (int i = 2; i <= 1000; ++i) {
+        model.addItem(Section::Bodies, QString("b%1").arg(i));
+    }
+    check(model.rowCount(bodies) == 1000, "1000 body rows");
+    check(inserted == 1000 && resets == 0, "additions are incremental");
+
+    model.removeItem(Section::Bodies, "b500");
+    const QModelIndex after = model.indexForId("b501");
+    check(after.row() == 499 && after.parent() == bodies, "rows renumbered after removal");
+    check(model.itemId(after) == "b501", "id lookup after removal");
+
+    model.renameItem(Section::Bodies, "b501", "Bracket");
+    check(after.data().toString() == "Bracket", "rename updates the row");
+
+    model.setItemVisible(Section::Bodies, "b501", false);
+    check(!model.isItemVisible(after), "visibility updates the row");
+
+    model.addItem(Section::Sketches, "s1", "Base");
+    model.removeItem(Section::Sketches, "s1");
+    check(model.rowCount(sketches) == 1 &&
+          model.rowKind(model.index(0, 0, sketches)) == RowKind::Placeholder,
+          "placeholder returns when the last item goes");
+
+    model.reset(nullptr);
+    check(resets == 1 && model.rowCount(bodies) == 1, "reset empties both sections");
+
+    if (failures > 0) {
+        return 1;
+    }
+    std::cout << "NavigatorModel tests passed\n";
+    return 0;
+}
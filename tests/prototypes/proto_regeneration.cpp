@@ -10,27 +10,64 @@
  */
 
 #include "app/document/Document.h"
+#include "app/document/DocumentEntryLoader.h"
 #include "app/history/DependencyGraph.h"
 #include "app/history/RegenerationEngine.h"
 #include "app/selection/SelectionManager.h"
 #include "core/loop/LoopDetector.h"
 #include "core/loop/RegionUtils.h"
 #include "core/sketch/Sketch.h"
+#include "io/AutosaveService.h"
+#include "io/BRepIO.h"
+#include "io/ElementMapIO.h"
 #include "io/HistoryIO.h"
-
+#include "io/HistoryVerificationJob.h"
+#include "io/IncrementalPackage.h"
+#include "io/ManifestIO.h"
+#include "io/OneCADFileIO.h"
+#include "io/Package.h"
+#include "io/PackageEntryPipeline.h"
+#include "io/ZipPackage.h"
+#include "io/mesh/MeshExporter.h"
+#include "io/step/StepExporter.h"
+#include "io/step/StepImporter.h"
+
+#include <BRepAlgoAPI_Cut.hxx>
 #include <BRepCheck_Analyzer.hxx>
 #include <BRepGProp.hxx>
 #include <BRepPrimAPI_MakeBox.hxx>
+#include <BRepPrimAPI_MakeCylinder.hxx>
+#include <BRep_Builder.hxx>
+#include <BRep_Tool.hxx>
 #include <GProp_GProps.hxx>
+#include <Poly_Triangulation.hxx>
 #include <TopExp_Explorer.hxx>
+#include <TopLoc_Location.hxx>
 #include <TopoDS.hxx>
+#include <TopoDS_Compound.hxx>
+#include <TopoDS_Face.hxx>
+#include <gp_Ax2.hxx>
+#include <gp_Pnt.hxx>
+#include <gp_Trsf.hxx>
+#include <gp_Vec.hxx>
 
 #include <QCoreApplication>
+#include <QDir>
+#include <QEventLoop>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonDocument>
+#include <QTemporaryDir>
 #include <QUuid>
 
+#include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <chrono>
 #include <cmath>
+#include <cstdlib>
 #include <iostream>
+#include <memory>
 #include <optional>
 #include <utility>
 
@@ -830,6 +867,852 @@ void testProjectedReferenceGeometryIsLocked() {
     std::cout << " PASS\n";
 }
 
+void testBRepStorageFormats() {
+    std::cout << "Test 18: Body BREP text/binary storage round-trip..." << std::flush;
+
+    // Large body: STEP file from ONECAD_BREP_BENCH_STEP, else a plate with 900 holes
+    TopoDS_Shape body;
+    if (const char* stepPath = std::getenv("ONECAD_BREP_BENCH_STEP")) {
+        auto imported = io::StepImporter::import(QString::fromLocal8Bit(stepPath));
+        if (imported.success && !imported.bodies.empty()) {
+            body = imported.bodies.front().shape;
+        }
+    }
+    if (body.IsNull()) {
+        TopoDS_Compound holes;
+        BRep_Builder builder;
+        builder.MakeCompound(holes);
+        for (int i = 0; i < 30; ++i) {
+            for (int j = 0; j < 30; ++j) {
+                gp_Ax2 axis(gp_Pnt(5.0 + 10.0 * i, 5.0 + 10.0 * j, -1.0), gp::DZ());
+                builder.Add(holes, BRepPrimAPI_MakeCylinder(axis, 3.0, 12.0).Shape());
+            }
+        }
+        body = BRepAlgoAPI_Cut(BRepPrimAPI_MakeBox(300.0, 300.0, 10.0).Shape(), holes).Shape();
+    }
+    assert(!body.IsNull());
+    const double expectedVolume = shapeVolume(body);
+
+    QTemporaryDir dir;
+    assert(dir.isValid());
+    auto package = io::Package::createForWrite(dir.filePath("bench.onecadpkg"));
+    assert(package);
+
+    using Clock = std::chrono::steady_clock;
+    auto millis = [](Clock::time_point a, Clock::time_point b) {
+        return std::chrono::duration<double, std::milli>(b - a).count();
+    };
+
+    std::cout << "\n";
+    for (auto format : {io::BRepFormat::Text, io::BRepFormat::Binary}) {
+        const QString path = QString("bodies/%1.brep").arg(io::BRepIO::formatName(format));
+
+        auto t0 = Clock::now();
+        assert(io::BRepIO::writeShape(package.get(), path, body, format));
+        auto t1 = Clock::now();
+        QString error;
+        TopoDS_Shape loaded = io::BRepIO::readShape(package.get(), path, error);
+        auto t2 = Clock::now();
+
+        assert(!loaded.IsNull());
+        assert(io::BRepIO::detectFormat(package->readFile(path)) == format);
+        assert(nearlyEqual(shapeVolume(loaded), expectedVolume, 1e-6 * expectedVolume));
+
+        std::cout << "  " << io::BRepIO::formatName(format).toStdString()
+                  << ": " << package->readFile(path).size() / 1024 << " KiB"
+                  << ", save " << millis(t0, t1) << " ms"
+                  << ", load " << millis(t1, t2) << " ms\n";
+    }
+
+    std::cout << "  PASS\n";
+}
+
+void testPackageEntryPipeline() {
+    std::cout << "Test 19: Concurrent package entry encode/decode..." << std::flush;
+
+    TopoDS_Compound holes;
+    BRep_Builder builder;
+    builder.MakeCompound(holes);
+    for (int i = 0; i < 10; ++i) {
+        for (int j = 0; j < 10; ++j) {
+            gp_Ax2 axis(gp_Pnt(5.0 + 10.0 * i, 5.0 + 10.0 * j, -1.0), gp::DZ());
+            builder.Add(holes, BRepPrimAPI_MakeCylinder(axis, 3.0, 12.0).Shape());
+        }
+    }
+    const TopoDS_Shape body =
+        BRepAlgoAPI_Cut(BRepPrimAPI_MakeBox(100.0, 100.0, 10.0).Shape(), holes).Shape();
+    assert(!body.IsNull());
+    const double expectedVolume = shapeVolume(body);
+
+    QTemporaryDir dir;
+    assert(dir.isValid());
+    auto package = io::Package::createForWrite(dir.filePath("pipeline.onecadpkg"));
+    assert(package);
+
+    using Clock = std::chrono::steady_clock;
+    auto millis = [](Clock::time_point a, Clock::time_point b) {
+        return std::chrono::duration<double, std::milli>(b - a).count();
+    };
+
+    constexpr int kBodies = 16;
+    auto pathOf = [](int i) { return QString("bodies/body%1.brep").arg(i); };
+    auto streamedPathOf = [](int i) { return QString("bodies/streamed%1.brep").arg(i); };
+
+    std::cout << "\n";
+    for (int threads : {1, 0}) {
+        io::PackageEntryPipeline writer(package.get(), threads);
+        auto t0 = Clock::now();
+        for (int i = 0; i < kBodies; ++i) {
+            writer.write(pathOf(i), [&body](QByteArray& data) {
+                data = io::BRepIO::encodeShape(body, io::BRepFormat::Binary);
+                return !data.isEmpty();
+            });
+        }
+        assert(writer.finish());
+        auto t1 = Clock::now();
+
+        // Streamed entries are encoded on the pool too, via temporary files
+        io::PackageEntryPipeline streamer(package.get(), threads);
+        for (int i = 0; i < kBodies; ++i) {
+            streamer.writeStreamed(streamedPathOf(i), [&body](std::ostream& stream) {
+                return io::BRepIO::writeShape(stream, body, io::BRepFormat::Binary);
+            });
+        }
+        assert(streamer.finish());
+        auto t2 = Clock::now();
+
+        std::vector<TopoDS_Shape> loaded(2 * kBodies);
+        io::PackageEntryPipeline reader(package.get(), threads);
+        for (int i = 0; i < 2 * kBodies; ++i) {
+            TopoDS_Shape& slot = loaded[static_cast<size_t>(i)];
+            const QString path = i < kBodies ? pathOf(i) : streamedPathOf(i - kBodies);
+            reader.read(path, [&slot](const QByteArray& data, QString& error) {
+                slot = io::BRepIO::decodeShape(data, error);
+                return !slot.IsNull();
+            });
+        }
+        assert(reader.finish());
+        auto t3 = Clock::now();
+
+        for (const auto& shape : loaded) {
+            assert(!shape.IsNull());
+            assert(nearlyEqual(shapeVolume(shape), expectedVolume, 1e-6 * expectedVolume));
+        }
+        std::cout << "  " << (threads == 1 ? "1 thread" : "pool") << ": save "
+                  << millis(t0, t1) << " ms, streamed save " << millis(t1, t2)
+                  << " ms, load (both) " << millis(t2, t3) << " ms\n";
+    }
+
+    // Failed and missing entries are reported, not written
+    io::PackageEntryPipeline failing(package.get());
+    failing.write("bodies/failed.brep", [](QByteArray&) { return false; });
+    failing.writeStreamed("bodies/failed-stream.brep", [](std::ostream&) { return false; });
+    failing.read("bodies/missing.brep", [](const QByteArray&, QString&) { return true; });
+    assert(!failing.finish());
+    assert(failing.errors().size() == 3);
+    assert(!package->fileExists("bodies/failed.brep"));
+    assert(!package->fileExists("bodies/failed-stream.brep"));
+
+    std::cout << "  PASS\n";
+}
+
+void testStreamedElementMapStorage() {
+    std::cout << "Test 20: Streamed ElementMap write/read and hashing..." << std::flush;
+
+    namespace em = kernel::elementmap;
+    em::ElementMap map;
+    for (int i = 0; i < 200; ++i) {
+        em::ElementDescriptor desc;
+        desc.shapeType = TopAbs_FACE;
+        desc.center = gp_Pnt(i, 0.5 * i, 1.0);
+        desc.size = 1.0 + i;
+        desc.adjacencyHash = 0x9e3779b97f4a7c15ull * static_cast<uint64_t>(i + 1);
+        map.registerEntry(em::ElementId::From("op-1/face-" + std::to_string(i)),
+                          em::ElementKind::Face, desc, "op-1");
+    }
+
+    QTemporaryDir dir;
+    assert(dir.isValid());
+    auto package = io::Package::createForWrite(dir.filePath("elementmap.onecadpkg"));
+    assert(package);
+    assert(io::ElementMapIO::saveElementMap(package.get(), map));
+
+    // Streamed output parses back to the same document the JSON serializer builds
+    QJsonDocument stored = QJsonDocument::fromJson(package->readFile("topology/elementmap.json"));
+    assert(stored.isObject());
+    assert(stored.object() == io::ElementMapIO::serializeElementMap(map));
+
+    // Manifest hash of the in-memory map equals the streamed hash of the stored entry
+    const QString hash = io::ElementMapIO::computeElementMapHash(map);
+    assert(!hash.isEmpty());
+    assert(hash == io::ElementMapIO::computeStoredElementMapHash(package.get()));
+
+    em::ElementMap loaded;
+    QString error;
+    assert(io::ElementMapIO::loadElementMap(package.get(), loaded, error));
+    assert(loaded.ids().size() == map.ids().size());
+
+    std::cout << " PASS\n";
+}
+
+void testIncrementalPackageReuse() {
+    std::cout << "Test 21: Incremental save reuses unchanged package entries..." << std::flush;
+
+    QTemporaryDir dir;
+    assert(dir.isValid());
+    const QString firstPath = dir.filePath("first.onecadpkg");
+    const QString secondPath = dir.filePath("second.onecadpkg");
+    const QByteArray brep =
+        io::BRepIO::encodeShape(BRepPrimAPI_MakeBox(10.0, 20.0, 30.0).Shape(), io::BRepFormat::Text);
+    assert(!brep.isEmpty());
+
+    // First save: everything is written and hashed
+    QJsonObject firstEntries;
+    {
+        auto target = io::Package::createForWrite(firstPath);
+        assert(target);
+        io::IncrementalPackage package(target.get());
+        assert(package.writeFile("document.json", "{\"version\":1}"));
+        assert(package.writeFile("sketches/a.json", "{\"a\":1}"));
+        assert(package.writeFile("sketches/stale.json", "{\"stale\":1}"));
+        assert(package.writeFileStreamed("bodies/a.brep", [&brep](std::ostream& out) {
+            out.write(brep.constData(), brep.size());
+            return out.good();
+        }));
+        assert(!package.reuseFile("bodies/a.brep"));  // No baseline yet
+        assert(package.finalize());
+        firstEntries = package.entryHashes();
+        assert(package.writtenCount() == 4);
+        assert(package.reusedCount() == 0);
+    }
+    assert(firstEntries["bodies/a.brep"].toString() == io::IncrementalPackage::hashData(brep));
+
+    // Second save against the first: unchanged entries are copied, not rewritten
+    {
+        auto baseline = io::Package::openForRead(firstPath);
+        auto target = io::Package::createForWrite(secondPath);
+        assert(baseline && target);
+        io::IncrementalPackage package(target.get(), baseline.get(), firstEntries, true);
+        assert(package.writeFile("document.json", "{\"version\":2}"));
+        assert(package.writeFile("sketches/a.json", "{\"a\":1}"));
+        assert(package.reuseFile("bodies/a.brep"));
+        assert(!package.reuseFile("bodies/b.brep"));  // Not in the baseline
+        assert(package.finalize());
+        assert(package.writtenCount() == 1);
+        assert(package.reusedCount() == 2);
+        assert(package.entryHashes()["sketches/a.json"] == firstEntries["sketches/a.json"]);
+        assert(package.entryHashes()["document.json"] != firstEntries["document.json"]);
+        assert(target->readFile("bodies/a.brep") == brep);
+    }
+
+    // Untrusted baseline: reuse needs a matching content hash
+    {
+        auto baseline = io::Package::openForRead(firstPath);
+        auto target = io::Package::createForWrite(secondPath);
+        io::IncrementalPackage package(target.get(), baseline.get(), firstEntries, false);
+        assert(!package.reuseFile("bodies/a.brep"));
+        assert(!package.reuseFile("bodies/a.brep", io::IncrementalPackage::hashData("other")));
+        assert(package.reuseFile("bodies/a.brep", io::IncrementalPackage::hashData(brep)));
+    }
+
+    // Saving in place drops entries the document no longer produces
+    {
+        auto baseline = io::Package::openForRead(firstPath);
+        auto target = io::Package::createForWrite(firstPath);
+        io::IncrementalPackage package(target.get(), baseline.get(), firstEntries, true);
+        assert(package.writeFile("sketches/a.json", "{\"a\":1}"));
+        assert(package.reuseFile("bodies/a.brep"));
+        assert(package.finalize());
+        assert(target->fileExists("bodies/a.brep"));
+        assert(!target->fileExists("sketches/stale.json"));
+        assert(!target->fileExists("document.json"));
+    }
+
+    std::cout << " PASS\n";
+}
+
+void testAutosaveSnapshot() {
+    std::cout << "Test 22: Autosave writes a detached snapshot in the background..." << std::flush;
+
+    QTemporaryDir dir;
+    assert(dir.isValid());
+    qputenv("ONECAD_RECOVERY_DIR", dir.path().toUtf8());
+
+    app::Document doc;
+    const std::string bodyId = doc.addBody(BRepPrimAPI_MakeBox(20.0, 20.0, 10.0).Shape());
+    auto sketch = std::make_unique<core::sketch::Sketch>();
+    sketch->addLine(0.0, 0.0, 10.0, 0.0);
+    const std::string sketchId = doc.addSketch(std::move(sketch));
+    assert(doc.isModified());
+
+    // Snapshot shares shapes but is unaffected by later edits
+    auto snapshot = doc.createSnapshot();
+    assert(snapshot->getBodyShape(bodyId)->IsSame(*doc.getBodyShape(bodyId)));
+    assert(snapshot->bodyShapeRevision(bodyId) == doc.bodyShapeRevision(bodyId));
+    const kernel::elementmap::ElementMap* sharedMap = &doc.elementMap();
+    assert(&snapshot->elementMap() == sharedMap);
+    const size_t mappedElements = sharedMap->ids().size();
+    doc.updateBodyShape(bodyId, BRepPrimAPI_MakeBox(5.0, 5.0, 5.0).Shape());
+    assert(snapshot->bodyShapeRevision(bodyId) != doc.bodyShapeRevision(bodyId));
+    assert(nearlyEqual(shapeVolume(*snapshot->getBodyShape(bodyId)), 4000.0));
+    // The edit copied the document's ElementMap; the snapshot kept the old one
+    assert(&doc.elementMap() != sharedMap && &snapshot->elementMap() == sharedMap);
+    assert(snapshot->elementMap().ids().size() == mappedElements);
+    assert(snapshot->isSketchLoaded(sketchId));
+    assert(snapshot->getSketch(sketchId) != doc.getSketch(sketchId));
+    assert(snapshot->getSketch(sketchId)->getEntityCount() == doc.getSketch(sketchId)->getEntityCount());
+    doc.getSketch(sketchId)->addLine(0.0, 5.0, 10.0, 5.0);
+    assert(snapshot->getSketch(sketchId)->getEntityCount() < doc.getSketch(sketchId)->getEntityCount());
+
+    QString packagePath;
+    {
+        io::AutosaveService autosave;
+        autosave.setIntervalSeconds(0);
+        autosave.setDocument(&doc);
+
+        QEventLoop loop;
+        QObject::connect(&autosave, &io::AutosaveService::autosaved, &loop,
+                         [&](const QString& path, qint64) {
+                             packagePath = path;
+                             loop.quit();
+                         });
+        QObject::connect(&autosave, &io::AutosaveService::autosaveFailed, &loop, &QEventLoop::quit);
+        assert(autosave.autosaveNow());
+        assert(!autosave.autosaveNow());  // One save at a time
+        loop.exec();
+        assert(!packagePath.isEmpty());
+
+        // Held by this session, so not offered for recovery
+        assert(io::AutosaveService::findOrphanedRecoveries().empty());
+
+        QString error;
+        auto recovered = io::OneCADFileIO::load(packagePath, error);
+        assert(recovered);
+        assert(recovered->bodyCount() == 1);
+        assert(recovered->sketchCount() == 1);
+        assert(nearlyEqual(shapeVolume(*recovered->getBodyShape(bodyId)), 125.0));
+    }
+
+    // Clean shutdown leaves nothing behind
+    assert(!QFileInfo::exists(packagePath));
+    assert(io::AutosaveService::findOrphanedRecoveries().empty());
+    qunsetenv("ONECAD_RECOVERY_DIR");
+
+    std::cout << " PASS\n";
+}
+
+struct FailingEntryLoader : app::DocumentEntryLoader {
+    int attempts = 0;
+
+    std::unique_ptr<core::sketch::Sketch> loadSketch(const std::string&, std::string& error) override {
+        ++attempts;
+        error = "unreadable";
+        return nullptr;
+    }
+    TopoDS_Shape loadBodyShape(const std::string&, std::string& error) override {
+        ++attempts;
+        error = "unreadable";
+        return TopoDS_Shape();
+    }
+};
+
+void testLazyEntryLoading() {
+    std::cout << "Test 23: Sketches and hidden bodies load on first access..." << std::flush;
+
+    QTemporaryDir dir;
+    assert(dir.isValid());
+    const QString path = dir.filePath("lazy.onecadpkg");
+
+    std::string visibleId;
+    std::string hiddenId;
+    std::string sketchId;
+    {
+        app::Document doc;
+        visibleId = doc.addBody(BRepPrimAPI_MakeBox(10.0, 10.0, 10.0).Shape());
+        hiddenId = doc.addBody(BRepPrimAPI_MakeBox(2.0, 3.0, 4.0).Shape());
+        doc.setBodyVisible(hiddenId, false);
+        auto sketch = std::make_unique<core::sketch::Sketch>();
+        sketch->addLine(0.0, 0.0, 10.0, 0.0);
+        sketchId = doc.addSketch(std::move(sketch));
+        assert(io::OneCADFileIO::save(path, &doc).success);
+    }
+
+    QString error;
+    auto loaded = io::OneCADFileIO::load(path, error);
+    assert(loaded);
+    // Metadata is available up front, content is not
+    assert(loaded->bodyCount() == 2);
+    assert(loaded->sketchCount() == 1);
+    assert(loaded->isBodyLoaded(visibleId));
+    assert(!loaded->isBodyLoaded(hiddenId));
+    assert(!loaded->isSketchLoaded(sketchId));
+    assert(!loaded->isBodyVisible(hiddenId));
+    assert(loaded->getBodyName(hiddenId) == "Body 2");
+    assert(loaded->pendingEntryCount() == 2);
+
+    // Saving in place keeps pending entries without loading them
+    assert(io::OneCADFileIO::save(path, loaded.get()).success);
+    assert(loaded->pendingEntryCount() == 2);
+
+    assert(loaded->getSketch(sketchId));
+    assert(loaded->getSketch(sketchId)->getEntityCount() > 0);
+    const TopoDS_Shape* hidden = loaded->getBodyShape(hiddenId);
+    assert(hidden && nearlyEqual(shapeVolume(*hidden), 24.0));
+    assert(loaded->isBodyLoaded(hiddenId));
+    assert(!loaded->isBodyVisible(hiddenId));
+    assert(loaded->pendingEntryCount() == 0);
+
+    // Entries reused by the in-place save are intact
+    auto reloaded = io::OneCADFileIO::load(path, error);
+    assert(reloaded);
+    reloaded->setBodyVisible(hiddenId, true);
+    assert(reloaded->isBodyLoaded(hiddenId));
+    assert(reloaded->isBodyVisible(hiddenId));
+    assert(reloaded->loadPendingEntries());
+    assert(reloaded->getSketch(sketchId)->getEntityCount() ==
+           loaded->getSketch(sketchId)->getEntityCount());
+
+    // A failed load keeps the entry pending, reports it once, and saving in
+    // place still carries the stored copy over
+    auto broken = io::OneCADFileIO::load(path, error);
+    assert(broken);
+    auto failing = std::make_shared<FailingEntryLoader>();
+    broken->setEntryLoader(failing);
+    int reported = 0;
+    QObject::connect(broken.get(), &app::Document::pendingEntryLoadFailed,
+                     [&reported](const QString&, const QString& name, const QString& message) {
+        assert(!name.isEmpty());
+        assert(message == "unreadable");
+        ++reported;
+    });
+    assert(!broken->getBodyShape(hiddenId));
+    assert(!broken->getBodyShape(hiddenId));
+    assert(failing->attempts == 1);
+    assert(reported == 1);
+    assert(!broken->loadPendingEntries());
+    assert(broken->entryLoader() == failing.get());
+    assert(broken->pendingEntryCount() == 2);
+    assert(broken->getBodyName(hiddenId) == "Body 2");
+    assert(io::OneCADFileIO::save(path, broken.get()).success);
+
+    auto restored = io::OneCADFileIO::load(path, error);
+    assert(restored);
+    assert(restored->loadPendingEntries());
+    assert(restored->getBodyShape(hiddenId));
+    assert(restored->getSketch(sketchId));
+
+    std::cout << " PASS\n";
+}
+
+void testStepImportStreaming() {
+    std::cout << "Test 24: STEP import streams bodies per root and cancels..." << std::flush;
+
+    QTemporaryDir dir;
+    assert(dir.isValid());
+    const QString path = dir.filePath("parts.step");
+    std::vector<TopoDS_Shape> parts = {
+        BRepPrimAPI_MakeBox(10.0, 10.0, 10.0).Shape(),
+        BRepPrimAPI_MakeBox(gp_Pnt(20.0, 0.0, 0.0), 2.0, 3.0, 4.0).Shape(),
+    };
+    assert(io::StepExporter::exportShapes(path, parts).success);
+
+    app::Document doc;
+    std::vector<io::ImportedBody> streamed;
+    std::vector<double> fractions;
+    int prepared = 0;
+    io::StepImportControl control;
+    control.onProgress = [&fractions](double fraction, const QString&) {
+        fractions.push_back(fraction);
+    };
+    control.prepareBody = [&doc, &prepared](const TopoDS_Shape& shape) {
+        assert(doc.prepareBodyMesh(shape));
+        ++prepared;
+    };
+    control.onBody = [&streamed](io::ImportedBody body) { streamed.push_back(std::move(body)); };
+
+    io::StepImportResult result = io::StepImporter::import(path, control);
+    assert(result.success);
+    assert(result.bodies.empty());
+    assert(result.bodyCount == 2);
+    assert(streamed.size() == 2 && prepared == 2);
+    assert(streamed.front().name == "Imported Body 1");
+    assert(nearlyEqual(shapeVolume(streamed.front().shape), 1000.0));
+    assert(nearlyEqual(shapeVolume(streamed.back().shape), 24.0));
+    assert(!fractions.empty() && nearlyEqual(fractions.back(), 1.0));
+    assert(std::is_sorted(fractions.begin(), fractions.end()));
+
+    // Bodies arrive triangulated, so adding them reuses the mesh
+    TopExp_Explorer faceExp(streamed.front().shape, TopAbs_FACE);
+    TopLoc_Location location;
+    assert(!BRep_Tool::Triangulation(TopoDS::Face(faceExp.Current()), location).IsNull());
+
+    // Plain import still collects bodies in order
+    io::StepImportResult plain = io::StepImporter::import(path);
+    assert(plain.success && plain.bodies.size() == 2 && plain.bodyCount == 2);
+    assert(plain.bodies.back().name == "Imported Body 2");
+
+    // Cancelled imports deliver nothing
+    std::atomic<bool> cancelled{true};
+    int delivered = 0;
+    io::StepImportControl cancelControl;
+    cancelControl.cancelFlag = &cancelled;
+    cancelControl.onBody = [&delivered](io::ImportedBody) { ++delivered; };
+    io::StepImportResult cancelledResult = io::StepImporter::import(path, cancelControl);
+    assert(!cancelledResult.success);
+    assert(cancelledResult.cancelled);
+    assert(delivered == 0 && cancelledResult.bodyCount == 0);
+
+    std::cout << " PASS\n";
+}
+
+void testStepExportProgress() {
+    std::cout << "Test 25: STEP export reports progress and cancels before writing..." << std::flush;
+
+    QTemporaryDir dir;
+    assert(dir.isValid());
+    std::vector<TopoDS_Shape> parts = {
+        BRepPrimAPI_MakeBox(10.0, 10.0, 10.0).Shape(),
+        BRepPrimAPI_MakeBox(gp_Pnt(20.0, 0.0, 0.0), 2.0, 3.0, 4.0).Shape(),
+    };
+
+    const QString path = dir.filePath("parts.step");
+    std::vector<double> fractions;
+    io::StepExportControl control;
+    control.onProgress = [&fractions](double fraction, const QString&) {
+        fractions.push_back(fraction);
+    };
+    io::StepExportResult result = io::StepExporter::exportShapes(path, parts, control);
+    assert(result.success && result.bodyCount == 2);
+    assert(!fractions.empty() && nearlyEqual(fractions.back(), 1.0));
+    assert(std::is_sorted(fractions.begin(), fractions.end()));
+
+    io::StepImportResult imported = io::StepImporter::import(path);
+    assert(imported.success && imported.bodies.size() == 2);
+
+    // Cancelled exports leave no file behind
+    const QString cancelledPath = dir.filePath("cancelled.step");
+    std::atomic<bool> cancelled{true};
+    io::StepExportControl cancelControl;
+    cancelControl.cancelFlag = &cancelled;
+    io::StepExportResult cancelledResult =
+        io::StepExporter::exportShapes(cancelledPath, parts, cancelControl);
+    assert(!cancelledResult.success && cancelledResult.cancelled);
+    assert(!QFileInfo::exists(cancelledPath));
+
+    std::cout << " PASS\n";
+}
+
+void testMeshExport() {
+    std::cout << "Test 26: Streaming STL/OBJ/3MF mesh export..." << std::flush;
+
+    // Bodies: STEP file from ONECAD_MESH_BENCH_STEP, else 8 plates with 100 holes
+    std::vector<io::MeshExportBody> bodies;
+    if (const char* stepPath = std::getenv("ONECAD_MESH_BENCH_STEP")) {
+        auto imported = io::StepImporter::import(QString::fromLocal8Bit(stepPath));
+        for (auto& body : imported.bodies) {
+            bodies.push_back({body.name.toStdString(), body.shape});
+        }
+    }
+    if (bodies.empty()) {
+        TopoDS_Compound holes;
+        BRep_Builder builder;
+        builder.MakeCompound(holes);
+        for (int i = 0; i < 10; ++i) {
+            for (int j = 0; j < 10; ++j) {
+                gp_Ax2 axis(gp_Pnt(5.0 + 10.0 * i, 5.0 + 10.0 * j, -1.0), gp::DZ());
+                builder.Add(holes, BRepPrimAPI_MakeCylinder(axis, 3.0, 12.0).Shape());
+            }
+        }
+        for (int k = 0; k < 8; ++k) {
+            gp_Trsf offset;
+            offset.SetTranslation(gp_Vec(0.0, 0.0, 20.0 * k));
+            const TopoDS_Shape plate = BRepAlgoAPI_Cut(
+                BRepPrimAPI_MakeBox(gp_Pnt(0.0, 0.0, 20.0 * k), 100.0, 100.0, 10.0).Shape(),
+                holes.Moved(TopLoc_Location(offset))).Shape();
+            bodies.push_back({"Plate " + std::to_string(k + 1), plate});
+        }
+    }
+
+    // Display tessellation, reused when no deflection is requested
+    app::Document doc;
+    for (const auto& body : bodies) {
+        assert(doc.prepareBodyMesh(body.shape));
+    }
+    TopLoc_Location location;
+    TopExp_Explorer firstFace(bodies.front().shape, TopAbs_FACE);
+    const Handle(Poly_Triangulation) displayMesh =
+        BRep_Tool::Triangulation(TopoDS::Face(firstFace.Current()), location);
+    assert(!displayMesh.IsNull());
+
+    QTemporaryDir dir;
+    assert(dir.isValid());
+
+    using Clock = std::chrono::steady_clock;
+    auto millis = [](Clock::time_point a, Clock::time_point b) {
+        return std::chrono::duration<double, std::milli>(b - a).count();
+    };
+
+    std::cout << "\n";
+    for (double deflection : {0.0, 0.01}) {
+        for (auto format : {io::MeshFormat::BinaryStl, io::MeshFormat::Obj, io::MeshFormat::ThreeMf}) {
+            if (format == io::MeshFormat::ThreeMf && !io::ZipPackage::isSupported()) {
+                continue;
+            }
+            const QString suffix = io::MeshExporter::formatName(format).toLower();
+            const QString path = dir.filePath(QString("mesh.%1").arg(suffix));
+            assert(io::MeshExporter::formatForPath(path) == format);
+
+            io::MeshExportOptions options;
+            options.format = format;
+            options.linearDeflection = deflection;
+            auto t0 = Clock::now();
+            io::MeshExportResult result = io::MeshExporter::exportBodies(path, bodies, options);
+            auto t1 = Clock::now();
+            assert(result.success);
+            assert(result.bodyCount == static_cast<int>(bodies.size()));
+            assert(result.triangleCount > 0);
+            assert(result.bytesWritten == QFileInfo(path).size());
+
+            if (format == io::MeshFormat::BinaryStl) {
+                assert(result.bytesWritten ==
+                       84 + 50 * static_cast<qint64>(result.triangleCount));
+            } else if (format == io::MeshFormat::Obj) {
+                QFile file(path);
+                assert(file.open(QIODevice::ReadOnly));
+                uint64_t faces = 0;
+                while (!file.atEnd()) {
+                    faces += file.readLine().startsWith("f ") ? 1 : 0;
+                }
+                assert(faces == result.triangleCount);
+            } else {
+                auto package = io::ZipPackage::openRead(path);
+                assert(package);
+                assert(package->fileExists("[Content_Types].xml"));
+                const QByteArray model = package->readFile("3D/3dmodel.model");
+                assert(static_cast<uint64_t>(model.count("<triangle ")) == result.triangleCount);
+            }
+
+            const double ms = std::max(millis(t0, t1), 0.001);
+            std::cout << "  " << io::MeshExporter::formatName(format).toStdString()
+                      << (deflection > 0.0 ? " re-meshed" : " display mesh") << ": "
+                      << result.triangleCount << " triangles, "
+                      << result.bytesWritten / 1024 << " KiB, " << ms << " ms, "
+                      << result.triangleCount / ms / 1000.0 << " Mtri/s\n";
+        }
+    }
+
+    // Re-meshing works on copies; the display tessellation is untouched
+    assert(BRep_Tool::Triangulation(TopoDS::Face(firstFace.Current()), location) == displayMesh);
+
+    // Cancelled exports leave no file behind
+    std::atomic<bool> cancelled{true};
+    io::MeshExportOptions cancelOptions;
+    cancelOptions.cancelFlag = &cancelled;
+    const QString cancelledPath = dir.filePath("cancelled.stl");
+    io::MeshExportResult cancelledResult =
+        io::MeshExporter::exportBodies(cancelledPath, bodies, cancelOptions);
+    assert(!cancelledResult.success && cancelledResult.cancelled);
+    assert(!QFileInfo::exists(cancelledPath));
+
+    std::cout << "  PASS\n";
+}
+
+void testChangeSetCoalescing() {
+    std::cout << "Test 27: Body changes are delivered as one coalesced delta..." << std::flush;
+
+    app::Document doc;
+    std::vector<app::DocumentChangeSet> delivered;
+    QObject::connect(&doc, &app::Document::changesCommitted,
+                     [&](const app::DocumentChangeSet& changes) { delivered.push_back(changes); });
+
+    const TopoDS_Shape box = BRepPrimAPI_MakeBox(10.0, 10.0, 10.0).Shape();
+    std::string keptId;
+    {
+        // Explicit batch: delivered once when it ends, net effect only
+        app::Document::ChangeBatch batch(&doc);
+        keptId = doc.addBody(box);
+        const std::string transientId = doc.addBody(box);
+        doc.updateBodyShape(keptId, BRepPrimAPI_MakeBox(5.0, 5.0, 5.0).Shape());
+        doc.removeBody(transientId);
+        doc.setBodyVisible(keptId, false);
+        doc.setBodyVisible(keptId, true);
+        assert(delivered.empty());
+    }
+    assert(delivered.size() == 1);
+    assert(delivered[0].added.size() == 1 && delivered[0].added.count(keptId) == 1);
+    assert(delivered[0].removed.empty());
+    assert(delivered[0].updated.empty());
+    assert(delivered[0].visibilityChanged.empty());
+
+    // Outside a batch: everything in one event-loop iteration is coalesced
+    const std::string otherId = doc.addBody(box);
+    doc.removeBody(keptId);
+    doc.addBodyWithId(keptId, box);
+    doc.setBodyVisible(otherId, false);
+    doc.isolateItem(keptId);
+    assert(delivered.size() == 1);
+    QCoreApplication::processEvents();
+    assert(delivered.size() == 2);
+    const app::DocumentChangeSet& tick = delivered[1];
+    assert(tick.added.size() == 1 && tick.added.count(otherId) == 1);
+    assert(tick.updated.size() == 1 && tick.updated.count(keptId) == 1);
+    assert(tick.removed.empty());
+    assert(tick.visibilityChanged.count(otherId) == 1);
+    assert(tick.isolationChanged);
+
+    // Nothing left over, and an explicit flush delivers immediately
+    QCoreApplication::processEvents();
+    assert(delivered.size() == 2);
+    doc.clearIsolation();
+    doc.flushChanges();
+    assert(delivered.size() == 3);
+    assert(delivered[2].isolationChanged);
+    assert(!doc.hasPendingChanges());
+
+    doc.clear();
+    doc.flushChanges();
+    assert(delivered.size() == 4 && delivered[3].cleared);
+
+    std::cout << " PASS\n";
+}
+
+void testBodyCacheTrust() {
+    std::cout << "Test 28: BREP cache trust checks and background verification..." << std::flush;
+
+    QTemporaryDir dir;
+    assert(dir.isValid());
+    const QString path = dir.filePath("cached.onecadpkg");
+
+    std::string sketchId;
+    std::string bodyId;
+    {
+        app::Document doc;
+        auto sketch = std::make_unique<core::sketch::Sketch>();
+        auto p1 = sketch->addPoint(0.0, 0.0);
+        auto p2 = sketch->addPoint(10.0, 0.0);
+        auto p3 = sketch->addPoint(10.0, 10.0);
+        auto p4 = sketch->addPoint(0.0, 10.0);
+        sketch->addLine(p1, p2);
+        sketch->addLine(p2, p3);
+        sketch->addLine(p3, p4);
+        sketch->addLine(p4, p1);
+        sketchId = doc.addSketch(std::move(sketch));
+
+        bodyId = newId();
+        app::OperationRecord op;
+        op.opId = newId();
+        op.type = app::OperationType::Extrude;
+        op.input = app::SketchRegionRef{sketchId, firstRegionId(*doc.getSketch(sketchId))};
+        op.params = app::ExtrudeParams{20.0, 0.0, app::BooleanMode::NewBody};
+        op.resultBodyIds.push_back(bodyId);
+        doc.addOperation(op);
+
+        app::history::RegenerationEngine engine(&doc);
+        assert(engine.regenerateAll().status == app::history::RegenStatus::Success);
+        assert(io::OneCADFileIO::save(path, &doc).success);
+    }
+
+    const QString manifestPath = QDir(path).filePath("manifest.json");
+    auto writeManifest = [&manifestPath](const QJsonObject& manifest) {
+        QFile file(manifestPath);
+        const bool opened = file.open(QIODevice::WriteOnly | QIODevice::Truncate);
+        assert(opened);
+        file.write(QJsonDocument(manifest).toJson());
+    };
+    auto withValue = [](QJsonObject object, const QString& group, const QString& key,
+                        const QJsonValue& value) {
+        QJsonObject inner = object[group].toObject();
+        inner[key] = value;
+        object[group] = inner;
+        return object;
+    };
+
+    QJsonObject manifest;
+    {
+        QFile file(manifestPath);
+        const bool opened = file.open(QIODevice::ReadOnly);
+        assert(opened);
+        manifest = QJsonDocument::fromJson(file.readAll()).object();
+    }
+    const QString opsHash = manifest["hashes"].toObject()["opsHash"].toString();
+    const QString elementMapHash = manifest["hashes"].toObject()["elementMapHash"].toString();
+    assert(!opsHash.isEmpty() && !elementMapHash.isEmpty());
+
+    // checkBodyCache(): each input can reject the cache
+    assert(io::ManifestIO::checkBodyCache(manifest, opsHash, elementMapHash).isEmpty());
+    const QJsonObject otherKernel = withValue(manifest, "kernel", "version", "0.0.0");
+    assert(io::ManifestIO::checkBodyCache(otherKernel, opsHash, elementMapHash)
+               .startsWith("Kernel version changed"));
+    assert(io::ManifestIO::checkBodyCache(manifest, "other", elementMapHash) == "Operations hash mismatch");
+    assert(io::ManifestIO::checkBodyCache(manifest, {}, elementMapHash) == "Operations hash mismatch");
+    assert(io::ManifestIO::checkBodyCache(manifest, opsHash, "other") == "ElementMap hash mismatch");
+    assert(!io::ManifestIO::checkBodyCache(withValue(manifest, "contents", "bodyCacheComplete", false),
+                                           opsHash, elementMapHash).isEmpty());
+
+    // Load: a trusted cache defers verification, a rejected one regenerates
+    QString error;
+    {
+        auto loaded = io::OneCADFileIO::load(path, error);
+        assert(loaded && loaded->isHistoryVerificationPending());
+        assert(nearlyEqual(shapeVolume(*loaded->getBodyShape(bodyId)), 2000.0));
+    }
+    const std::vector<QJsonObject> rejected = {
+        otherKernel,
+        withValue(manifest, "hashes", "opsHash", "other"),
+        withValue(manifest, "hashes", "elementMapHash", "other"),
+    };
+    for (const auto& rejectedManifest : rejected) {
+        writeManifest(rejectedManifest);
+        auto loaded = io::OneCADFileIO::load(path, error);
+        assert(loaded && !loaded->isHistoryVerificationPending());
+        assert(nearlyEqual(shapeVolume(*loaded->getBodyShape(bodyId)), 2000.0));
+    }
+    writeManifest(manifest);
+
+    // A stale BREP passes the manifest checks; verification replaces it
+    {
+        QFile brep(QDir(path).filePath(QString("bodies/%1.brep").arg(QString::fromStdString(bodyId))));
+        const bool opened = brep.open(QIODevice::WriteOnly | QIODevice::Truncate);
+        assert(opened);
+        brep.write(io::BRepIO::encodeShape(BRepPrimAPI_MakeBox(1.0, 2.0, 3.0).Shape(),
+                                           io::BRepFormat::Text));
+    }
+    auto stale = io::OneCADFileIO::load(path, error);
+    assert(stale && stale->isHistoryVerificationPending());
+    assert(nearlyEqual(shapeVolume(*stale->getBodyShape(bodyId)), 6.0));
+    assert(!stale->isSketchLoaded(sketchId));
+
+    io::HistoryVerificationJob job;
+    std::optional<io::HistoryVerificationResult> verified;
+    QEventLoop loop;
+    QObject::connect(&job, &io::HistoryVerificationJob::finished, &loop,
+                     [&](const io::HistoryVerificationResult& result) {
+                         verified = result;
+                         loop.quit();
+                     });
+    job.start(stale.get());
+    loop.exec();
+    assert(verified && verified->success && verified->failures.empty());
+    assert(verified->changedBodies.count(bodyId) == 1);
+    // The replay ran on a snapshot: nothing changed or loaded yet
+    assert(stale->isHistoryVerificationPending());
+    assert(!stale->isSketchLoaded(sketchId));
+    assert(nearlyEqual(shapeVolume(*stale->getBodyShape(bodyId)), 6.0));
+
+    // A result for other operations is not applied
+    io::HistoryVerificationResult outdated = *verified;
+    outdated.opsHash = "other";
+    assert(!io::HistoryVerificationJob::apply(stale.get(), outdated));
+    assert(stale->isHistoryVerificationPending());
+
+    assert(io::HistoryVerificationJob::apply(stale.get(), *verified));
+    assert(!stale->isHistoryVerificationPending());
+    assert(stale->isModified());
+    assert(nearlyEqual(shapeVolume(*stale->getBodyShape(bodyId)), 2000.0));
+
+    std::cout << " PASS\n";
+}
+
 int main(int argc, char* argv[]) {
     QCoreApplication app(argc, argv);
 
@@ -852,6 +1735,17 @@ int main(int argc, char* argv[]) {
     testSketchHostProjectionVersionRequired();
     testSelectionPriorityPrefersSketchRegion();
     testProjectedReferenceGeometryIsLocked();
+    testBRepStorageFormats();
+    testPackageEntryPipeline();
+    testStreamedElementMapStorage();
+    testIncrementalPackageReuse();
+    testAutosaveSnapshot();
+    testLazyEntryLoading();
+    testStepImportStreaming();
+    testStepExportProgress();
+    testMeshExport();
+    testChangeSetCoalescing();
+    testBodyCacheTrust();
 
     std::cout << "\n=== All tests passed! ===\n\n";
     return 0;
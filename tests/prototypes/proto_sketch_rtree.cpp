@@ -0,0 +1,183 @@
+#include "sketch/SpatialRTree.h"
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace onecad::core::sketch;
+
+namespace {
+
+BoundingBox2d makeBox(double minX, double minY, double maxX, double maxY) {
+    BoundingBox2d box;
+    box.minX = std::min(minX, maxX);
+    box.minY = std::min(minY, maxY);
+    box.maxX = std::max(minX, maxX);
+    box.maxY = std::max(minY, maxY);
+    return box;
+}
+
+std::vector<EntityID> bruteQuery(const std::unordered_map<EntityID, BoundingBox2d>& boxes,
+                                 const BoundingBox2d& query) {
+    std::vector<EntityID> result;
+    for (const auto& [id, box] : boxes) {
+        if (box.intersects(query)) {
+            result.push_back(id);
+        }
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+// Mix of points, short segments, long lines and huge circles.
+BoundingBox2d randomBox(std::mt19937& rng) {
+    std::uniform_real_distribution<double> pos(-500.0, 500.0);
+    std::uniform_int_distribution<int> kind(0, 3);
+    const double x = pos(rng);
+    const double y = pos(rng);
+    switch (kind(rng)) {
+        case 0:
+            return makeBox(x, y, x, y);
+        case 1:
+            return makeBox(x, y, x + 3.0, y - 2.0);
+        case 2:
+            return makeBox(x, y, x + 800.0, y);
+        default:
+            return makeBox(x - 200.0, y - 200.0, x + 200.0, y + 200.0);
+    }
+}
+
+} // namespace
+
+int main() {
+    {
+        SpatialRTree tree;
+        assert(tree.empty());
+        assert(tree.query(makeBox(-1, -1, 1, 1)).empty());
+        assert(tree.nearest({0.0, 0.0}, 3).empty());
+        assert(!tree.remove("missing"));
+
+        tree.insert("a", makeBox(0, 0, 0, 0));
+        tree.insert("b", makeBox(10, 0, 20, 0));
+        assert(tree.size() == 2);
+        assert(tree.query(makeBox(-1, -1, 1, 1)) == std::vector<EntityID>{"a"});
+
+        // Re-insert replaces the stored box.
+        tree.insert("a", makeBox(50, 50, 51, 51));
+        assert(tree.size() == 2);
+        assert(tree.query(makeBox(-1, -1, 1, 1)).empty());
+
+        tree.update("b", makeBox(-2, -2, -1, -1));
+        assert(tree.query(makeBox(-1.5, -1.5, -1.5, -1.5)) == std::vector<EntityID>{"b"});
+
+        assert(tree.remove("a"));
+        assert(!tree.contains("a"));
+        assert(tree.size() == 1);
+    }
+
+    // Randomized insert/update/remove against brute force.
+    {
+        std::mt19937 rng(99);
+        SpatialRTree tree;
+        std::unordered_map<EntityID, BoundingBox2d> boxes;
+        std::uniform_int_distribution<int> op(0, 9);
+        std::uniform_real_distribution<double> pos(-600.0, 600.0);
+
+        for (int step = 0; step < 4000; ++step) {
+            const int action = op(rng);
+            if (action < 5 || boxes.empty()) {
+                const EntityID id = "e" + std::to_string(step);
+                const BoundingBox2d box = randomBox(rng);
+                tree.insert(id, box);
+                boxes[id] = box;
+            } else {
+                auto it = boxes.begin();
+                std::advance(it, std::uniform_int_distribution<size_t>(0, boxes.size() - 1)(rng));
+                if (action < 8) {
+                    const BoundingBox2d box = randomBox(rng);
+                    tree.update(it->first, box);
+                    it->second = box;
+                } else {
+                    assert(tree.remove(it->first));
+                    boxes.erase(it);
+                }
+            }
+
+            if (step % 50 == 0) {
+                const double x = pos(rng);
+                const double y = pos(rng);
+                const BoundingBox2d query = makeBox(x, y, x + 25.0, y + 10.0);
+                std::vector<EntityID> fast = tree.query(query);
+                std::sort(fast.begin(), fast.end());
+                assert(fast == bruteQuery(boxes, query));
+                assert(tree.size() == boxes.size());
+            }
+        }
+
+        // k-nearest by box distance matches a full sort.
+        for (int i = 0; i < 20; ++i) {
+            const Vec2d point{pos(rng), pos(rng)};
+            std::vector<double> expected;
+            for (const auto& [id, box] : boxes) {
+                expected.push_back(SpatialRTree::boxDistance(point, box));
+            }
+            std::sort(expected.begin(), expected.end());
+            const auto knn = tree.nearest(point, 5);
+            assert(knn.size() == std::min<size_t>(5, boxes.size()));
+            for (size_t k = 0; k < knn.size(); ++k) {
+                assert(std::abs(knn[k].second - expected[k]) < 1e-9);
+            }
+        }
+    }
+
+    // Exact distance refinement reorders candidates whose boxes overlap the point.
+    {
+        SpatialRTree tree;
+        tree.insert("diagonal", makeBox(0, 0, 100, 100));
+        tree.insert("near", makeBox(49, 52, 49, 52));
+        const auto exact = [](const EntityID& id, const BoundingBox2d& box) {
+            if (id == "diagonal") {
+                return 40.0;  // Pretend the real curve is far from the query.
+            }
+            return SpatialRTree::boxDistance({50.0, 50.0}, box);
+        };
+        const auto result = tree.nearest({50.0, 50.0}, 2, 100.0, exact);
+        assert(result.size() == 2);
+        assert(result[0].first == "near");
+        assert(result[1].first == "diagonal");
+        assert(std::abs(result[1].second - 40.0) < 1e-12);
+
+        const auto bounded = tree.nearest({50.0, 50.0}, 2, 10.0, exact);
+        assert(bounded.size() == 1);
+    }
+
+    // Scaling: long lines must not degrade queries the way fixed cells did.
+    {
+        std::mt19937 rng(5);
+        SpatialRTree tree;
+        for (int i = 0; i < 20000; ++i) {
+            tree.insert("s" + std::to_string(i), randomBox(rng));
+        }
+        std::uniform_real_distribution<double> pos(-500.0, 500.0);
+        auto t0 = std::chrono::steady_clock::now();
+        size_t hits = 0;
+        for (int i = 0; i < 1000; ++i) {
+            const double x = pos(rng);
+            const double y = pos(rng);
+            hits += tree.query(makeBox(x - 2.0, y - 2.0, x + 2.0, y + 2.0)).size();
+        }
+        auto t1 = std::chrono::steady_clock::now();
+        std::cout << "R-tree: 20000 mixed boxes, height " << tree.height() << ", 1000 queries "
+                  << std::chrono::duration<double, std::milli>(t1 - t0).count() << " ms ("
+                  << hits << " hits)" << std::endl;
+    }
+
+    std::cout << "Sketch R-tree prototype: OK" << std::endl;
+    return 0;
+}
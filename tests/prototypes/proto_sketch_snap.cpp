@@ -1,7 +1,11 @@
 #include "sketch/SnapManager.h"
+#include "sketch/AutoConstrainer.h"
+#include "sketch/IntersectionManager.h"
 #include "sketch/Sketch.h"
+#include "sketch/SketchArc.h"
 #include "sketch/SketchLine.h"
 #include "sketch/tools/SketchToolManager.h"
+#include "sketch/tools/TrimEngine.h"
 
 #include <algorithm>
 #include <chrono>
@@ -835,6 +839,211 @@ TestResult testSpatialHashEquivalentToBruteforce() {
     return {true, "", ""};
 }
 
+TestResult test_spatial_index_tracks_incremental_edits() {
+    Sketch sketch;
+    std::mt19937 rng(2024);
+    std::uniform_real_distribution<double> pointDist(-60.0, 60.0);
+
+    std::vector<EntityID> points;
+    for (int i = 0; i < 60; ++i) {
+        points.push_back(sketch.addPoint(pointDist(rng), pointDist(rng)));
+    }
+    std::vector<EntityID> lines;
+    for (int i = 0; i < 20; ++i) {
+        lines.push_back(sketch.addLine(points[2 * i], points[2 * i + 1]));
+    }
+    for (int i = 40; i < 48; ++i) {
+        sketch.addCircle(points[i], 4.0);
+    }
+
+    SnapManager fast;
+    fast.setSpatialHashEnabled(true);
+    SnapManager brute;
+    brute.setSpatialHashEnabled(false);
+
+    auto compareAt = [&](const Vec2d& cursor) -> TestResult {
+        auto fastSnaps = fast.findAllSnaps(cursor, sketch);
+        auto bruteSnaps = brute.findAllSnaps(cursor, sketch);
+        std::sort(fastSnaps.begin(), fastSnaps.end());
+        std::sort(bruteSnaps.begin(), bruteSnaps.end());
+        if (fastSnaps.size() != bruteSnaps.size()) {
+            return {false, std::to_string(bruteSnaps.size()), std::to_string(fastSnaps.size())};
+        }
+        for (size_t i = 0; i < fastSnaps.size(); ++i) {
+            if (!snapResultsEqual(fastSnaps[i], bruteSnaps[i])) {
+                return {false, "identical snap sets", "mismatch at index " + std::to_string(i)};
+            }
+        }
+        return {true, "", ""};
+    };
+
+    std::uniform_int_distribution<size_t> pick(0, points.size() - 1);
+    for (int round = 0; round < 40; ++round) {
+        const uint64_t revisionBefore = sketch.geometryRevision();
+        const EntityID& movedId = points[pick(rng)];
+        auto* moved = sketch.getEntityAs<SketchPoint>(movedId);
+        if (!moved) {
+            continue;
+        }
+        moved->setPosition(pointDist(rng), pointDist(rng));
+        if (sketch.geometryRevision() == revisionBefore) {
+            return {false, "revision bump on move", "unchanged"};
+        }
+
+        if (round % 10 == 9 && !lines.empty()) {
+            sketch.removeEntity(lines.back());
+            lines.pop_back();
+        }
+
+        // Query exactly at the moved point and at a random location.
+        TestResult atMoved = compareAt({moved->x() + 0.3, moved->y() - 0.2});
+        if (!atMoved.pass) {
+            return atMoved;
+        }
+        TestResult atRandom = compareAt({pointDist(rng), pointDist(rng)});
+        if (!atRandom.pass) {
+            return atRandom;
+        }
+    }
+
+    if (sketch.spatialIndex().size() != sketch.getEntityCount()) {
+        return {false,
+                std::to_string(sketch.getEntityCount()),
+                std::to_string(sketch.spatialIndex().size())};
+    }
+    return {true, "", ""};
+}
+
+TestResult test_intersection_index_matches_pairwise_after_moves() {
+    Sketch sketch;
+    std::vector<EntityID> rowStarts;
+    for (int i = 0; i < 8; ++i) {
+        const double y = 10.0 * static_cast<double>(i);
+        EntityID start = sketch.addPoint(-5.0, y);
+        EntityID end = sketch.addPoint(75.0, y);
+        sketch.addLine(start, end);
+        rowStarts.push_back(start);
+    }
+    for (int i = 0; i < 8; ++i) {
+        const double x = 10.0 * static_cast<double>(i);
+        sketch.addLine(x, -5.0, x, 75.0);
+    }
+    EntityID circleCenter = sketch.addPoint(35.0, 35.0);
+    sketch.addCircle(circleCenter, 12.0);
+
+    SnapManager fast = createSnapManagerFor({SnapType::Intersection});
+    fast.setSpatialHashEnabled(true);
+    SnapManager brute = createSnapManagerFor({SnapType::Intersection});
+    brute.setSpatialHashEnabled(false);
+
+    auto compareGrid = [&]() -> TestResult {
+        for (int ix = 0; ix < 8; ++ix) {
+            for (int iy = 0; iy < 8; ++iy) {
+                const Vec2d cursor{10.0 * ix + 0.4, 10.0 * iy + 0.3};
+                auto fastSnaps = fast.findAllSnaps(cursor, sketch);
+                auto bruteSnaps = brute.findAllSnaps(cursor, sketch);
+                std::sort(fastSnaps.begin(), fastSnaps.end());
+                std::sort(bruteSnaps.begin(), bruteSnaps.end());
+                if (fastSnaps.size() != bruteSnaps.size()) {
+                    return {false, std::to_string(bruteSnaps.size()), std::to_string(fastSnaps.size())};
+                }
+                for (size_t i = 0; i < fastSnaps.size(); ++i) {
+                    if (!snapResultsEqual(fastSnaps[i], bruteSnaps[i])) {
+                        return {false, "identical intersection snaps", "mismatch"};
+                    }
+                }
+            }
+        }
+        return {true, "", ""};
+    };
+
+    TestResult initial = compareGrid();
+    if (!initial.pass) {
+        return initial;
+    }
+
+    // Tilt a few rows and move the circle; only affected pairs are recomputed.
+    for (int i = 1; i < 8; i += 3) {
+        sketch.getEntityAs<SketchPoint>(rowStarts[static_cast<size_t>(i)])->setPosition(-5.0, 10.0 * i + 3.0);
+    }
+    sketch.getEntityAs<SketchPoint>(circleCenter)->setPosition(20.0, 42.0);
+
+    TestResult moved = compareGrid();
+    if (!moved.pass) {
+        return moved;
+    }
+    if (sketch.intersectionIndex().size() < 64) {
+        return {false, ">= 64 intersections", std::to_string(sketch.intersectionIndex().size())};
+    }
+    return {true, "", ""};
+}
+
+void addRowLines(Sketch& sketch, int count, double spacing) {
+    for (int i = 0; i < count; ++i) {
+        const double y = spacing * static_cast<double>(i);
+        sketch.addLine(-5.0, y, spacing * (count - 1) + 5.0, y);
+    }
+}
+
+std::vector<EntityID> addColumnLines(Sketch& sketch, int count, double spacing) {
+    std::vector<EntityID> ids;
+    for (int i = 0; i < count; ++i) {
+        const double x = spacing * static_cast<double>(i);
+        ids.push_back(sketch.addLine(x, -5.0, x, spacing * (count - 1) + 5.0));
+    }
+    return ids;
+}
+
+size_t countEntities(const Sketch& sketch, EntityType type) {
+    size_t count = 0;
+    for (const auto& entity : sketch.getAllEntities()) {
+        if (entity->type() == type) {
+            ++count;
+        }
+    }
+    return count;
+}
+
+TestResult test_batch_intersections_split_like_sequential() {
+    SnapManager snapManager;
+    IntersectionManager intersections;
+
+    Sketch batch;
+    addRowLines(batch, 6, 10.0);
+    const std::vector<EntityID> columns = addColumnLines(batch, 6, 10.0);
+    IntersectionResult result = intersections.processIntersections(columns, batch, snapManager);
+
+    Sketch sequential;
+    addRowLines(sequential, 6, 10.0);
+    for (const auto& id : addColumnLines(sequential, 6, 10.0)) {
+        intersections.processIntersections(id, sequential, snapManager);
+    }
+
+    if (result.intersectionPoints.size() != 36) {
+        return {false, "36 merged intersections", std::to_string(result.intersectionPoints.size())};
+    }
+    // Each of the 12 lines is cut at 6 interior crossings.
+    const size_t batchLines = countEntities(batch, EntityType::Line);
+    const size_t sequentialLines = countEntities(sequential, EntityType::Line);
+    if (batchLines != 84 || sequentialLines != 84) {
+        return {false, "84 line segments", std::to_string(batchLines) + "/" + std::to_string(sequentialLines)};
+    }
+
+    for (int ix = 0; ix < 6; ++ix) {
+        for (int iy = 0; iy < 6; ++iy) {
+            const Vec2d crossing{10.0 * ix, 10.0 * iy};
+            bool found = false;
+            for (const auto& id : batch.spatialIndex().queryRadius(crossing, 1e-6)) {
+                found = found || batch.getEntityAs<SketchPoint>(id) != nullptr;
+            }
+            if (!found) {
+                return {false, "point at every crossing", "missing point"};
+            }
+        }
+    }
+    return {true, "", ""};
+}
+
 TestResult test_preserves_guides_when_vertex_wins() {
     Sketch sketch;
     sketch.addPoint(5.0, 5.0);
@@ -1438,6 +1647,259 @@ bool shouldSkipInLegacy(const std::string& testName) {
     return false;
 }
 
+TestResult test_auto_constrainer_indexed_line_candidates() {
+    // 200 lines fanned in 0.9° steps, scattered so none share endpoints.
+    Sketch sketch;
+    std::vector<EntityID> fan;
+    for (int i = 0; i < 200; ++i) {
+        const double angle = 0.9 * i * M_PI / 180.0;
+        const Vec2d origin{50.0 * (i % 20), 50.0 * (i / 20)};
+        fan.push_back(sketch.addLine(origin.x, origin.y,
+                                     origin.x + 10.0 * std::cos(angle), origin.y + 10.0 * std::sin(angle)));
+    }
+
+    AutoConstrainer constrainer;
+    DrawingContext context;
+    const double drawAngle = 37.3 * M_PI / 180.0;
+    const Vec2d start{-100.0, -100.0};
+    const Vec2d end{start.x + 20.0 * std::cos(drawAngle), start.y + 20.0 * std::sin(drawAngle)};
+
+    auto find = [](const std::vector<InferredConstraint>& constraints, ConstraintType type) {
+        std::optional<EntityID> id;
+        for (const auto& c : constraints) {
+            if (c.type == type) {
+                id = c.entity2;
+            }
+        }
+        return id;
+    };
+
+    // 36.9° (i=41) and 126.9° (i=141) are the closest matches
+    auto inferred = constrainer.inferLineConstraints(start, end, "", sketch, context);
+    if (find(inferred, ConstraintType::Parallel) != fan[41]) {
+        return {false, "parallel to fan[41]", find(inferred, ConstraintType::Parallel).value_or("none")};
+    }
+    if (find(inferred, ConstraintType::Perpendicular) != fan[141]) {
+        return {false, "perpendicular to fan[141]", find(inferred, ConstraintType::Perpendicular).value_or("none")};
+    }
+
+    // Rotating an existing line must be seen by the next inference
+    auto* rotated = sketch.getEntityAs<SketchLine>(fan[5]);
+    auto* rotatedEnd = sketch.getEntityAs<SketchPoint>(rotated->endPointId());
+    const Vec2d rotatedStart{250.0, 0.0};
+    rotatedEnd->setPosition(rotatedStart.x + 10.0 * std::cos(drawAngle), rotatedStart.y + 10.0 * std::sin(drawAngle));
+    inferred = constrainer.inferLineConstraints(start, end, "", sketch, context);
+    if (find(inferred, ConstraintType::Parallel) != fan[5]) {
+        return {false, "parallel to moved fan[5]", find(inferred, ConstraintType::Parallel).value_or("none")};
+    }
+
+    // Near 180° wraps to the bucket near 0°; fan[0] is horizontal (0°)
+    const double nearFlat = 179.6 * M_PI / 180.0;
+    constrainer.setTypeEnabled(ConstraintType::Horizontal, false);
+    inferred = constrainer.inferLineConstraints(
+        start, {start.x + 20.0 * std::cos(nearFlat), start.y + 20.0 * std::sin(nearFlat)}, "", sketch, context);
+    if (find(inferred, ConstraintType::Parallel) != fan[0]) {
+        return {false, "parallel to fan[0] across wrap", find(inferred, ConstraintType::Parallel).value_or("none")};
+    }
+    return {true, "", ""};
+}
+
+TestResult test_auto_constrainer_indexed_curve_candidates() {
+    Sketch sketch;
+    std::vector<EntityID> circles;
+    std::vector<EntityID> centers;
+    for (int i = 0; i < 100; ++i) {
+        centers.push_back(sketch.addPoint(30.0 * (i % 10), 30.0 * (i / 10)));
+        circles.push_back(sketch.addCircle(centers.back(), 1.0 + 0.37 * i));
+    }
+    EntityID lineStart = sketch.addPoint(-50.0, -50.0);
+    EntityID lineEnd = sketch.addPoint(-40.0, -50.0);
+    EntityID line = sketch.addLine(lineStart, lineEnd);
+
+    AutoConstrainer constrainer;
+    DrawingContext context;
+
+    // Near circle 23's center, radius between circles 60 (23.2) and 61 (23.57)
+    const Vec2d center{30.0 * 3 + 0.3, 30.0 * 2 - 0.2};
+    auto inferred = constrainer.inferCircleConstraints(center, 23.3, "", sketch, context);
+    std::optional<EntityID> concentric;
+    std::optional<EntityID> equal;
+    std::optional<EntityID> coincident;
+    for (const auto& c : inferred) {
+        if (c.type == ConstraintType::Concentric) concentric = c.entity2;
+        if (c.type == ConstraintType::Equal) equal = c.entity2;
+        if (c.type == ConstraintType::Coincident) coincident = c.entity1;
+    }
+    if (concentric != circles[23] || coincident != centers[23]) {
+        return {false, "concentric/coincident with circle 23", concentric.value_or("none")};
+    }
+    if (equal != circles[60]) {
+        return {false, "equal radius with circle 60", equal.value_or("none")};
+    }
+
+    // Arc leaving the line end along +X, center below
+    auto arcInferred = constrainer.inferArcConstraints({-40.0, -55.0}, 5.0, M_PI / 2.0, M_PI, "", sketch, context);
+    bool tangent = false;
+    for (const auto& c : arcInferred) {
+        tangent = tangent || (c.type == ConstraintType::Tangent && c.entity2 == line);
+    }
+    if (!tangent) {
+        return {false, "tangent to line", "none"};
+    }
+
+    // Resizing a circle moves it between radius buckets
+    sketch.getEntityAs<SketchCircle>(circles[0])->setRadius(23.31);
+    inferred = constrainer.inferCircleConstraints(center, 23.3, "", sketch, context);
+    equal.reset();
+    for (const auto& c : inferred) {
+        if (c.type == ConstraintType::Equal) equal = c.entity2;
+    }
+    if (equal != circles[0]) {
+        return {false, "equal radius with resized circle 0", equal.value_or("none")};
+    }
+    return {true, "", ""};
+}
+
+TestResult test_trim_engine_removes_segment_between_cuts() {
+    Sketch sketch;
+    EntityID base = sketch.addLine(0.0, 0.0, 30.0, 0.0);
+    sketch.addLine(10.0, -5.0, 10.0, 5.0);
+    sketch.addLine(20.0, -5.0, 20.0, 5.0);
+
+    tools::TrimEngine engine;
+    auto segment = engine.segmentAt(sketch, {15.0, 0.5}, 3.0);
+    if (!segment || segment->entityId != base || segment->wholeEntity ||
+        !approx(segment->startParam, 1.0 / 3.0) || !approx(segment->endParam, 2.0 / 3.0)) {
+        return {false, "middle third of base line", segment ? std::to_string(segment->startParam) : "none"};
+    }
+
+    if (engine.trim(sketch, {*segment}, 3.0) != 1 || sketch.getEntity(base)) {
+        return {false, "base line replaced", "still present"};
+    }
+    if (countEntities(sketch, EntityType::Line) != 4) {
+        return {false, "4 lines", std::to_string(countEntities(sketch, EntityType::Line))};
+    }
+
+    // Remaining pieces end on the cuts
+    auto left = engine.segmentAt(sketch, {5.0, 0.0}, 1.0);
+    auto right = engine.segmentAt(sketch, {25.0, 0.0}, 1.0);
+    if (!left || !right || !left->wholeEntity || !right->wholeEntity ||
+        engine.segmentAt(sketch, {15.0, 0.0}, 1.0)) {
+        return {false, "two uncut pieces and a gap", "different"};
+    }
+    const auto* leftLine = sketch.getEntityAs<SketchLine>(left->entityId);
+    const auto* leftEnd = sketch.getEntityAs<SketchPoint>(leftLine->endPointId());
+    if (!approx(leftEnd->position().X(), 10.0) || !approx(leftEnd->position().Y(), 0.0)) {
+        return {false, "left piece ends at x=10", std::to_string(leftEnd->position().X())};
+    }
+    return {true, "", ""};
+}
+
+TestResult test_trim_engine_drag_gesture_single_batch() {
+    Sketch sketch;
+    EntityID base = sketch.addLine(0.0, 0.0, 30.0, 0.0);
+    sketch.addLine(10.0, -5.0, 10.0, 5.0);
+    sketch.addLine(20.0, -5.0, 20.0, 5.0);
+
+    tools::TrimEngine engine;
+    auto first = engine.segmentAt(sketch, {5.0, 0.0}, 1.0);
+    auto second = engine.segmentAt(sketch, {15.0, 0.0}, 1.0);
+    if (!first || !second) {
+        return {false, "two segments", "missing"};
+    }
+
+    // An unrelated edit makes both segments stale; trim re-resolves them from the pick positions
+    sketch.addLine(100.0, 100.0, 110.0, 100.0);
+    const uint64_t staleRevision = first->revision;
+    if (sketch.geometryRevision() == staleRevision) {
+        return {false, "revision bump", "unchanged"};
+    }
+
+    if (engine.trim(sketch, {*first, *second}, 1.0) != 1 || sketch.getEntity(base)) {
+        return {false, "one curve trimmed", "different"};
+    }
+    auto remaining = engine.segmentAt(sketch, {25.0, 0.0}, 1.0);
+    if (!remaining || engine.segmentAt(sketch, {5.0, 0.0}, 1.0) || engine.segmentAt(sketch, {15.0, 0.0}, 1.0)) {
+        return {false, "only the right third left", "different"};
+    }
+    const auto* line = sketch.getEntityAs<SketchLine>(remaining->entityId);
+    const auto* start = sketch.getEntityAs<SketchPoint>(line->startPointId());
+    if (!approx(start->position().X(), 20.0)) {
+        return {false, "remaining piece starts at x=20", std::to_string(start->position().X())};
+    }
+    return {true, "", ""};
+}
+
+TestResult test_trim_engine_circle_becomes_arc() {
+    Sketch sketch;
+    EntityID circle = sketch.addCircle(0.0, 0.0, 10.0);
+    sketch.addLine(-15.0, 0.0, 15.0, 0.0);
+    EntityID lone = sketch.addLine(50.0, 50.0, 60.0, 50.0);
+
+    tools::TrimEngine engine;
+    auto top = engine.segmentAt(sketch, {0.0, 10.2}, 1.0);
+    if (!top || top->entityId != circle || top->wholeEntity || !approx(top->endParam - top->startParam, M_PI)) {
+        return {false, "upper half of circle", top ? std::to_string(top->endParam - top->startParam) : "none"};
+    }
+    auto loneSegment = engine.segmentAt(sketch, {55.0, 50.0}, 1.0);
+    if (!loneSegment || !loneSegment->wholeEntity) {
+        return {false, "uncut line is whole", "partial"};
+    }
+
+    engine.trim(sketch, {*top, *loneSegment}, 1.0);
+    if (sketch.getEntity(circle) || sketch.getEntity(lone)) {
+        return {false, "circle and lone line removed", "still present"};
+    }
+    if (countEntities(sketch, EntityType::Arc) != 1) {
+        return {false, "1 arc", std::to_string(countEntities(sketch, EntityType::Arc))};
+    }
+    auto bottom = engine.segmentAt(sketch, {0.0, -10.0}, 1.0);
+    const auto* arc = bottom ? sketch.getEntityAs<SketchArc>(bottom->entityId) : nullptr;
+    if (!arc || !approx(arc->sweepAngle(), M_PI, 1e-9) || !arc->containsAngle(-M_PI / 2.0)) {
+        return {false, "lower half arc", arc ? std::to_string(arc->sweepAngle()) : "none"};
+    }
+    return {true, "", ""};
+}
+
+TestResult test_sketch_find_queries_use_spatial_index() {
+    Sketch sketch;
+    EntityID center = sketch.addPoint(0.0, 0.0);
+    EntityID arc = sketch.addArc(center, 10.0, M_PI / 4.0, 3.0 * M_PI / 4.0);
+    EntityID near = sketch.addLine(-5.0, 2.0, 5.0, 2.0);
+    EntityID far = sketch.addLine(-5.0, 50.0, 5.0, 50.0);
+    for (int i = 0; i < 500; ++i) {
+        sketch.addLine(100.0 + i, 100.0, 100.0 + i, 110.0);
+    }
+
+    // The arc's indexed box reaches its center; exact bounds do not
+    auto inRect = sketch.findInRect({-1.0, -1.0}, {1.0, 1.0});
+    if (inRect != std::vector<EntityID>{center}) {
+        return {false, "only the center point", std::to_string(inRect.size()) + " entities"};
+    }
+    inRect = sketch.findInRect({6.0, 1.5}, {-6.0, 9.0});
+    std::erase_if(inRect, [&](const EntityID& id) { return sketch.getEntity(id)->type() == EntityType::Point; });
+    if (inRect.size() != 2 || inRect[0] != arc || inRect[1] != near) {
+        return {false, "arc then line in sketch order", std::to_string(inRect.size()) + " curves"};
+    }
+
+    if (sketch.findNearest({0.0, 2.5}, 1.0) != near || !sketch.findNearest({0.0, 30.0}, 1.0).empty()) {
+        return {false, "nearest line within tolerance only", "different"};
+    }
+    if (sketch.findNearest({0.0, 9.8}, 1.0) != arc ||
+        sketch.findNearest({0.0, 0.5}, 1.0, EntityType::Point) != center) {
+        return {false, "arc and filtered center point", "different"};
+    }
+
+    // Moved geometry is found at its new location
+    auto* line = sketch.getEntityAs<SketchLine>(far);
+    sketch.getEntityAs<SketchPoint>(line->startPointId())->setPosition(-5.0, 30.0);
+    sketch.getEntityAs<SketchPoint>(line->endPointId())->setPosition(5.0, 30.0);
+    if (sketch.findNearest({0.0, 30.0}, 1.0) != far) {
+        return {false, "moved line found", "none"};
+    }
+    return {true, "", ""};
+}
+
 void runBenchmark() {
     Sketch sketch;
     std::mt19937 rng(42);
@@ -1470,6 +1932,146 @@ void runBenchmark() {
     const double p95Millis = p95Micros / 1000.0;
     std::cout << "Benchmark: p95 query time " << p95Micros << " us (" << p95Millis << " ms)" << std::endl;
     std::cout << "Benchmark target (<2ms): " << (p95Millis < 2.0 ? "PASS" : "FAIL") << std::endl;
+
+    // Drag-style workload: move one point then snap, on a sketch 10x larger.
+    Sketch large;
+    std::vector<EntityID> largePoints;
+    largePoints.reserve(10000);
+    for (int i = 0; i < 10000; ++i) {
+        largePoints.push_back(large.addPoint(dist(rng), dist(rng)));
+    }
+    (void)manager.findBestSnap({0.0, 0.0}, large);
+
+    std::vector<double> moveMicros;
+    moveMicros.reserve(100);
+    for (int i = 0; i < 100; ++i) {
+        auto* point = large.getEntityAs<SketchPoint>(largePoints[static_cast<size_t>(i)]);
+        const Vec2d cursor{dist(rng), dist(rng)};
+        auto t0 = std::chrono::steady_clock::now();
+        point->setPosition(cursor.x, cursor.y);
+        (void)manager.findBestSnap(cursor, large);
+        auto t1 = std::chrono::steady_clock::now();
+        moveMicros.push_back(std::chrono::duration<double, std::micro>(t1 - t0).count());
+    }
+    std::sort(moveMicros.begin(), moveMicros.end());
+    std::cout << "Benchmark: p95 move+snap time (10000 points) "
+              << moveMicros[p95Index] << " us" << std::endl;
+
+    // Intersection snapping on a 60x60 line lattice (3600 crossings).
+    Sketch lattice;
+    for (int i = 0; i < 60; ++i) {
+        const double offset = 5.0 * static_cast<double>(i);
+        lattice.addLine(-2.0, offset, 300.0, offset);
+        lattice.addLine(offset, -2.0, offset, 300.0);
+    }
+    SnapManager indexed = createSnapManagerFor({SnapType::Intersection});
+    SnapManager pairwise = createSnapManagerFor({SnapType::Intersection});
+    pairwise.setSpatialHashEnabled(false);
+
+    std::uniform_real_distribution<double> latticeDist(0.0, 295.0);
+    auto timeQueries = [&](const SnapManager& manager) {
+        std::vector<double> micros;
+        micros.reserve(100);
+        std::mt19937 latticeRng(7);
+        for (int i = 0; i < 100; ++i) {
+            const Vec2d cursor{latticeDist(latticeRng), latticeDist(latticeRng)};
+            auto t0 = std::chrono::steady_clock::now();
+            (void)manager.findBestSnap(cursor, lattice);
+            auto t1 = std::chrono::steady_clock::now();
+            micros.push_back(std::chrono::duration<double, std::micro>(t1 - t0).count());
+        }
+        std::sort(micros.begin(), micros.end());
+        return micros[p95Index];
+    };
+
+    auto buildStart = std::chrono::steady_clock::now();
+    (void)lattice.intersectionIndex();
+    auto buildEnd = std::chrono::steady_clock::now();
+    std::cout << "Benchmark: intersection index build (3600 crossings) "
+              << std::chrono::duration<double, std::milli>(buildEnd - buildStart).count() << " ms" << std::endl;
+    std::cout << "Benchmark: p95 intersection snap indexed " << timeQueries(indexed)
+              << " us, pairwise " << timeQueries(pairwise) << " us" << std::endl;
+
+    // Pattern-style bulk insert: 80 new columns crossing 80 existing rows.
+    IntersectionManager intersections;
+    auto timeSplit = [&](bool batchMode) {
+        Sketch sketch;
+        addRowLines(sketch, 80, 5.0);
+        const std::vector<EntityID> columns = addColumnLines(sketch, 80, 5.0);
+        auto t0 = std::chrono::steady_clock::now();
+        if (batchMode) {
+            intersections.processIntersections(columns, sketch, manager);
+        } else {
+            for (const auto& id : columns) {
+                intersections.processIntersections(id, sketch, manager);
+            }
+        }
+        auto t1 = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::milli>(t1 - t0).count();
+    };
+    std::cout << "Benchmark: split 80x80 pattern batch " << timeSplit(true)
+              << " ms, per-entity " << timeSplit(false) << " ms" << std::endl;
+
+    // Ghost constraint inference while drawing over 5000 lines and 1000 circles.
+    Sketch busy;
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    for (int i = 0; i < 5000; ++i) {
+        const double x = dist(rng);
+        const double y = dist(rng);
+        const double angle = unit(rng) * M_PI;
+        busy.addLine(x, y, x + 20.0 * std::cos(angle), y + 20.0 * std::sin(angle));
+    }
+    for (int i = 0; i < 1000; ++i) {
+        busy.addCircle(dist(rng), dist(rng), 1.0 + 40.0 * unit(rng));
+    }
+    AutoConstrainer constrainer;
+    DrawingContext drawing;
+    (void)constrainer.inferLineConstraints({0.0, 0.0}, {10.0, 3.0}, "", busy, drawing);
+    std::vector<double> inferMicros;
+    inferMicros.reserve(100);
+    for (int i = 0; i < 100; ++i) {
+        const Vec2d a{dist(rng), dist(rng)};
+        const Vec2d b{dist(rng), dist(rng)};
+        auto t0 = std::chrono::steady_clock::now();
+        (void)constrainer.inferLineConstraints(a, b, "", busy, drawing);
+        (void)constrainer.inferCircleConstraints(a, 1.0 + 40.0 * unit(rng), "", busy, drawing);
+        auto t1 = std::chrono::steady_clock::now();
+        inferMicros.push_back(std::chrono::duration<double, std::micro>(t1 - t0).count());
+    }
+    std::sort(inferMicros.begin(), inferMicros.end());
+    std::cout << "Benchmark: p95 line+circle inference (6000 curves) "
+              << inferMicros[p95Index] << " us" << std::endl;
+
+    // Trim hover over the 60x60 lattice: each line has 59 cuts.
+    tools::TrimEngine trimEngine;
+    (void)trimEngine.segmentAt(lattice, {1.0, 0.0}, 1.0);
+    std::vector<double> hoverMicros;
+    hoverMicros.reserve(100);
+    std::mt19937 hoverRng(11);
+    for (int i = 0; i < 100; ++i) {
+        const Vec2d cursor{latticeDist(hoverRng), 5.0 * static_cast<double>(i % 60)};
+        auto t0 = std::chrono::steady_clock::now();
+        (void)trimEngine.segmentAt(lattice, cursor, 1.0);
+        auto t1 = std::chrono::steady_clock::now();
+        hoverMicros.push_back(std::chrono::duration<double, std::micro>(t1 - t0).count());
+    }
+    std::sort(hoverMicros.begin(), hoverMicros.end());
+    std::cout << "Benchmark: p95 trim hover (lattice) " << hoverMicros[p95Index] << " us" << std::endl;
+
+    // Rubber-band selection growing across the 6000-curve sketch.
+    (void)busy.findInRect({0.0, 0.0}, {1.0, 1.0});
+    std::vector<double> rectMicros;
+    rectMicros.reserve(100);
+    for (int i = 0; i < 100; ++i) {
+        const double extent = 2.0 * static_cast<double>(i + 1);
+        auto t0 = std::chrono::steady_clock::now();
+        (void)busy.findInRect({-extent, -extent}, {extent, extent});
+        (void)busy.findNearest({extent, -extent}, 3.0);
+        auto t1 = std::chrono::steady_clock::now();
+        rectMicros.push_back(std::chrono::duration<double, std::micro>(t1 - t0).count());
+    }
+    std::sort(rectMicros.begin(), rectMicros.end());
+    std::cout << "Benchmark: p95 findInRect+findNearest (6000 curves) " << rectMicros[p95Index] << " us" << std::endl;
 }
 
 } // namespace
@@ -1526,6 +2128,15 @@ int main(int argc, char** argv) {
         {"test_priority_order", testPriorityOrder},
         {"test_spatial_hash_after_geometry_move", test_spatial_hash_after_geometry_move},
         {"test_spatial_hash_equivalent_to_bruteforce", testSpatialHashEquivalentToBruteforce},
+        {"test_spatial_index_tracks_incremental_edits", test_spatial_index_tracks_incremental_edits},
+        {"test_intersection_index_matches_pairwise_after_moves", test_intersection_index_matches_pairwise_after_moves},
+        {"test_batch_intersections_split_like_sequential", test_batch_intersections_split_like_sequential},
+        {"test_auto_constrainer_indexed_line_candidates", test_auto_constrainer_indexed_line_candidates},
+        {"test_auto_constrainer_indexed_curve_candidates", test_auto_constrainer_indexed_curve_candidates},
+        {"test_trim_engine_removes_segment_between_cuts", test_trim_engine_removes_segment_between_cuts},
+        {"test_trim_engine_drag_gesture_single_batch", test_trim_engine_drag_gesture_single_batch},
+        {"test_trim_engine_circle_becomes_arc", test_trim_engine_circle_becomes_arc},
+        {"test_sketch_find_queries_use_spatial_index", test_sketch_find_queries_use_spatial_index},
         {"test_preserves_guides_when_vertex_wins", test_preserves_guides_when_vertex_wins},
         {"test_perpendicular_guide_nonzero_length", test_perpendicular_guide_nonzero_length},
         {"test_tangent_guide_nonzero_length", test_tangent_guide_nonzero_length},
@@ -0,0 +1,92 @@
+#include "core/trace/Trace.h"
+
+#include <QCoreApplication>
+#include <QDir>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSet>
+#include <QTemporaryDir>
+
+#include <iostream>
+#include <thread>
+
+namespace trace = onecad::core::trace;
+
+namespace {
+int failures = 0;
+
+void check(bool condition, const char* message) {
+    if (!condition) {
+        std::cerr << "FAIL: " << message << "\n";
+        ++failures;
+    }
+}
+
+QJsonArray readEvents(const QString& path) {
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return {};
+    }
+    QJsonParseError error;
+    const QJsonDocument doc = QJsonDocument::fromJson(file.readAll(), &error);
+    check(error.error == QJsonParseError::NoError, "trace file is valid JSON");
+    return doc.object()["traceEvents"].toArray();
+}
+} // namespace
+
+int main(int argc, char** argv) {
+    QCoreApplication app(argc, argv);
+    QTemporaryDir dir;
+    const QString path = dir.filePath("trace.json");
+
+    // Disabled: scopes record nothing and stop() has no session to write
+    {
+        ONECAD_TRACE_SCOPE("test", "disabled");
+    }
+    check(!trace::isEnabled(), "tracing starts disabled");
+    check(!trace::stop(path.toStdString()), "stop without a session fails");
+
+    trace::start();
+    {
+        ONECAD_TRACE_NAMED_SCOPE(outer, "test", "outer");
+        ONECAD_TRACE_ARG(outer, "key", std::string("va\"lue"));
+        ONECAD_TRACE_SCOPE("test", "inner");
+    }
+    std::thread worker([]() {
+        trace::setThreadName("worker");
+        ONECAD_TRACE_SCOPE("test", "work");
+    });
+    worker.join();
+    check(trace::stop(path.toStdString()), "stop writes the session");
+    check(!trace::isEnabled(), "tracing disabled after stop");
+
+    const QJsonArray events = readEvents(path);
+    QSet<int> lanes;
+    QSet<QString> names;
+    QSet<QString> threadNames;
+    for (const auto& value : events) {
+        const QJsonObject event = value.toObject();
+        if (event["ph"].toString() == "M") {
+            threadNames.insert(event["args"].toObject()["name"].toString());
+            continue;
+        }
+        check(event["ph"].toString() == "X", "complete events");
+        check(event["dur"].toInteger() >= 0, "non-negative duration");
+        lanes.insert(event["tid"].toInt());
+        names.insert(event["name"].toString());
+        if (event["name"].toString() == "outer") {
+            check(event["args"].toObject()["key"].toString() == "va\"lue", "argument is escaped");
+        }
+    }
+    check(names == QSet<QString>({"outer", "inner", "work"}), "only session events recorded");
+    check(lanes.size() == 2, "one lane per thread");
+    check(threadNames.contains("main") && threadNames.contains("worker"), "lanes are named");
+
+    if (failures > 0) {
+        return 1;
+    }
+    std::cout << "Trace tests passed\n";
+    return 0;
+}